@@ -11,6 +11,7 @@
 #include <ctype.h>
 #include <zephyr.h>
 #include <zephyr/types.h>
+#include <sys/byteorder.h>
 #include <net/cloud.h>
 #if defined(CONFIG_NRF_MODEM_LIB)
 #include <modem/modem_info.h>
@@ -33,6 +34,16 @@ LOG_MODULE_REGISTER(cloud_codec, CONFIG_ASSET_TRACKER_LOG_LEVEL);
 
 #define DATA_TS "ts"
 
+/* Binary frame: version, channel, 64-bit unix time ms, payload. */
+#define BINARY_FRAME_VERSION 1
+#define BINARY_FRAME_HDR_LEN (1 + 1 + sizeof(int64_t))
+#define BINARY_ENV_PAYLOAD_LEN sizeof(int32_t)
+#define BINARY_MOTION_PAYLOAD_LEN (1 + 3 * sizeof(int16_t))
+#define BINARY_LIGHT_PAYLOAD_LEN (4 * sizeof(int32_t))
+/* Fixed-point scale factors of the binary payload values. */
+#define BINARY_ENV_SCALE 10
+#define BINARY_ACCEL_SCALE 100
+
 #define DISABLE_SEND_INTERVAL_VAL 0
 #define MIN_INTERVAL_VAL_SECONDS 5
 
@@ -335,6 +346,57 @@ static bool json_value_string_compare(cJSON *obj, const char *const str)
 	return (strcmp(json_str, str) == 0);
 }
 
+/** Convert sample uptime to unix time ms. If this function fails the
+ *  uptime is cleared and an empty timestamp value is encoded.
+ */
+static void data_ts_convert(int64_t *data_ts)
+{
+	int ret = date_time_uptime_to_unix_time_ms(data_ts);
+
+	if (ret) {
+		LOG_WRN("date_time_uptime_to_unix_time_ms, error: %d", ret);
+		LOG_WRN("Clearing timestamp");
+		date_time_timestamp_clear(data_ts);
+	}
+}
+
+/* Allocates a binary frame and fills in the header. The caller writes
+ * payload_len bytes of payload after the header.
+ */
+static uint8_t *binary_frame_alloc(enum cloud_channel type, int64_t ts,
+				   size_t payload_len, struct cloud_msg *output)
+{
+	uint8_t *buf = k_malloc(BINARY_FRAME_HDR_LEN + payload_len);
+
+	if (buf == NULL) {
+		return NULL;
+	}
+
+	data_ts_convert(&ts);
+
+	buf[0] = BINARY_FRAME_VERSION;
+	buf[1] = (uint8_t)type;
+	sys_put_le64((uint64_t)ts, &buf[2]);
+
+	output->buf = (char *)buf;
+	output->len = BINARY_FRAME_HDR_LEN + payload_len;
+
+	return &buf[BINARY_FRAME_HDR_LEN];
+}
+
+static int16_t accel_to_fixed(double value)
+{
+	double scaled = value * BINARY_ACCEL_SCALE;
+
+	if (scaled > INT16_MAX) {
+		return INT16_MAX;
+	} else if (scaled < INT16_MIN) {
+		return INT16_MIN;
+	}
+
+	return (int16_t)scaled;
+}
+
 int cloud_encode_data(const struct cloud_channel_data *channel,
 		      const enum cloud_cmd_group group,
 		      struct cloud_msg *output)
@@ -354,15 +416,7 @@ int cloud_encode_data(const struct cloud_channel_data *channel,
 		return -ENOMEM;
 	}
 
-	/** Convert sample uptime to unix time ms. If this function fails the
-	 *  uptime is cleared and an empty timestamp value is encoded.
-	 */
-	ret = date_time_uptime_to_unix_time_ms(&data_ts);
-	if (ret) {
-		LOG_WRN("date_time_uptime_to_unix_time_ms, error: %d", ret);
-		LOG_WRN("Clearing timestamp");
-		date_time_timestamp_clear(&data_ts);
-	}
+	data_ts_convert(&data_ts);
 
 	ret = json_add_str(root_obj, CMD_CHAN_KEY_STR,
 			   channel_type_str[channel->type]);
@@ -416,6 +470,21 @@ int cloud_encode_env_sensors_data(const env_sensor_data_t *sensor_data,
 		return -1;
 	}
 
+	if (IS_ENABLED(CONFIG_CLOUD_CODEC_BINARY_ENV_SENSORS)) {
+		uint8_t *payload = binary_frame_alloc(cloud_sensor.type,
+						      sensor_data->ts,
+						      BINARY_ENV_PAYLOAD_LEN,
+						      output);
+		if (payload == NULL) {
+			return -ENOMEM;
+		}
+
+		sys_put_le32((uint32_t)(int32_t)(sensor_data->value *
+						 BINARY_ENV_SCALE),
+			     payload);
+		return 0;
+	}
+
 	len = snprintf(buf, sizeof(buf), "%.1f",
 		sensor_data->value);
 	cloud_sensor.data.buf = buf;
@@ -446,6 +515,25 @@ int cloud_encode_motion_data(const motion_data_t *motion_data,
 		return -1;
 	}
 
+	if (IS_ENABLED(CONFIG_CLOUD_CODEC_BINARY_MOTION)) {
+		uint8_t *payload = binary_frame_alloc(cloud_sensor.type,
+						      motion_data->ts,
+						      BINARY_MOTION_PAYLOAD_LEN,
+						      output);
+		if (payload == NULL) {
+			return -ENOMEM;
+		}
+
+		payload[0] = (uint8_t)motion_data->orientation;
+		sys_put_le16((uint16_t)accel_to_fixed(
+				motion_data->acceleration.x), &payload[1]);
+		sys_put_le16((uint16_t)accel_to_fixed(
+				motion_data->acceleration.y), &payload[3]);
+		sys_put_le16((uint16_t)accel_to_fixed(
+				motion_data->acceleration.z), &payload[5]);
+		return 0;
+	}
+
 	cloud_sensor.data.len = sizeof(cloud_sensor.data.buf) - 1;
 
 	return cloud_encode_data(&cloud_sensor, CLOUD_CMD_GROUP_DATA, output);
@@ -493,6 +581,22 @@ int cloud_encode_light_sensor_data(const struct light_sensor_data *sensor_data,
 		send.ir = sensor_data->ir;
 	}
 
+	if (IS_ENABLED(CONFIG_CLOUD_CODEC_BINARY_LIGHT_SENSOR)) {
+		uint8_t *payload = binary_frame_alloc(cloud_sensor.type,
+						      sensor_data->ts,
+						      BINARY_LIGHT_PAYLOAD_LEN,
+						      output);
+		if (payload == NULL) {
+			return -ENOMEM;
+		}
+
+		sys_put_le32((uint32_t)send.red, &payload[0]);
+		sys_put_le32((uint32_t)send.green, &payload[4]);
+		sys_put_le32((uint32_t)send.blue, &payload[8]);
+		sys_put_le32((uint32_t)send.ir, &payload[12]);
+		return 0;
+	}
+
 	len = snprintf(buf, sizeof(buf), "%d %d %d %d", send.red, send.green,
 		       send.blue, send.ir);
 
@@ -503,6 +607,75 @@ int cloud_encode_light_sensor_data(const struct light_sensor_data *sensor_data,
 }
 #endif /* CONFIG_LIGHT_SENSOR */
 
+int cloud_decode_binary_data(const uint8_t *buf, size_t len,
+			     struct cloud_binary_data *output)
+{
+	const uint8_t *payload;
+	size_t payload_len;
+
+	if ((buf == NULL) || (output == NULL) || (len < BINARY_FRAME_HDR_LEN)) {
+		return -EINVAL;
+	}
+
+	if (buf[0] != BINARY_FRAME_VERSION) {
+		return -ENOTSUP;
+	}
+
+	output->type = (enum cloud_channel)buf[1];
+	output->ts = (int64_t)sys_get_le64(&buf[2]);
+	payload = &buf[BINARY_FRAME_HDR_LEN];
+	payload_len = len - BINARY_FRAME_HDR_LEN;
+
+	switch (output->type) {
+	case CLOUD_CHANNEL_TEMP:
+	case CLOUD_CHANNEL_HUMID:
+	case CLOUD_CHANNEL_AIR_PRESS:
+	case CLOUD_CHANNEL_AIR_QUAL:
+		if (payload_len != BINARY_ENV_PAYLOAD_LEN) {
+			return -EMSGSIZE;
+		}
+
+		output->value = (double)(int32_t)sys_get_le32(payload) /
+				BINARY_ENV_SCALE;
+		break;
+
+	case CLOUD_CHANNEL_FLIP:
+		if (payload_len != BINARY_MOTION_PAYLOAD_LEN) {
+			return -EMSGSIZE;
+		}
+
+		output->motion.orientation = payload[0];
+		output->motion.acceleration.x =
+			(double)(int16_t)sys_get_le16(&payload[1]) /
+			BINARY_ACCEL_SCALE;
+		output->motion.acceleration.y =
+			(double)(int16_t)sys_get_le16(&payload[3]) /
+			BINARY_ACCEL_SCALE;
+		output->motion.acceleration.z =
+			(double)(int16_t)sys_get_le16(&payload[5]) /
+			BINARY_ACCEL_SCALE;
+		output->motion.ts = output->ts;
+		break;
+
+	case CLOUD_CHANNEL_LIGHT_SENSOR:
+		if (payload_len != BINARY_LIGHT_PAYLOAD_LEN) {
+			return -EMSGSIZE;
+		}
+
+		output->light.red = (int32_t)sys_get_le32(&payload[0]);
+		output->light.green = (int32_t)sys_get_le32(&payload[4]);
+		output->light.blue = (int32_t)sys_get_le32(&payload[8]);
+		output->light.ir = (int32_t)sys_get_le32(&payload[12]);
+		output->light.ts = output->ts;
+		break;
+
+	default:
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
 int cloud_encode_config_data(struct cloud_msg *output)
 {
 	__ASSERT_NO_MSG(output != NULL);
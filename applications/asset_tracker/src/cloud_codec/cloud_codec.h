@@ -277,6 +277,43 @@ int cloud_encode_env_sensors_data(const env_sensor_data_t *sensor_data,
 int cloud_encode_motion_data(const motion_data_t *motion_data,
 			     struct cloud_msg *output);
 
+/**@brief Sensor data decoded from a binary frame. */
+struct cloud_binary_data {
+	/** The sensor that is the source of the data. */
+	enum cloud_channel type;
+	/** Unix time in milliseconds, 0 if the device had no valid time. */
+	int64_t ts;
+	union {
+		/** Environment sensor value, resolution 0.1. */
+		double value;
+		/** Orientation and acceleration, resolution 0.01 m/s^2. */
+		motion_data_t motion;
+		/** Light levels, -1 for channels that were not updated. */
+		struct light_sensor_data light;
+	};
+};
+
+/**
+ * @brief Decode a binary sensor data frame.
+ *
+ * @details Binary frames are produced by the sensor data encoders for the
+ *          data types selected with the CONFIG_CLOUD_CODEC_BINARY_* options.
+ *          All fields are little-endian: a version byte, the cloud_channel
+ *          byte, a 64-bit unix timestamp in ms, followed by a fixed-size
+ *          payload specific to the channel.
+ *
+ * @param buf Pointer to the encoded frame.
+ * @param len Length of the encoded frame.
+ * @param output Pointer to the decoded data.
+ *
+ * @retval 0 If successful; data was decoded.
+ * @retval -EINVAL If a parameter is invalid or the frame is truncated.
+ * @retval -ENOTSUP If the frame version or channel is not supported.
+ * @retval -EMSGSIZE If the payload size does not match the channel.
+ */
+int cloud_decode_binary_data(const uint8_t *buf, size_t len,
+			     struct cloud_binary_data *output);
+
 #if CONFIG_LIGHT_SENSOR
 int cloud_encode_light_sensor_data(const struct light_sensor_data *sensor_data,
 				   struct cloud_msg *output);
@@ -30,10 +30,10 @@ extern "C" {
 
 /** @brief Structure containing battery data published to cloud. */
 struct cloud_data_battery {
-	/** Battery voltage level. */
-	uint16_t bat;
 	/** Battery data timestamp. UNIX milliseconds. */
 	int64_t bat_ts;
+	/** Battery voltage level. */
+	uint16_t bat;
 	/** Flag signifying that the data entry is to be encoded. */
 	bool queued : 1;
 };
@@ -179,10 +179,10 @@ struct cloud_data_modem_dynamic {
 };
 
 struct cloud_data_ui {
-	/** Button number. */
-	int btn;
 	/** Button data timestamp. UNIX milliseconds. */
 	int64_t btn_ts;
+	/** Button number. */
+	int btn;
 	/** Flag signifying that the data entry is to be encoded. */
 	bool queued : 1;
 };
@@ -9,10 +9,31 @@
 #include <cJSON.h>
 #include <cJSON_os.h>
 #include <math.h>
+#include <string.h>
 
 #include <logging/log.h>
 LOG_MODULE_REGISTER(cloud_codec_ringbuffer, CONFIG_CLOUD_CODEC_LOG_LEVEL);
 
+/* All data types share the same ring buffer logic. The entry is copied in
+ * the slot after the head, overwriting the oldest entry when the buffer is
+ * full.
+ */
+static void buffer_entry_add(void *buffer, const void *new_data,
+			     size_t entry_size, int *head, size_t buffer_count,
+			     const char *name)
+{
+	/* Go to start of buffer if end is reached. */
+	*head += 1;
+	if (*head == buffer_count) {
+		*head = 0;
+	}
+
+	memcpy((uint8_t *)buffer + (*head * entry_size), new_data, entry_size);
+
+	LOG_DBG("Entry: %d of %d in %s buffer filled", *head, buffer_count - 1,
+		name);
+}
+
 void cloud_codec_populate_sensor_buffer(
 				struct cloud_data_sensors *sensor_buffer,
 				struct cloud_data_sensors *new_sensor_data,
@@ -27,16 +48,8 @@ void cloud_codec_populate_sensor_buffer(
 		return;
 	}
 
-	/* Go to start of buffer if end is reached. */
-	*head_sensor_buf += 1;
-	if (*head_sensor_buf == buffer_count) {
-		*head_sensor_buf = 0;
-	}
-
-	sensor_buffer[*head_sensor_buf] = *new_sensor_data;
-
-	LOG_DBG("Entry: %d of %d in sensor buffer filled", *head_sensor_buf,
-		buffer_count - 1);
+	buffer_entry_add(sensor_buffer, new_sensor_data, sizeof(*new_sensor_data),
+			 head_sensor_buf, buffer_count, "sensor");
 }
 
 void cloud_codec_populate_ui_buffer(struct cloud_data_ui *ui_buffer,
@@ -52,16 +65,8 @@ void cloud_codec_populate_ui_buffer(struct cloud_data_ui *ui_buffer,
 		return;
 	}
 
-	/* Go to start of buffer if end is reached. */
-	*head_ui_buf += 1;
-	if (*head_ui_buf == buffer_count) {
-		*head_ui_buf = 0;
-	}
-
-	ui_buffer[*head_ui_buf] = *new_ui_data;
-
-	LOG_DBG("Entry: %d of %d in UI buffer filled", *head_ui_buf,
-		buffer_count - 1);
+	buffer_entry_add(ui_buffer, new_ui_data, sizeof(*new_ui_data),
+			 head_ui_buf, buffer_count, "UI");
 }
 
 void cloud_codec_populate_accel_buffer(
@@ -78,16 +83,8 @@ void cloud_codec_populate_accel_buffer(
 		return;
 	}
 
-	/* Go to start of buffer if end is reached. */
-	*head_mov_buf += 1;
-	if (*head_mov_buf == buffer_count) {
-		*head_mov_buf = 0;
-	}
-
-	mov_buf[*head_mov_buf] = *new_accel_data;
-
-	LOG_DBG("Entry: %d of %d in movement buffer filled", *head_mov_buf,
-		buffer_count - 1);
+	buffer_entry_add(mov_buf, new_accel_data, sizeof(*new_accel_data),
+			 head_mov_buf, buffer_count, "movement");
 }
 
 void cloud_codec_populate_bat_buffer(struct cloud_data_battery *bat_buffer,
@@ -103,16 +100,8 @@ void cloud_codec_populate_bat_buffer(struct cloud_data_battery *bat_buffer,
 		return;
 	}
 
-	/* Go to start of buffer if end is reached. */
-	*head_bat_buf += 1;
-	if (*head_bat_buf == buffer_count) {
-		*head_bat_buf = 0;
-	}
-
-	bat_buffer[*head_bat_buf] = *new_bat_data;
-
-	LOG_DBG("Entry: %d of %d in battery buffer filled", *head_bat_buf,
-		buffer_count - 1);
+	buffer_entry_add(bat_buffer, new_bat_data, sizeof(*new_bat_data),
+			 head_bat_buf, buffer_count, "battery");
 }
 
 void cloud_codec_populate_gps_buffer(struct cloud_data_gps *gps_buffer,
@@ -128,16 +117,8 @@ void cloud_codec_populate_gps_buffer(struct cloud_data_gps *gps_buffer,
 		return;
 	}
 
-	/* Go to start of buffer if end is reached. */
-	*head_gps_buf += 1;
-	if (*head_gps_buf == buffer_count) {
-		*head_gps_buf = 0;
-	}
-
-	gps_buffer[*head_gps_buf] = *new_gps_data;
-
-	LOG_DBG("Entry: %d of %d in GPS buffer filled", *head_gps_buf,
-		buffer_count - 1);
+	buffer_entry_add(gps_buffer, new_gps_data, sizeof(*new_gps_data),
+			 head_gps_buf, buffer_count, "GPS");
 }
 
 void cloud_codec_populate_modem_dynamic_buffer(
@@ -154,14 +135,6 @@ void cloud_codec_populate_modem_dynamic_buffer(
 		return;
 	}
 
-	/* Go to start of buffer if end is reached. */
-	*head_modem_buf += 1;
-	if (*head_modem_buf == buffer_count) {
-		*head_modem_buf = 0;
-	}
-
-	modem_buffer[*head_modem_buf] = *new_modem_data;
-
-	LOG_DBG("Entry: %d of %d in dynamic modem buffer filled",
-		*head_modem_buf, buffer_count - 1);
+	buffer_entry_add(modem_buffer, new_modem_data, sizeof(*new_modem_data),
+			 head_modem_buf, buffer_count, "dynamic modem");
 }
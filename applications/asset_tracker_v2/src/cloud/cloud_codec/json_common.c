@@ -1077,10 +1077,80 @@ void json_common_config_get(cJSON *parent, struct cloud_data_cfg *data)
 	}
 }
 
+/* Put an entry that did not fit into the current batch chunk back in its buffer, so that it is
+ * picked up by the next chunk.
+ */
+static void batch_entry_requeue(enum json_common_buffer_type type, void *buf, size_t index)
+{
+	switch (type) {
+	case JSON_COMMON_UI:
+		((struct cloud_data_ui *)buf)[index].queued = true;
+		break;
+	case JSON_COMMON_MODEM_STATIC:
+		((struct cloud_data_modem_static *)buf)[index].queued = true;
+		break;
+	case JSON_COMMON_MODEM_DYNAMIC:
+		((struct cloud_data_modem_dynamic *)buf)[index].queued = true;
+		break;
+	case JSON_COMMON_GPS:
+		((struct cloud_data_gps *)buf)[index].queued = true;
+		break;
+	case JSON_COMMON_SENSOR:
+		((struct cloud_data_sensors *)buf)[index].queued = true;
+		break;
+	case JSON_COMMON_ACCELEROMETER:
+		((struct cloud_data_accelerometer *)buf)[index].queued = true;
+		break;
+	case JSON_COMMON_BATTERY:
+		((struct cloud_data_battery *)buf)[index].queued = true;
+		break;
+	default:
+		break;
+	}
+}
+
+/* Charge the last entry added to the array object against the remaining chunk size. If the entry
+ * does not fit it is removed from the array and -E2BIG is returned. An entry is always accepted
+ * if it is the first one in the chunk, otherwise an oversized entry would never be sent.
+ */
+static int batch_entry_budget_charge(cJSON *parent, cJSON *array_obj,
+				     const char *object_label, size_t *budget)
+{
+	int count = cJSON_GetArraySize(array_obj);
+	char *string = cJSON_PrintUnformatted(cJSON_GetArrayItem(array_obj, count - 1));
+	size_t len;
+
+	if (string == NULL) {
+		return -ENOMEM;
+	}
+
+	/* Entry and the comma separating it from the next one. */
+	len = strlen(string) + 1;
+	cJSON_FreeString(string);
+
+	if (count == 1) {
+		/* "<label>":[], including the comma separating it from the next object. */
+		len += strlen(object_label) + 6;
+	}
+
+	if (len > *budget) {
+		if ((count > 1) || (cJSON_GetArraySize(parent) > 0)) {
+			cJSON_DeleteItemFromArray(array_obj, count - 1);
+			return -E2BIG;
+		}
+
+		len = *budget;
+	}
+
+	*budget -= len;
+	return 0;
+}
+
 int json_common_batch_data_add(cJSON *parent, enum json_common_buffer_type type, void *buf,
-			       size_t buf_count, const char *object_label)
+			       size_t buf_count, const char *object_label, size_t *budget)
 {
 	int err = 0;
+	int array_size;
 	cJSON *array_obj = cJSON_CreateArray();
 
 	if (parent == NULL || array_obj == NULL) {
@@ -1094,7 +1164,14 @@ int json_common_batch_data_add(cJSON *parent, enum json_common_buffer_type type,
 		return -EINVAL;
 	}
 
+	if ((budget != NULL) && (*budget == 0)) {
+		cJSON_Delete(array_obj);
+		return -ENODATA;
+	}
+
 	for (int i = 0; i < buf_count; i++) {
+		array_size = cJSON_GetArraySize(array_obj);
+
 		switch (type) {
 		case JSON_COMMON_UI: {
 			struct cloud_data_ui *data =
@@ -1176,6 +1253,23 @@ int json_common_batch_data_add(cJSON *parent, enum json_common_buffer_type type,
 			cJSON_Delete(array_obj);
 			return err;
 		}
+
+		if ((budget == NULL) || (cJSON_GetArraySize(array_obj) == array_size)) {
+			continue;
+		}
+
+		err = batch_entry_budget_charge(parent, array_obj, object_label, budget);
+		if (err == -E2BIG) {
+			/* Chunk is full. Leave the remaining entries queued for the next chunk. */
+			batch_entry_requeue(type, buf, i);
+			*budget = 0;
+			break;
+		} else if (err) {
+			LOG_ERR("Failed measuring encoded entry");
+			batch_entry_requeue(type, buf, i);
+			cJSON_Delete(array_obj);
+			return err;
+		}
 	}
 
 	if (cJSON_GetArraySize(array_obj) == 0) {
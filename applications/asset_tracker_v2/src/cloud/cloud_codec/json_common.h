@@ -276,12 +276,15 @@ void json_common_config_get(cJSON *parent, struct cloud_data_cfg *data);
  * @param[in] buf Pointer to data buffer that is to be encoded.
  * @param[in] buf_count Number of entries in passed in data buffer.
  * @param[in] object_label Name of the array entry that is added to the parent object.
+ * @param[in,out] budget Pointer to the number of bytes left in the encoded batch chunk. Entries
+ *                       are encoded until the budget is exhausted, entries that do not fit stay
+ *                       queued and the budget is set to 0. NULL if the size is not bounded.
  *
  * @return 0 on success. -ENODATA if the passed in data is not valid. Otherwise a negative error
  *         code is returned.
  */
 int json_common_batch_data_add(cJSON *parent, enum json_common_buffer_type type, void *buf,
-			       size_t buf_count, const char *object_label);
+			       size_t buf_count, const char *object_label, size_t *budget);
 
 #ifdef __cplusplus
 }
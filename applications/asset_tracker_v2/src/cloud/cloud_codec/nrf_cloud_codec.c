@@ -543,6 +543,8 @@ int cloud_codec_encode_batch_data(
 	int err;
 	char *buffer;
 	bool object_added = false;
+	/* Leave room for the braces of the root object. */
+	size_t budget = CONFIG_CLOUD_CODEC_BATCH_CHUNK_SIZE_MAX - 2;
 
 	cJSON *root_obj = cJSON_CreateObject();
 
@@ -552,7 +554,7 @@ int cloud_codec_encode_batch_data(
 
 	err = json_common_batch_data_add(root_obj, JSON_COMMON_MODEM_DYNAMIC,
 					 modem_dyn_buf, modem_dyn_buf_count,
-					 DATA_MODEM_DYNAMIC);
+					 DATA_MODEM_DYNAMIC, &budget);
 	if (err == 0) {
 		object_added = true;
 	} else if (err != -ENODATA) {
@@ -561,7 +563,7 @@ int cloud_codec_encode_batch_data(
 
 	err = json_common_batch_data_add(root_obj, JSON_COMMON_GPS,
 					 gps_buf, gps_buf_count,
-					 DATA_GPS);
+					 DATA_GPS, &budget);
 	if (err == 0) {
 		object_added = true;
 	} else if (err != -ENODATA) {
@@ -570,7 +572,7 @@ int cloud_codec_encode_batch_data(
 
 	err = json_common_batch_data_add(root_obj, JSON_COMMON_SENSOR,
 					 sensor_buf, sensor_buf_count,
-					 DATA_ENVIRONMENTALS);
+					 DATA_ENVIRONMENTALS, &budget);
 	if (err == 0) {
 		object_added = true;
 	} else if (err != -ENODATA) {
@@ -579,7 +581,7 @@ int cloud_codec_encode_batch_data(
 
 	err = json_common_batch_data_add(root_obj, JSON_COMMON_UI,
 					 ui_buf, ui_buf_count,
-					 DATA_BUTTON);
+					 DATA_BUTTON, &budget);
 	if (err == 0) {
 		object_added = true;
 	} else if (err != -ENODATA) {
@@ -588,7 +590,7 @@ int cloud_codec_encode_batch_data(
 
 	err = json_common_batch_data_add(root_obj, JSON_COMMON_BATTERY,
 					 bat_buf, bat_buf_count,
-					 DATA_BATTERY);
+					 DATA_BATTERY, &budget);
 	if (err == 0) {
 		object_added = true;
 	} else if (err != -ENODATA) {
@@ -597,7 +599,7 @@ int cloud_codec_encode_batch_data(
 
 	err = json_common_batch_data_add(root_obj, JSON_COMMON_ACCELEROMETER,
 					 accel_buf, accel_buf_count,
-					 DATA_MOVEMENT);
+					 DATA_MOVEMENT, &budget);
 	if (err == 0) {
 		object_added = true;
 	} else if (err != -ENODATA) {
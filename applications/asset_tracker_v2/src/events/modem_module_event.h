@@ -33,6 +33,10 @@ enum modem_module_event_type {
 	MODEM_EVT_LTE_CELL_UPDATE,
 	MODEM_EVT_LTE_PSM_UPDATE,
 	MODEM_EVT_LTE_EDRX_UPDATE,
+	/** The modem has entered RRC connected mode, the radio is active. */
+	MODEM_EVT_LTE_RRC_CONNECTED,
+	/** The modem has left RRC connected mode. */
+	MODEM_EVT_LTE_RRC_IDLE,
 	MODEM_EVT_MODEM_STATIC_DATA_READY,
 	MODEM_EVT_MODEM_DYNAMIC_DATA_READY,
 	MODEM_EVT_MODEM_STATIC_DATA_NOT_READY,
@@ -40,13 +40,13 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_APPLICATION_MODULE_LOG_LEVEL);
  */
 struct app_msg_data {
 	union {
-		struct cloud_module_event cloud;
-		struct ui_module_event ui;
-		struct sensor_module_event sensor;
-		struct data_module_event data;
-		struct util_module_event util;
-		struct modem_module_event modem;
-		struct app_module_event app;
+		struct cloud_module_event *cloud;
+		struct ui_module_event *ui;
+		struct sensor_module_event *sensor;
+		struct data_module_event *data;
+		struct util_module_event *util;
+		struct modem_module_event *modem;
+		struct app_module_event *app;
 	} module;
 };
 
@@ -104,6 +104,24 @@ K_TIMER_DEFINE(movement_timeout_timer, data_sample_timer_handler, NULL);
  */
 K_TIMER_DEFINE(movement_resolution_timer, waiting_for_movement_handler, NULL);
 
+/* Timer that bounds how long a sample request is held back while the modem is in RRC connected
+ * mode. Used by the sampling scheduler.
+ */
+K_TIMER_DEFINE(sample_defer_timer, data_sample_timer_handler, NULL);
+
+/* RRC mode and serving cell as last reported by the modem module. */
+static bool rrc_connected;
+static uint32_t cell_id = LTE_LC_CELL_EUTRAN_ID_INVALID;
+
+/* Set if a sample request is held back until the modem leaves RRC connected mode. */
+static bool sample_deferred;
+
+/* Serving cell at the last GNSS sample request and the number of consecutive sample requests that
+ * GNSS has been left out of because the serving cell has not changed.
+ */
+static uint32_t gnss_cell_id = LTE_LC_CELL_EUTRAN_ID_INVALID;
+static int gnss_skip_count;
+
 /* Module data structure to hold information of the application module, which
  * opens up for using convenience functions available for modules.
  */
@@ -216,49 +234,49 @@ static bool event_handler(const struct event_header *eh)
 	if (is_cloud_module_event(eh)) {
 		struct cloud_module_event *evt = cast_cloud_module_event(eh);
 
-		msg.module.cloud = *evt;
+		msg.module.cloud = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_app_module_event(eh)) {
 		struct app_module_event *evt = cast_app_module_event(eh);
 
-		msg.module.app = *evt;
+		msg.module.app = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_data_module_event(eh)) {
 		struct data_module_event *evt = cast_data_module_event(eh);
 
-		msg.module.data = *evt;
+		msg.module.data = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_sensor_module_event(eh)) {
 		struct sensor_module_event *evt = cast_sensor_module_event(eh);
 
-		msg.module.sensor = *evt;
+		msg.module.sensor = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_util_module_event(eh)) {
 		struct util_module_event *evt = cast_util_module_event(eh);
 
-		msg.module.util = *evt;
+		msg.module.util = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_modem_module_event(eh)) {
 		struct modem_module_event *evt = cast_modem_module_event(eh);
 
-		msg.module.modem = *evt;
+		msg.module.modem = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_ui_module_event(eh)) {
 		struct ui_module_event *evt = cast_ui_module_event(eh);
 
-		msg.module.ui = *evt;
+		msg.module.ui = evt;
 		enqueue_msg = true;
 	}
 
@@ -321,6 +339,29 @@ static void active_mode_timers_start_all(void)
 	SEND_EVENT(app, APP_EVT_ACTIVITY_DETECTION_DISABLE);
 }
 
+/* Returns true if GNSS can be left out of the next sample request. In active mode, a device that
+ * stays in the same serving cell is unlikely to have moved far, so the position is only refreshed
+ * every CONFIG_APP_SAMPLING_GNSS_SKIP_MAX + 1 sample requests.
+ */
+static bool gnss_sample_skip(void)
+{
+	if (!IS_ENABLED(CONFIG_APP_SAMPLING_SCHEDULER) ||
+	    (sub_state != SUB_STATE_ACTIVE_MODE) ||
+	    (cell_id == LTE_LC_CELL_EUTRAN_ID_INVALID)) {
+		return false;
+	}
+
+	if ((cell_id == gnss_cell_id) &&
+	    (gnss_skip_count < CONFIG_APP_SAMPLING_GNSS_SKIP_MAX)) {
+		gnss_skip_count++;
+		return true;
+	}
+
+	gnss_cell_id = cell_id;
+	gnss_skip_count = 0;
+	return false;
+}
+
 static void data_get(void)
 {
 	static bool first = true;
@@ -364,7 +405,9 @@ static void data_get(void)
 		app_module_event->data_list[count++] = APP_DATA_MODEM_STATIC;
 		first = false;
 	} else {
-		if (!app_cfg.no_data.gnss) {
+		if (!app_cfg.no_data.gnss && gnss_sample_skip()) {
+			LOG_DBG("Serving cell unchanged, GNSS left out of sample request");
+		} else if (!app_cfg.no_data.gnss) {
 			app_module_event->data_list[count++] = APP_DATA_GNSS;
 			app_module_event->timeout = MAX(app_cfg.gps_timeout + 15, 75);
 		}
@@ -377,12 +420,75 @@ static void data_get(void)
 	EVENT_SUBMIT(app_module_event);
 }
 
+/* Request data sampling, taking the modem RRC mode into account. GNSS cannot get a fix while the
+ * modem is in RRC connected mode, so sample requests that include GNSS are held back until the
+ * modem goes idle, but for no longer than CONFIG_APP_SAMPLING_RRC_IDLE_WAIT_MAX seconds.
+ */
+static void data_sample(void)
+{
+	if (IS_ENABLED(CONFIG_APP_SAMPLING_SCHEDULER) && rrc_connected && !app_cfg.no_data.gnss) {
+		if (!sample_deferred) {
+			LOG_DBG("RRC connected, deferring sample request");
+
+			sample_deferred = true;
+			k_timer_start(&sample_defer_timer,
+				      K_SECONDS(CONFIG_APP_SAMPLING_RRC_IDLE_WAIT_MAX),
+				      K_SECONDS(0));
+			return;
+		}
+
+		if (k_timer_remaining_get(&sample_defer_timer) != 0) {
+			/* Already waiting for RRC idle. */
+			return;
+		}
+
+		LOG_DBG("RRC still connected, sampling anyway");
+	}
+
+	sample_deferred = false;
+	k_timer_stop(&sample_defer_timer);
+	data_get();
+}
+
+/* Handle RRC mode changes reported by the modem module. */
+static void rrc_mode_update(bool connected)
+{
+	rrc_connected = connected;
+
+	if (!IS_ENABLED(CONFIG_APP_SAMPLING_SCHEDULER)) {
+		return;
+	}
+
+	if (!connected) {
+		if (sample_deferred) {
+			data_sample();
+		}
+
+		return;
+	}
+
+	/* The radio is active for other traffic. If GNSS is not needed and the next sample is
+	 * due shortly, sample now so that the data is sent in the same connection instead of
+	 * waking up the radio again later.
+	 */
+	if ((sub_state == SUB_STATE_ACTIVE_MODE) && app_cfg.no_data.gnss &&
+	    (k_timer_remaining_get(&data_sample_timer) <=
+	     (CONFIG_APP_SAMPLING_ALIGN_WINDOW * MSEC_PER_SEC))) {
+		LOG_DBG("Sampling ahead of schedule while RRC is connected");
+
+		data_get();
+		k_timer_start(&data_sample_timer,
+			      K_SECONDS(app_cfg.active_wait_timeout),
+			      K_SECONDS(app_cfg.active_wait_timeout));
+	}
+}
+
 /* Message handler for STATE_INIT. */
 static void on_state_init(struct app_msg_data *msg)
 {
 	if (IS_EVENT(msg, data, DATA_EVT_CONFIG_INIT)) {
 		/* Keep a copy of the new configuration. */
-		app_cfg = msg->module.data.data.cfg;
+		app_cfg = msg->module.data->data.cfg;
 
 		if (app_cfg.active_mode) {
 			active_mode_timers_start_all();
@@ -404,7 +510,19 @@ static void on_state_running(struct app_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, app, APP_EVT_DATA_GET_ALL)) {
-		data_get();
+		data_sample();
+	}
+
+	if (IS_EVENT(msg, modem, MODEM_EVT_LTE_RRC_CONNECTED)) {
+		rrc_mode_update(true);
+	}
+
+	if (IS_EVENT(msg, modem, MODEM_EVT_LTE_RRC_IDLE)) {
+		rrc_mode_update(false);
+	}
+
+	if (IS_EVENT(msg, modem, MODEM_EVT_LTE_CELL_UPDATE)) {
+		cell_id = msg->module.modem->data.cell.cell_id;
 	}
 }
 
@@ -413,7 +531,7 @@ void on_sub_state_passive(struct app_msg_data *msg)
 {
 	if (IS_EVENT(msg, data, DATA_EVT_CONFIG_READY)) {
 		/* Keep a copy of the new configuration. */
-		app_cfg = msg->module.data.data.cfg;
+		app_cfg = msg->module.data->data.cfg;
 
 		if (app_cfg.active_mode) {
 			active_mode_timers_start_all();
@@ -428,7 +546,7 @@ void on_sub_state_passive(struct app_msg_data *msg)
 	    (IS_EVENT(msg, sensor, SENSOR_EVT_MOVEMENT_DATA_READY))) {
 
 		if (IS_EVENT(msg, ui, UI_EVT_BUTTON_DATA_READY) &&
-		    msg->module.ui.data.ui.button_number != 2) {
+		    msg->module.ui->data.ui.button_number != 2) {
 			return;
 		}
 
@@ -449,7 +567,7 @@ static void on_sub_state_active(struct app_msg_data *msg)
 {
 	if (IS_EVENT(msg, data, DATA_EVT_CONFIG_READY)) {
 		/* Keep a copy of the new configuration. */
-		app_cfg = msg->module.data.data.cfg;
+		app_cfg = msg->module.data->data.cfg;
 
 		if (!app_cfg.active_mode) {
 			passive_mode_timers_start_all();
@@ -468,6 +586,7 @@ static void on_all_events(struct app_msg_data *msg)
 		k_timer_stop(&data_sample_timer);
 		k_timer_stop(&movement_timeout_timer);
 		k_timer_stop(&movement_resolution_timer);
+		k_timer_stop(&sample_defer_timer);
 
 		SEND_SHUTDOWN_ACK(app, APP_EVT_SHUTDOWN_READY, self.id);
 		state_set(STATE_SHUTDOWN);
@@ -542,6 +661,7 @@ void main(void)
 		}
 
 		on_all_events(&msg);
+		module_release_msg(&msg);
 	}
 }
 
@@ -44,13 +44,13 @@ BUILD_ASSERT(CONFIG_CLOUD_CONNECT_RETRIES < 14,
 
 struct cloud_msg_data {
 	union {
-		struct app_module_event app;
-		struct data_module_event data;
-		struct modem_module_event modem;
-		struct cloud_module_event cloud;
-		struct util_module_event util;
-		struct gps_module_event gps;
-		struct debug_module_event debug;
+		struct app_module_event *app;
+		struct data_module_event *data;
+		struct modem_module_event *modem;
+		struct cloud_module_event *cloud;
+		struct util_module_event *util;
+		struct gps_module_event *gps;
+		struct debug_module_event *debug;
 	} module;
 };
 
@@ -176,49 +176,49 @@ static bool event_handler(const struct event_header *eh)
 	if (is_app_module_event(eh)) {
 		struct app_module_event *evt = cast_app_module_event(eh);
 
-		msg.module.app = *evt;
+		msg.module.app = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_data_module_event(eh)) {
 		struct data_module_event *evt = cast_data_module_event(eh);
 
-		msg.module.data = *evt;
+		msg.module.data = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_modem_module_event(eh)) {
 		struct modem_module_event *evt = cast_modem_module_event(eh);
 
-		msg.module.modem = *evt;
+		msg.module.modem = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_cloud_module_event(eh)) {
 		struct cloud_module_event *evt = cast_cloud_module_event(eh);
 
-		msg.module.cloud = *evt;
+		msg.module.cloud = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_util_module_event(eh)) {
 		struct util_module_event *evt = cast_util_module_event(eh);
 
-		msg.module.util = *evt;
+		msg.module.util = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_gps_module_event(eh)) {
 		struct gps_module_event *evt = cast_gps_module_event(eh);
 
-		msg.module.gps = *evt;
+		msg.module.gps = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_debug_module_event(eh)) {
 		struct debug_module_event *evt = cast_debug_module_event(eh);
 
-		msg.module.debug = *evt;
+		msg.module.debug = evt;
 		enqueue_msg = true;
 	}
 
@@ -766,19 +766,19 @@ static void on_sub_state_cloud_connected(struct cloud_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, data, DATA_EVT_AGPS_REQUEST_DATA_SEND)) {
-		agps_data_request_send(&msg->module.data);
+		agps_data_request_send(msg->module.data);
 	}
 
 	if (IS_EVENT(msg, debug, DEBUG_EVT_MEMFAULT_DATA_READY)) {
-		memfault_data_send(&msg->module.debug);
+		memfault_data_send(msg->module.debug);
 	}
 
 	if (IS_EVENT(msg, data, DATA_EVT_DATA_SEND)) {
-		data_send(&msg->module.data);
+		data_send(msg->module.data);
 	}
 
 	if (IS_EVENT(msg, data, DATA_EVT_CONFIG_SEND)) {
-		config_send(&msg->module.data);
+		config_send(msg->module.data);
 	}
 
 	if (IS_EVENT(msg, data, DATA_EVT_CONFIG_GET)) {
@@ -786,15 +786,15 @@ static void on_sub_state_cloud_connected(struct cloud_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, data, DATA_EVT_DATA_SEND_BATCH)) {
-		batch_data_send(&msg->module.data);
+		batch_data_send(msg->module.data);
 	}
 
 	if (IS_EVENT(msg, data, DATA_EVT_UI_DATA_SEND)) {
-		ui_data_send(&msg->module.data);
+		ui_data_send(msg->module.data);
 	}
 
 	if (IS_EVENT(msg, data, DATA_EVT_NEIGHBOR_CELLS_DATA_SEND)) {
-		neighbor_cells_data_send(&msg->module.data);
+		neighbor_cells_data_send(msg->module.data);
 	}
 
 	/* To properly initialize the nRF Cloud PGPS library we need to be connected to cloud and
@@ -843,12 +843,12 @@ static void on_all_states(struct cloud_msg_data *msg)
 		state_set(STATE_SHUTDOWN);
 	}
 
-	if (is_data_module_event(&msg->module.data.header)) {
-		switch (msg->module.data.type) {
+	if (is_data_module_event(&msg->module.data->header)) {
+		switch (msg->module.data->type) {
 		case DATA_EVT_CONFIG_INIT:
 			/* Fall through. */
 		case DATA_EVT_CONFIG_READY:
-			copy_cfg = msg->module.data.data.cfg;
+			copy_cfg = msg->module.data->data.cfg;
 			break;
 		default:
 			break;
@@ -860,7 +860,7 @@ static void on_all_states(struct cloud_msg_data *msg)
 		/* Keep a local copy of the incoming request. Used when injecting
 		 * P-GPS data into the modem.
 		 */
-		agps_request_convert(&agps_request, &msg->module.gps.data.agps_request);
+		agps_request_convert(&agps_request, &msg->module.gps->data.agps_request);
 	}
 #endif
 }
@@ -917,6 +917,7 @@ static void module_thread_fn(void)
 		}
 
 		on_all_states(&msg);
+		module_release_msg(&msg);
 	}
 }
 
@@ -45,14 +45,14 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_DATA_MODULE_LOG_LEVEL);
 
 struct data_msg_data {
 	union {
-		struct modem_module_event modem;
-		struct cloud_module_event cloud;
-		struct gps_module_event gps;
-		struct ui_module_event ui;
-		struct sensor_module_event sensor;
-		struct data_module_event data;
-		struct app_module_event app;
-		struct util_module_event util;
+		struct modem_module_event *modem;
+		struct cloud_module_event *cloud;
+		struct gps_module_event *gps;
+		struct ui_module_event *ui;
+		struct sensor_module_event *sensor;
+		struct data_module_event *data;
+		struct app_module_event *app;
+		struct util_module_event *util;
 	} module;
 };
 
@@ -143,6 +143,12 @@ static struct ack_data failed_data[CONFIG_FAILED_DATA_COUNT];
 /* Data that has been encoded and shipped on, but has not yet been ACKed. */
 static struct ack_data pending_data[CONFIG_PENDING_DATA_COUNT];
 
+/* Batch chunk that has been shipped on but not yet ACKed. Buffered data is sent one chunk at a
+ * time, the next chunk is encoded when the previous one has been ACKed. This bounds the heap
+ * needed for batch data regardless of how much data has been buffered.
+ */
+static void *batch_chunk_pending;
+
 /* Data module message queue. */
 #define DATA_QUEUE_ENTRY_COUNT		10
 #define DATA_QUEUE_BYTE_ALIGNMENT	4
@@ -203,21 +209,21 @@ static bool event_handler(const struct event_header *eh)
 	if (is_modem_module_event(eh)) {
 		struct modem_module_event *event = cast_modem_module_event(eh);
 
-		msg.module.modem = *event;
+		msg.module.modem = event;
 		enqueue_msg = true;
 	}
 
 	if (is_cloud_module_event(eh)) {
 		struct cloud_module_event *event = cast_cloud_module_event(eh);
 
-		msg.module.cloud = *event;
+		msg.module.cloud = event;
 		enqueue_msg = true;
 	}
 
 	if (is_gps_module_event(eh)) {
 		struct gps_module_event *event = cast_gps_module_event(eh);
 
-		msg.module.gps = *event;
+		msg.module.gps = event;
 		enqueue_msg = true;
 	}
 
@@ -225,35 +231,35 @@ static bool event_handler(const struct event_header *eh)
 		struct sensor_module_event *event =
 				cast_sensor_module_event(eh);
 
-		msg.module.sensor = *event;
+		msg.module.sensor = event;
 		enqueue_msg = true;
 	}
 
 	if (is_ui_module_event(eh)) {
 		struct ui_module_event *event = cast_ui_module_event(eh);
 
-		msg.module.ui = *event;
+		msg.module.ui = event;
 		enqueue_msg = true;
 	}
 
 	if (is_app_module_event(eh)) {
 		struct app_module_event *event = cast_app_module_event(eh);
 
-		msg.module.app = *event;
+		msg.module.app = event;
 		enqueue_msg = true;
 	}
 
 	if (is_data_module_event(eh)) {
 		struct data_module_event *event = cast_data_module_event(eh);
 
-		msg.module.data = *event;
+		msg.module.data = event;
 		enqueue_msg = true;
 	}
 
 	if (is_util_module_event(eh)) {
 		struct util_module_event *event = cast_util_module_event(eh);
 
-		msg.module.util = *event;
+		msg.module.util = event;
 		enqueue_msg = true;
 	}
 
@@ -548,6 +554,48 @@ static void data_send(enum data_module_event_type event,
 	data->len = 0;
 }
 
+/* Encode the next chunk of buffered data. Entries that do not fit in the chunk are left queued
+ * in their ringbuffers and are encoded when the chunk has been ACKed.
+ */
+static void data_encode_batch(void)
+{
+	int err;
+	struct cloud_codec_data codec = {0};
+
+	if (batch_chunk_pending != NULL) {
+		LOG_DBG("Batch chunk %p not yet ACKed, deferring", batch_chunk_pending);
+		return;
+	}
+
+	err = cloud_codec_encode_batch_data(&codec,
+					gps_buf,
+					sensors_buf,
+					modem_dyn_buf,
+					ui_buf,
+					accel_buf,
+					bat_buf,
+					ARRAY_SIZE(gps_buf),
+					ARRAY_SIZE(sensors_buf),
+					ARRAY_SIZE(modem_dyn_buf),
+					ARRAY_SIZE(ui_buf),
+					ARRAY_SIZE(accel_buf),
+					ARRAY_SIZE(bat_buf));
+	switch (err) {
+	case 0:
+		LOG_DBG("Batch data encoded successfully");
+		batch_chunk_pending = codec.buf;
+		data_send(DATA_EVT_DATA_SEND_BATCH, BATCH, &codec);
+		break;
+	case -ENODATA:
+		LOG_DBG("No batch data to encode, ringbuffers are empty");
+		break;
+	default:
+		LOG_ERR("Error batch-enconding data: %d", err);
+		SEND_ERROR(data, DATA_EVT_ERROR, err);
+		break;
+	}
+}
+
 /* This function allocates buffer on the heap, which needs to be freed after use. */
 static void data_encode(void)
 {
@@ -606,32 +654,7 @@ static void data_encode(void)
 		return;
 	}
 
-	err = cloud_codec_encode_batch_data(&codec,
-					gps_buf,
-					sensors_buf,
-					modem_dyn_buf,
-					ui_buf,
-					accel_buf,
-					bat_buf,
-					ARRAY_SIZE(gps_buf),
-					ARRAY_SIZE(sensors_buf),
-					ARRAY_SIZE(modem_dyn_buf),
-					ARRAY_SIZE(ui_buf),
-					ARRAY_SIZE(accel_buf),
-					ARRAY_SIZE(bat_buf));
-	switch (err) {
-	case 0:
-		LOG_DBG("Batch data encoded successfully");
-		data_send(DATA_EVT_DATA_SEND_BATCH, BATCH, &codec);
-		break;
-	case -ENODATA:
-		LOG_DBG("No batch data to encode, ringbuffers are empty");
-		break;
-	default:
-		LOG_ERR("Error batch-enconding data: %d", err);
-		SEND_ERROR(data, DATA_EVT_ERROR, err);
-		return;
-	}
+	data_encode_batch();
 }
 
 #if defined(CONFIG_AGPS) && !defined(CONFIG_NRF_CLOUD_MQTT) && !defined(CONFIG_AGPS_SRC_SUPL)
@@ -1069,6 +1092,8 @@ static void on_cloud_state_connected(struct data_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, cloud, CLOUD_EVT_DISCONNECTED)) {
+		/* A batch chunk in flight will not be ACKed, start over on the next connection. */
+		batch_chunk_pending = NULL;
 		state_set(STATE_CLOUD_DISCONNECTED);
 		return;
 	}
@@ -1086,21 +1111,21 @@ static void on_all_states(struct data_msg_data *msg)
 	if (IS_EVENT(msg, cloud, CLOUD_EVT_CONFIG_RECEIVED)) {
 		struct cloud_data_cfg new = {
 			.active_mode =
-				msg->module.cloud.data.config.active_mode,
+				msg->module.cloud->data.config.active_mode,
 			.active_wait_timeout =
-				msg->module.cloud.data.config.active_wait_timeout,
+				msg->module.cloud->data.config.active_wait_timeout,
 			.movement_resolution =
-				msg->module.cloud.data.config.movement_resolution,
+				msg->module.cloud->data.config.movement_resolution,
 			.movement_timeout =
-				msg->module.cloud.data.config.movement_timeout,
+				msg->module.cloud->data.config.movement_timeout,
 			.gps_timeout =
-				msg->module.cloud.data.config.gps_timeout,
+				msg->module.cloud->data.config.gps_timeout,
 			.accelerometer_threshold =
-				msg->module.cloud.data.config.accelerometer_threshold,
+				msg->module.cloud->data.config.accelerometer_threshold,
 			.no_data.gnss =
-				msg->module.cloud.data.config.no_data.gnss,
+				msg->module.cloud->data.config.no_data.gnss,
 			.no_data.neighbor_cell =
-				msg->module.cloud.data.config.no_data.neighbor_cell
+				msg->module.cloud->data.config.no_data.neighbor_cell
 		};
 
 		new_config_handle(&new);
@@ -1108,7 +1133,7 @@ static void on_all_states(struct data_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, gps, GPS_EVT_AGPS_NEEDED)) {
-		agps_request_handle(&msg->module.gps.data.agps_request);
+		agps_request_handle(&msg->module.gps->data.agps_request);
 		return;
 	}
 
@@ -1129,22 +1154,22 @@ static void on_all_states(struct data_msg_data *msg)
 		/* Store which data is requested by the app, later to be used
 		 * to confirm data is reported to the data manger.
 		 */
-		requested_data_list_set(msg->module.app.data_list,
-					msg->module.app.count);
+		requested_data_list_set(msg->module.app->data_list,
+					msg->module.app->count);
 
 		/* Start countdown until data must have been received by the
 		 * Data module in order to be sent to cloud
 		 */
 		k_work_reschedule(&data_send_work,
-				      K_SECONDS(msg->module.app.timeout));
+				      K_SECONDS(msg->module.app->timeout));
 
 		return;
 	}
 
 	if (IS_EVENT(msg, ui, UI_EVT_BUTTON_DATA_READY)) {
 		struct cloud_data_ui new_ui_data = {
-			.btn = msg->module.ui.data.ui.button_number,
-			.btn_ts = msg->module.ui.data.ui.timestamp,
+			.btn = msg->module.ui->data.ui.button_number,
+			.btn_ts = msg->module.ui->data.ui.timestamp,
 			.queued = true
 		};
 
@@ -1161,29 +1186,29 @@ static void on_all_states(struct data_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, modem, MODEM_EVT_MODEM_STATIC_DATA_READY)) {
-		modem_stat.nw_lte_m = msg->module.modem.data.modem_static.nw_mode_ltem;
-		modem_stat.nw_nb_iot = msg->module.modem.data.modem_static.nw_mode_nbiot;
-		modem_stat.nw_gps = msg->module.modem.data.modem_static.nw_mode_gps;
-		modem_stat.bnd = msg->module.modem.data.modem_static.band;
-		modem_stat.ts = msg->module.modem.data.modem_static.timestamp;
+		modem_stat.nw_lte_m = msg->module.modem->data.modem_static.nw_mode_ltem;
+		modem_stat.nw_nb_iot = msg->module.modem->data.modem_static.nw_mode_nbiot;
+		modem_stat.nw_gps = msg->module.modem->data.modem_static.nw_mode_gps;
+		modem_stat.bnd = msg->module.modem->data.modem_static.band;
+		modem_stat.ts = msg->module.modem->data.modem_static.timestamp;
 		modem_stat.queued = true;
 
 		BUILD_ASSERT(sizeof(modem_stat.appv) >=
-			     sizeof(msg->module.modem.data.modem_static.app_version));
+			     sizeof(msg->module.modem->data.modem_static.app_version));
 
 		BUILD_ASSERT(sizeof(modem_stat.brdv) >=
-			     sizeof(msg->module.modem.data.modem_static.board_version));
+			     sizeof(msg->module.modem->data.modem_static.board_version));
 
 		BUILD_ASSERT(sizeof(modem_stat.fw) >=
-			     sizeof(msg->module.modem.data.modem_static.modem_fw));
+			     sizeof(msg->module.modem->data.modem_static.modem_fw));
 
 		BUILD_ASSERT(sizeof(modem_stat.iccid) >=
-			     sizeof(msg->module.modem.data.modem_static.iccid));
+			     sizeof(msg->module.modem->data.modem_static.iccid));
 
-		strcpy(modem_stat.appv, msg->module.modem.data.modem_static.app_version);
-		strcpy(modem_stat.brdv, msg->module.modem.data.modem_static.board_version);
-		strcpy(modem_stat.fw, msg->module.modem.data.modem_static.modem_fw);
-		strcpy(modem_stat.iccid, msg->module.modem.data.modem_static.iccid);
+		strcpy(modem_stat.appv, msg->module.modem->data.modem_static.app_version);
+		strcpy(modem_stat.brdv, msg->module.modem->data.modem_static.board_version);
+		strcpy(modem_stat.fw, msg->module.modem->data.modem_static.modem_fw);
+		strcpy(modem_stat.iccid, msg->module.modem->data.modem_static.iccid);
 
 		requested_data_status_set(APP_DATA_MODEM_STATIC);
 	}
@@ -1194,27 +1219,27 @@ static void on_all_states(struct data_msg_data *msg)
 
 	if (IS_EVENT(msg, modem, MODEM_EVT_MODEM_DYNAMIC_DATA_READY)) {
 		struct cloud_data_modem_dynamic new_modem_data = {
-			.area = msg->module.modem.data.modem_dynamic.area_code,
-			.cell = msg->module.modem.data.modem_dynamic.cell_id,
-			.rsrp = msg->module.modem.data.modem_dynamic.rsrp,
-			.ts = msg->module.modem.data.modem_dynamic.timestamp,
-
-			.area_code_fresh = msg->module.modem.data.modem_dynamic.area_code_fresh,
-			.cell_id_fresh = msg->module.modem.data.modem_dynamic.cell_id_fresh,
-			.rsrp_fresh = msg->module.modem.data.modem_dynamic.rsrp_fresh,
-			.ip_address_fresh = msg->module.modem.data.modem_dynamic.ip_address_fresh,
-			.mccmnc_fresh = msg->module.modem.data.modem_dynamic.mccmnc_fresh,
+			.area = msg->module.modem->data.modem_dynamic.area_code,
+			.cell = msg->module.modem->data.modem_dynamic.cell_id,
+			.rsrp = msg->module.modem->data.modem_dynamic.rsrp,
+			.ts = msg->module.modem->data.modem_dynamic.timestamp,
+
+			.area_code_fresh = msg->module.modem->data.modem_dynamic.area_code_fresh,
+			.cell_id_fresh = msg->module.modem->data.modem_dynamic.cell_id_fresh,
+			.rsrp_fresh = msg->module.modem->data.modem_dynamic.rsrp_fresh,
+			.ip_address_fresh = msg->module.modem->data.modem_dynamic.ip_address_fresh,
+			.mccmnc_fresh = msg->module.modem->data.modem_dynamic.mccmnc_fresh,
 			.queued = true
 		};
 
 		BUILD_ASSERT(sizeof(new_modem_data.ip) >=
-			     sizeof(msg->module.modem.data.modem_dynamic.ip_address));
+			     sizeof(msg->module.modem->data.modem_dynamic.ip_address));
 
 		BUILD_ASSERT(sizeof(new_modem_data.mccmnc) >=
-			     sizeof(msg->module.modem.data.modem_dynamic.mccmnc));
+			     sizeof(msg->module.modem->data.modem_dynamic.mccmnc));
 
-		strcpy(new_modem_data.ip, msg->module.modem.data.modem_dynamic.ip_address);
-		strcpy(new_modem_data.mccmnc, msg->module.modem.data.modem_dynamic.mccmnc);
+		strcpy(new_modem_data.ip, msg->module.modem->data.modem_dynamic.ip_address);
+		strcpy(new_modem_data.mccmnc, msg->module.modem->data.modem_dynamic.mccmnc);
 
 		cloud_codec_populate_modem_dynamic_buffer(
 						modem_dyn_buf,
@@ -1231,8 +1256,8 @@ static void on_all_states(struct data_msg_data *msg)
 
 	if (IS_EVENT(msg, modem, MODEM_EVT_BATTERY_DATA_READY)) {
 		struct cloud_data_battery new_battery_data = {
-			.bat = msg->module.modem.data.bat.battery_voltage,
-			.bat_ts = msg->module.modem.data.bat.timestamp,
+			.bat = msg->module.modem->data.bat.battery_voltage,
+			.bat_ts = msg->module.modem->data.bat.timestamp,
 			.queued = true
 		};
 
@@ -1245,9 +1270,9 @@ static void on_all_states(struct data_msg_data *msg)
 
 	if (IS_EVENT(msg, sensor, SENSOR_EVT_ENVIRONMENTAL_DATA_READY)) {
 		struct cloud_data_sensors new_sensor_data = {
-			.temp = msg->module.sensor.data.sensors.temperature,
-			.hum = msg->module.sensor.data.sensors.humidity,
-			.env_ts = msg->module.sensor.data.sensors.timestamp,
+			.temp = msg->module.sensor->data.sensors.temperature,
+			.hum = msg->module.sensor->data.sensors.humidity,
+			.env_ts = msg->module.sensor->data.sensors.timestamp,
 			.queued = true
 		};
 
@@ -1265,10 +1290,10 @@ static void on_all_states(struct data_msg_data *msg)
 
 	if (IS_EVENT(msg, sensor, SENSOR_EVT_MOVEMENT_DATA_READY)) {
 		struct cloud_data_accelerometer new_movement_data = {
-			.values[0] = msg->module.sensor.data.accel.values[0],
-			.values[1] = msg->module.sensor.data.accel.values[1],
-			.values[2] = msg->module.sensor.data.accel.values[2],
-			.ts = msg->module.sensor.data.accel.timestamp,
+			.values[0] = msg->module.sensor->data.accel.values[0],
+			.values[1] = msg->module.sensor->data.accel.values[1],
+			.values[2] = msg->module.sensor->data.accel.values[2],
+			.ts = msg->module.sensor->data.accel.timestamp,
 			.queued = true
 		};
 
@@ -1279,29 +1304,29 @@ static void on_all_states(struct data_msg_data *msg)
 
 	if (IS_EVENT(msg, gps, GPS_EVT_DATA_READY)) {
 		struct cloud_data_gps new_gps_data = {
-			.gps_ts = msg->module.gps.data.gps.timestamp,
+			.gps_ts = msg->module.gps->data.gps.timestamp,
 			.queued = true,
-			.format = msg->module.gps.data.gps.format
+			.format = msg->module.gps->data.gps.format
 		};
 
-		switch (msg->module.gps.data.gps.format) {
+		switch (msg->module.gps->data.gps.format) {
 		case GPS_MODULE_DATA_FORMAT_PVT: {
 			/* Add PVT data */
-			new_gps_data.pvt.acc = msg->module.gps.data.gps.pvt.accuracy;
-			new_gps_data.pvt.alt = msg->module.gps.data.gps.pvt.altitude;
-			new_gps_data.pvt.hdg = msg->module.gps.data.gps.pvt.heading;
-			new_gps_data.pvt.lat = msg->module.gps.data.gps.pvt.latitude;
-			new_gps_data.pvt.longi = msg->module.gps.data.gps.pvt.longitude;
-			new_gps_data.pvt.spd = msg->module.gps.data.gps.pvt.speed;
+			new_gps_data.pvt.acc = msg->module.gps->data.gps.pvt.accuracy;
+			new_gps_data.pvt.alt = msg->module.gps->data.gps.pvt.altitude;
+			new_gps_data.pvt.hdg = msg->module.gps->data.gps.pvt.heading;
+			new_gps_data.pvt.lat = msg->module.gps->data.gps.pvt.latitude;
+			new_gps_data.pvt.longi = msg->module.gps->data.gps.pvt.longitude;
+			new_gps_data.pvt.spd = msg->module.gps->data.gps.pvt.speed;
 
 		};
 			break;
 		case GPS_MODULE_DATA_FORMAT_NMEA: {
 			/* Add NMEA data */
 			BUILD_ASSERT(sizeof(new_gps_data.nmea) >=
-				     sizeof(msg->module.gps.data.gps.nmea));
+				     sizeof(msg->module.gps->data.gps.nmea));
 
-			strcpy(new_gps_data.nmea, msg->module.gps.data.gps.nmea);
+			strcpy(new_gps_data.nmea, msg->module.gps->data.gps.nmea);
 		};
 			break;
 		case GPS_MODULE_DATA_FORMAT_INVALID:
@@ -1320,19 +1345,19 @@ static void on_all_states(struct data_msg_data *msg)
 
 	if (IS_EVENT(msg, modem, MODEM_EVT_NEIGHBOR_CELLS_DATA_READY)) {
 		BUILD_ASSERT(sizeof(neighbor_cells.cell_data) ==
-			     sizeof(msg->module.modem.data.neighbor_cells.cell_data));
+			     sizeof(msg->module.modem->data.neighbor_cells.cell_data));
 
 		BUILD_ASSERT(sizeof(neighbor_cells.neighbor_cells) ==
-			     sizeof(msg->module.modem.data.neighbor_cells.neighbor_cells));
+			     sizeof(msg->module.modem->data.neighbor_cells.neighbor_cells));
 
-		memcpy(&neighbor_cells.cell_data, &msg->module.modem.data.neighbor_cells.cell_data,
+		memcpy(&neighbor_cells.cell_data, &msg->module.modem->data.neighbor_cells.cell_data,
 		       sizeof(neighbor_cells.cell_data));
 
 		memcpy(&neighbor_cells.neighbor_cells,
-		       &msg->module.modem.data.neighbor_cells.neighbor_cells,
+		       &msg->module.modem->data.neighbor_cells.neighbor_cells,
 		       sizeof(neighbor_cells.neighbor_cells));
 
-		neighbor_cells.ts = msg->module.modem.data.neighbor_cells.timestamp;
+		neighbor_cells.ts = msg->module.modem->data.neighbor_cells.timestamp;
 		neighbor_cells.queued = true;
 
 		requested_data_status_set(APP_DATA_NEIGHBOR_CELLS);
@@ -1347,8 +1372,21 @@ static void on_all_states(struct data_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, cloud, CLOUD_EVT_DATA_ACK)) {
-		data_ack(msg->module.cloud.data.ack.ptr,
-			 msg->module.cloud.data.ack.sent);
+		void *ptr = msg->module.cloud->data.ack.ptr;
+		bool sent = msg->module.cloud->data.ack.sent;
+
+		data_ack(ptr, sent);
+
+		if ((ptr != NULL) && (ptr == batch_chunk_pending)) {
+			batch_chunk_pending = NULL;
+
+			/* Continue with the next chunk of buffered data. If the chunk failed, it is
+			 * resent together with the remaining data on the next data publication.
+			 */
+			if (sent && (state == STATE_CLOUD_CONNECTED)) {
+				data_encode_batch();
+			}
+		}
 	}
 }
 
@@ -1394,6 +1432,7 @@ static void module_thread_fn(void)
 		}
 
 		on_all_states(&msg);
+		module_release_msg(&msg);
 	}
 }
 
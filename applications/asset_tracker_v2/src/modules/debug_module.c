@@ -32,14 +32,14 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_DEBUG_MODULE_LOG_LEVEL);
 
 struct debug_msg_data {
 	union {
-		struct cloud_module_event cloud;
-		struct util_module_event util;
-		struct ui_module_event ui;
-		struct sensor_module_event sensor;
-		struct data_module_event data;
-		struct app_module_event app;
-		struct gps_module_event gps;
-		struct modem_module_event modem;
+		struct cloud_module_event *cloud;
+		struct util_module_event *util;
+		struct ui_module_event *ui;
+		struct sensor_module_event *sensor;
+		struct data_module_event *data;
+		struct app_module_event *app;
+		struct gps_module_event *gps;
+		struct modem_module_event *modem;
 	} module;
 };
 
@@ -79,7 +79,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_modem_module_event(eh)) {
 		struct modem_module_event *event = cast_modem_module_event(eh);
 		struct debug_msg_data debug_msg = {
-			.module.modem = *event
+			.module.modem = event
 		};
 
 		message_handler(&debug_msg);
@@ -88,7 +88,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_cloud_module_event(eh)) {
 		struct cloud_module_event *event = cast_cloud_module_event(eh);
 		struct debug_msg_data debug_msg = {
-			.module.cloud = *event
+			.module.cloud = event
 		};
 
 		message_handler(&debug_msg);
@@ -97,7 +97,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_gps_module_event(eh)) {
 		struct gps_module_event *event = cast_gps_module_event(eh);
 		struct debug_msg_data debug_msg = {
-			.module.gps = *event
+			.module.gps = event
 		};
 
 		message_handler(&debug_msg);
@@ -107,7 +107,7 @@ static bool event_handler(const struct event_header *eh)
 		struct sensor_module_event *event =
 				cast_sensor_module_event(eh);
 		struct debug_msg_data debug_msg = {
-			.module.sensor = *event
+			.module.sensor = event
 		};
 
 		message_handler(&debug_msg);
@@ -116,7 +116,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_ui_module_event(eh)) {
 		struct ui_module_event *event = cast_ui_module_event(eh);
 		struct debug_msg_data debug_msg = {
-			.module.ui = *event
+			.module.ui = event
 		};
 
 		message_handler(&debug_msg);
@@ -125,7 +125,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_app_module_event(eh)) {
 		struct app_module_event *event = cast_app_module_event(eh);
 		struct debug_msg_data debug_msg = {
-			.module.app = *event
+			.module.app = event
 		};
 
 		message_handler(&debug_msg);
@@ -134,7 +134,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_data_module_event(eh)) {
 		struct data_module_event *event = cast_data_module_event(eh);
 		struct debug_msg_data debug_msg = {
-			.module.data = *event
+			.module.data = event
 		};
 
 		message_handler(&debug_msg);
@@ -143,7 +143,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_util_module_event(eh)) {
 		struct util_module_event *event = cast_util_module_event(eh);
 		struct debug_msg_data debug_msg = {
-			.module.util = *event
+			.module.util = event
 		};
 
 		message_handler(&debug_msg);
@@ -311,9 +311,9 @@ static void memfault_handle_event(struct debug_msg_data *msg)
 
 	if ((IS_EVENT(msg, gps, GPS_EVT_TIMEOUT)) ||
 	    (IS_EVENT(msg, gps, GPS_EVT_DATA_READY))) {
-		add_gps_metrics(msg->module.gps.data.gps.satellites_tracked,
-				msg->module.gps.data.gps.search_time,
-				msg->module.gps.type);
+		add_gps_metrics(msg->module.gps->data.gps.satellites_tracked,
+				msg->module.gps->data.gps.search_time,
+				msg->module.gps->type);
 		return;
 	}
 }
@@ -36,11 +36,11 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_GPS_MODULE_LOG_LEVEL);
 
 struct gps_msg_data {
 	union {
-		struct app_module_event app;
-		struct data_module_event data;
-		struct util_module_event util;
-		struct modem_module_event modem;
-		struct gps_module_event gps;
+		struct app_module_event *app;
+		struct data_module_event *data;
+		struct util_module_event *util;
+		struct modem_module_event *modem;
+		struct gps_module_event *gps;
 	} module;
 };
 
@@ -150,7 +150,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_app_module_event(eh)) {
 		struct app_module_event *event = cast_app_module_event(eh);
 		struct gps_msg_data msg = {
-			.module.app = *event
+			.module.app = event
 		};
 
 		message_handler(&msg);
@@ -159,7 +159,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_data_module_event(eh)) {
 		struct data_module_event *event = cast_data_module_event(eh);
 		struct gps_msg_data msg = {
-			.module.data = *event
+			.module.data = event
 		};
 
 		message_handler(&msg);
@@ -168,7 +168,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_util_module_event(eh)) {
 		struct util_module_event *event = cast_util_module_event(eh);
 		struct gps_msg_data msg = {
-			.module.util = *event
+			.module.util = event
 		};
 
 		message_handler(&msg);
@@ -177,7 +177,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_gps_module_event(eh)) {
 		struct gps_module_event *event = cast_gps_module_event(eh);
 		struct gps_msg_data msg = {
-			.module.gps = *event
+			.module.gps = event
 		};
 
 		message_handler(&msg);
@@ -186,7 +186,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_modem_module_event(eh)) {
 		struct modem_module_event *event = cast_modem_module_event(eh);
 		struct gps_msg_data msg = {
-			.module.modem = *event
+			.module.modem = event
 		};
 
 		message_handler(&msg);
@@ -554,7 +554,7 @@ static int setup(void)
 static void on_state_init(struct gps_msg_data *msg)
 {
 	if (IS_EVENT(msg, data, DATA_EVT_CONFIG_INIT)) {
-		gnss_timeout = msg->module.data.data.cfg.gps_timeout;
+		gnss_timeout = msg->module.data->data.cfg.gps_timeout;
 	}
 }
 
@@ -562,7 +562,7 @@ static void on_state_init(struct gps_msg_data *msg)
 static void on_state_running(struct gps_msg_data *msg)
 {
 	if (IS_EVENT(msg, data, DATA_EVT_CONFIG_READY)) {
-		gnss_timeout = msg->module.data.data.cfg.gps_timeout;
+		gnss_timeout = msg->module.data->data.cfg.gps_timeout;
 	}
 }
 
@@ -574,8 +574,8 @@ static void on_state_running_gps_search(struct gps_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, app, APP_EVT_DATA_GET)) {
-		if (!gps_data_requested(msg->module.app.data_list,
-					msg->module.app.count)) {
+		if (!gps_data_requested(msg->module.app->data_list,
+					msg->module.app->count)) {
 			return;
 		}
 
@@ -593,8 +593,8 @@ static void on_state_running_gps_idle(struct gps_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, app, APP_EVT_DATA_GET)) {
-		if (!gps_data_requested(msg->module.app.data_list,
-					msg->module.app.count)) {
+		if (!gps_data_requested(msg->module.app->data_list,
+					msg->module.app->count)) {
 			return;
 		}
 
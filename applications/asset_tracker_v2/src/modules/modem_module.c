@@ -37,10 +37,10 @@ BUILD_ASSERT(!IS_ENABLED(CONFIG_LTE_AUTO_INIT_AND_CONNECT),
 
 struct modem_msg_data {
 	union {
-		struct app_module_event app;
-		struct cloud_module_event cloud;
-		struct util_module_event util;
-		struct modem_module_event modem;
+		struct app_module_event *app;
+		struct cloud_module_event *cloud;
+		struct util_module_event *util;
+		struct modem_module_event *modem;
 	} module;
 };
 
@@ -124,28 +124,28 @@ static bool event_handler(const struct event_header *eh)
 	if (is_modem_module_event(eh)) {
 		struct modem_module_event *evt = cast_modem_module_event(eh);
 
-		msg.module.modem = *evt;
+		msg.module.modem = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_app_module_event(eh)) {
 		struct app_module_event *evt = cast_app_module_event(eh);
 
-		msg.module.app = *evt;
+		msg.module.app = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_cloud_module_event(eh)) {
 		struct cloud_module_event *evt = cast_cloud_module_event(eh);
 
-		msg.module.cloud = *evt;
+		msg.module.cloud = evt;
 		enqueue_msg = true;
 	}
 
 	if (is_util_module_event(eh)) {
 		struct util_module_event *evt = cast_util_module_event(eh);
 
-		msg.module.util = *evt;
+		msg.module.util = evt;
 		enqueue_msg = true;
 	}
 
@@ -208,6 +208,12 @@ static void lte_evt_handler(const struct lte_lc_evt *const evt)
 		LOG_DBG("RRC mode: %s",
 			evt->rrc_mode == LTE_LC_RRC_MODE_CONNECTED ?
 			"Connected" : "Idle");
+
+		if (evt->rrc_mode == LTE_LC_RRC_MODE_CONNECTED) {
+			SEND_EVENT(modem, MODEM_EVT_LTE_RRC_CONNECTED);
+		} else {
+			SEND_EVENT(modem, MODEM_EVT_LTE_RRC_IDLE);
+		}
 		break;
 	case LTE_LC_EVT_CELL_UPDATE:
 		LOG_DBG("LTE cell changed: Cell ID: %d, Tracking area: %d",
@@ -880,8 +886,8 @@ static void on_all_states(struct modem_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, app, APP_EVT_DATA_GET)) {
-		if (static_modem_data_requested(msg->module.app.data_list,
-						msg->module.app.count)) {
+		if (static_modem_data_requested(msg->module.app->data_list,
+						msg->module.app->count)) {
 
 			int err;
 
@@ -892,8 +898,8 @@ static void on_all_states(struct modem_msg_data *msg)
 			}
 		}
 
-		if (dynamic_modem_data_requested(msg->module.app.data_list,
-						 msg->module.app.count)) {
+		if (dynamic_modem_data_requested(msg->module.app->data_list,
+						 msg->module.app->count)) {
 
 			int err;
 
@@ -904,8 +910,8 @@ static void on_all_states(struct modem_msg_data *msg)
 			}
 		}
 
-		if (battery_data_requested(msg->module.app.data_list,
-					   msg->module.app.count)) {
+		if (battery_data_requested(msg->module.app->data_list,
+					   msg->module.app->count)) {
 
 			int err;
 
@@ -916,8 +922,8 @@ static void on_all_states(struct modem_msg_data *msg)
 			}
 		}
 
-		if (neighbor_cells_data_requested(msg->module.app.data_list,
-						  msg->module.app.count)) {
+		if (neighbor_cells_data_requested(msg->module.app->data_list,
+						  msg->module.app->count)) {
 			int err;
 
 			err = neighbor_cells_measurement_start();
@@ -985,6 +991,7 @@ static void module_thread_fn(void)
 		}
 
 		on_all_states(&msg);
+		module_release_msg(&msg);
 	}
 }
 
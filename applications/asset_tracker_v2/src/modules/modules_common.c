@@ -13,10 +13,8 @@
 
 LOG_MODULE_REGISTER(modules_common, CONFIG_MODULES_COMMON_LOG_LEVEL);
 
-struct event_prototype {
-	struct event_header header;
-	uint8_t event_id;
-};
+BUILD_ASSERT(IS_ENABLED(CONFIG_EVENT_MANAGER_EVENT_REF),
+	     "Module message queues require event reference counting");
 
 /* List containing metadata on active modules in the application. */
 static sys_slist_t module_list = SYS_SLIST_STATIC_INIT(&module_list);
@@ -33,7 +31,14 @@ static struct modules_info {
 /* Public interface */
 void module_purge_queue(struct module_data *module)
 {
-	k_msgq_purge(module->msg_q);
+	struct module_msg msg;
+
+	__ASSERT_NO_MSG(module->msg_q->msg_size == sizeof(msg));
+
+	/* Release the events referenced by the purged messages. */
+	while (k_msgq_get(module->msg_q, &msg, K_NO_WAIT) == 0) {
+		module_release_msg(&msg);
+	}
 }
 
 int module_get_next_msg(struct module_data *module, void *msg)
@@ -41,13 +46,10 @@ int module_get_next_msg(struct module_data *module, void *msg)
 	int err = k_msgq_get(module->msg_q, msg, K_FOREVER);
 
 	if (err == 0 && IS_ENABLED(CONFIG_MODULES_COMMON_LOG_LEVEL_DBG)) {
-		struct event_prototype *evt_proto =
-			(struct event_prototype *)msg;
-		struct event_type *event =
-			(struct event_type *)evt_proto->header.type_id;
+		const struct event_header *eh = ((struct module_msg *)msg)->header;
 		char buf[50];
 
-		event->log_event(&evt_proto->header, buf, sizeof(buf));
+		eh->type_id->log_event(eh, buf, sizeof(buf));
 
 		LOG_DBG("%s module: Dequeued %s",
 			module->name,
@@ -60,9 +62,17 @@ int module_get_next_msg(struct module_data *module, void *msg)
 int module_enqueue_msg(struct module_data *module, void *msg)
 {
 	int err;
+	uint32_t depth;
+	const struct event_header *eh = ((struct module_msg *)msg)->header;
+
+	/* The message only points to the event, keep the event until the message is released. */
+	event_manager_event_ref(eh);
 
 	err = k_msgq_put(module->msg_q, msg, K_NO_WAIT);
 	if (err) {
+		event_manager_event_unref(eh);
+		module->msg_q_drop_count++;
+
 		LOG_WRN("%s: Message could not be enqueued, error code: %d",
 			module->name, err);
 			/* Purge message queue before reporting an error. This
@@ -77,14 +87,18 @@ int module_enqueue_msg(struct module_data *module, void *msg)
 		return err;
 	}
 
+	depth = k_msgq_num_used_get(module->msg_q);
+	if (depth > module->msg_q_depth_max) {
+		module->msg_q_depth_max = depth;
+
+		LOG_DBG("%s module: Message queue depth %d of %d", log_strdup(module->name),
+			depth, module->msg_q->max_msgs);
+	}
+
 	if (IS_ENABLED(CONFIG_MODULES_COMMON_LOG_LEVEL_DBG)) {
-		struct event_prototype *evt_proto =
-			(struct event_prototype *)msg;
-		struct event_type *event =
-			(struct event_type *)evt_proto->header.type_id;
 		char buf[50];
 
-		event->log_event(&evt_proto->header, buf, sizeof(buf));
+		eh->type_id->log_event(eh, buf, sizeof(buf));
 
 		LOG_DBG("%s module: Enqueued: %s", log_strdup(module->name),
 			log_strdup(buf));
@@ -93,6 +107,11 @@ int module_enqueue_msg(struct module_data *module, void *msg)
 	return 0;
 }
 
+void module_release_msg(void *msg)
+{
+	event_manager_event_unref(((struct module_msg *)msg)->header);
+}
+
 bool modules_shutdown_register(uint32_t id_reg)
 {
 	bool retval = false;
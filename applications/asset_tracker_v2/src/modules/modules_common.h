@@ -10,8 +10,8 @@
 #include <zephyr.h>
 
 #define IS_EVENT(_ptr, _mod, _evt) \
-		is_ ## _mod ## _module_event(&_ptr->module._mod.header) &&		\
-		_ptr->module._mod.type == _evt
+		is_ ## _mod ## _module_event(&_ptr->module._mod->header) &&		\
+		_ptr->module._mod->type == _evt
 
 #define SEND_EVENT(_mod, _type)								\
 	struct _mod ## _module_event *event = new_ ## _mod ## _module_event();		\
@@ -30,6 +30,13 @@
 	event->data.id = _id;								\
 	EVENT_SUBMIT(event)
 
+/* Module messages are unions of pointers to the events that a module subscribes to. All members
+ * point to the same event, which is kept alive by a reference while the message is queued.
+ */
+struct module_msg {
+	const struct event_header *header;
+};
+
 struct module_data {
 	/* Variable used to construct a linked list of module metadata. */
 	sys_snode_t header;
@@ -40,18 +47,29 @@ struct module_data {
 	struct k_msgq *msg_q;
 	/* Flag signifying if the module supports shutdown. */
 	bool supports_shutdown;
+	/* Highest number of messages waiting in the message queue. */
+	uint32_t msg_q_depth_max;
+	/* Number of messages that could not be enqueued because the message queue was full. */
+	uint32_t msg_q_drop_count;
 };
 
 void module_purge_queue(struct module_data *module);
 
 int module_get_next_msg(struct module_data *module, void *msg);
 
-/** @brief Enqueue message to a module's queue.
+/** @brief Enqueue message to a module's queue. A reference to the event that the message points
+ *	   to is held until the message is released with module_release_msg().
  *
  *  @return 0 if successful, otherwise a negative error code.
  */
 int module_enqueue_msg(struct module_data *module, void *msg);
 
+/** @brief Release a message obtained with module_get_next_msg(), after it has been processed.
+ *
+ *  @param msg Pointer to the message.
+ */
+void module_release_msg(void *msg);
+
 /** @brief Register that a module has performed a graceful shutdown.
  *
  *  @param id_reg Identifier of module.
@@ -26,9 +26,9 @@ LOG_MODULE_REGISTER(sensor_module, CONFIG_SENSOR_MODULE_LOG_LEVEL);
 
 struct sensor_msg_data {
 	union {
-		struct app_module_event app;
-		struct data_module_event data;
-		struct util_module_event util;
+		struct app_module_event *app;
+		struct data_module_event *data;
+		struct util_module_event *util;
 	} module;
 };
 
@@ -90,21 +90,21 @@ static bool event_handler(const struct event_header *eh)
 	if (is_app_module_event(eh)) {
 		struct app_module_event *event = cast_app_module_event(eh);
 
-		msg.module.app = *event;
+		msg.module.app = event;
 		enqueue_msg = true;
 	}
 
 	if (is_data_module_event(eh)) {
 		struct data_module_event *event = cast_data_module_event(eh);
 
-		msg.module.data = *event;
+		msg.module.data = event;
 		enqueue_msg = true;
 	}
 
 	if (is_util_module_event(eh)) {
 		struct util_module_event *event = cast_util_module_event(eh);
 
-		msg.module.util = *event;
+		msg.module.util = event;
 		enqueue_msg = true;
 	}
 
@@ -243,7 +243,7 @@ static void on_state_init(struct sensor_msg_data *msg)
 #if defined(CONFIG_EXTERNAL_SENSORS)
 		int err;
 		double accelerometer_threshold =
-			msg->module.data.data.cfg.accelerometer_threshold;
+			msg->module.data->data.cfg.accelerometer_threshold;
 
 		err = ext_sensors_mov_thres_set(accelerometer_threshold);
 		if (err == -ENOTSUP) {
@@ -264,7 +264,7 @@ static void on_state_running(struct sensor_msg_data *msg)
 #if defined(CONFIG_EXTERNAL_SENSORS)
 		int err;
 		double accelerometer_threshold =
-			msg->module.data.data.cfg.accelerometer_threshold;
+			msg->module.data->data.cfg.accelerometer_threshold;
 
 		err = ext_sensors_mov_thres_set(accelerometer_threshold);
 		if (err == -ENOTSUP) {
@@ -277,8 +277,8 @@ static void on_state_running(struct sensor_msg_data *msg)
 
 	if (IS_EVENT(msg, app, APP_EVT_DATA_GET)) {
 		if (!environmental_data_requested(
-			msg->module.app.data_list,
-			msg->module.app.count)) {
+			msg->module.app->data_list,
+			msg->module.app->count)) {
 			return;
 		}
 
@@ -348,6 +348,7 @@ static void module_thread_fn(void)
 		}
 
 		on_all_states(&msg);
+		module_release_msg(&msg);
 	}
 }
 
@@ -27,11 +27,11 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_UI_MODULE_LOG_LEVEL);
 
 struct ui_msg_data {
 	union {
-		struct app_module_event app;
-		struct modem_module_event modem;
-		struct data_module_event data;
-		struct gps_module_event gps;
-		struct util_module_event util;
+		struct app_module_event *app;
+		struct modem_module_event *modem;
+		struct data_module_event *data;
+		struct gps_module_event *gps;
+		struct util_module_event *util;
 	} module;
 };
 
@@ -137,7 +137,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_app_module_event(eh)) {
 		struct app_module_event *event = cast_app_module_event(eh);
 		struct ui_msg_data ui_msg = {
-			.module.app = *event
+			.module.app = event
 		};
 
 		message_handler(&ui_msg);
@@ -146,7 +146,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_data_module_event(eh)) {
 		struct data_module_event *event = cast_data_module_event(eh);
 		struct ui_msg_data ui_msg = {
-			.module.data = *event
+			.module.data = event
 		};
 
 		message_handler(&ui_msg);
@@ -155,7 +155,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_modem_module_event(eh)) {
 		struct modem_module_event *event = cast_modem_module_event(eh);
 		struct ui_msg_data ui_msg = {
-			.module.modem = *event
+			.module.modem = event
 		};
 
 		message_handler(&ui_msg);
@@ -164,7 +164,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_gps_module_event(eh)) {
 		struct gps_module_event *event = cast_gps_module_event(eh);
 		struct ui_msg_data ui_msg = {
-			.module.gps = *event
+			.module.gps = event
 		};
 
 		message_handler(&ui_msg);
@@ -173,7 +173,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_util_module_event(eh)) {
 		struct util_module_event *event = cast_util_module_event(eh);
 		struct ui_msg_data ui_msg = {
-			.module.util = *event
+			.module.util = event
 		};
 
 		message_handler(&ui_msg);
@@ -268,7 +268,7 @@ static void on_state_active_sub_state_gps_active(struct ui_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, data, DATA_EVT_CONFIG_READY)) {
-		if (!msg->module.data.data.cfg.active_mode) {
+		if (!msg->module.data->data.cfg.active_mode) {
 			state_set(STATE_PASSIVE);
 			k_work_reschedule(&led_pat_gps_work,
 					      K_SECONDS(5));
@@ -291,7 +291,7 @@ static void on_state_active_sub_state_gps_inactive(struct ui_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, data, DATA_EVT_CONFIG_READY)) {
-		if (!msg->module.data.data.cfg.active_mode) {
+		if (!msg->module.data->data.cfg.active_mode) {
 			state_set(STATE_PASSIVE);
 			k_work_reschedule(&led_pat_passive_work,
 					      K_SECONDS(5));
@@ -314,7 +314,7 @@ static void on_state_passive_sub_state_gps_active(struct ui_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, data, DATA_EVT_CONFIG_READY)) {
-		if (msg->module.data.data.cfg.active_mode) {
+		if (msg->module.data->data.cfg.active_mode) {
 			state_set(STATE_ACTIVE);
 			k_work_reschedule(&led_pat_gps_work,
 					      K_SECONDS(5));
@@ -337,7 +337,7 @@ static void on_state_passive_sub_state_gps_inactive(struct ui_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, data, DATA_EVT_CONFIG_READY)) {
-		if (msg->module.data.data.cfg.active_mode) {
+		if (msg->module.data->data.cfg.active_mode) {
 			state_set(STATE_ACTIVE);
 			k_work_reschedule(&led_pat_active_work,
 					      K_SECONDS(5));
@@ -361,7 +361,7 @@ static void on_all_states(struct ui_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, util, UTIL_EVT_SHUTDOWN_REQUEST)) {
-		switch (msg->module.util.reason) {
+		switch (msg->module.util->reason) {
 		case REASON_FOTA_UPDATE:
 			update_led_pattern(LED_STATE_FOTA_UPDATE_REBOOT);
 			break;
@@ -382,7 +382,7 @@ static void on_all_states(struct ui_msg_data *msg)
 	}
 
 	if (IS_EVENT(msg, data, DATA_EVT_CONFIG_INIT)) {
-		state_set(msg->module.data.data.cfg.active_mode ?
+		state_set(msg->module.data->data.cfg.active_mode ?
 			 STATE_ACTIVE :
 			 STATE_PASSIVE);
 	}
@@ -25,13 +25,13 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_UTIL_MODULE_LOG_LEVEL);
 
 struct util_msg_data {
 	union {
-		struct cloud_module_event cloud;
-		struct ui_module_event ui;
-		struct sensor_module_event sensor;
-		struct data_module_event data;
-		struct app_module_event app;
-		struct gps_module_event gps;
-		struct modem_module_event modem;
+		struct cloud_module_event *cloud;
+		struct ui_module_event *ui;
+		struct sensor_module_event *sensor;
+		struct data_module_event *data;
+		struct app_module_event *app;
+		struct gps_module_event *gps;
+		struct modem_module_event *modem;
 	} module;
 };
 
@@ -87,7 +87,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_modem_module_event(eh)) {
 		struct modem_module_event *event = cast_modem_module_event(eh);
 		struct util_msg_data util_msg = {
-			.module.modem = *event
+			.module.modem = event
 		};
 
 		message_handler(&util_msg);
@@ -96,7 +96,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_cloud_module_event(eh)) {
 		struct cloud_module_event *event = cast_cloud_module_event(eh);
 		struct util_msg_data util_msg = {
-			.module.cloud = *event
+			.module.cloud = event
 		};
 
 		message_handler(&util_msg);
@@ -105,7 +105,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_gps_module_event(eh)) {
 		struct gps_module_event *event = cast_gps_module_event(eh);
 		struct util_msg_data util_msg = {
-			.module.gps = *event
+			.module.gps = event
 		};
 
 		message_handler(&util_msg);
@@ -115,7 +115,7 @@ static bool event_handler(const struct event_header *eh)
 		struct sensor_module_event *event =
 				cast_sensor_module_event(eh);
 		struct util_msg_data util_msg = {
-			.module.sensor = *event
+			.module.sensor = event
 		};
 
 		message_handler(&util_msg);
@@ -124,7 +124,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_ui_module_event(eh)) {
 		struct ui_module_event *event = cast_ui_module_event(eh);
 		struct util_msg_data util_msg = {
-			.module.ui = *event
+			.module.ui = event
 		};
 
 		message_handler(&util_msg);
@@ -133,7 +133,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_app_module_event(eh)) {
 		struct app_module_event *event = cast_app_module_event(eh);
 		struct util_msg_data util_msg = {
-			.module.app = *event
+			.module.app = event
 		};
 
 		message_handler(&util_msg);
@@ -142,7 +142,7 @@ static bool event_handler(const struct event_header *eh)
 	if (is_data_module_event(eh)) {
 		struct data_module_event *event = cast_data_module_event(eh);
 		struct util_msg_data util_msg = {
-			.module.data = *event
+			.module.data = event
 		};
 
 		message_handler(&util_msg);
@@ -250,37 +250,37 @@ static void on_state_init(struct util_msg_data *msg)
 static void on_state_reboot_pending(struct util_msg_data *msg)
 {
 	if (IS_EVENT(msg, cloud, CLOUD_EVT_SHUTDOWN_READY)) {
-		reboot_ack_check(msg->module.cloud.data.id);
+		reboot_ack_check(msg->module.cloud->data.id);
 		return;
 	}
 
 	if (IS_EVENT(msg, modem, MODEM_EVT_SHUTDOWN_READY)) {
-		reboot_ack_check(msg->module.modem.data.id);
+		reboot_ack_check(msg->module.modem->data.id);
 		return;
 	}
 
 	if (IS_EVENT(msg, sensor, SENSOR_EVT_SHUTDOWN_READY)) {
-		reboot_ack_check(msg->module.sensor.data.id);
+		reboot_ack_check(msg->module.sensor->data.id);
 		return;
 	}
 
 	if (IS_EVENT(msg, gps, GPS_EVT_SHUTDOWN_READY)) {
-		reboot_ack_check(msg->module.gps.data.id);
+		reboot_ack_check(msg->module.gps->data.id);
 		return;
 	}
 
 	if (IS_EVENT(msg, data, DATA_EVT_SHUTDOWN_READY)) {
-		reboot_ack_check(msg->module.data.data.id);
+		reboot_ack_check(msg->module.data->data.id);
 		return;
 	}
 
 	if (IS_EVENT(msg, app, APP_EVT_SHUTDOWN_READY)) {
-		reboot_ack_check(msg->module.app.data.id);
+		reboot_ack_check(msg->module.app->data.id);
 		return;
 	}
 
 	if (IS_EVENT(msg, ui, UI_EVT_SHUTDOWN_READY)) {
-		reboot_ack_check(msg->module.ui.data.id);
+		reboot_ack_check(msg->module.ui->data.id);
 		return;
 	}
 }
@@ -366,3 +366,13 @@
 					"}"							\
 				"]"								\
 			"}"
+
+#define TEST_VALIDATE_BATCH_BOUNDED_JSON_SCHEMA							\
+			"{"									\
+				"\"bat\":["							\
+					"{"							\
+						"\"v\":3600,"					\
+						"\"ts\":1563968747123"				\
+					"}"							\
+				"]"								\
+			"}"
@@ -890,49 +890,56 @@ static void test_encode_batch_data_object(void)
 					 JSON_COMMON_BATTERY,
 					 &battery,
 					 ARRAY_SIZE(battery),
-					 DATA_BATTERY);
+					 DATA_BATTERY,
+					 NULL);
 	zassert_equal(0, ret, "Return value %d is wrong", ret);
 
 	ret = json_common_batch_data_add(dummy.root_obj,
 					 JSON_COMMON_UI,
 					 &ui,
 					 ARRAY_SIZE(ui),
-					 DATA_BUTTON);
+					 DATA_BUTTON,
+					 NULL);
 	zassert_equal(0, ret, "Return value %d is wrong", ret);
 
 	ret = json_common_batch_data_add(dummy.root_obj,
 					 JSON_COMMON_GPS,
 					 &gps,
 					 ARRAY_SIZE(gps),
-					 DATA_GPS);
+					 DATA_GPS,
+					 NULL);
 	zassert_equal(0, ret, "Return value %d is wrong", ret);
 
 	ret = json_common_batch_data_add(dummy.root_obj,
 					 JSON_COMMON_SENSOR,
 					 &environmental,
 					 ARRAY_SIZE(environmental),
-					 DATA_ENVIRONMENTALS);
+					 DATA_ENVIRONMENTALS,
+					 NULL);
 	zassert_equal(0, ret, "Return value %d is wrong", ret);
 
 	ret = json_common_batch_data_add(dummy.root_obj,
 					 JSON_COMMON_ACCELEROMETER,
 					 &accelerometer,
 					 ARRAY_SIZE(accelerometer),
-					 DATA_MOVEMENT);
+					 DATA_MOVEMENT,
+					 NULL);
 	zassert_equal(0, ret, "Return value %d is wrong", ret);
 
 	ret = json_common_batch_data_add(dummy.root_obj,
 					 JSON_COMMON_MODEM_DYNAMIC,
 					 &modem_dynamic,
 					 ARRAY_SIZE(modem_dynamic),
-					 DATA_MODEM_DYNAMIC);
+					 DATA_MODEM_DYNAMIC,
+					 NULL);
 	zassert_equal(0, ret, "Return value %d is wrong", ret);
 
 	ret = json_common_batch_data_add(dummy.root_obj,
 					 JSON_COMMON_MODEM_STATIC,
 					 &modem_static,
 					 ARRAY_SIZE(modem_static),
-					 DATA_MODEM_STATIC);
+					 DATA_MODEM_STATIC,
+					 NULL);
 	zassert_equal(0, ret, "Return value %d is wrong", ret);
 
 	ret = encoded_output_check(dummy.root_obj, TEST_VALIDATE_BATCH_JSON_SCHEMA, -1);
@@ -940,13 +947,76 @@ static void test_encode_batch_data_object(void)
 
 	/* Check for invalid inputs. */
 
-	ret = json_common_batch_data_add(NULL, -1, NULL, 0, "");
+	ret = json_common_batch_data_add(NULL, -1, NULL, 0, "", NULL);
 	zassert_equal(-ENOMEM, ret, "Return value %d is wrong.", ret);
 
-	ret = json_common_batch_data_add(dummy.root_obj, -1, NULL, 0, NULL);
+	ret = json_common_batch_data_add(dummy.root_obj, -1, NULL, 0, NULL, NULL);
 	zassert_equal(-EINVAL, ret, "Return value %d is wrong.", ret);
 }
 
+static void test_encode_batch_data_object_bounded(void)
+{
+	int ret;
+	/* Room for the first battery entry and its label, but not for the second entry. */
+	size_t budget = 50;
+	struct cloud_data_battery battery[2] = {
+		[0].bat = 3600,
+		[0].bat_ts = 1000,
+		[0].queued = true,
+		/* Second entry */
+		[1].bat = 3600,
+		[1].bat_ts = 1000,
+		[1].queued = true
+	};
+	struct cloud_data_ui ui[1] = {
+		[0].btn = 1,
+		[0].btn_ts = 1000,
+		[0].queued = true
+	};
+
+	ret = json_common_batch_data_add(dummy.root_obj,
+					 JSON_COMMON_BATTERY,
+					 &battery,
+					 ARRAY_SIZE(battery),
+					 DATA_BATTERY,
+					 &budget);
+	zassert_equal(0, ret, "Return value %d is wrong", ret);
+	zassert_equal(0, budget, "Budget %zu is wrong", budget);
+	zassert_false(battery[0].queued, "First entry should be encoded");
+	zassert_true(battery[1].queued, "Second entry should be left queued");
+
+	/* The chunk is full, no further data is added to it. */
+	ret = json_common_batch_data_add(dummy.root_obj,
+					 JSON_COMMON_UI,
+					 &ui,
+					 ARRAY_SIZE(ui),
+					 DATA_BUTTON,
+					 &budget);
+	zassert_equal(-ENODATA, ret, "Return value %d is wrong", ret);
+	zassert_true(ui[0].queued, "UI entry should be left queued");
+
+	ret = encoded_output_check(dummy.root_obj, TEST_VALIDATE_BATCH_BOUNDED_JSON_SCHEMA, -1);
+	zassert_equal(0, ret, "Return value %d is wrong", ret);
+
+	/* An entry larger than the whole chunk is still encoded if the chunk is empty. */
+	cJSON_Delete(dummy.root_obj);
+	dummy.root_obj = cJSON_CreateObject();
+	cJSON_FreeString(dummy.buffer);
+	budget = 1;
+
+	ret = json_common_batch_data_add(dummy.root_obj,
+					 JSON_COMMON_BATTERY,
+					 &battery,
+					 ARRAY_SIZE(battery),
+					 DATA_BATTERY,
+					 &budget);
+	zassert_equal(0, ret, "Return value %d is wrong", ret);
+	zassert_false(battery[1].queued, "Oversized entry should be encoded");
+
+	ret = encoded_output_check(dummy.root_obj, TEST_VALIDATE_BATCH_BOUNDED_JSON_SCHEMA, -1);
+	zassert_equal(0, ret, "Return value %d is wrong", ret);
+}
+
 /* Test used to verify encoding and decoding of data structures that contain floating point
  * values. Floating point values cannot be exactly represented in binary so they cannot be compared
  * with a predefined JSON string schema.
@@ -1285,6 +1355,9 @@ void test_main(void)
 		ztest_unit_test_setup_teardown(test_encode_batch_data_object,
 					       test_setup_object,
 					       test_teardown_object),
+		ztest_unit_test_setup_teardown(test_encode_batch_data_object_bounded,
+					       test_setup_object,
+					       test_teardown_object),
 
 		/* GPS floating point values comparison */
 		ztest_unit_test_setup_teardown(test_floating_point_encoding_gps,
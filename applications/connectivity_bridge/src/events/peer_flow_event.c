@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <assert.h>
+
+#include "peer_flow_event.h"
+
+static const char * const peer_name[] = {
+#define X(name) STRINGIFY(name),
+	PEER_ID_LIST
+#undef X
+};
+
+static int log_peer_flow_event(const struct event_header *eh, char *buf,
+			       size_t buf_len)
+{
+	const struct peer_flow_event *event = cast_peer_flow_event(eh);
+
+	BUILD_ASSERT(ARRAY_SIZE(peer_name) == PEER_ID_COUNT,
+			 "Invalid number of elements");
+
+	__ASSERT_NO_MSG(event->peer_id < PEER_ID_COUNT);
+
+	return snprintf(
+		buf,
+		buf_len,
+		"%s:%s_%d",
+		event->flow_state == PEER_FLOW_PAUSE ? "PAUSE" : "RESUME",
+		peer_name[event->peer_id],
+		event->dev_idx);
+}
+
+EVENT_TYPE_DEFINE(peer_flow_event,
+		  IS_ENABLED(CONFIG_BRIDGE_LOG_PEER_FLOW_EVENT),
+		  log_peer_flow_event,
+		  NULL);
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _PEER_FLOW_EVENT_H_
+#define _PEER_FLOW_EVENT_H_
+
+/**
+ * @brief Peer Flow Control Event
+ * @defgroup peer_flow_event Peer Flow Control Event
+ * @{
+ */
+
+#include <string.h>
+#include <toolchain/common.h>
+
+#include "event_manager.h"
+#include "peer_conn_event.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum peer_flow_state {
+	PEER_FLOW_RESUME,
+	PEER_FLOW_PAUSE
+};
+
+/** Peer flow control event. Pauses or resumes UART RX for a peer. */
+struct peer_flow_event {
+	struct event_header header;
+
+	enum peer_id peer_id;
+	uint8_t dev_idx;
+	enum peer_flow_state flow_state;
+};
+
+EVENT_TYPE_DECLARE(peer_flow_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _PEER_FLOW_EVENT_H_ */
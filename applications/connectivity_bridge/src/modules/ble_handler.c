@@ -17,6 +17,7 @@
 #define MODULE ble_handler
 #include "module_state_event.h"
 #include "peer_conn_event.h"
+#include "peer_flow_event.h"
 #include "ble_ctrl_event.h"
 #include "ble_data_event.h"
 #include "uart_data_event.h"
@@ -28,7 +29,10 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_BRIDGE_BLE_LOG_LEVEL);
 #define BLE_RX_BUF_COUNT 4
 #define BLE_SLAB_ALIGNMENT 4
 
-#define BLE_TX_BUF_SIZE (CONFIG_BRIDGE_BUF_SIZE * 2)
+#define BLE_TX_BUF_SIZE (CONFIG_BRIDGE_BUF_SIZE * 4)
+/* Pause UART RX while there is no room for the UART buffers in flight */
+#define BLE_TX_PAUSE_SPACE (CONFIG_BRIDGE_BUF_SIZE * 2)
+#define BLE_TX_RESUME_USED CONFIG_BRIDGE_BUF_SIZE
 
 #define BLE_AD_IDX_FLAGS 0
 #define BLE_AD_IDX_NAME 1
@@ -49,6 +53,7 @@ static struct bt_gatt_exchange_params exchange_params;
 static uint32_t nus_max_send_len;
 static atomic_t ready;
 static atomic_t active;
+static atomic_t uart_paused;
 
 static char bt_device_name[CONFIG_BT_DEVICE_NAME_MAX + 1] = CONFIG_BT_DEVICE_NAME;
 
@@ -69,6 +74,24 @@ static void exchange_func(struct bt_conn *conn, uint8_t err,
 	}
 }
 
+static void uart_flow_set(bool pause)
+{
+	if (!IS_ENABLED(CONFIG_BRIDGE_BLE_UART_FLOW_CONTROL)) {
+		return;
+	}
+
+	if (atomic_set(&uart_paused, pause) == pause) {
+		return;
+	}
+
+	struct peer_flow_event *event = new_peer_flow_event();
+
+	event->peer_id = PEER_ID_BLE;
+	event->dev_idx = 0;
+	event->flow_state = pause ? PEER_FLOW_PAUSE : PEER_FLOW_RESUME;
+	EVENT_SUBMIT(event);
+}
+
 static void connected(struct bt_conn *conn, uint8_t err)
 {
 	char addr[BT_ADDR_LE_STR_LEN];
@@ -90,6 +113,7 @@ static void connected(struct bt_conn *conn, uint8_t err)
 	}
 
 	ring_buf_reset(&ble_tx_ring_buf);
+	atomic_set(&uart_paused, false);
 
 	struct peer_conn_event *event = new_peer_conn_event();
 
@@ -112,6 +136,9 @@ static void disconnected(struct bt_conn *conn, uint8_t reason)
 		current_conn = NULL;
 	}
 
+	/* UART handler clears the pause state of disconnected peers */
+	atomic_set(&uart_paused, false);
+
 	struct peer_conn_event *event = new_peer_conn_event();
 
 	event->peer_id = PEER_ID_BLE;
@@ -128,33 +155,26 @@ static struct bt_conn_cb conn_callbacks = {
 
 static void bt_send_work_handler(struct k_work *work)
 {
-	uint16_t len;
-	uint8_t *buf;
 	int err;
-	bool notif_disabled = false;
-
-	do {
-		len = ring_buf_get_claim(&ble_tx_ring_buf, &buf, nus_max_send_len);
-
-		err = bt_nus_send(current_conn, buf, len);
-		if (err == -EINVAL) {
-			notif_disabled = true;
-			len = 0;
-		} else if (err) {
-			len = 0;
-		}
 
-		err = ring_buf_get_finish(&ble_tx_ring_buf, len);
-		if (err) {
-			LOG_ERR("ring_buf_get_finish: %d", err);
-			break;
-		}
-	} while (len != 0 && !ring_buf_is_empty(&ble_tx_ring_buf));
+	if (current_conn == NULL) {
+		return;
+	}
 
-	if (notif_disabled) {
+	/* Queue notifications until all credits are in use. The rest of */
+	/* the data is aggregated in the ring buffer and sent in full ATT */
+	/* payloads as the credits are returned in bt_sent_cb. */
+	err = bt_nus_stream_send_ring(current_conn, &ble_tx_ring_buf, K_NO_WAIT);
+	if (err == -EINVAL) {
 		/* Peer has not enabled notifications: don't accumulate data */
 		ring_buf_reset(&ble_tx_ring_buf);
 	}
+
+	if (atomic_get(&uart_paused) &&
+	    (ring_buf_capacity_get(&ble_tx_ring_buf) -
+	     ring_buf_space_get(&ble_tx_ring_buf)) <= BLE_TX_RESUME_USED) {
+		uart_flow_set(false);
+	}
 }
 
 static void bt_receive_cb(struct bt_conn *conn, const uint8_t *const data,
@@ -305,16 +325,13 @@ static bool event_handler(const struct event_header *eh)
 			LOG_WRN("UART_%d -> BLE overflow", event->dev_idx);
 		}
 
-		uint32_t buf_utilization =
-			(ring_buf_capacity_get(&ble_tx_ring_buf) -
-			ring_buf_space_get(&ble_tx_ring_buf));
-
-		/* Simple check to start transmission. */
-		/* If bt_send_work is already running, this has no effect */
-		if (buf_utilization == written) {
-			k_work_submit(&bt_send_work);
+		if (ring_buf_space_get(&ble_tx_ring_buf) < BLE_TX_PAUSE_SPACE) {
+			uart_flow_set(true);
 		}
 
+		/* If bt_send_work is already pending, this has no effect */
+		k_work_submit(&bt_send_work);
+
 		return false;
 	}
 
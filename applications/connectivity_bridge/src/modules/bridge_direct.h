@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _BRIDGE_DIRECT_H_
+#define _BRIDGE_DIRECT_H_
+
+/**
+ * @brief Direct UART <-> USB CDC ACM data path
+ * @defgroup bridge_direct Direct bridge data path
+ * @{
+ *
+ * Bulk data between a UART instance and the CDC ACM instance with the same
+ * index is moved from interrupt context without going through the event
+ * manager. Connection state changes and all other control information are
+ * still distributed as events.
+ */
+
+#include <zephyr/types.h>
+#include <device.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Read data from a FIFO device directly into the UART TX buffer.
+ *
+ * Reads as much data as fits from the RX FIFO of @p fifo_dev into the
+ * TX buffer of the given UART instance, and starts transmission.
+ * Must be called from the RX interrupt handler of @p fifo_dev.
+ *
+ * @param dev_idx UART instance index.
+ * @param fifo_dev Interrupt-driven device to read data from.
+ *
+ * @return Number of bytes read, or a negative error code. -ENOMEM is
+ *         returned if the UART TX buffer is full, in which case the caller
+ *         has to drain the FIFO itself.
+ */
+int uart_bridge_tx_from_fifo(uint8_t dev_idx, const struct device *fifo_dev);
+
+/**
+ * @brief Write UART RX data directly to a CDC ACM instance.
+ *
+ * Can be called from interrupt context.
+ *
+ * @param dev_idx CDC ACM instance index.
+ * @param buf Data to write.
+ * @param len Length of the data.
+ *
+ * @return Number of bytes written, or a negative error code.
+ */
+int usb_cdc_bridge_tx(uint8_t dev_idx, const uint8_t *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _BRIDGE_DIRECT_H_ */
@@ -11,9 +11,11 @@
 #define MODULE uart_handler
 #include "module_state_event.h"
 #include "peer_conn_event.h"
+#include "peer_flow_event.h"
 #include "ble_data_event.h"
 #include "cdc_data_event.h"
 #include "uart_data_event.h"
+#include "bridge_direct.h"
 
 #include <logging/log.h>
 LOG_MODULE_REGISTER(MODULE, CONFIG_BRIDGE_UART_LOG_LEVEL);
@@ -76,6 +78,16 @@ static uint32_t uart_default_baudrate[UART_DEVICE_COUNT];
 static int subscriber_count[UART_DEVICE_COUNT];
 static bool enable_rx_retry[UART_DEVICE_COUNT];
 static atomic_t uart_tx_started[UART_DEVICE_COUNT];
+/* Serializes TX buffer producers: event handler and direct data path */
+static struct k_spinlock uart_tx_lock[UART_DEVICE_COUNT];
+/* UART RX data goes straight to USB CDC when it is the only subscriber */
+static bool cdc_subscribed[UART_DEVICE_COUNT];
+static bool direct_rx[UART_DEVICE_COUNT];
+/* Bitmask of peers that have paused RX, indexed by peer ID */
+static atomic_t rx_paused[UART_DEVICE_COUNT];
+/* RX buffer request declined due to pause; RX stops when buffer is full */
+static atomic_t rx_stalled[UART_DEVICE_COUNT];
+static atomic_t rx_stopped[UART_DEVICE_COUNT];
 
 static void enable_uart_rx(uint8_t dev_idx);
 static void disable_uart_rx(uint8_t dev_idx);
@@ -136,6 +148,33 @@ static void uart_rx_buf_unref(void *buf)
 	}
 }
 
+static void uart_rx_resume(uint8_t dev_idx)
+{
+	/* Called from both UART callback and event handler: only one of */
+	/* them gets to restart RX. */
+	if (!atomic_cas(&rx_stopped[dev_idx], true, false)) {
+		return;
+	}
+
+	if (subscriber_count[dev_idx] > 0) {
+		enable_uart_rx(dev_idx);
+	}
+}
+
+static void uart_rx_flow_set(uint8_t dev_idx, enum peer_id peer_id,
+			     bool pause)
+{
+	if (pause) {
+		atomic_or(&rx_paused[dev_idx], BIT(peer_id));
+		return;
+	}
+
+	atomic_and(&rx_paused[dev_idx], ~BIT(peer_id));
+	if (!atomic_get(&rx_paused[dev_idx])) {
+		uart_rx_resume(dev_idx);
+	}
+}
+
 static void uart_callback(const struct device *dev, struct uart_event *evt,
 			  void *user_data)
 {
@@ -146,6 +185,20 @@ static void uart_callback(const struct device *dev, struct uart_event *evt,
 
 	switch (evt->type) {
 	case UART_RX_RDY:
+		if (IS_ENABLED(CONFIG_BRIDGE_DIRECT_DATA_PATH) &&
+		    direct_rx[dev_idx]) {
+			err = usb_cdc_bridge_tx(
+				dev_idx,
+				&evt->data.rx.buf[evt->data.rx.offset],
+				evt->data.rx.len);
+			if (err >= 0 && err != (int)evt->data.rx.len) {
+				LOG_DBG("UART_%d->CDC_%d overflow",
+					dev_idx,
+					dev_idx);
+			}
+			break;
+		}
+
 		uart_rx_buf_ref(evt->data.rx.buf);
 
 		event = new_uart_data_event();
@@ -160,6 +213,13 @@ static void uart_callback(const struct device *dev, struct uart_event *evt,
 		}
 		break;
 	case UART_RX_BUF_REQUEST:
+		if (atomic_get(&rx_paused[dev_idx])) {
+			/* Let RX stop when the current buffer is full. With */
+			/* hardware flow control, RTS is deasserted meanwhile. */
+			atomic_set(&rx_stalled[dev_idx], true);
+			break;
+		}
+
 		buf = uart_rx_buf_alloc();
 		if (buf == NULL) {
 			LOG_WRN("UART_%d RX overflow", dev_idx);
@@ -176,6 +236,13 @@ static void uart_callback(const struct device *dev, struct uart_event *evt,
 		if (enable_rx_retry[dev_idx]) {
 			enable_uart_rx(dev_idx);
 			enable_rx_retry[dev_idx] = false;
+		} else if (atomic_get(&rx_stalled[dev_idx]) &&
+			   subscriber_count[dev_idx] > 0) {
+			atomic_set(&rx_stopped[dev_idx], true);
+			if (!atomic_get(&rx_paused[dev_idx])) {
+				/* Resumed before RX stopped */
+				uart_rx_resume(dev_idx);
+			}
 		} else if (UART_SET_PM_STATE) {
 			set_uart_power_state(dev_idx, false);
 		}
@@ -272,6 +339,9 @@ static void enable_uart_rx(uint8_t dev_idx)
 	int err;
 	struct uart_rx_buf *buf;
 
+	atomic_set(&rx_stalled[dev_idx], false);
+	atomic_set(&rx_stopped[dev_idx], false);
+
 	err = uart_callback_set(dev, uart_callback, (void *) (int) dev_idx);
 	if (err) {
 		LOG_ERR("uart_callback_set: %d", err);
@@ -335,17 +405,11 @@ static void uart_tx_finish(uint8_t dev_idx, size_t len)
 	}
 }
 
-static int uart_tx_enqueue(uint8_t *data, size_t data_len, uint8_t dev_idx)
+static void uart_tx_kick(uint8_t dev_idx)
 {
 	atomic_t started;
-	uint32_t written;
 	int err;
 
-	written = ring_buf_put(&uart_tx_ringbufs[dev_idx].rb, data, data_len);
-	if (written == 0) {
-		return -ENOMEM;
-	}
-
 	started = atomic_set(&uart_tx_started[dev_idx], true);
 	if (!started) {
 		err = uart_tx_start(dev_idx);
@@ -354,6 +418,21 @@ static int uart_tx_enqueue(uint8_t *data, size_t data_len, uint8_t dev_idx)
 			atomic_set(&uart_tx_started[dev_idx], false);
 		}
 	}
+}
+
+static int uart_tx_enqueue(uint8_t *data, size_t data_len, uint8_t dev_idx)
+{
+	k_spinlock_key_t key;
+	uint32_t written;
+
+	key = k_spin_lock(&uart_tx_lock[dev_idx]);
+	written = ring_buf_put(&uart_tx_ringbufs[dev_idx].rb, data, data_len);
+	k_spin_unlock(&uart_tx_lock[dev_idx], key);
+	if (written == 0) {
+		return -ENOMEM;
+	}
+
+	uart_tx_kick(dev_idx);
 
 	if (written == data_len) {
 		return 0;
@@ -364,6 +443,49 @@ static int uart_tx_enqueue(uint8_t *data, size_t data_len, uint8_t dev_idx)
 	return 0;
 }
 
+#if CONFIG_BRIDGE_DIRECT_DATA_PATH
+int uart_bridge_tx_from_fifo(uint8_t dev_idx, const struct device *fifo_dev)
+{
+	k_spinlock_key_t key;
+	uint8_t *buf;
+	uint32_t size;
+	int len;
+
+	if (dev_idx >= UART_DEVICE_COUNT || !devices[dev_idx]) {
+		return -ENODEV;
+	}
+
+	key = k_spin_lock(&uart_tx_lock[dev_idx]);
+
+	/* Read straight into free TX buffer space to avoid an extra copy */
+	size = ring_buf_put_claim(
+			&uart_tx_ringbufs[dev_idx].rb,
+			&buf,
+			sizeof(uart_tx_ringbufs[dev_idx].buf));
+	if (size == 0) {
+		k_spin_unlock(&uart_tx_lock[dev_idx], key);
+		return -ENOMEM;
+	}
+
+	len = uart_fifo_read(fifo_dev, buf, size);
+	ring_buf_put_finish(&uart_tx_ringbufs[dev_idx].rb, MAX(len, 0));
+
+	k_spin_unlock(&uart_tx_lock[dev_idx], key);
+
+	if (len > 0) {
+		uart_tx_kick(dev_idx);
+	}
+
+	return len;
+}
+#endif /* CONFIG_BRIDGE_DIRECT_DATA_PATH */
+
+static void update_direct_rx(uint8_t dev_idx)
+{
+	direct_rx[dev_idx] = cdc_subscribed[dev_idx] &&
+			     (subscriber_count[dev_idx] == 1);
+}
+
 static bool event_handler(const struct event_header *eh)
 {
 	int err;
@@ -422,6 +544,24 @@ static bool event_handler(const struct event_header *eh)
 		return false;
 	}
 
+	if (is_peer_flow_event(eh)) {
+		const struct peer_flow_event *event =
+			cast_peer_flow_event(eh);
+
+		if (event->dev_idx >= UART_DEVICE_COUNT) {
+			return false;
+		}
+
+		if (!devices[event->dev_idx]) {
+			return false;
+		}
+
+		uart_rx_flow_set(event->dev_idx, event->peer_id,
+				 event->flow_state == PEER_FLOW_PAUSE);
+
+		return false;
+	}
+
 	if (is_peer_conn_event(eh)) {
 		const struct peer_conn_event *event =
 			cast_peer_conn_event(eh);
@@ -446,6 +586,17 @@ static bool event_handler(const struct event_header *eh)
 
 		__ASSERT_NO_MSG(subscriber_count[event->dev_idx] >= 0);
 
+		if (event->peer_id == PEER_ID_USB) {
+			cdc_subscribed[event->dev_idx] =
+				(event->conn_state == PEER_STATE_CONNECTED);
+		}
+		update_direct_rx(event->dev_idx);
+
+		if (event->conn_state == PEER_STATE_DISCONNECTED) {
+			/* Disconnected peers can no longer resume RX */
+			uart_rx_flow_set(event->dev_idx, event->peer_id, false);
+		}
+
 		if (subscriber_count[event->dev_idx] == 0) {
 			LOG_DBG("No subscribers. Close UART_%d RX", event->dev_idx);
 			set_uart_baudrate(
@@ -486,6 +637,11 @@ static bool event_handler(const struct event_header *eh)
 				}
 				uart_default_baudrate[i] = cfg.baudrate;
 				subscriber_count[i] = 0;
+				cdc_subscribed[i] = false;
+				direct_rx[i] = false;
+				atomic_set(&rx_paused[i], 0);
+				atomic_set(&rx_stalled[i], false);
+				atomic_set(&rx_stopped[i], false);
 				enable_rx_retry[i] = false;
 
 				atomic_set(&uart_tx_started[i], false);
@@ -512,6 +668,7 @@ static bool event_handler(const struct event_header *eh)
 EVENT_LISTENER(MODULE, event_handler);
 EVENT_SUBSCRIBE(MODULE, module_state_event);
 EVENT_SUBSCRIBE(MODULE, peer_conn_event);
+EVENT_SUBSCRIBE(MODULE, peer_flow_event);
 EVENT_SUBSCRIBE(MODULE, ble_data_event);
 EVENT_SUBSCRIBE(MODULE, cdc_data_event);
 EVENT_SUBSCRIBE_FINAL(MODULE, uart_data_event);
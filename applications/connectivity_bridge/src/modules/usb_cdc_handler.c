@@ -13,6 +13,7 @@
 #include "peer_conn_event.h"
 #include "cdc_data_event.h"
 #include "uart_data_event.h"
+#include "bridge_direct.h"
 
 #include <logging/log.h>
 LOG_MODULE_REGISTER(MODULE, CONFIG_BRIDGE_CDC_LOG_LEVEL);
@@ -103,6 +104,21 @@ static void cdc_uart_interrupt_handler(const struct device *dev, void *user_data
 			poll_dtr();
 		}
 
+		if (IS_ENABLED(CONFIG_BRIDGE_DIRECT_DATA_PATH)) {
+			data_length = uart_bridge_tx_from_fifo(dev_idx, dev);
+			if (data_length >= 0) {
+				continue;
+			}
+
+			if (data_length == -ENOMEM) {
+				LOG_WRN("CDC_%d->UART_%d overflow", dev_idx, dev_idx);
+			}
+
+			/* Drain FIFO to avoid re-entering with the same data */
+			uart_fifo_read(dev, overflow_buf, sizeof(overflow_buf));
+			continue;
+		}
+
 		err = k_mem_slab_alloc(&cdc_rx_slab, &rx_buf, K_NO_WAIT);
 		if (err) {
 			data_length = uart_fifo_read(
@@ -130,6 +146,21 @@ static void cdc_uart_interrupt_handler(const struct device *dev, void *user_data
 	}
 }
 
+#if CONFIG_BRIDGE_DIRECT_DATA_PATH
+int usb_cdc_bridge_tx(uint8_t dev_idx, const uint8_t *buf, size_t len)
+{
+	if (dev_idx >= CDC_DEVICE_COUNT || !devices[dev_idx]) {
+		return -ENODEV;
+	}
+
+	if (cdc_ready[dev_idx] == 0) {
+		return 0;
+	}
+
+	return uart_fifo_fill(devices[dev_idx], buf, len);
+}
+#endif /* CONFIG_BRIDGE_DIRECT_DATA_PATH */
+
 static void enable_rx_irq(int dev_idx)
 {
 	uart_irq_callback_user_data_set(
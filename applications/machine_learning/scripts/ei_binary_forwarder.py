@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+"""Convert binary data forwarder frames into the Edge Impulse data forwarder
+format.
+
+The script reads binary frames sent by the nRF Machine Learning application
+built with CONFIG_ML_APP_EI_DATA_FORWARDER_FORMAT_BINARY from a serial port.
+Every sensor readout is written as a line of comma-separated values to a
+pseudo-terminal, which can be passed to edge-impulse-data-forwarder, or to the
+standard output.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+import serial
+
+FRAME_SYNC = b'\xa5\x5a'
+FRAME_HDR_SIZE = 4
+VALUE_SIZE = 4
+
+
+def frames(data):
+    """Split a byte stream into frames.
+
+    Returns the list of decoded frames and the number of consumed bytes.
+    Every frame is a list of sensor readouts, and every readout is a tuple
+    of float values.
+    """
+    result = []
+    pos = 0
+
+    while True:
+        start = data.find(FRAME_SYNC, pos)
+        if start < 0:
+            # Keep the last byte, it can be the first byte of a sync word.
+            return result, max(pos, len(data) - 1)
+
+        if len(data) - start < FRAME_HDR_SIZE:
+            return result, start
+
+        sample_cnt = data[start + 2]
+        value_cnt = data[start + 3]
+        size = FRAME_HDR_SIZE + sample_cnt * value_cnt * VALUE_SIZE
+
+        if (sample_cnt == 0) or (value_cnt == 0):
+            pos = start + 1
+            continue
+
+        if len(data) - start < size:
+            return result, start
+
+        values = struct.unpack_from('<{}f'.format(sample_cnt * value_cnt),
+                                    data, start + FRAME_HDR_SIZE)
+        result.append([values[i:i + value_cnt]
+                       for i in range(0, len(values), value_cnt)])
+        pos = start + size
+
+
+def format_readout(readout):
+    return ','.join('{:.2f}'.format(v) for v in readout) + '\r\n'
+
+
+def open_output(use_stdout):
+    if use_stdout:
+        return sys.stdout.fileno()
+
+    master, slave = os.openpty()
+    print('Forwarding data to {}'.format(os.ttyname(slave)), file=sys.stderr)
+    print('Run: edge-impulse-data-forwarder --baud-rate 115200 --port {}'
+          .format(os.ttyname(slave)), file=sys.stderr)
+
+    return master
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Convert binary sensor data frames into the Edge Impulse '
+                    'data forwarder format.')
+    parser.add_argument('port', help='Serial port of the device')
+    parser.add_argument('-b', '--baudrate', type=int, default=115200,
+                        help='Serial port baud rate (default: 115200)')
+    parser.add_argument('--stdout', action='store_true',
+                        help='Write the converted data to the standard output '
+                             'instead of a pseudo-terminal')
+    args = parser.parse_args()
+
+    out = open_output(args.stdout)
+    data = b''
+
+    with serial.Serial(args.port, args.baudrate, timeout=0.1) as port:
+        try:
+            while True:
+                data += port.read(port.in_waiting or 1)
+                decoded, consumed = frames(data)
+                data = data[consumed:]
+
+                for frame in decoded:
+                    lines = ''.join(format_readout(r) for r in frame)
+                    os.write(out, lines.encode())
+        except KeyboardInterrupt:
+            pass
+
+
+if __name__ == '__main__':
+    main()
@@ -29,6 +29,15 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_ML_APP_EI_DATA_FORWARDER_LOG_LEVEL);
 #define PIPELINE_MAX_CNT	2
 
 #define ML_STATE_CONTROL	IS_ENABLED(CONFIG_ML_APP_ML_STATE_EVENTS)
+#define BINARY_FORMAT		IS_ENABLED(CONFIG_ML_APP_EI_DATA_FORWARDER_FORMAT_BINARY)
+
+#if BINARY_FORMAT
+#define FRAME_SAMPLES		CONFIG_ML_APP_EI_DATA_FORWARDER_FRAME_SAMPLES
+/* Binary frames are assembled directly in the buffers of the send queue. */
+BUILD_ASSERT(DATA_BUF_COUNT > 0);
+#else
+#define FRAME_SAMPLES		1
+#endif
 
 enum {
 	CONN_SECURED			= BIT(0),
@@ -67,6 +76,9 @@ static struct k_work send_queued;
 static size_t pipeline_cnt;
 static atomic_t sent_cnt;
 
+static struct ei_data_packet *frame_packet;
+static struct ei_data_forwarder_frame frame;
+
 
 static void broadcast_ei_data_forwarder_state(enum ei_data_forwarder_state forwarder_state)
 {
@@ -154,6 +166,11 @@ static void clean_buffered_data(void)
 
 		k_mem_slab_free(&buf_slab, (void **)&packet);
 	}
+
+	if (frame_packet) {
+		k_mem_slab_free(&buf_slab, (void **)&frame_packet);
+		frame_packet = NULL;
+	}
 }
 
 static int send_packet(struct bt_conn *conn, uint8_t *buf, size_t size)
@@ -209,6 +226,90 @@ static void send_queued_fn(struct k_work *w)
 	}
 }
 
+static int frame_start(void)
+{
+	if (k_mem_slab_alloc(&buf_slab, (void **)&frame_packet, K_NO_WAIT)) {
+		frame_packet = NULL;
+		return -ENOMEM;
+	}
+
+	size_t size = MIN(sizeof(frame_packet->buf), bt_nus_get_mtu(nus_conn));
+
+	ei_data_forwarder_frame_init(&frame, frame_packet->buf, size);
+
+	return 0;
+}
+
+static int frame_send(void)
+{
+	struct ei_data_packet *packet = frame_packet;
+	int err = 0;
+
+	packet->size = ei_data_forwarder_frame_finish(&frame);
+	frame_packet = NULL;
+
+	if (pipeline_cnt < PIPELINE_MAX_CNT) {
+		err = send_packet(nus_conn, packet->buf, packet->size);
+		if (!err) {
+			pipeline_cnt++;
+		}
+
+		k_mem_slab_free(&buf_slab, (void **)&packet);
+	} else {
+		sys_slist_append(&send_queue, &packet->node);
+	}
+
+	return err;
+}
+
+static int forward_binary(const float *data_ptr, size_t data_cnt)
+{
+	int err;
+
+	if (!frame_packet) {
+		err = frame_start();
+		if (err) {
+			return err;
+		}
+	}
+
+	err = ei_data_forwarder_frame_add(&frame, data_ptr, data_cnt);
+	if ((err == -ENOBUFS) && (frame.sample_cnt > 0)) {
+		err = frame_send();
+		if (!err) {
+			err = frame_start();
+		}
+		if (!err) {
+			err = ei_data_forwarder_frame_add(&frame, data_ptr, data_cnt);
+		}
+	}
+
+	if (!err && (frame.sample_cnt >= FRAME_SAMPLES)) {
+		err = frame_send();
+	}
+
+	return err;
+}
+
+static bool handle_sensor_event_binary(const struct sensor_event *event)
+{
+	int err = forward_binary(sensor_event_get_data_ptr(event),
+				 sensor_event_get_data_cnt(event));
+
+	if (err == -ENOMEM) {
+		LOG_WRN("No space to buffer data");
+		LOG_WRN("Sampling frequency is too high");
+		update_state(STATE_BLOCKED);
+	} else if (err == -ENOBUFS) {
+		LOG_ERR("Sensor readout does not fit in a frame");
+		report_error();
+	} else if (err) {
+		update_state(STATE_BLOCKED);
+	}
+
+	return false;
+}
+
 static bool handle_sensor_event(const struct sensor_event *event)
 {
 	if ((event->descr != handled_sensor_event_descr) &&
@@ -222,6 +323,10 @@ static bool handle_sensor_event(const struct sensor_event *event)
 
 	__ASSERT_NO_MSG(sensor_event_get_data_cnt(event) > 0);
 
+	if (BINARY_FORMAT) {
+		return handle_sensor_event_binary(event);
+	}
+
 	static uint8_t buf[DATA_BUF_SIZE];
 	int pos = ei_data_forwarder_parse_data(sensor_event_get_data_ptr(event),
 					       sensor_event_get_data_cnt(event),
@@ -22,6 +22,15 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_ML_APP_EI_DATA_FORWARDER_LOG_LEVEL);
 #define UART_LABEL		CONFIG_ML_APP_EI_DATA_FORWARDER_UART_DEV
 #define UART_BUF_SIZE		CONFIG_ML_APP_EI_DATA_FORWARDER_BUF_SIZE
 #define ML_STATE_CONTROL	IS_ENABLED(CONFIG_ML_APP_ML_STATE_EVENTS)
+#define BINARY_FORMAT		IS_ENABLED(CONFIG_ML_APP_EI_DATA_FORWARDER_FORMAT_BINARY)
+
+#if BINARY_FORMAT
+#define FRAME_SAMPLES		CONFIG_ML_APP_EI_DATA_FORWARDER_FRAME_SAMPLES
+#define FRAME_BUF_COUNT		2
+#else
+#define FRAME_SAMPLES		1
+#define FRAME_BUF_COUNT		1
+#endif
 
 enum state {
 	STATE_DISABLED,
@@ -38,6 +47,13 @@ static const struct device *dev;
 static atomic_t uart_busy;
 static enum state state = STATE_DISABLED;
 
+/* Binary frames are double buffered: one is filled while the other is sent.
+ * Text lines use a single buffer.
+ */
+static uint8_t frame_buf[FRAME_BUF_COUNT][UART_BUF_SIZE];
+static struct ei_data_forwarder_frame frame;
+static uint8_t frame_idx;
+
 
 static void broadcast_ei_data_forwarder_state(enum ei_data_forwarder_state forwarder_state)
 {
@@ -84,6 +100,86 @@ static void report_error(void)
 	module_set_state(MODULE_STATE_ERROR);
 }
 
+static void frame_reset(void)
+{
+	ei_data_forwarder_frame_init(&frame, frame_buf[frame_idx], sizeof(frame_buf[frame_idx]));
+}
+
+static int frame_send(void)
+{
+	size_t len = ei_data_forwarder_frame_finish(&frame);
+
+	if (len == 0) {
+		return 0;
+	}
+
+	/* Ensure that previous frame was sent. */
+	if (!atomic_cas(&uart_busy, false, true)) {
+		return -EBUSY;
+	}
+
+	int err = uart_tx(dev, frame.buf, len, SYS_FOREVER_MS);
+
+	if (err) {
+		atomic_cas(&uart_busy, true, false);
+		LOG_ERR("uart_tx error: %d", err);
+		return err;
+	}
+
+	frame_idx ^= 1;
+	frame_reset();
+
+	return 0;
+}
+
+static int forward_binary(const float *data_ptr, size_t data_cnt)
+{
+	int err = 0;
+
+	if (frame.sample_cnt >= FRAME_SAMPLES) {
+		/* Full frame was not sent yet because UART was busy. */
+		err = frame_send();
+		if (err) {
+			return err;
+		}
+	}
+
+	err = ei_data_forwarder_frame_add(&frame, data_ptr, data_cnt);
+	if (err == -ENOBUFS) {
+		err = frame_send();
+		if (!err) {
+			err = ei_data_forwarder_frame_add(&frame, data_ptr, data_cnt);
+		}
+	}
+
+	if (!err && (frame.sample_cnt >= FRAME_SAMPLES)) {
+		/* If UART is busy, the frame is sent with the next readout. */
+		err = frame_send();
+		if (err == -EBUSY) {
+			err = 0;
+		}
+	}
+
+	return err;
+}
+
+static bool handle_sensor_event_binary(const struct sensor_event *event)
+{
+	int err = forward_binary(sensor_event_get_data_ptr(event),
+				 sensor_event_get_data_cnt(event));
+
+	if (err == -EBUSY) {
+		LOG_WRN("UART not ready");
+		LOG_WRN("Sampling frequency is too high");
+		update_state(STATE_BLOCKED);
+	} else if (err) {
+		LOG_ERR("EI data forwader framing error: %d", err);
+		report_error();
+	}
+
+	return false;
+}
+
 static bool handle_sensor_event(const struct sensor_event *event)
 {
 	if ((event->descr != handled_sensor_event_descr) &&
@@ -97,6 +193,10 @@ static bool handle_sensor_event(const struct sensor_event *event)
 
 	__ASSERT_NO_MSG(sensor_event_get_data_cnt(event) > 0);
 
+	if (BINARY_FORMAT) {
+		return handle_sensor_event_binary(event);
+	}
+
 	/* Ensure that previous sensor_event was sent. */
 	if (!atomic_cas(&uart_busy, false, true)) {
 		LOG_WRN("UART not ready");
@@ -105,12 +205,12 @@ static bool handle_sensor_event(const struct sensor_event *event)
 		return false;
 	}
 
-	static uint8_t buf[UART_BUF_SIZE];
+	uint8_t *buf = frame_buf[0];
 
 	int pos = ei_data_forwarder_parse_data(sensor_event_get_data_ptr(event),
 					       sensor_event_get_data_cnt(event),
 					       buf,
-					       sizeof(buf));
+					       sizeof(frame_buf[0]));
 
 	if (pos < 0) {
 		atomic_cas(&uart_busy, true, false);
@@ -139,6 +239,9 @@ static bool handle_ml_state_event(const struct ml_state_event *event)
 	}
 
 	if (event->state == ML_STATE_DATA_FORWARDING) {
+		if (BINARY_FORMAT) {
+			frame_reset();
+		}
 		update_state(STATE_ACTIVE);
 	} else {
 		update_state(STATE_SUSPENDED);
@@ -163,6 +266,10 @@ static int init(void)
 		return -ENXIO;
 	}
 
+	if (BINARY_FORMAT) {
+		frame_reset();
+	}
+
 	int err = uart_callback_set(dev, uart_cb, NULL);
 
 	if (err) {
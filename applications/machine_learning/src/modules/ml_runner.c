@@ -22,6 +22,15 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_ML_APP_ML_RUNNER_LOG_LEVEL);
 
 #define APP_CONTROLS_ML_STATE	IS_ENABLED(CONFIG_ML_APP_ML_STATE_EVENTS)
 
+#define ACTIVITY_GATING		IS_ENABLED(CONFIG_ML_APP_ML_RUNNER_ACTIVITY_GATING)
+#if ACTIVITY_GATING
+#define ACTIVITY_THRESHOLD	(CONFIG_ML_APP_ML_RUNNER_ACTIVITY_THRESHOLD / 1000.0f)
+#else
+#define ACTIVITY_THRESHOLD	0.0f
+#endif
+/* Number of values of a sensor event taken into account for activity. */
+#define ACTIVITY_VALUES_MAX	8
+
 /* Make sure that event handlers will not be preempted by the EI wrapper's callback. */
 BUILD_ASSERT(CONFIG_SYSTEM_WORKQUEUE_PRIORITY < CONFIG_EI_WRAPPER_THREAD_PRIORITY);
 
@@ -50,6 +59,24 @@ enum {
 	ML_CLEANUP_REQUIRED		= BIT(1),
 	ML_FIRST_PREDICTION		= BIT(2),
 	ML_RUNNING			= BIT(3),
+	ML_GATED			= BIT(4),
+};
+
+struct activity {
+	float prev_values[ACTIVITY_VALUES_MAX];
+	bool prev_valid;
+	/* Moving average of the mean absolute change of a value between frames. */
+	float level;
+	float alpha;
+	/* Frames between predictions and frames since the last gated result. */
+	size_t shift_frames;
+	size_t gated_frames;
+};
+
+struct cached_result {
+	const char *label;
+	float value;
+	float anomaly;
 };
 
 BUILD_ASSERT(ARRAY_SIZE(CONFIG_ML_APP_ML_RUNNER_SENSOR_EVENT_DESCR) > 1);
@@ -58,6 +85,8 @@ static const char *handled_sensor_event_descr = CONFIG_ML_APP_ML_RUNNER_SENSOR_E
 static uint8_t ml_control;
 static enum state state;
 static struct module_flags active_listeners;
+static struct activity activity;
+static struct cached_result cached_result;
 
 
 static void report_error(void)
@@ -80,9 +109,67 @@ static void submit_result(void)
 	__ASSERT_NO_MSG(!err);
 	ARG_UNUSED(err);
 
+	if (ACTIVITY_GATING) {
+		cached_result.label = evt->label;
+		cached_result.value = evt->value;
+		cached_result.anomaly = evt->anomaly;
+	}
+
+	EVENT_SUBMIT(evt);
+}
+
+static void submit_cached_result(void)
+{
+	struct ml_result_event *evt = new_ml_result_event();
+
+	evt->label = cached_result.label;
+	evt->value = cached_result.value;
+	evt->anomaly = cached_result.anomaly;
+
 	EVENT_SUBMIT(evt);
 }
 
+static void activity_init(void)
+{
+	size_t frame_size = ei_wrapper_get_frame_size();
+	size_t window_frames = ei_wrapper_get_window_size() / frame_size;
+
+	__ASSERT_NO_MSG(window_frames > 0);
+
+	/* Average activity over roughly one prediction window. */
+	activity.alpha = 1.0f / window_frames;
+	activity.shift_frames = SHIFT_WINDOWS * window_frames + SHIFT_FRAMES;
+	if (activity.shift_frames == 0) {
+		activity.shift_frames = window_frames;
+	}
+}
+
+static bool activity_update(const float *data, size_t data_cnt)
+{
+	size_t cnt = MIN(data_cnt, ACTIVITY_VALUES_MAX);
+	float change = 0.0f;
+
+	for (size_t i = 0; i < cnt; i++) {
+		if (activity.prev_valid) {
+			float diff = data[i] - activity.prev_values[i];
+
+			change += (diff < 0) ? -diff : diff;
+		}
+		activity.prev_values[i] = data[i];
+	}
+
+	if (activity.prev_valid) {
+		change /= cnt;
+		activity.level += activity.alpha * (change - activity.level);
+	} else {
+		/* Do not gate until the average is built up. */
+		activity.level = ACTIVITY_THRESHOLD;
+		activity.prev_valid = true;
+	}
+
+	return activity.level >= ACTIVITY_THRESHOLD;
+}
+
 static int buf_cleanup(void)
 {
 	bool cancelled = false;
@@ -98,6 +185,7 @@ static int buf_cleanup(void)
 		}
 
 		ml_control &= ~ML_CLEANUP_REQUIRED;
+		ml_control &= ~ML_GATED;
 		ml_control |= ML_FIRST_PREDICTION;
 	} else if (err == -EBUSY) {
 		__ASSERT_NO_MSG(ml_control & ML_RUNNING);
@@ -161,7 +249,16 @@ static void result_ready_cb(int err)
 		ml_control &= ~ML_RUNNING;
 
 		if (state == STATE_ACTIVE) {
-			start_prediction();
+			if (ACTIVITY_GATING && !drop_result &&
+			    (activity.level < ACTIVITY_THRESHOLD)) {
+				/* Static input: skip predictions and repeat this
+				 * result until the signal becomes active again.
+				 */
+				ml_control |= ML_GATED;
+				activity.gated_frames = 0;
+			} else {
+				start_prediction();
+			}
 		}
 	}
 
@@ -180,7 +277,14 @@ static int init(void)
 
 	if (err) {
 		LOG_ERR("Edge Impulse wrapper failed to initialize (err: %d)", err);
-	} else if (!APP_CONTROLS_ML_STATE) {
+		return err;
+	}
+
+	if (ACTIVITY_GATING) {
+		activity_init();
+	}
+
+	if (!APP_CONTROLS_ML_STATE) {
 		start_prediction();
 	}
 
@@ -198,12 +302,38 @@ static bool handle_sensor_event(const struct sensor_event *event)
 		return false;
 	}
 
+	bool restart = false;
+
+	if (ACTIVITY_GATING) {
+		bool active = activity_update(sensor_event_get_data_ptr(event),
+					      sensor_event_get_data_cnt(event));
+
+		if (ml_control & ML_GATED) {
+			if (!active) {
+				activity.gated_frames++;
+				if (activity.gated_frames >= activity.shift_frames) {
+					activity.gated_frames = 0;
+					submit_cached_result();
+				}
+				return false;
+			}
+
+			/* Input became active: predict on a window of new data. */
+			if (buf_cleanup()) {
+				return false;
+			}
+			restart = true;
+		}
+	}
+
 	int err = ei_wrapper_add_data(sensor_event_get_data_ptr(event),
 				      sensor_event_get_data_cnt(event));
 
 	if (err) {
 		LOG_ERR("Cannot add data for EI wrapper (err %d)", err);
 		report_error();
+	} else if (restart) {
+		start_prediction();
 	}
 
 	return false;
@@ -6,6 +6,7 @@
 
 #include <zephyr.h>
 #include <stdio.h>
+#include <sys/byteorder.h>
 #include "ei_data_forwarder.h"
 
 
@@ -47,3 +48,65 @@ int ei_data_forwarder_parse_data(const float *data_ptr, size_t data_cnt,
 
 	return pos;
 }
+
+void ei_data_forwarder_frame_init(struct ei_data_forwarder_frame *frame,
+				  uint8_t *buf, size_t buf_size)
+{
+	__ASSERT_NO_MSG(buf_size > EI_DATA_FORWARDER_FRAME_HDR_SIZE);
+
+	frame->buf = buf;
+	frame->buf_size = buf_size;
+	frame->pos = EI_DATA_FORWARDER_FRAME_HDR_SIZE;
+	frame->sample_cnt = 0;
+	frame->value_cnt = 0;
+}
+
+int ei_data_forwarder_frame_add(struct ei_data_forwarder_frame *frame,
+				const float *data_ptr, size_t data_cnt)
+{
+	size_t size = data_cnt * sizeof(float);
+
+	if ((data_cnt == 0) || (data_cnt > UINT8_MAX)) {
+		return -EINVAL;
+	}
+
+	if (frame->sample_cnt == 0) {
+		frame->value_cnt = data_cnt;
+	} else if ((frame->value_cnt != data_cnt) || (frame->sample_cnt == UINT8_MAX)) {
+		return -ENOBUFS;
+	}
+
+	if (frame->pos + size > frame->buf_size) {
+		return -ENOBUFS;
+	}
+
+#ifdef CONFIG_LITTLE_ENDIAN
+	memcpy(&frame->buf[frame->pos], data_ptr, size);
+#else
+	for (size_t i = 0; i < data_cnt; i++) {
+		uint32_t val;
+
+		memcpy(&val, &data_ptr[i], sizeof(val));
+		sys_put_le32(val, &frame->buf[frame->pos + i * sizeof(val)]);
+	}
+#endif /* CONFIG_LITTLE_ENDIAN */
+
+	frame->pos += size;
+	frame->sample_cnt++;
+
+	return 0;
+}
+
+size_t ei_data_forwarder_frame_finish(struct ei_data_forwarder_frame *frame)
+{
+	if (frame->sample_cnt == 0) {
+		return 0;
+	}
+
+	frame->buf[0] = EI_DATA_FORWARDER_FRAME_SYNC_0;
+	frame->buf[1] = EI_DATA_FORWARDER_FRAME_SYNC_1;
+	frame->buf[2] = frame->sample_cnt;
+	frame->buf[3] = frame->value_cnt;
+
+	return frame->pos;
+}
@@ -7,8 +7,31 @@
 #ifndef _EI_DATA_FORWARDER_H_
 #define _EI_DATA_FORWARDER_H_
 
+/* Binary frame: sync word, sample count, values per sample and the samples
+ * as little-endian float32 values.
+ */
+#define EI_DATA_FORWARDER_FRAME_SYNC_0		0xA5
+#define EI_DATA_FORWARDER_FRAME_SYNC_1		0x5A
+#define EI_DATA_FORWARDER_FRAME_HDR_SIZE	4
+
+struct ei_data_forwarder_frame {
+	uint8_t *buf;
+	size_t buf_size;
+	size_t pos;
+	uint8_t sample_cnt;
+	uint8_t value_cnt;
+};
+
 
 int ei_data_forwarder_parse_data(const float *data_ptr, size_t data_cnt,
 				 uint8_t *buf, size_t buf_size);
 
+void ei_data_forwarder_frame_init(struct ei_data_forwarder_frame *frame,
+				  uint8_t *buf, size_t buf_size);
+
+int ei_data_forwarder_frame_add(struct ei_data_forwarder_frame *frame,
+				const float *data_ptr, size_t data_cnt);
+
+size_t ei_data_forwarder_frame_finish(struct ei_data_forwarder_frame *frame);
+
 #endif /* _EI_DATA_FORWARDER_H_ */
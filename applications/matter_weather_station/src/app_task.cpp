@@ -46,10 +46,36 @@ constexpr uint8_t kPressureMeasurementEndpointId = 3;
 constexpr int16_t kPressureMeasurementAttributeMaxValue = 0x7fff;
 constexpr int16_t kPressureMeasurementAttributeMinValue = 0x8001;
 constexpr int16_t kPressureMeasurementAttributeInvalidValue = 0x8000;
+/* Minimum change of a measured value that is written to the attribute, in attribute units. */
+constexpr int16_t kTemperatureMeasurementThreshold = 10; /* 0.1 degC */
+constexpr uint16_t kHumidityMeasurementThreshold = 50; /* 0.5 %RH */
+constexpr int16_t kPressureMeasurementThreshold = 1; /* 0.1 kPa */
+constexpr size_t kSampleQueueSize = 4;
+constexpr size_t kSamplingStackSize = 1024;
+
+/* Measurement converted to cluster attribute units. */
+struct Sample {
+	int16_t mTemperature;
+	uint16_t mHumidity;
+	int16_t mPressure;
+};
+
+/* Last values written to the attributes. */
+struct ReportedValue {
+	int32_t mValue;
+	bool mValid;
+};
 
 K_MSGQ_DEFINE(sAppEventQueue, sizeof(AppEvent), kAppEventQueueSize, alignof(AppEvent));
+K_MSGQ_DEFINE(sSampleQueue, sizeof(Sample), kSampleQueueSize, alignof(Sample));
+K_THREAD_STACK_DEFINE(sSamplingStack, kSamplingStackSize);
+k_work_q sSamplingWorkQueue;
+k_work sSamplingWork;
 k_timer sFunctionTimer;
 k_timer sMeasurementsTimer;
+ReportedValue sReportedTemperature;
+ReportedValue sReportedHumidity;
+ReportedValue sReportedPressure;
 FunctionTimerMode sFunctionTimerMode = FunctionTimerMode::kDisabled;
 
 LEDWidget sRedLED;
@@ -64,6 +90,21 @@ bool sHaveBLEConnections;
 LedState sLedState = LedState::kAlive;
 
 const device *kBme688SensorDev = device_get_binding(DT_LABEL(DT_INST(0, bosch_bme680)));
+
+/* Change-threshold filter: check if a new value differs enough from the last written one. */
+bool ShouldReport(ReportedValue &reported, int32_t value, int32_t invalidValue, int32_t threshold)
+{
+	bool valid = (value != invalidValue);
+	int32_t change = value - reported.mValue;
+
+	if (valid != reported.mValid || (valid && (change >= threshold || change <= -threshold))) {
+		reported.mValue = value;
+		reported.mValid = valid;
+		return true;
+	}
+
+	return false;
+}
 } /* namespace */
 
 AppTask AppTask::sAppTask;
@@ -98,9 +139,13 @@ int AppTask::Init()
 	k_timer_init(
 		&sFunctionTimer, [](k_timer *) { sAppTask.PostEvent(AppEvent::Type::kTimer, FunctionTimerHandler); },
 		nullptr);
+	/* Sensor sampling runs in a low priority work queue, so that it does not delay the app task. */
+	k_work_queue_start(&sSamplingWorkQueue, sSamplingStack, K_THREAD_STACK_SIZEOF(sSamplingStack),
+			   K_LOWEST_APPLICATION_THREAD_PRIO, nullptr);
+	k_work_init(&sSamplingWork, SamplingWorkHandler);
 	k_timer_init(
-		&sMeasurementsTimer,
-		[](k_timer *) { sAppTask.PostEvent(AppEvent::Type::kTimer, MeasurementsTimerHandler); }, nullptr);
+		&sMeasurementsTimer, [](k_timer *) { k_work_submit_to_queue(&sSamplingWorkQueue, &sSamplingWork); },
+		nullptr);
 	k_timer_start(&sMeasurementsTimer, K_MSEC(kMeasurementsIntervalMs),
 		      K_MSEC(kMeasurementsIntervalMs));
 
@@ -241,16 +286,11 @@ void AppTask::FunctionTimerHandler(AppEvent *)
 	}
 }
 
-void AppTask::MeasurementsTimerHandler(AppEvent *)
-{
-	sAppTask.UpdateClusterState();
-}
-
-void AppTask::UpdateClusterState()
+void AppTask::SamplingWorkHandler(k_work *)
 {
 	struct sensor_value sTemperature, sPressure, sHumidity;
+	Sample sample;
 	int result = sensor_sample_fetch(kBme688SensorDev);
-	EmberAfStatus status;
 
 	if (result != 0) {
 		LOG_ERR("Fetching data from BME688 sensor failed with: %d", result);
@@ -262,23 +302,16 @@ void AppTask::UpdateClusterState()
 		/* Defined by cluster temperature measured value = 100 x temperature in degC with resolution of
 		 * 0.01 degC. val1 is an integer part of the value and val2 is fractional part in one-millionth
 		 * parts. To achieve resolution of 0.01 degC val2 needs to be divided by 10000. */
-		int16_t newValue = static_cast<int16_t>(sTemperature.val1 * 100 + sTemperature.val2 / 10000);
+		sample.mTemperature = static_cast<int16_t>(sTemperature.val1 * 100 + sTemperature.val2 / 10000);
 
-		if (newValue > kTemperatureMeasurementAttributeMaxValue ||
-		    newValue < kTemperatureMeasurementAttributeMinValue) {
+		if (sample.mTemperature > kTemperatureMeasurementAttributeMaxValue ||
+		    sample.mTemperature < kTemperatureMeasurementAttributeMinValue) {
 			/* Read value exceeds permitted limits, so assign invalid value code to it. */
-			newValue = kTemperatureMeasurementAttributeInvalidValue;
-		}
-
-		status = emberAfWriteAttribute(kTemperatureMeasurementEndpointId, ZCL_TEMP_MEASUREMENT_CLUSTER_ID,
-					       ZCL_TEMP_MEASURED_VALUE_ATTRIBUTE_ID, CLUSTER_MASK_SERVER,
-					       reinterpret_cast<uint8_t *>(&newValue), ZCL_INT16S_ATTRIBUTE_TYPE);
-
-		if (status != EMBER_ZCL_STATUS_SUCCESS) {
-			LOG_ERR("Updating temperature measurement %x", status);
+			sample.mTemperature = kTemperatureMeasurementAttributeInvalidValue;
 		}
 	} else {
 		LOG_ERR("Getting temperature measurement data from BME688 failed with: %d", result);
+		sample.mTemperature = kTemperatureMeasurementAttributeInvalidValue;
 	}
 
 	result = sensor_channel_get(kBme688SensorDev, SENSOR_CHAN_PRESS, &sPressure);
@@ -286,23 +319,16 @@ void AppTask::UpdateClusterState()
 		/* Defined by cluster pressure measured value = 10 x pressure in kPa with resolution of 0.1 kPa.
 		 * val1 is an integer part of the value and val2 is fractional part in one-millionth parts.
 		 * To achieve resolution of 0.1 kPa val2 needs to be divided by 100000. */
-		int16_t newValue = static_cast<int16_t>(sPressure.val1 * 10 + sPressure.val2 / 100000);
+		sample.mPressure = static_cast<int16_t>(sPressure.val1 * 10 + sPressure.val2 / 100000);
 
-		if (newValue > kPressureMeasurementAttributeMaxValue ||
-		    newValue < kPressureMeasurementAttributeMinValue) {
+		if (sample.mPressure > kPressureMeasurementAttributeMaxValue ||
+		    sample.mPressure < kPressureMeasurementAttributeMinValue) {
 			/* Read value exceeds permitted limits, so assign invalid value code to it. */
-			newValue = kPressureMeasurementAttributeInvalidValue;
-		}
-
-		status = emberAfWriteAttribute(kPressureMeasurementEndpointId, ZCL_PRESSURE_MEASUREMENT_CLUSTER_ID,
-					       ZCL_PRESSURE_MEASURED_VALUE_ATTRIBUTE_ID, CLUSTER_MASK_SERVER,
-					       reinterpret_cast<uint8_t *>(&newValue), ZCL_INT16S_ATTRIBUTE_TYPE);
-
-		if (status != EMBER_ZCL_STATUS_SUCCESS) {
-			LOG_ERR("Updating pressure measurement %x", status);
+			sample.mPressure = kPressureMeasurementAttributeInvalidValue;
 		}
 	} else {
 		LOG_ERR("Getting pressure measurement data from BME688 failed with: %d", result);
+		sample.mPressure = kPressureMeasurementAttributeInvalidValue;
 	}
 
 	result = sensor_channel_get(kBme688SensorDev, SENSOR_CHAN_HUMIDITY, &sHumidity);
@@ -310,24 +336,81 @@ void AppTask::UpdateClusterState()
 		/* Defined by cluster humidity measured value = 100 x humidity in %RH with resolution of 0.01 %.
 		 * val1 is an integer part of the value and val2 is fractional part in one-millionth parts.
 		 * To achieve resolution of 0.01 % val2 needs to be divided by 10000. */
-		uint16_t newValue = static_cast<int16_t>(sHumidity.val1 * 100 + sHumidity.val2 / 10000);
+		sample.mHumidity = static_cast<int16_t>(sHumidity.val1 * 100 + sHumidity.val2 / 10000);
 
-		if (newValue > kHumidityMeasurementAttributeMaxValue ||
-		    newValue < kHumidityMeasurementAttributeMinValue) {
+		if (sample.mHumidity > kHumidityMeasurementAttributeMaxValue ||
+		    sample.mHumidity < kHumidityMeasurementAttributeMinValue) {
 			/* Read value exceeds permitted limits, so assign invalid value code to it. */
-			newValue = kHumidityMeasurementAttributeInvalidValue;
+			sample.mHumidity = kHumidityMeasurementAttributeInvalidValue;
+		}
+	} else {
+		LOG_ERR("Getting humidity measurement data from BME688 failed with: %d", result);
+		sample.mHumidity = kHumidityMeasurementAttributeInvalidValue;
+	}
+
+	/* If the app task lags behind, drop the oldest sample. */
+	while (k_msgq_put(&sSampleQueue, &sample, K_NO_WAIT) != 0) {
+		Sample dropped;
+
+		k_msgq_get(&sSampleQueue, &dropped, K_NO_WAIT);
+	}
+
+	sAppTask.PostEvent(AppEvent::Type::kTimer, MeasurementsTimerHandler);
+}
+
+void AppTask::MeasurementsTimerHandler(AppEvent *)
+{
+	sAppTask.UpdateClusterState();
+}
+
+void AppTask::UpdateClusterState()
+{
+	Sample sample;
+	bool haveSample = false;
+	EmberAfStatus status;
+
+	/* Only the latest sample is relevant for the attributes. */
+	while (k_msgq_get(&sSampleQueue, &sample, K_NO_WAIT) == 0) {
+		haveSample = true;
+	}
+
+	if (!haveSample) {
+		return;
+	}
+
+	if (ShouldReport(sReportedTemperature, sample.mTemperature, kTemperatureMeasurementAttributeInvalidValue,
+			 kTemperatureMeasurementThreshold)) {
+		status = emberAfWriteAttribute(kTemperatureMeasurementEndpointId, ZCL_TEMP_MEASUREMENT_CLUSTER_ID,
+					       ZCL_TEMP_MEASURED_VALUE_ATTRIBUTE_ID, CLUSTER_MASK_SERVER,
+					       reinterpret_cast<uint8_t *>(&sample.mTemperature),
+					       ZCL_INT16S_ATTRIBUTE_TYPE);
+
+		if (status != EMBER_ZCL_STATUS_SUCCESS) {
+			LOG_ERR("Updating temperature measurement %x", status);
 		}
+	}
 
+	if (ShouldReport(sReportedPressure, sample.mPressure, kPressureMeasurementAttributeInvalidValue,
+			 kPressureMeasurementThreshold)) {
+		status = emberAfWriteAttribute(kPressureMeasurementEndpointId, ZCL_PRESSURE_MEASUREMENT_CLUSTER_ID,
+					       ZCL_PRESSURE_MEASURED_VALUE_ATTRIBUTE_ID, CLUSTER_MASK_SERVER,
+					       reinterpret_cast<uint8_t *>(&sample.mPressure), ZCL_INT16S_ATTRIBUTE_TYPE);
+
+		if (status != EMBER_ZCL_STATUS_SUCCESS) {
+			LOG_ERR("Updating pressure measurement %x", status);
+		}
+	}
+
+	if (ShouldReport(sReportedHumidity, sample.mHumidity, kHumidityMeasurementAttributeInvalidValue,
+			 kHumidityMeasurementThreshold)) {
 		status = emberAfWriteAttribute(kHumidityMeasurementEndpointId,
 					       ZCL_RELATIVE_HUMIDITY_MEASUREMENT_CLUSTER_ID,
 					       ZCL_RELATIVE_HUMIDITY_MEASURED_VALUE_ATTRIBUTE_ID, CLUSTER_MASK_SERVER,
-					       reinterpret_cast<uint8_t *>(&newValue), ZCL_INT16U_ATTRIBUTE_TYPE);
+					       reinterpret_cast<uint8_t *>(&sample.mHumidity), ZCL_INT16U_ATTRIBUTE_TYPE);
 
 		if (status != EMBER_ZCL_STATUS_SUCCESS) {
 			LOG_ERR("Updating relative humidity measurement %x", status);
 		}
-	} else {
-		LOG_ERR("Getting humidity measurement data from BME688 failed with: %d", result);
 	}
 }
 
@@ -15,6 +15,7 @@
 #endif
 
 struct k_timer;
+struct k_work;
 
 class AppTask {
 public:
@@ -40,6 +41,7 @@ private:
 	static void ButtonReleaseHandler(AppEvent *event);
 	static void FunctionTimerHandler(AppEvent *event);
 	static void MeasurementsTimerHandler(AppEvent *event);
+	static void SamplingWorkHandler(k_work *work);
 	static void ChipEventHandler(const chip::DeviceLayer::ChipDeviceEvent *event, intptr_t arg);
 
 	static AppTask sAppTask;
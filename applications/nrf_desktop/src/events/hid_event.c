@@ -47,9 +47,17 @@ static void profile_hid_report_event(struct log_event_buf *buf,
 
 	__ASSERT_NO_MSG(event->dyndata.size > 0);
 
-	profiler_log_encode_uint8(buf, event->dyndata.data[0]);
-	profiler_log_encode_uint32(buf, (uint32_t)event->source);
-	profiler_log_encode_uint32(buf, (uint32_t)event->subscriber);
+	const struct {
+		uint8_t report_id;
+		uint32_t source;
+		uint32_t subscriber;
+	} __packed data = {
+		.report_id = event->dyndata.data[0],
+		.source = (uint32_t)event->source,
+		.subscriber = (uint32_t)event->subscriber,
+	};
+
+	PROFILER_LOG_ENCODE_PACKED(buf, data);
 }
 
 EVENT_INFO_DEFINE(hid_report_event,
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+
+#include "hid_latency_event.h"
+
+
+static int log_hid_latency_event(const struct event_header *eh, char *buf,
+				 size_t buf_len)
+{
+	const struct hid_latency_event *event = cast_hid_latency_event(eh);
+	int pos = snprintf(buf, buf_len, "cnt=%u min=%uus avg=%uus max=%uus hist:",
+			   event->count, event->min, event->avg, event->max);
+
+	for (size_t i = 0; (i < ARRAY_SIZE(event->histogram)) && (pos >= 0) &&
+			   ((size_t)pos < buf_len); i++) {
+		pos += snprintf(&buf[pos], buf_len - pos, " %u",
+				event->histogram[i]);
+	}
+
+	return pos;
+}
+
+static void profile_hid_latency_event(struct log_event_buf *buf,
+				      const struct event_header *eh)
+{
+	const struct hid_latency_event *event = cast_hid_latency_event(eh);
+
+	profiler_log_encode_uint32(buf, event->count);
+	profiler_log_encode_uint32(buf, event->min);
+	profiler_log_encode_uint32(buf, event->avg);
+	profiler_log_encode_uint32(buf, event->max);
+}
+
+EVENT_INFO_DEFINE(hid_latency_event,
+		  ENCODE(PROFILER_ARG_U32, PROFILER_ARG_U32, PROFILER_ARG_U32,
+			 PROFILER_ARG_U32),
+		  ENCODE("count", "min", "avg", "max"),
+		  profile_hid_latency_event);
+
+EVENT_TYPE_DEFINE(hid_latency_event,
+		  IS_ENABLED(CONFIG_DESKTOP_INIT_LOG_HID_LATENCY_EVENT),
+		  log_hid_latency_event,
+		  &hid_latency_event_info);
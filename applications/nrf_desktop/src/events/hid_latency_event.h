@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _HID_LATENCY_EVENT_H_
+#define _HID_LATENCY_EVENT_H_
+
+/**
+ * @brief HID Latency Event
+ * @defgroup hid_latency_event HID Latency Event
+ * @{
+ */
+
+#include "event_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of latency histogram bins. */
+#define HID_LATENCY_HISTOGRAM_SIZE	8
+
+/** Upper bound of the first latency histogram bin [us]. Upper bound of every
+ *  following bin is doubled. The last bin has no upper bound.
+ */
+#define HID_LATENCY_HISTOGRAM_BASE_US	250
+
+/** @brief HID latency event.
+ *
+ * Sums up the time between motion sampling and HID transport confirming
+ * the mouse report that carried the motion.
+ */
+struct hid_latency_event {
+	struct event_header header; /**< Event header. */
+
+	uint32_t count; /**< Number of measured reports. */
+	uint32_t min; /**< Minimal latency [us]. */
+	uint32_t avg; /**< Average latency [us]. */
+	uint32_t max; /**< Maximal latency [us]. */
+	uint32_t histogram[HID_LATENCY_HISTOGRAM_SIZE]; /**< Latency histogram. */
+};
+
+EVENT_TYPE_DECLARE(hid_latency_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* _HID_LATENCY_EVENT_H_ */
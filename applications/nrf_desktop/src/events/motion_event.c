@@ -20,9 +20,15 @@ static void profile_motion_event(struct log_event_buf *buf,
 				    const struct event_header *eh)
 {
 	const struct motion_event *event = cast_motion_event(eh);
-
-	profiler_log_encode_int16(buf, event->dx);
-	profiler_log_encode_int16(buf, event->dy);
+	const struct {
+		int16_t dx;
+		int16_t dy;
+	} __packed data = {
+		.dx = event->dx,
+		.dy = event->dy,
+	};
+
+	PROFILER_LOG_ENCODE_PACKED(buf, data);
 }
 
 
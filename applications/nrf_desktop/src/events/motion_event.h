@@ -24,6 +24,8 @@ struct motion_event {
 
 	int16_t dx;
 	int16_t dy;
+
+	uint32_t timestamp; /* Motion sampling time [in cycles]. */
 };
 
 EVENT_TYPE_DECLARE(motion_event);
@@ -51,6 +51,8 @@ struct sensor_state {
 
 	enum state state;
 	bool sample;
+	bool data_ready;
+	uint32_t data_ready_time;
 	uint8_t peer_count;
 	uint32_t option[MOTION_SENSOR_OPTION_COUNT];
 	uint32_t option_mask;
@@ -187,6 +189,9 @@ static void data_ready_handler(const struct device *dev, struct sensor_trigger *
 
 	disable_trigger();
 
+	state.data_ready = true;
+	state.data_ready_time = k_cycle_get_32();
+
 	switch (state.state) {
 	case STATE_IDLE:
 		state.state = STATE_FETCHING;
@@ -223,6 +228,17 @@ static int motion_read(bool send_event)
 {
 	struct sensor_value value_x;
 	struct sensor_value value_y;
+	uint32_t timestamp = k_cycle_get_32();
+
+	/* Sample triggered by the sensor was ready before the fetch. */
+	k_spinlock_key_t key = k_spin_lock(&state.lock);
+
+	if (state.data_ready) {
+		timestamp = state.data_ready_time;
+		state.data_ready = false;
+	}
+
+	k_spin_unlock(&state.lock, key);
 
 	int err = sensor_sample_fetch(sensor_dev);
 
@@ -256,6 +272,7 @@ static int motion_read(bool send_event)
 
 	event->dx = value_x.val1;
 	event->dy = value_y.val1;
+	event->timestamp = timestamp;
 	EVENT_SUBMIT(event);
 
 	return err;
@@ -474,17 +491,24 @@ static void motion_thread_fn(void)
 
 	while (!err) {
 		bool send_event;
+		bool skip_read;
 		uint32_t option_bm;
 
 		k_sem_take(&sem, K_FOREVER);
 
 		k_spinlock_key_t key = k_spin_lock(&state.lock);
 		send_event = (state.state == STATE_FETCHING) && state.sample;
+		/* While fetching, the sensor accumulates motion until the next
+		 * HID report pulls it. Reading it earlier would drop it.
+		 */
+		skip_read = (state.state == STATE_FETCHING) && !state.sample;
 		state.sample = false;
 		option_bm = state.option_mask;
 		k_spin_unlock(&state.lock, key);
 
-		err = motion_read(send_event);
+		if (!skip_read) {
+			err = motion_read(send_event);
+		}
 
 		bool no_motion = (err == -ENODATA);
 		if (unlikely(no_motion)) {
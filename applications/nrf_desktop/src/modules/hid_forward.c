@@ -28,6 +28,8 @@
 LOG_MODULE_REGISTER(MODULE, CONFIG_DESKTOP_HID_FORWARD_LOG_LEVEL);
 
 #define MAX_ENQUEUED_ITEMS CONFIG_DESKTOP_HID_FORWARD_MAX_ENQUEUED_REPORTS
+/* Subscriber holds reports of all the peripherals that were disconnected. */
+#define REPORT_RING_SIZE (MAX_ENQUEUED_ITEMS * CONFIG_BT_MAX_CONN)
 #define CFG_CHAN_RSP_READ_DELAY		15
 #define CFG_CHAN_MAX_RSP_POLL_CNT	50
 #define CFG_CHAN_UNUSED_PEER_ID		UINT8_MAX
@@ -36,6 +38,8 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_DESKTOP_HID_FORWARD_LOG_LEVEL);
 #define PERIPHERAL_ADDRESSES_STORAGE_NAME "paddr"
 
 BUILD_ASSERT(CFG_CHAN_MAX_RSP_POLL_CNT <= UCHAR_MAX);
+BUILD_ASSERT(REPORT_RING_SIZE <= UINT16_MAX);
+BUILD_ASSERT(ARRAY_SIZE(input_reports) < __CHAR_BIT__ * sizeof(uint32_t));
 
 struct enqueued_out_report {
 	sys_snode_t node;
@@ -43,18 +47,15 @@ struct enqueued_out_report {
 	size_t data_size;
 };
 
-struct enqueued_report {
-	sys_snode_t node;
-	struct hid_report_event *report;
-};
-
-struct counted_list {
-	sys_slist_t list;
-	size_t count;
+struct report_ring {
+	struct hid_report_event *items[REPORT_RING_SIZE];
+	uint16_t head;
+	uint16_t count;
 };
 
 struct enqueued_reports {
-	struct counted_list reports[ARRAY_SIZE(input_reports)];
+	struct report_ring reports[ARRAY_SIZE(input_reports)];
+	uint32_t enqueued_bm;
 	uint8_t last_idx;
 };
 
@@ -192,39 +193,50 @@ static bool is_report_enabled(const struct subscriber *sub, uint8_t report_id)
 static bool is_report_enqueued(struct enqueued_reports *enqueued_reports,
 			       size_t irep_idx)
 {
-	struct counted_list *reports = &enqueued_reports->reports[irep_idx];
+	struct report_ring *reports = &enqueued_reports->reports[irep_idx];
 
-	if (reports->count == 0) {
-		__ASSERT_NO_MSG(sys_slist_is_empty(&reports->list));
+	if ((enqueued_reports->enqueued_bm & BIT(irep_idx)) == 0) {
+		__ASSERT_NO_MSG(reports->count == 0);
 		return false;
 	}
+	__ASSERT_NO_MSG(reports->count > 0);
 	return true;
 }
 
 static bool is_any_report_enqueued(struct enqueued_reports *enqueued_reports)
 {
-	for (size_t irep_idx = 0; irep_idx < ARRAY_SIZE(enqueued_reports->reports); irep_idx++) {
-		if (is_report_enqueued(enqueued_reports, irep_idx)) {
-			return true;
-		}
-	}
-
-	return false;
+	return (enqueued_reports->enqueued_bm != 0);
 }
 
-static struct enqueued_report *get_enqueued_report(struct enqueued_reports *enqueued_reports,
-						   size_t irep_idx)
+static struct hid_report_event *get_enqueued_report(struct enqueued_reports *enqueued_reports,
+						    size_t irep_idx)
 {
-	struct counted_list *reports = &enqueued_reports->reports[irep_idx];
-	struct enqueued_report *item;
+	struct report_ring *reports = &enqueued_reports->reports[irep_idx];
+	struct hid_report_event *report;
 
-	item = CONTAINER_OF(sys_slist_get(&reports->list),
-			    __typeof__(*item),
-			    node);
 	__ASSERT_NO_MSG(reports->count > 0);
+	report = reports->items[reports->head];
+	reports->head = next_id(reports->head, ARRAY_SIZE(reports->items));
 	reports->count--;
 
-	return item;
+	if (reports->count == 0) {
+		enqueued_reports->enqueued_bm &= ~BIT(irep_idx);
+	}
+
+	return report;
+}
+
+static void put_enqueued_report(struct enqueued_reports *enqueued_reports,
+				size_t irep_idx,
+				struct hid_report_event *report)
+{
+	struct report_ring *reports = &enqueued_reports->reports[irep_idx];
+
+	__ASSERT_NO_MSG(reports->count < ARRAY_SIZE(reports->items));
+	reports->items[(reports->head + reports->count) % ARRAY_SIZE(reports->items)] = report;
+	reports->count++;
+
+	enqueued_reports->enqueued_bm |= BIT(irep_idx);
 }
 
 static void drop_enqueued_reports(struct enqueued_reports *enqueued_reports,
@@ -233,44 +245,40 @@ static void drop_enqueued_reports(struct enqueued_reports *enqueued_reports,
 	__ASSERT_NO_MSG(irep_idx < ARRAY_SIZE(enqueued_reports->reports));
 
 	while (is_report_enqueued(enqueued_reports, irep_idx)) {
-		struct enqueued_report *item;
-
-		item = get_enqueued_report(enqueued_reports, irep_idx);
-
-		k_free(item->report);
-		k_free(item);
+		k_free(get_enqueued_report(enqueued_reports, irep_idx));
 	}
 }
 
 static void init_enqueued_reports(struct enqueued_reports *enqueued_reports)
 {
 	for (size_t irep_idx = 0; irep_idx < ARRAY_SIZE(enqueued_reports->reports); irep_idx++) {
-		struct counted_list *reports = &enqueued_reports->reports[irep_idx];
+		struct report_ring *reports = &enqueued_reports->reports[irep_idx];
 
-		sys_slist_init(&reports->list);
+		reports->head = 0;
 		reports->count = 0;
 	}
 
+	enqueued_reports->enqueued_bm = 0;
 	enqueued_reports->last_idx = 0;
 }
 
-static struct enqueued_report *get_next_enqueued_report(struct enqueued_reports *enqueued_reports)
+static struct hid_report_event *get_next_enqueued_report(struct enqueued_reports *enqueued_reports)
 {
-	struct enqueued_report *item = NULL;
+	uint32_t bm = enqueued_reports->enqueued_bm;
 
-	for (size_t i = 0; i < ARRAY_SIZE(enqueued_reports->reports); i++) {
-		size_t irep_idx = next_id(enqueued_reports->last_idx + i,
-					  ARRAY_SIZE(enqueued_reports->reports));
+	if (bm == 0) {
+		return NULL;
+	}
 
-		if (is_report_enqueued(enqueued_reports, irep_idx)) {
-			item = get_enqueued_report(enqueued_reports, irep_idx);
+	/* Round robin over report types: take the first one enqueued after
+	 * the last one sent, wrapping around if there is none.
+	 */
+	uint32_t next_bm = bm & ~BIT_MASK(enqueued_reports->last_idx + 1);
+	size_t irep_idx = find_lsb_set(next_bm ? next_bm : bm) - 1;
 
-			enqueued_reports->last_idx = irep_idx;
-			break;
-		}
-	}
+	enqueued_reports->last_idx = irep_idx;
 
-	return item;
+	return get_enqueued_report(enqueued_reports, irep_idx);
 }
 
 static void migrate_enqueued_reports(struct enqueued_reports *dst_reports,
@@ -278,7 +286,7 @@ static void migrate_enqueued_reports(struct enqueued_reports *dst_reports,
 {
 	/* Migrate only up to MAX_ENQUEUED_ITEMS newest items.
 	 * As per can hold up only up to MAX_ENQUEUED_ITEMS at a time,
-	 * migration from per to sub will affect entire list.
+	 * migration from per to sub will affect entire ring.
 	 * When migrating from sub to par we will never get more items
 	 * then the defined limit.
 	 * Leaving the oldest items at sub will allow them to be sent
@@ -286,31 +294,21 @@ static void migrate_enqueued_reports(struct enqueued_reports *dst_reports,
 	 */
 	for (size_t irep_idx = 0; irep_idx < ARRAY_SIZE(dst_reports->reports); irep_idx++) {
 		if (is_report_enqueued(src_reports, irep_idx)) {
-			struct counted_list *dst = &dst_reports->reports[irep_idx];
-			struct counted_list *src = &src_reports->reports[irep_idx];
+			struct report_ring *src = &src_reports->reports[irep_idx];
+			size_t count = MIN(src->count, MAX_ENQUEUED_ITEMS);
+			size_t left = src->count - count;
 
-			sys_slist_t tmp_list;
-			size_t count = 0;
+			for (size_t i = 0; i < count; i++) {
+				size_t pos = (src->head + left + i) % ARRAY_SIZE(src->items);
 
-			sys_slist_init(&tmp_list);
-
-			/* Move excessive items to a temporary list. */
-			while (src->count > MAX_ENQUEUED_ITEMS) {
-				sys_snode_t *node = sys_slist_get(&src->list);
-				src->count--;
-
-				sys_slist_append(&tmp_list, node);
-				count++;
+				put_enqueued_report(dst_reports, irep_idx, src->items[pos]);
 			}
 
-			/* Source hold MAX_ENQUEUED_ITEMS items max.
-			 * Migrate the entire list. */
-			sys_slist_merge_slist(&dst->list, &src->list);
-			dst->count += src->count;
-
-			/* Bring back excessive items to the source list. */
-			src->list = tmp_list;
-			src->count = count;
+			/* Excessive items stay at the source ring. */
+			src->count = left;
+			if (left == 0) {
+				src_reports->enqueued_bm &= ~BIT(irep_idx);
+			}
 		}
 	}
 }
@@ -321,27 +319,12 @@ static void enqueue_hid_report(struct enqueued_reports *enqueued_reports,
 {
 	__ASSERT_NO_MSG(irep_idx < ARRAY_SIZE(enqueued_reports->reports));
 
-	struct counted_list *reports = &enqueued_reports->reports[irep_idx];
-
-	struct enqueued_report *item;
-
-	if (reports->count < MAX_ENQUEUED_ITEMS) {
-		item = k_malloc(sizeof(*item));
-	} else {
+	if (enqueued_reports->reports[irep_idx].count >= MAX_ENQUEUED_ITEMS) {
 		LOG_WRN("Enqueue dropped the oldest report");
-		item = get_enqueued_report(enqueued_reports, irep_idx);
-		k_free(item->report);
+		k_free(get_enqueued_report(enqueued_reports, irep_idx));
 	}
 
-	if (!item) {
-		LOG_ERR("Dropped HID report");
-		/* Should never happen. */
-		__ASSERT_NO_MSG(false);
-	} else {
-		item->report = report;
-		sys_slist_append(&reports->list, &item->node);
-		reports->count++;
-	}
+	put_enqueued_report(enqueued_reports, irep_idx, report);
 }
 
 static void forward_hid_report(struct hids_peripheral *per, uint8_t report_id,
@@ -1112,12 +1095,12 @@ static void send_enqueued_report(struct subscriber *sub)
 		return;
 	}
 
-	struct enqueued_report *item;
+	struct hid_report_event *report;
 
 	/* First try to send report left at subscriber. */
-	item = get_next_enqueued_report(&sub->enqueued_reports);
+	report = get_next_enqueued_report(&sub->enqueued_reports);
 
-	if (!item) {
+	if (!report) {
 		/* Look for any report to sent at linked peripherals. */
 		for (size_t i = 0; i < ARRAY_SIZE(peripherals); i++) {
 			size_t per_id = next_id(sub->last_peripheral_id + i,
@@ -1129,19 +1112,17 @@ static void send_enqueued_report(struct subscriber *sub)
 				continue;
 			}
 
-			item = get_next_enqueued_report(&per->enqueued_reports);
+			report = get_next_enqueued_report(&per->enqueued_reports);
 
-			if (item) {
+			if (report) {
 				sub->last_peripheral_id = per_id;
 				break;
 			}
 		}
 	}
 
-	if (item) {
-		EVENT_SUBMIT(item->report);
-
-		k_free(item);
+	if (report) {
+		EVENT_SUBMIT(report);
 
 		sub->busy = true;
 	}
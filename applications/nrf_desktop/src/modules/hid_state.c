@@ -14,7 +14,6 @@
 #include <sys/types.h>
 
 #include <zephyr/types.h>
-#include <sys/slist.h>
 #include <sys/util.h>
 #include <sys/byteorder.h>
 
@@ -25,6 +24,7 @@
 #include "hid_event.h"
 #include <caf/events/ble_common_event.h>
 #include "usb_event.h"
+#include "hid_latency_event.h"
 
 #include CONFIG_DESKTOP_HID_STATE_HID_KEYBOARD_LEDS_DEF_PATH
 #include "hid_keymap.h"
@@ -49,6 +49,10 @@ enum state {
   #define CONFIG_USB_HID_DEVICE_COUNT	0
 #endif
 
+#ifndef CONFIG_DESKTOP_HID_STATE_LATENCY_MEAS_PERIOD
+  #define CONFIG_DESKTOP_HID_STATE_LATENCY_MEAS_PERIOD	0
+#endif
+
 #define SUBSCRIBER_COUNT (IS_ENABLED(CONFIG_DESKTOP_HIDS_ENABLE) + \
 			  CONFIG_USB_HID_DEVICE_COUNT)
 
@@ -75,6 +79,8 @@ enum state {
 
 #define AXIS_COUNT (IS_ENABLED(CONFIG_DESKTOP_HID_REPORT_MOUSE_SUPPORT) * MOUSE_REPORT_AXIS_COUNT)
 
+#define REPORT_PIPELINE_DEPTH_MAX 2
+
 /**@brief HID state item. */
 struct item {
 	uint16_t usage_id; /**< HID usage ID. */
@@ -90,21 +96,38 @@ struct items {
 
 /**@brief Enqueued HID state item. */
 struct item_event {
-	sys_snode_t node; /**< Event queue linked list node. */
 	struct item item; /**< HID state item which has been enqueued. */
 	uint32_t timestamp; /**< HID event timestamp. */
 };
 
-/**@brief Event queue. */
+/**@brief Event queue. Events are stored in order of their timestamps. */
 struct eventq {
-	sys_slist_t root;
-	size_t len;
+	struct item_event event[CONFIG_DESKTOP_HID_EVENT_QUEUE_SIZE];
+	uint8_t head; /**< Position of the oldest event. */
+	uint8_t len;
 };
 
 /**@brief Axis data. */
 struct axis_data {
 	int16_t axis[AXIS_COUNT]; /**< Array of axes. */
 	uint8_t axis_count; /**< Number of axes in this array. */
+	bool timestamp_valid; /**< Axes hold motion that was not reported. */
+	uint32_t timestamp; /**< Oldest not reported motion sampling time. */
+};
+
+/**@brief Motion sampling time of a report in the pipeline. */
+struct report_timestamp {
+	bool valid;
+	uint32_t timestamp;
+};
+
+/**@brief Motion to HID report latency statistics. */
+struct latency_stats {
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t sum;
+	uint32_t histogram[HID_LATENCY_HISTOGRAM_SIZE];
 };
 
 struct report_data {
@@ -121,6 +144,8 @@ struct report_state {
 	struct subscriber *subscriber;
 	struct report_data *linked_rd;
 	bool update_needed;
+	/* Ordered as reports in the pipeline. */
+	struct report_timestamp timestamp[REPORT_PIPELINE_DEPTH_MAX];
 };
 
 struct output_report_state {
@@ -143,12 +168,13 @@ struct hid_state {
 };
 
 
-static const struct report_data empty_rd = {
-			.eventq.root = SYS_SLIST_STATIC_INIT(&empty_rd.eventq.root)};
+static const struct report_data empty_rd;
 
 static uint8_t report_data_index[REPORT_ID_COUNT];
 static uint8_t report_state_index[REPORT_ID_COUNT];
 static struct hid_state state;
+static struct latency_stats latency_stats;
+static struct k_work_delayable latency_report;
 
 
 static bool report_send(struct report_state *rs,
@@ -228,124 +254,146 @@ static int usage_id_compare(const void *a, const void *b)
 	return (p_a->usage_id - p_b->usage_id);
 }
 
-static void eventq_reset(struct eventq *eventq)
+/**@brief Insert item keeping the recorded items sorted by usage ID.
+ *
+ * Free slots are kept at the beginning of the array, so the recorded items
+ * preceding the new one are moved one slot down.
+ */
+static void item_insert(struct items *items, uint16_t usage_id, int16_t value)
 {
-	struct item_event *event;
-	struct item_event *tmp;
+	size_t first = ARRAY_SIZE(items->item) - items->item_count;
+	size_t idx = first;
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&eventq->root, event, tmp, node) {
-		sys_slist_remove(&eventq->root, NULL, &event->node);
+	__ASSERT_NO_MSG(first > 0);
 
-		k_free(event);
+	while ((idx < ARRAY_SIZE(items->item)) &&
+	       (items->item[idx].usage_id < usage_id)) {
+		items->item[idx - 1] = items->item[idx];
+		idx++;
 	}
 
-	sys_slist_init(&eventq->root);
+	items->item[idx - 1].usage_id = usage_id;
+	items->item[idx - 1].value = value;
+	items->item_count += 1;
+}
+
+/**@brief Remove item keeping the recorded items sorted by usage ID. */
+static void item_remove(struct items *items, struct item *p_item)
+{
+	struct item *first = &items->item[ARRAY_SIZE(items->item) - items->item_count];
+
+	__ASSERT_NO_MSG(items->item_count != 0);
+
+	for (; p_item > first; p_item--) {
+		*p_item = *(p_item - 1);
+	}
+
+	first->usage_id = 0;
+	first->value = 0;
+	items->item_count -= 1;
+}
+
+static void eventq_reset(struct eventq *eventq)
+{
+	eventq->head = 0;
 	eventq->len = 0;
 }
 
 static bool eventq_is_full(const struct eventq *eventq)
 {
-	return (eventq->len >= CONFIG_DESKTOP_HID_EVENT_QUEUE_SIZE);
+	return (eventq->len >= ARRAY_SIZE(eventq->event));
 }
 
 
 static bool eventq_is_empty(struct eventq *eventq)
 {
-	bool empty = sys_slist_is_empty(&eventq->root);
+	return (eventq->len == 0);
+}
 
-	__ASSERT_NO_MSG(!empty == (eventq->len != 0));
+/**@brief Get event at a given position, counting from the oldest one. */
+static struct item_event *eventq_at(struct eventq *eventq, size_t pos)
+{
+	__ASSERT_NO_MSG(pos < eventq->len);
 
-	return empty;
+	return &eventq->event[(eventq->head + pos) % ARRAY_SIZE(eventq->event)];
 }
 
-static struct item_event *eventq_get(struct eventq *eventq)
+static bool eventq_get(struct eventq *eventq, struct item_event *event)
 {
-	sys_snode_t *node = sys_slist_get(&eventq->root);
-
-	if (!node) {
-		return NULL;
+	if (eventq_is_empty(eventq)) {
+		return false;
 	}
 
+	*event = *eventq_at(eventq, 0);
+
+	eventq->head = (eventq->head + 1) % ARRAY_SIZE(eventq->event);
 	eventq->len--;
 
-	return CONTAINER_OF(node, struct item_event, node);
+	return true;
 }
 
 static void eventq_append(struct eventq *eventq, uint16_t usage_id, int16_t value)
 {
-	struct item_event *hid_event = k_malloc(sizeof(*hid_event));
+	__ASSERT_NO_MSG(!eventq_is_full(eventq));
 
-	if (!hid_event) {
-		LOG_ERR("Failed to allocate HID event");
-		/* Should never happen. */
-		__ASSERT_NO_MSG(false);
-		return;
-	}
+	/* Add a new event to the queue. */
+	eventq->len++;
+
+	struct item_event *hid_event = eventq_at(eventq, eventq->len - 1);
 
 	hid_event->item.usage_id = usage_id;
 	hid_event->item.value = value;
 	hid_event->timestamp = k_uptime_get_32();
+}
 
-	/* Add a new event to the queue. */
-	sys_slist_append(&eventq->root, &hid_event->node);
+static void eventq_region_purge(struct eventq *eventq, size_t cnt)
+{
+	__ASSERT_NO_MSG(cnt <= eventq->len);
 
-	eventq->len++;
+	eventq->head = (eventq->head + cnt) % ARRAY_SIZE(eventq->event);
+	eventq->len -= cnt;
+
+	LOG_WRN("%zu stale events removed from the queue!", cnt);
 }
 
-static void eventq_region_purge(struct eventq *eventq,
-				sys_snode_t *last_to_purge)
+/**@brief Get position of the first event that did not time out. */
+static size_t eventq_first_valid(struct eventq *eventq, uint32_t timestamp)
 {
-	sys_snode_t *tmp;
-	sys_snode_t *tmp_safe;
-	size_t cnt = 0;
-
-	SYS_SLIST_FOR_EACH_NODE_SAFE(&eventq->root, tmp, tmp_safe) {
-		sys_slist_remove(&eventq->root, NULL, tmp);
+	/* Events are appended in order, so their age only decreases
+	 * towards the end of the queue.
+	 */
+	size_t lower = 0;
+	size_t upper = eventq->len;
 
-		k_free(CONTAINER_OF(tmp, struct item_event, node));
-		cnt++;
+	while (lower < upper) {
+		size_t m = (lower + upper) / 2;
+		uint32_t diff = timestamp - eventq_at(eventq, m)->timestamp;
 
-		if (tmp == last_to_purge) {
-			break;
+		if (diff < CONFIG_DESKTOP_HID_REPORT_EXPIRATION) {
+			upper = m;
+		} else {
+			lower = m + 1;
 		}
 	}
 
-	eventq->len -= cnt;
-
-	LOG_WRN("%u stale events removed from the queue!", cnt);
+	return lower;
 }
 
-
 static void eventq_cleanup(struct eventq *eventq, uint32_t timestamp)
 {
 	/* Find timed out events. */
 
-	sys_snode_t *first_valid;
-
-	SYS_SLIST_FOR_EACH_NODE(&eventq->root, first_valid) {
-		uint32_t diff = timestamp - CONTAINER_OF(
-			first_valid, struct item_event, node)->timestamp;
-
-		if (diff < CONFIG_DESKTOP_HID_REPORT_EXPIRATION) {
-			break;
-		}
-	}
+	size_t first_valid = eventq_first_valid(eventq, timestamp);
 
 	/* Remove events but only if key up was generated for each removed
 	 * key down.
 	 */
 
-	sys_snode_t *maxfound = sys_slist_peek_head(&eventq->root);
 	size_t maxfound_pos = 0;
+	size_t purge_cnt = 0;
 
-	sys_snode_t *cur;
-	size_t cur_pos = 0;
-
-	sys_snode_t *tmp_safe;
-
-	SYS_SLIST_FOR_EACH_NODE_SAFE(&eventq->root, cur, tmp_safe) {
-		const struct item cur_item =
-			CONTAINER_OF(cur, struct item_event, node)->item;
+	for (size_t cur_pos = 0; cur_pos < eventq->len; cur_pos++) {
+		const struct item cur_item = eventq_at(eventq, cur_pos)->item;
 
 		if (cur_item.value > 0) {
 			/* Every key down must be paired with key up.
@@ -354,19 +402,10 @@ static void eventq_cleanup(struct eventq *eventq, uint32_t timestamp)
 			 */
 
 			unsigned int hit_count = cur_item.value;
-			sys_snode_t *j = cur;
-			size_t j_pos = cur_pos;
+			size_t j_pos = cur_pos + 1;
 
-			SYS_SLIST_ITERATE_FROM_NODE(&eventq->root, j) {
-				j_pos++;
-				if (j == first_valid) {
-					break;
-				}
-
-				const struct item item =
-					CONTAINER_OF(j,
-						     struct item_event,
-						     node)->item;
+			for (; (j_pos < eventq->len) && (j_pos != first_valid); j_pos++) {
+				const struct item item = eventq_at(eventq, j_pos)->item;
 
 				if (cur_item.usage_id == item.usage_id) {
 					hit_count += item.value;
@@ -380,49 +419,32 @@ static void eventq_cleanup(struct eventq *eventq, uint32_t timestamp)
 				}
 			}
 
-			if (j == first_valid) {
+			if (j_pos == first_valid) {
 				/* Pair not found. */
 				break;
 			}
 
 			if (j_pos > maxfound_pos) {
-				maxfound = j;
 				maxfound_pos = j_pos;
 			}
 		}
 
 
-		if (cur == first_valid) {
+		if (cur_pos == first_valid) {
 			break;
 		}
 
-		if (cur == maxfound) {
+		if (cur_pos == maxfound_pos) {
 			/* All events up to this point have pairs and can
-			 * be deleted.
+			 * be deleted. They are never accessed again, so
+			 * they are purged after the loop.
 			 */
-			eventq_region_purge(eventq, maxfound);
+			purge_cnt = maxfound_pos + 1;
 		}
-
-		cur_pos++;
 	}
-}
-
-static void sort_by_usage_id(struct item items[], size_t array_size)
-{
-	for (size_t k = 0; k < array_size; k++) {
-		size_t id = k;
-
-		for (size_t l = k + 1; l < array_size; l++) {
-			if (items[l].usage_id < items[id].usage_id) {
-				id = l;
-			}
-		}
-		if (id != k) {
-			struct item tmp = items[k];
 
-			items[k] = items[id];
-			items[id] = tmp;
-		}
+	if (purge_cnt > 0) {
+		eventq_region_purge(eventq, purge_cnt);
 	}
 }
 
@@ -435,6 +457,7 @@ static void clear_items(struct items *items)
 static void clear_axes(struct axis_data *axes)
 {
 	memset(axes->axis, 0, sizeof(axes->axis));
+	axes->timestamp_valid = false;
 }
 
 static void clear_report_data(struct report_data *rd)
@@ -508,8 +531,6 @@ static struct subscriber *get_linked_subscriber(uint8_t report_id)
 
 static bool key_value_set(struct items *items, uint16_t usage_id, int16_t value)
 {
-	const uint8_t prev_item_count = items->item_count;
-
 	bool update_needed = false;
 	struct item *p_item;
 
@@ -519,9 +540,10 @@ static bool key_value_set(struct items *items, uint16_t usage_id, int16_t value)
 	/* Report equal to zero brings no change. This should never happen. */
 	__ASSERT_NO_MSG(value != 0);
 
+	/* Recorded items are stored sorted at the end of the array. */
 	p_item = bsearch(&usage_id,
-			 (uint8_t *)items->item,
-			 ARRAY_SIZE(items->item),
+			 (uint8_t *)&items->item[ARRAY_SIZE(items->item) - items->item_count],
+			 items->item_count,
 			 sizeof(items->item[0]),
 			 usage_id_compare);
 
@@ -529,9 +551,7 @@ static bool key_value_set(struct items *items, uint16_t usage_id, int16_t value)
 		/* Item is present in the array - update its value. */
 		p_item->value += value;
 		if (p_item->value == 0) {
-			__ASSERT_NO_MSG(items->item_count != 0);
-			items->item_count -= 1;
-			p_item->usage_id = 0;
+			item_remove(items, p_item);
 		}
 
 		update_needed = true;
@@ -541,35 +561,19 @@ static bool key_value_set(struct items *items, uint16_t usage_id, int16_t value)
 		 * could happen if a key up event is lost and the state
 		 * receives an unpaired key down event.
 		 */
-	} else if (prev_item_count >= items->item_count_max) {
+	} else if (items->item_count >= items->item_count_max) {
 		/* Configuration should allow the HID module to hold data
 		 * about the maximum number of simultaneously pressed keys.
 		 * Generate a warning if an item cannot be recorded.
 		 */
 		LOG_WRN("No place on the list to store HID item!");
 	} else {
-		/* After sort operation, free slots (zeros) are stored
-		 * at the beginning of the array.
-		 */
-		size_t const idx = ARRAY_SIZE(items->item) - prev_item_count - 1;
-
-		__ASSERT_NO_MSG(items->item[idx].usage_id == 0);
-
 		/* Record this value change. */
-		items->item[idx].usage_id = usage_id;
-		items->item[idx].value = value;
-		items->item_count += 1;
+		item_insert(items, usage_id, value);
 
 		update_needed = true;
 	}
 
-	if (prev_item_count != items->item_count) {
-		/* Sort elements on the list. Use simple algorithm
-		 * with small footprint.
-		 */
-		sort_by_usage_id(items->item, ARRAY_SIZE(items->item));
-	}
-
 	return update_needed;
 }
 
@@ -826,27 +830,99 @@ static bool update_report(struct report_data *rd)
 {
 	bool update_needed = false;
 
-	while (!update_needed && !eventq_is_empty(&rd->eventq)) {
-		/* There are enqueued events to handle. */
-		struct item_event *event = eventq_get(&rd->eventq);
-
-		__ASSERT_NO_MSG(event);
+	struct item_event event;
 
+	while (!update_needed && eventq_get(&rd->eventq, &event)) {
+		/* There are enqueued events to handle. */
 		update_needed = key_value_set(&rd->items,
-					      event->item.usage_id,
-					      event->item.value);
+					      event.item.usage_id,
+					      event.item.value);
 
 		rd->linked_rs->update_needed = rd->linked_rs->update_needed || update_needed;
 
-
-		k_free(event);
-
 		/* If no item was changed, try next event. */
 	}
 
 	return rd->linked_rs->update_needed;
 }
 
+static void latency_stats_reset(void)
+{
+	memset(&latency_stats, 0, sizeof(latency_stats));
+	latency_stats.min = UINT32_MAX;
+}
+
+static void latency_stats_add(uint32_t latency_us)
+{
+	size_t bin = 0;
+
+	while ((bin < ARRAY_SIZE(latency_stats.histogram) - 1) &&
+	       (latency_us >= (HID_LATENCY_HISTOGRAM_BASE_US << bin))) {
+		bin++;
+	}
+
+	latency_stats.histogram[bin]++;
+	latency_stats.count++;
+	latency_stats.sum += latency_us;
+	latency_stats.min = MIN(latency_stats.min, latency_us);
+	latency_stats.max = MAX(latency_stats.max, latency_us);
+}
+
+static void latency_report_fn(struct k_work *work)
+{
+	if (latency_stats.count > 0) {
+		struct hid_latency_event *event = new_hid_latency_event();
+
+		event->count = latency_stats.count;
+		event->min = latency_stats.min;
+		event->avg = latency_stats.sum / latency_stats.count;
+		event->max = latency_stats.max;
+		memcpy(event->histogram, latency_stats.histogram,
+		       sizeof(event->histogram));
+
+		EVENT_SUBMIT(event);
+
+		latency_stats_reset();
+	}
+
+	k_work_reschedule(&latency_report,
+			  K_MSEC(CONFIG_DESKTOP_HID_STATE_LATENCY_MEAS_PERIOD));
+}
+
+/**@brief Remember motion sampling time of the report put into the pipeline. */
+static void report_timestamp_push(struct report_state *rs, struct report_data *rd)
+{
+	__ASSERT_NO_MSG(rs->cnt < ARRAY_SIZE(rs->timestamp));
+
+	struct report_timestamp *ts = &rs->timestamp[rs->cnt];
+
+	ts->valid = false;
+
+	if (((rs->report_id == REPORT_ID_MOUSE) ||
+	     (rs->report_id == REPORT_ID_BOOT_MOUSE)) &&
+	    rd->axes.timestamp_valid) {
+		ts->valid = true;
+		ts->timestamp = rd->axes.timestamp;
+		rd->axes.timestamp_valid = false;
+	}
+}
+
+/**@brief Remove the oldest report from the pipeline and account its latency. */
+static void report_timestamp_pop(struct report_state *rs, bool sent)
+{
+	__ASSERT_NO_MSG(rs->cnt > 0);
+
+	if (sent && rs->timestamp[0].valid) {
+		uint32_t latency = k_cycle_get_32() - rs->timestamp[0].timestamp;
+
+		latency_stats_add(k_cyc_to_us_floor32(latency));
+	}
+
+	for (size_t i = 1; i < rs->cnt; i++) {
+		rs->timestamp[i - 1] = rs->timestamp[i];
+	}
+}
+
 static bool report_send(struct report_state *rs,
 			struct report_data *rd,
 			bool check_state,
@@ -872,13 +948,17 @@ static bool report_send(struct report_state *rs,
 		    (rs->report_id == REPORT_ID_SYSTEM_CTRL))  {
 			pipeline_depth = 1;
 		} else {
-			pipeline_depth = 2;
+			pipeline_depth = REPORT_PIPELINE_DEPTH_MAX;
 		}
 
 		while ((rs->cnt < pipeline_depth) &&
 		       (rs->subscriber->report_cnt < rs->subscriber->report_max) &&
 		       (update_report(rd) || rs->update_needed || send_always)) {
 
+			if (IS_ENABLED(CONFIG_DESKTOP_HID_STATE_LATENCY_MEAS)) {
+				report_timestamp_push(rs, rd);
+			}
+
 			switch (rs->report_id) {
 			case REPORT_ID_KEYBOARD_KEYS:
 				send_report_keyboard(rs, rd);
@@ -948,6 +1028,11 @@ static void report_issued(const void *subscriber_id, uint8_t report_id, bool err
 
 	if (rs->state != STATE_DISCONNECTED) {
 		__ASSERT_NO_MSG(rs->cnt > 0);
+
+		if (IS_ENABLED(CONFIG_DESKTOP_HID_STATE_LATENCY_MEAS)) {
+			report_timestamp_pop(rs, !error);
+		}
+
 		rs->cnt--;
 
 		if (rs->cnt == 0) {
@@ -1277,16 +1362,12 @@ static void enqueue(struct report_data *rd, uint16_t usage_id, int16_t value,
 			 * Try to remove queued items starting from the
 			 * oldest one.
 			 */
-			sys_snode_t *i;
-
-			SYS_SLIST_FOR_EACH_NODE(&rd->eventq.root, i) {
+			for (size_t i = 0; i < rd->eventq.len; i++) {
 				/* Initial cleanup was done above. Queue will
 				 * not contain events with expired timestamp.
 				 */
 				uint32_t timestamp =
-					CONTAINER_OF(i,
-						     struct item_event,
-						     node)->timestamp +
+					eventq_at(&rd->eventq, i)->timestamp +
 					CONFIG_DESKTOP_HID_REPORT_EXPIRATION;
 
 				eventq_cleanup(&rd->eventq, timestamp);
@@ -1294,7 +1375,7 @@ static void enqueue(struct report_data *rd, uint16_t usage_id, int16_t value,
 				if (!eventq_is_full(&rd->eventq)) {
 					/* At least one element was removed
 					 * from the queue. Do not continue
-					 * list traverse, content was modified!
+					 * queue traverse, content was modified!
 					 */
 					break;
 				}
@@ -1416,6 +1497,13 @@ static void init(void)
 
 	__ASSERT_NO_MSG(data_id == INPUT_REPORT_DATA_COUNT);
 	__ASSERT_NO_MSG(state_id == INPUT_REPORT_STATE_COUNT);
+
+	if (IS_ENABLED(CONFIG_DESKTOP_HID_STATE_LATENCY_MEAS)) {
+		latency_stats_reset();
+		k_work_init_delayable(&latency_report, latency_report_fn);
+		k_work_reschedule(&latency_report,
+				  K_MSEC(CONFIG_DESKTOP_HID_STATE_LATENCY_MEAS_PERIOD));
+	}
 }
 
 static bool handle_motion_event(const struct motion_event *event)
@@ -1430,6 +1518,12 @@ static bool handle_motion_event(const struct motion_event *event)
 	rd->axes.axis[MOUSE_REPORT_AXIS_X] += event->dx;
 	rd->axes.axis[MOUSE_REPORT_AXIS_Y] += event->dy;
 
+	if (IS_ENABLED(CONFIG_DESKTOP_HID_STATE_LATENCY_MEAS) &&
+	    !rd->axes.timestamp_valid) {
+		rd->axes.timestamp = event->timestamp;
+		rd->axes.timestamp_valid = true;
+	}
+
 	report_send(NULL, rd, true, true);
 
 	return false;
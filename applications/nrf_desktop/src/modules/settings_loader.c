@@ -5,6 +5,7 @@
  */
 
 #include <zephyr.h>
+#include <inttypes.h>
 #include <settings/settings.h>
 
 #include "event_manager.h"
@@ -21,20 +22,161 @@ static struct k_thread thread;
 static K_THREAD_STACK_DEFINE(thread_stack, THREAD_STACK_SIZE);
 
 
-static void load_settings_thread(void)
+#if CONFIG_DESKTOP_SETTINGS_LOADER_PRIORITY
+/* Subtrees needed for the first input. They are loaded before the module
+ * reports readiness, the remaining settings are loaded afterwards.
+ */
+static const char * const priority_subtrees[] = {
+	"bt",
+	"ble_bond",
+#if CONFIG_DESKTOP_MOTION_SENSOR_ENABLE
+	"motion",
+#endif
+#if CONFIG_DESKTOP_FN_KEYS_ENABLE
+	"fn_keys",
+#endif
+};
+
+struct subtree_stats {
+	uint32_t count;
+	uint32_t cycles;
+};
+
+/* Last entry holds the statistics of the remaining settings. */
+static struct subtree_stats stats[ARRAY_SIZE(priority_subtrees) + 1];
+
+static size_t subtree_find(const char *key)
 {
-	LOG_INF("Settings load thread started");
+	size_t i;
 
+	for (i = 0; i < ARRAY_SIZE(priority_subtrees); i++) {
+		if (settings_name_steq(key, priority_subtrees[i], NULL)) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+static int load_direct_cb(const char *key, size_t len,
+			  settings_read_cb read_cb, void *cb_arg,
+			  void *param)
+{
+	bool priority = *(const bool *)param;
+	size_t idx = subtree_find(key);
+	uint32_t start;
+	int err;
+
+	if ((idx < ARRAY_SIZE(priority_subtrees)) != priority) {
+		return 0;
+	}
+
+	start = k_cycle_get_32();
+	err = settings_call_set_handler(key, len, read_cb, cb_arg, NULL);
+	stats[idx].cycles += k_cycle_get_32() - start;
+	stats[idx].count++;
+
+	return err;
+}
+
+static void stats_print(size_t idx, const char *name)
+{
+	LOG_INF("%s: %" PRIu32 " entries, %" PRIu32 " us in handlers",
+		name, stats[idx].count,
+		(uint32_t)k_cyc_to_us_floor64(stats[idx].cycles));
+}
+
+static int load_priority(void)
+{
+	static const bool priority = true;
+	int err;
+
+	err = settings_load_subtree_direct(NULL, load_direct_cb,
+					   (void *)&priority);
+	if (err) {
+		return err;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(priority_subtrees); i++) {
+		err = settings_commit_subtree(priority_subtrees[i]);
+		if (err) {
+			return err;
+		}
+		stats_print(i, priority_subtrees[i]);
+	}
+
+	return 0;
+}
+
+static int load_remaining(void)
+{
+	static const bool priority;
+	int err;
+
+	err = settings_load_subtree_direct(NULL, load_direct_cb,
+					   (void *)&priority);
+	if (err) {
+		return err;
+	}
+
+	/* Commit handlers of the priority subtrees are called again. They
+	 * only finalize the loaded state, so this is harmless.
+	 */
+	err = settings_commit();
+	if (!err) {
+		stats_print(ARRAY_SIZE(priority_subtrees), "others");
+	}
+
+	return err;
+}
+
+static void settings_load_all(void)
+{
+	uint32_t start = k_uptime_get_32();
+	int err = load_priority();
+
+	if (err) {
+		LOG_ERR("Cannot load settings");
+		module_set_state(MODULE_STATE_ERROR);
+		return;
+	}
+
+	LOG_INF("Priority settings loaded in %" PRIu32 " ms",
+		k_uptime_get_32() - start);
+	module_set_state(MODULE_STATE_READY);
+
+	err = load_remaining();
+	if (err) {
+		LOG_ERR("Cannot load settings");
+		module_set_state(MODULE_STATE_ERROR);
+	} else {
+		LOG_INF("Settings loaded in %" PRIu32 " ms",
+			k_uptime_get_32() - start);
+	}
+}
+#else
+static void settings_load_all(void)
+{
+	uint32_t start = k_uptime_get_32();
 	int err = settings_load();
 
 	if (err) {
 		LOG_ERR("Cannot load settings");
 		module_set_state(MODULE_STATE_ERROR);
 	} else {
-		LOG_INF("Settings loaded");
+		LOG_INF("Settings loaded in %" PRIu32 " ms",
+			k_uptime_get_32() - start);
 		module_set_state(MODULE_STATE_READY);
 	}
 }
+#endif /* CONFIG_DESKTOP_SETTINGS_LOADER_PRIORITY */
+
+static void load_settings_thread(void)
+{
+	LOG_INF("Settings load thread started");
+
+	settings_load_all();
+}
 
 static void start_loading_thread(void)
 {
@@ -51,15 +193,7 @@ static void load_settings(void)
 	if (IS_ENABLED(CONFIG_DESKTOP_SETTINGS_LOADER_USE_THREAD)) {
 		start_loading_thread();
 	} else {
-		int err = settings_load();
-
-		if (err) {
-			LOG_ERR("Cannot load settings");
-			module_set_state(MODULE_STATE_ERROR);
-		} else {
-			LOG_INF("Settings loaded");
-			module_set_state(MODULE_STATE_READY);
-		}
+		settings_load_all();
 	}
 }
 
@@ -56,6 +56,10 @@ static struct button buttons[] = {
 static bool registered;
 static bool connected;
 
+static struct k_work_delayable update_work;
+static uint32_t suppressed_updates;
+static uint32_t suppressed_updates_logged;
+
 
 static void update_button(struct button *button)
 {
@@ -85,6 +89,29 @@ static void update_buttons(void)
 	}
 }
 
+static void update_work_handler(struct k_work *work)
+{
+	if (suppressed_updates != suppressed_updates_logged) {
+		suppressed_updates_logged = suppressed_updates;
+		LOG_INF("Suppressed updates: %" PRIu32, suppressed_updates);
+	}
+
+	update_buttons();
+}
+
+static void request_update(struct button *button)
+{
+	if (CONFIG_PELION_CLIENT_OMA_DIGITAL_INPUT_UPDATE_WINDOW > 0) {
+		/* Window starts with the first change, later changes
+		 * within the window only overwrite the values.
+		 */
+		k_work_schedule(&update_work,
+				K_MSEC(CONFIG_PELION_CLIENT_OMA_DIGITAL_INPUT_UPDATE_WINDOW));
+	} else {
+		update_button(button);
+	}
+}
+
 static void notification_status_callback(const M2MBase& object,
 					 const M2MBase::MessageDeliveryStatus status,
 					 const M2MBase::MessageType,
@@ -193,15 +220,21 @@ static bool handle_button_event(const struct button_event *event)
 {
 	for (size_t i = 0; i < ARRAY_SIZE(buttons); i++) {
 		if (buttons[i].key_id == event->key_id) {
+			if (buttons[i].state.updated) {
+				suppressed_updates++;
+			}
 			buttons[i].state.state = event->pressed;
 			buttons[i].state.updated = true;
 
 			if (event->pressed) {
+				if (buttons[i].counter.updated) {
+					suppressed_updates++;
+				}
 				buttons[i].counter.counter++;
 				buttons[i].counter.updated = true;
 			}
 
-			update_button(&buttons[i]);
+			request_update(&buttons[i]);
 		}
 	}
 
@@ -258,6 +291,8 @@ static bool event_handler(const struct event_header *eh)
 			__ASSERT_NO_MSG(!initialized);
 			initialized = true;
 
+			k_work_init_delayable(&update_work, update_work_handler);
+
 			module_set_state(MODULE_STATE_READY);
 		}
 
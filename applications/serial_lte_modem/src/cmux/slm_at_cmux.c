@@ -0,0 +1,758 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <logging/log.h>
+#include <zephyr.h>
+#include <stdio.h>
+#include <string.h>
+#include <net/socket.h>
+#include <sys/byteorder.h>
+#include <sys/crc.h>
+#include <sys/ring_buffer.h>
+#include "slm_util.h"
+#include "slm_at_host.h"
+#include "slm_poll.h"
+#include "slm_at_cmux.h"
+
+LOG_MODULE_REGISTER(slm_cmux, CONFIG_SLM_LOG_LEVEL);
+
+/* 3GPP TS 27.010 basic option */
+#define CMUX_FLAG		0xF9
+#define CMUX_EA			0x01
+#define CMUX_CR			0x02
+#define CMUX_PF			0x10
+#define CMUX_FCS_POLY		0xE0
+#define CMUX_FCS_INIT		0xFF
+
+/* Frame types, without the P/F bit */
+#define CMUX_FRAME_SABM		0x2F
+#define CMUX_FRAME_UA		0x63
+#define CMUX_FRAME_DM		0x0F
+#define CMUX_FRAME_DISC		0x43
+#define CMUX_FRAME_UIH		0xEF
+
+/* Control channel message types, without the C/R and EA bits */
+#define CMUX_MSG_PN		0x80
+#define CMUX_MSG_CLD		0xC0
+#define CMUX_MSG_TEST		0x20
+#define CMUX_MSG_FCON		0xA0
+#define CMUX_MSG_FCOFF		0x60
+#define CMUX_MSG_MSC		0xE0
+#define CMUX_MSG_NSC		0x10
+
+/* V.24 signals of the MSC message */
+#define CMUX_MSC_FC		0x02
+#define CMUX_MSC_SIGNALS	0x8D	/* EA, RTC, RTR and DV */
+#define CMUX_PN_LEN		8
+#define CMUX_CTRL_MAX		32
+
+#define CMUX_DLCI_CONTROL	0
+#define CMUX_DLCI_DATA		(SLM_CMUX_DLCI_AT + 1)
+#define CMUX_CHAN_NUM		(1 + CONFIG_SLM_CMUX_DATA_CHANNELS)
+
+#define CMUX_HDR_MAX		4	/* Address, control and two length octets */
+#define CMUX_LEN_1_MAX		127
+#define CMUX_FRAME_MAX		(CONFIG_SLM_CMUX_FRAME_SIZE + CMUX_HDR_MAX + 3)
+#define CMUX_RX_BUF_SIZE	2048
+
+/* Frames the host may send before it handles a flow control request */
+#define CMUX_HIGH_WATER		(2 * CONFIG_SLM_CMUX_FRAME_SIZE)
+#define CMUX_LOW_WATER		(CONFIG_SLM_CMUX_CHAN_BUF_SIZE / 2)
+
+#define CMUX_RETRY_MS		10
+
+#define THREAD_STACK_SIZE	KB(2)
+#define THREAD_PRIORITY		K_LOWEST_APPLICATION_THREAD_PRIO
+
+BUILD_ASSERT(CMUX_HIGH_WATER < CMUX_LOW_WATER, "Channel buffer too small for frame size");
+
+/* Channel flags */
+enum {
+	CHAN_OPEN,
+	CHAN_FC_LOCAL,  /* The host is asked to stop sending */
+	CHAN_FC_REMOTE, /* The host asked to stop sending */
+};
+
+struct cmux_chan {
+	uint8_t dlci;
+	atomic_t flags;
+	int fd;
+	/* Received from the host, not consumed yet */
+	struct ring_buf rb;
+	uint8_t rb_data[CONFIG_SLM_CMUX_CHAN_BUF_SIZE];
+	struct k_work_delayable work;
+};
+
+enum cmux_state {
+	CMUX_IDLE,
+	CMUX_STARTING,
+	CMUX_ACTIVE
+};
+
+enum cmux_rx_state {
+	RX_FLAG,
+	RX_ADDR,
+	RX_CTRL,
+	RX_LEN,
+	RX_LEN2,
+	RX_DATA,
+	RX_FCS,
+	RX_END
+};
+
+static struct cmux_frame {
+	enum cmux_rx_state state;
+	uint8_t hdr[CMUX_HDR_MAX];
+	uint8_t hdr_len;
+	uint16_t len;
+	uint16_t pos;
+	uint8_t data[CONFIG_SLM_CMUX_FRAME_SIZE];
+} frame;
+
+static enum cmux_state cmux_state;
+static bool fc_remote_all;
+static struct cmux_chan chans[CMUX_CHAN_NUM];
+
+static struct ring_buf rx_rb;
+static uint8_t rx_rb_data[CMUX_RX_BUF_SIZE];
+static struct k_work rx_work;
+
+static uint8_t tx_frame[CMUX_FRAME_MAX];
+static K_MUTEX_DEFINE(tx_lock);
+
+static struct k_work_q cmux_work_q;
+static K_THREAD_STACK_DEFINE(cmux_work_q_stack, THREAD_STACK_SIZE);
+static bool work_q_started;
+
+/* global variable defined in different files */
+extern struct at_param_list at_param_list;
+extern char rsp_buf[SLM_AT_CMD_RESPONSE_MAX_LEN];
+
+/* global functions defined in different files */
+int slm_uart_tx(const uint8_t *data, size_t len);
+int slm_at_host_cmd_rx(const uint8_t *data, size_t len);
+
+static uint8_t fcs_calc(const uint8_t *data, size_t len)
+{
+	return 0xFF - crc8(data, len, CMUX_FCS_POLY, CMUX_FCS_INIT, true);
+}
+
+static struct cmux_chan *chan_get(uint8_t dlci)
+{
+	if (dlci < SLM_CMUX_DLCI_AT || dlci >= SLM_CMUX_DLCI_AT + CMUX_CHAN_NUM) {
+		return NULL;
+	}
+
+	return &chans[dlci - SLM_CMUX_DLCI_AT];
+}
+
+/* As the responding station, commands are sent with C/R cleared */
+static int frame_send(uint8_t dlci, uint8_t type, bool command, const uint8_t *data,
+		      size_t len)
+{
+	size_t hdr_len = (len > CMUX_LEN_1_MAX) ? 4 : 3;
+	size_t fcs_len = hdr_len;
+	uint8_t *hdr = &tx_frame[1];
+	int err;
+
+	if (len > CONFIG_SLM_CMUX_FRAME_SIZE) {
+		return -EMSGSIZE;
+	}
+
+	k_mutex_lock(&tx_lock, K_FOREVER);
+
+	tx_frame[0] = CMUX_FLAG;
+	hdr[0] = (dlci << 2) | (command ? 0 : CMUX_CR) | CMUX_EA;
+	hdr[1] = type;
+	if (hdr_len == 4) {
+		hdr[2] = (len & 0x7F) << 1;
+		hdr[3] = len >> 7;
+	} else {
+		hdr[2] = (len << 1) | CMUX_EA;
+	}
+	memcpy(&hdr[hdr_len], data, len);
+	/* The FCS of UIH frames does not cover the information field */
+	if ((type & ~CMUX_PF) != CMUX_FRAME_UIH) {
+		fcs_len += len;
+	}
+	hdr[hdr_len + len] = fcs_calc(hdr, fcs_len);
+	hdr[hdr_len + len + 1] = CMUX_FLAG;
+
+	err = slm_uart_tx(tx_frame, hdr_len + len + 3);
+
+	k_mutex_unlock(&tx_lock);
+
+	return err;
+}
+
+static int data_send(uint8_t dlci, const uint8_t *data, size_t len)
+{
+	int err;
+
+	while (len > 0) {
+		size_t size = MIN(len, CONFIG_SLM_CMUX_FRAME_SIZE);
+
+		err = frame_send(dlci, CMUX_FRAME_UIH, true, data, size);
+		if (err) {
+			return err;
+		}
+		data += size;
+		len -= size;
+	}
+
+	return 0;
+}
+
+static int ctrl_msg_send(uint8_t type, const uint8_t *val, size_t len)
+{
+	uint8_t msg[2 + CMUX_CTRL_MAX];
+
+	if (len > sizeof(msg) - 2) {
+		return -EMSGSIZE;
+	}
+
+	msg[0] = type | CMUX_EA;
+	msg[1] = (len << 1) | CMUX_EA;
+	memcpy(&msg[2], val, len);
+
+	return frame_send(CMUX_DLCI_CONTROL, CMUX_FRAME_UIH, true, msg, len + 2);
+}
+
+static int msc_send(uint8_t dlci, bool fc)
+{
+	uint8_t val[] = {
+		(dlci << 2) | CMUX_CR | CMUX_EA,
+		CMUX_MSC_SIGNALS | (fc ? CMUX_MSC_FC : 0)
+	};
+
+	LOG_DBG("DLCI %d flow control %s", dlci, fc ? "on" : "off");
+
+	return ctrl_msg_send(CMUX_MSG_MSC | CMUX_CR, val, sizeof(val));
+}
+
+/* Bound sockets are polled only while their channel can take data */
+static void chan_poll_update(struct cmux_chan *chan)
+{
+	short events = 0;
+
+	if (chan->fd == INVALID_SOCKET) {
+		return;
+	}
+	if (cmux_state == CMUX_ACTIVE && !fc_remote_all &&
+	    atomic_test_bit(&chan->flags, CHAN_OPEN) &&
+	    !atomic_test_bit(&chan->flags, CHAN_FC_REMOTE)) {
+		events = POLLIN;
+	}
+
+	(void)slm_poll_update(chan->fd, events);
+}
+
+static void chans_poll_update(void)
+{
+	for (int i = 0; i < CONFIG_SLM_CMUX_DATA_CHANNELS; i++) {
+		chan_poll_update(chan_get(CMUX_DLCI_DATA + i));
+	}
+}
+
+static void chan_reset(struct cmux_chan *chan)
+{
+	atomic_clear(&chan->flags);
+	ring_buf_reset(&chan->rb);
+}
+
+static void chan_unbind(struct cmux_chan *chan)
+{
+	char urc[32];
+
+	if (chan->fd == INVALID_SOCKET) {
+		return;
+	}
+
+	(void)slm_poll_remove(chan->fd);
+	chan->fd = INVALID_SOCKET;
+	LOG_INF("DLCI %d unbound", chan->dlci);
+	sprintf(urc, "\r\n#XCMUXBIND: %d,\"closed\"\r\n", chan->dlci);
+	rsp_send(urc, strlen(urc));
+}
+
+static void cmux_stop(void)
+{
+	cmux_state = CMUX_IDLE;
+	fc_remote_all = false;
+	for (int i = 0; i < CMUX_CHAN_NUM; i++) {
+		(void)k_work_cancel_delayable(&chans[i].work);
+		chan_reset(&chans[i]);
+		if (chans[i].fd != INVALID_SOCKET) {
+			(void)slm_poll_remove(chans[i].fd);
+			chans[i].fd = INVALID_SOCKET;
+		}
+	}
+	LOG_INF("CMUX stopped");
+}
+
+/* Consume data received from the host on a channel */
+static void chan_work_fn(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct cmux_chan *chan = CONTAINER_OF(dwork, struct cmux_chan, work);
+	uint8_t *data;
+	uint32_t len;
+	int ret;
+
+	while ((len = ring_buf_get_claim(&chan->rb, &data, CONFIG_SLM_CMUX_CHAN_BUF_SIZE)) > 0) {
+		if (chan->dlci == SLM_CMUX_DLCI_AT) {
+			ret = slm_at_host_cmd_rx(data, len);
+		} else if (chan->fd != INVALID_SOCKET) {
+			ret = send(chan->fd, data, len, MSG_DONTWAIT);
+			if (ret < 0 && errno == EAGAIN) {
+				ret = 0;
+			} else if (ret < 0) {
+				LOG_ERR("send() failed on DLCI %d: %d", chan->dlci, -errno);
+				ret = len;
+			}
+		} else {
+			LOG_WRN("DLCI %d not bound, %d dropped", chan->dlci, len);
+			ret = len;
+		}
+		(void)ring_buf_get_finish(&chan->rb, ret);
+
+		if (chan->dlci == SLM_CMUX_DLCI_AT && ret < len) {
+			/* Resumed when the AT command is completed */
+			break;
+		} else if (ret == 0) {
+			(void)k_work_reschedule_for_queue(&cmux_work_q, dwork,
+							  K_MSEC(CMUX_RETRY_MS));
+			break;
+		}
+	}
+
+	if (ring_buf_space_get(&chan->rb) >= CMUX_LOW_WATER &&
+	    atomic_test_and_clear_bit(&chan->flags, CHAN_FC_LOCAL)) {
+		(void)msc_send(chan->dlci, false);
+	}
+}
+
+static void chan_rx(struct cmux_chan *chan, const uint8_t *data, size_t len)
+{
+	uint32_t ret = ring_buf_put(&chan->rb, data, len);
+
+	if (ret != len) {
+		LOG_WRN("DLCI %d buffer full, %d dropped", chan->dlci, len - ret);
+	}
+	if (ring_buf_space_get(&chan->rb) < CMUX_HIGH_WATER &&
+	    !atomic_test_and_set_bit(&chan->flags, CHAN_FC_LOCAL)) {
+		(void)msc_send(chan->dlci, true);
+	}
+
+	(void)k_work_reschedule_for_queue(&cmux_work_q, &chan->work, K_NO_WAIT);
+}
+
+static void ctrl_msg_handle(const uint8_t *data, size_t len)
+{
+	uint8_t type;
+	uint8_t val[CMUX_CTRL_MAX];
+	size_t val_len;
+	struct cmux_chan *chan;
+
+	if (len < 2 || !(data[1] & CMUX_EA) || (data[1] >> 1) + 2 > len) {
+		LOG_WRN("Invalid control message");
+		return;
+	}
+
+	type = data[0] & ~(CMUX_CR | CMUX_EA);
+	val_len = MIN(data[1] >> 1, sizeof(val));
+	memcpy(val, &data[2], val_len);
+
+	if (!(data[0] & CMUX_CR)) {
+		/* Response to a message of ours */
+		return;
+	}
+
+	switch (type) {
+	case CMUX_MSG_MSC:
+		if (val_len < 2) {
+			return;
+		}
+		chan = chan_get(val[0] >> 2);
+		if (chan == NULL) {
+			break;
+		}
+		if (val[1] & CMUX_MSC_FC) {
+			atomic_set_bit(&chan->flags, CHAN_FC_REMOTE);
+		} else {
+			atomic_clear_bit(&chan->flags, CHAN_FC_REMOTE);
+		}
+		chan_poll_update(chan);
+		break;
+	case CMUX_MSG_FCON:
+		fc_remote_all = false;
+		chans_poll_update();
+		break;
+	case CMUX_MSG_FCOFF:
+		fc_remote_all = true;
+		chans_poll_update();
+		break;
+	case CMUX_MSG_PN:
+		if (val_len < CMUX_PN_LEN) {
+			return;
+		}
+		/* Accept the parameters, with frames no larger than ours */
+		if (sys_get_le16(&val[4]) > CONFIG_SLM_CMUX_FRAME_SIZE) {
+			sys_put_le16(CONFIG_SLM_CMUX_FRAME_SIZE, &val[4]);
+		}
+		break;
+	case CMUX_MSG_TEST:
+		break;
+	case CMUX_MSG_CLD:
+		(void)ctrl_msg_send(type, NULL, 0);
+		cmux_stop();
+		return;
+	default:
+		LOG_WRN("Unsupported control message 0x%02x", data[0]);
+		val[0] = data[0];
+		(void)ctrl_msg_send(CMUX_MSG_NSC, val, 1);
+		return;
+	}
+
+	(void)ctrl_msg_send(type, val, val_len);
+}
+
+static void frame_handle(void)
+{
+	uint8_t dlci = frame.hdr[0] >> 2;
+	uint8_t type = frame.hdr[1] & ~CMUX_PF;
+	struct cmux_chan *chan = chan_get(dlci);
+
+	switch (type) {
+	case CMUX_FRAME_SABM:
+		if (dlci != CMUX_DLCI_CONTROL && chan == NULL) {
+			(void)frame_send(dlci, CMUX_FRAME_DM | CMUX_PF, false, NULL, 0);
+			break;
+		}
+		if (chan) {
+			chan_reset(chan);
+			atomic_set_bit(&chan->flags, CHAN_OPEN);
+			chan_poll_update(chan);
+		}
+		LOG_INF("DLCI %d open", dlci);
+		(void)frame_send(dlci, CMUX_FRAME_UA | CMUX_PF, false, NULL, 0);
+		break;
+	case CMUX_FRAME_DISC:
+		(void)frame_send(dlci, CMUX_FRAME_UA | CMUX_PF, false, NULL, 0);
+		if (dlci == CMUX_DLCI_CONTROL) {
+			cmux_stop();
+		} else if (chan) {
+			atomic_clear_bit(&chan->flags, CHAN_OPEN);
+			chan_poll_update(chan);
+			LOG_INF("DLCI %d closed", dlci);
+		}
+		break;
+	case CMUX_FRAME_UIH:
+		if (dlci == CMUX_DLCI_CONTROL) {
+			ctrl_msg_handle(frame.data, frame.len);
+		} else if (chan && atomic_test_bit(&chan->flags, CHAN_OPEN)) {
+			chan_rx(chan, frame.data, frame.len);
+		} else {
+			LOG_WRN("DLCI %d not open, %d dropped", dlci, frame.len);
+		}
+		break;
+	default:
+		LOG_DBG("Frame 0x%02x on DLCI %d ignored", frame.hdr[1], dlci);
+		break;
+	}
+}
+
+static void frame_parse(uint8_t c)
+{
+	switch (frame.state) {
+	case RX_FLAG:
+		if (c == CMUX_FLAG) {
+			frame.state = RX_ADDR;
+		}
+		break;
+	case RX_ADDR:
+		/* Consecutive flags are allowed */
+		if (c == CMUX_FLAG) {
+			break;
+		}
+		if (!(c & CMUX_EA)) {
+			frame.state = RX_FLAG;
+			break;
+		}
+		frame.hdr[0] = c;
+		frame.state = RX_CTRL;
+		break;
+	case RX_CTRL:
+		frame.hdr[1] = c;
+		frame.state = RX_LEN;
+		break;
+	case RX_LEN:
+	case RX_LEN2:
+		if (frame.state == RX_LEN) {
+			frame.hdr[2] = c;
+			frame.hdr_len = 3;
+			frame.len = c >> 1;
+			if (!(c & CMUX_EA)) {
+				frame.state = RX_LEN2;
+				break;
+			}
+		} else {
+			frame.hdr[3] = c;
+			frame.hdr_len = 4;
+			frame.len |= c << 7;
+		}
+		if (frame.len > CONFIG_SLM_CMUX_FRAME_SIZE) {
+			LOG_WRN("Frame too long: %d", frame.len);
+			frame.state = RX_FLAG;
+			break;
+		}
+		frame.pos = 0;
+		frame.state = (frame.len > 0) ? RX_DATA : RX_FCS;
+		break;
+	case RX_DATA:
+		frame.data[frame.pos++] = c;
+		if (frame.pos == frame.len) {
+			frame.state = RX_FCS;
+		}
+		break;
+	case RX_FCS: {
+		uint8_t buf[CMUX_HDR_MAX + CONFIG_SLM_CMUX_FRAME_SIZE];
+		size_t len = frame.hdr_len;
+
+		memcpy(buf, frame.hdr, frame.hdr_len);
+		if ((frame.hdr[1] & ~CMUX_PF) != CMUX_FRAME_UIH) {
+			memcpy(&buf[len], frame.data, frame.len);
+			len += frame.len;
+		}
+		if (fcs_calc(buf, len) != c) {
+			LOG_WRN("FCS error");
+			frame.state = RX_FLAG;
+			break;
+		}
+		frame.state = RX_END;
+		break;
+	}
+	case RX_END:
+		if (c != CMUX_FLAG) {
+			LOG_WRN("Missing closing flag");
+			frame.state = RX_FLAG;
+			break;
+		}
+		frame_handle();
+		/* The closing flag can open the next frame */
+		frame.state = RX_ADDR;
+		break;
+	}
+}
+
+static void rx_work_fn(struct k_work *work)
+{
+	uint8_t *data;
+	uint32_t len;
+
+	ARG_UNUSED(work);
+
+	while ((len = ring_buf_get_claim(&rx_rb, &data, CMUX_RX_BUF_SIZE)) > 0) {
+		for (uint32_t i = 0; i < len && cmux_state != CMUX_IDLE; i++) {
+			frame_parse(data[i]);
+		}
+		(void)ring_buf_get_finish(&rx_rb, len);
+	}
+}
+
+/* Forward data received on bound sockets to their channel */
+static void chan_poll_handler(int fd, short revents, void *ctx)
+{
+	static uint8_t buf[CONFIG_SLM_CMUX_FRAME_SIZE];
+	struct cmux_chan *chan = ctx;
+	int ret;
+
+	if (chan->fd != fd) {
+		return;
+	}
+
+	if (revents & POLLIN) {
+		ret = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+		if (ret > 0) {
+			(void)data_send(chan->dlci, buf, ret);
+			return;
+		} else if (ret < 0 && errno == EAGAIN) {
+			return;
+		}
+		chan_unbind(chan);
+	} else if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
+		chan_unbind(chan);
+	}
+}
+
+bool slm_cmux_active(void)
+{
+	return (cmux_state != CMUX_IDLE);
+}
+
+void slm_cmux_rx(const uint8_t *data, size_t len)
+{
+	uint32_t ret = ring_buf_put(&rx_rb, data, len);
+
+	if (ret != len) {
+		LOG_WRN("CMUX RX buffer full, %d dropped", len - ret);
+	}
+
+	k_work_submit_to_queue(&cmux_work_q, &rx_work);
+}
+
+int slm_cmux_at_send(const uint8_t *data, size_t len)
+{
+	if (cmux_state != CMUX_ACTIVE) {
+		return -ENOTCONN;
+	}
+
+	return data_send(SLM_CMUX_DLCI_AT, data, len);
+}
+
+void slm_cmux_at_resume(void)
+{
+	if (cmux_state == CMUX_STARTING) {
+		cmux_state = CMUX_ACTIVE;
+		chans_poll_update();
+		LOG_INF("CMUX started");
+	}
+
+	(void)k_work_reschedule_for_queue(&cmux_work_q, &chan_get(SLM_CMUX_DLCI_AT)->work,
+					  K_NO_WAIT);
+}
+
+/**@brief handle AT#XCMUX commands
+ *  AT#XCMUX
+ *  AT#XCMUX?
+ *  AT#XCMUX=? not supported
+ */
+int handle_at_cmux(enum at_cmd_type type)
+{
+	int ret = -EINVAL;
+
+	if (type == AT_CMD_TYPE_SET_COMMAND) {
+		if (cmux_state != CMUX_IDLE || in_datamode()) {
+			LOG_ERR("CMUX not allowed");
+			return -EINVAL;
+		}
+		ring_buf_reset(&rx_rb);
+		frame.state = RX_FLAG;
+		/* The response is sent before frames are */
+		cmux_state = CMUX_STARTING;
+		ret = 0;
+	}
+
+	if (type == AT_CMD_TYPE_READ_COMMAND) {
+		sprintf(rsp_buf, "\r\n#XCMUX: %d\r\n", slm_cmux_active() ? 1 : 0);
+		rsp_send(rsp_buf, strlen(rsp_buf));
+		ret = 0;
+	}
+
+	return ret;
+}
+
+/**@brief handle AT#XCMUXBIND commands
+ *  AT#XCMUXBIND=<dlci>[,<handle>]
+ *  AT#XCMUXBIND?
+ *  AT#XCMUXBIND=?
+ */
+int handle_at_cmux_bind(enum at_cmd_type type)
+{
+	int ret = -EINVAL;
+	uint16_t dlci;
+	int handle = INVALID_SOCKET;
+	struct cmux_chan *chan;
+
+	if (type == AT_CMD_TYPE_SET_COMMAND) {
+		if (cmux_state != CMUX_ACTIVE) {
+			LOG_ERR("CMUX not started");
+			return -EINVAL;
+		}
+		ret = at_params_unsigned_short_get(&at_param_list, 1, &dlci);
+		if (ret) {
+			return ret;
+		}
+		chan = chan_get(dlci);
+		if (chan == NULL || dlci == SLM_CMUX_DLCI_AT) {
+			LOG_ERR("Invalid data channel: %d", dlci);
+			return -EINVAL;
+		}
+		if (at_params_valid_count_get(&at_param_list) > 2) {
+			ret = at_params_int_get(&at_param_list, 2, &handle);
+			if (ret) {
+				return ret;
+			}
+			if (handle < 0) {
+				return -EINVAL;
+			}
+		}
+		if (chan->fd != INVALID_SOCKET) {
+			(void)slm_poll_remove(chan->fd);
+			chan->fd = INVALID_SOCKET;
+		}
+		if (handle != INVALID_SOCKET) {
+			ret = slm_poll_add(handle, 0, chan_poll_handler, chan);
+			if (ret) {
+				return ret;
+			}
+			chan->fd = handle;
+			chan_poll_update(chan);
+		}
+		LOG_INF("DLCI %d bound to %d", dlci, handle);
+		ret = 0;
+	}
+
+	if (type == AT_CMD_TYPE_READ_COMMAND) {
+		for (int i = 0; i < CONFIG_SLM_CMUX_DATA_CHANNELS; i++) {
+			chan = chan_get(CMUX_DLCI_DATA + i);
+			sprintf(rsp_buf, "\r\n#XCMUXBIND: %d,%d\r\n", chan->dlci, chan->fd);
+			rsp_send(rsp_buf, strlen(rsp_buf));
+		}
+		ret = 0;
+	}
+
+	if (type == AT_CMD_TYPE_TEST_COMMAND) {
+		sprintf(rsp_buf, "\r\n#XCMUXBIND: (%d-%d),<handle>\r\n", CMUX_DLCI_DATA,
+			CMUX_DLCI_DATA + CONFIG_SLM_CMUX_DATA_CHANNELS - 1);
+		rsp_send(rsp_buf, strlen(rsp_buf));
+		ret = 0;
+	}
+
+	return ret;
+}
+
+int slm_at_cmux_init(void)
+{
+	for (int i = 0; i < CMUX_CHAN_NUM; i++) {
+		chans[i].dlci = SLM_CMUX_DLCI_AT + i;
+		chans[i].fd = INVALID_SOCKET;
+		ring_buf_init(&chans[i].rb, sizeof(chans[i].rb_data), chans[i].rb_data);
+		k_work_init_delayable(&chans[i].work, chan_work_fn);
+	}
+	ring_buf_init(&rx_rb, sizeof(rx_rb_data), rx_rb_data);
+	k_work_init(&rx_work, rx_work_fn);
+	cmux_state = CMUX_IDLE;
+
+	/* Not stopped on uninit, it is idle without CMUX */
+	if (!work_q_started) {
+		k_work_queue_start(&cmux_work_q, cmux_work_q_stack,
+				   K_THREAD_STACK_SIZEOF(cmux_work_q_stack), THREAD_PRIORITY,
+				   NULL);
+		work_q_started = true;
+	}
+
+	return 0;
+}
+
+int slm_at_cmux_uninit(void)
+{
+	if (cmux_state != CMUX_IDLE) {
+		cmux_stop();
+	}
+
+	return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SLM_AT_CMUX_
+#define SLM_AT_CMUX_
+
+/**@file slm_at_cmux.h
+ *
+ * @brief Vendor-specific AT commands for the 3GPP TS 27.010 multiplexer.
+ * @{
+ */
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+
+/** Channel of AT commands, responses and notifications. */
+#define SLM_CMUX_DLCI_AT	1
+
+/**
+ * @brief Check whether the UART is multiplexed.
+ *
+ * Multiplexing starts on reception right after AT#XCMUX is received, and on
+ * transmission once its response is sent.
+ *
+ * @retval true if yes, false if no.
+ */
+bool slm_cmux_active(void);
+
+/**
+ * @brief Pass data received from the UART to the multiplexer.
+ *
+ * Can be called from the UART callback.
+ *
+ * @param data Received data.
+ * @param len Length of received data.
+ */
+void slm_cmux_rx(const uint8_t *data, size_t len);
+
+/**
+ * @brief Send AT responses and notifications on the AT channel.
+ *
+ * @param data Data to send.
+ * @param len Length of data.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENOTCONN If the response to AT#XCMUX is not sent yet.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int slm_cmux_at_send(const uint8_t *data, size_t len);
+
+/**
+ * @brief Resume handling of the AT channel once an AT command is completed.
+ */
+void slm_cmux_at_resume(void);
+
+/**
+ * @brief Initialize CMUX AT command parser.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int slm_at_cmux_init(void);
+
+/**
+ * @brief Uninitialize CMUX AT command parser.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int slm_at_cmux_uninit(void);
+
+/** @} */
+
+#endif /* SLM_AT_CMUX_ */
@@ -7,6 +7,7 @@
 #include <logging/log.h>
 #include <zephyr.h>
 #include <stdio.h>
+#include <strings.h>
 #include <net/socket.h>
 #include <net/tls_credentials.h>
 #include <net/http_client.h>
@@ -27,6 +28,7 @@ LOG_MODULE_REGISTER(slm_httpc, CONFIG_SLM_LOG_LEVEL);
 # error "Please specify larger HTTPC_BUF_LEN"
 #endif
 #define HTTPC_REQ_TO_S		10
+#define HTTPC_CHUNK_HDR_LEN	12	/* Chunk size in hexadecimal and <CR><LF> */
 
 /* Buffers for HTTP client. */
 static uint8_t data_buf[HTTPC_BUF_LEN];
@@ -57,6 +59,7 @@ static struct slm_httpc_ctx {
 	char *headers;			/* headers */
 	size_t pl_len;			/* payload length */
 	size_t total_sent;		/* payload has been sent to server */
+	bool chunked;			/* payload sent with chunked transfer coding */
 	enum httpc_state state;		/* HTTPC state */
 } httpc;
 
@@ -71,10 +74,38 @@ static K_THREAD_STACK_DEFINE(httpc_thread_stack, HTTPC_THREAD_STACK_SIZE);
 
 static K_SEM_DEFINE(http_req_sem, 0, 1);
 
+/* Length of the response headers up to and including the empty line, or 0 */
+static size_t headers_end_find(const uint8_t *data, size_t len)
+{
+	for (size_t i = 3; i < len; i++) {
+		if (data[i - 3] == '\r' && data[i - 2] == '\n' &&
+		    data[i - 1] == '\r' && data[i] == '\n') {
+			return i + 1;
+		}
+	}
+
+	return 0;
+}
+
+/* Pass a part of the response to the host straight from the receive buffer */
+static void response_fragment_send(const uint8_t *data, size_t len,
+				   enum http_final_call final_data)
+{
+	if (len == 0) {
+		return;
+	}
+
+	sprintf(rsp_buf, "\r\n#XHTTPCRSP:%zu,%hu\r\n", len, final_data);
+	rsp_send(rsp_buf, strlen(rsp_buf));
+	rsp_send(data, len);
+}
+
 static void response_cb(struct http_response *rsp,
 			enum http_final_call final_data,
 			void *user_data)
 {
+	size_t header_len = 0;
+
 	if (rsp->data_len > HTTPC_BUF_LEN) {
 		/* Increase HTTPC_BUF_LEN in case of overflow */
 		LOG_WRN("HTTP parser buffer overflow!");
@@ -90,43 +121,43 @@ static void response_cb(struct http_response *rsp,
 		LOG_DBG("Response data received (%zd bytes)", rsp->data_len);
 	}
 
-	/* Process response header if required */
+	/* Process response header if required. It may not fit in one
+	 * receive buffer, in which case it is passed on as it comes.
+	 */
 	if (httpc.state == HTTPC_REQ_DONE) {
-		/* Look for end of response header */
-		const uint8_t *header_end = "\r\n\r\n";
-		uint8_t *pch = NULL;
-
-		pch = strstr(data_buf, header_end);
-		if (!pch) {
-			LOG_WRN("Invalid HTTP header");
-			return;
-		}
-		httpc.state = HTTPC_RES_HEADER_DONE;
-		sprintf(rsp_buf, "\r\n#XHTTPCRSP:%d,%hu\r\n", pch - data_buf + 4, final_data);
-		rsp_send(rsp_buf, strlen(rsp_buf));
-		rsp_send(data_buf, pch - data_buf + 4);
-		/* Process response body if required */
 		if (rsp->body_start) {
-			sprintf(rsp_buf, "\r\n#XHTTPCRSP:%d,%hu\r\n",
-				rsp->data_len - (rsp->body_start - data_buf), final_data);
-			rsp_send(rsp_buf, strlen(rsp_buf));
-			rsp_send(rsp->body_start,
-				 rsp->data_len - (rsp->body_start - data_buf));
+			header_len = rsp->body_start - data_buf;
+		} else {
+			header_len = headers_end_find(data_buf, rsp->data_len);
 		}
-	} else {
-		/* Process response body */
-		if (rsp->body_start) {
-			/* Response body starts from the middle of receive buffer */
-			sprintf(rsp_buf, "\r\n#XHTTPCRSP:%d,%hu\r\n", rsp->data_len, final_data);
-			rsp_send(rsp_buf, strlen(rsp_buf));
-			rsp_send(rsp->body_start, rsp->data_len);
+		if (header_len > 0) {
+			httpc.state = HTTPC_RES_HEADER_DONE;
 		} else {
-			/* Response body starts from the beginning of receive buffer */
-			sprintf(rsp_buf, "\r\n#XHTTPCRSP:%d,%hu\r\n", rsp->data_len, final_data);
-			rsp_send(rsp_buf, strlen(rsp_buf));
-			rsp_send(data_buf, rsp->data_len);
+			header_len = rsp->data_len;
+		}
+		response_fragment_send(data_buf, header_len, final_data);
+	}
+
+	/* Process response body */
+	response_fragment_send(data_buf + header_len, rsp->data_len - header_len, final_data);
+}
+
+static int data_send_all(const void *data, size_t len)
+{
+	size_t offset = 0;
+
+	while (offset < len) {
+		ssize_t ret;
+
+		ret = send(httpc.fd, (const uint8_t *)data + offset,
+			   MIN(len - offset, HTTPC_FRAG_SIZE), 0);
+		if (ret < 0) {
+			return -errno;
 		}
+		offset += ret;
 	}
+
+	return 0;
 }
 
 static int headers_cb(int sock, struct http_request *req, void *user_data)
@@ -135,15 +166,12 @@ static int headers_cb(int sock, struct http_request *req, void *user_data)
 	int ret = 0;
 
 	len = strlen(httpc.headers);
-	while (len > 0) {
-		ret = send(sock, httpc.headers + ret, len, 0);
-		if (ret < 0) {
-			LOG_ERR("send header fail: %d", ret);
-			return ret;
-		}
-		LOG_DBG("send header: %d bytes", ret);
-		len -= ret;
+	ret = data_send_all(httpc.headers, len);
+	if (ret < 0) {
+		LOG_ERR("send header fail: %d", ret);
+		return ret;
 	}
+	LOG_DBG("send header: %d bytes", len);
 
 	return len;
 }
@@ -192,15 +220,47 @@ int do_send_payload(const uint8_t *data, int len)
 	return 0;
 }
 
-int httpc_datamode_callback(uint8_t op, const uint8_t *data, int len)
+/* Send data received in data mode as one chunk */
+static int do_send_chunk(const uint8_t *data, int len)
 {
-	int ret = 0;
+	char chunk_hdr[HTTPC_CHUNK_HDR_LEN];
+	int ret;
 
 	if (data == NULL || len <= 0) {
-		LOG_ERR("Wrong raw data");
 		return -EINVAL;
 	}
-	if (op == DATAMODE_SEND) {
+
+	sprintf(chunk_hdr, "%x\r\n", len);
+	ret = data_send_all(chunk_hdr, strlen(chunk_hdr));
+	if (ret == 0) {
+		ret = data_send_all(data, len);
+	}
+	if (ret == 0) {
+		ret = data_send_all("\r\n", 2);
+	}
+	if (ret < 0) {
+		LOG_ERR("Fail to send chunk: %d", ret);
+		httpc.total_sent = ret;
+		k_sem_give(&http_req_sem);
+		return ret;
+	}
+	LOG_DBG("send %d bytes chunk", len);
+	httpc.total_sent += len;
+
+	return 0;
+}
+
+int httpc_datamode_callback(uint8_t op, const uint8_t *data, int len)
+{
+	int ret = 0;
+
+	if (op == DATAMODE_SEND && httpc.chunked) {
+		return do_send_chunk(data, len);
+	} else if (op == DATAMODE_SEND) {
+		if (data == NULL || len <= 0) {
+			LOG_ERR("Wrong raw data");
+			return -EINVAL;
+		}
 		ret = do_send_payload(data, len);
 		LOG_INF("datamode send: %d", ret);
 		if (ret == 0) {
@@ -221,14 +281,23 @@ int httpc_datamode_callback(uint8_t op, const uint8_t *data, int len)
 
 static int payload_cb(int sock, struct http_request *req, void *user_data)
 {
-	if (httpc.pl_len > 0) {
+	if (httpc.pl_len > 0 || httpc.chunked) {
 		enter_datamode(httpc_datamode_callback);
 		sprintf(rsp_buf, "\r\n#XHTTPCREQ: 1\r\n");
 		rsp_send(rsp_buf, strlen(rsp_buf));
-		/* Wait until all payload is sent */
+		/* Wait until all payload is sent, or data mode is exited */
 		LOG_DBG("wait until payload is ready");
 		k_sem_take(&http_req_sem, K_FOREVER);
 	}
+	if (httpc.chunked && (int)httpc.total_sent >= 0) {
+		/* Last chunk, without trailer */
+		int err = data_send_all("0\r\n\r\n", 5);
+
+		if (err) {
+			LOG_ERR("Fail to send last chunk: %d", err);
+			httpc.total_sent = err;
+		}
+	}
 	httpc.state = HTTPC_REQ_DONE;
 	sprintf(rsp_buf, "\r\n#XHTTPCREQ: 0\r\n");
 	rsp_send(rsp_buf, strlen(rsp_buf));
@@ -566,6 +635,27 @@ static int http_headers_preprocess(size_t size)
 	return 0;
 }
 
+/* Payload is streamed in chunks if the host asks for the chunked transfer coding */
+static bool http_headers_chunked(void)
+{
+	const char name[] = "Transfer-Encoding:";
+	const char coding[] = "chunked";
+	char *line = httpc.headers;
+	char *end;
+
+	while ((end = strstr(line, "\r\n")) != NULL) {
+		/* chunked is the last transfer coding applied */
+		if (strncasecmp(line, name, sizeof(name) - 1) == 0 &&
+		    end - line >= sizeof(name) - 1 + sizeof(coding) - 1 &&
+		    strncasecmp(end - (sizeof(coding) - 1), coding, sizeof(coding) - 1) == 0) {
+			return true;
+		}
+		line = end + 2;
+	}
+
+	return false;
+}
+
 /**@brief handle AT#XHTTPCREQ commands
  *  AT#XHTTPCREQ=<method>,<resource>,<headers>[,<payload_length>]
  *  AT#XHTTPCREQ? READ command not supported
@@ -590,7 +680,9 @@ int handle_at_httpc_request(enum at_cmd_type cmd_type)
 		param_count = at_params_valid_count_get(&at_param_list);
 		httpc.pl_len = 0;
 		httpc.total_sent = 0;
+		httpc.chunked = false;
 		httpc.state = HTTPC_INIT;
+		k_sem_reset(&http_req_sem);
 		memset(data_buf, 0, sizeof(data_buf));
 		err = util_string_get(&at_param_list, 1, data_buf, &method_sz);
 		if (err < 0) {
@@ -618,6 +710,7 @@ int handle_at_httpc_request(enum at_cmd_type cmd_type)
 		if (err) {
 			return err;
 		}
+		httpc.chunked = http_headers_chunked();
 		if (param_count >= 5) {
 			err = at_params_unsigned_int_get(&at_param_list, 4, &httpc.pl_len);
 			if (err != 0) {
@@ -10,6 +10,7 @@
 #include <net/mqtt.h>
 #include <net/socket.h>
 #include <random/rand32.h>
+#include <sys/ring_buffer.h>
 #include "slm_util.h"
 #include "slm_at_host.h"
 #include "slm_native_tls.h"
@@ -59,6 +60,23 @@ static struct mqtt_publish_param pub_param;
 static uint8_t pub_topic[MQTT_MAX_TOPIC_LEN];
 static uint8_t pub_msg[MQTT_MESSAGE_BUFFER_LEN];
 
+/* Queued publish, followed by its topic and message */
+struct pub_record {
+	uint16_t message_id;
+	uint8_t qos;
+	uint8_t retain;
+	uint16_t topic_len;
+	uint16_t msg_len;
+};
+
+/* Publishes wait in the queue while the in-flight window is full */
+static K_MUTEX_DEFINE(pub_lock);
+RING_BUF_DECLARE(pub_queue, CONFIG_SLM_MQTTC_PUB_QUEUE_SIZE);
+static int pub_in_flight;
+static uint16_t pub_message_id;
+static uint8_t queued_topic[MQTT_MAX_TOPIC_LEN];
+static uint8_t queued_msg[MQTT_MESSAGE_BUFFER_LEN];
+
 /* global variable defined in different files */
 extern struct at_param_list at_param_list;
 extern char rsp_buf[SLM_AT_CMD_RESPONSE_MAX_LEN];
@@ -112,11 +130,124 @@ static int handle_mqtt_publish_evt(struct mqtt_client *const c, const struct mqt
 	return 0;
 }
 
+static int pub_send(const struct pub_record *rec, uint8_t *topic, uint8_t *msg)
+{
+	int err;
+	struct mqtt_publish_param param = {
+		.message.topic.qos = rec->qos,
+		.message.topic.topic.utf8 = topic,
+		.message.topic.topic.size = rec->topic_len,
+		.message.payload.data = msg,
+		.message.payload.len = rec->msg_len,
+		.message_id = rec->message_id,
+		.dup_flag = 0,
+		.retain_flag = rec->retain
+	};
+
+	err = mqtt_publish(&client, &param);
+	if (err == 0 && rec->qos != MQTT_QOS_0_AT_MOST_ONCE) {
+		pub_in_flight++;
+	}
+
+	return err;
+}
+
+/**@brief Send queued publishes until the in-flight window is full.
+ * Must be called with pub_lock held.
+ */
+static void pub_queue_flush(void)
+{
+	struct pub_record rec;
+	int err;
+
+	while (pub_in_flight < CONFIG_SLM_MQTTC_PUB_WINDOW &&
+	       ring_buf_get(&pub_queue, (uint8_t *)&rec, sizeof(rec)) == sizeof(rec)) {
+		(void)ring_buf_get(&pub_queue, queued_topic, rec.topic_len);
+		(void)ring_buf_get(&pub_queue, queued_msg, rec.msg_len);
+		err = pub_send(&rec, queued_topic, queued_msg);
+		if (err) {
+			LOG_ERR("Fail to publish %u: %d", rec.message_id, err);
+			if (rec.qos != MQTT_QOS_0_AT_MOST_ONCE) {
+				sprintf(rsp_buf, "\r\n#XMQTTEVT: %d,%d,%u\r\n",
+					(rec.qos == MQTT_QOS_1_AT_LEAST_ONCE) ?
+					MQTT_EVT_PUBACK : MQTT_EVT_PUBCOMP, err, rec.message_id);
+				rsp_send(rsp_buf, strlen(rsp_buf));
+			}
+		}
+	}
+}
+
+/**@brief Publish a message, or queue it if others are waiting or the
+ * in-flight window is full.
+ */
+static int pub_submit(uint8_t *topic, size_t topic_len, uint8_t *msg, size_t msg_len,
+		      uint8_t qos, uint8_t retain, uint16_t *message_id)
+{
+	int err = 0;
+	struct pub_record rec = {
+		.qos = qos,
+		.retain = retain,
+		.topic_len = topic_len,
+		.msg_len = msg_len
+	};
+
+	k_mutex_lock(&pub_lock, K_FOREVER);
+	pub_message_id++;
+	if (pub_message_id == UINT16_MAX) {
+		pub_message_id = 1;
+	}
+	rec.message_id = pub_message_id;
+
+	if (ring_buf_is_empty(&pub_queue) &&
+	    (qos == MQTT_QOS_0_AT_MOST_ONCE || pub_in_flight < CONFIG_SLM_MQTTC_PUB_WINDOW)) {
+		err = pub_send(&rec, topic, msg);
+	} else if (topic_len > sizeof(queued_topic) || msg_len > sizeof(queued_msg)) {
+		LOG_WRN("Publish too large to be queued");
+		err = -EMSGSIZE;
+	} else if (ring_buf_space_get(&pub_queue) < sizeof(rec) + topic_len + msg_len) {
+		LOG_WRN("Publish queue full");
+		err = -ENOBUFS;
+	} else {
+		(void)ring_buf_put(&pub_queue, (uint8_t *)&rec, sizeof(rec));
+		(void)ring_buf_put(&pub_queue, topic, topic_len);
+		(void)ring_buf_put(&pub_queue, msg, msg_len);
+		LOG_DBG("Publish %u queued", rec.message_id);
+	}
+	k_mutex_unlock(&pub_lock);
+
+	if (message_id) {
+		*message_id = rec.message_id;
+	}
+
+	return err;
+}
+
+/**@brief Handle PUBACK and PUBCOMP, which end a publish in flight
+ */
+static void pub_complete(void)
+{
+	k_mutex_lock(&pub_lock, K_FOREVER);
+	if (pub_in_flight > 0) {
+		pub_in_flight--;
+	}
+	pub_queue_flush();
+	k_mutex_unlock(&pub_lock);
+}
+
+static void pub_queue_reset(void)
+{
+	k_mutex_lock(&pub_lock, K_FOREVER);
+	ring_buf_reset(&pub_queue);
+	pub_in_flight = 0;
+	k_mutex_unlock(&pub_lock);
+}
+
 /**@brief MQTT client event handler
  */
 void mqtt_evt_handler(struct mqtt_client *const c, const struct mqtt_evt *evt)
 {
 	int ret;
+	int message_id = -1;
 
 	ret = evt->result;
 	switch (evt->type) {
@@ -138,6 +269,8 @@ void mqtt_evt_handler(struct mqtt_client *const c, const struct mqtt_evt *evt)
 		if (evt->result == 0) {
 			LOG_DBG("PUBACK packet id: %u", evt->param.puback.message_id);
 		}
+		message_id = evt->param.puback.message_id;
+		pub_complete();
 		break;
 
 	case MQTT_EVT_PUBREC:
@@ -180,6 +313,8 @@ void mqtt_evt_handler(struct mqtt_client *const c, const struct mqtt_evt *evt)
 		if (evt->result == 0) {
 			LOG_DBG("PUBCOMP packet id %u", evt->param.pubcomp.message_id);
 		}
+		message_id = evt->param.pubcomp.message_id;
+		pub_complete();
 		break;
 
 	case MQTT_EVT_SUBACK:
@@ -193,8 +328,13 @@ void mqtt_evt_handler(struct mqtt_client *const c, const struct mqtt_evt *evt)
 		break;
 	}
 
-	sprintf(rsp_buf, "\r\n#XMQTTEVT: %d,%d\r\n",
-		evt->type, ret);
+	if (message_id >= 0) {
+		sprintf(rsp_buf, "\r\n#XMQTTEVT: %d,%d,%d\r\n",
+			evt->type, ret, message_id);
+	} else {
+		sprintf(rsp_buf, "\r\n#XMQTTEVT: %d,%d\r\n",
+			evt->type, ret);
+	}
 	rsp_send(rsp_buf, strlen(rsp_buf));
 }
 
@@ -357,6 +497,7 @@ static int do_mqtt_connect(void)
 
 	/* Connect to MQTT broker */
 	client_init();
+	pub_queue_reset();
 	err = mqtt_connect(&client);
 	if (err != 0) {
 		LOG_ERR("ERROR: mqtt_connect %d", err);
@@ -395,12 +536,11 @@ static int do_mqtt_disconnect(void)
 	return err;
 }
 
-static int do_mqtt_publish(uint8_t *msg, size_t msg_len)
+static int do_mqtt_publish(uint8_t *msg, size_t msg_len, uint16_t *message_id)
 {
-	pub_param.message.payload.data = msg;
-	pub_param.message.payload.len  = msg_len;
-
-	return mqtt_publish(&client, &pub_param);
+	return pub_submit(pub_param.message.topic.topic.utf8, pub_param.message.topic.topic.size,
+			  msg, msg_len, pub_param.message.topic.qos, pub_param.retain_flag,
+			  message_id);
 }
 
 static int do_mqtt_subscribe(uint16_t op,
@@ -536,7 +676,7 @@ static int mqtt_datamode_callback(uint8_t op, const uint8_t *data, int len)
 	int ret = 0;
 
 	if (op == DATAMODE_SEND) {
-		ret = do_mqtt_publish((uint8_t *)data, len);
+		ret = do_mqtt_publish((uint8_t *)data, len, NULL);
 		LOG_INF("datamode send: %d", ret);
 	} else if (op == DATAMODE_EXIT) {
 		LOG_DBG("MQTT datamode exit");
@@ -610,16 +750,17 @@ int handle_at_mqtt_publish(enum at_cmd_type cmd_type)
 		}
 		pub_param.message.topic.topic.utf8 = pub_topic;
 		pub_param.message.topic.topic.size = topic_sz;
-		pub_param.dup_flag = 0;
-		pub_param.message_id++;
-		if (pub_param.message_id == UINT16_MAX) {
-			pub_param.message_id = 1;
-		}
 		if (strlen(pub_msg) == 0) {
 			/* Publish payload in data mode */
 			err = enter_datamode(mqtt_datamode_callback);
 		} else {
-			err = do_mqtt_publish(pub_msg, msg_sz);
+			uint16_t message_id;
+
+			err = do_mqtt_publish(pub_msg, msg_sz, &message_id);
+			if (err == 0 && qos != MQTT_QOS_0_AT_MOST_ONCE) {
+				sprintf(rsp_buf, "\r\n#XMQTTPUB: %d\r\n", message_id);
+				rsp_send(rsp_buf, strlen(rsp_buf));
+			}
 		}
 		break;
 
@@ -719,7 +860,7 @@ int handle_at_mqtt_unsubscribe(enum at_cmd_type cmd_type)
 
 int slm_at_mqtt_init(void)
 {
-	pub_param.message_id = 0;
+	pub_message_id = 0;
 	memset(&ctx, 0, sizeof(ctx));
 	ctx.sec_tag = INVALID_SEC_TAG;
 
@@ -729,6 +870,7 @@ int slm_at_mqtt_init(void)
 int slm_at_mqtt_uninit(void)
 {
 	client.broker = NULL;
+	pub_queue_reset();
 
 	return 0;
 }
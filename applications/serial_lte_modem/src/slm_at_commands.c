@@ -17,6 +17,7 @@
 #include "ncs_version.h"
 
 #include "slm_util.h"
+#include "slm_poll.h"
 #include "slm_at_host.h"
 #include "slm_at_tcp_proxy.h"
 #include "slm_at_udp_proxy.h"
@@ -42,6 +43,9 @@
 #if defined(CONFIG_SLM_TWI)
 #include "slm_at_twi.h"
 #endif
+#if defined(CONFIG_SLM_CMUX)
+#include "slm_at_cmux.h"
+#endif
 
 LOG_MODULE_REGISTER(slm_at, CONFIG_SLM_LOG_LEVEL);
 
@@ -370,6 +374,11 @@ int handle_at_twi_read(enum at_cmd_type cmd_type);
 int handle_at_twi_write_read(enum at_cmd_type cmd_type);
 #endif
 
+#if defined(CONFIG_SLM_CMUX)
+int handle_at_cmux(enum at_cmd_type cmd_type);
+int handle_at_cmux_bind(enum at_cmd_type cmd_type);
+#endif
+
 static struct slm_at_cmd {
 	char *string;
 	slm_at_handler_t handler;
@@ -461,8 +470,18 @@ static struct slm_at_cmd {
 	{"AT#XTWIR", handle_at_twi_read},
 	{"AT#XTWIWR", handle_at_twi_write_read},
 #endif
+
+#if defined(CONFIG_SLM_CMUX)
+	/* CMUX commands */
+	{"AT#XCMUX", handle_at_cmux},
+	{"AT#XCMUXBIND", handle_at_cmux_bind},
+#endif
 };
 
+/* Indexes of slm_at_cmd_list sorted by command name, for binary search */
+static uint8_t slm_at_cmd_index[ARRAY_SIZE(slm_at_cmd_list)];
+BUILD_ASSERT(ARRAY_SIZE(slm_at_cmd_list) <= UINT8_MAX + 1);
+
 int handle_at_clac(enum at_cmd_type cmd_type)
 {
 	int ret = -EINVAL;
@@ -480,27 +499,91 @@ int handle_at_clac(enum at_cmd_type cmd_type)
 	return ret;
 }
 
-int slm_at_parse(const char *at_cmd)
+/* Compare the first len characters of name, ignoring case, with a command */
+static int cmd_name_cmp(const char *name, size_t len, const char *cmd)
+{
+	int diff;
+
+	for (size_t i = 0; i < len; i++) {
+		diff = toupper((int)name[i]) - toupper((int)cmd[i]);
+		if (diff != 0) {
+			return diff;
+		}
+	}
+
+	return (cmd[len] == '\0') ? 0 : -1;
+}
+
+static void cmd_index_sort(void)
 {
-	int ret = -ENOENT;
 	int total = ARRAY_SIZE(slm_at_cmd_list);
 
 	for (int i = 0; i < total; i++) {
-		if (slm_util_cmd_casecmp(at_cmd, slm_at_cmd_list[i].string)) {
-			enum at_cmd_type type = at_parser_cmd_type_get(at_cmd);
+		const char *cmd = slm_at_cmd_list[i].string;
+		int j = i;
 
-			at_params_list_clear(&at_param_list);
-			ret = at_parser_params_from_str(at_cmd, NULL, &at_param_list);
-			if (ret) {
-				LOG_ERR("Failed to parse AT command %d", ret);
-				return -EINVAL;
-			}
-			ret = slm_at_cmd_list[i].handler(type);
-			break;
+		while (j > 0 && cmd_name_cmp(cmd, strlen(cmd),
+					     slm_at_cmd_list[slm_at_cmd_index[j - 1]].string) < 0) {
+			slm_at_cmd_index[j] = slm_at_cmd_index[j - 1];
+			j--;
+		}
+		slm_at_cmd_index[j] = i;
+	}
+}
+
+static struct slm_at_cmd *cmd_find(const char *at_cmd)
+{
+	size_t len = 0;
+	int low = 0;
+	int high = ARRAY_SIZE(slm_at_cmd_list) - 1;
+
+	/* The grammar is checked already: AT<separator><body>[=|?...] */
+	if (strlen(at_cmd) > 3) {
+		len = 3;
+		while (isalnum((int)at_cmd[len])) {
+			len++;
 		}
 	}
+	if (len == 0) {
+		return NULL;
+	}
 
-	return ret;
+	while (low <= high) {
+		int mid = (low + high) / 2;
+		struct slm_at_cmd *cmd = &slm_at_cmd_list[slm_at_cmd_index[mid]];
+		int diff = cmd_name_cmp(at_cmd, len, cmd->string);
+
+		if (diff == 0) {
+			return cmd;
+		} else if (diff < 0) {
+			high = mid - 1;
+		} else {
+			low = mid + 1;
+		}
+	}
+
+	return NULL;
+}
+
+int slm_at_parse(const char *at_cmd)
+{
+	int ret;
+	enum at_cmd_type type;
+	struct slm_at_cmd *cmd = cmd_find(at_cmd);
+
+	if (cmd == NULL) {
+		return -ENOENT;
+	}
+
+	type = at_parser_cmd_type_get(at_cmd);
+	at_params_list_clear(&at_param_list);
+	ret = at_parser_params_from_str(at_cmd, NULL, &at_param_list);
+	if (ret) {
+		LOG_ERR("Failed to parse AT command %d", ret);
+		return -EINVAL;
+	}
+
+	return cmd->handler(type);
 }
 
 int slm_at_init(void)
@@ -509,7 +592,13 @@ int slm_at_init(void)
 
 	k_work_init_delayable(&slm_work.uart_work, set_uart_wk);
 	k_work_init_delayable(&slm_work.sleep_work, go_sleep_wk);
+	cmd_index_sort();
 
+	err = slm_poll_init();
+	if (err) {
+		LOG_ERR("Poll service could not be initialized: %d", err);
+		return -EFAULT;
+	}
 	err = slm_at_tcp_proxy_init();
 	if (err) {
 		LOG_ERR("TCP Server could not be initialized: %d", err);
@@ -584,6 +673,13 @@ int slm_at_init(void)
 		return -EFAULT;
 	}
 #endif
+#if defined(CONFIG_SLM_CMUX)
+	err = slm_at_cmux_init();
+	if (err) {
+		LOG_ERR("CMUX could not be initialized: %d", err);
+		return -EFAULT;
+	}
+#endif
 
 	return err;
 }
@@ -654,4 +750,10 @@ void slm_at_uninit(void)
 		LOG_ERR("TWI could not be uninit: %d", err);
 	}
 #endif
+#if defined(CONFIG_SLM_CMUX)
+	err = slm_at_cmux_uninit();
+	if (err) {
+		LOG_WRN("CMUX could not be uninitialized: %d", err);
+	}
+#endif
 }
@@ -16,6 +16,9 @@
 #include "slm_util.h"
 #include "slm_at_host.h"
 #include "slm_at_fota.h"
+#if defined(CONFIG_SLM_CMUX)
+#include "slm_at_cmux.h"
+#endif
 
 LOG_MODULE_REGISTER(slm_at_host, CONFIG_SLM_LOG_LEVEL);
 
@@ -29,13 +32,23 @@ LOG_MODULE_REGISTER(slm_at_host, CONFIG_SLM_LOG_LEVEL);
  *  Modem library's NRF_MODEM_AT_MAX_CMD_SIZE */
 #define AT_MAX_CMD_LEN          4096
 
-#define UART_RX_BUF_NUM         2
+/* In datamode, RX buffers are lent to the send path until their data is
+ * sent, so more than two are needed to keep the UART receiving meanwhile.
+ */
+#define UART_RX_BUF_NUM         4
 #define UART_RX_LEN             256
 #define UART_RX_TIMEOUT_MS      1
 #define UART_ERROR_DELAY_MS     500
 #define UART_RX_MARGIN_MS       10
 
 #define HEXDUMP_DATAMODE_MAX    16
+#define DATAMODE_SLICE_NUM      32
+/* Data that can still arrive once RX is paused: the current buffer and the
+ * next one, already handed to the UART.
+ */
+#define DATAMODE_HIGH_WATER     (2 * UART_RX_LEN)
+/* RX resumes while the rest of the buffered data is being sent */
+#define DATAMODE_LOW_WATER      (AT_MAX_CMD_LEN / 2)
 
 static enum slm_operation_modes {
 	SLM_AT_COMMAND_MODE,  /* AT command host or bridge */
@@ -46,21 +59,36 @@ static const struct device *uart_dev;
 static uint8_t at_buf[AT_MAX_CMD_LEN];
 static uint16_t at_buf_len;
 static bool at_buf_overflow;
+static bool cmd_pending;
+static bool cmd_rx_disabled;
 static struct ring_buf data_rb;
 static bool datamode_off_pending;
 static bool datamode_rx_disabled;
+static bool datamode_rx_paused;
+static bool datamode_zero_copy;
 static slm_datamode_handler_t datamode_handler;
 static struct k_work raw_send_work;
 static struct k_work cmd_send_work;
 
 static uint8_t uart_rx_buf[UART_RX_BUF_NUM][UART_RX_LEN];
-static uint8_t *next_buf;
+/* References to each RX buffer: one by the UART while it owns the buffer,
+ * and one by each datamode slice in it that is not sent yet.
+ */
+static atomic_t uart_rx_buf_ref[UART_RX_BUF_NUM];
 static uint8_t *uart_tx_buf;
 static bool uart_recovery_pending;
 static struct k_work_delayable uart_recovery_work;
 
 static K_SEM_DEFINE(tx_done, 0, 1);
 
+/* Data received in datamode, sent straight from the RX buffers */
+struct datamode_slice {
+	const uint8_t *data;
+	size_t len;
+};
+
+K_MSGQ_DEFINE(datamode_slices, sizeof(struct datamode_slice), DATAMODE_SLICE_NUM, 4);
+
 /* global functions defined in different files */
 int slm_at_parse(const char *at_cmd);
 int slm_at_init(void);
@@ -76,6 +104,15 @@ uint16_t datamode_time_limit;                 /* Send trigger by time in data mo
 extern bool uart_configured;
 extern struct uart_config slm_uart;
 
+static bool cmux_active(void)
+{
+#if defined(CONFIG_SLM_CMUX)
+	return slm_cmux_active();
+#else
+	return false;
+#endif
+}
+
 static int uart_send(const uint8_t *str, size_t len)
 {
 	int ret;
@@ -107,26 +144,96 @@ void rsp_send(const char *str, size_t len)
 	}
 
 	LOG_HEXDUMP_DBG(str, len, "TX");
+#if defined(CONFIG_SLM_CMUX)
+	/* Multiplexed once the response to AT#XCMUX is sent */
+	if (slm_cmux_at_send(str, len) != -ENOTCONN) {
+		return;
+	}
+#endif
 	(void)uart_send(str, len);
 }
 
 void datamode_send(const uint8_t *data, size_t len)
 {
 	LOG_HEXDUMP_DBG(data, MIN(len, HEXDUMP_DATAMODE_MAX), "TX-DATAMODE");
+#if defined(CONFIG_SLM_CMUX)
+	if (slm_cmux_at_send(data, len) != -ENOTCONN) {
+		return;
+	}
+#endif
 	(void)uart_send(data, len);
 }
 
+int slm_uart_tx(const uint8_t *data, size_t len)
+{
+	return uart_send(data, len);
+}
+
+static uint8_t *rx_buf_alloc(void)
+{
+	for (int i = 0; i < UART_RX_BUF_NUM; i++) {
+		if (atomic_cas(&uart_rx_buf_ref[i], 0, 1)) {
+			return uart_rx_buf[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Returns -1 for data which is not in an RX buffer, like the terminator */
+static int rx_buf_idx(const uint8_t *data)
+{
+	if (data < uart_rx_buf[0] || data >= uart_rx_buf[UART_RX_BUF_NUM - 1] + UART_RX_LEN) {
+		return -1;
+	}
+
+	return (data - uart_rx_buf[0]) / UART_RX_LEN;
+}
+
+static void rx_buf_ref(const uint8_t *data)
+{
+	int idx = rx_buf_idx(data);
+
+	if (idx >= 0) {
+		(void)atomic_inc(&uart_rx_buf_ref[idx]);
+	}
+}
+
+static void rx_buf_unref(const uint8_t *data)
+{
+	int idx = rx_buf_idx(data);
+
+	if (idx >= 0) {
+		(void)atomic_dec(&uart_rx_buf_ref[idx]);
+	}
+}
+
+static void datamode_slices_drop(void)
+{
+	struct datamode_slice slice;
+
+	while (k_msgq_get(&datamode_slices, &slice, K_NO_WAIT) == 0) {
+		rx_buf_unref(slice.data);
+	}
+}
+
 static int uart_receive(void)
 {
 	int ret;
+	uint8_t *buf = rx_buf_alloc();
+
+	if (buf == NULL) {
+		LOG_ERR("No free UART RX buffer");
+		return -ENOMEM;
+	}
 
-	ret = uart_rx_enable(uart_dev, uart_rx_buf[0], sizeof(uart_rx_buf[0]), UART_RX_TIMEOUT_MS);
+	ret = uart_rx_enable(uart_dev, buf, UART_RX_LEN, UART_RX_TIMEOUT_MS);
 	if (ret) {
 		LOG_ERR("UART RX failed: %d", ret);
+		rx_buf_unref(buf);
 		rsp_send(FATAL_STR, sizeof(FATAL_STR) - 1);
 		return ret;
 	}
-	next_buf = uart_rx_buf[1];
 	at_buf_overflow = false;
 	at_buf_len = 0;
 
@@ -148,8 +255,18 @@ int enter_datamode(slm_datamode_handler_t handler)
 		LOG_INF("Invalid, not enter datamode");
 		return -EINVAL;
 	}
+	/* Data channels are used instead when multiplexed */
+	if (cmux_active()) {
+		LOG_INF("CMUX active, not enter datamode");
+		return -EBUSY;
+	}
 
 	ring_buf_init(&data_rb, sizeof(at_buf), at_buf);
+	/* Without a time limit, data is sent as it comes and does not need to
+	 * be gathered in the ring buffer.
+	 */
+	datamode_zero_copy = (datamode_time_limit == 0);
+	datamode_rx_paused = false;
 	datamode_handler = handler;
 	slm_operation_mode = SLM_DATA_MODE;
 	LOG_INF("Enter datamode");
@@ -169,6 +286,7 @@ bool exit_datamode(int exit_mode)
 		/* reset UART to restore command mode */
 		uart_rx_disable(uart_dev);
 		k_sleep(K_MSEC(10));
+		datamode_slices_drop();
 		(void)uart_receive();
 
 		if (exit_mode == DATAMODE_EXIT_OK) {
@@ -277,13 +395,64 @@ static void notification_handler(const char *response)
 	}
 }
 
+static int slice_send(const struct datamode_slice *slice)
+{
+	size_t offset = 0;
+	int size_sent;
+
+	LOG_INF("Raw send %zu", slice->len);
+	LOG_HEXDUMP_DBG(slice->data, MIN(slice->len, HEXDUMP_DATAMODE_MAX), "RX-DATAMODE");
+
+	while (offset < slice->len) {
+		if (datamode_handler == NULL) {
+			LOG_WRN("no handler, %zu dropped", slice->len - offset);
+			return 0;
+		}
+
+		size_sent = datamode_handler(DATAMODE_SEND, slice->data + offset,
+					     slice->len - offset);
+		if (size_sent < 0) {
+			LOG_WRN("Raw send failed, %zu dropped", slice->len - offset);
+			return size_sent;
+		} else if (size_sent == 0) {
+			break;
+		}
+		offset += size_sent;
+	}
+
+	return 0;
+}
+
+static void datamode_rx_resume(void)
+{
+	datamode_rx_paused = false;
+	(void)uart_receive();
+	datamode_rx_disabled = false;
+}
+
 static void raw_send(struct k_work *work)
 {
 	uint8_t *data = NULL;
 	int size_send, size_sent;
+	struct datamode_slice slice;
 
 	ARG_UNUSED(work);
 
+	/* Slices are sent from the RX buffers, which are handed back to the
+	 * UART once all their data is sent.
+	 */
+	while (k_msgq_get(&datamode_slices, &slice, K_NO_WAIT) == 0) {
+		int err = slice_send(&slice);
+
+		rx_buf_unref(slice.data);
+		if (err) {
+			(void)exit_datamode(DATAMODE_EXIT_ERROR);
+			/* UART RX already resumed */
+			datamode_rx_disabled = false;
+			return;
+		}
+	}
+
 	/* NOTE ring_buf_get_claim() might not return full size */
 	do {
 		size_send = ring_buf_get_claim(&data_rb, &data, sizeof(at_buf));
@@ -294,6 +463,10 @@ static void raw_send(struct k_work *work)
 				size_sent = datamode_handler(DATAMODE_SEND, data, size_send);
 				if (size_sent > 0) {
 					(void)ring_buf_get_finish(&data_rb, size_sent);
+					if (datamode_rx_disabled &&
+					    ring_buf_space_get(&data_rb) >= DATAMODE_LOW_WATER) {
+						datamode_rx_resume();
+					}
 				} else if (size_sent == 0) {
 					(void)ring_buf_get_finish(&data_rb, size_send);
 				} else {
@@ -317,8 +490,7 @@ static void raw_send(struct k_work *work)
 
 	/* resume UART RX in case of stopped by buffer full */
 	if (datamode_rx_disabled) {
-		(void)uart_receive();
-		datamode_rx_disabled = false;
+		datamode_rx_resume();
 	}
 }
 
@@ -357,6 +529,32 @@ static void silence_timer_handler(struct k_timer *timer)
 
 K_TIMER_DEFINE(silence_timer, silence_timer_handler, NULL);
 
+/* Called from the UART callback */
+static int datamode_data_put(const uint8_t *data, int len)
+{
+	if (datamode_zero_copy) {
+		struct datamode_slice slice = {
+			.data = data,
+			.len = len
+		};
+
+		/* Reference the RX buffer before the slice can be sent */
+		rx_buf_ref(data);
+		if (k_msgq_put(&datamode_slices, &slice, K_NO_WAIT)) {
+			rx_buf_unref(data);
+			return -ENOBUFS;
+		}
+
+		return 0;
+	}
+
+	if (ring_buf_put(&data_rb, data, len) != len) {
+		return -ENOBUFS;
+	}
+
+	return 0;
+}
+
 static int raw_rx_handler(const uint8_t *data, int datalen)
 {
 	int ret;
@@ -371,7 +569,7 @@ static int raw_rx_handler(const uint8_t *data, int datalen)
 			/* quit procedure aborted */
 			k_timer_stop(&silence_timer);
 			datamode_off_pending = false;
-			(void)ring_buf_put(&data_rb, quit_str, quit_str_len);
+			(void)datamode_data_put(quit_str, quit_str_len);
 			LOG_INF("datamode off cancelled");
 		}
 	} else {
@@ -392,17 +590,22 @@ static int raw_rx_handler(const uint8_t *data, int datalen)
 	}
 
 	/* Second, save data to buffer */
-	ret = ring_buf_put(&data_rb, data, datalen);
-	if (ret != datalen) {
+	ret = datamode_data_put(data, datalen);
+	if (ret) {
 		LOG_ERR("enqueue data error (%d, %d)", datalen, ret);
 		uart_rx_disable(uart_dev);
 		return -1;
 	}
-	ret = ring_buf_space_get(&data_rb);
-	if (ret < UART_RX_LEN) {
-		LOG_WRN("data buffer full (%d)", ret);
-		uart_rx_disable(uart_dev);
-		return -1;
+	if (!datamode_zero_copy) {
+		ret = ring_buf_space_get(&data_rb);
+		if (ret < DATAMODE_HIGH_WATER && !datamode_rx_paused) {
+			/* Stop handing out RX buffers. The UART stops once the ones it
+			 * has are full, with RTS deasserted if flow control is used,
+			 * and the buffered data is sent meanwhile.
+			 */
+			LOG_DBG("data buffer high water (%d)", ret);
+			datamode_rx_paused = true;
+		}
 	}
 
 	/* Third, start/restart inactivity timer, or trigger sending */
@@ -551,7 +754,16 @@ static void cmd_send(struct k_work *work)
 	}
 
 done:
-	(void)uart_receive();
+	cmd_pending = false;
+#if defined(CONFIG_SLM_CMUX)
+	if (slm_cmux_active()) {
+		slm_cmux_at_resume();
+	}
+#endif
+	if (cmd_rx_disabled) {
+		cmd_rx_disabled = false;
+		(void)uart_receive();
+	}
 }
 
 static int cmd_rx_handler(uint8_t character)
@@ -612,7 +824,12 @@ static int cmd_rx_handler(uint8_t character)
 	return 0;
 
 send:
-	uart_rx_disable(uart_dev);
+	/* When multiplexed, the AT channel is held until the command is done */
+	if (!cmux_active()) {
+		uart_rx_disable(uart_dev);
+		cmd_rx_disabled = true;
+	}
+	cmd_pending = true;
 
 	at_buf[at_cmd_len] = '\0';
 	at_buf_len = at_cmd_len;
@@ -626,6 +843,17 @@ send:
 	return 0;
 }
 
+int slm_at_host_cmd_rx(const uint8_t *data, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len && !cmd_pending; i++) {
+		(void)cmd_rx_handler(data[i]);
+	}
+
+	return i;
+}
+
 static void uart_callback(const struct device *dev, struct uart_event *evt, void *user_data)
 {
 	int err;
@@ -646,6 +874,13 @@ static void uart_callback(const struct device *dev, struct uart_event *evt, void
 		LOG_INF("TX_ABORTED");
 		break;
 	case UART_RX_RDY:
+#if defined(CONFIG_SLM_CMUX)
+		if (slm_cmux_active()) {
+			slm_cmux_rx(&(evt->data.rx.buf[pos]), evt->data.rx.len);
+			pos += evt->data.rx.len;
+			break;
+		}
+#endif
 		if (slm_operation_mode == SLM_AT_COMMAND_MODE) {
 			for (int i = pos; i < (pos + evt->data.rx.len); i++) {
 				err = cmd_rx_handler(evt->data.rx.buf[i]);
@@ -664,15 +899,28 @@ static void uart_callback(const struct device *dev, struct uart_event *evt, void
 		}
 		pos += evt->data.rx.len;
 		break;
-	case UART_RX_BUF_REQUEST:
+	case UART_RX_BUF_REQUEST: {
+		uint8_t *buf = rx_buf_alloc();
+
 		pos = 0;
-		err = uart_rx_buf_rsp(uart_dev, next_buf, sizeof(uart_rx_buf[0]));
+		if (slm_operation_mode == SLM_DATA_MODE && datamode_rx_paused) {
+			rx_buf_unref(buf);
+			break;
+		}
+		if (buf == NULL) {
+			/* All lent to datamode, RX resumes once they are sent */
+			LOG_WRN("No free UART RX buffer");
+			break;
+		}
+		err = uart_rx_buf_rsp(uart_dev, buf, UART_RX_LEN);
 		if (err) {
 			LOG_WRN("UART RX buf rsp: %d", err);
+			rx_buf_unref(buf);
 		}
 		break;
+	}
 	case UART_RX_BUF_RELEASED:
-		next_buf = evt->data.rx_buf.buf;
+		rx_buf_unref(evt->data.rx_buf.buf);
 		break;
 	case UART_RX_STOPPED:
 		LOG_WRN("RX_STOPPED (%d)", evt->data.rx_stop.reason);
@@ -11,13 +11,11 @@
 #include "slm_util.h"
 #include "slm_native_tls.h"
 #include "slm_at_host.h"
+#include "slm_poll.h"
 #include "slm_at_tcp_proxy.h"
 
 LOG_MODULE_REGISTER(slm_tcp, CONFIG_SLM_LOG_LEVEL);
 
-#define THREAD_STACK_SIZE	KB(4)
-#define THREAD_PRIORITY		K_LOWEST_APPLICATION_THREAD_PRIO
-
 /* Some features need future modem firmware support */
 #define SLM_TCP_PROXY_FUTURE_FEATURE	0
 
@@ -37,9 +35,6 @@ enum slm_tcp_role {
 	TCP_ROLE_SERVER
 };
 
-static struct k_thread tcp_thread;
-static K_THREAD_STACK_DEFINE(tcp_thread_stack, THREAD_STACK_SIZE);
-
 static struct tcp_proxy {
 	int sock;		/* Socket descriptor. */
 	int family;		/* Socket address family */
@@ -52,9 +47,9 @@ static struct tcp_proxy {
 extern struct at_param_list at_param_list;
 extern char rsp_buf[SLM_AT_CMD_RESPONSE_MAX_LEN];
 
-/** forward declaration of thread function **/
-static void tcpcli_thread_func(void *p1, void *p2, void *p3);
-static void tcpsvr_thread_func(void *p1, void *p2, void *p3);
+/** forward declaration of socket event handlers **/
+static void tcpcli_poll_handler(int fd, short revents, void *ctx);
+static void tcpsvr_poll_handler(int fd, short revents, void *ctx);
 
 static int do_tcp_server_start(uint16_t port)
 {
@@ -188,10 +183,10 @@ static int do_tcp_server_start(uint16_t port)
 		goto exit_svr;
 	}
 
-	k_thread_create(&tcp_thread, tcp_thread_stack,
-			K_THREAD_STACK_SIZEOF(tcp_thread_stack),
-			tcpsvr_thread_func, NULL, NULL, NULL,
-			THREAD_PRIORITY, K_USER, K_NO_WAIT);
+	ret = slm_poll_add(proxy.sock, POLLIN, tcpsvr_poll_handler, NULL);
+	if (ret) {
+		goto exit_svr;
+	}
 	proxy.role = TCP_ROLE_SERVER;
 	sprintf(rsp_buf, "\r\n#XTCPSVR: %d,\"started\"\r\n", proxy.sock);
 	rsp_send(rsp_buf, strlen(rsp_buf));
@@ -229,9 +224,11 @@ static int do_tcp_server_stop(void)
 	}
 #endif
 	if (proxy.sock_peer != INVALID_SOCKET) {
+		(void)slm_poll_remove(proxy.sock_peer);
 		(void)close(proxy.sock_peer);
 		proxy.sock_peer = INVALID_SOCKET;
 	}
+	(void)slm_poll_remove(proxy.sock);
 	ret = close(proxy.sock);
 	if (ret < 0) {
 		LOG_WRN("close() failed: %d", -errno);
@@ -239,10 +236,6 @@ static int do_tcp_server_stop(void)
 	} else {
 		proxy.sock = INVALID_SOCKET;
 	}
-	if (ret == 0 &&
-	    k_thread_join(&tcp_thread, K_SECONDS(CONFIG_SLM_TCP_POLL_TIME * 2)) != 0) {
-		LOG_WRN("Wait for thread terminate failed");
-	}
 	sprintf(rsp_buf, "\r\n#XTCPSVR: %d,\"stopped\"\r\n", ret);
 	rsp_send(rsp_buf, strlen(rsp_buf));
 
@@ -315,10 +308,11 @@ static int do_tcp_client_connect(const char *url, uint16_t port)
 		goto exit_cli;
 	}
 
-	k_thread_create(&tcp_thread, tcp_thread_stack,
-			K_THREAD_STACK_SIZEOF(tcp_thread_stack),
-			tcpcli_thread_func, NULL, NULL, NULL,
-			THREAD_PRIORITY, K_USER, K_NO_WAIT);
+	ret = slm_poll_add(proxy.sock, POLLIN, tcpcli_poll_handler, NULL);
+	if (ret) {
+		freeaddrinfo(res);
+		goto exit_cli;
+	}
 
 	proxy.role = TCP_ROLE_CLIENT;
 	sprintf(rsp_buf, "\r\n#XTCPCLI: %d,\"connected\"\r\n", proxy.sock);
@@ -343,6 +337,7 @@ static int do_tcp_client_disconnect(void)
 	if (proxy.sock == INVALID_SOCKET) {
 		return 0;
 	}
+	(void)slm_poll_remove(proxy.sock);
 	ret = close(proxy.sock);
 	if (ret < 0) {
 		LOG_WRN("close() failed: %d", -errno);
@@ -350,10 +345,6 @@ static int do_tcp_client_disconnect(void)
 	} else {
 		proxy.sock = INVALID_SOCKET;
 	}
-	if (ret == 0 &&
-	    k_thread_join(&tcp_thread, K_SECONDS(CONFIG_SLM_TCP_POLL_TIME * 2)) != 0) {
-		LOG_WRN("Wait for thread terminate failed");
-	}
 	sprintf(rsp_buf, "\r\n#XTCPCLI: %d,\"disconnected\"\r\n", ret);
 	rsp_send(rsp_buf, strlen(rsp_buf));
 
@@ -434,6 +425,7 @@ static void tcpsvr_terminate_connection(int cause)
 		(void)exit_datamode(DATAMODE_EXIT_URC);
 	}
 	if (proxy.sock_peer != INVALID_SOCKET) {
+		(void)slm_poll_remove(proxy.sock_peer);
 		close(proxy.sock_peer);
 		proxy.sock_peer = INVALID_SOCKET;
 		sprintf(rsp_buf, "\r\n#XTCPSVR: %d,\"disconnected\"\r\n", cause);
@@ -441,141 +433,122 @@ static void tcpsvr_terminate_connection(int cause)
 	}
 }
 
-/* TCP server thread */
-static void tcpsvr_thread_func(void *p1, void *p2, void *p3)
+/* Receive data and pass it to the host */
+static void tcp_recv(int fd)
 {
+	char rx_data[SLM_MAX_PAYLOAD];
 	int ret;
-	struct pollfd fds[2];
-
-	ARG_UNUSED(p1);
-	ARG_UNUSED(p2);
-	ARG_UNUSED(p3);
-
-	fds[0].fd = proxy.sock;
-	fds[0].events = POLLIN;
-	/** The field fd contains a file descriptor for an open file.  If this field is negative,
-	 * then the corresponding events field is ignored and the revents field returns zero.
-	 */
-	fds[1].fd = INVALID_SOCKET;
-	fds[1].events = POLLIN;
-	while (true) {
-		ret = poll(fds, 2, MSEC_PER_SEC * CONFIG_SLM_TCP_POLL_TIME);
-		if (ret < 0) {
-			LOG_WRN("poll() error: %d", -errno);
-			ret = -EIO;
-			break;
-		} /* IO error */
-		if (ret == 0) {
-			continue;
-		} /* timeout */
-		LOG_DBG("fds[0] events 0x%08x", fds[0].revents);
-		LOG_DBG("fds[1] events 0x%08x", fds[1].revents);
-		/* Listening socket events must be handled first*/
-		if (fds[0].revents) {
-			if ((fds[0].revents & POLLERR) == POLLERR) {
-				LOG_ERR("0: POLLERR");
-				ret = -EIO;
-				break;
-			}
-			if ((fds[0].revents & POLLHUP) == POLLHUP) {
-				LOG_WRN("0: POLLHUP");
-				ret = -ECONNRESET;
-				break;
-			}
-			if ((fds[0].revents & POLLNVAL) == POLLNVAL) {
-				/* server stopped by AT command */
-				LOG_WRN("0: POLLNVAL");
-				ret = -ENETDOWN;
-				break;
-			}
-			if ((fds[0].revents & POLLIN) != POLLIN) {
-				/* Ignore and check whether there are client events */
-				goto client_events;
-			}
 
-			/* Accept incoming connection */
-			char peer_addr[INET6_ADDRSTRLEN] = {0};
-			socklen_t len;
+	ret = recv(fd, (void *)rx_data, sizeof(rx_data), MSG_DONTWAIT);
+	if (ret < 0) {
+		if (errno != EAGAIN) {
+			LOG_WRN("recv() error: %d", -errno);
+		}
+		return;
+	}
+	if (ret == 0) {
+		return;
+	}
+	if (in_datamode()) {
+		datamode_send(rx_data, ret);
+	} else {
+		rsp_send(rx_data, ret);
+		sprintf(rsp_buf, "\r\n#XTCPDATA: %d\r\n", ret);
+		rsp_send(rsp_buf, strlen(rsp_buf));
+	}
+}
 
-			if (proxy.family == AF_INET) {
-				struct sockaddr_in client;
+/* TCP server, incoming connection events */
+static void tcpsvr_peer_poll_handler(int fd, short revents, void *ctx)
+{
+	ARG_UNUSED(ctx);
 
-				len = sizeof(struct sockaddr_in);
-				ret = accept(proxy.sock, (struct sockaddr *)&client, &len);
-				if (ret == -1) {
-					LOG_WRN("accept(ipv4) error: %d", -errno);
-					goto client_events;
-				}
-				(void)inet_ntop(AF_INET, &client.sin_addr, peer_addr,
-					sizeof(peer_addr));
-			} else {
-				struct sockaddr_in6 client;
-
-				len = sizeof(struct sockaddr_in6);
-				ret = accept(proxy.sock, (struct sockaddr *)&client, &len);
-				if (ret == -1) {
-					LOG_WRN("accept(ipv6) error: %d", -errno);
-					goto client_events;
-				}
-				(void)inet_ntop(AF_INET6, &client.sin6_addr, peer_addr,
-					sizeof(peer_addr));
-			}
-			if (fds[1].fd >= 0) {
-				LOG_WRN("Full. Close connection.");
-				close(ret);
-				goto client_events;
-			}
-			proxy.sock_peer = ret;
-			fds[1].fd = proxy.sock_peer;
-			sprintf(rsp_buf, "\r\n#XTCPSVR: \"%s\",\"connected\"\r\n", peer_addr);
-			rsp_send(rsp_buf, strlen(rsp_buf));
-			LOG_DBG("New connection - %d", proxy.sock_peer);
+	if ((revents & POLLERR) == POLLERR) {
+		LOG_ERR("1: POLLERR");
+		tcpsvr_terminate_connection(-EIO);
+		return;
+	}
+	if ((revents & POLLHUP) == POLLHUP) {
+		LOG_ERR("1: POLLHUP");
+		tcpsvr_terminate_connection(-ECONNRESET);
+		return;
+	}
+	if ((revents & POLLNVAL) == POLLNVAL) {
+		LOG_WRN("1: POLLNVAL");
+		tcpsvr_terminate_connection(-ENETDOWN);
+		return;
+	}
+	if ((revents & POLLIN) == POLLIN) {
+		tcp_recv(fd);
+	}
+}
+
+/* TCP server, listening socket events */
+static void tcpsvr_poll_handler(int fd, short revents, void *ctx)
+{
+	int ret;
+	char peer_addr[INET6_ADDRSTRLEN] = {0};
+	socklen_t len;
+
+	ARG_UNUSED(ctx);
+
+	if ((revents & POLLERR) == POLLERR) {
+		LOG_ERR("0: POLLERR");
+		ret = -EIO;
+		goto exit;
+	}
+	if ((revents & POLLHUP) == POLLHUP) {
+		LOG_WRN("0: POLLHUP");
+		ret = -ECONNRESET;
+		goto exit;
+	}
+	if ((revents & POLLNVAL) == POLLNVAL) {
+		LOG_WRN("0: POLLNVAL");
+		ret = -ENETDOWN;
+		goto exit;
+	}
+	if ((revents & POLLIN) != POLLIN) {
+		return;
+	}
+
+	/* Accept incoming connection */
+	if (proxy.family == AF_INET) {
+		struct sockaddr_in client;
+
+		len = sizeof(struct sockaddr_in);
+		ret = accept(fd, (struct sockaddr *)&client, &len);
+		if (ret == -1) {
+			LOG_WRN("accept(ipv4) error: %d", -errno);
+			return;
 		}
-client_events:
-		/* Incoming socket events */
-		if (fds[1].revents) {
-			if ((fds[1].revents & POLLERR) == POLLERR) {
-				LOG_ERR("1: POLLERR");
-				tcpsvr_terminate_connection(-EIO);
-				fds[1].fd = INVALID_SOCKET;
-				continue;
-			}
-			if ((fds[1].revents & POLLHUP) == POLLHUP) {
-				LOG_ERR("1: POLLHUP");
-				tcpsvr_terminate_connection(-ECONNRESET);
-				fds[1].fd = INVALID_SOCKET;
-				continue;
-			}
-			if ((fds[1].revents & POLLNVAL) == POLLNVAL) {
-				LOG_WRN("1: POLLNVAL");
-				tcpsvr_terminate_connection(-ENETDOWN);
-				fds[1].fd = INVALID_SOCKET;
-				continue;
-			}
-			if ((fds[1].revents & POLLIN) != POLLIN) {
-				continue;
-			}
-			/* Receive data */
-			char rx_data[SLM_MAX_PAYLOAD];
+		(void)inet_ntop(AF_INET, &client.sin_addr, peer_addr, sizeof(peer_addr));
+	} else {
+		struct sockaddr_in6 client;
 
-			ret = recv(fds[1].fd, (void *)rx_data, sizeof(rx_data), 0);
-			if (ret < 0) {
-				LOG_WRN("recv() error: %d", -errno);
-				continue;
-			}
-			if (ret == 0) {
-				continue;
-			}
-			if (in_datamode()) {
-				datamode_send(rx_data, ret);
-			} else {
-				rsp_send(rx_data, ret);
-				sprintf(rsp_buf, "\r\n#XTCPDATA: %d\r\n", ret);
-				rsp_send(rsp_buf, strlen(rsp_buf));
-			}
+		len = sizeof(struct sockaddr_in6);
+		ret = accept(fd, (struct sockaddr *)&client, &len);
+		if (ret == -1) {
+			LOG_WRN("accept(ipv6) error: %d", -errno);
+			return;
 		}
+		(void)inet_ntop(AF_INET6, &client.sin6_addr, peer_addr, sizeof(peer_addr));
+	}
+	if (proxy.sock_peer != INVALID_SOCKET) {
+		LOG_WRN("Full. Close connection.");
+		close(ret);
+		return;
 	}
+	if (slm_poll_add(ret, POLLIN, tcpsvr_peer_poll_handler, NULL) != 0) {
+		close(ret);
+		return;
+	}
+	proxy.sock_peer = ret;
+	sprintf(rsp_buf, "\r\n#XTCPSVR: \"%s\",\"connected\"\r\n", peer_addr);
+	rsp_send(rsp_buf, strlen(rsp_buf));
+	LOG_DBG("New connection - %d", proxy.sock_peer);
+	return;
 
+exit:
 #if defined(CONFIG_SLM_NATIVE_TLS)
 	if (proxy.sec_tag != INVALID_SEC_TAG) {
 		(void)slm_tls_unloadcrdl(proxy.sec_tag);
@@ -584,89 +557,57 @@ client_events:
 #endif
 	tcpsvr_terminate_connection(ret);
 	if (proxy.sock != INVALID_SOCKET) {
+		(void)slm_poll_remove(proxy.sock);
 		(void)close(proxy.sock);
 		proxy.sock = INVALID_SOCKET;
 		sprintf(rsp_buf, "\r\n#XTCPSVR: %d,\"stopped\"\r\n", ret);
 		rsp_send(rsp_buf, strlen(rsp_buf));
 	}
 
-	LOG_INF("TCP server thread terminated");
+	LOG_INF("TCP server terminated");
 }
 
-/* TCP client thread */
-static void tcpcli_thread_func(void *p1, void *p2, void *p3)
+/* TCP client socket events */
+static void tcpcli_poll_handler(int fd, short revents, void *ctx)
 {
 	int ret;
-	static struct pollfd fds;
-
-	ARG_UNUSED(p1);
-	ARG_UNUSED(p2);
-	ARG_UNUSED(p3);
-
-	fds.fd = proxy.sock;
-	fds.events = POLLIN;
-	while (true) {
-		ret = poll(&fds, 1, MSEC_PER_SEC * CONFIG_SLM_TCP_POLL_TIME);
-		if (ret < 0) {  /* IO error */
-			LOG_WRN("poll() error: %d", ret);
-			ret = -EIO;
-			break;
-		}
-		if (ret == 0) {  /* timeout */
-			continue;
-		}
-		LOG_DBG("Poll events 0x%08x", fds.revents);
-		if ((fds.revents & POLLERR) == POLLERR) {
-			LOG_ERR("POLLERR");
-			ret = -EIO;
-			break;
-		}
-		if ((fds.revents & POLLNVAL) == POLLNVAL) {
-			/* client disconnected locally by AT command */
-			LOG_WRN("POLLNVAL");
-			ret = -ENETDOWN;
-			break;
-		}
-		if ((fds.revents & POLLHUP) == POLLHUP) {
-			/* client disconnected by remote or lose LTE connection */
-			LOG_WRN("POLLHUP");
-			ret = -ECONNRESET;
-			break;
-		}
-		if ((fds.revents & POLLIN) != POLLIN) {
-			continue;
-		}
-		/* Receive data */
-		char rx_data[SLM_MAX_PAYLOAD];
 
-		ret = recv(fds.fd, (void *)rx_data, sizeof(rx_data), 0);
-		if (ret < 0) {
-			LOG_WRN("recv() error: %d", -errno);
-			continue;
-		}
-		if (ret == 0) {
-			continue;
-		}
-		if (in_datamode()) {
-			datamode_send(rx_data, ret);
-		} else {
-			rsp_send(rx_data, ret);
-			sprintf(rsp_buf, "\r\n#XTCPDATA: %d\r\n", ret);
-			rsp_send(rsp_buf, strlen(rsp_buf));
-		}
+	ARG_UNUSED(ctx);
+
+	if ((revents & POLLERR) == POLLERR) {
+		LOG_ERR("POLLERR");
+		ret = -EIO;
+		goto exit;
+	}
+	if ((revents & POLLNVAL) == POLLNVAL) {
+		LOG_WRN("POLLNVAL");
+		ret = -ENETDOWN;
+		goto exit;
+	}
+	if ((revents & POLLHUP) == POLLHUP) {
+		/* client disconnected by remote or lose LTE connection */
+		LOG_WRN("POLLHUP");
+		ret = -ECONNRESET;
+		goto exit;
+	}
+	if ((revents & POLLIN) == POLLIN) {
+		tcp_recv(fd);
 	}
+	return;
 
+exit:
 	if (in_datamode()) {
 		(void)exit_datamode(DATAMODE_EXIT_URC);
 	}
 	if (proxy.sock != INVALID_SOCKET) {
+		(void)slm_poll_remove(proxy.sock);
 		(void)close(proxy.sock);
 		proxy.sock = INVALID_SOCKET;
 		sprintf(rsp_buf, "\r\n#XTCPCLI: %d,\"disconnected\"\r\n", ret);
 		rsp_send(rsp_buf, strlen(rsp_buf));
 	}
 
-	LOG_INF("TCP client thread terminated");
+	LOG_INF("TCP client disconnected");
 }
 
 /**@brief handle AT#XTCPSVR commands
@@ -11,13 +11,11 @@
 #include <net/tls_credentials.h>
 #include "slm_util.h"
 #include "slm_at_host.h"
+#include "slm_poll.h"
 #include "slm_at_udp_proxy.h"
 
 LOG_MODULE_REGISTER(slm_udp, CONFIG_SLM_LOG_LEVEL);
 
-#define THREAD_STACK_SIZE	KB(4)
-#define THREAD_PRIORITY		K_LOWEST_APPLICATION_THREAD_PRIO
-
 /*
  * Known limitation in this version
  * - Multiple concurrent
@@ -33,10 +31,6 @@ enum slm_udp_proxy_operation {
 	CLIENT_CONNECT6 = SERVER_START6
 };
 
-static struct k_thread udp_thread;
-static K_THREAD_STACK_DEFINE(udp_thread_stack, THREAD_STACK_SIZE);
-static k_tid_t udp_thread_id;
-
 /**@brief Proxy roles. */
 enum slm_udp_role {
 	UDP_ROLE_CLIENT,
@@ -58,8 +52,8 @@ static struct udp_proxy {
 extern struct at_param_list at_param_list;
 extern char rsp_buf[SLM_AT_CMD_RESPONSE_MAX_LEN];
 
-/** forward declaration of thread function **/
-static void udp_thread_func(void *p1, void *p2, void *p3);
+/** forward declaration of socket event handler **/
+static void udp_poll_handler(int fd, short revents, void *ctx);
 
 static int do_udp_server_start(uint16_t port)
 {
@@ -123,10 +117,11 @@ static int do_udp_server_start(uint16_t port)
 		return -errno;
 	}
 
-	udp_thread_id = k_thread_create(&udp_thread, udp_thread_stack,
-			K_THREAD_STACK_SIZEOF(udp_thread_stack),
-			udp_thread_func, NULL, NULL, NULL,
-			THREAD_PRIORITY, K_USER, K_NO_WAIT);
+	ret = slm_poll_add(proxy.sock, POLLIN, udp_poll_handler, NULL);
+	if (ret) {
+		close(proxy.sock);
+		return ret;
+	}
 
 	proxy.role = UDP_ROLE_SERVER;
 	sprintf(rsp_buf, "\r\n#XUDPSVR: %d,\"started\"\r\n", proxy.sock);
@@ -142,6 +137,7 @@ static int do_udp_server_stop(void)
 	if (proxy.sock == INVALID_SOCKET) {
 		return 0;
 	}
+	(void)slm_poll_remove(proxy.sock);
 	ret = close(proxy.sock);
 	if (ret < 0) {
 		LOG_WRN("close() failed: %d", -errno);
@@ -155,10 +151,6 @@ static int do_udp_server_stop(void)
 		}
 		(void)slm_at_udp_proxy_init();
 	}
-	if (ret == 0 &&
-	    k_thread_join(&udp_thread, K_SECONDS(CONFIG_SLM_UDP_POLL_TIME * 2)) != 0) {
-		LOG_WRN("Wait for thread terminate failed");
-	}
 	sprintf(rsp_buf, "\r\n#XUDPSVR: %d,\"stopped\"\r\n", ret);
 	rsp_send(rsp_buf, strlen(rsp_buf));
 
@@ -224,10 +216,11 @@ static int do_udp_client_connect(const char *url, uint16_t port)
 		goto cli_exit;
 	}
 
-	udp_thread_id = k_thread_create(&udp_thread, udp_thread_stack,
-			K_THREAD_STACK_SIZEOF(udp_thread_stack),
-			udp_thread_func, NULL, NULL, NULL,
-			THREAD_PRIORITY, K_USER, K_NO_WAIT);
+	ret = slm_poll_add(proxy.sock, POLLIN, udp_poll_handler, NULL);
+	if (ret) {
+		freeaddrinfo(res);
+		goto cli_exit;
+	}
 
 	proxy.role = UDP_ROLE_CLIENT;
 	sprintf(rsp_buf, "\r\n#XUDPCLI: %d,\"connected\"\r\n", proxy.sock);
@@ -252,6 +245,7 @@ static int do_udp_client_disconnect(void)
 	if (proxy.sock == INVALID_SOCKET) {
 		return 0;
 	}
+	(void)slm_poll_remove(proxy.sock);
 	ret = close(proxy.sock);
 	if (ret < 0) {
 		LOG_WRN("close() failed: %d", -errno);
@@ -259,10 +253,6 @@ static int do_udp_client_disconnect(void)
 	} else {
 		proxy.sock = INVALID_SOCKET;
 	}
-	if (ret == 0 &&
-	    k_thread_join(&udp_thread, K_SECONDS(CONFIG_SLM_UDP_POLL_TIME * 2)) != 0) {
-		LOG_WRN("Wait for thread terminate failed");
-	}
 	sprintf(rsp_buf, "\r\n#XUDPCLI: %d,\"disconnected\"\r\n", ret);
 	rsp_send(rsp_buf, strlen(rsp_buf));
 
@@ -343,98 +333,86 @@ static int do_udp_send_datamode(const uint8_t *data, int datalen)
 	return (offset > 0) ? offset : -1;
 }
 
-static void udp_thread_func(void *p1, void *p2, void *p3)
+/* UDP socket events */
+static void udp_poll_handler(int fd, short revents, void *ctx)
 {
 	int ret;
-	struct pollfd fds;
 
-	ARG_UNUSED(p1);
-	ARG_UNUSED(p2);
-	ARG_UNUSED(p3);
-
-	fds.fd = proxy.sock;
-	fds.events = POLLIN;
-
-	do {
-		ret = poll(&fds, 1, MSEC_PER_SEC * CONFIG_SLM_UDP_POLL_TIME);
-		if (ret < 0) {  /* IO error */
-			LOG_WRN("poll() error: %d", ret);
-			continue;
-		}
-		if (ret == 0) {  /* timeout */
-			continue;
-		}
-		LOG_DBG("Poll events 0x%08x", fds.revents);
-		if ((fds.revents & POLLERR) == POLLERR) {
-			LOG_WRN("POLLERR");
-			ret = -EIO;
-			break;
-		}
-		if ((fds.revents & POLLNVAL) == POLLNVAL) {
-			/* UDP client or server closed */
-			LOG_WRN("POLLNVAL");
-			ret = -ENETDOWN;
-			break;
-		}
-		if ((fds.revents & POLLHUP) == POLLHUP) {
-			/* Lose LTE connection */
-			LOG_WRN("POLLHUP");
-			ret = -ECONNRESET;
-			break;
-		}
-		if ((fds.revents & POLLIN) != POLLIN) {
-			continue;
-		}
-		/* Receive data */
-		char rx_data[SLM_MAX_PAYLOAD];
+	ARG_UNUSED(ctx);
 
-		if (proxy.role == UDP_ROLE_SERVER) {
-			/* remember remote from last recvfrom */
-			if (proxy.family == AF_INET) {
-				int size = sizeof(struct sockaddr_in);
+	if ((revents & POLLERR) == POLLERR) {
+		LOG_WRN("POLLERR");
+		ret = -EIO;
+		goto exit;
+	}
+	if ((revents & POLLNVAL) == POLLNVAL) {
+		LOG_WRN("POLLNVAL");
+		ret = -ENETDOWN;
+		goto exit;
+	}
+	if ((revents & POLLHUP) == POLLHUP) {
+		/* Lose LTE connection */
+		LOG_WRN("POLLHUP");
+		ret = -ECONNRESET;
+		goto exit;
+	}
+	if ((revents & POLLIN) != POLLIN) {
+		return;
+	}
+	/* Receive data */
+	char rx_data[SLM_MAX_PAYLOAD];
 
-				memset(&proxy.remote, 0, sizeof(struct sockaddr_in));
-				ret = recvfrom(proxy.sock, (void *)rx_data, sizeof(rx_data), 0,
-					(struct sockaddr *)&(proxy.remote), &size);
-			} else {
-				int size = sizeof(struct sockaddr_in6);
+	if (proxy.role == UDP_ROLE_SERVER) {
+		/* remember remote from last recvfrom */
+		if (proxy.family == AF_INET) {
+			int size = sizeof(struct sockaddr_in);
 
-				memset(&proxy.remote6, 0, sizeof(struct sockaddr_in6));
-				ret = recvfrom(proxy.sock, (void *)rx_data, sizeof(rx_data), 0,
-					(struct sockaddr *)&(proxy.remote6), &size);
-			}
+			memset(&proxy.remote, 0, sizeof(struct sockaddr_in));
+			ret = recvfrom(fd, (void *)rx_data, sizeof(rx_data), MSG_DONTWAIT,
+				(struct sockaddr *)&(proxy.remote), &size);
 		} else {
-			ret = recv(proxy.sock, (void *)rx_data, sizeof(rx_data), 0);
+			int size = sizeof(struct sockaddr_in6);
+
+			memset(&proxy.remote6, 0, sizeof(struct sockaddr_in6));
+			ret = recvfrom(fd, (void *)rx_data, sizeof(rx_data), MSG_DONTWAIT,
+				(struct sockaddr *)&(proxy.remote6), &size);
 		}
-		if (ret < 0) {
+	} else {
+		ret = recv(fd, (void *)rx_data, sizeof(rx_data), MSG_DONTWAIT);
+	}
+	if (ret < 0) {
+		if (errno != EAGAIN) {
 			LOG_WRN("recv() error: %d", -errno);
-			continue;
-		}
-		if (ret == 0) {
-			continue;
 		}
-		rsp_send(rx_data, ret);
-		if (!in_datamode()) {
-			sprintf(rsp_buf, "\r\n#XUDPDATA: %d\r\n", ret);
-			rsp_send(rsp_buf, strlen(rsp_buf));
-		}
-	} while (true);
+		return;
+	}
+	if (ret == 0) {
+		return;
+	}
+	rsp_send(rx_data, ret);
+	if (!in_datamode()) {
+		sprintf(rsp_buf, "\r\n#XUDPDATA: %d\r\n", ret);
+		rsp_send(rsp_buf, strlen(rsp_buf));
+	}
+	return;
 
+exit:
 	if (in_datamode()) {
 		(void)exit_datamode(false);
 	}
 	if (proxy.sock != INVALID_SOCKET) {
+		(void)slm_poll_remove(proxy.sock);
 		(void)close(proxy.sock);
 		proxy.sock = INVALID_SOCKET;
 		if (proxy.role == UDP_ROLE_CLIENT) {
-			sprintf(rsp_buf, "\r\n#XTCPCLI: %d,\"disconnected\"\r\n", ret);
+			sprintf(rsp_buf, "\r\n#XUDPCLI: %d,\"disconnected\"\r\n", ret);
 		} else {
-			sprintf(rsp_buf, "\r\n#XTCPSVR: %d,\"stopped\"\r\n", ret);
+			sprintf(rsp_buf, "\r\n#XUDPSVR: %d,\"stopped\"\r\n", ret);
 		}
 		rsp_send(rsp_buf, strlen(rsp_buf));
 	}
 
-	LOG_INF("UDP thread terminated");
+	LOG_INF("UDP socket closed");
 }
 
 static int udp_datamode_callback(uint8_t op, const uint8_t *data, int len)
@@ -615,7 +593,7 @@ int slm_at_udp_proxy_uninit(void)
 	int ret = 0;
 
 	if (proxy.sock != INVALID_SOCKET) {
-		k_thread_abort(udp_thread_id);
+		(void)slm_poll_remove(proxy.sock);
 		ret = close(proxy.sock);
 		if (ret < 0) {
 			LOG_WRN("close() failed: %d", -errno);
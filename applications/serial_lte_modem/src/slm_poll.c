@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <logging/log.h>
+#include <zephyr.h>
+#include <net/socket.h>
+#include "slm_poll.h"
+
+LOG_MODULE_REGISTER(slm_poll, CONFIG_SLM_LOG_LEVEL);
+
+/* Handlers receive into stack buffers of SLM_MAX_PAYLOAD bytes */
+#define THREAD_STACK_SIZE	KB(4)
+#define THREAD_PRIORITY		K_LOWEST_APPLICATION_THREAD_PRIO
+
+#define SLM_POLL_FD_MAX		8
+/* Registrations made while polling are picked up after this at the latest */
+#define SLM_POLL_TIMEOUT_MS	200
+#define SLM_POLL_ALWAYS		(POLLERR | POLLHUP | POLLNVAL)
+
+static struct slm_poll_entry {
+	int fd;
+	short events;
+	slm_poll_handler_t handler;
+	void *ctx;
+	/* Changed on each registration, so that events polled for a previous
+	 * user of the same descriptor are not dispatched.
+	 */
+	uint32_t gen;
+} entries[SLM_POLL_FD_MAX];
+
+static K_MUTEX_DEFINE(poll_mutex);
+static K_SEM_DEFINE(poll_sem, 0, 1);
+static uint32_t poll_gen;
+
+static struct k_thread poll_thread;
+static K_THREAD_STACK_DEFINE(poll_thread_stack, THREAD_STACK_SIZE);
+static bool poll_thread_started;
+
+static struct slm_poll_entry *entry_find(int fd)
+{
+	for (int i = 0; i < SLM_POLL_FD_MAX; i++) {
+		if (entries[i].handler != NULL && entries[i].fd == fd) {
+			return &entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void poll_thread_fn(void *p1, void *p2, void *p3)
+{
+	struct pollfd fds[SLM_POLL_FD_MAX];
+	uint8_t idx[SLM_POLL_FD_MAX];
+	uint32_t gen[SLM_POLL_FD_MAX];
+	int nfds;
+	int ret;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		nfds = 0;
+		k_mutex_lock(&poll_mutex, K_FOREVER);
+		for (int i = 0; i < SLM_POLL_FD_MAX; i++) {
+			if (entries[i].handler == NULL || entries[i].events == 0) {
+				continue;
+			}
+			fds[nfds].fd = entries[i].fd;
+			fds[nfds].events = entries[i].events;
+			fds[nfds].revents = 0;
+			idx[nfds] = i;
+			gen[nfds] = entries[i].gen;
+			nfds++;
+		}
+		k_mutex_unlock(&poll_mutex);
+
+		if (nfds == 0) {
+			(void)k_sem_take(&poll_sem, K_FOREVER);
+			continue;
+		}
+
+		ret = poll(fds, nfds, SLM_POLL_TIMEOUT_MS);
+		if (ret < 0) {
+			LOG_WRN("poll() error: %d", -errno);
+			k_sleep(K_MSEC(SLM_POLL_TIMEOUT_MS));
+			continue;
+		}
+		if (ret == 0) {
+			continue;
+		}
+
+		for (int i = 0; i < nfds; i++) {
+			struct slm_poll_entry *entry = &entries[idx[i]];
+			short revents;
+
+			if (fds[i].revents == 0) {
+				continue;
+			}
+			LOG_DBG("fd %d events 0x%04x", fds[i].fd, fds[i].revents);
+			/* The mutex is held while the handler runs, so that
+			 * slm_poll_remove() returns only once it is done.
+			 */
+			k_mutex_lock(&poll_mutex, K_FOREVER);
+			revents = fds[i].revents & (entry->events | SLM_POLL_ALWAYS);
+			if (entry->handler != NULL && entry->gen == gen[i] && revents) {
+				entry->handler(entry->fd, revents, entry->ctx);
+			}
+			k_mutex_unlock(&poll_mutex);
+		}
+	}
+}
+
+int slm_poll_add(int fd, short events, slm_poll_handler_t handler, void *ctx)
+{
+	int ret = -ENOMEM;
+
+	if (fd < 0 || handler == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&poll_mutex, K_FOREVER);
+	if (entry_find(fd) != NULL) {
+		ret = -EALREADY;
+		goto exit;
+	}
+	for (int i = 0; i < SLM_POLL_FD_MAX; i++) {
+		if (entries[i].handler == NULL) {
+			entries[i].fd = fd;
+			entries[i].events = events;
+			entries[i].handler = handler;
+			entries[i].ctx = ctx;
+			entries[i].gen = ++poll_gen;
+			ret = 0;
+			break;
+		}
+	}
+exit:
+	k_mutex_unlock(&poll_mutex);
+
+	if (ret == 0) {
+		k_sem_give(&poll_sem);
+	} else {
+		LOG_ERR("Fail to add fd %d: %d", fd, ret);
+	}
+
+	return ret;
+}
+
+int slm_poll_update(int fd, short events)
+{
+	struct slm_poll_entry *entry;
+	int ret = 0;
+
+	k_mutex_lock(&poll_mutex, K_FOREVER);
+	entry = entry_find(fd);
+	if (entry == NULL) {
+		ret = -ENOENT;
+	} else {
+		entry->events = events;
+	}
+	k_mutex_unlock(&poll_mutex);
+
+	if (ret == 0 && events != 0) {
+		k_sem_give(&poll_sem);
+	}
+
+	return ret;
+}
+
+int slm_poll_remove(int fd)
+{
+	struct slm_poll_entry *entry;
+	int ret = 0;
+
+	k_mutex_lock(&poll_mutex, K_FOREVER);
+	entry = entry_find(fd);
+	if (entry == NULL) {
+		ret = -ENOENT;
+	} else {
+		entry->handler = NULL;
+		entry->ctx = NULL;
+		entry->events = 0;
+	}
+	k_mutex_unlock(&poll_mutex);
+
+	return ret;
+}
+
+int slm_poll_init(void)
+{
+	if (poll_thread_started) {
+		return 0;
+	}
+
+	(void)k_thread_create(&poll_thread, poll_thread_stack,
+			      K_THREAD_STACK_SIZEOF(poll_thread_stack),
+			      poll_thread_fn, NULL, NULL, NULL,
+			      THREAD_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&poll_thread, "slm_poll");
+	poll_thread_started = true;
+
+	return 0;
+}
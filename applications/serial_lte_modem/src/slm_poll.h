@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SLM_POLL_
+#define SLM_POLL_
+
+/**@file slm_poll.h
+ *
+ * @brief Socket poll service for serial LTE modem
+ *
+ * One thread polls all registered sockets and calls their handlers when they
+ * are ready, so that modules do not need a thread for each socket.
+ * @{
+ */
+
+#include <zephyr/types.h>
+
+/**@brief Socket event handler type.
+ *
+ * Called from the poll thread. Handlers must not block on the socket. Use
+ * MSG_DONTWAIT when receiving, as the socket may have been replaced by another
+ * one with the same descriptor.
+ *
+ * @param fd Socket descriptor.
+ * @param revents Returned poll events.
+ * @param ctx Context given on registration.
+ */
+typedef void (*slm_poll_handler_t)(int fd, short revents, void *ctx);
+
+/**
+ * @brief Register a socket to the poll service
+ *
+ * @param fd Socket descriptor.
+ * @param events Poll events to wait for. POLLERR, POLLHUP and POLLNVAL are
+ *               always reported.
+ * @param handler Socket event handler.
+ * @param ctx Context passed to the handler.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int slm_poll_add(int fd, short events, slm_poll_handler_t handler, void *ctx);
+
+/**
+ * @brief Change the poll events of a registered socket
+ *
+ * @param fd Socket descriptor.
+ * @param events Poll events to wait for. With 0, the socket is not polled.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int slm_poll_update(int fd, short events);
+
+/**
+ * @brief Unregister a socket from the poll service
+ *
+ * Once this function returns, the handler is not called anymore, and the
+ * socket can be closed.
+ *
+ * @param fd Socket descriptor.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int slm_poll_remove(int fd);
+
+/**
+ * @brief Initialize the poll service
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int slm_poll_init(void);
+
+/** @} */
+
+#endif /* SLM_POLL_ */
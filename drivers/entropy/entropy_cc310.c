@@ -24,18 +24,82 @@
 #include "nrf_cc3xx_platform_ctr_drbg.h"
 #endif
 
+#if defined(CONFIG_HW_CC3XX_JOB_QUEUE)
+#include <drivers/hw_cc310.h>
+#endif
+
 #define CTR_DRBG_MAX_REQUEST 1024
 
-static int entropy_cc3xx_rng_get_entropy(
-	const struct device *dev,
-	uint8_t *buffer,
-	uint16_t length)
+#if defined(CONFIG_HW_CC3XX_JOB_QUEUE) && !defined(CONFIG_SPM) && \
+	!defined(CONFIG_BUILD_WITH_TFM)
+struct ctr_drbg_job_ctx {
+	uint8_t *buffer;
+	size_t length;
+	size_t *olen;
+};
+
+static int ctr_drbg_job_handler(void *ctx)
 {
-	int res = -EINVAL;
+	struct ctr_drbg_job_ctx *job_ctx = ctx;
 
-	__ASSERT_NO_MSG(dev != NULL);
-	__ASSERT_NO_MSG(buffer != NULL);
+	return nrf_cc3xx_platform_ctr_drbg_get(NULL, job_ctx->buffer,
+					       job_ctx->length, job_ctx->olen);
+}
+#endif
+
+#if defined(CONFIG_SPM) && defined(CONFIG_SPM_SERVICE_BATCH)
+/** Requests random data in chunks of CTR_DRBG_MAX_REQUEST bytes, with up to
+ *  CONFIG_SPM_SERVICE_BATCH_MAX_OPS chunks in a single secure call.
+ */
+static int spm_random_number_batch(uint8_t *buffer, size_t length)
+{
+	struct spm_batch_op ops[CONFIG_SPM_SERVICE_BATCH_MAX_OPS];
+	size_t offset = 0;
+	size_t count;
+	int res;
+
+	while (offset < length) {
+		for (count = 0; (count < ARRAY_SIZE(ops)) && (offset < length);
+		     count++) {
+			size_t chunk_size = MIN(length - offset,
+						CTR_DRBG_MAX_REQUEST);
+
+			ops[count].type = SPM_BATCH_OP_RANDOM_NUMBER;
+			ops[count].random_number.output = buffer + offset;
+			ops[count].random_number.len = chunk_size;
+			offset += chunk_size;
+		}
+
+		res = spm_request_batch(ops, count);
+		if (res != 0) {
+			return res;
+		}
 
+		for (size_t i = 0; i < count; i++) {
+			if (ops[i].result != 0) {
+				return ops[i].result;
+			}
+
+			if (ops[i].random_number.olen !=
+			    ops[i].random_number.len) {
+				return -EINVAL;
+			}
+		}
+	}
+
+	return 0;
+}
+#endif
+
+static int entropy_cc3xx_rng_generate(uint8_t *buffer, uint16_t length)
+{
+	int res = -EINVAL;
+
+#if defined(CONFIG_SPM) && defined(CONFIG_SPM_SERVICE_BATCH)
+	if (length > CTR_DRBG_MAX_REQUEST) {
+		return spm_random_number_batch(buffer, length);
+	}
+#endif
 
 #if defined(CONFIG_BUILD_WITH_TFM)
 
@@ -66,6 +130,18 @@ static int entropy_cc3xx_rng_get_entropy(
 			res = spm_request_random_number(buffer + offset,
 								chunk_size,
 								&olen);
+		#elif defined(CONFIG_HW_CC3XX_JOB_QUEUE)
+			/** Same as below, but executed as a TRNG job of the
+			 * CryptoCell job queue.
+			 */
+			struct ctr_drbg_job_ctx job_ctx = {
+				.buffer = buffer + offset,
+				.length = chunk_size,
+				.olen = &olen,
+			};
+
+			res = hw_cc3xx_job_run(HW_CC3XX_JOB_TRNG,
+					       ctr_drbg_job_handler, &job_ctx);
 		#else
 			/** This is a call from a secure app, in which
 			 * case entropy is gathered using CC3xx HW
@@ -95,6 +171,130 @@ static int entropy_cc3xx_rng_get_entropy(
 	return res;
 }
 
+#if defined(CONFIG_ENTROPY_CC3XX_POOL)
+
+/* Number of bytes generated by the refill thread in a single request. In
+ * non-secure firmware the pool is refilled with a single request, to save
+ * transitions to the Secure Firmware.
+ */
+#if defined(CONFIG_SPM)
+#define POOL_REFILL_CHUNK CONFIG_ENTROPY_CC3XX_POOL_SIZE
+#else
+#define POOL_REFILL_CHUNK 64
+#endif
+
+BUILD_ASSERT(CONFIG_ENTROPY_CC3XX_POOL_REFILL_THRESHOLD <
+	     CONFIG_ENTROPY_CC3XX_POOL_SIZE,
+	     "Pool refill threshold must be lower than pool size");
+
+/* Pool of pre-generated random data. Bytes are taken from the end of the
+ * pool and cleared after use.
+ */
+static uint8_t pool[CONFIG_ENTROPY_CC3XX_POOL_SIZE];
+static size_t pool_len;
+static struct k_spinlock pool_lock;
+static K_SEM_DEFINE(pool_refill_sem, 1, 1);
+
+static size_t pool_get(uint8_t *buffer, size_t length)
+{
+	k_spinlock_key_t key = k_spin_lock(&pool_lock);
+	size_t len = MIN(length, pool_len);
+
+	pool_len -= len;
+	memcpy(buffer, &pool[pool_len], len);
+	memset(&pool[pool_len], 0, len);
+
+	if (pool_len <= CONFIG_ENTROPY_CC3XX_POOL_REFILL_THRESHOLD) {
+		k_sem_give(&pool_refill_sem);
+	}
+
+	k_spin_unlock(&pool_lock, key);
+
+	return len;
+}
+
+static void pool_refill_thread_fn(void)
+{
+	static uint8_t chunk[POOL_REFILL_CHUNK];
+	k_spinlock_key_t key;
+	size_t len;
+	size_t space;
+
+	while (true) {
+		k_sem_take(&pool_refill_sem, K_FOREVER);
+
+		do {
+			key = k_spin_lock(&pool_lock);
+			space = sizeof(pool) - pool_len;
+			k_spin_unlock(&pool_lock, key);
+
+			len = MIN(space, sizeof(chunk));
+			if (len == 0) {
+				break;
+			}
+
+			if (entropy_cc3xx_rng_generate(chunk, len) != 0) {
+				break;
+			}
+
+			/* Pool may only have shrunk while generating. */
+			key = k_spin_lock(&pool_lock);
+			memcpy(&pool[pool_len], chunk, len);
+			pool_len += len;
+			k_spin_unlock(&pool_lock, key);
+		} while (len == sizeof(chunk));
+
+		memset(chunk, 0, sizeof(chunk));
+	}
+}
+
+K_THREAD_DEFINE(entropy_cc3xx_pool_thread,
+		CONFIG_ENTROPY_CC3XX_POOL_THREAD_STACK_SIZE,
+		pool_refill_thread_fn, NULL, NULL, NULL,
+		CONFIG_ENTROPY_CC3XX_POOL_THREAD_PRIORITY, 0, 0);
+
+#endif /* CONFIG_ENTROPY_CC3XX_POOL */
+
+static int entropy_cc3xx_rng_get_entropy(
+	const struct device *dev,
+	uint8_t *buffer,
+	uint16_t length)
+{
+	__ASSERT_NO_MSG(dev != NULL);
+	__ASSERT_NO_MSG(buffer != NULL);
+
+#if defined(CONFIG_ENTROPY_CC3XX_POOL)
+	size_t len = pool_get(buffer, length);
+
+	if (len == length) {
+		return 0;
+	}
+
+	/* Pool exhausted, generate the rest synchronously. */
+	buffer += len;
+	length -= len;
+#endif
+
+	return entropy_cc3xx_rng_generate(buffer, length);
+}
+
+#if defined(CONFIG_ENTROPY_CC3XX_POOL)
+static int entropy_cc3xx_rng_get_entropy_isr(
+	const struct device *dev,
+	uint8_t *buffer,
+	uint16_t length,
+	uint32_t flags)
+{
+	__ASSERT_NO_MSG(dev != NULL);
+	__ASSERT_NO_MSG(buffer != NULL);
+
+	/* Random data can be generated only in thread context, so only the
+	 * pool is used regardless of ENTROPY_BUSYWAIT flag.
+	 */
+	return pool_get(buffer, length);
+}
+#endif
+
 static int entropy_cc3xx_rng_init(const struct device *dev)
 {
 	(void)dev;
@@ -123,7 +323,10 @@ static int entropy_cc3xx_rng_init(const struct device *dev)
 }
 
 static const struct entropy_driver_api entropy_cc3xx_rng_api = {
-	.get_entropy = entropy_cc3xx_rng_get_entropy
+	.get_entropy = entropy_cc3xx_rng_get_entropy,
+#if defined(CONFIG_ENTROPY_CC3XX_POOL)
+	.get_entropy_isr = entropy_cc3xx_rng_get_entropy_isr,
+#endif
 };
 
 #if DT_NODE_HAS_STATUS(DT_NODELABEL(cryptocell), okay)
@@ -55,6 +55,13 @@ struct gps_drv_data {
 	struct k_work error_work;
 	struct k_work_delayable timeout_work;
 	struct k_work_delayable blocked_work;
+#if defined(CONFIG_NRF9160_GPS_FIX_BATCH)
+	struct k_mutex batch_lock;
+	struct k_work_delayable batch_work;
+	struct gps_pvt batch[CONFIG_NRF9160_GPS_FIX_BATCH_SIZE];
+	size_t batch_count;
+	uint32_t batch_fix_count;
+#endif
 };
 
 /* Struct for an event item. The data is read in the GNSS event handler and passed as a part of the
@@ -250,8 +257,74 @@ static void cancel_works(struct gps_drv_data *drv_data)
 {
 	k_work_cancel_delayable(&drv_data->timeout_work);
 	k_work_cancel_delayable(&drv_data->blocked_work);
+#if defined(CONFIG_NRF9160_GPS_FIX_BATCH)
+	k_work_cancel_delayable(&drv_data->batch_work);
+#endif
 }
 
+#if defined(CONFIG_NRF9160_GPS_FIX_BATCH)
+/* Must be called with the batch lock held. */
+static void batch_flush(const struct device *dev)
+{
+	struct gps_drv_data *drv_data = dev->data;
+	struct gps_event evt = {
+		.type = GPS_EVT_PVT_FIX_BATCH,
+		.pvt_batch = {
+			.fixes = drv_data->batch,
+			.count = drv_data->batch_count,
+		},
+	};
+
+	k_work_cancel_delayable(&drv_data->batch_work);
+
+	if (drv_data->batch_count == 0) {
+		return;
+	}
+
+	LOG_DBG("Delivering %d position fixes", drv_data->batch_count);
+
+	notify_event(dev, &evt);
+	drv_data->batch_count = 0;
+}
+
+static void batch_add(const struct device *dev, const struct gps_pvt *pvt)
+{
+	struct gps_drv_data *drv_data = dev->data;
+
+	k_mutex_lock(&drv_data->batch_lock, K_FOREVER);
+
+	/* Decimation: only every Nth fix is kept. */
+	if (drv_data->batch_fix_count++ % CONFIG_NRF9160_GPS_FIX_BATCH_DECIMATION) {
+		goto unlock;
+	}
+
+	drv_data->batch[drv_data->batch_count++] = *pvt;
+
+	if (drv_data->batch_count == ARRAY_SIZE(drv_data->batch)) {
+		batch_flush(dev);
+	} else if ((drv_data->batch_count == 1) &&
+		   (CONFIG_NRF9160_GPS_FIX_BATCH_TIMEOUT_SEC > 0)) {
+		/* The time window starts from the oldest fix in the batch. */
+		k_work_schedule(&drv_data->batch_work,
+				K_SECONDS(CONFIG_NRF9160_GPS_FIX_BATCH_TIMEOUT_SEC));
+	}
+
+unlock:
+	k_mutex_unlock(&drv_data->batch_lock);
+}
+
+static void batch_work_fn(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct gps_drv_data *drv_data =
+		CONTAINER_OF(dwork, struct gps_drv_data, batch_work);
+
+	k_mutex_lock(&drv_data->batch_lock, K_FOREVER);
+	batch_flush(drv_data->dev);
+	k_mutex_unlock(&drv_data->batch_lock);
+}
+#endif /* CONFIG_NRF9160_GPS_FIX_BATCH */
+
 static void gps_thread(int dev_ptr)
 {
 	struct device *dev = INT_TO_POINTER(dev_ptr);
@@ -346,7 +419,16 @@ static void gps_thread(int dev_ptr)
 				atomic_set(&drv_data->fix_valid, 0);
 			}
 
+#if defined(CONFIG_NRF9160_GPS_FIX_BATCH)
+			/* In batch mode, PVT data is only delivered as part of
+			 * a batch of fixes.
+			 */
+			if (evt.type == GPS_EVT_PVT_FIX) {
+				batch_add(dev, &evt.pvt);
+			}
+#else
 			notify_event(dev, &evt);
+#endif
 			print_satellite_stats(pvt_data);
 			break;
 		case NRF_MODEM_GNSS_EVT_NMEA:
@@ -604,6 +686,13 @@ static void stop_work_fn(struct k_work *work)
 		.type = GPS_EVT_SEARCH_STOPPED
 	};
 
+#if defined(CONFIG_NRF9160_GPS_FIX_BATCH)
+	/* Fixes obtained before stopping are delivered first. */
+	k_mutex_lock(&drv_data->batch_lock, K_FOREVER);
+	batch_flush(dev);
+	k_mutex_unlock(&drv_data->batch_lock);
+#endif
+
 	notify_event(dev, &evt);
 }
 
@@ -702,6 +791,10 @@ static int init(const struct device *dev, gps_event_handler_t handler)
 	k_work_init(&drv_data->error_work, error_work_fn);
 	k_work_init_delayable(&drv_data->timeout_work, timeout_work_fn);
 	k_work_init_delayable(&drv_data->blocked_work, blocked_work_fn);
+#if defined(CONFIG_NRF9160_GPS_FIX_BATCH)
+	k_mutex_init(&drv_data->batch_lock);
+	k_work_init_delayable(&drv_data->batch_work, batch_work_fn);
+#endif
 
 	atomic_set(&drv_data->is_init, 1);
 	atomic_set(&drv_data->is_running, 0);
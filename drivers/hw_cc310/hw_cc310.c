@@ -14,6 +14,7 @@
 #include <device.h>
 
 #include <nrf_cc3xx_platform.h>
+#include <drivers/hw_cc310.h>
 
 #if CONFIG_HW_CC3XX
 
@@ -56,6 +57,184 @@ SYS_INIT(hw_cc3xx_init_internal, PRE_KERNEL_1,
 SYS_INIT(hw_cc3xx_init, POST_KERNEL,
 	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
 
+#if CONFIG_HW_CC3XX_JOB_QUEUE
+
+static sys_slist_t job_queue = SYS_SLIST_STATIC_INIT(&job_queue);
+static struct k_spinlock job_lock;
+static K_SEM_DEFINE(job_sem, 0, 1);
+static struct hw_cc3xx_job_stats job_stats[HW_CC3XX_JOB_TYPE_COUNT];
+static enum hw_cc3xx_job_type batch_type;
+static size_t batch_cnt;
+static k_tid_t job_thread_id;
+
+static uint32_t cycles_to_us(uint32_t cycles)
+{
+	return (uint32_t)k_cyc_to_us_floor64(cycles);
+}
+
+void hw_cc3xx_job_init(struct hw_cc3xx_job *job, enum hw_cc3xx_job_type type,
+		       hw_cc3xx_job_handler_t handler, void *ctx)
+{
+	k_sem_init(&job->done, 0, 1);
+	job->type = type;
+	job->handler = handler;
+	job->ctx = ctx;
+	job->result = 0;
+	job->wait_us = 0;
+	job->exec_us = 0;
+}
+
+int hw_cc3xx_job_submit(struct hw_cc3xx_job *job)
+{
+	k_spinlock_key_t key;
+
+	if ((job->handler == NULL) || (job->type >= HW_CC3XX_JOB_TYPE_COUNT)) {
+		return -EINVAL;
+	}
+
+	job->submit_cycles = k_cycle_get_32();
+
+	key = k_spin_lock(&job_lock);
+	sys_slist_append(&job_queue, &job->node);
+	k_spin_unlock(&job_lock, key);
+
+	k_sem_give(&job_sem);
+
+	return 0;
+}
+
+int hw_cc3xx_job_wait(struct hw_cc3xx_job *job, k_timeout_t timeout)
+{
+	return k_sem_take(&job->done, timeout);
+}
+
+/* Takes next job from the queue. Jobs of the same type as the previous one
+ * are preferred, up to the batch limit, to avoid switching between hash,
+ * AES and TRNG contexts.
+ */
+static struct hw_cc3xx_job *job_get(void)
+{
+	struct hw_cc3xx_job *job = NULL;
+	struct hw_cc3xx_job *item;
+	sys_snode_t *prev = NULL;
+	sys_snode_t *prev_item = NULL;
+	k_spinlock_key_t key = k_spin_lock(&job_lock);
+
+	if (batch_cnt < CONFIG_HW_CC3XX_JOB_BATCH_MAX) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&job_queue, item, node) {
+			if (item->type == batch_type) {
+				job = item;
+				prev = prev_item;
+				break;
+			}
+			prev_item = &item->node;
+		}
+	}
+
+	if (job == NULL) {
+		job = SYS_SLIST_PEEK_HEAD_CONTAINER(&job_queue, job, node);
+		prev = NULL;
+	}
+
+	if (job != NULL) {
+		sys_slist_remove(&job_queue, prev, &job->node);
+
+		if (job->type == batch_type) {
+			batch_cnt++;
+		} else {
+			batch_type = job->type;
+			batch_cnt = 1;
+		}
+	}
+
+	k_spin_unlock(&job_lock, key);
+
+	return job;
+}
+
+static void job_execute(struct hw_cc3xx_job *job)
+{
+	struct hw_cc3xx_job_stats *stats = &job_stats[job->type];
+	uint32_t start = k_cycle_get_32();
+	k_spinlock_key_t key;
+
+	job->wait_us = cycles_to_us(start - job->submit_cycles);
+	job->result = job->handler(job->ctx);
+	job->exec_us = cycles_to_us(k_cycle_get_32() - start);
+
+	key = k_spin_lock(&job_lock);
+	stats->count++;
+	stats->wait_us += job->wait_us;
+	stats->wait_max_us = MAX(stats->wait_max_us, job->wait_us);
+	stats->exec_us += job->exec_us;
+	stats->exec_max_us = MAX(stats->exec_max_us, job->exec_us);
+	k_spin_unlock(&job_lock, key);
+
+	k_sem_give(&job->done);
+}
+
+int hw_cc3xx_job_run(enum hw_cc3xx_job_type type,
+		     hw_cc3xx_job_handler_t handler, void *ctx)
+{
+	struct hw_cc3xx_job job;
+	int err;
+
+	hw_cc3xx_job_init(&job, type, handler, ctx);
+
+	if (k_is_pre_kernel() || (k_current_get() == job_thread_id)) {
+		/* Queue is not processed, execute in place. */
+		job.submit_cycles = k_cycle_get_32();
+		job_execute(&job);
+		return job.result;
+	}
+
+	err = hw_cc3xx_job_submit(&job);
+	if (err) {
+		return err;
+	}
+
+	(void)hw_cc3xx_job_wait(&job, K_FOREVER);
+
+	return job.result;
+}
+
+int hw_cc3xx_job_stats_get(enum hw_cc3xx_job_type type,
+			   struct hw_cc3xx_job_stats *stats)
+{
+	k_spinlock_key_t key;
+
+	if (type >= HW_CC3XX_JOB_TYPE_COUNT) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&job_lock);
+	*stats = job_stats[type];
+	k_spin_unlock(&job_lock, key);
+
+	return 0;
+}
+
+static void job_thread_fn(void)
+{
+	struct hw_cc3xx_job *job;
+
+	job_thread_id = k_current_get();
+
+	while (true) {
+		k_sem_take(&job_sem, K_FOREVER);
+
+		while ((job = job_get()) != NULL) {
+			job_execute(job);
+		}
+	}
+}
+
+K_THREAD_DEFINE(hw_cc3xx_job_thread, CONFIG_HW_CC3XX_JOB_QUEUE_STACK_SIZE,
+		job_thread_fn, NULL, NULL, NULL,
+		CONFIG_HW_CC3XX_JOB_QUEUE_PRIORITY, 0, 0);
+
+#endif /* CONFIG_HW_CC3XX_JOB_QUEUE */
+
 #endif /* CONFIG_HW_CC3XX */
 
 #if CONFIG_HW_CC3XX_INTERRUPT
@@ -42,6 +42,11 @@ struct mpsl_context {
 	int status; /* Return value for nrf_flash_sync_exe(). */
 	/* Indicate timeout condition to the timeslot callback. */
 	atomic_t timeout_occured;
+	/* Time in the timeslot at which the current slice started. */
+	uint32_t slice_start_us;
+	/* Statistics for the current flash operation. */
+	uint32_t timeslot_count;
+	uint32_t extension_count;
 };
 
 static struct mpsl_context _context;
@@ -69,10 +74,44 @@ static void reschedule_next_timeslot(void)
 		      "mpsl_timeslot_request failed: %d", ret);
 }
 
+static void request_next_timeslot(void)
+{
+	/* Reset the priority back to normal after a successful timeslot. */
+	_context.timeslot_request.params.earliest.priority =
+		MPSL_TIMESLOT_PRIORITY_NORMAL;
+
+	_context.return_param.callback_action =
+		MPSL_TIMESLOT_SIGNAL_ACTION_REQUEST;
+	_context.return_param.params.request.p_next =
+		&_context.timeslot_request;
+}
+
+/* Run one slice of the flash operation. If it is not done, try to extend the
+ * timeslot for the next slice. The extension is only granted if it does not
+ * collide with other activity, such as radio events, so as many slices as
+ * fit in the gap between them are run in one timeslot.
+ */
+static void slice_run(void)
+{
+	int rc = _context.op_desc->handler(_context.op_desc->context);
+
+	if (rc != FLASH_OP_ONGOING) {
+		_context.status = (rc == FLASH_OP_DONE) ? 0 : rc;
+		_context.return_param.callback_action =
+			MPSL_TIMESLOT_SIGNAL_ACTION_END;
+	} else if (IS_ENABLED(CONFIG_SOC_FLASH_NRF_RADIO_SYNC_MPSL_TIMESLOT_EXTEND)) {
+		_context.return_param.callback_action =
+			MPSL_TIMESLOT_SIGNAL_ACTION_EXTEND;
+		_context.return_param.params.extend.length_us =
+			_context.request_length_us + TIMESLOT_LENGTH_SLACK_US;
+	} else {
+		request_next_timeslot();
+	}
+}
+
 static mpsl_timeslot_signal_return_param_t *
 timeslot_callback(mpsl_timeslot_session_id_t session_id, uint32_t signal)
 {
-	int rc;
 	__ASSERT_NO_MSG(session_id == _context.session_id);
 
 	if (atomic_get(&_context.timeout_occured)) {
@@ -81,23 +120,18 @@ timeslot_callback(mpsl_timeslot_session_id_t session_id, uint32_t signal)
 
 	switch (signal) {
 	case MPSL_TIMESLOT_SIGNAL_START:
-		rc = _context.op_desc->handler(_context.op_desc->context);
-		if (rc != FLASH_OP_ONGOING) {
-			_context.status = (rc == FLASH_OP_DONE) ? 0 : rc;
-			_context.return_param.callback_action =
-				MPSL_TIMESLOT_SIGNAL_ACTION_END;
-		} else {
-			/* Reset the priority back to normal after a successful
-			 * timeslot. */
-			_context.timeslot_request.params.earliest.priority =
-				MPSL_TIMESLOT_PRIORITY_NORMAL;
-
-			_context.return_param.callback_action =
-				MPSL_TIMESLOT_SIGNAL_ACTION_REQUEST;
-			_context.return_param.params.request.p_next =
-				&_context.timeslot_request;
-		}
+		_context.timeslot_count++;
+		slice_run();
+		break;
 
+	case MPSL_TIMESLOT_SIGNAL_EXTEND_SUCCEEDED:
+		_context.extension_count++;
+		slice_run();
+		break;
+
+	case MPSL_TIMESLOT_SIGNAL_EXTEND_FAILED:
+		/* Something else is scheduled, continue in a new timeslot. */
+		request_next_timeslot();
 		break;
 
 	case MPSL_TIMESLOT_SIGNAL_SESSION_IDLE:
@@ -164,8 +198,12 @@ int nrf_flash_sync_exe(struct flash_op_desc *op_desc)
 
 	_context.op_desc = op_desc;
 	_context.status = -ETIMEDOUT;
+	_context.timeslot_count = 0;
+	_context.extension_count = 0;
 	atomic_clear(&_context.timeout_occured);
 
+	uint32_t start_ms = k_uptime_get_32();
+
 	__ASSERT_NO_MSG(k_sem_count_get(&_context.timeout_sem) == 0);
 
 	errcode = MULTITHREADING_LOCK_ACQUIRE();
@@ -192,17 +230,24 @@ int nrf_flash_sync_exe(struct flash_op_desc *op_desc)
 		k_sem_reset(&_context.timeout_sem);
 	}
 
+	LOG_DBG("status: %d, %u ms, %u timeslots, %u extensions",
+		_context.status, k_uptime_get_32() - start_ms,
+		_context.timeslot_count, _context.extension_count);
+
 	return _context.status;
 }
 
 void nrf_flash_sync_get_timestamp_begin(void)
 {
-	/* Not needed for this driver. */
+	/* A timeslot may be extended, so slices do not always start at the
+	 * beginning of the timeslot.
+	 */
+	_context.slice_start_us = get_timeslot_time_us();
 }
 
 bool nrf_flash_sync_check_time_limit(uint32_t iteration)
 {
-	uint32_t now_us = get_timeslot_time_us();
+	uint32_t now_us = get_timeslot_time_us() - _context.slice_start_us;
 	uint32_t time_per_iteration_us = now_us / iteration;
 	return now_us + time_per_iteration_us >= _context.request_length_us;
 }
@@ -36,6 +36,7 @@
 LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 #include <stdio.h>
+#include <string.h>
 #include <kernel.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -70,6 +71,24 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #define ACTIVE_POLL_COUNT (CONFIG_ETH_POLL_PERIOD_MS / \
 			   CONFIG_ETH_POLL_ACTIVE_PERIOD_MS)
 
+/** Poll period used when transfer is running (in microseconds). */
+#define ACTIVE_POLL_PERIOD_US (CONFIG_ETH_POLL_ACTIVE_PERIOD_MS * 1000)
+
+/** Number of bytes read in a single poll above which the poll period is
+ *  shortened. Below a quarter of it, the poll period is extended again.
+ */
+#define POLL_HIGH_WATERMARK (CONFIG_ETH_RTT_DOWN_BUFFER_SIZE / 2)
+
+/** Repeats byte in every byte of a 32-bit word. */
+#define WORD_REPEAT(byte) (0x01010101u * (uint8_t)(byte))
+
+/** Checks if any byte of a 32-bit word is zero. */
+#define WORD_HAS_ZERO(word) \
+	(((word) - WORD_REPEAT(0x01)) & ~(word) & WORD_REPEAT(0x80))
+
+/** Checks if any byte of a 32-bit word is equal to the given byte. */
+#define WORD_HAS_BYTE(word, byte) WORD_HAS_ZERO((word) ^ WORD_REPEAT(byte))
+
 BUILD_ASSERT(CONFIG_ETH_RTT_CHANNEL < SEGGER_RTT_MAX_NUM_UP_BUFFERS,
 		 "RTT channel number used in RTT network driver "
 		 "must be lower than SEGGER_RTT_MAX_NUM_UP_BUFFERS");
@@ -88,6 +107,14 @@ struct eth_rtt_context {
 	 */
 	uint16_t active_poll_counter;
 
+	/** Current poll period when transfer is running (in microseconds). It
+	 *  is shortened when a lot of data is read in a single poll.
+	 */
+	uint32_t active_poll_period_us;
+
+	/** Last byte received from RTT was SLIP_ESC. */
+	bool rx_escape;
+
 	/** CRC of currently sending frame to RTT. */
 	uint16_t crc;
 
@@ -104,6 +131,14 @@ struct eth_rtt_context {
 	/** Number of bytes currently occupied in rx_buffer. */
 	size_t rx_buffer_length;
 
+	/** Buffer that collects SLIP encoded data of currently sending frame,
+	 *  so it can be passed to RTT with a single write.
+	 */
+	uint8_t tx_buffer[CONFIG_ETH_RTT_TX_BUFFER_SIZE];
+
+	/** Number of bytes currently occupied in tx_buffer. */
+	size_t tx_buffer_length;
+
 	/** Up buffer used by RTT library */
 	uint8_t rtt_up_buffer[CONFIG_ETH_RTT_UP_BUFFER_SIZE];
 
@@ -163,8 +198,73 @@ static void dbg_hex_dump_end(const char *prefix)
 	}
 }
 
+/** Finds first SLIP_END or SLIP_ESC byte. Data is scanned a word at a time.
+ *  @param ptr   Points data to scan.
+ *  @param end   Points end of data to scan.
+ *  @return Pointer to the first special byte or @a end if there is none.
+ */
+static const uint8_t *slip_find_special(const uint8_t *ptr, const uint8_t *end)
+{
+	while ((size_t)(end - ptr) >= sizeof(uint32_t)) {
+		uint32_t word = UNALIGNED_GET((const uint32_t *)ptr);
+
+		if (WORD_HAS_BYTE(word, SLIP_END) ||
+		    WORD_HAS_BYTE(word, SLIP_ESC)) {
+			break;
+		}
+		ptr += sizeof(uint32_t);
+	}
+
+	while (ptr < end && *ptr != SLIP_END && *ptr != SLIP_ESC) {
+		ptr++;
+	}
+
+	return ptr;
+}
+
 /*********** OUTPUT PART OF THE DRIVER (from network stack to RTT) ***********/
 
+/** Writes contents of the transmit buffer to RTT up channel with a single
+ *  RTT write call and empties the buffer.
+ *  @param context   Driver context.
+ */
+static void rtt_send_flush(struct eth_rtt_context *context)
+{
+	if (context->tx_buffer_length > 0) {
+		SEGGER_RTT_Write(CONFIG_ETH_RTT_CHANNEL, context->tx_buffer,
+				 context->tx_buffer_length);
+		dbg_hex_dump("RTT<", context->tx_buffer,
+			     context->tx_buffer_length);
+		context->tx_buffer_length = 0;
+	}
+}
+
+/** Puts data into the transmit buffer. Buffer is flushed to RTT when it gets
+ *  full.
+ *  @param context   Driver context.
+ *  @param ptr       Points data to put.
+ *  @param len       Number of bytes to put.
+ */
+static void rtt_send_raw(struct eth_rtt_context *context, const uint8_t *ptr,
+			 size_t len)
+{
+	while (len > 0) {
+		size_t space = sizeof(context->tx_buffer) -
+			       context->tx_buffer_length;
+		size_t chunk = MIN(len, space);
+
+		memcpy(&context->tx_buffer[context->tx_buffer_length], ptr,
+		       chunk);
+		context->tx_buffer_length += chunk;
+		ptr += chunk;
+		len -= chunk;
+
+		if (context->tx_buffer_length == sizeof(context->tx_buffer)) {
+			rtt_send_flush(context);
+		}
+	}
+}
+
 /** Sends start of frame (SLIP_END) to RTT up channel.
  *  @param context   Driver context.
  */
@@ -172,13 +272,13 @@ static void rtt_send_begin(struct eth_rtt_context *context)
 {
 	uint8_t data = SLIP_END;
 
-	SEGGER_RTT_Write(CONFIG_ETH_RTT_CHANNEL, &data, sizeof(data));
 	dbg_hex_dump_begin("RTT<");
-	dbg_hex_dump("RTT<", &data, sizeof(data));
+	rtt_send_raw(context, &data, sizeof(data));
 	context->crc = 0xFFFF;
 }
 
-/** Encodes fragment of frame using SLIP and sends it to RTT up channel.
+/** Encodes fragment of frame using SLIP and puts it into the transmit buffer.
+ *  Data between special bytes is copied in bulk.
  *  @param context   Driver context.
  *  @param ptr       Points data to send.
  *  @param len       Number of bytes to send.
@@ -189,45 +289,28 @@ static void rtt_send_fragment(struct eth_rtt_context *context, const uint8_t *pt
 	static const uint8_t end_stuffed[2] = { SLIP_ESC, SLIP_ESC_END };
 	static const uint8_t esc_stuffed[2] = { SLIP_ESC, SLIP_ESC_ESC };
 	const uint8_t *end = ptr + len;
-	const uint8_t *plain_begin = ptr;
+	const uint8_t *special;
 
 	context->crc = crc16_ccitt(context->crc, ptr, len);
 
-	for (; ptr < end; ptr++) {
-		if (*ptr == SLIP_END || *ptr == SLIP_ESC) {
-			if (ptr > plain_begin) {
-				SEGGER_RTT_Write(CONFIG_ETH_RTT_CHANNEL,
-						 plain_begin,
-						 ptr - plain_begin);
-				dbg_hex_dump("RTT<", plain_begin,
-					     ptr - plain_begin);
-			}
-
-			if (*ptr == SLIP_END) {
-				SEGGER_RTT_Write(CONFIG_ETH_RTT_CHANNEL,
-						 end_stuffed,
-						 sizeof(end_stuffed));
-				dbg_hex_dump("RTT<", end_stuffed,
-					     sizeof(end_stuffed));
-			} else if (*ptr == SLIP_ESC) {
-				SEGGER_RTT_Write(CONFIG_ETH_RTT_CHANNEL,
-						 esc_stuffed,
-						 sizeof(esc_stuffed));
-				dbg_hex_dump("RTT<", esc_stuffed,
-					     sizeof(esc_stuffed));
-			}
-			plain_begin = ptr + 1;
+	while (ptr < end) {
+		special = slip_find_special(ptr, end);
+		rtt_send_raw(context, ptr, special - ptr);
+		if (special == end) {
+			break;
 		}
-	}
 
-	if (ptr > plain_begin) {
-		SEGGER_RTT_Write(CONFIG_ETH_RTT_CHANNEL, plain_begin,
-				 ptr - plain_begin);
-		dbg_hex_dump("RTT<", plain_begin, ptr - plain_begin);
+		if (*special == SLIP_END) {
+			rtt_send_raw(context, end_stuffed, sizeof(end_stuffed));
+		} else {
+			rtt_send_raw(context, esc_stuffed, sizeof(esc_stuffed));
+		}
+		ptr = special + 1;
 	}
 }
 
-/** Sends end of frame (SLIP_END) to RTT up channel.
+/** Sends end of frame (SLIP_END) to RTT up channel. Remaining content of the
+ *  transmit buffer is written to RTT.
  *  @param context   Driver context.
  */
 static void rtt_send_end(struct eth_rtt_context *context)
@@ -236,8 +319,8 @@ static void rtt_send_end(struct eth_rtt_context *context)
 	uint8_t data = SLIP_END;
 
 	rtt_send_fragment(context, crc_buffer, sizeof(crc_buffer));
-	SEGGER_RTT_Write(CONFIG_ETH_RTT_CHANNEL, &data, sizeof(data));
-	dbg_hex_dump("RTT<", &data, sizeof(data));
+	rtt_send_raw(context, &data, sizeof(data));
+	rtt_send_flush(context);
 	dbg_hex_dump_end("RTT<");
 }
 
@@ -366,10 +449,10 @@ static void recv_frame(struct eth_rtt_context *context, const uint8_t *data,
 /** Functions decodes SLIP data and passes each decoded frame to recv_frame
  *  function. It decodes data from rx_buffer that were recently added to it,
  *  i.e. decoding starts at rx_buffer_length. Decoding is done inplace, so
- *  decoded data are written back to the rx_buffer. If there is unfinished
- *  frame left then it will be moved to the beginning of the rx_buffer and
- *  rx_buffer_length will be updated accordingly. Otherwise rx_buffer will be
- *  cleared.
+ *  decoded data are written back to the rx_buffer. Data between special bytes
+ *  is moved in bulk. If there is unfinished frame left then it will be moved
+ *  to the beginning of the rx_buffer and rx_buffer_length will be updated
+ *  accordingly. Otherwise rx_buffer will be cleared.
  *  @param context        Driver context.
  *  @param new_data_size  Number of bytes that have to be decoded.
  */
@@ -380,24 +463,43 @@ static void decode_new_slip_data(struct eth_rtt_context *context,
 	uint8_t *dst = &context->rx_buffer[context->rx_buffer_length];
 	uint8_t *end = src + new_data_size;
 	uint8_t *start = context->rx_buffer;
-	uint8_t last_byte = context->rx_buffer_length > 0 ? dst[-1] : 0;
+	const uint8_t *special;
+	size_t len;
 
 	while (src < end) {
-		uint8_t byte = *src++;
-		*dst++ = byte;
-		if (byte == SLIP_END) {
-			recv_frame(context, start, dst - start - 1);
-			start = dst;
-		} else if (last_byte == SLIP_ESC) {
-			if (byte == SLIP_ESC_END) {
-				dst--;
-				dst[-1] = SLIP_END;
-			} else if (byte == SLIP_ESC_ESC) {
-				dst--;
-				dst[-1] = SLIP_ESC;
+		if (context->rx_escape) {
+			context->rx_escape = false;
+			if (*src == SLIP_ESC_END) {
+				*dst++ = SLIP_END;
+				src++;
+			} else if (*src == SLIP_ESC_ESC) {
+				*dst++ = SLIP_ESC;
+				src++;
+			} else {
+				/* Invalid sequence, keep the escape byte. */
+				*dst++ = SLIP_ESC;
 			}
+			continue;
+		}
+
+		special = slip_find_special(src, end);
+		len = special - src;
+		if (dst != src) {
+			memmove(dst, src, len);
+		}
+		dst += len;
+		src += len;
+
+		if (src == end) {
+			break;
+		}
+
+		if (*src++ == SLIP_END) {
+			recv_frame(context, start, dst - start);
+			start = dst;
+		} else {
+			context->rx_escape = true;
 		}
-		last_byte = byte;
 	}
 
 	context->rx_buffer_length = dst - start;
@@ -412,12 +514,14 @@ static struct k_work_delayable eth_rtt_poll_work;
 
 /** Work handler that is submitted to system workqueue by the poll timer.
  *  It is responsible for reading all available data from RTT down buffer.
+ *  Poll period is adapted to the amount of data read, so it gets shorter
+ *  when transfer is running and longer when transfer stops.
  */
 static void poll_work_handler(struct k_work *work)
 {
 	struct eth_rtt_context *context = &context_data;
-	bool active = false;
 	k_timeout_t period = K_MSEC(CONFIG_ETH_POLL_PERIOD_MS);
+	size_t total = 0;
 	unsigned num;
 
 	do {
@@ -425,6 +529,7 @@ static void poll_work_handler(struct k_work *work)
 			LOG_ERR("RX buffer overflow. "
 				"Discarding buffer contents.\n");
 			context->rx_buffer_length = 0;
+			context->rx_escape = false;
 		}
 		num = SEGGER_RTT_Read(CONFIG_ETH_RTT_CHANNEL,
 			&context->rx_buffer[context->rx_buffer_length],
@@ -434,13 +539,24 @@ static void poll_work_handler(struct k_work *work)
 				&context->rx_buffer[context->rx_buffer_length],
 				num);
 			decode_new_slip_data(context, num);
-			active = true;
+			total += num;
 		}
 	} while (num > 0);
 
-	if (active) {
+	if (total > 0) {
+		if (context->active_poll_counter == 0) {
+			context->active_poll_period_us = ACTIVE_POLL_PERIOD_US;
+		} else if (total >= POLL_HIGH_WATERMARK) {
+			context->active_poll_period_us /= 2;
+		} else if (total < POLL_HIGH_WATERMARK / 2) {
+			context->active_poll_period_us *= 2;
+		}
+		context->active_poll_period_us =
+			MAX(MIN(context->active_poll_period_us,
+				ACTIVE_POLL_PERIOD_US),
+			    k_ticks_to_us_ceil32(1));
 		context->active_poll_counter = ACTIVE_POLL_COUNT;
-		period = K_MSEC(CONFIG_ETH_POLL_ACTIVE_PERIOD_MS);
+		period = K_USEC(context->active_poll_period_us);
 	} else if (context->active_poll_counter > 0) {
 		context->active_poll_counter--;
 		period = K_MSEC(CONFIG_ETH_POLL_ACTIVE_PERIOD_MS);
@@ -469,6 +585,7 @@ static void eth_iface_init(struct net_if *iface)
 	context->init_done = true;
 	context->iface = iface;
 	context->active_poll_counter = 0;
+	context->active_poll_period_us = ACTIVE_POLL_PERIOD_US;
 
 #if defined(CONFIG_ETH_RTT_MAC_ADDR)
 	if (CONFIG_ETH_RTT_MAC_ADDR[0] != 0) {
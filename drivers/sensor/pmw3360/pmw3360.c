@@ -675,23 +675,7 @@ static int pmw3360_async_init_fw_load_verify(struct pmw3360_data *dev_data)
 	return err;
 }
 
-static void irq_handler(const struct device *gpiob, struct gpio_callback *cb,
-			uint32_t pins)
-{
-	int err;
-
-	err = gpio_pin_interrupt_configure(pmw3360_data.irq_gpio_dev,
-					   PMW3360_IRQ_GPIO_PIN,
-					   GPIO_INT_DISABLE);
-	if (unlikely(err)) {
-		LOG_ERR("Cannot disable IRQ");
-		k_panic();
-	}
-
-	k_work_submit(&pmw3360_data.trigger_handler_work);
-}
-
-static void trigger_handler(struct k_work *work)
+static void data_ready_notify(void)
 {
 	sensor_trigger_handler_t handler;
 	int err = 0;
@@ -725,6 +709,31 @@ static void trigger_handler(struct k_work *work)
 	}
 }
 
+static void irq_handler(const struct device *gpiob, struct gpio_callback *cb,
+			uint32_t pins)
+{
+	int err;
+
+	err = gpio_pin_interrupt_configure(pmw3360_data.irq_gpio_dev,
+					   PMW3360_IRQ_GPIO_PIN,
+					   GPIO_INT_DISABLE);
+	if (unlikely(err)) {
+		LOG_ERR("Cannot disable IRQ");
+		k_panic();
+	}
+
+	if (IS_ENABLED(CONFIG_PMW3360_TRIGGER_ISR)) {
+		data_ready_notify();
+	} else {
+		k_work_submit(&pmw3360_data.trigger_handler_work);
+	}
+}
+
+static void trigger_handler(struct k_work *work)
+{
+	data_ready_notify();
+}
+
 static int pmw3360_async_init_power_up(struct pmw3360_data *dev_data)
 {
 	/* Reset sensor */
@@ -5,6 +5,7 @@
  */
 
 #include <drivers/uart.h>
+#include <drivers/uart_nrf_sw_lpuart.h>
 #include <drivers/gpio.h>
 #include <hal/nrf_gpio.h>
 #include <hal/nrf_gpiote.h>
@@ -119,6 +120,26 @@ struct lpuart_data {
 
 	struct onoff_client rx_clk_cli;
 
+	/* Set to true if HFCLK is requested for RX. */
+	bool rx_clk_requested;
+
+	/* Set to true if HFCLK requested for RX is running. */
+	bool rx_clk_ready;
+
+	/* Set to true if burst mode is active. */
+	bool burst;
+
+	/* Timer used to release HFCLK after the linger time. */
+	struct k_timer rx_linger_timer;
+
+	/* Cycle counter value when HFCLK was requested. */
+	uint32_t rx_clk_req_cycles;
+
+	/* Cycle counter value when HFCLK started running with RX idle. */
+	uint32_t rx_clk_idle_cycles;
+
+	struct lpuart_stats stats;
+
 #if CONFIG_NRF_SW_LPUART_INT_DRIVEN
 	struct lpuart_int_driven int_driven;
 #endif
@@ -228,6 +249,30 @@ static void activate_rx(struct lpuart_data *data)
 	data->rx_state = RX_ACTIVE;
 }
 
+static uint32_t cycles_to_us(uint32_t cycles)
+{
+	return (uint32_t)k_cyc_to_us_floor64(cycles);
+}
+
+/* Called when HFCLK is kept running while receiver is idle. */
+static void stats_clk_idle_start(struct lpuart_data *data)
+{
+	if (IS_ENABLED(CONFIG_NRF_SW_LPUART_STATS)) {
+		data->rx_clk_idle_cycles = k_cycle_get_32();
+	}
+}
+
+/* Called when HFCLK kept running while receiver was idle is used or
+ * released.
+ */
+static void stats_clk_idle_end(struct lpuart_data *data)
+{
+	if (IS_ENABLED(CONFIG_NRF_SW_LPUART_STATS)) {
+		data->stats.clk_idle_time_us += cycles_to_us(
+			k_cycle_get_32() - data->rx_clk_idle_cycles);
+	}
+}
+
 static void rx_hfclk_callback(struct onoff_manager *mgr,
 			      struct onoff_client *cli,
 			      uint32_t state, int res)
@@ -237,7 +282,19 @@ static void rx_hfclk_callback(struct onoff_manager *mgr,
 
 	__ASSERT_NO_MSG(res >= 0);
 
-	activate_rx(data);
+	if (IS_ENABLED(CONFIG_NRF_SW_LPUART_STATS)) {
+		data->stats.clk_startup_time_us += cycles_to_us(
+			k_cycle_get_32() - data->rx_clk_req_cycles);
+	}
+
+	data->rx_clk_ready = true;
+
+	if (data->rx_state == RX_PREPARE) {
+		activate_rx(data);
+	} else {
+		/* Clock requested in advance by the burst mode. */
+		stats_clk_idle_start(data);
+	}
 }
 
 static void rx_hfclk_request(struct lpuart_data *data)
@@ -246,20 +303,107 @@ static void rx_hfclk_request(struct lpuart_data *data)
 		z_nrf_clock_control_get_onoff(CLOCK_CONTROL_NRF_SUBSYS_HF);
 	int err;
 
+	if (IS_ENABLED(CONFIG_NRF_SW_LPUART_STATS)) {
+		data->stats.clk_requests++;
+		data->rx_clk_req_cycles = k_cycle_get_32();
+	}
+
+	data->rx_clk_requested = true;
 	sys_notify_init_callback(&data->rx_clk_cli.notify, rx_hfclk_callback);
 	err = onoff_request(mgr, &data->rx_clk_cli);
 	__ASSERT_NO_MSG(err >= 0);
 }
 
+static void rx_hfclk_release(struct lpuart_data *data)
+{
+	struct onoff_manager *mgr =
+		z_nrf_clock_control_get_onoff(CLOCK_CONTROL_NRF_SUBSYS_HF);
+	int err;
+
+	if (!data->rx_clk_requested) {
+		return;
+	}
+
+	if (data->rx_clk_ready) {
+		stats_clk_idle_end(data);
+	}
+
+	data->rx_clk_requested = false;
+	data->rx_clk_ready = false;
+	err = onoff_cancel_or_release(mgr, &data->rx_clk_cli);
+	__ASSERT_NO_MSG(err >= 0);
+}
+
+static bool rx_is_running(const struct lpuart_data *data)
+{
+	return (data->rx_state == RX_PREPARE) || (data->rx_state == RX_ACTIVE);
+}
+
+/* Called when receiver no longer needs HFCLK. Clock is kept running in burst
+ * mode or released after the linger time.
+ */
+static void rx_hfclk_idle(struct lpuart_data *data)
+{
+	if (!data->rx_clk_requested) {
+		return;
+	}
+
+	if (data->rx_clk_ready) {
+		stats_clk_idle_start(data);
+	}
+
+	if (data->burst) {
+		return;
+	}
+
+	if (CONFIG_NRF_SW_LPUART_RX_LINGER_TIME > 0) {
+		k_timer_start(&data->rx_linger_timer,
+			      K_MSEC(CONFIG_NRF_SW_LPUART_RX_LINGER_TIME),
+			      K_NO_WAIT);
+	} else {
+		rx_hfclk_release(data);
+	}
+}
+
+static void rx_linger_timeout(struct k_timer *timer)
+{
+	struct lpuart_data *data = k_timer_user_data_get(timer);
+	int key = irq_lock();
+
+	if (!data->burst && !rx_is_running(data)) {
+		LOG_DBG("RX: Linger time expired");
+		rx_hfclk_release(data);
+	}
+
+	irq_unlock(key);
+}
+
 static void start_rx_activation(struct lpuart_data *data)
 {
 	data->rx_state = RX_PREPARE;
 
-	if (IS_ENABLED(CONFIG_NRF_SW_LPUART_HFXO_ON_RX)) {
-		rx_hfclk_request(data);
-	} else {
+	if (IS_ENABLED(CONFIG_NRF_SW_LPUART_STATS)) {
+		data->stats.rx_transfers++;
+	}
+
+	if (!IS_ENABLED(CONFIG_NRF_SW_LPUART_HFXO_ON_RX)) {
 		activate_rx(data);
+		return;
 	}
+
+	k_timer_stop(&data->rx_linger_timer);
+
+	if (data->rx_clk_ready) {
+		/* Clock kept running since previous transfer. */
+		if (IS_ENABLED(CONFIG_NRF_SW_LPUART_STATS)) {
+			data->stats.clk_reuses++;
+		}
+		stats_clk_idle_end(data);
+		activate_rx(data);
+	} else if (!data->rx_clk_requested) {
+		rx_hfclk_request(data);
+	}
+	/* Otherwise clock is starting and RX is activated from the callback. */
 }
 
 /* Called when end of transfer is detected. It sets response pin to idle and
@@ -270,11 +414,7 @@ static void deactivate_rx(struct lpuart_data *data)
 	int err;
 
 	if (IS_ENABLED(CONFIG_NRF_SW_LPUART_HFXO_ON_RX)) {
-		struct onoff_manager *mgr =
-		     z_nrf_clock_control_get_onoff(CLOCK_CONTROL_NRF_SUBSYS_HF);
-
-		err = onoff_cancel_or_release(mgr, &data->rx_clk_cli);
-		__ASSERT_NO_MSG(err >= 0);
+		rx_hfclk_idle(data);
 	}
 
 	ctrl_pin_idle(&data->rdy_pin);
@@ -494,6 +634,9 @@ static void uart_callback(const struct device *uart, struct uart_event *evt,
 		} else {
 			data->rx_buf = NULL;
 			data->rx_state = RX_OFF;
+			data->burst = false;
+			k_timer_stop(&data->rx_linger_timer);
+			rx_hfclk_release(data);
 		}
 
 		user_callback(dev, evt);
@@ -662,6 +805,84 @@ static int api_rx_disable(const struct device *dev)
 	return uart_rx_disable(data->uart);
 }
 
+int lpuart_burst_start(const struct device *dev)
+{
+	struct lpuart_data *data = get_dev_data(dev);
+	int key;
+
+	if (!IS_ENABLED(CONFIG_NRF_SW_LPUART_HFXO_ON_RX)) {
+		return -ENOTSUP;
+	}
+
+	key = irq_lock();
+
+	if (data->rx_state == RX_OFF || data->rx_state == RX_TO_OFF) {
+		irq_unlock(key);
+		return -EIO;
+	}
+
+	data->burst = true;
+	k_timer_stop(&data->rx_linger_timer);
+	if (!data->rx_clk_requested) {
+		rx_hfclk_request(data);
+	}
+
+	irq_unlock(key);
+
+	LOG_DBG("Burst started");
+
+	return 0;
+}
+
+int lpuart_burst_stop(const struct device *dev)
+{
+	struct lpuart_data *data = get_dev_data(dev);
+	int key;
+
+	if (!IS_ENABLED(CONFIG_NRF_SW_LPUART_HFXO_ON_RX)) {
+		return -ENOTSUP;
+	}
+
+	key = irq_lock();
+
+	if (data->burst) {
+		data->burst = false;
+		if (!rx_is_running(data)) {
+			if (data->rx_clk_ready) {
+				stats_clk_idle_end(data);
+			}
+			rx_hfclk_idle(data);
+		}
+	}
+
+	irq_unlock(key);
+
+	LOG_DBG("Burst stopped");
+
+	return 0;
+}
+
+int lpuart_stats_get(const struct device *dev, struct lpuart_stats *stats)
+{
+	struct lpuart_data *data = get_dev_data(dev);
+	int key;
+
+	if (!IS_ENABLED(CONFIG_NRF_SW_LPUART_STATS)) {
+		return -ENOTSUP;
+	}
+
+	key = irq_lock();
+	*stats = data->stats;
+	if (data->rx_clk_ready && !rx_is_running(data)) {
+		/* Include currently ongoing idle period. */
+		stats->clk_idle_time_us += cycles_to_us(
+			k_cycle_get_32() - data->rx_clk_idle_cycles);
+	}
+	irq_unlock(key);
+
+	return 0;
+}
+
 #if CONFIG_NRF_SW_LPUART_INT_DRIVEN
 
 static uint32_t int_driven_rd_available(struct lpuart_data *data)
@@ -895,6 +1116,9 @@ static int lpuart_init(const struct device *dev)
 	k_timer_init(&data->tx_timer, tx_timeout, NULL);
 	k_timer_user_data_set(&data->tx_timer, (void *)dev);
 
+	k_timer_init(&data->rx_linger_timer, rx_linger_timeout, NULL);
+	k_timer_user_data_set(&data->rx_linger_timer, data);
+
 	err = uart_callback_set(data->uart, uart_callback, (void *)dev);
 	if (err < 0) {
 		return -EINVAL;
@@ -90,6 +90,8 @@ static inline size_t bt_conn_ctx_count(struct bt_conn_ctx_lib *ctx_lib)
  * @brief Allocate memory for the connection context data.
  *
  * This function can set the pointer to the allocated memory.
+ * The context is stored at the slot given by @ref bt_conn_index, so
+ * lookups for a connection do not search the context array.
  *
  * This function should be used in conjunction with
  * @ref bt_conn_ctx_release to ensure proper operation.
@@ -98,7 +100,8 @@ static inline size_t bt_conn_ctx_count(struct bt_conn_ctx_lib *ctx_lib)
  * @param conn		Bluetooth connection.
  *
  * @return Pointer to the connection context data if the operation
- *         was successful. Otherwise NULL.
+ *         was successful. Otherwise NULL, also when the connection
+ *         already has a context allocated.
  */
 void *bt_conn_ctx_alloc(struct bt_conn_ctx_lib *ctx_lib, struct bt_conn *conn);
 
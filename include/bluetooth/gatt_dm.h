@@ -155,6 +155,35 @@ size_t bt_gatt_dm_attr_cnt(const struct bt_gatt_dm *dm);
 const struct bt_gatt_dm_attr *bt_gatt_dm_service_get(
 	const struct bt_gatt_dm *dm);
 
+/** @brief Get next service
+ *
+ * Iterates over the services found by a discovery started with
+ * @ref bt_gatt_dm_start_multi. A discovery of a single service returns
+ * only that service.
+ *
+ * @param[in] dm   Discovery Manager instance
+ * @param[in] prev An attribute where the search is to be started.
+ *                 Set it to NULL to get the first service.
+ *
+ * @return The pointer to the service attribute
+ *         or NULL if there are no more services.
+ */
+const struct bt_gatt_dm_attr *bt_gatt_dm_service_next(
+	const struct bt_gatt_dm *dm,
+	const struct bt_gatt_dm_attr *prev);
+
+/** @brief Get the service by its UUID
+ *
+ * @param[in] dm   Discovery Manager instance
+ * @param[in] uuid Service UUID
+ *
+ * @return The pointer to the service attribute
+ *         or NULL if the service was not found.
+ */
+const struct bt_gatt_dm_attr *bt_gatt_dm_service_by_uuid(
+	const struct bt_gatt_dm *dm,
+	const struct bt_uuid *uuid);
+
 /** @brief Get next characteristic
  *
  * @param[in] dm Discovery Manager instance.
@@ -287,6 +316,38 @@ int bt_gatt_dm_start(struct bt_conn *conn,
 		     const struct bt_gatt_dm_cb *cb,
 		     void *context);
 
+/** @brief Start discovery of multiple services.
+ *
+ * This function is asynchronous. The primary services of the peer are
+ * walked once and all services that match one of @p svc_uuids are
+ * discovered together with their characteristics and descriptors.
+ * The completed callback is called once, when all of them are found,
+ * or the service not found callback if none of them is present.
+ *
+ * Use @ref bt_gatt_dm_service_next or @ref bt_gatt_dm_service_by_uuid
+ * to access the services. The attributes of a service are placed after
+ * its service attribute, up to its end handle.
+ *
+ * @note @kconfig{CONFIG_BT_GATT_DM_MAX_ATTRS} must be large enough to hold
+ * the attributes of all requested services.
+ *
+ * @param[in]     conn Connection object.
+ * @param[in]     svc_uuids UUIDs of target services.
+ * @param[in]     svc_uuid_cnt Number of UUIDs in @p svc_uuids,
+ *                at most @kconfig{CONFIG_BT_GATT_DM_MAX_SVC_UUIDS}.
+ * @param[in]     cb Callback structure.
+ * @param[in,out] context Context argument to be passed to
+ *                callback functions.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int bt_gatt_dm_start_multi(struct bt_conn *conn,
+			   const struct bt_uuid *const *svc_uuids,
+			   size_t svc_uuid_cnt,
+			   const struct bt_gatt_dm_cb *cb,
+			   void *context);
+
 /** @brief Continue service discovery.
  *
  * This function continues service discovery.
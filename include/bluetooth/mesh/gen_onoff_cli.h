@@ -66,6 +66,8 @@ struct bt_mesh_onoff_cli {
 	uint8_t tid;
 	/** Response context for tracking acknowledged messages. */
 	struct bt_mesh_msg_ack_ctx ack_ctx;
+	/** Response context for collecting responses to group requests. */
+	struct bt_mesh_msg_ack_ctx group_ack_ctx;
 	/** Publish parameters. */
 	struct bt_mesh_model_pub pub;
 	/* Publication buffer */
@@ -99,6 +101,44 @@ int bt_mesh_onoff_cli_get(struct bt_mesh_onoff_cli *cli,
 			  struct bt_mesh_msg_ctx *ctx,
 			  struct bt_mesh_onoff_status *rsp);
 
+/** Response from a single server to a group request. */
+struct bt_mesh_onoff_cli_group_rsp {
+	/** Address of the responding server. */
+	uint16_t addr;
+	/** OnOff status of the responding server. */
+	struct bt_mesh_onoff_status status;
+};
+
+/** @brief Get the status of all servers in a group.
+ *
+ * Sends a single Get message, and collects the responses of all servers
+ * that respond within the given timeout. This call is blocking, and returns
+ * when the timeout expires or all response buffers are filled. The responses
+ * are also passed to the @ref bt_mesh_onoff_cli::status_handler callback.
+ *
+ * A group request may be in progress at the same time as a blocking request
+ * to a single server.
+ *
+ * @param[in] cli Client model to send on.
+ * @param[in] ctx Message context, or NULL to use the configured publish
+ * parameters.
+ * @param[out] rsps Array of response buffers.
+ * @param[in] count Number of response buffers in @p rsps.
+ * @param[in] timeout Time to wait for responses.
+ *
+ * @return The number of responses written to @p rsps, or a negative error
+ * code.
+ * @retval -EINVAL No response buffers were provided.
+ * @retval -EALREADY A group request is already in progress.
+ * @retval -EADDRNOTAVAIL A message context was not provided and publishing is
+ * not configured.
+ * @retval -EAGAIN The device has not been provisioned.
+ */
+int bt_mesh_onoff_cli_group_get(struct bt_mesh_onoff_cli *cli,
+				struct bt_mesh_msg_ctx *ctx,
+				struct bt_mesh_onoff_cli_group_rsp *rsps,
+				size_t count, k_timeout_t timeout);
+
 /** @brief Set the OnOff state in the srv.
  *
  * This call is blocking if the @p rsp buffer is non-NULL. Otherwise, this
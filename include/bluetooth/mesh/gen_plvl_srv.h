@@ -156,7 +156,7 @@ struct bt_mesh_plvl_srv {
 
 #if CONFIG_BT_SETTINGS
 	/** Storage timer */
-	struct k_work_delayable store_timer;
+	struct bt_mesh_model_store store_timer;
 #endif
 	/** Current Power Range. */
 	struct bt_mesh_plvl_range range;
@@ -106,7 +106,7 @@ struct bt_mesh_ponoff_srv {
 
 #if CONFIG_BT_SETTINGS
 	/** Storage timer */
-	struct k_work_delayable store_timer;
+	struct bt_mesh_model_store store_timer;
 #endif
 	/** Current OnPowerUp state. */
 	enum bt_mesh_on_power_up on_power_up;
@@ -165,7 +165,7 @@ struct bt_mesh_prop_srv {
 
 #if CONFIG_BT_SETTINGS
 	/** Storage timer */
-	struct k_work_delayable store_timer;
+	struct bt_mesh_model_store store_timer;
 #endif
 	/** List of properties supported by the server. */
 	struct bt_mesh_prop *const properties;
@@ -193,7 +193,7 @@ struct bt_mesh_light_hue_srv {
 
 #if CONFIG_BT_SETTINGS
 	/** Storage timer */
-	struct k_work_delayable store_timer;
+	struct bt_mesh_model_store store_timer;
 #endif
 	/** Hue range */
 	struct bt_mesh_light_hsl_range range;
@@ -127,7 +127,7 @@ struct bt_mesh_light_temp_srv {
 
 #if CONFIG_BT_SETTINGS
 	/** Storage timer */
-	struct k_work_delayable store_timer;
+	struct bt_mesh_model_store store_timer;
 #endif
 	/** Default light temperature and delta UV */
 	struct bt_mesh_light_temp dflt;
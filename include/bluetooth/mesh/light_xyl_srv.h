@@ -158,7 +158,7 @@ struct bt_mesh_light_xyl_srv {
 
 #if CONFIG_BT_SETTINGS
 	/** Storage timer */
-	struct k_work_delayable store_timer;
+	struct bt_mesh_model_store store_timer;
 #endif
 	/** Current range parameters */
 	struct bt_mesh_light_xy_range range;
@@ -108,6 +108,8 @@ struct bt_mesh_lightness_cli {
 		BT_MESH_LIGHTNESS_OP_SET, BT_MESH_LIGHTNESS_MSG_MAXLEN_SET)];
 	/** Acknowledged message tracking. */
 	struct bt_mesh_msg_ack_ctx ack_ctx;
+	/** Response collection for group requests. */
+	struct bt_mesh_msg_ack_ctx group_ack_ctx;
 	/** Current transaction ID. */
 	uint8_t tid;
 	/** Collection of handler callbacks */
@@ -139,6 +141,45 @@ int bt_mesh_lightness_cli_light_get(struct bt_mesh_lightness_cli *cli,
 				    struct bt_mesh_msg_ctx *ctx,
 				    struct bt_mesh_lightness_status *rsp);
 
+/** Response from a single server to a group request. */
+struct bt_mesh_lightness_cli_group_rsp {
+	/** Address of the responding server. */
+	uint16_t addr;
+	/** Light Level status of the responding server. */
+	struct bt_mesh_lightness_status status;
+};
+
+/** @brief Get the Light Level of all servers in a group.
+ *
+ * By default, the ACTUAL representation will be used. LINEAR representation
+ * can be configured by defining CONFIG_BT_MESH_LIGHTNESS_LINEAR.
+ *
+ * Sends a single Get message, and collects the responses of all servers
+ * that respond within the given timeout. This call is blocking, and returns
+ * when the timeout expires or all response buffers are filled. The responses
+ * are also passed to the
+ * @ref bt_mesh_lightness_cli_handlers::light_status callback.
+ *
+ * @param[in] cli Client model to send on.
+ * @param[in] ctx Message context, or NULL to use the configured publish
+ * parameters.
+ * @param[out] rsps Array of response buffers.
+ * @param[in] count Number of response buffers in @c rsps.
+ * @param[in] timeout Time to wait for responses.
+ *
+ * @return The number of responses written to @c rsps, or a negative error
+ * code.
+ * @retval -EINVAL No response buffers were provided.
+ * @retval -EALREADY A group request is already in progress.
+ * @retval -EADDRNOTAVAIL A message context was not provided and publishing is
+ * not configured.
+ * @retval -EAGAIN The device has not been provisioned.
+ */
+int bt_mesh_lightness_cli_light_group_get(
+	struct bt_mesh_lightness_cli *cli, struct bt_mesh_msg_ctx *ctx,
+	struct bt_mesh_lightness_cli_group_rsp *rsps, size_t count,
+	k_timeout_t timeout);
+
 /** @brief Set the Light Level of the server.
  *
  * By default, the ACTUAL representation will be used. LINEAR representation
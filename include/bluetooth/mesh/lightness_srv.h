@@ -157,7 +157,7 @@ struct bt_mesh_lightness_srv {
 
 #if CONFIG_BT_SETTINGS
 	/** Storage timer */
-	struct k_work_delayable store_timer;
+	struct bt_mesh_model_store store_timer;
 #endif
 	/** Current Light Level Range. */
 	struct bt_mesh_lightness_range range;
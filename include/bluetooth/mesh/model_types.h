@@ -87,6 +87,29 @@ bt_mesh_model_transition_time(const struct bt_mesh_model_transition *trans)
 	return trans->delay + trans->time;
 }
 
+/** @cond INTERNAL_HIDDEN */
+struct bt_mesh_model_store;
+
+/** Model state store handler. */
+typedef void (*bt_mesh_model_store_cb_t)(struct bt_mesh_model_store *store);
+
+/** Deferred model state storage.
+ *
+ *  All models share a single timer for storing their state. Pending stores
+ *  are kept in a list, in the order they're due.
+ */
+struct bt_mesh_model_store {
+	/** List node. */
+	sys_snode_t node;
+	/** Uptime at which the state is stored. */
+	int64_t deadline;
+	/** Store handler. */
+	bt_mesh_model_store_cb_t cb;
+	/** The store is pending. */
+	bool pending;
+};
+/** @endcond */
+
 /** @cond INTERNAL_HIDDEN
  * @def BT_MESH_MODEL_USER_DATA
  *
@@ -391,6 +391,20 @@ struct bt_mesh_sensor {
 		/** Flag indicating whether the sensor is in fast cadence mode.
 		 */
 		uint8_t fast_pub : 1;
+
+#if CONFIG_BT_MESH_SENSOR_SRV_STATUS_CACHE
+		/** Length of the cached sensor status, or 0 if not cached. */
+		uint16_t cache_len;
+
+		/** Uptime of the last cache update, in milliseconds. */
+		uint32_t cache_time;
+
+		/** Cached encoded sensor status. Same size as
+		 *  BT_MESH_SENSOR_STATUS_MAXLEN.
+		 */
+		uint8_t cache[3 + CONFIG_BT_MESH_SENSOR_CHANNELS_MAX *
+				      CONFIG_BT_MESH_SENSOR_CHANNEL_ENCODED_SIZE_MAX];
+#endif
 	} state;
 };
 
@@ -133,6 +133,41 @@ struct bt_filter_status {
 	struct bt_scan_filter_info manufacturer_data;
 };
 
+/**@brief Match and reject counters of a single filter type.
+ */
+struct bt_scan_filter_type_stats {
+	/** Number of advertising reports that matched the filter type. */
+	uint32_t match;
+
+	/** Number of advertising reports rejected by the filter type. */
+	uint32_t reject;
+};
+
+/**@brief Filter statistics structure.
+ *
+ * @details Counters are updated for every advertising report, for each
+ *          filter type that is enabled when the report is received.
+ */
+struct bt_scan_filter_stats {
+	/** Name filter counters. */
+	struct bt_scan_filter_type_stats name;
+
+	/** Short name filter counters. */
+	struct bt_scan_filter_type_stats short_name;
+
+	/** Address filter counters. */
+	struct bt_scan_filter_type_stats addr;
+
+	/** UUID filter counters. */
+	struct bt_scan_filter_type_stats uuid;
+
+	/** Appearance filter counters. */
+	struct bt_scan_filter_type_stats appearance;
+
+	/** Manufacturer data filter counters. */
+	struct bt_scan_filter_type_stats manufacturer_data;
+};
+
 /**@brief Advertising info structure.
  */
 struct bt_scan_adv_info {
@@ -497,6 +532,23 @@ int bt_scan_filter_add(enum bt_scan_filter_type type,
  */
 void bt_scan_filter_remove_all(void);
 
+/**@brief Function for getting the filter statistics.
+ *
+ * @details Requires @kconfig{CONFIG_BT_SCAN_FILTER_STATS}.
+ *
+ * @param[out] stats Pointer to the filter statistics structure.
+ *
+ * @return 0 If the operation was successful. Otherwise, a (negative) error
+ *	     code is returned.
+ */
+int bt_scan_filter_stats_get(struct bt_scan_filter_stats *stats);
+
+/**@brief Function for resetting the filter statistics.
+ *
+ * @details Requires @kconfig{CONFIG_BT_SCAN_FILTER_STATS}.
+ */
+void bt_scan_filter_stats_reset(void);
+
 #endif /* CONFIG_BT_SCAN_FILTER_ENABLE */
 
 /**@brief Function for changing the scanning parameters.
@@ -543,6 +595,14 @@ int bt_scan_blocklist_device_add(const bt_addr_le_t *addr);
  */
 void bt_scan_blocklist_clear(void);
 
+/**@brief Clear the duplicate filter.
+ *
+ * @details Use this function to remove all entries from the duplicate
+ *          filter, so that the next report from every device is passed
+ *          to the application.
+ */
+void bt_scan_duplicate_filter_clear(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,6 +15,7 @@
  * @brief Apple Notification Center Service Client module.
  */
 
+#include <kernel.h>
 #include <bluetooth/gatt.h>
 #include <bluetooth/conn.h>
 #include <bluetooth/gatt_dm.h>
@@ -311,6 +312,20 @@ typedef void (*bt_ancs_ns_notif_cb)(struct bt_ancs_client *ancs_c, int err,
 typedef void (*bt_ancs_ds_notif_cb)(struct bt_ancs_client *ancs_c,
 				    const struct bt_ancs_attr_response *response);
 
+/**@brief Data Source attribute chunk callback function.
+ *
+ * @param[in] ancs_c    ANCS client instance.
+ * @param[in] response  Attribute response structure. The attribute length is
+ *                      the total length of the attribute.
+ * @param[in] data      Chunk of the attribute data.
+ * @param[in] len       Length of the chunk.
+ * @param[in] offset    Offset of the chunk in the attribute data.
+ */
+typedef void (*bt_ancs_ds_chunk_cb)(struct bt_ancs_client *ancs_c,
+				    const struct bt_ancs_attr_response *response,
+				    const uint8_t *data, uint16_t len,
+				    uint16_t offset);
+
 /**@brief Write response callback function.
  *
  * @param[in] ancs_c  ANCS client instance.
@@ -319,6 +334,14 @@ typedef void (*bt_ancs_ds_notif_cb)(struct bt_ancs_client *ancs_c,
 typedef void (*bt_ancs_write_cb)(struct bt_ancs_client *ancs_c,
 				 uint8_t err);
 
+/**@brief Queued request for notification attributes. */
+struct bt_ancs_attr_req {
+	/** Notification UID. */
+	uint32_t notif_uid;
+	/** Callback function for handling NP write response. */
+	bt_ancs_write_cb func;
+};
+
 struct bt_ancs_parse_sm {
 	/** The current list of attributes that are being parsed. This will
 	 *  point to either ancs_notif_attr_list or ancs_app_attr_list in
@@ -392,6 +415,23 @@ struct bt_ancs_client {
 	/** Callback function for Data Source notification. */
 	bt_ancs_ds_notif_cb ds_notif_cb;
 
+	/** Callback function for Data Source attribute chunks. */
+	bt_ancs_ds_chunk_cb ds_chunk_cb;
+
+#if CONFIG_BT_ANCS_CLIENT_REQ_QUEUE_SIZE > 0
+	/** Notification attribute requests waiting for the Control Point. */
+	struct {
+		/** Protects the queue and the Control Point pending flag. */
+		struct k_spinlock lock;
+		/** Queued requests. */
+		struct bt_ancs_attr_req reqs[CONFIG_BT_ANCS_CLIENT_REQ_QUEUE_SIZE];
+		/** Index of the oldest request. */
+		uint8_t head;
+		/** Number of queued requests. */
+		uint8_t count;
+	} req_queue;
+#endif
+
 	/** For all attributes: contains information about whether the
 	 *  attributes are to be requested upon attribute request, and
 	 *  the length and buffer of where to store attribute data.
@@ -504,7 +544,30 @@ int bt_ancs_register_app_attr(struct bt_ancs_client *ancs_c,
 			      const enum bt_ancs_app_attr_id_val id,
 			      uint8_t *data, const uint16_t len);
 
+/**@brief Function for registering a callback for attribute data chunks.
+ *
+ * @details The callback receives the data of the requested attributes
+ *          directly from the Data Source notifications, as soon as they
+ *          arrive. The data is passed in full, also the part that does not
+ *          fit into the buffer registered for the attribute.
+ *          The Data Source notification callback is still called when
+ *          the attribute is complete.
+ *
+ * @param[in] ancs_c ANCS client instance.
+ * @param[in] func   Callback function, or NULL to disable it.
+ *
+ * @retval 0 If the operation is successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int bt_ancs_register_attr_chunk_cb(struct bt_ancs_client *ancs_c,
+				   bt_ancs_ds_chunk_cb func);
+
 /**@brief Function for requesting attributes for a notification.
+ *
+ * @details If a Control Point write is in progress and
+ *          @kconfig{CONFIG_BT_ANCS_CLIENT_REQ_QUEUE_SIZE} is not zero, the
+ *          request is queued and written as soon as the Control Point is
+ *          free. The responses are parsed in the order of the requests.
  *
  * @param[in] ancs_c   ANCS client instance.
  * @param[in] notif    Pointer to the notification whose attributes will be requested from
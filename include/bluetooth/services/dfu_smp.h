@@ -19,6 +19,7 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <kernel.h>
 #include <bluetooth/gatt.h>
 #include <bluetooth/conn.h>
 #include <bluetooth/gatt_dm.h>
@@ -100,6 +101,45 @@ typedef void (*bt_dfu_smp_rsp_part_cb)(struct bt_dfu_smp *dfu_smp);
 typedef void (*bt_dfu_smp_error_cb)(struct bt_dfu_smp *dfu_smp,
 					 int err);
 
+/** @brief Read a part of the image to be uploaded.
+ *
+ *  @param dfu_smp DFU SMP Client instance.
+ *  @param offset  Offset within the image.
+ *  @param buf     Buffer for the data.
+ *  @param len     Number of bytes to read.
+ *
+ *  @retval 0 If the operation was successful.
+ *            Otherwise, a (negative) error code is returned.
+ */
+typedef int (*bt_dfu_smp_upload_read_cb)(struct bt_dfu_smp *dfu_smp,
+					 size_t offset, uint8_t *buf,
+					 size_t len);
+
+/** @brief Image upload has finished.
+ *
+ *  @param dfu_smp DFU SMP Client instance.
+ *  @param err     0 if the image was uploaded, negative internal error code
+ *                 or positive SMP error code reported by the server.
+ */
+typedef void (*bt_dfu_smp_upload_done_cb)(struct bt_dfu_smp *dfu_smp,
+					  int err);
+
+/**
+ * @brief Image upload parameters.
+ */
+struct bt_dfu_smp_upload_params {
+	/** Image number. */
+	uint8_t image;
+	/** Size of the image. */
+	size_t size;
+	/** SHA-256 of the image, or NULL. */
+	const uint8_t *sha;
+	/** Callback for reading the image data. */
+	bt_dfu_smp_upload_read_cb read;
+	/** Callback called when the upload has finished. */
+	bt_dfu_smp_upload_done_cb done;
+};
+
 /**
  * @brief DFU SMP Client parameters for the initialization function.
  */
@@ -149,6 +189,40 @@ struct bt_dfu_smp {
 	 *  This is handled automatically by the library.
 	 */
 	struct bt_gatt_subscribe_params notification_params;
+#if defined(CONFIG_BT_DFU_SMP_UPLOAD) || defined(__DOXYGEN__)
+	/** Image upload state, used internally. */
+	struct bt_dfu_smp_upload {
+		/** Upload parameters. */
+		struct bt_dfu_smp_upload_params params;
+		/** Work sending the upload requests. */
+		struct k_work_delayable work;
+		/** Protects the upload state. */
+		struct k_spinlock lock;
+		/** Upload in progress. */
+		bool active;
+		/** Offset of the next request. */
+		size_t next_off;
+		/** Offset confirmed by the server. */
+		size_t acked_off;
+		/** Sequence number of the next request. */
+		uint8_t seq;
+		/** Requests waiting for a response. */
+		struct bt_dfu_smp_upload_req {
+			/** Request sent. */
+			bool used;
+			/** Response is ignored, the upload was rewound. */
+			bool stale;
+			/** Sequence number. */
+			uint8_t seq;
+			/** Offset following the request data. */
+			size_t end;
+		} reqs[CONFIG_BT_DFU_SMP_UPLOAD_WINDOW];
+		/** Response being reassembled. */
+		uint8_t rsp[CONFIG_BT_DFU_SMP_UPLOAD_RSP_SIZE];
+		/** Number of response bytes received. */
+		size_t rsp_len;
+	} upload;
+#endif
 };
 
 /** @brief Initialize the DFU SMP Client module.
@@ -189,6 +263,24 @@ int bt_dfu_smp_command(struct bt_dfu_smp *dfu_smp,
 		       bt_dfu_smp_rsp_part_cb rsp_cb,
 		       size_t cmd_size, const void *cmd_data);
 
+/** @brief Upload an image.
+ *
+ *  The image is sent in image upload requests that fill the ATT MTU.
+ *  Up to @kconfig{CONFIG_BT_DFU_SMP_UPLOAD_WINDOW} requests are sent without
+ *  waiting for the responses, which are matched by their sequence numbers.
+ *  If the server expects a different offset, the upload continues from there.
+ *
+ *  No other command can be executed until the upload has finished.
+ *
+ *  @param[in,out] dfu_smp DFU SMP Client instance.
+ *  @param[in]     params  Upload parameters.
+ *
+ *  @retval 0 If the upload was started.
+ *            Otherwise, a (negative) error code is returned.
+ */
+int bt_dfu_smp_upload(struct bt_dfu_smp *dfu_smp,
+		      const struct bt_dfu_smp_upload_params *params);
+
 /** @brief Get the connection object that is used with the DFU SMP Client.
  *
  *  @param[in] dfu_smp DFU SMP Client instance.
@@ -21,6 +21,7 @@ extern "C" {
 #include <bluetooth/gatt_pool.h>
 #include <bluetooth/gatt.h>
 #include <bluetooth/conn_ctx.h>
+#include <net/buf.h>
 
 #ifndef CONFIG_BT_HIDS_INPUT_REP_MAX
 #define CONFIG_BT_HIDS_INPUT_REP_MAX 0
@@ -227,6 +228,11 @@ struct bt_hids_inp_rep {
 
 	/** Callback with the notification event. */
 	bt_hids_notify_handler_t handler;
+
+	/** Notification parameters prepared during the initialization.
+	 *  Used internally, leave it zeroed.
+	 */
+	struct bt_gatt_notify_params notify_params;
 };
 
 
@@ -485,6 +491,13 @@ struct bt_hids_conn_data {
 
 	/** Pointer to Feature Reports Context data. */
 	uint8_t *feat_rep_ctx;
+
+#if defined(CONFIG_BT_HIDS_INP_REP_NET_BUF)
+	/** Buffers with the last sent Input Reports that are not copied
+	 *  to the Input Reports Context data.
+	 */
+	struct net_buf *inp_rep_buf[CONFIG_BT_HIDS_INPUT_REP_MAX];
+#endif
 };
 
 
@@ -551,6 +564,34 @@ int bt_hids_inp_rep_send(struct bt_hids *hids_obj, struct bt_conn *conn,
 			 uint8_t rep_index, uint8_t const *rep, uint8_t len,
 			 bt_gatt_complete_func_t cb);
 
+/** @brief Send Input Report from a network buffer.
+ *
+ *  Works like @ref bt_hids_inp_rep_send, but the report is not copied to
+ *  the connection context. Instead, a reference to the buffer is kept as
+ *  the report value until the next report is sent. Reports with a report
+ *  mask are still copied, because only a part of them is stored.
+ *
+ *  The function takes ownership of the buffer reference, also if an error
+ *  is returned. The buffer must not be modified after calling this function.
+ *
+ *  Only available if @kconfig{CONFIG_BT_HIDS_INP_REP_NET_BUF} is enabled.
+ *
+ *  @warning The function is not thread safe.
+ *	     It can not be called from multiple threads at the same time.
+ *
+ *  @param hids_obj Pointer to HIDS instance.
+ *  @param conn Pointer to Connection Object.
+ *  @param rep_index Index of report descriptor.
+ *  @param buf Buffer with the report data.
+ *  @param cb Notification complete callback (can be NULL).
+ *
+ *  @return 0 If the operation was successful. Otherwise, a (negative) error
+ *	      code is returned.
+ */
+int bt_hids_inp_rep_send_buf(struct bt_hids *hids_obj, struct bt_conn *conn,
+			     uint8_t rep_index, struct net_buf *buf,
+			     bt_gatt_complete_func_t cb);
+
 /** @brief Send Boot Mouse Input Report.
  *
  *  @warning The function is not thread safe.
@@ -22,6 +22,7 @@ extern "C" {
 #include <bluetooth/conn.h>
 #include <bluetooth/gatt_dm.h>
 #include <bluetooth/services/hids.h>
+#include <sys/ring_buffer.h>
 
 struct bt_hogp;
 struct bt_hogp_rep_info;
@@ -207,6 +208,18 @@ struct bt_hogp {
 		 * current state of this process.
 		 */
 		uint8_t rep_idx;
+#if defined(CONFIG_BT_HOGP_REPREF_READ_MULTIPLE)
+		/** Number of report references read by the current
+		 *  Read Multiple request.
+		 */
+		uint8_t count;
+		/** Read Multiple is not supported by the server. */
+		bool single;
+		/** Handles of the report references read by the current
+		 *  Read Multiple request.
+		 */
+		uint16_t handles[CONFIG_BT_HOGP_REPORTS_MAX];
+#endif
 	} init_repref;
 
 	struct {
@@ -232,6 +245,20 @@ struct bt_hogp {
 	bool ready;
 	/** Current protocol mode. */
 	enum bt_hids_pm pm;
+#if defined(CONFIG_BT_HOGP_REPORT_BUFFER)
+	/** Buffered input reports. */
+	struct {
+		/** Ring buffer with the reports. */
+		struct ring_buf rb;
+		/** Memory of the ring buffer. */
+		uint32_t data[CONFIG_BT_HOGP_REPORT_BUFFER_SIZE /
+			      sizeof(uint32_t)];
+		/** Number of reports in the ring buffer. */
+		struct k_sem sem;
+		/** Number of reports dropped because the buffer was full. */
+		atomic_t dropped;
+	} rep_buf;
+#endif
 };
 
 /**
@@ -416,6 +443,59 @@ int bt_hogp_rep_subscribe(struct bt_hogp *hogp,
 int bt_hogp_rep_unsubscribe(struct bt_hogp *hogp,
 			    struct bt_hogp_rep_info *rep);
 
+/**
+ * @brief Subscribe to report notifications with buffering.
+ *
+ * Works like @ref bt_hogp_rep_subscribe, but received reports are copied
+ * to the report buffer of the HOGP object instead of being passed to
+ * @p func from the Bluetooth receive context.
+ * Call @ref bt_hogp_rep_buffer_process to pass the buffered reports
+ * to their callbacks.
+ *
+ * Only available if @kconfig{CONFIG_BT_HOGP_REPORT_BUFFER} is enabled.
+ *
+ * @param hogp   HOGP object.
+ * @param rep    Report object.
+ * @param func   Function to be called to handle the notificated value.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int bt_hogp_rep_subscribe_buffered(struct bt_hogp *hogp,
+				   struct bt_hogp_rep_info *rep,
+				   bt_hogp_read_cb func);
+
+/**
+ * @brief Process a buffered input report.
+ *
+ * Takes the oldest report from the report buffer and calls its
+ * notification callback in the context of the caller.
+ * If the callback returns @c BT_GATT_ITER_STOP, the report is unsubscribed.
+ *
+ * The buffer is lock-free with a single consumer. Only one thread can
+ * call this function for the given HOGP object.
+ *
+ * Only available if @kconfig{CONFIG_BT_HOGP_REPORT_BUFFER} is enabled.
+ *
+ * @param hogp    HOGP object.
+ * @param timeout Time to wait for a report.
+ *
+ * @retval 0 If a report was processed.
+ * @retval (-EAGAIN) If no report was received before the time-out.
+ */
+int bt_hogp_rep_buffer_process(struct bt_hogp *hogp, k_timeout_t timeout);
+
+/**
+ * @brief Get the number of reports dropped because the buffer was full.
+ *
+ * Only available if @kconfig{CONFIG_BT_HOGP_REPORT_BUFFER} is enabled.
+ *
+ * @param hogp HOGP object.
+ *
+ * @return Number of dropped reports.
+ */
+uint32_t bt_hogp_rep_buffer_dropped_get(const struct bt_hogp *hogp);
+
 /**
  * @brief Read part of the report map.
  *
@@ -17,11 +17,41 @@
 #include <bluetooth/uuid.h>
 #include <bluetooth/conn.h>
 #include <bluetooth/gatt_dm.h>
+#include <sys/slist.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** Number of linear sub-buckets per power of two, as a power of two. The
+ *  histogram resolution is 1/8 of the value.
+ */
+#define BT_LATENCY_HIST_SUB_BITS 3
+
+/** Number of histogram buckets covering 32-bit values. */
+#define BT_LATENCY_HIST_BUCKETS \
+	((32 - BT_LATENCY_HIST_SUB_BITS + 1) * BIT(BT_LATENCY_HIST_SUB_BITS))
+
+/** @brief Log-linear latency histogram.
+ *
+ * Values below 2^BT_LATENCY_HIST_SUB_BITS have one bucket each. Every higher
+ * power of two is split into 2^BT_LATENCY_HIST_SUB_BITS buckets of equal
+ * width.
+ */
+struct bt_latency_hist {
+	/** Number of values in every bucket. */
+	uint32_t buckets[BT_LATENCY_HIST_BUCKETS];
+
+	/** Number of values. */
+	uint32_t count;
+
+	/** Smallest value. */
+	uint32_t min;
+
+	/** Largest value. */
+	uint32_t max;
+};
+
 /** @brief Latency client callback structure. */
 struct bt_latency_client_cb {
 	/** @brief Latency received callback.
@@ -51,6 +81,25 @@ struct bt_latency_client {
 
 	/** Internal state. */
 	atomic_t state;
+
+#if defined(CONFIG_BT_LATENCY_CLIENT_HIST) || defined(__DOXYGEN__)
+	/** Round-trip latency in microseconds. */
+	struct bt_latency_hist hist;
+
+	/** Cycle counter value when the pending request was sent. It is also
+	 *  the payload of the requests sent in continuous mode.
+	 */
+	uint32_t req_cycles;
+
+	/** Request period in continuous mode, in milliseconds. */
+	uint32_t period;
+
+	/** Continuous mode work. */
+	struct k_work_delayable work;
+
+	/** Node in the list of client instances. */
+	sys_snode_t node;
+#endif
 };
 
 /** @brief Initialize the GATT latency client.
@@ -103,6 +152,56 @@ int bt_latency_handles_assign(struct bt_gatt_dm *dm,
 int bt_latency_request(struct bt_latency_client *latency,
 		       const void *data, uint16_t len);
 
+/** @brief Reset a latency histogram.
+ *
+ *  @param[out] hist Histogram.
+ */
+void bt_latency_hist_reset(struct bt_latency_hist *hist);
+
+/** @brief Add a value to a latency histogram.
+ *
+ *  @param[in,out] hist Histogram.
+ *  @param[in] value Value.
+ */
+void bt_latency_hist_add(struct bt_latency_hist *hist, uint32_t value);
+
+/** @brief Get a percentile of a latency histogram.
+ *
+ *  The result is the upper bound of the bucket that holds the percentile,
+ *  but not more than the largest value.
+ *
+ *  @param[in] hist Histogram.
+ *  @param[in] pct Percentile, from 0 to 100.
+ *
+ *  @return Percentile value, or 0 if the histogram is empty.
+ */
+uint32_t bt_latency_hist_percentile(const struct bt_latency_hist *hist,
+				    uint8_t pct);
+
+/** @brief Start the continuous mode.
+ *
+ *  Send a Latency request every @p period milliseconds. A period is skipped
+ *  if the previous request is still waiting for a response. The round-trip
+ *  time of every response is added to the histogram of the instance.
+ *  The continuous mode stops when the link is lost.
+ *
+ *  @param[in] latency Latency client instance.
+ *  @param[in] period Request period in milliseconds.
+ *
+ *  @retval 0 If the operation was successful.
+ *            Otherwise, a negative error code is returned.
+ *  @retval (-EINVAL) Special error code used when the period is 0 or no
+ *          link is assigned to the instance.
+ */
+int bt_latency_client_continuous_start(struct bt_latency_client *latency,
+				       uint32_t period);
+
+/** @brief Stop the continuous mode.
+ *
+ *  @param[in] latency Latency client instance.
+ */
+void bt_latency_client_continuous_stop(struct bt_latency_client *latency);
+
 #ifdef __cplusplus
 }
 #endif
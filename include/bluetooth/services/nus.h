@@ -18,6 +18,7 @@
 #include <bluetooth/conn.h>
 #include <bluetooth/uuid.h>
 #include <bluetooth/gatt.h>
+#include <sys/ring_buffer.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -113,6 +114,50 @@ int bt_nus_init(struct bt_nus_cb *callbacks);
  */
 int bt_nus_send(struct bt_conn *conn, const uint8_t *data, uint16_t len);
 
+/**@brief Send a stream of data.
+ *
+ * @details This function splits the data into notifications of at most
+ *          @ref bt_nus_get_mtu bytes and queues them on the connection.
+ *          At most @kconfig{CONFIG_BT_NUS_STREAM_CREDITS} notifications
+ *          are in flight per connection. When all of them are in use, the
+ *          function waits up to @p timeout for each completed notification
+ *          before queuing the next one. The data is copied into the host
+ *          buffers, so the buffer can be reused when the function returns.
+ *
+ *          The @ref bt_nus_cb.sent callback is called for every
+ *          notification that has been sent.
+ *
+ * @param[in] conn    Pointer to connection object.
+ * @param[in] data    Pointer to a data buffer.
+ * @param[in] len     Length of the data in the buffer.
+ * @param[in] timeout Time to wait for a free notification slot.
+ *
+ * @return Number of bytes queued. If an error occurs before any data has
+ *         been queued, a negative value is returned: -EINVAL if the peer
+ *         has not enabled notifications, -EAGAIN if the timeout expired,
+ *         or the error returned by @ref bt_gatt_notify_cb.
+ */
+int bt_nus_stream_send(struct bt_conn *conn, const uint8_t *data, size_t len,
+		       k_timeout_t timeout);
+
+/**@brief Send the content of a ring buffer as a stream.
+ *
+ * @details This function works like @ref bt_nus_stream_send, but takes the
+ *          data from a ring buffer until it is empty. Only the data that
+ *          has been queued is removed from the ring buffer. With
+ *          @p timeout set to K_NO_WAIT, the function can be called from
+ *          the @ref bt_nus_cb.sent callback to keep the stream going.
+ *
+ * @param[in] conn    Pointer to connection object.
+ * @param[in] rb      Ring buffer with the data to send.
+ * @param[in] timeout Time to wait for a free notification slot.
+ *
+ * @return Number of bytes queued. Otherwise, a negative value is returned,
+ *         as for @ref bt_nus_stream_send.
+ */
+int bt_nus_stream_send_ring(struct bt_conn *conn, struct ring_buf *rb,
+			    k_timeout_t timeout);
+
 /**@brief Get maximum data length that can be used for @ref bt_nus_send.
  *
  * @param[in] conn Pointer to connection Object.
@@ -35,6 +35,114 @@ struct bt_throughput_metrics {
 	uint32_t write_rate;
 };
 
+/** @brief Benchmark traffic type. */
+enum bt_throughput_bench_mode {
+	/** Write without response to the peer Throughput Characteristic. */
+	BT_THROUGHPUT_BENCH_WRITE,
+
+	/** Notify the local Throughput Characteristic to the peer. */
+	BT_THROUGHPUT_BENCH_NOTIFY,
+};
+
+/** @brief Benchmark configuration.
+ *
+ * Link parameters set to 0 are left unchanged.
+ */
+struct bt_throughput_bench_cfg {
+	/** Traffic type. */
+	enum bt_throughput_bench_mode mode;
+
+	/** PHY, one of BT_GAP_LE_PHY_1M, BT_GAP_LE_PHY_2M or
+	 *  BT_GAP_LE_PHY_CODED.
+	 */
+	uint8_t phy;
+
+	/** Link Layer TX data length in octets. */
+	uint16_t data_len;
+
+	/** Connection interval in 1.25 ms units. */
+	uint16_t interval;
+
+	/** Payload length of each packet. The ATT MTU can be exchanged only
+	 *  once per connection, so this value emulates smaller MTUs.
+	 *  0 or values above ATT MTU - 3 use the ATT MTU - 3.
+	 */
+	uint16_t payload_len;
+
+	/** Duration of the traffic in milliseconds. */
+	uint32_t duration;
+};
+
+/** @brief Benchmark result of one configuration. */
+struct bt_throughput_bench_result {
+	/** Configuration of the run. */
+	const struct bt_throughput_bench_cfg *cfg;
+
+	/** TX PHY in use. */
+	uint8_t phy;
+
+	/** Link Layer TX data length in use. */
+	uint16_t data_len;
+
+	/** Connection interval in use, in 1.25 ms units. */
+	uint16_t interval;
+
+	/** ATT MTU of the connection. */
+	uint16_t mtu;
+
+	/** Payload length of each packet. */
+	uint16_t payload_len;
+
+	/** Number of packets sent. */
+	uint32_t packets;
+
+	/** Number of payload bytes sent. */
+	uint32_t bytes;
+
+	/** Duration of the run in milliseconds, including the time
+	 *  needed to send the packets queued at the end.
+	 */
+	uint32_t duration;
+
+	/** Throughput in bits per second. */
+	uint32_t rate;
+
+	/** Median packet latency in microseconds. The latency is the time
+	 *  from queuing a packet until the host reports it as sent.
+	 */
+	uint32_t latency_p50;
+
+	/** 90th percentile packet latency in microseconds. */
+	uint32_t latency_p90;
+
+	/** 99th percentile packet latency in microseconds. */
+	uint32_t latency_p99;
+
+	/** Maximum packet latency in microseconds. */
+	uint32_t latency_max;
+
+	/** CPU load in 0.001% units, or 0 if @kconfig{CONFIG_CPU_LOAD}
+	 *  is disabled.
+	 */
+	uint32_t cpu_load;
+
+	/** 0 if the run completed. Otherwise, a negative error code. */
+	int err;
+};
+
+/** @brief Benchmark result callback.
+ *
+ * @param[in] result Result of one configuration.
+ */
+typedef void (*bt_throughput_bench_cb)(
+	const struct bt_throughput_bench_result *result);
+
+/** @brief Header line matching @ref bt_throughput_bench_result_csv. */
+#define BT_THROUGHPUT_BENCH_CSV_HEADER                                         \
+	"mode,phy,data_len,interval,mtu,payload_len,packets,bytes,"            \
+	"duration_ms,rate_bps,lat_p50_us,lat_p90_us,lat_p99_us,lat_max_us,"    \
+	"cpu_load,err"
+
 /** @brief Throughput callback structure. */
 struct bt_throughput_cb {
 	/** @brief Data read callback.
@@ -146,6 +254,49 @@ int bt_throughput_read(struct bt_throughput *throughput);
 int bt_throughput_write(struct bt_throughput *throughput,
 			const uint8_t *data, uint16_t len);
 
+/** @brief Run a benchmark sweep.
+ *
+ * For each configuration, this function applies the link parameters, waits
+ * for the updates to complete and streams data for the configured duration.
+ * At most @kconfig{CONFIG_BT_THROUGHPUT_BENCH_CREDITS} packets are in flight.
+ * In write mode, the peer metrics are reset before the traffic starts. In
+ * notify mode, the peer must have enabled notifications of the local
+ * Throughput Characteristic.
+ *
+ * The function blocks until all configurations have run. It must not be
+ * called from the Bluetooth callbacks.
+ *
+ * @param[in] throughput Throughput Service instance with the connection
+ *                       to use.
+ * @param[in] cfg        Array of configurations.
+ * @param[in] cfg_cnt    Number of configurations.
+ * @param[in] cb         Callback called with the result of each
+ *                       configuration.
+ *
+ * @retval 0 If all configurations have run. Errors of single runs are
+ *           reported in their results.
+ * @retval -EINVAL Invalid parameters or the service is not initialized.
+ * @retval -EBUSY A benchmark is already running.
+ */
+int bt_throughput_bench_run(struct bt_throughput *throughput,
+			    const struct bt_throughput_bench_cfg *cfg,
+			    size_t cfg_cnt, bt_throughput_bench_cb cb);
+
+/** @brief Format a benchmark result as a CSV line.
+ *
+ * The columns are described by @ref BT_THROUGHPUT_BENCH_CSV_HEADER.
+ *
+ * @param[in]  result Benchmark result.
+ * @param[out] buf    Output buffer.
+ * @param[in]  size   Size of the output buffer.
+ *
+ * @return Number of characters that the full line needs, as returned by
+ *         snprintk().
+ */
+int bt_throughput_bench_result_csv(
+	const struct bt_throughput_bench_result *result,
+	char *buf, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -40,6 +40,7 @@ struct sensor_config {
 	const struct sampled_channel *chans;
 	uint8_t chan_cnt;
 	uint8_t active_events_limit;
+	uint8_t samples_in_event;
 	unsigned int sampling_period_ms;
 	struct trigger *trigger;
 };
@@ -7,6 +7,7 @@
 #define __CPU_LOAD_H
 
 #include <zephyr/types.h>
+#include <kernel.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,6 +47,26 @@ void cpu_load_reset(void);
  */
 uint32_t cpu_load_get(void);
 
+/** @brief Callback called for each thread by @ref cpu_load_thread_foreach.
+ *
+ * @param thread Thread.
+ * @param load Share of the time since the measurement reset spent in the
+ *	       thread, in the same units as @ref cpu_load_get.
+ * @param user_data User data.
+ */
+typedef void (*cpu_load_thread_cb_t)(const struct k_thread *thread,
+				     uint32_t load, void *user_data);
+
+/** @brief Get the load of each thread.
+ *
+ * Available if CONFIG_CPU_LOAD_THREADS is enabled. Interrupts are accounted
+ * to the thread they preempted.
+ *
+ * @param cb Callback called for each thread.
+ * @param user_data User data passed to @p cb.
+ */
+void cpu_load_thread_foreach(cpu_load_thread_cb_t cb, void *user_data);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -6,6 +6,9 @@
 #ifndef __PPI_TRACE_H
 #define __PPI_TRACE_H
 
+#include <stddef.h>
+#include <zephyr/types.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -45,6 +48,48 @@ void *ppi_trace_config(uint32_t pin, uint32_t evt);
  */
 void *ppi_trace_pair_config(uint32_t pin, uint32_t start_evt, uint32_t stop_evt);
 
+/** @brief Captured event. */
+struct ppi_trace_capture_entry {
+	/** Time of the event, in microseconds, from a free-running 32-bit
+	 *  TIMER.
+	 */
+	uint32_t timestamp;
+	/** ID given in @ref ppi_trace_capture_config. */
+	uint8_t id;
+};
+
+/** @brief Configure capture of the timestamps of an event to RAM.
+ *
+ * Available if CONFIG_PPI_TRACE_CAPTURE is enabled. Read the captured events
+ * with @ref ppi_trace_capture_read. Use @ref ppi_trace_enable and
+ * @ref ppi_trace_disable with the returned handle.
+ *
+ * @note The timestamp is stored from an interrupt. If the event occurs again
+ *	 before the interrupt is handled, the first occurrence is lost.
+ *
+ * @param id		ID stored with each occurrence of the event.
+ * @param evt		Hardware event to be traced.
+ *
+ * @return Handle, or NULL if the configuration failed.
+ */
+void *ppi_trace_capture_config(uint8_t id, uint32_t evt);
+
+/** @brief Read captured events.
+ *
+ * @param entries	Buffer for the events, oldest first.
+ * @param max_entries	Number of entries in @p entries.
+ *
+ * @return Number of events read.
+ */
+size_t ppi_trace_capture_read(struct ppi_trace_capture_entry *entries,
+			      size_t max_entries);
+
+/** @brief Get the number of events dropped because the buffer was full.
+ *
+ * @return Number of dropped events since boot.
+ */
+uint32_t ppi_trace_capture_dropped_get(void);
+
 /** @brief Enable PPI trace pin.
  *
  * @param handle	Handle.
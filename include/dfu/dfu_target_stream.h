@@ -82,6 +82,11 @@ int dfu_target_stream_offset_get(size_t *offset);
 /**
  * @brief Write a chunk of firmware data.
  *
+ * With `CONFIG_DFU_TARGET_STREAM_ASYNC`, the data is copied and programmed
+ * by a writer thread, and this function blocks only while both fragment
+ * buffers are in use. A write error is then returned by a later call to
+ * this function or to @ref dfu_target_stream_done.
+ *
  * @param[in] buf Pointer to data that should be written.
  * @param[in] len Length of data to write.
  *
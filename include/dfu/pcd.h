@@ -116,6 +116,8 @@ const void *pcd_cmd_data_ptr_get(void);
  *
  * Use the information in the PCD CMD to load a DFU image to the
  * provided flash device.
+ * Each chunk is read back and compared to the source as it is written, so
+ * the image does not need to be verified again after the transfer.
  *
  * @param fdev The flash device to transfer the DFU image to.
  *
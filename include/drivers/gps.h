@@ -242,6 +242,17 @@ enum gps_event_type {
 	GPS_EVT_OPERATION_UNBLOCKED,
 	GPS_EVT_AGPS_DATA_NEEDED,
 	GPS_EVT_ERROR,
+	GPS_EVT_PVT_FIX_BATCH,
+};
+
+/**
+ * @brief Batch of position fixes, for drivers that support batching.
+ */
+struct gps_pvt_batch {
+	/** Position fixes, oldest first. Only valid in the event handler. */
+	const struct gps_pvt *fixes;
+	/** Number of position fixes. */
+	size_t count;
 };
 
 /**
@@ -259,6 +270,7 @@ struct gps_event {
 		struct gps_nmea nmea;
 		struct gps_agps_request agps_request;
 		enum gps_error error;
+		struct gps_pvt_batch pvt_batch;
 	};
 };
 
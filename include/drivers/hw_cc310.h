@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _HW_CC310_H_
+#define _HW_CC310_H_
+
+/**
+ * @file hw_cc310.h
+ *
+ * @brief Job queue API of the CC3xx hardware driver.
+ *
+ * Jobs submitted to the queue are executed one at a time by a dedicated
+ * thread, so users of the CryptoCell do not contend for it directly. Queued
+ * jobs of the same type are executed back-to-back.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <zephyr/types.h>
+#include <kernel.h>
+#include <sys/slist.h>
+
+/** @brief Type of a CryptoCell job. */
+enum hw_cc3xx_job_type {
+	/** Hash or HMAC operation. */
+	HW_CC3XX_JOB_HASH,
+
+	/** AES operation. */
+	HW_CC3XX_JOB_AES,
+
+	/** Random data generation. */
+	HW_CC3XX_JOB_TRNG,
+
+	/** Any other operation. */
+	HW_CC3XX_JOB_OTHER,
+
+	/** Number of job types. */
+	HW_CC3XX_JOB_TYPE_COUNT
+};
+
+/** @brief Job handler.
+ *
+ * Handler is called in the context of the job queue thread and can use
+ * the CryptoCell APIs.
+ *
+ * @param[in] ctx Job context.
+ *
+ * @return Result of the job.
+ */
+typedef int (*hw_cc3xx_job_handler_t)(void *ctx);
+
+/** @brief CryptoCell job. */
+struct hw_cc3xx_job {
+	/** Used internally by the job queue. */
+	sys_snode_t node;
+
+	/** Used internally to signal job completion. */
+	struct k_sem done;
+
+	/** Used internally to measure wait time. */
+	uint32_t submit_cycles;
+
+	/** Job type. */
+	enum hw_cc3xx_job_type type;
+
+	/** Job handler. */
+	hw_cc3xx_job_handler_t handler;
+
+	/** Context passed to the handler. */
+	void *ctx;
+
+	/** Value returned by the handler. */
+	int result;
+
+	/** Time the job waited in the queue, in microseconds. */
+	uint32_t wait_us;
+
+	/** Time of the job execution, in microseconds. */
+	uint32_t exec_us;
+};
+
+/** @brief Statistics of jobs of a given type. */
+struct hw_cc3xx_job_stats {
+	/** Number of executed jobs. */
+	uint32_t count;
+
+	/** Total wait time, in microseconds. */
+	uint64_t wait_us;
+
+	/** Maximum wait time, in microseconds. */
+	uint32_t wait_max_us;
+
+	/** Total execution time, in microseconds. */
+	uint64_t exec_us;
+
+	/** Maximum execution time, in microseconds. */
+	uint32_t exec_max_us;
+};
+
+/** @brief Initialize a job.
+ *
+ * @param[out] job Job to initialize.
+ * @param[in] type Job type.
+ * @param[in] handler Job handler.
+ * @param[in] ctx Context passed to the handler.
+ */
+void hw_cc3xx_job_init(struct hw_cc3xx_job *job, enum hw_cc3xx_job_type type,
+		       hw_cc3xx_job_handler_t handler, void *ctx);
+
+/** @brief Submit a job to the queue.
+ *
+ * The job must stay valid until it is completed.
+ *
+ * @param[in] job Initialized job.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If the job is invalid.
+ */
+int hw_cc3xx_job_submit(struct hw_cc3xx_job *job);
+
+/** @brief Wait for completion of a submitted job.
+ *
+ * @param[in] job Submitted job.
+ * @param[in] timeout Waiting period.
+ *
+ * @retval 0 If the job was completed. The result is stored in the job.
+ * @retval -EAGAIN If the waiting period timed out.
+ */
+int hw_cc3xx_job_wait(struct hw_cc3xx_job *job, k_timeout_t timeout);
+
+/** @brief Execute a job and wait for its completion.
+ *
+ * If called before the kernel is started or from a job handler, the job is
+ * executed directly.
+ *
+ * @param[in] type Job type.
+ * @param[in] handler Job handler.
+ * @param[in] ctx Context passed to the handler.
+ *
+ * @return Value returned by the handler.
+ */
+int hw_cc3xx_job_run(enum hw_cc3xx_job_type type,
+		     hw_cc3xx_job_handler_t handler, void *ctx);
+
+/** @brief Get statistics of jobs of a given type.
+ *
+ * @param[in] type Job type.
+ * @param[out] stats Statistics.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If the job type is invalid.
+ */
+int hw_cc3xx_job_stats_get(enum hw_cc3xx_job_type type,
+			   struct hw_cc3xx_job_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _HW_CC310_H_ */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _UART_NRF_SW_LPUART_H_
+#define _UART_NRF_SW_LPUART_H_
+
+/**
+ * @file uart_nrf_sw_lpuart.h
+ *
+ * @brief Extensions of the low power UART driver API.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <zephyr/types.h>
+#include <device.h>
+
+/** @brief Low power UART receiver statistics. */
+struct lpuart_stats {
+	/** Number of receiver activations. */
+	uint32_t rx_transfers;
+
+	/** Number of HFCLK requests made for the receiver. */
+	uint32_t clk_requests;
+
+	/** Number of receiver activations that used HFCLK kept running since
+	 *  a previous transfer or requested by the burst mode.
+	 */
+	uint32_t clk_reuses;
+
+	/** Total time spent waiting for HFCLK to start, in microseconds.
+	 *  Average handshake latency saved by each clock reuse is
+	 *  clk_startup_time_us / clk_requests.
+	 */
+	uint64_t clk_startup_time_us;
+
+	/** Total time HFCLK was kept running while the receiver was idle,
+	 *  in microseconds. It is the power cost of the linger time and the
+	 *  burst mode.
+	 */
+	uint64_t clk_idle_time_us;
+};
+
+/** @brief Start burst mode.
+ *
+ * HFCLK used by the receiver is requested and kept running until
+ * @ref lpuart_burst_stop is called. Receiver activation in a burst does not
+ * wait for the clock start-up.
+ *
+ * @param[in] dev Low power UART device.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENOTSUP If @kconfig{CONFIG_NRF_SW_LPUART_HFXO_ON_RX} is disabled.
+ * @retval -EIO If RX is not enabled.
+ */
+int lpuart_burst_start(const struct device *dev);
+
+/** @brief Stop burst mode.
+ *
+ * HFCLK is released after the linger time if the receiver is idle.
+ *
+ * @param[in] dev Low power UART device.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENOTSUP If @kconfig{CONFIG_NRF_SW_LPUART_HFXO_ON_RX} is disabled.
+ */
+int lpuart_burst_stop(const struct device *dev);
+
+/** @brief Get receiver statistics.
+ *
+ * @param[in] dev Low power UART device.
+ * @param[out] stats Statistics.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENOTSUP If @kconfig{CONFIG_NRF_SW_LPUART_STATS} is disabled.
+ */
+int lpuart_stats_get(const struct device *dev, struct lpuart_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _UART_NRF_SW_LPUART_H_ */
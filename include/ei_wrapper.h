@@ -71,6 +71,38 @@ size_t ei_wrapper_get_window_size(void);
 int ei_wrapper_add_data(const float *data, size_t data_size);
 
 
+/** Add signed 16-bit input data for the library.
+ *
+ * Size of the added data must be divisible by input frame size.
+ *
+ * Every value is multiplied by the scale set using
+ * @ref ei_wrapper_set_data_scale to get the floating-point value used by
+ * the library. If the wrapper stores the input data as signed 16-bit values,
+ * the data is converted only when it is read by the library.
+ *
+ * @param[in] data       Pointer to the buffer with input data.
+ * @param[in] data_size  Size of the data (number of values).
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int ei_wrapper_add_data_int16(const int16_t *data, size_t data_size);
+
+
+/** Set scale of signed 16-bit input data.
+ *
+ * The scale is a floating-point value represented by a single step of the
+ * signed 16-bit input data. The default scale is 1.0. The scale should be
+ * set before any data is added.
+ *
+ * @param[in] scale  Scale of the input data. Must be bigger than zero.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int ei_wrapper_set_data_scale(float scale);
+
+
 /** Clear all buffered data.
  *
  * The buffer cannot be cleared if the prediction was already started and the
@@ -98,6 +130,10 @@ int ei_wrapper_clear_data(bool *cancelled);
  * @param[in] frame_shift   Number of frames the input window is shifted before
  *                          prediction.
  *
+ * If continuous classification is enabled, the input window must be shifted
+ * by a multiple of the slice size. Otherwise, the -EINVAL error code is
+ * returned.
+ *
  * @retval 0 If the operation was successful.
  *           Otherwise, a (negative) error code is returned.
  */
@@ -206,13 +206,65 @@ struct esb_payload {
 		       *  ack is enabled.
 		       */
 	uint8_t pid;    /**< PID assigned during communication. */
+#if defined(CONFIG_ESB_TIMESTAMP) || defined(__DOXYGEN__)
+	uint32_t timestamp; /**< Kernel cycle counter value when the packet
+			     *  was received. Not used for TX payloads.
+			     */
+#endif
 	uint8_t data[CONFIG_ESB_MAX_PAYLOAD_LENGTH]; /**< The payload data. */
 };
 
+/** @brief Statistics of one RF channel. */
+struct esb_channel_stats {
+	uint8_t channel;      /**< RF channel. */
+	uint32_t tx_success;  /**< Packets sent successfully as PTX. */
+	uint32_t tx_failed;   /**< Packets that used all retransmits. */
+	uint32_t tx_attempts; /**< Transmissions including retransmits. */
+	uint32_t rx_packets;  /**< Valid packets received as PRX. */
+};
+
+/** @brief TX statistics of one pipe. */
+struct esb_pipe_stats {
+	uint32_t tx_success;  /**< Packets sent successfully. */
+	uint32_t tx_failed;   /**< Packets that used all retransmits. */
+	uint32_t tx_attempts; /**< Transmissions including retransmits. */
+};
+
 /** @brief Enhanced ShockBurst event. */
 struct esb_evt {
 	enum esb_evt_id evt_id;	/**< Enhanced ShockBurst event ID. */
 	uint32_t tx_attempts;	/**< Number of TX retransmission attempts. */
+#if defined(CONFIG_ESB_TIMESTAMP) || defined(__DOXYGEN__)
+	uint32_t tx_latency;	/**< Time in microseconds from the start of
+				 *  the first attempt until the packet was
+				 *  acknowledged, or sent for packets
+				 *  without ACK.
+				 */
+#endif
+};
+
+/** Number of buckets of the TX latency histogram. */
+#define ESB_LATENCY_HIST_BUCKETS 16
+
+/** Number of buckets of the TX attempts histogram. */
+#define ESB_ATTEMPTS_HIST_BUCKETS 8
+
+/** @brief TX latency statistics of one pipe. */
+struct esb_latency_stats {
+	/** Bucket i counts latencies from 2^i to 2^(i+1) - 1 microseconds.
+	 *  Bucket 0 also counts 0, and the last bucket counts all higher
+	 *  latencies.
+	 */
+	uint32_t latency_hist[ESB_LATENCY_HIST_BUCKETS];
+	/** Bucket i counts packets sent in i + 1 attempts. The last bucket
+	 *  counts all packets that needed more attempts.
+	 */
+	uint32_t attempts_hist[ESB_ATTEMPTS_HIST_BUCKETS];
+	uint32_t count;		/**< Number of packets sent. */
+	uint32_t failed;	/**< Number of packets that failed. */
+	uint32_t latency_min;	/**< Smallest latency in microseconds. */
+	uint32_t latency_max;	/**< Largest latency in microseconds. */
+	uint64_t latency_sum;	/**< Sum of latencies in microseconds. */
 };
 
 /** @brief Event handler prototype. */
@@ -299,6 +351,43 @@ bool esb_is_idle(void);
  */
 int esb_write_payload(const struct esb_payload *payload);
 
+/** @brief Reserve a TX FIFO slot for a payload.
+ *
+ *  This function gives access to the next free slot of the TX FIFO, so that
+ *  the application can write the payload in place instead of copying it
+ *  with @ref esb_write_payload. Set the length, pipe, noack flag and data of
+ *  the payload, and then call @ref esb_commit_tx_payload to queue it.
+ *  Only one slot can be reserved at a time, and @ref esb_write_payload is
+ *  not available while a slot is reserved. This function can only be used
+ *  in PTX mode.
+ *
+ *  @param[out]  payload     Pointer to the reserved payload.
+ *
+ * @retval 0 If successful.
+ * @retval -ENOMEM If the TX FIFO is full.
+ * @retval -EBUSY If a slot is already reserved.
+ * @retval -ENOTSUP If the module is not in PTX mode.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int esb_reserve_tx_payload(struct esb_payload **payload);
+
+/** @brief Queue the payload reserved with @ref esb_reserve_tx_payload.
+ *
+ *  In automatic TX mode, the transmission starts if the module is idle.
+ *  If the payload is invalid, it stays reserved.
+ *
+ * @retval 0 If successful.
+ * @retval -EINVAL If no slot is reserved or the pipe is invalid.
+ * @retval -EMSGSIZE If the payload length is invalid.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int esb_commit_tx_payload(void);
+
+/** @brief Release the slot reserved with @ref esb_reserve_tx_payload
+ *  without queuing it.
+ */
+void esb_cancel_tx_payload(void);
+
 /** @brief Read a payload.
  *
  *  @param[in,out] payload	The payload to be received.
@@ -441,6 +530,90 @@ int esb_set_rf_channel(uint32_t channel);
  */
 int esb_get_rf_channel(uint32_t *channel);
 
+/** @brief Set the list of channels to hop across.
+ *
+ *  Requires @kconfig{CONFIG_ESB_ADAPTIVE}. A PTX moves to the next channel of
+ *  the list after each transmission that used all retransmits. A PRX moves
+ *  to the next channel when it has not received a valid packet for
+ *  @kconfig{CONFIG_ESB_PRX_HOP_DWELL_MS}. Both sides must use the same
+ *  list. The module starts on the first channel of the list. Calling
+ *  @ref esb_set_rf_channel replaces the list with a single channel.
+ *
+ *  The module must be in an idle state to call this function.
+ *
+ *  @param[in] channels	Channel list.
+ *  @param[in] count	Number of channels, up to
+ *			@kconfig{CONFIG_ESB_HOP_CHANNELS_MAX}.
+ *
+ * @retval 0 If successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int esb_set_hop_channels(const uint8_t *channels, uint8_t count);
+
+/** @brief Get the statistics of the hopping channels.
+ *
+ *  Requires @kconfig{CONFIG_ESB_ADAPTIVE}.
+ *
+ *  @param[out]    stats	Array of channel statistics.
+ *  @param[in,out] count	Size of the array. Set to the number of
+ *				channels written.
+ *
+ * @retval 0 If successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int esb_get_channel_stats(struct esb_channel_stats *stats, uint8_t *count);
+
+/** @brief Get the TX statistics of a pipe.
+ *
+ *  Requires @kconfig{CONFIG_ESB_ADAPTIVE}.
+ *
+ *  @param[in]  pipe	Pipe.
+ *  @param[out] stats	Pipe statistics.
+ *
+ * @retval 0 If successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int esb_get_pipe_stats(uint8_t pipe, struct esb_pipe_stats *stats);
+
+/** @brief Get the TX latency statistics of a pipe.
+ *
+ *  Requires @kconfig{CONFIG_ESB_TIMESTAMP}.
+ *
+ *  @param[in]  pipe	Pipe.
+ *  @param[out] stats	Latency statistics.
+ *
+ * @retval 0 If successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int esb_get_latency_stats(uint8_t pipe, struct esb_latency_stats *stats);
+
+/** @brief Reset the TX latency statistics of all pipes.
+ *
+ *  Requires @kconfig{CONFIG_ESB_TIMESTAMP}.
+ */
+void esb_reset_latency_stats(void);
+
+/** @brief Reset the channel and pipe statistics.
+ *
+ *  Requires @kconfig{CONFIG_ESB_ADAPTIVE}.
+ */
+void esb_reset_stats(void);
+
+/** @brief Get the retransmit delay in use.
+ *
+ *  Requires @kconfig{CONFIG_ESB_ADAPTIVE}. The delay grows by steps while
+ *  packets need on average more than two attempts, up to
+ *  @kconfig{CONFIG_ESB_RETRANSMIT_DELAY_MAX}. It returns to the delay set
+ *  with @ref esb_set_retransmit_delay when most packets succeed at the
+ *  first attempt.
+ *
+ *  @param[out] delay	Retransmit delay in microseconds.
+ *
+ * @retval 0 If successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int esb_get_retransmit_delay(uint16_t *delay);
+
 /** @brief Set the radio output power.
  *
  *  @param[in] tx_output_power	Output power.
@@ -54,6 +54,27 @@ extern "C" {
 #define SUBS_PRIO_COUNT (SUBS_PRIO_MAX - SUBS_PRIO_MIN + 1)
 
 
+/** @brief Event queue identifiers.
+ *
+ * Every event queue is processed by a separate work queue. Events of a given
+ * type are processed in order of submission within the queue the event type is
+ * assigned to.
+ */
+enum event_queue_id {
+	/** Queue processed by the system work queue. */
+	EVENT_QUEUE_DEFAULT,
+
+	/** Queue for latency-critical events. */
+	EVENT_QUEUE_REALTIME,
+
+	/** Queue for events that are not time-critical. */
+	EVENT_QUEUE_BULK,
+
+	/** Number of event queues. */
+	EVENT_QUEUE_COUNT
+};
+
+
 /** @brief Event header.
  *
  * When defining an event structure, the event header
@@ -65,6 +86,17 @@ struct event_header {
 
 	/** Pointer to the event type object. */
 	const struct event_type *type_id;
+
+#ifdef CONFIG_EVENT_MANAGER_STATS
+	/** Hardware cycle count at the event submission. */
+	uint32_t submit_time;
+#endif
+
+#ifdef CONFIG_EVENT_MANAGER_EVENT_REF
+	/** Number of references to the event, including the one held by
+	 *  the Event Manager while the event is processed. */
+	atomic_t ref_cnt;
+#endif
 };
 
 
@@ -82,6 +114,60 @@ struct event_dyndata {
 };
 
 
+/** @def EVENT_MANAGER_STATS_HIST_LEN
+ *
+ * @brief Number of buckets of the listener execution time histogram.
+ */
+#define EVENT_MANAGER_STATS_HIST_LEN 12
+
+
+/** @brief Event type statistics.
+ */
+struct event_type_stats {
+	/** Number of submitted events. */
+	atomic_t submitted;
+
+	/** Number of processed events. */
+	uint32_t processed;
+
+	/** Number of events consumed by a listener. */
+	uint32_t consumed;
+
+	/** Sum of the times events spent in the event queue, in microseconds. */
+	uint64_t latency_sum_us;
+
+	/** Longest time an event spent in the event queue, in microseconds. */
+	uint32_t latency_max_us;
+};
+
+
+/** @brief Event listener statistics.
+ */
+struct event_listener_stats {
+	/** Number of notifications. */
+	atomic_t calls;
+
+	/** Longest notification, in microseconds. */
+	atomic_t time_max_us;
+
+	/** Histogram of notification times. Bucket n counts the notifications
+	 *  shorter than 2^(n + 1) microseconds that are not counted by the
+	 *  previous buckets. The last bucket also counts longer ones. */
+	atomic_t time_hist[EVENT_MANAGER_STATS_HIST_LEN];
+};
+
+
+/** @brief Event queue statistics.
+ */
+struct event_queue_stats {
+	/** Number of events waiting for processing. */
+	uint32_t depth;
+
+	/** Maximum number of events waiting for processing. */
+	uint32_t depth_max;
+};
+
+
 /** @brief Event listener.
  *
  * All event listeners must be defined using @ref EVENT_LISTENER.
@@ -93,6 +179,11 @@ struct event_listener {
 	/** Pointer to the function that is called when an event
 	 *  is handled. */
 	bool (*notification)(const struct event_header *eh);
+
+#ifdef CONFIG_EVENT_MANAGER_STATS
+	/** Statistics of the listener. */
+	struct event_listener_stats *stats;
+#endif
 };
 
 
@@ -128,7 +219,11 @@ struct event_type {
 	/** Event name. */
 	const char			*name;
 
-	/** Array of pointers to the array of subscribers. */
+	/** Array of pointers to the array of subscribers.
+	 *
+	 * Arrays of subscribers of subsequent priority levels are placed
+	 * back to back, so that subscribers of all the priority levels form
+	 * a single array ordered by priority. */
 	const struct event_subscriber	*subs_start[SUBS_PRIO_COUNT];
 
 	/** Array of pointers to the element directly after the array of
@@ -144,6 +239,31 @@ struct event_type {
 
 	/** Logging and formatting information. */
 	const struct event_info *ev_info;
+
+#ifdef CONFIG_EVENT_MANAGER_MEM_SLAB
+	/** Memory slab used to allocate events of this type or NULL if
+	 *  events are allocated from the heap. */
+	struct k_mem_slab *mem_slab;
+
+	/** Maximum number of memory slab blocks used at the same time. */
+	atomic_t *mem_slab_max_used;
+#endif
+
+#ifdef CONFIG_EVENT_MANAGER_STATS
+	/** Statistics of the event type. */
+	struct event_type_stats *stats;
+#endif
+};
+
+
+/** @brief Assignment of an event type to an event queue.
+ */
+struct event_queue_assignment {
+	/** Pointer to the event type object. */
+	const struct event_type *type_id;
+
+	/** Queue used to process events of the type. */
+	enum event_queue_id queue;
 };
 
 
@@ -153,6 +273,9 @@ extern const struct event_listener __stop_event_listeners[];
 extern const struct event_type __start_event_types[];
 extern const struct event_type __stop_event_types[];
 
+extern const struct event_queue_assignment __start_event_queue_assignments[];
+extern const struct event_queue_assignment __stop_event_queue_assignments[];
+
 
 /** Create an event listener object.
  *
@@ -261,6 +384,46 @@ extern const struct event_type __stop_event_types[];
 	_EVENT_TYPE_DEFINE(ename, init_log_en, log_fn, ev_info_struct)
 
 
+/** Define an event type that is allocated from a memory slab.
+ *
+ * This macro works like @ref EVENT_TYPE_DEFINE, but in addition it defines
+ * a memory slab dedicated to events of the given type. Allocating and freeing
+ * such events does not use the heap, so it takes a constant time and does not
+ * fragment the heap memory.
+ *
+ * Memory slab blocks are sized for the event structure. Events with dynamic
+ * data that do not fit in a single block are allocated from the heap.
+ *
+ * If @kconfig{CONFIG_EVENT_MANAGER_MEM_SLAB} is disabled, the event type is
+ * allocated from the heap.
+ *
+ * @param ename     	   Name of the event.
+ * @param init_log_en	   Bool indicating if the event is logged
+ *                         by default.
+ * @param log_fn  	   Function to stringify an event of this type.
+ * @param ev_info_struct   Data structure describing the event type.
+ * @param slab_cnt	   Number of events of this type that can be allocated
+ *                         at the same time.
+ */
+#define EVENT_TYPE_MEM_SLAB_DEFINE(ename, init_log_en, log_fn, ev_info_struct, slab_cnt) \
+	_EVENT_TYPE_MEM_SLAB_DEFINE(ename, init_log_en, log_fn, ev_info_struct, slab_cnt)
+
+
+/** Assign an event type to an event queue.
+ *
+ * Events of types that are not assigned to any queue are processed in the
+ * @ref EVENT_QUEUE_DEFAULT queue. The assignment takes effect after
+ * @ref event_manager_init is called.
+ *
+ * If @kconfig{CONFIG_EVENT_MANAGER_QUEUES} is disabled, all events are
+ * processed in the @ref EVENT_QUEUE_DEFAULT queue.
+ *
+ * @param ename  Name of the event.
+ * @param queue  Event queue identifier (@ref event_queue_id).
+ */
+#define EVENT_QUEUE_ASSIGN(ename, queue) _EVENT_QUEUE_ASSIGN(ename, queue)
+
+
 /** Verify if an event ID is valid.
  *
  * The pointer to an event type structure is used as its ID. This macro
@@ -273,6 +436,19 @@ extern const struct event_type __stop_event_types[];
 	__ASSERT_NO_MSG((id >= __start_event_types) && (id < __stop_event_types))
 
 
+/** Allocate memory for an event of the given type.
+ *
+ * The memory is taken from the memory slab of the event type if the event
+ * fits in a slab block. Otherwise, the memory is allocated from the heap.
+ *
+ * @param et    Pointer to the event type object.
+ * @param size  Size of the event, including dynamic data.
+ *
+ * @return Pointer to the allocated memory or NULL if out of memory.
+ */
+void *_event_manager_alloc(const struct event_type *et, size_t size);
+
+
 /** Submit an event to the Event Manager.
  *
  * @param eh  Pointer to the event header element in the event object.
@@ -289,6 +465,29 @@ void _event_submit(struct event_header *eh);
 #define EVENT_SUBMIT(event) _event_submit(&event->header)
 
 
+/** Submit a batch of events.
+ *
+ * All events from the list are added to the event queues under a single lock
+ * and the processing of every affected event queue is scheduled only once.
+ * The order of events within the list is preserved. After the call the list
+ * is empty.
+ *
+ * @param events  List of events, built with @ref EVENT_BATCH_APPEND.
+ */
+void event_submit_batch(sys_slist_t *events);
+
+
+/** Add an event to a batch of events.
+ *
+ * The batch is submitted with @ref event_submit_batch.
+ *
+ * @param events  Pointer to the list of events.
+ * @param event   Pointer to the event object.
+ */
+#define EVENT_BATCH_APPEND(events, event) \
+	sys_slist_append(events, &(event)->header.node)
+
+
 /** Initialize the Event Manager.
  *
  * @retval 0 If the operation was successful.
@@ -296,6 +495,53 @@ void _event_submit(struct event_header *eh);
 int event_manager_init(void);
 
 
+#ifdef CONFIG_EVENT_MANAGER_EVENT_REF
+/** Take a reference to an event.
+ *
+ * A listener can take a reference to keep the event after its notification
+ * returns, for example to process it later in another thread without copying
+ * it. The event is freed when the Event Manager has processed it and all
+ * references are released.
+ *
+ * @param eh  Pointer to the event header element in the event object.
+ */
+void event_manager_event_ref(const struct event_header *eh);
+
+
+/** Release a reference to an event.
+ *
+ * The event must not be accessed after its reference is released.
+ *
+ * @param eh  Pointer to the event header element in the event object.
+ */
+void event_manager_event_unref(const struct event_header *eh);
+#endif /* CONFIG_EVENT_MANAGER_EVENT_REF */
+
+
+#ifdef CONFIG_EVENT_MANAGER_STATS
+/** Get the statistics of an event queue.
+ *
+ * The statistics of event types and listeners are available through
+ * their stats fields.
+ *
+ * @param queue  Event queue identifier.
+ * @param stats  Pointer to the structure filled with the statistics.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If the event queue is not used.
+ */
+int event_manager_queue_stats_get(enum event_queue_id queue,
+				  struct event_queue_stats *stats);
+
+
+/** Reset the event statistics.
+ *
+ * Events that are processed during the reset can be partially counted.
+ */
+void event_manager_stats_reset(void);
+#endif
+
+
 #ifdef __cplusplus
 }
 #endif
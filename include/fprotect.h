@@ -38,6 +38,35 @@ extern "C" {
  */
 int fprotect_area(uint32_t start, size_t length);
 
+/** @brief Flash region to protect. */
+struct fprotect_region {
+	/** Start of the region. */
+	uint32_t start;
+	/** Length of the region in bytes. */
+	size_t length;
+};
+
+/**
+ * @brief Protect a list of flash areas against writes.
+ *
+ * Overlapping and adjacent regions are merged, and the hardware is
+ * configured with as few register writes and protection regions as
+ * possible. This is faster than calling @ref fprotect_area for each region
+ * and, on devices with a limited number of protection regions, uses fewer
+ * of them.
+ *
+ * @param[in]  regions  Regions to protect.
+ * @param[in]  count    Number of regions.
+ *
+ * @retval 0        On success.
+ * @retval -EINVAL  If any of the regions is not aligned to
+ *                  CONFIG_FPROTECT_BLOCK_SIZE or is outside of flash.
+ * @retval -EFAULT  If the protection was not applied properly.
+ * @retval -ENOSPC  If there are not enough configuration registers for
+ *                  the merged regions.
+ */
+int fprotect_areas(const struct fprotect_region *regions, size_t count);
+
 #if defined(CONFIG_FPROTECT_ENABLE_NO_ACCESS)
 /**
  * @brief Protect flash area against reads/writes.
@@ -54,6 +54,37 @@ enum at_cmd_state {
  */
 typedef void (*at_cmd_handler_t)(const char *response);
 
+/**
+ * @typedef at_cmd_complete_handler_t
+ *
+ * Completion handler for commands sent with at_cmd_write_async().
+ *
+ * @param response  Null terminated string containing the modem response,
+ *                  without the final result code. NULL if the command could
+ *                  not be written or the response could not be read.
+ * @param state     State of the AT command.
+ * @param code      Return code of the AT command, with the same meaning as
+ *                  the return value of at_cmd_write().
+ * @param user_data User data passed to at_cmd_write_async().
+ */
+typedef void (*at_cmd_complete_handler_t)(const char *response,
+					  enum at_cmd_state state, int code,
+					  void *user_data);
+
+/** @brief AT command timing statistics, in milliseconds. */
+struct at_cmd_stats {
+	/** Number of completed commands. */
+	uint32_t cmd_count;
+	/** Longest time a command waited in the queue before being sent. */
+	uint32_t queue_time_max;
+	/** Longest time from sending a command to receiving its response. */
+	uint32_t exec_time_max;
+	/** Total time spent by all commands in the queue. */
+	uint64_t queue_time_total;
+	/** Total time spent by all commands waiting for a response. */
+	uint64_t exec_time_total;
+};
+
 /**@brief Initialize or recover the AT command driver.
  *
  * @return Zero on success, non-zero otherwise.
@@ -90,6 +121,32 @@ int at_cmd_init(void);
 int at_cmd_write_with_callback(const char *const cmd,
 					  at_cmd_handler_t  handler);
 
+/**
+ * @brief Function to queue an AT command without waiting for the response.
+ *
+ * The command is copied and queued behind the commands submitted by other
+ * threads. The modem processes one command at a time, in the order they were
+ * queued. When the command completes, @p handler is called with the response
+ * and its result.
+ *
+ * @param cmd       Pointer to null terminated AT command string.
+ * @param handler   Completion handler. NULL pointer is allowed.
+ * @param user_data User data passed to @p handler.
+ *
+ * @note The handler function runs from at_cmd's thread, or from the calling
+ *       thread if the command could not be written to the modem. It must not
+ *       call at_cmd_write, as that would lead to a deadlock.
+ *
+ * @retval 0 If the command was queued.
+ * @retval -EINVAL is returned if the command is invalid.
+ * @retval -ENOMEM is returned if the command could not be copied.
+ * @retval -ENOBUFS is returned if the command queue is full.
+ * @retval -EHOSTDOWN is returned if the Modem library is shutdown.
+ */
+int at_cmd_write_async(const char *const cmd,
+		       at_cmd_complete_handler_t handler,
+		       void *user_data);
+
 /**
  * @brief Function to send an AT command and receive response immediately
  *
@@ -143,6 +200,25 @@ int at_cmd_write(const char *const cmd,
  */
 void at_cmd_set_notification_handler(at_cmd_handler_t handler);
 
+/**
+ * @brief Get the AT command timing statistics.
+ *
+ * Requires @kconfig{CONFIG_AT_CMD_STATS}.
+ *
+ * @param stats Pointer to the structure to fill.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL is returned if @p stats is NULL.
+ */
+int at_cmd_stats_get(struct at_cmd_stats *stats);
+
+/**
+ * @brief Reset the AT command timing statistics.
+ *
+ * Requires @kconfig{CONFIG_AT_CMD_STATS}.
+ */
+void at_cmd_stats_reset(void);
+
 /** @} */
 
 #ifdef __cplusplus
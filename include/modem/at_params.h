@@ -22,11 +22,18 @@
  * All parameters values are copied in the list. Parameters should be
  * cleared to free that memory. Getter and setter methods are available
  * to read and write parameter values.
+ *
+ * A list can optionally be switched to string view mode. In that mode,
+ * string parameters reference the buffer they were parsed from instead of
+ * being copied, so that buffer must stay valid for as long as the
+ * parameters are read.
  */
 #ifndef AT_PARAMS_H__
 #define AT_PARAMS_H__
 
+#include <stdbool.h>
 #include <zephyr/types.h>
+#include <toolchain.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -63,6 +70,29 @@ struct at_param {
 	union at_param_value value;
 };
 
+/**
+ * @brief Caller-supplied storage for a list of parameters.
+ *
+ * Placed at the beginning of the buffer passed to
+ * @ref at_params_list_init_static.
+ */
+struct at_param_arena {
+	size_t size;
+	size_t used;
+	uint8_t data[] __aligned(sizeof(int64_t));
+};
+
+/**
+ * @brief Size of a buffer for @ref at_params_list_init_static.
+ *
+ * @param max_params_count Maximum number of parameters in the list.
+ * @param data_size        Space needed for string and array values. Each
+ *                         value is rounded up to a multiple of 4 bytes.
+ */
+#define AT_PARAMS_ARENA_SIZE(max_params_count, data_size)		\
+	(sizeof(struct at_param_arena) + __alignof__(struct at_param_arena) +	\
+	 (max_params_count) * sizeof(struct at_param) + (data_size))
+
 /**
  * @brief List of AT parameters that compose an AT command or response.
  *
@@ -72,6 +102,10 @@ struct at_param {
 struct at_param_list {
 	size_t param_count;
 	struct at_param *params;
+	/** String parameters reference the source buffer instead of a copy. */
+	bool string_view;
+	/** Storage for parameters, NULL if the heap is used. */
+	struct at_param_arena *arena;
 };
 
 /**
@@ -90,6 +124,45 @@ struct at_param_list {
  */
 int at_params_list_init(struct at_param_list *list, size_t max_params_count);
 
+/**
+ * @brief Create a list of parameters in a caller-supplied buffer.
+ *
+ * Works like @ref at_params_list_init, but the parameter array and all
+ * string and array values are allocated from @p buf instead of the heap.
+ * Clearing the list releases all values at once. Values replaced without
+ * clearing the list are not released until the list is cleared.
+ * Use @ref AT_PARAMS_ARENA_SIZE to calculate the size of @p buf.
+ *
+ * @param[in] list             Parameter list to initialize.
+ * @param[in] max_params_count Maximum number of element that the list can
+ *                             store.
+ * @param[in] buf              Buffer for the parameter storage.
+ * @param[in] buf_size         Size of @p buf in bytes.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int at_params_list_init_static(struct at_param_list *list,
+			       size_t max_params_count,
+			       void *buf, size_t buf_size);
+
+/**
+ * @brief Enable or disable string view mode for a list of parameters.
+ *
+ * In string view mode, @ref at_params_string_put stores a reference to the
+ * provided string instead of copying it to the heap. The referenced buffer
+ * must remain valid and unchanged until the list is cleared. The list is
+ * cleared when the mode is changed.
+ *
+ * @param[in] list   Parameter list.
+ * @param[in] enable True to store string parameters as references,
+ *                   false to copy them.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int at_params_list_string_view_set(struct at_param_list *list, bool enable);
+
 /**
  * @brief Clear/reset all parameter types and values.
  *
@@ -103,6 +176,8 @@ void at_params_list_clear(struct at_param_list *list);
  * @brief Free a list of parameters.
  *
  * First the list is cleared. Then the list and its elements are deleted.
+ * For a list created with @ref at_params_list_init_static, the buffer
+ * is released to the caller.
  *
  * @param[in] list Parameter list to free.
  */
@@ -129,6 +204,8 @@ int at_params_int_put(const struct at_param_list *list, size_t index, int64_t va
  *
  * The parameter string value is copied and added to the list as a
  * null-terminated string. If a parameter exists at this index, it is replaced.
+ * If the list is in string view mode, only a reference to @p str is stored,
+ * and the stored string is not null-terminated.
  *
  * @param[in] list    Parameter list.
  * @param[in] index   Index in the list where to put the parameter.
@@ -276,6 +353,24 @@ int at_params_int64_get(const struct at_param_list *list, size_t index, int64_t
 int at_params_string_get(const struct at_param_list *list, size_t index,
 			 char *value, size_t *len);
 
+/**
+ * @brief Get a pointer to a string parameter value.
+ *
+ * The parameter type must be a string, or an error is returned.
+ * No data is copied. The returned string is not guaranteed to be
+ * null-terminated and is valid until the parameter is cleared or replaced.
+ *
+ * @param[in]  list   Parameter list.
+ * @param[in]  index  Parameter index in the list.
+ * @param[out] str    Pointer to the string value.
+ * @param[out] len    Length of the string value in bytes.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int at_params_string_ptr_get(const struct at_param_list *list, size_t index,
+			     const char **str, size_t *len);
+
 /**
  * @brief Get a parameter value as a array.
  *
@@ -603,6 +603,26 @@ struct lte_lc_evt {
 
 typedef void(*lte_lc_evt_handler_t)(const struct lte_lc_evt *const evt);
 
+/** @brief Link state. */
+struct lte_lc_link_state {
+	/** Network registration status. */
+	enum lte_lc_nw_reg_status nw_reg_status;
+	/** Serving cell. The cell ID is LTE_LC_CELL_EUTRAN_ID_INVALID when not
+	 *  registered.
+	 */
+	struct lte_lc_cell cell;
+	/** Currently active LTE mode. */
+	enum lte_lc_lte_mode lte_mode;
+	/** PSM configuration given by the network. The values are -1 when not
+	 *  registered.
+	 */
+	struct lte_lc_psm_cfg psm_cfg;
+	/** RRC mode. */
+	enum lte_lc_rrc_mode rrc_mode;
+	/** Functional mode. */
+	enum lte_lc_func_mode func_mode;
+};
+
 /** @brief Register event handler for LTE events.
  *
  *  @param handler Event handler. Handler is de-registered if parameter is
@@ -725,6 +745,9 @@ int lte_lc_psm_req(bool enable);
  * @param active_time Pointer to the variable for parsed active time in seconds.
  *	              Positive integer, or -1 if timer is deactivated.
  *
+ * If @kconfig{CONFIG_LTE_LC_STATE_CACHE} is enabled, the cached value is
+ * returned when available. See lte_lc_link_state_get().
+ *
  * @return Zero on success or (negative) error code otherwise.
  */
 int lte_lc_psm_get(int *tau, int *active_time);
@@ -791,6 +814,9 @@ int lte_lc_rai_param_set(const char *value);
 int lte_lc_rai_req(bool enable);
 
 /** @brief Get the current network registration status.
+ *
+ * If @kconfig{CONFIG_LTE_LC_STATE_CACHE} is enabled, the cached value is
+ * returned when available. See lte_lc_link_state_get().
  *
  * @param status Pointer for network registration status.
  *
@@ -809,6 +835,9 @@ int lte_lc_system_mode_set(enum lte_lc_system_mode mode,
 			   enum lte_lc_system_mode_preference preference);
 
 /** @brief Get the modem's system mode and LTE preference.
+ *
+ * If @kconfig{CONFIG_LTE_LC_STATE_CACHE} is enabled, the cached value is
+ * returned when available. See lte_lc_link_state_get().
  *
  * @param mode Pointer to system mode variable.
  * @param preference Pointer to system mode preference variable. Can be NULL.
@@ -827,6 +856,9 @@ int lte_lc_system_mode_get(enum lte_lc_system_mode *mode,
 int lte_lc_func_mode_set(enum lte_lc_func_mode mode);
 
 /** @brief Get the modem's functional mode.
+ *
+ * If @kconfig{CONFIG_LTE_LC_STATE_CACHE} is enabled, the cached value is
+ * returned when available. See lte_lc_link_state_get().
  *
  * @param mode Pointer to functional mode variable.
  *
@@ -835,6 +867,9 @@ int lte_lc_func_mode_set(enum lte_lc_func_mode mode);
 int lte_lc_func_mode_get(enum lte_lc_func_mode *mode);
 
 /** @brief Get the currently active LTE mode.
+ *
+ * If @kconfig{CONFIG_LTE_LC_STATE_CACHE} is enabled, the cached value is
+ * returned when available. See lte_lc_link_state_get().
  *
  * @param mode Pointer to LTE mode variable.
  *
@@ -842,6 +877,23 @@ int lte_lc_func_mode_get(enum lte_lc_func_mode *mode);
  */
 int lte_lc_lte_mode_get(enum lte_lc_lte_mode *mode);
 
+/** @brief Get the link state.
+ *
+ * If @kconfig{CONFIG_LTE_LC_STATE_CACHE} is enabled, the state is kept current
+ * from modem notifications, and the cached state is returned unless
+ * @p refresh is set. Otherwise, the state is always read from the modem.
+ *
+ * Reading the state from the modem also updates the values returned by the
+ * other getters, and makes the next call to lte_lc_system_mode_get() read
+ * the system mode from the modem.
+ *
+ * @param state Pointer to the link state.
+ * @param refresh Read the state from the modem instead of the cache.
+ *
+ * @return Zero on success or (negative) error code otherwise.
+ */
+int lte_lc_link_state_get(struct lte_lc_link_state *state, bool refresh);
+
 /** @brief Initiate a neighbor cell measurement.
  *	   The result of the measurement is reported back as an event of the type
  *	   LTE_LC_EVT_NEIGHBOR_CELL_MEAS, meaning that an event handler must be
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#ifndef ZEPHYR_INCLUDE_LTE_LINK_CONTROL_TX_SCHED_H_
+#define ZEPHYR_INCLUDE_LTE_LINK_CONTROL_TX_SCHED_H_
+
+#include <stdbool.h>
+#include <zephyr/types.h>
+#include <sys/slist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file lte_lc_tx_sched.h
+ *
+ * @brief Scheduling of deferred transmissions to the active windows of the
+ *	  LTE link.
+ * @defgroup lte_lc_tx_sched LTE link control transmission scheduling
+ * @{
+ */
+
+struct lte_lc_tx;
+
+/** @brief Deferred transmission handler.
+ *
+ * Called from the system workqueue, together with the other pending
+ * handlers, when the transmission is due.
+ *
+ * @param tx The deferred transmission. Use CONTAINER_OF() to get the
+ *	     structure it is embedded in.
+ */
+typedef void (*lte_lc_tx_handler_t)(struct lte_lc_tx *tx);
+
+/** @brief Deferred transmission.
+ *
+ * The structure is owned by the library from the call to lte_lc_tx_defer()
+ * until its handler is called or it is cancelled.
+ */
+struct lte_lc_tx {
+	/** Called when the transmission is due. */
+	lte_lc_tx_handler_t handler;
+
+	/** @cond INTERNAL_HIDDEN */
+	sys_snode_t node;
+	int64_t deadline;
+	/** @endcond */
+};
+
+/** @brief Predicted active window of the LTE link. */
+struct lte_lc_active_window {
+	/** RRC is connected. Data sent now does not need a new connection. */
+	bool rrc_connected;
+	/** Uptime, in milliseconds, at which the modem is predicted to connect
+	 *  on its own, for the next Tracking Area Update. -1 if unknown, for
+	 *  example when PSM is not in use.
+	 */
+	int64_t next_start;
+};
+
+/** @brief Defer a transmission to the next active window.
+ *
+ * Pending handlers are called together, as soon as one of the following
+ * happens:
+ * - RRC becomes connected.
+ * - A TAU pre-warning is received. Data sent then is sent in the same RRC
+ *   connection as the TAU.
+ * - The maximum delay of one of them expires.
+ *
+ * If RRC is connected when this function is called, the handler is called
+ * right away.
+ *
+ * @param tx Deferred transmission, with the handler set.
+ * @param max_delay_ms Maximum time, in milliseconds, to wait for an active
+ *		       window.
+ *
+ * @retval 0 If successful.
+ * @retval -EINVAL If @p tx or its handler is NULL.
+ * @retval -EALREADY If @p tx is already pending.
+ */
+int lte_lc_tx_defer(struct lte_lc_tx *tx, uint32_t max_delay_ms);
+
+/** @brief Cancel a deferred transmission.
+ *
+ * @param tx Deferred transmission.
+ *
+ * @retval 0 If successful.
+ * @retval -EINVAL If @p tx is not pending.
+ */
+int lte_lc_tx_cancel(struct lte_lc_tx *tx);
+
+/** @brief Get the predicted active window.
+ *
+ * @param window Pointer to the predicted active window.
+ *
+ * @retval 0 If successful.
+ * @retval -EINVAL If @p window is NULL.
+ */
+int lte_lc_active_window_get(struct lte_lc_active_window *window);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_LTE_LINK_CONTROL_TX_SCHED_H_ */
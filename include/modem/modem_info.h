@@ -195,25 +195,29 @@ int modem_info_name_get(enum modem_info info, char *name);
  */
 enum at_param_type modem_info_type_get(enum modem_info info);
 
-#ifdef CONFIG_CJSON_LIB
 #define MODEM_INFO_JSON_KEY_NET_INF	"networkInfo"
 #define MODEM_INFO_JSON_KEY_SIM_INF	"simInfo"
 #define MODEM_INFO_JSON_KEY_DEV_INF	"deviceInfo"
 
 /** @brief Encode the modem parameters.
  *
- * The data is added to the string buffer with JSON formatting.
+ * The data is added to the string buffer with JSON formatting. The
+ * string is written directly to the buffer, without allocating memory,
+ * and does not depend on cJSON.
  *
  * @param modem_param Pointer to the modem parameter structure.
- * @param buf         The buffer where the string will be written.
+ * @param buf         The buffer where the string will be written. It must
+ *                    be at least @ref MODEM_INFO_JSON_STRING_SIZE bytes.
  *
- * @return Length of the string buffer data if the operation was
- *         successful.
+ * @return Length of the string if the operation was successful.
+ *         -EMSGSIZE if the string does not fit in
+ *         @ref MODEM_INFO_JSON_STRING_SIZE bytes.
  *         Otherwise, a (negative) error code is returned.
  */
 int modem_info_json_string_encode(struct modem_param_info *modem_param,
 				  char *buf);
 
+#ifdef CONFIG_CJSON_LIB
 
 /** @brief Encode the modem parameters.
  *
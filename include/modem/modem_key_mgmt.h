@@ -145,5 +145,16 @@ int modem_key_mgmt_exists(nrf_sec_tag_t sec_tag,
 			  enum modem_key_mgmt_cred_type cred_type,
 			  bool *exists, uint8_t *perm_flags);
 
+/**
+ * @brief Invalidate the credential list cache.
+ *
+ * The cache is populated again on next use. Call this function if
+ * credentials have been changed without using this library, for example
+ * with AT commands.
+ *
+ * Only available if @kconfig{CONFIG_MODEM_KEY_MGMT_CACHE} is enabled.
+ */
+void modem_key_mgmt_cache_invalidate(void);
+
 #endif /* MODEM_KEY_MGMT_H__ */
 /**@} */
@@ -18,6 +18,8 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
+#include <zephyr/types.h>
 #include <nrf_modem.h>
 
 /**
@@ -73,6 +75,80 @@ int nrf_modem_lib_get_init_ret(void);
  */
 int nrf_modem_lib_shutdown(void);
 
+/** Number of buckets in the allocation size histogram. */
+#define NRF_MODEM_LIB_HEAP_STATS_BUCKETS 8
+
+/** Upper bound, in bytes, of the first bucket of the allocation size
+ *  histogram. Each of the following buckets is twice as large, and the last
+ *  one counts all the larger allocations.
+ */
+#define NRF_MODEM_LIB_HEAP_STATS_BUCKET_MIN 32
+
+/** @brief Heap usage statistics. */
+struct nrf_modem_lib_heap_stats {
+	/** Size of the heap, in bytes. */
+	size_t size;
+	/** Bytes currently allocated, including the statistics overhead. */
+	size_t allocated;
+	/** Highest number of bytes allocated at the same time. */
+	size_t max_allocated;
+	/** Number of successful allocations. */
+	uint32_t allocs;
+	/** Number of failed allocations. */
+	uint32_t failed_allocs;
+	/** Number of failed allocations for which there was enough free
+	 *  memory in the heap, but not in one block. This is an estimate, as
+	 *  the heap bookkeeping overhead is not taken into account.
+	 */
+	uint32_t failed_allocs_fragmented;
+	/** Number of allocation requests, by size. */
+	uint32_t size_hist[NRF_MODEM_LIB_HEAP_STATS_BUCKETS];
+	/** Total time spent in allocations, in microseconds. */
+	uint64_t alloc_time_total_us;
+	/** Longest time spent in an allocation, in microseconds. */
+	uint32_t alloc_time_max_us;
+};
+
+/**
+ * @brief Get the usage statistics of the library heap.
+ *
+ * Requires @kconfig{CONFIG_NRF_MODEM_LIB_MEM_DIAG}.
+ *
+ * @param stats Pointer to the statistics.
+ *
+ * @retval 0 If successful.
+ * @retval -EINVAL If @p stats is NULL.
+ */
+int nrf_modem_lib_heap_stats_get(struct nrf_modem_lib_heap_stats *stats);
+
+/**
+ * @brief Get the usage statistics of the TX heap.
+ *
+ * Requires @kconfig{CONFIG_NRF_MODEM_LIB_MEM_DIAG}.
+ *
+ * @param stats Pointer to the statistics.
+ *
+ * @retval 0 If successful.
+ * @retval -EINVAL If @p stats is NULL.
+ */
+int nrf_modem_lib_shm_tx_stats_get(struct nrf_modem_lib_heap_stats *stats);
+
+/**
+ * @brief Reset the usage statistics of the library heap.
+ *
+ * The counters are cleared, and the high-water mark is set to the memory
+ * currently in use.
+ */
+void nrf_modem_lib_heap_stats_reset(void);
+
+/**
+ * @brief Reset the usage statistics of the TX heap.
+ *
+ * The counters are cleared, and the high-water mark is set to the memory
+ * currently in use.
+ */
+void nrf_modem_lib_shm_tx_stats_reset(void);
+
 /**
  * @brief Print diagnostic information for the TX heap.
  */
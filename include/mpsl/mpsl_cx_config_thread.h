@@ -29,6 +29,16 @@ struct mpsl_cx_thread_interface_config {
 	uint8_t granted_pin;
 };
 
+/** @brief Coexistence counters, see @ref mpsl_cx_thread_stats_get. */
+struct mpsl_cx_thread_stats {
+	/** Number of times Request was asserted. */
+	uint32_t requests;
+	/** Number of times the arbiter granted access during a request. */
+	uint32_t granted;
+	/** Number of times the arbiter revoked access during a request. */
+	uint32_t denied;
+};
+
 /** @brief Configures the Thread Radio Coexistence interface.
  *
  * This function sets device interface parameters for the Coexistence module.
@@ -43,6 +53,14 @@ struct mpsl_cx_thread_interface_config {
 int32_t mpsl_cx_thread_interface_config_set(
 		struct mpsl_cx_thread_interface_config const * const config);
 
+/** @brief Get the coexistence counters.
+ *
+ * Available if CONFIG_MPSL_CX_THREAD_STATS is enabled.
+ *
+ * @param[out] stats Counters since the interface was configured.
+ */
+void mpsl_cx_thread_stats_get(struct mpsl_cx_thread_stats *stats);
+
 #endif // MPSL_CX_CONFIG_THREAD_H__
 
 /**@} */
@@ -104,7 +104,11 @@ enum aws_iot_evt_type {
 	 */
 	AWS_IOT_EVT_FOTA_ERROR,
 	/** AWS IoT library irrecoverable error. */
-	AWS_IOT_EVT_ERROR
+	AWS_IOT_EVT_ERROR,
+	/** A QoS 1 message has been acknowledged by the broker. The message ID
+	 *  is given in the event data.
+	 */
+	AWS_IOT_EVT_PUBACK
 };
 
 /** @brief AWS IoT topic data. */
@@ -137,6 +141,10 @@ struct aws_iot_data {
 	size_t len;
 	/** Quality of Service of the message. */
 	enum mqtt_qos qos;
+	/** Message ID. If set to 0 when sending, an ID is assigned by the
+	 *  library.
+	 */
+	uint16_t message_id;
 };
 
 /** @brief Struct with data received from AWS IoT broker. */
@@ -149,6 +157,8 @@ struct aws_iot_evt {
 		/** FOTA progress in percentage. */
 		int fota_progress;
 		bool persistent_session;
+		/** ID of the acknowledged message. */
+		uint16_t message_id;
 	} data;
 };
 
@@ -208,11 +218,18 @@ int aws_iot_connect(struct aws_iot_config *const config);
 int aws_iot_disconnect(void);
 
 /** @brief Send data to AWS IoT broker.
+ *
+ *  If @kconfig{CONFIG_AWS_IOT_PUBLISH_WINDOW} is enabled, QoS 1 messages are
+ *  copied and kept until the broker acknowledges them, which is signaled by
+ *  the AWS_IOT_EVT_PUBACK event. To match the event to the message, set the
+ *  message ID in @p tx_data. If the library is not connected, the message is
+ *  published when the next connection is established.
  *
  *  @param[in] tx_data Pointer to struct containing data to be transmitted to
  *                     the AWS IoT broker.
  *
  *  @return 0 If successful.
+ *            -ENOBUFS if the window of unacknowledged messages is full.
  *            Otherwise, a (negative) error code is returned.
  */
 int aws_iot_send(const struct aws_iot_data *const tx_data);
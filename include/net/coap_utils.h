@@ -39,6 +39,34 @@ int coap_send_request(enum coap_method method, const struct sockaddr *addr,
 		      const char *const *uri_path_options, uint8_t *payload,
 		      uint16_t payload_size, coap_reply_t reply_cb);
 
+/** @brief Send CoAP confirmable request.
+ *
+ * The request is retransmitted with exponential backoff until it is
+ * acknowledged, at most @kconfig{CONFIG_COAP_UTILS_MAX_RETRANSMIT} times.
+ * Up to @kconfig{CONFIG_COAP_UTILS_MAX_REQUESTS} requests can wait for a
+ * response at the same time, and responses are matched to requests by
+ * token.
+ *
+ * @param[in] method           CoAP method type.
+ * @param[in] addr             pointer to socket address struct for IPv6.
+ * @param[in] uri_path_options pointer to CoAP URI schemes option.
+ * @param[in] payload          pointer to the CoAP message payload.
+ * @param[in] payload_size     size of the CoAP message payload.
+ * @param[in] reply_cb         function to call when the response comes.
+ *                             If the request is not acknowledged, it is
+ *                             called with a NULL response.
+ *
+ * @retval >= 0 On success.
+ * @retval -ENOMEM If all the request slots are taken by confirmable
+ *                 requests that have not been acknowledged.
+ * @retval < 0 On other failure.
+ */
+int coap_send_confirmable_request(enum coap_method method,
+				  const struct sockaddr *addr,
+				  const char *const *uri_path_options,
+				  uint8_t *payload, uint16_t payload_size,
+				  coap_reply_t reply_cb);
+
 #endif
 
 /**
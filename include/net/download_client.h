@@ -126,6 +126,8 @@ struct download_client_cfg {
 typedef int (*download_client_callback_t)(
 	const struct download_client_evt *event);
 
+struct download_client_stripe;
+
 /**
  * @brief Download client instance.
  */
@@ -159,11 +161,42 @@ struct download_client {
 		bool has_header;
 		/** The server has closed the connection. */
 		bool connection_close;
+		/** Number of range requests waiting for a response. */
+		uint8_t outstanding;
+		/** Offset of the next range to request. */
+		size_t next_range;
+		/** Payload size of the current range response. */
+		size_t frag_len;
+		/** Bytes of the next response(s) received after the
+		 *  current fragment.
+		 */
+		size_t carry;
+#if CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE_DEPTH > 1
+		/** Request buffer, since the response buffer may hold
+		 *  pipelined data when requests are sent.
+		 */
+		char req_buf[CONFIG_DOWNLOAD_CLIENT_MAX_HOSTNAME_SIZE +
+			     CONFIG_DOWNLOAD_CLIENT_MAX_FILENAME_SIZE + 128];
+#endif
 	} http;
 
 	struct {
 		/** CoAP block context. */
 		struct coap_block_context block_ctx;
+		/** Uptime when the last request was sent, in milliseconds. */
+		int64_t send_time;
+		/** Smoothed round-trip time, in milliseconds. */
+		uint32_t srtt;
+		/** Round-trip time variation, in milliseconds. */
+		uint32_t rttvar;
+		/** Retransmission timeout, in milliseconds. */
+		uint32_t rto;
+		/** Number of retransmissions of the current block. */
+		uint8_t retransmits;
+		/** Blocks received without retransmissions since
+		 *  the block size was last changed.
+		 */
+		uint8_t blocks_ok;
 	} coap;
 
 	/** Internal thread ID. */
@@ -176,6 +209,37 @@ struct download_client {
 
 	/** Event handler. */
 	download_client_callback_t callback;
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_STRIPE) || defined(__DOXYGEN__)
+	/** Striped download this client is part of, if any. */
+	struct download_client_stripe *stripe;
+	/** Index of this client in the striped download. */
+	uint8_t stripe_idx;
+	/** Given when this client may deliver its next fragment. */
+	struct k_sem stripe_turn;
+#endif
+};
+
+/**
+ * @brief Striped download over several client instances.
+ *
+ * Fragment N of the file is downloaded by client N modulo the number of
+ * clients in use, and the fragments are delivered in order, each through
+ * the callback of the client that downloaded it.
+ */
+struct download_client_stripe {
+	/** Client instances, initialized and connected to the same host,
+	 *  with the same fragment size.
+	 */
+	struct download_client **clients;
+	/** Number of client instances. */
+	size_t count;
+	/** Number of client instances in use, set once the file size
+	 *  is known.
+	 */
+	size_t active;
+	/** Set when the download has stopped on any of the clients. */
+	atomic_t stopped;
 };
 
 /**
@@ -222,6 +286,27 @@ int download_client_connect(struct download_client *client, const char *host,
 int download_client_start(struct download_client *client, const char *file,
 			  size_t from);
 
+/**
+ * @brief Download a file over several connections.
+ *
+ * The first client requests the first fragment. Once the file size is
+ * known, the other clients are started on the following fragments. The
+ * download stops on all clients when it stops on one of them. The
+ * @ref DOWNLOAD_CLIENT_EVT_DONE event is sent by the client that delivers
+ * the last fragment.
+ *
+ * Requires @kconfig{CONFIG_DOWNLOAD_CLIENT_STRIPE}.
+ *
+ * @param[in] stripe	Striped download, with @c clients and @c count set.
+ * @param[in] file	File to download, null-terminated.
+ * @param[in] from	Offset from where to resume the download,
+ *			or zero to download from the beginning.
+ *
+ * @retval int Zero on success, a negative error code otherwise.
+ */
+int download_client_stripe_start(struct download_client_stripe *stripe,
+				 const char *file, size_t from);
+
 /**
  * @brief Pause the download.
  *
@@ -141,6 +141,35 @@ int fota_download_start_with_image_type(const char *host, const char *file,
  */
 int fota_download_cancel(void);
 
+/**@brief Set the expected SHA-256 hash of the image.
+ *
+ * When the download completes, the hash computed while downloading is
+ * compared to @p hash before the image is marked as an upgrade candidate.
+ * On mismatch, the image is discarded and a
+ * @ref FOTA_DOWNLOAD_ERROR_CAUSE_INVALID_UPDATE error event is sent.
+ *
+ * Requires @kconfig{CONFIG_FOTA_DOWNLOAD_SHA256}.
+ *
+ * @param hash Expected hash (32 bytes), or NULL to disable the check.
+ *
+ * @retval 0 If successful.
+ * @retval -EALREADY If download is ongoing.
+ */
+int fota_download_sha256_expected_set(const uint8_t *hash);
+
+/**@brief Get the SHA-256 hash of the last downloaded image.
+ *
+ * Requires @kconfig{CONFIG_FOTA_DOWNLOAD_SHA256}.
+ *
+ * @param hash Buffer for the hash (32 bytes).
+ *
+ * @retval 0 If successful.
+ * @retval -ENODATA If no download has finished, or if the hash could not
+ *                  be computed because the download was resumed without a
+ *                  matching hash context.
+ */
+int fota_download_sha256_get(uint8_t *hash);
+
 /**@brief Get target image type.
  *
  * Image type becomes known after download starts.
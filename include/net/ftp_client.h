@@ -249,6 +249,17 @@ enum ftp_put_type {
  */
 typedef void (*ftp_client_callback_t)(const uint8_t *msg, uint16_t len);
 
+/**
+ * @brief FTP upload data producer callback.
+ * Called from the FTP client work queue until it returns 0 or a negative value.
+ * @param buf Buffer to fill with the next chunk of data. It is sent before
+ *            the callback is called again.
+ * @param size Size of the buffer
+ * @retval Number of bytes written to the buffer, 0 at the end of data, or a
+ *         negative value to abort the transfer.
+ */
+typedef int (*ftp_client_put_cb_t)(uint8_t *buf, uint16_t size);
+
 /**@brief Initialize the FTP client library.
  *
  * @param ctrl_callback Callback for FTP command result.
@@ -382,6 +393,17 @@ int ftp_get(const char *file);
  */
 int ftp_put(const char *file, const uint8_t *data, uint16_t length, int type);
 
+/**@brief Put data to a file, pulling it from a producer callback
+ * If file does not exist, create the file. The data does not need to be in
+ * RAM at once, and its total length is not limited.
+ * @param file Target file name
+ * @param producer Callback providing the data, see @ref ftp_client_put_cb_t
+ * @param type specify FTP put types, see enum ftp_put_type
+ * @retval ftp_reply_code, negative value returned by the producer, or other
+ *         negative value if error
+ */
+int ftp_put_stream(const char *file, ftp_client_put_cb_t producer, int type);
+
 #ifdef __cplusplus
 }
 #endif
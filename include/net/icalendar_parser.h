@@ -100,16 +100,47 @@ struct ical_parser_evt {
 typedef int (*icalendar_parser_callback_t)(
 	const struct ical_parser_evt *event);
 
+/** Maximum length of a property name or component name that is parsed. */
+#define ICAL_PARSER_NAME_SIZE 16
+
+/** No supported property is being parsed. */
+#define ICAL_PARSER_PROP_NONE 0xFF
+
 /**
  * @brief iCalendar parser instance.
+ *
+ * The parser keeps only the state of the content line being parsed,
+ * so data can be passed to it in fragments of any size.
  */
 struct icalendar_parser {
-	/** Internal Buffer for parsing incoming data stream */
-	char buf[CONFIG_ICAL_PARSER_BUFFER_SIZE + 1];
-	/** Offset of unparsed data in buf. */
-	size_t offset;
+	/** Name of the content line being parsed. */
+	char name[ICAL_PARSER_NAME_SIZE + 1];
+	/** Length of the name. */
+	size_t name_len;
+	/** Value of a BEGIN or END content line. */
+	char token[ICAL_PARSER_NAME_SIZE + 1];
+	/** Destination of the value being parsed, or NULL if it is skipped. */
+	char *value;
+	/** Length of the value. */
+	size_t value_len;
+	/** Maximum length of the value. */
+	size_t value_max;
+	/** Index of the property being parsed. */
+	uint8_t prop;
+	/** Position within the content line. */
+	uint8_t line_state;
+	/** Position within the line break. */
+	uint8_t eol_state;
+	/** Inside a quoted parameter value. */
+	bool quoted;
+	/** Nesting level of the components. */
+	uint8_t depth;
+	/** The top-level component is supported. */
+	bool component;
 	/** begin of iCalendar object delimiter pair */
 	bool icalobject_begin;
+	/** Component being parsed. */
+	struct ical_parser_evt evt;
 	/** Event handler. */
 	icalendar_parser_callback_t callback;
 };
@@ -128,6 +159,11 @@ int ical_parser_init(struct icalendar_parser *ical,
 /**
  * @brief Parse the iCalendar data stream. Return the parsed bytes.
  *
+ * Data is parsed as it arrives and does not need to be buffered.
+ * Each completed component is reported through the callback.
+ * If the callback returns non-zero, parsing stops after that
+ * component.
+ *
  * @param[in,out] ical iCalendar parser instance.
  * @param[in] data Input data to be parsed.
  * @param[in] len  Length of input data stream.
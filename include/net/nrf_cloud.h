@@ -213,6 +213,17 @@ struct nrf_cloud_connect_param {
 	const struct nrf_cloud_sensor_list *sensor;
 };
 
+/**@brief Encoding of device messages. */
+enum nrf_cloud_data_format {
+	/** JSON, sent on the data topic. */
+	NRF_CLOUD_DATA_FORMAT_JSON,
+	/** CBOR, sent on the CBOR data topic. Falls back to JSON if
+	 *  @kconfig{CONFIG_NRF_CLOUD_CBOR} is disabled or the message
+	 *  cannot be encoded.
+	 */
+	NRF_CLOUD_DATA_FORMAT_CBOR,
+};
+
 /**@brief Sensor data transmission parameters. */
 struct nrf_cloud_sensor_data {
 	/** The sensor that is the source of the data. */
@@ -225,6 +236,8 @@ struct nrf_cloud_sensor_data {
 	 * Any other value will suppress the NRF_CLOUD_EVT_SENSOR_DATA_ACK event.
 	 */
 	uint16_t tag;
+	/** Encoding of the message. Not used for shadow updates. */
+	enum nrf_cloud_data_format format;
 };
 
 /**@brief Asynchronous events received from the module. */
@@ -44,6 +44,12 @@ struct nfc_ndef_msg_desc {
  * This function encodes an NDEF message according to the provided message
  * descriptor.
  *
+ * The message is encoded in a single pass. The payload constructor of each
+ * record, including the records of nested messages, is called once and
+ * writes the payload directly to its place in @p msg_buffer. Only call this
+ * function with @p msg_buffer set to NULL if the size is needed before the
+ * buffer can be provided.
+ *
  * @param ndef_msg_desc Pointer to the message descriptor.
  * @param msg_buffer Pointer to the message destination. If NULL, function
  * will calculate the expected size of the message.
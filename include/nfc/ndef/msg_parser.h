@@ -84,6 +84,51 @@ int nfc_ndef_msg_parse(const uint8_t  *result_buf,
 		       const uint8_t *raw_data,
 		       uint32_t *raw_data_len);
 
+/** @brief Iterator over the records of an NDEF message.
+ *
+ *  The iterator does not need any memory for descriptors. Records are
+ *  parsed one at a time into a @ref nfc_ndef_record_view, which points into
+ *  the message data.
+ */
+struct nfc_ndef_msg_iter {
+	/** Data of the records that are not parsed yet. */
+	const uint8_t *data;
+	/** Length of the data that is not parsed yet. */
+	uint32_t data_len;
+	/** Number of records parsed so far. */
+	uint32_t record_count;
+	/** The last record of the message was parsed. */
+	bool end;
+};
+
+/** @brief Initialize an NDEF message iterator.
+ *
+ *  Nested NDEF messages, for example in the payload of a Connection
+ *  Handover record, can be iterated by initializing another iterator over
+ *  the payload of a record view, only when they need to be decoded.
+ *
+ *  @param[out] iter Pointer to the iterator.
+ *  @param[in] raw_data Pointer to the NDEF message data.
+ *  @param[in] raw_data_len Length of the NDEF message data.
+ */
+void nfc_ndef_msg_iter_init(struct nfc_ndef_msg_iter *iter,
+			    const uint8_t *raw_data,
+			    uint32_t raw_data_len);
+
+/** @brief Parse the next record of an NDEF message.
+ *
+ *  @param[in,out] iter Pointer to the iterator.
+ *  @param[out] view Pointer to the record view that will be filled.
+ *
+ *  @retval 0 If the record was parsed.
+ *  @retval -ENOENT If there are no more records in the message.
+ *  @retval -EINVAL If the record does not fit in the message data.
+ *  @retval -EFAULT If the record location flags are invalid, or the message
+ *                  data ends before the last record.
+ */
+int nfc_ndef_msg_iter_next(struct nfc_ndef_msg_iter *iter,
+			   struct nfc_ndef_record_view *view);
+
 /** @brief Print the parsed contents of an NDEF message.
  *
  *  @param[in] msg_desc Pointer to the descriptor of the message that should
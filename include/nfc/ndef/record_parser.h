@@ -21,6 +21,48 @@ extern "C" {
  */
 
 
+/** @brief View of a parsed NDEF record.
+ *
+ *  The type, ID and payload point into the parsed NFC data, which must stay
+ *  valid as long as the view is used.
+ */
+struct nfc_ndef_record_view {
+	/** Value of the Type Name Format (TNF) field. */
+	enum nfc_ndef_record_tnf tnf;
+	/** Location of the record within the NDEF message. */
+	enum nfc_ndef_record_location location;
+	/** Length of the type field. */
+	uint8_t type_length;
+	/** Pointer to the type field data. NULL if type_length is 0. */
+	const uint8_t *type;
+	/** Length of the ID field. */
+	uint8_t id_length;
+	/** Pointer to the ID field data. NULL if id_length is 0. */
+	const uint8_t *id;
+	/** Length of the payload. */
+	uint32_t payload_length;
+	/** Pointer to the payload. NULL if payload_length is 0. */
+	const uint8_t *payload;
+};
+
+/** @brief Parse an NDEF record into a view.
+ *
+ *  Unlike @ref nfc_ndef_record_parse, this function does not need a payload
+ *  descriptor. The view only points into @p nfc_data.
+ *
+ *  @param[out] view Pointer to the record view that will be filled.
+ *  @param[in] nfc_data Pointer to the raw data to be parsed.
+ *  @param[in,out] nfc_data_len As input: size of the NFC data in the
+ *                              @p nfc_data buffer. As output: size of the
+ *                              parsed record.
+ *
+ *  @retval 0 If the operation was successful.
+ *  @retval -EINVAL If the record does not fit in the NFC data.
+ */
+int nfc_ndef_record_view_parse(struct nfc_ndef_record_view *view,
+			       const uint8_t *nfc_data,
+			       uint32_t *nfc_data_len);
+
 /** @brief Parse NDEF records.
  *
  *  This parsing implementation uses the binary payload descriptor
@@ -69,6 +69,22 @@ struct nfc_t4t_hl_procedure_cb {
 	 */
 	void (*ndef_read)(uint16_t file_id, const uint8_t *data, size_t len);
 
+	/**@brief HL Procedure NDEF file chunk read callback.
+	 *
+	 * A part of the NDEF file was received during the NDEF Read
+	 * procedure. Use it to process the file while the remaining parts
+	 * are still being read. This callback is optional.
+	 *
+	 * @param[in] file_id File Identifier
+	 * @param[in] offset Offset of the received data in the NDEF file,
+	 *                   including the NLEN field.
+	 * @param[in] data Pointer to the received data. It is only valid
+	 *                 until the callback returns.
+	 * @param[in] len Received data length.
+	 */
+	void (*ndef_chunk_read)(uint16_t file_id, uint16_t offset,
+				const uint8_t *data, size_t len);
+
 	/**@brief HL Procedure NDEF file updated callback.
 	 *
 	 * The NDEF file of Typ 4 Tag update  operation is
@@ -151,6 +167,23 @@ int nfc_t4t_hl_procedure_ndef_file_select(uint16_t id);
 int nfc_t4t_hl_procedure_ndef_read(struct nfc_t4t_cc_file *cc,
 				   uint8_t *ndef_buff, uint16_t ndef_len);
 
+/**@brief Perform NDEF Read Procedure without a buffer for the NDEF file.
+ *
+ * The NDEF file is delivered in chunks, as they are received, through the
+ * @ref nfc_t4t_hl_procedure_cb.ndef_chunk_read callback. When the whole file
+ * is read, the @ref nfc_t4t_hl_procedure_cb.ndef_read callback is called with
+ * the data pointer set to NULL and the total length of the NDEF file.
+ * The file content is not assigned to the Capability Container descriptor.
+ *
+ * @param[in] cc Pointer to Capability Containers descriptor.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If @p cc is NULL or the chunk read callback is not
+ *                 registered.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int nfc_t4t_hl_procedure_ndef_read_stream(struct nfc_t4t_cc_file *cc);
+
 /**@brief Perform NDEF Update Procedure.
  *
  * @param[in] cc Pointer to Capability Containers descriptor.
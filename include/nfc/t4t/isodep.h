@@ -104,7 +104,19 @@ enum nfc_t4t_isodep_fsd {
 	NFC_T4T_ISODEP_FSD_128,
 
 	/** 256-byte frame size. */
-	NFC_T4T_ISODEP_FSD_256
+	NFC_T4T_ISODEP_FSD_256,
+
+	/** 512-byte frame size. */
+	NFC_T4T_ISODEP_FSD_512,
+
+	/** 1024-byte frame size. */
+	NFC_T4T_ISODEP_FSD_1024,
+
+	/** 2048-byte frame size. */
+	NFC_T4T_ISODEP_FSD_2048,
+
+	/** 4096-byte frame size. */
+	NFC_T4T_ISODEP_FSD_4096
 };
 
 /**@brief ISO-DEP Protocol callback structure.
@@ -168,7 +180,9 @@ struct nfc_t4t_isodep_cb {
  *                communication with one Listener.
  *
  * @note According to NFC Forum Digital Specification 2.0, FSD
- *       must be set to 256 bytes.
+ *       must be set to 256 bytes. Frame sizes above 256 bytes
+ *       are defined by ISO/IEC 14443-4:2016. Use them only with
+ *       tags and NFC frontends that support such frames.
  *
  * @retval 0 If the operation was successful.
  *           Otherwise, a (negative) error code is returned.
@@ -294,6 +294,39 @@ void nfc_tnep_tag_rx_msg_indicate(const uint8_t *rx_buffer, size_t len);
 int nfc_tnep_tag_tx_msg_app_data(struct nfc_ndef_msg_desc *msg,
 				 enum nfc_tnep_status_value status);
 
+/**
+ * @brief Queue application data for the next message.
+ *
+ * Use this function to stream service data. The message is encoded in
+ * the second NDEF buffer while the Reader/Writer reads the current one.
+ * When the next service message is received from the Reader/Writer, the
+ * queued message is set as the response right away, without waiting for
+ * the application. The @ref nfc_tnep_tag_service_cb.message_received
+ * callback is then called, and the application can queue the next message
+ * instead of calling @ref nfc_tnep_tag_tx_msg_app_data.
+ *
+ * A queued message is dropped if the Reader/Writer selects or deselects
+ * a service, or if the tag is selected again.
+ *
+ * This function must be called from the thread that calls
+ * @ref nfc_tnep_tag_process.
+ *
+ * @param[in] msg Pointer to NDEF message with application data. The message
+ *                must have one free slot for the TNEP status record. Use
+ *                @ref NFC_TNEP_TAG_APP_MSG_DEF which reserves slot for the
+ *                TNEP status record.
+ * @param[in] status TNEP App data message status.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EBUSY If a message is already queued. Queue the next message
+ *                when the queued one is used.
+ * @retval -EACCES If no service is selected, or the response to the last
+ *                 received message is not set yet.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int nfc_tnep_tag_tx_msg_app_data_queue(struct nfc_ndef_msg_desc *msg,
+				       enum nfc_tnep_status_value status);
+
 /**
  * @brief Respond with no more application data.
  *
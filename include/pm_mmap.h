@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef PM_MMAP_H_
+#define PM_MMAP_H_
+
+/**
+ * @file
+ * @defgroup pm_mmap Partition Manager memory-mapped access
+ * @{
+ * @brief Direct read-only access to data stored in flash partitions.
+ *
+ * Partitions in internal flash, and on nRF5340 partitions in external flash
+ * connected over QSPI, are mapped into the address space. This API returns
+ * pointers into that space, so data stored in a partition can be used without
+ * copying it to RAM.
+ *
+ * A pointer returned by @ref pm_mmap stays valid until @ref pm_munmap is
+ * called for it. Data must not be accessed through the pointer while the
+ * same part of the partition is erased or written. The partition must be
+ * readable by the current image, for example a non-secure partition for
+ * non-secure firmware.
+ */
+
+#include <stddef.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Map a part of a partition for reading.
+ *
+ * @param[in]  id     Partition ID, for example FLASH_AREA_ID(label).
+ * @param[in]  off    Offset of the mapped data within the partition.
+ * @param[in]  len    Length of the mapped data.
+ * @param[in]  align  Required alignment of the returned pointer. Must be a
+ *                    power of two. Use 1 if no alignment is required.
+ * @param[out] ptr    Pointer to the mapped data.
+ *
+ * @retval 0        If successful.
+ * @retval -EINVAL  If the arguments are invalid, the data is out of the
+ *                  partition bounds, or the pointer would not be aligned.
+ * @retval -ENOTSUP If the partition is not located in memory-mapped flash.
+ * @retval -ENOENT  If the partition does not exist.
+ */
+int pm_mmap(uint8_t id, off_t off, size_t len, size_t align,
+	    const void **ptr);
+
+/** @brief Release a pointer returned by @ref pm_mmap.
+ *
+ * For external flash, XIP is disabled when the last mapping is released.
+ *
+ * @param[in] ptr Pointer returned by @ref pm_mmap.
+ */
+void pm_munmap(const void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* PM_MMAP_H_ */
@@ -250,6 +250,56 @@ static inline void profiler_log_encode_string(struct log_event_buf *buf,
 #endif
 
 
+/** @brief Add a packed structure with fixed-size data values to a buffer.
+ *
+ * The structure must be declared as __packed and contain fields of fixed-size
+ * data types, in the order and of the types registered for the event type.
+ * The layout of the encoded data is defined at compile time and the whole
+ * structure is added to the buffer with a single copy, instead of encoding
+ * the values one by one.
+ *
+ * @note Values are encoded in little-endian byte order, so this function can
+ *       be used only on little-endian targets.
+ *
+ * @warning The buffer must be initialized with @ref profiler_log_start
+ *          before calling this function.
+ *
+ * @param buf Pointer to the data buffer.
+ * @param data Pointer to the packed structure.
+ * @param size Size of the packed structure.
+ */
+#ifdef CONFIG_PROFILER
+void profiler_log_encode_packed(struct log_event_buf *buf, const void *data,
+				size_t size);
+#else
+static inline void profiler_log_encode_packed(struct log_event_buf *buf,
+					      const void *data, size_t size) {}
+#endif
+
+
+/** @brief Add a packed structure with fixed-size data values to a buffer.
+ *
+ * Wrapper for @ref profiler_log_encode_packed that verifies at build time
+ * that the structure fits in the buffer, together with the event type ID
+ * and the timestamp.
+ *
+ * @param buf Pointer to the data buffer.
+ * @param data Packed structure (not a pointer).
+ */
+#ifdef CONFIG_PROFILER
+#define PROFILER_LOG_ENCODE_PACKED(buf, data)					\
+	do {									\
+		BUILD_ASSERT(sizeof(data) + sizeof(uint8_t) + sizeof(uint32_t) <=	\
+			     CONFIG_PROFILER_CUSTOM_EVENT_BUF_LEN,		\
+			     "Profiled data does not fit in the buffer");	\
+		profiler_log_encode_packed(buf, &(data), sizeof(data));	\
+	} while (0)
+#else
+#define PROFILER_LOG_ENCODE_PACKED(buf, data) \
+	profiler_log_encode_packed(buf, &(data), sizeof(data))
+#endif
+
+
 /** @brief Encode and add the event's address in memory to the buffer.
  *
  * This information is used for event identification.
@@ -18,6 +18,8 @@
  *
  */
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -28,6 +30,31 @@ extern "C" {
  */
 void power_down_unused_ram(void);
 
+/** Allocate RAM above the image and power it up.
+ *
+ * Memory is allocated in whole RAM sections, which are powered down again
+ * when freed. The memory can be used, for example, as the buffer of a
+ * @c k_heap or a @c k_mem_slab that is needed only for a while.
+ *
+ * Only available with @kconfig{CONFIG_RAM_POWER_DOWN_DYNAMIC}.
+ *
+ * @param size Number of bytes to allocate.
+ *
+ * @return Pointer to the memory, aligned to the RAM section, or NULL if
+ *         there are not enough free contiguous sections.
+ */
+void *ram_pwrdn_alloc(size_t size);
+
+/** Free RAM allocated with @ref ram_pwrdn_alloc.
+ *
+ * Free sections above
+ * @kconfig{CONFIG_RAM_POWER_DOWN_DYNAMIC_HYSTERESIS} are powered down
+ * and lose their content.
+ *
+ * @param ptr Pointer returned by @ref ram_pwrdn_alloc, or NULL.
+ */
+void ram_pwrdn_free(void *ptr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -87,6 +87,68 @@ int spm_request_random_number(uint8_t *output, size_t len, size_t *olen);
  */
 int spm_request_read(void *destination, uint32_t addr, size_t len);
 
+/** Type of an operation in a batched secure service request. */
+enum spm_batch_op_type {
+	/** Same as @ref spm_request_read. */
+	SPM_BATCH_OP_READ,
+	/** Same as @ref spm_request_random_number. */
+	SPM_BATCH_OP_RANDOM_NUMBER,
+	/** Same as @ref spm_firmware_info. */
+	SPM_BATCH_OP_FIRMWARE_INFO,
+};
+
+/** Operation in a batched secure service request. */
+struct spm_batch_op {
+	/** Operation type. */
+	enum spm_batch_op_type type;
+
+	/** Result of the operation, set by the Secure Firmware. It is the
+	 *  value the corresponding secure service would return, or -ENOTSUP
+	 *  if the service is not enabled.
+	 */
+	int result;
+
+	union {
+		/** Parameters of @ref SPM_BATCH_OP_READ. */
+		struct {
+			void *destination;
+			uint32_t addr;
+			size_t len;
+		} read;
+
+		/** Parameters of @ref SPM_BATCH_OP_RANDOM_NUMBER. The length
+		 *  of the provided random number is stored in @c olen.
+		 */
+		struct {
+			uint8_t *output;
+			size_t len;
+			size_t olen;
+		} random_number;
+
+		/** Parameters of @ref SPM_BATCH_OP_FIRMWARE_INFO. */
+		struct {
+			uint32_t fw_address;
+			struct fw_info *info;
+		} firmware_info;
+	};
+};
+
+/** Request a list of operations to be executed from Secure Firmware.
+ *
+ * All operations are executed in a single transition to the Secure Firmware,
+ * which saves the overhead of calling the services one by one. The result of
+ * each operation is stored in the operation.
+ *
+ * @param[in,out] ops    Operations to execute. Must be in non-secure RAM.
+ * @param[in]     count  Number of operations.
+ *
+ * @retval 0        If the operations were executed.
+ * @retval -EINVAL  If ops is NULL, count is 0, or ops is in secure RAM.
+ * @retval -E2BIG   If count is greater than
+ *                  @kconfig{CONFIG_SPM_SERVICE_BATCH_MAX_OPS}.
+ */
+int spm_request_batch(struct spm_batch_op *ops, size_t count);
+
 /** Check if S0 is the active B1 slot.
  *
  * @param[in]   s0_address Address of s0 slot.
@@ -28,7 +28,10 @@ extern const struct shell_transport_api shell_bt_nus_transport_api;
 /** @brief Instance control block (RW data). */
 struct shell_bt_nus_ctrl_blk {
 	struct bt_conn *conn;
-	atomic_t tx_busy;
+	/* Number of notifications in flight. */
+	atomic_t tx_pending;
+	/* Serializes sending from the shell thread and the sent callback. */
+	struct k_mutex tx_lock;
 	shell_transport_handler_t handler;
 	void *context;
 };
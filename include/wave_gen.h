@@ -66,6 +66,26 @@ struct wave_gen_param {
  */
 int wave_gen_generate_value(uint32_t time, const struct wave_gen_param *params, double *out_val);
 
+/**
+ * @brief Generate a block of wave values.
+ *
+ * The values are calculated in single precision, using a lookup table with linear
+ * interpolation for the sine wave. This is much faster than generating the values
+ * one by one on targets without a double precision FPU.
+ *
+ * @param[in]	time		Time for the first generated value [ms].
+ * @param[in]	time_step_us	Time between consecutive generated values [us].
+ * @param[in]	params		Parameters describing generated wave signal.
+ * @param[out]	out_vals	Pointer to the array that is used to store generated values.
+ * @param[in]	val_cnt		Number of values to generate.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int wave_gen_generate_values(uint32_t time, uint32_t time_step_us,
+			     const struct wave_gen_param *params,
+			     float *out_vals, size_t val_cnt);
+
 #ifdef __cplusplus
 }
 #endif
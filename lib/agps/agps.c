@@ -6,6 +6,7 @@
 
 #include <zephyr.h>
 #include <stdio.h>
+#include <string.h>
 #include <logging/log.h>
 #include <net/socket.h>
 #include <nrf_modem_gnss.h>
@@ -20,10 +21,165 @@
 
 LOG_MODULE_REGISTER(agps, CONFIG_AGPS_LOG_LEVEL);
 
+#define SV_COUNT 32
+
+/* Serializes the requests, so that a request waiting for another one to
+ * finish can be served with the data the other one obtained.
+ */
+static K_MUTEX_DEFINE(request_lock);
+
+#if defined(CONFIG_AGPS_SRC_NRF_CLOUD)
+/* Last request sent to nRF Cloud, to drop the same request while the
+ * response to it is pending.
+ */
+static struct nrf_modem_gnss_agps_data_frame last_request;
+#endif
+
 #if defined(CONFIG_AGPS_SRC_SUPL)
 static int supl_fd = -1;
 #endif /* CONFIG_AGPS_SRC_SUPL */
 
+#if defined(CONFIG_AGPS_CACHE)
+/* Validity periods of the cached assistance data, counted from reception. */
+#define EPHE_VALIDITY_MS	(CONFIG_AGPS_CACHE_EPHE_VALIDITY_MINUTES * MSEC_PER_SEC * 60LL)
+#define ALM_VALIDITY_MS		(7 * 24 * 3600 * MSEC_PER_SEC * 1LL)
+#define UTC_VALIDITY_MS		(7 * 24 * 3600 * MSEC_PER_SEC * 1LL)
+#define KLOBUCHAR_VALIDITY_MS	(24 * 3600 * MSEC_PER_SEC * 1LL)
+
+/* Expiry times are uptimes in milliseconds, zero when there is no data. */
+static struct agps_cache {
+	struct nrf_modem_gnss_agps_data_ephemeris ephe[SV_COUNT];
+	int64_t ephe_expiry[SV_COUNT];
+	struct nrf_modem_gnss_agps_data_almanac alm[SV_COUNT];
+	int64_t alm_expiry[SV_COUNT];
+	struct nrf_modem_gnss_agps_data_utc utc;
+	int64_t utc_expiry;
+	struct nrf_modem_gnss_agps_data_klobuchar klobuchar;
+	int64_t klobuchar_expiry;
+} cache;
+
+static void cache_store(const void *agps, size_t agps_size, uint16_t type)
+{
+	int64_t now = k_uptime_get();
+
+	switch (type) {
+	case NRF_MODEM_GNSS_AGPS_EPHEMERIDES: {
+		const struct nrf_modem_gnss_agps_data_ephemeris *ephe = agps;
+
+		if (agps_size != sizeof(*ephe) || ephe->sv_id < 1 || ephe->sv_id > SV_COUNT) {
+			return;
+		}
+
+		cache.ephe[ephe->sv_id - 1] = *ephe;
+		cache.ephe_expiry[ephe->sv_id - 1] = now + EPHE_VALIDITY_MS;
+		break;
+	}
+	case NRF_MODEM_GNSS_AGPS_ALMANAC: {
+		const struct nrf_modem_gnss_agps_data_almanac *alm = agps;
+
+		if (agps_size != sizeof(*alm) || alm->sv_id < 1 || alm->sv_id > SV_COUNT) {
+			return;
+		}
+
+		cache.alm[alm->sv_id - 1] = *alm;
+		cache.alm_expiry[alm->sv_id - 1] = now + ALM_VALIDITY_MS;
+		break;
+	}
+	case NRF_MODEM_GNSS_AGPS_UTC_PARAMETERS:
+		if (agps_size != sizeof(cache.utc)) {
+			return;
+		}
+
+		memcpy(&cache.utc, agps, sizeof(cache.utc));
+		cache.utc_expiry = now + UTC_VALIDITY_MS;
+		break;
+	case NRF_MODEM_GNSS_AGPS_KLOBUCHAR_IONOSPHERIC_CORRECTION:
+		if (agps_size != sizeof(cache.klobuchar)) {
+			return;
+		}
+
+		memcpy(&cache.klobuchar, agps, sizeof(cache.klobuchar));
+		cache.klobuchar_expiry = now + KLOBUCHAR_VALIDITY_MS;
+		break;
+	default:
+		/* Time, position and integrity are only valid for the request. */
+		break;
+	}
+}
+
+static bool cache_inject_one(const void *agps, size_t agps_size, uint16_t type,
+			     int64_t expiry, int64_t now)
+{
+	int err;
+
+	if (expiry <= now) {
+		return false;
+	}
+
+	err = nrf_modem_gnss_agps_write((void *)agps, agps_size, type);
+	if (err) {
+		LOG_WRN("Failed to inject cached A-GPS data, type: %d (err: %d)", type, err);
+		return false;
+	}
+
+	return true;
+}
+
+/* Injects the requested data that is still valid in the cache, and removes
+ * it from the request.
+ */
+static void cache_inject(struct nrf_modem_gnss_agps_data_frame *request)
+{
+	int64_t now = k_uptime_get();
+
+	for (size_t i = 0; i < SV_COUNT; i++) {
+		if ((request->sv_mask_ephe & BIT(i)) &&
+		    cache_inject_one(&cache.ephe[i], sizeof(cache.ephe[i]),
+				     NRF_MODEM_GNSS_AGPS_EPHEMERIDES,
+				     cache.ephe_expiry[i], now)) {
+			request->sv_mask_ephe &= ~BIT(i);
+		}
+
+		if ((request->sv_mask_alm & BIT(i)) &&
+		    cache_inject_one(&cache.alm[i], sizeof(cache.alm[i]),
+				     NRF_MODEM_GNSS_AGPS_ALMANAC,
+				     cache.alm_expiry[i], now)) {
+			request->sv_mask_alm &= ~BIT(i);
+		}
+	}
+
+	if ((request->data_flags & NRF_MODEM_GNSS_AGPS_GPS_UTC_REQUEST) &&
+	    cache_inject_one(&cache.utc, sizeof(cache.utc),
+			     NRF_MODEM_GNSS_AGPS_UTC_PARAMETERS,
+			     cache.utc_expiry, now)) {
+		request->data_flags &= ~NRF_MODEM_GNSS_AGPS_GPS_UTC_REQUEST;
+	}
+
+	if ((request->data_flags & NRF_MODEM_GNSS_AGPS_KLOBUCHAR_REQUEST) &&
+	    cache_inject_one(&cache.klobuchar, sizeof(cache.klobuchar),
+			     NRF_MODEM_GNSS_AGPS_KLOBUCHAR_IONOSPHERIC_CORRECTION,
+			     cache.klobuchar_expiry, now)) {
+		request->data_flags &= ~NRF_MODEM_GNSS_AGPS_KLOBUCHAR_REQUEST;
+	}
+}
+#endif /* CONFIG_AGPS_CACHE */
+
+static bool request_is_empty(const struct nrf_modem_gnss_agps_data_frame *request)
+{
+	return request->sv_mask_ephe == 0 && request->sv_mask_alm == 0 &&
+	       request->data_flags == 0;
+}
+
+#if defined(CONFIG_AGPS_SRC_NRF_CLOUD)
+static bool request_is_subset(const struct nrf_modem_gnss_agps_data_frame *request,
+			      const struct nrf_modem_gnss_agps_data_frame *of)
+{
+	return (request->sv_mask_ephe & ~of->sv_mask_ephe) == 0 &&
+	       (request->sv_mask_alm & ~of->sv_mask_alm) == 0 &&
+	       (request->data_flags & ~of->data_flags) == 0;
+}
+#endif
+
 #if defined(CONFIG_AGPS_SRC_SUPL)
 static int inject_agps_type(void *agps,
 			    size_t agps_size,
@@ -42,6 +198,10 @@ static int inject_agps_type(void *agps,
 
 	LOG_DBG("Injected A-GPS data, type: %d, size: %d", type, agps_size);
 
+#if defined(CONFIG_AGPS_CACHE)
+	cache_store(agps, agps_size, type);
+#endif
+
 	return 0;
 }
 
@@ -233,7 +393,7 @@ cleanup:
 
 #endif /* CONFIG_AGPS_SRC_SUPL */
 
-int agps_request_send(struct nrf_modem_gnss_agps_data_frame request)
+static int request_send(struct nrf_modem_gnss_agps_data_frame request)
 {
 	int err;
 
@@ -260,6 +420,12 @@ int agps_request_send(struct nrf_modem_gnss_agps_data_frame request)
 	/* Convert GNSS API A-GPS request to GPS driver A-GPS request. */
 	struct gps_agps_request agps_request;
 
+	if (nrf_cloud_agps_request_in_progress() &&
+	    request_is_subset(&request, &last_request)) {
+		LOG_DBG("Same A-GPS request already pending");
+		return 0;
+	}
+
 	agps_request.sv_mask_ephe = request.sv_mask_ephe;
 	agps_request.sv_mask_alm = request.sv_mask_alm;
 	agps_request.utc =
@@ -280,6 +446,8 @@ int agps_request_send(struct nrf_modem_gnss_agps_data_frame request)
 		LOG_ERR("nRF Cloud A-GPS request failed, error: %d", err);
 		return err;
 	}
+
+	last_request = request;
 #elif defined(CONFIG_AGPS_SRC_NRF_CLOUD) && !defined(CONFIG_NRF_CLOUD_MQTT)
 	LOG_ERR("CONFIG_NRF_CLOUD_MQTT must be enabled to make A-GPS requests");
 	return -EOPNOTSUPP;
@@ -289,6 +457,29 @@ int agps_request_send(struct nrf_modem_gnss_agps_data_frame request)
 	return 0;
 }
 
+int agps_request_send(struct nrf_modem_gnss_agps_data_frame request)
+{
+	int err = 0;
+
+	k_mutex_lock(&request_lock, K_FOREVER);
+
+#if defined(CONFIG_AGPS_CACHE)
+	cache_inject(&request);
+#endif
+
+	if (request_is_empty(&request)) {
+		LOG_DBG("No A-GPS data to request");
+		goto unlock;
+	}
+
+	err = request_send(request);
+
+unlock:
+	k_mutex_unlock(&request_lock);
+
+	return err;
+}
+
 int agps_cloud_data_process(const uint8_t *buf, size_t len)
 {
 	int err = 0;
@@ -34,19 +34,27 @@ enum at_cmd_flags {
 	AT_CMD_SYNC = 1 << 1,		/* Command is synchronous */
 };
 
+/* Metadata for an AT response */
+struct resp_item  {
+	int code;			/* Return code of AT command */
+	enum at_cmd_state state;	/* State of AT command */
+};
+
 /* Metadata for a queued AT command */
 struct cmd_item  {
 	char *cmd;			/* Pointer to 0-terminated command */
 	char *resp;			/* Pointer to response buffer */
 	at_cmd_handler_t callback;	/* Callback to execute on result */
+	at_cmd_complete_handler_t complete; /* Callback on completion */
+	void *user_data;		/* User data for completion callback */
+	struct resp_item *sync_resp;	/* Result of synchronous command */
+	struct k_sem *sync_sem;		/* Given when sync_resp is set */
 	size_t resp_size;		/* Size of response buffer */
 	enum at_cmd_flags flags;	/* Flags describing the request */
-};
-
-/* Metadata for an AT response */
-struct resp_item  {
-	int code;			/* Return code of AT command */
-	enum at_cmd_state state;	/* State of AT command */
+#if defined(CONFIG_AT_CMD_STATS)
+	uint32_t queued_time;		/* Uptime when command was queued */
+	uint32_t sent_time;		/* Uptime when command was sent */
+#endif
 };
 
 static K_THREAD_STACK_DEFINE(socket_thread_stack,
@@ -68,9 +76,42 @@ K_MUTEX_DEFINE(current_cmd_mutex);
 /* Queue for queued command metadata */
 K_MSGQ_DEFINE(commands, sizeof(struct cmd_item), CONFIG_AT_CMD_QUEUE_LEN, 4);
 
-/* Message queue to return the result in the case of a synchronous call */
-K_MSGQ_DEFINE(response_sync, sizeof(struct resp_item), 1, 4);
-K_MUTEX_DEFINE(response_sync_get);
+#if defined(CONFIG_AT_CMD_STATS)
+static struct at_cmd_stats stats;
+static struct k_spinlock stats_lock;
+
+static void stats_cmd_queued(struct cmd_item *item)
+{
+	item->queued_time = k_uptime_get_32();
+}
+
+static void stats_cmd_sent(struct cmd_item *item)
+{
+	item->sent_time = k_uptime_get_32();
+
+	uint32_t queue_time = item->sent_time - item->queued_time;
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	stats.queue_time_total += queue_time;
+	stats.queue_time_max = MAX(stats.queue_time_max, queue_time);
+	k_spin_unlock(&stats_lock, key);
+}
+
+static void stats_cmd_completed(const struct cmd_item *item)
+{
+	uint32_t exec_time = k_uptime_get_32() - item->sent_time;
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	stats.cmd_count++;
+	stats.exec_time_total += exec_time;
+	stats.exec_time_max = MAX(stats.exec_time_max, exec_time);
+	k_spin_unlock(&stats_lock, key);
+}
+#else
+static inline void stats_cmd_queued(struct cmd_item *item) {}
+static inline void stats_cmd_sent(struct cmd_item *item) {}
+static inline void stats_cmd_completed(const struct cmd_item *item) {}
+#endif /* CONFIG_AT_CMD_STATS */
 
 static int open_socket(void)
 {
@@ -178,12 +219,46 @@ static inline int at_write(const char *const cmd)
 	return 0;
 }
 
-/* Clear the current command safely */
-static void complete_cmd(void)
+/*
+ * Report the result of the current command, if any, and clear it safely.
+ * The completion callback is called after the command is cleared, so that
+ * the next queued command can be written while the callback runs.
+ */
+static void complete_cmd(const char *response, const struct resp_item *ret)
 {
+	at_cmd_complete_handler_t complete;
+	void *user_data;
+
 	k_mutex_lock(&current_cmd_mutex, K_FOREVER);
+	if (current_cmd.cmd == NULL) {
+		k_mutex_unlock(&current_cmd_mutex);
+		return;
+	}
+
+	stats_cmd_completed(&current_cmd);
+
+	complete = current_cmd.complete;
+	user_data = current_cmd.user_data;
+
+	if (current_cmd.flags & AT_CMD_SYNC) {
+		LOG_DBG("Returning response for sync call");
+		*current_cmd.sync_resp = *ret;
+		k_sem_give(current_cmd.sync_sem);
+	}
+
 	current_cmd.cmd = NULL;
 	k_mutex_unlock(&current_cmd_mutex);
+
+	if (complete != NULL) {
+		complete(response, ret->state, ret->code, user_data);
+	}
+}
+
+static int enqueue_cmd(struct cmd_item *command, k_timeout_t timeout)
+{
+	stats_cmd_queued(command);
+
+	return k_msgq_put(&commands, command, timeout);
 }
 
 /*
@@ -207,6 +282,7 @@ static void load_cmd_and_write(void)
 			break;
 		}
 
+		stats_cmd_sent(&current_cmd);
 		ret = at_write(current_cmd.cmd);
 
 		if (current_cmd.flags & AT_CMD_BUF_CMD) {
@@ -217,10 +293,7 @@ static void load_cmd_and_write(void)
 		if (ret != 0) {
 			resp.state = AT_CMD_ERROR_WRITE;
 			resp.code = ret;
-			if (current_cmd.flags & AT_CMD_SYNC) {
-				k_msgq_put(&response_sync, &resp, K_FOREVER);
-			}
-			complete_cmd();
+			complete_cmd(NULL, &resp);
 		}
 	} while (ret != 0);
 	k_mutex_unlock(&current_cmd_mutex);
@@ -324,17 +397,9 @@ static void socket_thread_fn(void *arg1, void *arg2, void *arg3)
 		}
 
 next:
-		/* Dispatch response for sync call */
-		if (current_cmd.cmd != NULL &&
-		    current_cmd.flags & AT_CMD_SYNC &&
-		    ret.state != AT_CMD_NOTIFICATION) {
-			LOG_DBG("Enqueueing response for sync call");
-			k_msgq_put(&response_sync, &ret, K_FOREVER);
-		}
-
 		/* We have now handled a command if it was not a notification */
 		if (ret.state != AT_CMD_NOTIFICATION) {
-			complete_cmd();
+			complete_cmd(bytes_read > 0 ? buf : NULL, &ret);
 		}
 	}
 }
@@ -367,10 +432,12 @@ int at_cmd_write_with_callback(const char *const cmd,
 
 	command.resp = NULL;
 	command.callback = handler;
+	command.complete = NULL;
 	command.flags = AT_CMD_BUF_CMD;
 
-	ret = k_msgq_put(&commands, &command, K_FOREVER);
+	ret = enqueue_cmd(&command, K_FOREVER);
 	if (ret) {
+		k_free(command.cmd);
 		return ret;
 	}
 
@@ -378,6 +445,46 @@ int at_cmd_write_with_callback(const char *const cmd,
 	return 0;
 }
 
+int at_cmd_write_async(const char *const cmd,
+		       at_cmd_complete_handler_t handler,
+		       void *user_data)
+{
+	struct cmd_item command;
+	int ret;
+
+	if (atomic_get(&shutdown_mode) == 1) {
+		return -EHOSTDOWN;
+	}
+
+	if (check_cmd(cmd)) {
+		LOG_ERR("Invalid command");
+		return -EINVAL;
+	}
+
+	command.cmd = k_malloc(strlen(cmd) + 1);
+	if (command.cmd == NULL) {
+		return -ENOMEM;
+	}
+	strcpy(command.cmd, cmd);
+
+	command.resp = NULL;
+	command.callback = NULL;
+	command.complete = handler;
+	command.user_data = user_data;
+	command.flags = AT_CMD_BUF_CMD;
+
+	/* Never block the caller, the queue being full is reported instead */
+	ret = enqueue_cmd(&command, K_NO_WAIT);
+	if (ret) {
+		LOG_ERR("Could not enqueue cmd, error %d", ret);
+		k_free(command.cmd);
+		return -ENOBUFS;
+	}
+
+	load_cmd_and_write();
+	return 0;
+}
+
 int at_cmd_write(const char *const cmd,
 		 char *buf,
 		 size_t buf_len,
@@ -385,6 +492,7 @@ int at_cmd_write(const char *const cmd,
 {
 	struct cmd_item command;
 	struct resp_item ret;
+	struct k_sem done;
 
 	if (atomic_get(&shutdown_mode) == 1) {
 		return -EHOSTDOWN;
@@ -414,13 +522,18 @@ int at_cmd_write(const char *const cmd,
 	command.resp = buf;
 	command.resp_size = buf_len;
 	command.callback = NULL;
+	command.complete = NULL;
+	command.sync_resp = &ret;
+	command.sync_sem = &done;
 	command.flags = AT_CMD_SYNC;
 
-	/* Ensure we get our own AT response, not an old one */
-	k_mutex_lock(&response_sync_get, K_FOREVER);
+	/* The response is returned through our own semaphore, so concurrent
+	 * synchronous callers only wait for the modem, not for each other.
+	 */
+	k_sem_init(&done, 0, 1);
 
 	/* We borrow the return code field from the currently unused response */
-	ret.code = k_msgq_put(&commands, &command, K_FOREVER);
+	ret.code = enqueue_cmd(&command, K_FOREVER);
 	if (ret.code) {
 		LOG_ERR("Could not enqueue cmd, error %d", ret.code);
 		if (state) {
@@ -432,8 +545,7 @@ int at_cmd_write(const char *const cmd,
 	load_cmd_and_write();
 
 	LOG_DBG("Awaiting response for %s", log_strdup(cmd));
-	k_msgq_get(&response_sync, &ret, K_FOREVER);
-	k_mutex_unlock(&response_sync_get);
+	k_sem_take(&done, K_FOREVER);
 
 	if (state) {
 		*state = ret.state;
@@ -442,6 +554,30 @@ int at_cmd_write(const char *const cmd,
 	return ret.code;
 }
 
+#if defined(CONFIG_AT_CMD_STATS)
+int at_cmd_stats_get(struct at_cmd_stats *out)
+{
+	if (out == NULL) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	*out = stats;
+	k_spin_unlock(&stats_lock, key);
+
+	return 0;
+}
+
+void at_cmd_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	memset(&stats, 0, sizeof(stats));
+	k_spin_unlock(&stats_lock, key);
+}
+#endif /* CONFIG_AT_CMD_STATS */
+
 void at_cmd_set_notification_handler(at_cmd_handler_t handler)
 {
 	LOG_DBG("Setting notification handler to %p", handler);
@@ -11,6 +11,7 @@
 #include <zephyr.h>
 #include <zephyr/types.h>
 #include <kernel.h>
+#include <sys/util.h>
 
 #include <modem/at_params.h>
 
@@ -24,11 +25,42 @@ static void at_param_init(struct at_param *param)
 }
 
 /* Internal function. Parameter cannot be null. */
-static void at_param_clear(struct at_param *param)
+static void *at_param_value_alloc(const struct at_param_list *list,
+				  size_t size)
+{
+	struct at_param_arena *arena = list->arena;
+
+	if (arena == NULL) {
+		return k_malloc(size);
+	}
+
+	size = ROUND_UP(size, sizeof(uint32_t));
+
+	if (size > arena->size - arena->used) {
+		return NULL;
+	}
+
+	void *value = &arena->data[arena->used];
+
+	arena->used += size;
+
+	return value;
+}
+
+/* Internal function. Parameters cannot be null. */
+static void at_param_clear(const struct at_param_list *list,
+			   struct at_param *param)
 {
 	__ASSERT(param != NULL, "Parameter cannot be NULL.");
 
-	if ((param->type == AT_PARAM_TYPE_STRING) ||
+	/* Values of a static list are released when the list is cleared. */
+	if (list->arena != NULL) {
+		param->value.int_val = 0;
+		return;
+	}
+
+	/* String values in view mode reference the parsed buffer. */
+	if (((param->type == AT_PARAM_TYPE_STRING) && !list->string_view) ||
 	    (param->type == AT_PARAM_TYPE_ARRAY)) {
 		k_free(param->value.str_val);
 	}
@@ -79,6 +111,53 @@ int at_params_list_init(struct at_param_list *list, size_t max_params_count)
 	}
 
 	list->param_count = max_params_count;
+	list->string_view = false;
+	list->arena = NULL;
+	return 0;
+}
+
+int at_params_list_init_static(struct at_param_list *list,
+			       size_t max_params_count,
+			       void *buf, size_t buf_size)
+{
+	if (list == NULL || buf == NULL) {
+		return -EINVAL;
+	}
+
+	uintptr_t start = ROUND_UP((uintptr_t)buf,
+				   __alignof__(struct at_param_arena));
+	size_t params_size = max_params_count * sizeof(struct at_param);
+	size_t overhead = (start - (uintptr_t)buf) +
+			  sizeof(struct at_param_arena);
+
+	if (buf_size < overhead + params_size) {
+		return -ENOMEM;
+	}
+
+	struct at_param_arena *arena = (struct at_param_arena *)start;
+
+	arena->size = buf_size - overhead;
+	arena->used = params_size;
+
+	/* Array initialized with empty parameters. */
+	list->params = (struct at_param *)arena->data;
+	memset(list->params, 0, params_size);
+
+	list->param_count = max_params_count;
+	list->string_view = false;
+	list->arena = arena;
+	return 0;
+}
+
+int at_params_list_string_view_set(struct at_param_list *list, bool enable)
+{
+	if (list == NULL || list->params == NULL) {
+		return -EINVAL;
+	}
+
+	at_params_list_clear(list);
+	list->string_view = enable;
+
 	return 0;
 }
 
@@ -88,10 +167,18 @@ void at_params_list_clear(struct at_param_list *list)
 		return;
 	}
 
+	if (list->arena != NULL) {
+		size_t params_size = list->param_count * sizeof(struct at_param);
+
+		memset(list->params, 0, params_size);
+		list->arena->used = params_size;
+		return;
+	}
+
 	for (size_t i = 0; i < list->param_count; ++i) {
 		struct at_param *params = list->params;
 
-		at_param_clear(&params[i]);
+		at_param_clear(list, &params[i]);
 		at_param_init(&params[i]);
 	}
 }
@@ -105,8 +192,11 @@ void at_params_list_free(struct at_param_list *list)
 	at_params_list_clear(list);
 
 	list->param_count = 0;
-	k_free(list->params);
+	if (list->arena == NULL) {
+		k_free(list->params);
+	}
 	list->params = NULL;
+	list->arena = NULL;
 }
 
 int at_params_empty_put(const struct at_param_list *list, size_t index)
@@ -121,7 +211,7 @@ int at_params_empty_put(const struct at_param_list *list, size_t index)
 		return -EINVAL;
 	}
 
-	at_param_clear(param);
+	at_param_clear(list, param);
 
 	param->type = AT_PARAM_TYPE_EMPTY;
 	param->value.int_val = 0;
@@ -141,7 +231,7 @@ int at_params_int_put(const struct at_param_list *list, size_t index, int64_t va
 		return -EINVAL;
 	}
 
-	at_param_clear(param);
+	at_param_clear(list, param);
 
 	param->type = AT_PARAM_TYPE_NUM_INT;
 	param->value.int_val = value;
@@ -161,15 +251,21 @@ int at_params_string_put(const struct at_param_list *list, size_t index,
 		return -EINVAL;
 	}
 
-	char *param_value = (char *)k_malloc(str_len + 1);
+	char *param_value;
 
-	if (param_value == NULL) {
-		return -ENOMEM;
-	}
+	if (list->string_view) {
+		param_value = (char *)str;
+	} else {
+		param_value = (char *)at_param_value_alloc(list, str_len + 1);
 
-	memcpy(param_value, str, str_len);
+		if (param_value == NULL) {
+			return -ENOMEM;
+		}
 
-	at_param_clear(param);
+		memcpy(param_value, str, str_len);
+	}
+
+	at_param_clear(list, param);
 	param->size = str_len;
 	param->type = AT_PARAM_TYPE_STRING;
 	param->value.str_val = param_value;
@@ -190,7 +286,8 @@ int at_params_array_put(const struct at_param_list *list, size_t index,
 		return -EINVAL;
 	}
 
-	uint32_t *param_value = (uint32_t *)k_malloc(array_len);
+	uint32_t *param_value =
+		(uint32_t *)at_param_value_alloc(list, array_len);
 
 	if (param_value == NULL) {
 		return -ENOMEM;
@@ -198,7 +295,7 @@ int at_params_array_put(const struct at_param_list *list, size_t index,
 
 	memcpy(param_value, array, array_len);
 
-	at_param_clear(param);
+	at_param_clear(list, param);
 	param->size = array_len;
 	param->type = AT_PARAM_TYPE_ARRAY;
 	param->value.array_val = param_value;
@@ -376,6 +473,30 @@ int at_params_string_get(const struct at_param_list *list, size_t index,
 	return 0;
 }
 
+int at_params_string_ptr_get(const struct at_param_list *list, size_t index,
+			     const char **str, size_t *len)
+{
+	if (list == NULL || list->params == NULL || str == NULL ||
+	    len == NULL) {
+		return -EINVAL;
+	}
+
+	struct at_param *param = at_params_get(list, index);
+
+	if (param == NULL) {
+		return -EINVAL;
+	}
+
+	if (param->type != AT_PARAM_TYPE_STRING) {
+		return -EINVAL;
+	}
+
+	*str = param->value.str_val;
+	*len = at_param_size(param);
+
+	return 0;
+}
+
 int at_params_array_get(const struct at_param_list *list, size_t index,
 			uint32_t *array, size_t *len)
 {
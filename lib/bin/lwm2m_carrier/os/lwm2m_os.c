@@ -181,6 +181,11 @@ struct lwm2m_work {
 
 static struct lwm2m_work lwm2m_works[LWM2M_OS_MAX_TIMER_COUNT];
 
+BUILD_ASSERT(LWM2M_OS_MAX_TIMER_COUNT <= 32, "Free timer mask too small");
+
+/* Bitmask of free delayed works, for constant time allocation. */
+static uint32_t lwm2m_works_free = BIT_MASK(LWM2M_OS_MAX_TIMER_COUNT);
+
 static void work_handler(struct k_work *work)
 {
 	struct k_work_delayable *delayed_work = CONTAINER_OF(work, struct k_work_delayable, work);
@@ -215,13 +220,13 @@ lwm2m_os_timer_t *lwm2m_os_timer_get(lwm2m_os_timer_handler_t handler)
 
 	uint32_t key = irq_lock();
 
-	/* Find free delayed work */
-	for (int i = 0; i < ARRAY_SIZE(lwm2m_works); i++) {
-		if (lwm2m_works[i].handler == NULL) {
-			work = &lwm2m_works[i];
-			work->handler = handler;
-			break;
-		}
+	/* Take the lowest free delayed work */
+	if (lwm2m_works_free) {
+		int i = find_lsb_set(lwm2m_works_free) - 1;
+
+		lwm2m_works_free &= ~BIT(i);
+		work = &lwm2m_works[i];
+		work->handler = handler;
 	}
 
 	irq_unlock(key);
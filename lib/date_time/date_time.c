@@ -73,6 +73,30 @@ static struct time_aux {
 	int64_t last_date_time_update;
 } time_aux;
 
+#if defined(CONFIG_DATE_TIME_DRIFT_CORRECTION)
+/* Largest plausible drift of the uptime clock, in parts per million.
+ * Differences beyond it mean that the time was stepped.
+ */
+#define DRIFT_PPM_MAX 500
+
+/* Updates must be at least this far apart for the resolution of the time
+ * sources to give a drift estimate within DRIFT_PPM_MAX.
+ */
+#define DRIFT_BASELINE_MIN_MS \
+	((int64_t)CONFIG_DATE_TIME_DRIFT_TOLERANCE_MS * 1000000 / DRIFT_PPM_MAX)
+
+static struct time_drift {
+	/* First update of the current estimation */
+	int64_t ref_utc;
+	int64_t ref_uptime;
+	/* Uptime drift, in parts per million. Positive when uptime is slow. */
+	int32_t ppm;
+	uint32_t interval_s;
+} drift = {
+	.interval_s = CONFIG_DATE_TIME_UPDATE_INTERVAL_SECONDS,
+};
+#endif
+
 static bool initial_valid_time;
 static date_time_evt_handler_t app_evt_handler;
 
@@ -87,6 +111,94 @@ static void date_time_notify_event(const struct date_time_evt *evt)
 	}
 }
 
+static uint32_t update_interval_get(void)
+{
+#if defined(CONFIG_DATE_TIME_DRIFT_CORRECTION)
+	return drift.interval_s;
+#else
+	return CONFIG_DATE_TIME_UPDATE_INTERVAL_SECONDS;
+#endif
+}
+
+/* Date time UTC, in milliseconds, at the given uptime. */
+static int64_t time_extrapolate(int64_t uptime)
+{
+	int64_t elapsed = uptime - time_aux.last_date_time_update;
+
+#if defined(CONFIG_DATE_TIME_DRIFT_CORRECTION)
+	elapsed += elapsed * drift.ppm / 1000000;
+#endif
+
+	return time_aux.date_time_utc + elapsed;
+}
+
+#if defined(CONFIG_DATE_TIME_DRIFT_CORRECTION)
+static void drift_restart(int64_t utc, int64_t now)
+{
+	drift.ref_utc = utc;
+	drift.ref_uptime = now;
+	drift.interval_s = CONFIG_DATE_TIME_UPDATE_INTERVAL_SECONDS;
+}
+
+static void drift_update(int64_t utc, int64_t now)
+{
+	int64_t error;
+	int64_t elapsed;
+	int64_t baseline;
+
+	if (time_aux.last_date_time_update == 0) {
+		drift_restart(utc, now);
+		return;
+	}
+
+	error = utc - time_extrapolate(now);
+	elapsed = now - time_aux.last_date_time_update;
+
+	LOG_DBG("Extrapolated time was off by %lld ms", error);
+
+	if (llabs(error) > CONFIG_DATE_TIME_DRIFT_TOLERANCE_MS +
+			   elapsed * DRIFT_PPM_MAX / 1000000) {
+		LOG_DBG("Date time stepped, restarting drift estimation");
+		drift_restart(utc, now);
+		return;
+	}
+
+	/* Spacing the updates further apart as long as the extrapolation
+	 * holds, so that the time sources are used less often.
+	 */
+	if (llabs(error) <= CONFIG_DATE_TIME_DRIFT_TOLERANCE_MS) {
+		drift.interval_s = MIN(drift.interval_s * 2,
+				       CONFIG_DATE_TIME_UPDATE_INTERVAL_MAX_SECONDS);
+	} else {
+		drift.interval_s = CONFIG_DATE_TIME_UPDATE_INTERVAL_SECONDS;
+	}
+
+	/* The estimate gets more accurate as the baseline grows, since the
+	 * resolution of the time sources does not change.
+	 */
+	baseline = now - drift.ref_uptime;
+	if (baseline >= DRIFT_BASELINE_MIN_MS) {
+		int64_t ppm = ((utc - drift.ref_utc) - baseline) * 1000000 / baseline;
+
+		drift.ppm = CLAMP(ppm, -DRIFT_PPM_MAX, DRIFT_PPM_MAX);
+
+		LOG_DBG("Drift %d ppm over %lld s", drift.ppm, baseline / MSEC_PER_SEC);
+	}
+}
+#endif /* CONFIG_DATE_TIME_DRIFT_CORRECTION */
+
+static void time_update(int64_t utc)
+{
+	int64_t now = k_uptime_get();
+
+#if defined(CONFIG_DATE_TIME_DRIFT_CORRECTION)
+	drift_update(utc, now);
+#endif
+
+	time_aux.date_time_utc = utc;
+	time_aux.last_date_time_update = now;
+}
+
 #if defined(CONFIG_DATE_TIME_MODEM)
 static int time_modem_get(void)
 {
@@ -134,8 +246,7 @@ static int time_modem_get(void)
 		return -ENODATA;
 	}
 
-	time_aux.date_time_utc = (int64_t)timeutil_timegm64(&date_time) * 1000;
-	time_aux.last_date_time_update = k_uptime_get();
+	time_update((int64_t)timeutil_timegm64(&date_time) * 1000);
 
 	return 0;
 }
@@ -244,8 +355,9 @@ static int time_NTP_server_get(void)
 
 		LOG_DBG("Got time response from NTP server %s",
 			log_strdup(servers[i].server_str));
-		time_aux.date_time_utc = (int64_t)sntp_time.seconds * 1000;
-		time_aux.last_date_time_update = k_uptime_get();
+		/* The fraction is in units of 2^-32 seconds. */
+		time_update((int64_t)sntp_time.seconds * 1000 +
+			    (((uint64_t)sntp_time.fraction * 1000) >> 32));
 		return 0;
 	}
 
@@ -264,7 +376,7 @@ static int current_time_check(void)
 	}
 
 	if ((k_uptime_get() - time_aux.last_date_time_update) >
-	    CONFIG_DATE_TIME_UPDATE_INTERVAL_SECONDS * 1000) {
+	    (int64_t)update_interval_get() * 1000) {
 		LOG_DBG("Current date time too old");
 		return -ENODATA;
 	}
@@ -336,9 +448,9 @@ static void date_time_handler(struct k_work *work)
 		k_sem_give(&time_fetch_sem);
 
 		LOG_DBG("New date time update in: %d seconds",
-			CONFIG_DATE_TIME_UPDATE_INTERVAL_SECONDS);
+			update_interval_get());
 
-		k_work_schedule(&time_work, K_SECONDS(CONFIG_DATE_TIME_UPDATE_INTERVAL_SECONDS));
+		k_work_schedule(&time_work, K_SECONDS(update_interval_get()));
 	}
 }
 
@@ -415,8 +527,7 @@ int date_time_set(const struct tm *new_date_time)
 	}
 
 	initial_valid_time = true;
-	time_aux.last_date_time_update = k_uptime_get();
-	time_aux.date_time_utc = (int64_t)timeutil_timegm64(new_date_time) * 1000;
+	time_update((int64_t)timeutil_timegm64(new_date_time) * 1000);
 
 	evt.type = DATE_TIME_OBTAINED_EXT;
 	date_time_notify_event(&evt);
@@ -440,14 +551,13 @@ int date_time_uptime_to_unix_time_ms(int64_t *uptime)
 		return -ENODATA;
 	}
 
-	*uptime += time_aux.date_time_utc - time_aux.last_date_time_update;
+	*uptime = time_extrapolate(*uptime);
 
 	/** Check if the passed in uptime was allready converted,
 	 * meaning that after a second conversion it is greater than the
 	 * current date time UTC.
 	 */
-	if (*uptime > time_aux.date_time_utc +
-	    (k_uptime_get() - time_aux.last_date_time_update)) {
+	if (*uptime > time_extrapolate(k_uptime_get())) {
 		LOG_WRN("Uptime to large or previously converted");
 		LOG_WRN("Clear variable or set a new uptime");
 		*uptime = uptime_prev;
@@ -520,6 +630,10 @@ int date_time_clear(void)
 	time_aux.last_date_time_update = 0;
 	initial_valid_time = false;
 
+#if defined(CONFIG_DATE_TIME_DRIFT_CORRECTION)
+	drift.interval_s = CONFIG_DATE_TIME_UPDATE_INTERVAL_SECONDS;
+#endif
+
 	return 0;
 }
 
@@ -15,6 +15,10 @@
 
 LOG_MODULE_REGISTER(dk_buttons_and_leds, CONFIG_DK_LIBRARY_LOG_LEVEL);
 
+#ifndef CONFIG_DK_LIBRARY_BUTTON_DEBOUNCE_TIME
+#define CONFIG_DK_LIBRARY_BUTTON_DEBOUNCE_TIME 0
+#endif
+
 
 struct gpio_pin {
 	const char * const port;
@@ -99,6 +103,30 @@ static int callback_ctrl(bool enable)
 	return err;
 }
 
+/* Configure the interrupt of every button to fire on the level opposite to
+ * its current state, so that only transitions wake up the CPU.
+ */
+static int callback_ctrl_transition(uint32_t button_state)
+{
+	int err = 0;
+
+	for (size_t i = 0; (i < ARRAY_SIZE(button_pins)) && !err; i++) {
+		bool wait_for_high = !(button_state & BIT(i));
+		gpio_flags_t flags;
+
+		if (IS_ENABLED(CONFIG_DK_LIBRARY_INVERT_BUTTONS)) {
+			wait_for_high = !wait_for_high;
+		}
+
+		flags = wait_for_high ? GPIO_INT_LEVEL_HIGH : GPIO_INT_LEVEL_LOW;
+
+		err = gpio_pin_interrupt_configure(button_devs[i],
+			button_pins[i].number, flags);
+	}
+
+	return err;
+}
+
 static uint32_t get_buttons(void)
 {
 	uint32_t ret = 0;
@@ -157,7 +185,31 @@ static void buttons_scan_fn(struct k_work *work)
 
 	last_button_scan = button_scan;
 
-	if (button_scan != 0) {
+	if (IS_ENABLED(CONFIG_DK_LIBRARY_BUTTON_TRANSITIONS)) {
+		/* Wait for the next transition of any button, also if some
+		 * buttons are pressed.
+		 */
+		int err = 0;
+
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		switch (state) {
+		case STATE_SCANNING:
+			state = STATE_WAITING;
+			err = callback_ctrl_transition(button_scan);
+			break;
+
+		default:
+			__ASSERT_NO_MSG(false);
+			break;
+		}
+
+		k_spin_unlock(&lock, key);
+
+		if (err) {
+			LOG_ERR("Cannot enable callbacks");
+		}
+	} else if (button_scan != 0) {
 		k_work_reschedule(&buttons_scan,
 		  K_MSEC(CONFIG_DK_LIBRARY_BUTTON_SCAN_INTERVAL));
 
@@ -223,7 +275,13 @@ static void button_pressed(const struct device *gpio_dev, struct gpio_callback *
 	switch (state) {
 	case STATE_WAITING:
 		state = STATE_SCANNING;
-		k_work_reschedule(&buttons_scan, K_MSEC(1));
+		if (IS_ENABLED(CONFIG_DK_LIBRARY_BUTTON_TRANSITIONS)) {
+			/* Buttons are read once they stop bouncing. */
+			k_work_reschedule(&buttons_scan,
+				K_MSEC(CONFIG_DK_LIBRARY_BUTTON_DEBOUNCE_TIME));
+		} else {
+			k_work_reschedule(&buttons_scan, K_MSEC(1));
+		}
 		break;
 
 	case STATE_SCANNING:
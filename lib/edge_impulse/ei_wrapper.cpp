@@ -5,6 +5,7 @@
  */
 
 #include <assert.h>
+#include <math.h>
 #include <ei_run_classifier.h>
 #include <ei_wrapper.h>
 
@@ -22,6 +23,15 @@ BUILD_ASSERT(CONFIG_EI_WRAPPER_THREAD_STACK_SIZE > 0);
 #define THREAD_STACK_SIZE	CONFIG_EI_WRAPPER_THREAD_STACK_SIZE
 #define THREAD_PRIORITY 	CONFIG_EI_WRAPPER_THREAD_PRIORITY
 #define DEBUG_MODE		IS_ENABLED(CONFIG_EI_WRAPPER_DEBUG_MODE)
+#define CONTINUOUS		IS_ENABLED(CONFIG_EI_WRAPPER_CONTINUOUS)
+#define SLICE_SIZE		EI_CLASSIFIER_SLICE_SIZE
+#define SLICES_PER_WINDOW	EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW
+
+#ifdef CONFIG_EI_WRAPPER_DATA_BUF_INT16
+typedef int16_t buf_data_t;
+#else
+typedef float buf_data_t;
+#endif
 
 enum state {
 	STATE_DISABLED,
@@ -30,11 +40,18 @@ enum state {
 	STATE_READY,
 };
 
+/* Beginning of the buffer is mirrored after its end. Every input window can be
+ * read from a contiguous memory area.
+ */
+#define MIRROR_SIZE		INPUT_WINDOW_SIZE
+
 struct data_buffer {
-	float buf[DATA_BUFFER_SIZE];
+	buf_data_t buf[DATA_BUFFER_SIZE + MIRROR_SIZE];
 	size_t process_idx;
 	size_t append_idx;
 	size_t wait_data_size;
+	/* Slices of input window not fed to the continuous classifier. */
+	size_t slice_cnt;
 	struct k_spinlock lock;
 	enum state state;
 };
@@ -46,12 +63,16 @@ static k_tid_t ei_thread_id;
 static K_SEM_DEFINE(ei_sem, 0, 1);
 
 static struct data_buffer ei_input;
+static size_t signal_offset;
+/* Value represented by a single step of int16_t input data. */
+static float data_scale = 1.0f;
 static ei_impulse_result_t ei_result;
 static ei_wrapper_result_ready_cb user_cb;
 
 
 BUILD_ASSERT(DATA_BUFFER_SIZE > INPUT_WINDOW_SIZE);
 BUILD_ASSERT(INPUT_WINDOW_SIZE % INPUT_FRAME_SIZE == 0);
+BUILD_ASSERT(!CONTINUOUS || (INPUT_WINDOW_SIZE == SLICE_SIZE * SLICES_PER_WINDOW));
 
 
 static size_t buf_get_collected_data_count(const struct data_buffer *b)
@@ -60,17 +81,17 @@ static size_t buf_get_collected_data_count(const struct data_buffer *b)
 		return b->append_idx - b->process_idx;
 	}
 
-	return (ARRAY_SIZE(b->buf) - b->process_idx) + b->append_idx;
+	return (DATA_BUFFER_SIZE - b->process_idx) + b->append_idx;
 }
 
 static size_t buf_calc_free_space(const struct data_buffer *b)
 {
 	if (b->wait_data_size > 0) {
-		return b->wait_data_size + ARRAY_SIZE(b->buf) -
+		return b->wait_data_size + DATA_BUFFER_SIZE -
 		       INPUT_WINDOW_SIZE - 1;
 	}
 
-	return ARRAY_SIZE(b->buf) - buf_get_collected_data_count(b) - 1;
+	return DATA_BUFFER_SIZE - buf_get_collected_data_count(b) - 1;
 }
 
 static void buf_processing_end(struct data_buffer *b)
@@ -79,6 +100,7 @@ static void buf_processing_end(struct data_buffer *b)
 
 	__ASSERT_NO_MSG(b->state == STATE_PROCESSING);
 	b->state = STATE_READY;
+	b->slice_cnt = 0;
 
 	k_spin_unlock(&b->lock, key);
 }
@@ -100,6 +122,7 @@ static int buf_cleanup(struct data_buffer *b, bool *cancelled)
 		b->process_idx = 0;
 		b->append_idx = 0;
 		b->wait_data_size = 0;
+		b->slice_cnt = SLICES_PER_WINDOW;
 		b->state = STATE_READY;
 	}
 
@@ -108,7 +131,46 @@ static int buf_cleanup(struct data_buffer *b, bool *cancelled)
 	return err;
 }
 
-static int buf_append(struct data_buffer *b, const float *data, size_t len,
+static inline void data_convert(float *dst, const float *src, size_t len)
+{
+	memcpy(dst, src, len * sizeof(dst[0]));
+}
+
+static inline void data_convert(int16_t *dst, const int16_t *src, size_t len)
+{
+	memcpy(dst, src, len * sizeof(dst[0]));
+}
+
+static inline void data_convert(float *dst, const int16_t *src, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		dst[i] = src[i] * data_scale;
+	}
+}
+
+static inline void data_convert(int16_t *dst, const float *src, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		long val = lroundf(src[i] / data_scale);
+
+		dst[i] = MIN(MAX(val, INT16_MIN), INT16_MAX);
+	}
+}
+
+template <typename T>
+static void buf_write(struct data_buffer *b, size_t idx, const T *data,
+		      size_t len)
+{
+	data_convert(&b->buf[idx], data, len);
+
+	if (idx < MIRROR_SIZE) {
+		memcpy(&b->buf[DATA_BUFFER_SIZE + idx], &b->buf[idx],
+		       MIN(len, MIRROR_SIZE - idx) * sizeof(b->buf[0]));
+	}
+}
+
+template <typename T>
+static int buf_append(struct data_buffer *b, const T *data, size_t len,
 		      bool *process_buf)
 {
 	*process_buf = false;
@@ -134,8 +196,8 @@ static int buf_append(struct data_buffer *b, const float *data, size_t len,
 		}
 	}
 
-	if (new_idx >= ARRAY_SIZE(b->buf)) {
-		new_idx -= ARRAY_SIZE(b->buf);
+	if (new_idx >= DATA_BUFFER_SIZE) {
+		new_idx -= DATA_BUFFER_SIZE;
 		looped = true;
 	}
 
@@ -144,42 +206,27 @@ static int buf_append(struct data_buffer *b, const float *data, size_t len,
 	k_spin_unlock(&b->lock, key);
 
 	if (looped) {
-		size_t copy_cnt = ARRAY_SIZE(b->buf) - cur_idx;
+		size_t copy_cnt = DATA_BUFFER_SIZE - cur_idx;
 
-		memcpy(&b->buf[cur_idx], data, copy_cnt * sizeof(b->buf[0]));
-		memcpy(&b->buf[0], data + copy_cnt,
-		      (len - copy_cnt) * sizeof(b->buf[0]));
+		buf_write(b, cur_idx, data, copy_cnt);
+		buf_write(b, 0, data + copy_cnt, len - copy_cnt);
 	} else {
-		memcpy(&b->buf[cur_idx], data, len * sizeof(b->buf[0]));
+		buf_write(b, cur_idx, data, len);
 	}
 
 	return 0;
 }
 
-static void buf_get(const struct data_buffer *b, float *b_res, size_t offset,
-		    size_t len)
+static const buf_data_t *buf_get(const struct data_buffer *b, size_t offset,
+			    size_t len)
 {
 	__ASSERT_NO_MSG((offset + len) <= INPUT_WINDOW_SIZE);
+	ARG_UNUSED(len);
 
 	/* Processing index cannot change while processing is done. */
 	__ASSERT_NO_MSG(b->state == STATE_PROCESSING);
 
-	size_t read_start = b->process_idx + offset;
-	size_t read_end = read_start + len;
-
-	if ((read_end > ARRAY_SIZE(b->buf)) && (read_start < ARRAY_SIZE(b->buf))) {
-		size_t copy_cnt = ARRAY_SIZE(b->buf) - read_start;
-
-		memcpy(b_res, &b->buf[read_start],
-		       copy_cnt * sizeof(b->buf[0]));
-		memcpy(b_res + copy_cnt, &b->buf[0],
-		       (len - copy_cnt) * sizeof(b->buf[0]));
-	} else {
-		if (read_start >= ARRAY_SIZE(b->buf)) {
-			read_start -= ARRAY_SIZE(b->buf);
-		}
-		memcpy(b_res, &b->buf[read_start], len * sizeof(b->buf[0]));
-	}
+	return &b->buf[b->process_idx + offset];
 }
 
 static int buf_processing_move(struct data_buffer *b, size_t move,
@@ -199,9 +246,11 @@ static int buf_processing_move(struct data_buffer *b, size_t move,
 
 	size_t max_move = buf_get_collected_data_count(b);
 
+	b->slice_cnt = MIN(b->slice_cnt + move / SLICE_SIZE, SLICES_PER_WINDOW);
+
 	b->process_idx += move;
-	if (b->process_idx >= ARRAY_SIZE(b->buf)) {
-		b->process_idx -= ARRAY_SIZE(b->buf);
+	if (b->process_idx >= DATA_BUFFER_SIZE) {
+		b->process_idx -= DATA_BUFFER_SIZE;
 	}
 
 	size_t processing_end_move = move + INPUT_WINDOW_SIZE;
@@ -233,7 +282,8 @@ size_t ei_wrapper_get_window_size(void)
 	return INPUT_WINDOW_SIZE;
 }
 
-int ei_wrapper_add_data(const float *data, size_t data_size)
+template <typename T>
+static int add_data(const T *data, size_t data_size)
 {
 	if (data_size % INPUT_FRAME_SIZE) {
 		return -EINVAL;
@@ -249,9 +299,37 @@ int ei_wrapper_add_data(const float *data, size_t data_size)
 	return err;
 }
 
+int ei_wrapper_add_data(const float *data, size_t data_size)
+{
+	return add_data(data, data_size);
+}
+
+int ei_wrapper_add_data_int16(const int16_t *data, size_t data_size)
+{
+	return add_data(data, data_size);
+}
+
+int ei_wrapper_set_data_scale(float scale)
+{
+	if (!(scale > 0.0f)) {
+		return -EINVAL;
+	}
+
+	data_scale = scale;
+
+	return 0;
+}
+
 int ei_wrapper_clear_data(bool *cancelled)
 {
-	return buf_cleanup(&ei_input, cancelled);
+	int err = buf_cleanup(&ei_input, cancelled);
+
+	if (!err && CONTINUOUS) {
+		/* Drop the features of the data that was cleared. */
+		run_classifier_init();
+	}
+
+	return err;
 }
 
 int ei_wrapper_start_prediction(size_t window_shift, size_t frame_shift)
@@ -259,6 +337,10 @@ int ei_wrapper_start_prediction(size_t window_shift, size_t frame_shift)
 	size_t sample_shift = window_shift * ei_wrapper_get_window_size() +
 			      frame_shift * ei_wrapper_get_frame_size();
 
+	if (CONTINUOUS && (sample_shift % SLICE_SIZE)) {
+		return -EINVAL;
+	}
+
 	bool process_buf;
 	int err = buf_processing_move(&ei_input, sample_shift, &process_buf);
 
@@ -271,7 +353,9 @@ int ei_wrapper_start_prediction(size_t window_shift, size_t frame_shift)
 
 static int raw_feature_get_data(size_t offset, size_t length, float *out_ptr)
 {
-	buf_get(&ei_input, out_ptr, offset, length);
+	/* The int16_t data is scaled only when read by the library. */
+	data_convert(out_ptr, buf_get(&ei_input, signal_offset + offset, length),
+		     length);
 
 	return 0;
 }
@@ -284,6 +368,40 @@ static void processing_finished(int err)
 	user_cb(err);
 }
 
+static EI_IMPULSE_ERROR run_classifier_slices(signal_t *signal)
+{
+	EI_IMPULSE_ERROR err = EI_IMPULSE_OK;
+	int dsp_time = 0;
+	int classification_time = 0;
+	int anomaly_time = 0;
+
+	/* Results of the previous prediction are valid if input window was
+	 * not shifted.
+	 */
+	if (ei_input.slice_cnt == 0) {
+		return err;
+	}
+
+	signal->total_length = SLICE_SIZE;
+
+	for (size_t i = ei_input.slice_cnt; (i > 0) && !err; i--) {
+		signal_offset = INPUT_WINDOW_SIZE - i * SLICE_SIZE;
+		err = run_classifier_continuous(signal, &ei_result, DEBUG_MODE,
+						false);
+
+		dsp_time += ei_result.timing.dsp;
+		classification_time += ei_result.timing.classification;
+		anomaly_time += ei_result.timing.anomaly;
+	}
+
+	/* Report costs of processing all of the new slices. */
+	ei_result.timing.dsp = dsp_time;
+	ei_result.timing.classification = classification_time;
+	ei_result.timing.anomaly = anomaly_time;
+
+	return err;
+}
+
 static void edge_impulse_thread_fn(void)
 {
 	signal_t features_signal;
@@ -295,8 +413,15 @@ static void edge_impulse_thread_fn(void)
 		features_signal.total_length = INPUT_WINDOW_SIZE;
 
 		/* Invoke the impulse. */
-		EI_IMPULSE_ERROR err = run_classifier(&features_signal,
-						      &ei_result, DEBUG_MODE);
+		EI_IMPULSE_ERROR err;
+
+		if (CONTINUOUS) {
+			err = run_classifier_slices(&features_signal);
+		} else {
+			signal_offset = 0;
+			err = run_classifier(&features_signal, &ei_result,
+					     DEBUG_MODE);
+		}
 
 		if (err) {
 			LOG_ERR("run_classifier err=%d", err);
@@ -380,6 +505,10 @@ int ei_wrapper_init(ei_wrapper_result_ready_cb cb)
 	__ASSERT_NO_MSG(!err);
 	ARG_UNUSED(err);
 
+	if (CONTINUOUS) {
+		run_classifier_init();
+	}
+
 	ei_thread_id = k_thread_create(&thread, thread_stack, THREAD_STACK_SIZE,
 				       (k_thread_entry_t)edge_impulse_thread_fn,
 				       NULL, NULL, NULL,
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <fprotect.h>
+#include "fprotect_internal.h"
+
+#define FLASH_END (CONFIG_FLASH_BASE_ADDRESS + (CONFIG_FLASH_SIZE * 1024))
+
+int fprotect_areas(const struct fprotect_region *regions, size_t count)
+{
+	uint32_t blocks[FPROTECT_BLOCK_WORDS] = {0};
+	uint32_t first;
+	uint32_t last;
+
+	if (regions == NULL || count == 0) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		uint32_t start = regions[i].start;
+		size_t length = regions[i].length;
+
+		if ((start % CONFIG_FPROTECT_BLOCK_SIZE) ||
+		    (length % CONFIG_FPROTECT_BLOCK_SIZE) ||
+		    (length == 0) ||
+		    (start < CONFIG_FLASH_BASE_ADDRESS) ||
+		    (start >= FLASH_END) ||
+		    (length > FLASH_END - start)) {
+			return -EINVAL;
+		}
+
+		first = (start - CONFIG_FLASH_BASE_ADDRESS) /
+			CONFIG_FPROTECT_BLOCK_SIZE;
+		last = first + length / CONFIG_FPROTECT_BLOCK_SIZE;
+
+		/* Overlapping and adjacent regions merge in the bitmap. */
+		for (uint32_t block = first; block < last; block++) {
+			blocks[block / 32] |= BIT(block % 32);
+		}
+	}
+
+	return fprotect_blocks(blocks);
+}
@@ -9,6 +9,7 @@
 #include <errno.h>
 #include <sys/__assert.h>
 #include <kernel.h>
+#include "fprotect_internal.h"
 
 /* Find the first unused ACL region. */
 static int find_free_region(uint32_t *region_idx)
@@ -62,6 +63,54 @@ int fprotect_area(uint32_t start, size_t length)
 				       NRF_ACL_PERM_READ_NO_WRITE);
 }
 
+static bool block_is_set(const uint32_t *blocks, uint32_t block)
+{
+	return (block < FPROTECT_BLOCKS_NUM) &&
+	       (blocks[block / 32] & BIT(block % 32));
+}
+
+int fprotect_blocks(const uint32_t *blocks)
+{
+	uint32_t block = 0;
+	uint32_t run_start;
+	uint32_t start;
+	size_t length;
+	size_t chunk;
+	int err;
+
+	/* Each run of consecutive blocks takes a single ACL region, or more
+	 * if it is longer than the maximum region size.
+	 */
+	while (block < FPROTECT_BLOCKS_NUM) {
+		if (!block_is_set(blocks, block)) {
+			block++;
+			continue;
+		}
+
+		run_start = block;
+		while (block_is_set(blocks, block)) {
+			block++;
+		}
+
+		start = CONFIG_FLASH_BASE_ADDRESS +
+			run_start * CONFIG_FPROTECT_BLOCK_SIZE;
+		length = (block - run_start) * CONFIG_FPROTECT_BLOCK_SIZE;
+
+		while (length > 0) {
+			chunk = MIN(length, NRF_ACL_REGION_SIZE_MAX);
+			err = fprotect_set_permission(start, chunk,
+					NRF_ACL_PERM_READ_NO_WRITE);
+			if (err) {
+				return err;
+			}
+			start += chunk;
+			length -= chunk;
+		}
+	}
+
+	return 0;
+}
+
 #if defined(CONFIG_FPROTECT_ENABLE_NO_ACCESS)
 
 int fprotect_area_no_access(uint32_t start, size_t length)
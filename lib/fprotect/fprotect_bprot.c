@@ -20,6 +20,7 @@
 #endif
 #include <sys/util.h>
 #include <errno.h>
+#include "fprotect_internal.h"
 
  /* The number of CONFIG registers present in the chip. */
 #define BPROT_CONFIGS_NUM ceiling_fraction(BPROT_REGIONS_NUM, BITS_PER_LONG)
@@ -64,3 +65,22 @@ int fprotect_area(uint32_t start, size_t length)
 
 	return 0;
 }
+
+int fprotect_blocks(const uint32_t *blocks)
+{
+	BUILD_ASSERT(BITS_PER_LONG == 32);
+
+	ENABLE_PROTECTION_IN_DEBUG(NRF_BPROT,
+				   ENABLE_IN_DEBUG
+				   );
+
+	/* One write per CONFIG register containing protected blocks. */
+	for (uint32_t i = 0;
+	     i < MIN(BPROT_CONFIGS_NUM, FPROTECT_BLOCK_WORDS); i++) {
+		if (blocks[i]) {
+			PROTECT(NRF_BPROT, i, blocks[i]);
+		}
+	}
+
+	return 0;
+}
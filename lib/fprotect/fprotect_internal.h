@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef FPROTECT_INTERNAL_H_
+#define FPROTECT_INTERNAL_H_
+
+#include <zephyr/types.h>
+#include <sys/util.h>
+
+/* Number of protection blocks in the flash. */
+#define FPROTECT_BLOCKS_NUM \
+	((CONFIG_FLASH_SIZE * 1024) / CONFIG_FPROTECT_BLOCK_SIZE)
+
+/* Number of words in a bitmap of protection blocks. */
+#define FPROTECT_BLOCK_WORDS ceiling_fraction(FPROTECT_BLOCKS_NUM, 32)
+
+/* Write-protect blocks set in the bitmap. Bit n of the bitmap corresponds
+ * to the block starting at CONFIG_FLASH_BASE_ADDRESS +
+ * n * CONFIG_FPROTECT_BLOCK_SIZE. Implemented by the backend.
+ */
+int fprotect_blocks(const uint32_t *blocks);
+
+#endif /* FPROTECT_INTERNAL_H_ */
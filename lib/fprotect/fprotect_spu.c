@@ -10,6 +10,7 @@
 #include <errno.h>
 #include <soc.h>
 #include <nrf_erratas.h>
+#include "fprotect_internal.h"
 
 
 #define SPU_BLOCK_SIZE CONFIG_FPROTECT_BLOCK_SIZE
@@ -32,3 +33,20 @@ int fprotect_area(uint32_t start, size_t length)
 
 	return 0;
 }
+
+int fprotect_blocks(const uint32_t *blocks)
+{
+	/* SPU has one configuration register per region, so each protected
+	 * region is written exactly once.
+	 */
+	for (uint32_t i = 0; i < FPROTECT_BLOCKS_NUM; i++) {
+		if (blocks[i / 32] & BIT(i % 32)) {
+			nrf_spu_flashregion_set(NRF_SPU_S, i, true,
+						NRF_SPU_MEM_PERM_EXECUTE |
+						NRF_SPU_MEM_PERM_READ,
+						true);
+		}
+	}
+
+	return 0;
+}
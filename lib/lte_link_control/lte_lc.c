@@ -20,6 +20,7 @@
 #include <logging/log.h>
 
 #include "lte_lc_helpers.h"
+#include "lte_lc_tx_sched.h"
 
 LOG_MODULE_REGISTER(lte_lc, CONFIG_LTE_LINK_CONTROL_LOG_LEVEL);
 
@@ -163,6 +164,23 @@ static const char thingy91_magpio[] = {
 
 static struct k_sem link;
 
+/* Link state cache, used with CONFIG_LTE_LC_STATE_CACHE. Each group of
+ * values is only returned once it has been set from a notification, from a
+ * command sent by the library or from a read.
+ */
+static struct {
+	struct lte_lc_link_state state;
+	enum lte_lc_system_mode sys_mode;
+	enum lte_lc_system_mode_preference sys_mode_pref;
+	/* nw_reg_status, cell and lte_mode */
+	bool reg_valid;
+	bool psm_valid;
+	bool rrc_valid;
+	bool func_mode_valid;
+	bool sys_mode_valid;
+} cache;
+static struct k_spinlock cache_lock;
+
 static const char *const at_notifs[] = {
 	[LTE_LC_NOTIF_CEREG]		= "+CEREG",
 	[LTE_LC_NOTIF_CSCON]		= "+CSCON",
@@ -199,6 +217,112 @@ static bool is_cellid_valid(uint32_t cellid)
 	return true;
 }
 
+static bool is_registered(enum lte_lc_nw_reg_status status)
+{
+	return (status == LTE_LC_NW_REG_REGISTERED_HOME) ||
+	       (status == LTE_LC_NW_REG_REGISTERED_ROAMING);
+}
+
+static void cache_reg_update(enum lte_lc_nw_reg_status status,
+			     const struct lte_lc_cell *cell,
+			     enum lte_lc_lte_mode lte_mode,
+			     const struct lte_lc_psm_cfg *psm_cfg)
+{
+	k_spinlock_key_t key;
+
+	if (!IS_ENABLED(CONFIG_LTE_LC_STATE_CACHE)) {
+		return;
+	}
+
+	key = k_spin_lock(&cache_lock);
+
+	cache.state.nw_reg_status = status;
+	cache.state.cell = *cell;
+	cache.state.lte_mode = lte_mode;
+	cache.reg_valid = true;
+
+	/* The PSM configuration is only reported while registered. */
+	if (is_registered(status)) {
+		cache.state.psm_cfg = *psm_cfg;
+	} else {
+		cache.state.psm_cfg.tau = -1;
+		cache.state.psm_cfg.active_time = -1;
+	}
+
+	cache.psm_valid = true;
+
+	k_spin_unlock(&cache_lock, key);
+}
+
+static void cache_rrc_update(enum lte_lc_rrc_mode mode)
+{
+	k_spinlock_key_t key;
+
+	if (!IS_ENABLED(CONFIG_LTE_LC_STATE_CACHE)) {
+		return;
+	}
+
+	key = k_spin_lock(&cache_lock);
+	cache.state.rrc_mode = mode;
+	cache.rrc_valid = true;
+	k_spin_unlock(&cache_lock, key);
+}
+
+static void cache_func_mode_update(enum lte_lc_func_mode mode)
+{
+	k_spinlock_key_t key;
+
+	if (!IS_ENABLED(CONFIG_LTE_LC_STATE_CACHE)) {
+		return;
+	}
+
+	key = k_spin_lock(&cache_lock);
+
+	cache.state.func_mode = mode;
+	cache.func_mode_valid = true;
+
+	/* Powering off the modem resets the notification subscriptions, so
+	 * the values that are kept current from notifications can no longer
+	 * be trusted.
+	 */
+	if (mode == LTE_LC_FUNC_MODE_POWER_OFF) {
+		cache.reg_valid = false;
+		cache.psm_valid = false;
+		cache.rrc_valid = false;
+	}
+
+	k_spin_unlock(&cache_lock, key);
+}
+
+static void cache_sys_mode_update(enum lte_lc_system_mode mode,
+				  enum lte_lc_system_mode_preference preference)
+{
+	k_spinlock_key_t key;
+
+	if (!IS_ENABLED(CONFIG_LTE_LC_STATE_CACHE)) {
+		return;
+	}
+
+	key = k_spin_lock(&cache_lock);
+	cache.sys_mode = mode;
+	cache.sys_mode_pref = preference;
+	cache.sys_mode_valid = true;
+	k_spin_unlock(&cache_lock, key);
+}
+
+static void cache_invalidate(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&cache_lock);
+
+	cache.reg_valid = false;
+	cache.psm_valid = false;
+	cache.rrc_valid = false;
+	cache.func_mode_valid = false;
+	cache.sys_mode_valid = false;
+
+	k_spin_unlock(&cache_lock, key);
+}
+
 static void at_handler(void *context, const char *response)
 {
 	ARG_UNUSED(context);
@@ -246,11 +370,16 @@ static void at_handler(void *context, const char *response)
 			reg_status = LTE_LC_NW_REG_UNKNOWN;
 		}
 
-		if ((reg_status == LTE_LC_NW_REG_REGISTERED_HOME) ||
-		    (reg_status == LTE_LC_NW_REG_REGISTERED_ROAMING)) {
+		if (is_registered(reg_status)) {
 			k_sem_give(&link);
 		}
 
+		cache_reg_update(reg_status, &cell, lte_mode, &psm_cfg);
+
+		if (IS_ENABLED(CONFIG_LTE_LC_TX_SCHED) && is_registered(reg_status)) {
+			tx_sched_psm_update(&psm_cfg);
+		}
+
 		switch (reg_status) {
 		case LTE_LC_NW_REG_NOT_REGISTERED:
 			LTE_LC_TRACE(LTE_LC_TRACE_NW_REG_NOT_REGISTERED);
@@ -342,6 +471,12 @@ static void at_handler(void *context, const char *response)
 			return;
 		}
 
+		cache_rrc_update(evt.rrc_mode);
+
+		if (IS_ENABLED(CONFIG_LTE_LC_TX_SCHED)) {
+			tx_sched_rrc_update(evt.rrc_mode);
+		}
+
 		if (evt.rrc_mode == LTE_LC_RRC_MODE_IDLE) {
 			LTE_LC_TRACE(LTE_LC_TRACE_RRC_IDLE);
 		} else if (evt.rrc_mode == LTE_LC_RRC_MODE_CONNECTED) {
@@ -374,6 +509,10 @@ static void at_handler(void *context, const char *response)
 			return;
 		}
 
+		if (IS_ENABLED(CONFIG_LTE_LC_TX_SCHED)) {
+			tx_sched_tau_update(evt.time);
+		}
+
 		if (evt.time != CONFIG_LTE_LC_TAU_PRE_WARNING_TIME_MS) {
 			/* Only propagate TAU pre-warning notifications when the received time
 			 * parameter is the duration of the set pre-warning time.
@@ -381,6 +520,10 @@ static void at_handler(void *context, const char *response)
 			return;
 		}
 
+		if (IS_ENABLED(CONFIG_LTE_LC_TX_SCHED)) {
+			tx_sched_tau_pre_warning();
+		}
+
 		evt.type = LTE_LC_EVT_TAU_PRE_WARNING;
 		notify = true;
 
@@ -792,6 +935,7 @@ int lte_lc_deinit(void)
 	if (is_initialized) {
 		is_initialized = false;
 		at_notif_deregister_handler(NULL, at_handler);
+		cache_invalidate();
 		return lte_lc_func_mode_set(LTE_LC_FUNC_MODE_POWER_OFF);
 	}
 
@@ -886,6 +1030,19 @@ int lte_lc_psm_get(int *tau, int *active_time)
 		return -EINVAL;
 	}
 
+	if (IS_ENABLED(CONFIG_LTE_LC_STATE_CACHE)) {
+		k_spinlock_key_t key = k_spin_lock(&cache_lock);
+		bool valid = cache.psm_valid;
+
+		*tau = cache.state.psm_cfg.tau;
+		*active_time = cache.state.psm_cfg.active_time;
+		k_spin_unlock(&cache_lock, key);
+
+		if (valid) {
+			return 0;
+		}
+	}
+
 	/* Enable network registration status with PSM information */
 	err = at_cmd_write(AT_CEREG_5, NULL, 0, NULL);
 	if (err) {
@@ -1092,15 +1249,14 @@ int lte_lc_rai_param_set(const char *value)
 	return 0;
 }
 
-int lte_lc_nw_reg_status_get(enum lte_lc_nw_reg_status *status)
+/* Read the network registration status, cell, LTE mode and PSM configuration
+ * from the modem, and update the cache.
+ */
+static int cereg_read(struct lte_lc_link_state *state)
 {
 	int err;
 	char buf[AT_CEREG_RESPONSE_MAX_LEN] = {0};
 
-	if (status == NULL) {
-		return -EINVAL;
-	}
-
 	/* Enable network registration status with level 5 */
 	err = at_cmd_write(AT_CEREG_5, NULL, 0, NULL);
 	if (err) {
@@ -1115,13 +1271,70 @@ int lte_lc_nw_reg_status_get(enum lte_lc_nw_reg_status *status)
 		return err;
 	}
 
-	err = parse_cereg(buf, false, status, NULL, NULL, NULL);
+	err = parse_cereg(buf, false, &state->nw_reg_status, &state->cell,
+			  &state->lte_mode, &state->psm_cfg);
 	if (err) {
 		LOG_ERR("Could not parse registration status, err: %d", err);
 		return err;
 	}
 
-	return err;
+	cache_reg_update(state->nw_reg_status, &state->cell, state->lte_mode,
+			 &state->psm_cfg);
+
+	return 0;
+}
+
+static int rrc_mode_read(enum lte_lc_rrc_mode *mode)
+{
+	int err;
+	char buf[AT_CSCON_RESPONSE_MAX_LEN] = {0};
+
+	err = at_cmd_write(AT_CSCON_READ, buf, sizeof(buf), NULL);
+	if (err) {
+		LOG_ERR("Could not get CSCON response, error: %d", err);
+		return err;
+	}
+
+	err = parse_rrc_mode(buf, mode, AT_CSCON_READ_RRC_MODE_INDEX);
+	if (err) {
+		LOG_ERR("Could not parse RRC mode, err: %d", err);
+		return err;
+	}
+
+	cache_rrc_update(*mode);
+
+	return 0;
+}
+
+int lte_lc_nw_reg_status_get(enum lte_lc_nw_reg_status *status)
+{
+	int err;
+	struct lte_lc_link_state state;
+
+	if (status == NULL) {
+		return -EINVAL;
+	}
+
+	if (IS_ENABLED(CONFIG_LTE_LC_STATE_CACHE)) {
+		k_spinlock_key_t key = k_spin_lock(&cache_lock);
+		bool valid = cache.reg_valid;
+
+		*status = cache.state.nw_reg_status;
+		k_spin_unlock(&cache_lock, key);
+
+		if (valid) {
+			return 0;
+		}
+	}
+
+	err = cereg_read(&state);
+	if (err) {
+		return err;
+	}
+
+	*status = state.nw_reg_status;
+
+	return 0;
 }
 
 int lte_lc_system_mode_set(enum lte_lc_system_mode mode,
@@ -1170,6 +1383,8 @@ int lte_lc_system_mode_set(enum lte_lc_system_mode mode,
 	err = at_cmd_write(cmd, NULL, 0, NULL);
 	if (err) {
 		LOG_ERR("Could not send AT command, error: %d", err);
+	} else {
+		cache_sys_mode_update(mode, preference);
 	}
 
 	sys_mode_current = mode;
@@ -1193,6 +1408,21 @@ int lte_lc_system_mode_get(enum lte_lc_system_mode *mode,
 		return -EINVAL;
 	}
 
+	if (IS_ENABLED(CONFIG_LTE_LC_STATE_CACHE)) {
+		k_spinlock_key_t key = k_spin_lock(&cache_lock);
+		bool valid = cache.sys_mode_valid;
+
+		*mode = cache.sys_mode;
+		if (preference != NULL) {
+			*preference = cache.sys_mode_pref;
+		}
+		k_spin_unlock(&cache_lock, key);
+
+		if (valid) {
+			return 0;
+		}
+	}
+
 	err = at_cmd_write(AT_XSYSTEMMODE_READ, response, sizeof(response),
 			   NULL);
 	if (err) {
@@ -1327,13 +1557,18 @@ int lte_lc_system_mode_get(enum lte_lc_system_mode *mode,
 		mode_pref_current = *preference;
 	}
 
+	/* The preference is only known if it was requested. */
+	if (preference != NULL) {
+		cache_sys_mode_update(*mode, *preference);
+	}
+
 clean_exit:
 	at_params_list_free(&resp_list);
 
 	return err;
 }
 
-int lte_lc_func_mode_get(enum lte_lc_func_mode *mode)
+static int func_mode_read(enum lte_lc_func_mode *mode)
 {
 	int err, resp_mode;
 	struct at_param_list resp_list = {0};
@@ -1341,10 +1576,6 @@ int lte_lc_func_mode_get(enum lte_lc_func_mode *mode)
 	char response_prefix[sizeof(AT_CFUN_RESPONSE_PREFIX)] = {0};
 	size_t response_prefix_len = sizeof(response_prefix);
 
-	if (mode == NULL) {
-		return -EINVAL;
-	}
-
 	err = at_cmd_write(AT_CFUN_READ, response, sizeof(response), NULL);
 	if (err) {
 		LOG_ERR("Could not send AT command");
@@ -1388,6 +1619,7 @@ int lte_lc_func_mode_get(enum lte_lc_func_mode *mode)
 	}
 
 	*mode = resp_mode;
+	cache_func_mode_update(*mode);
 
 clean_exit:
 	at_params_list_free(&resp_list);
@@ -1395,6 +1627,27 @@ clean_exit:
 	return err;
 }
 
+int lte_lc_func_mode_get(enum lte_lc_func_mode *mode)
+{
+	if (mode == NULL) {
+		return -EINVAL;
+	}
+
+	if (IS_ENABLED(CONFIG_LTE_LC_STATE_CACHE)) {
+		k_spinlock_key_t key = k_spin_lock(&cache_lock);
+		bool valid = cache.func_mode_valid;
+
+		*mode = cache.state.func_mode;
+		k_spin_unlock(&cache_lock, key);
+
+		if (valid) {
+			return 0;
+		}
+	}
+
+	return func_mode_read(mode);
+}
+
 int lte_lc_func_mode_set(enum lte_lc_func_mode mode)
 {
 	char buf[12];
@@ -1459,28 +1712,99 @@ int lte_lc_func_mode_set(enum lte_lc_func_mode mode)
 		return -EFAULT;
 	}
 
-	return at_cmd_write(buf, NULL, 0, NULL);
+	err = at_cmd_write(buf, NULL, 0, NULL);
+	if (err) {
+		return err;
+	}
+
+	/* Modes that only activate or deactivate a part of the modem are not
+	 * reported as such by AT+CFUN?, so they are read back when needed.
+	 */
+	if ((mode == LTE_LC_FUNC_MODE_POWER_OFF) ||
+	    (mode == LTE_LC_FUNC_MODE_NORMAL) ||
+	    (mode == LTE_LC_FUNC_MODE_OFFLINE)) {
+		cache_func_mode_update(mode);
+	} else if (IS_ENABLED(CONFIG_LTE_LC_STATE_CACHE)) {
+		k_spinlock_key_t key = k_spin_lock(&cache_lock);
+
+		cache.func_mode_valid = false;
+		k_spin_unlock(&cache_lock, key);
+	}
+
+	return 0;
 }
 
 int lte_lc_lte_mode_get(enum lte_lc_lte_mode *mode)
 {
 	int err;
-	char buf[AT_CEREG_RESPONSE_MAX_LEN] = {0};
+	struct lte_lc_link_state state;
 
-	/* Read network registration status */
-	err = at_cmd_write(AT_CEREG_READ, buf, sizeof(buf), NULL);
+	if (mode == NULL) {
+		return -EINVAL;
+	}
+
+	if (IS_ENABLED(CONFIG_LTE_LC_STATE_CACHE)) {
+		k_spinlock_key_t key = k_spin_lock(&cache_lock);
+		bool valid = cache.reg_valid;
+
+		*mode = cache.state.lte_mode;
+		k_spin_unlock(&cache_lock, key);
+
+		if (valid) {
+			return 0;
+		}
+	}
+
+	err = cereg_read(&state);
 	if (err) {
-		LOG_ERR("Could not get CEREG response, error: %d", err);
 		return err;
 	}
 
-	err = parse_cereg(buf, false, NULL, NULL, mode, NULL);
+	*mode = state.lte_mode;
+
+	return 0;
+}
+
+int lte_lc_link_state_get(struct lte_lc_link_state *state, bool refresh)
+{
+	int err;
+
+	if (state == NULL) {
+		return -EINVAL;
+	}
+
+	if (IS_ENABLED(CONFIG_LTE_LC_STATE_CACHE) && !refresh) {
+		k_spinlock_key_t key = k_spin_lock(&cache_lock);
+		bool valid = cache.reg_valid && cache.psm_valid &&
+			     cache.rrc_valid && cache.func_mode_valid;
+
+		*state = cache.state;
+		k_spin_unlock(&cache_lock, key);
+
+		if (valid) {
+			return 0;
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_LTE_LC_STATE_CACHE)) {
+		k_spinlock_key_t key = k_spin_lock(&cache_lock);
+
+		/* Not part of the link state, read on the next request. */
+		cache.sys_mode_valid = false;
+		k_spin_unlock(&cache_lock, key);
+	}
+
+	err = cereg_read(state);
 	if (err) {
-		LOG_ERR("Could not parse registration status, err: %d", err);
 		return err;
 	}
 
-	return 0;
+	err = rrc_mode_read(&state->rrc_mode);
+	if (err) {
+		return err;
+	}
+
+	return func_mode_read(&state->func_mode);
 }
 
 int lte_lc_neighbor_cell_measurement(void)
@@ -402,13 +402,20 @@ int parse_rrc_mode(const char *at_response,
 {
 	int err, temp_mode;
 	struct at_param_list resp_list = {0};
+	uint8_t resp_arena[AT_PARAMS_ARENA_SIZE(AT_CSCON_PARAMS_COUNT_MAX, 0)];
 
-	err = at_params_list_init(&resp_list, AT_CSCON_PARAMS_COUNT_MAX);
+	err = at_params_list_init_static(&resp_list, AT_CSCON_PARAMS_COUNT_MAX,
+					 resp_arena, sizeof(resp_arena));
 	if (err) {
 		LOG_ERR("Could not init AT params list, error: %d", err);
 		return err;
 	}
 
+	/* Strings are only read while the response is available, so the
+	 * parameters never need storage beyond the static list.
+	 */
+	(void)at_params_list_string_view_set(&resp_list, true);
+
 	/* Parse CSCON response and populate AT parameter list */
 	err = at_parser_params_from_str(at_response,
 					NULL,
@@ -450,17 +457,24 @@ int parse_cereg(const char *at_response,
 {
 	int err, status;
 	struct at_param_list resp_list;
+	uint8_t resp_arena[AT_PARAMS_ARENA_SIZE(AT_CEREG_PARAMS_COUNT_MAX, 0)];
 	char str_buf[10];
 	char  response_prefix[sizeof(AT_CEREG_RESPONSE_PREFIX)] = {0};
 	size_t response_prefix_len = sizeof(response_prefix);
 	size_t len = sizeof(str_buf) - 1;
 
-	err = at_params_list_init(&resp_list, AT_CEREG_PARAMS_COUNT_MAX);
+	err = at_params_list_init_static(&resp_list, AT_CEREG_PARAMS_COUNT_MAX,
+					 resp_arena, sizeof(resp_arena));
 	if (err) {
 		LOG_ERR("Could not init AT params list, error: %d", err);
 		return err;
 	}
 
+	/* Strings are only read while the response is available, so the
+	 * parameters never need storage beyond the static list.
+	 */
+	(void)at_params_list_string_view_set(&resp_list, true);
+
 	/* Parse CEREG response and populate AT parameter list */
 	err = at_parser_params_from_str(at_response,
 					NULL,
@@ -879,18 +893,25 @@ int parse_xmodemsleep(const char *at_response, struct lte_lc_modem_sleep *modem_
 {
 	int err;
 	struct at_param_list resp_list = {0};
+	uint8_t resp_arena[AT_PARAMS_ARENA_SIZE(AT_XMODEMSLEEP_PARAMS_COUNT_MAX, 0)];
 	uint16_t type;
 
 	if (modem_sleep == NULL || at_response == NULL) {
 		return -EINVAL;
 	}
 
-	err = at_params_list_init(&resp_list, AT_XMODEMSLEEP_PARAMS_COUNT_MAX);
+	err = at_params_list_init_static(&resp_list, AT_XMODEMSLEEP_PARAMS_COUNT_MAX,
+					 resp_arena, sizeof(resp_arena));
 	if (err) {
 		LOG_ERR("Could not init AT params list, error: %d", err);
 		return err;
 	}
 
+	/* Strings are only read while the response is available, so the
+	 * parameters never need storage beyond the static list.
+	 */
+	(void)at_params_list_string_view_set(&resp_list, true);
+
 	/* Parse XMODEMSLEEP response and populate AT parameter list */
 	err = at_parser_params_from_str(at_response, NULL, &resp_list);
 	if (err) {
@@ -65,10 +65,12 @@
 #define AT_CEDRXP_NW_PTW_INDEX			4
 
 /* CSCON command parameters */
+#define AT_CSCON_READ				"AT+CSCON?"
 #define AT_CSCON_RESPONSE_PREFIX		"+CSCON"
 #define AT_CSCON_PARAMS_COUNT_MAX		4
 #define AT_CSCON_RRC_MODE_INDEX			1
 #define AT_CSCON_READ_RRC_MODE_INDEX		2
+#define AT_CSCON_RESPONSE_MAX_LEN		20
 
 /* XT3412 command parameters */
 #define AT_XT3412_SUB				"AT%%XT3412=1,%d,%d"
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr.h>
+#include <sys/slist.h>
+#include <modem/lte_lc.h>
+#include <modem/lte_lc_tx_sched.h>
+#include <logging/log.h>
+
+#include "lte_lc_tx_sched.h"
+
+LOG_MODULE_REGISTER(lte_lc_tx_sched, CONFIG_LTE_LINK_CONTROL_LOG_LEVEL);
+
+static sys_slist_t pending = SYS_SLIST_STATIC_INIT(&pending);
+static struct k_spinlock lock;
+
+static bool rrc_connected;
+/* Periodic TAU interval given by the network, in seconds, or -1 */
+static int psm_tau = -1;
+static int64_t next_start = -1;
+
+static void flush_work_fn(struct k_work *work);
+static void deadline_work_fn(struct k_work *work);
+
+static K_WORK_DEFINE(flush_work, flush_work_fn);
+static K_WORK_DELAYABLE_DEFINE(deadline_work, deadline_work_fn);
+
+static void flush_work_fn(struct k_work *work)
+{
+	sys_slist_t due;
+	sys_snode_t *node;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(work);
+
+	/* Take all pending transmissions, so that handlers can defer new ones
+	 * without being called again in this flush.
+	 */
+	key = k_spin_lock(&lock);
+	due = pending;
+	sys_slist_init(&pending);
+	k_spin_unlock(&lock, key);
+
+	(void)k_work_cancel_delayable(&deadline_work);
+
+	while ((node = sys_slist_get(&due)) != NULL) {
+		struct lte_lc_tx *tx = CONTAINER_OF(node, struct lte_lc_tx, node);
+
+		tx->handler(tx);
+	}
+}
+
+/* When one transmission can wait no longer, the others are sent in the same
+ * connection.
+ */
+static void deadline_work_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	LOG_DBG("Deferred transmission deadline expired");
+
+	flush_work_fn(NULL);
+}
+
+/* Must be called with the lock held. */
+static void deadline_schedule(void)
+{
+	struct lte_lc_tx *tx;
+	int64_t earliest = INT64_MAX;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&pending, tx, node) {
+		earliest = MIN(earliest, tx->deadline);
+	}
+
+	if (earliest == INT64_MAX) {
+		return;
+	}
+
+	(void)k_work_reschedule(&deadline_work,
+				K_MSEC(MAX(earliest - k_uptime_get(), 0)));
+}
+
+void tx_sched_rrc_update(enum lte_lc_rrc_mode mode)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	bool flush;
+
+	rrc_connected = (mode == LTE_LC_RRC_MODE_CONNECTED);
+	flush = rrc_connected && !sys_slist_is_empty(&pending);
+
+	/* T3412 is started when RRC is released. */
+	if (!rrc_connected) {
+		next_start = (psm_tau > 0) ?
+			     k_uptime_get() + (int64_t)psm_tau * MSEC_PER_SEC : -1;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (flush) {
+		LOG_DBG("RRC connected, sending deferred transmissions");
+		k_work_submit(&flush_work);
+	}
+}
+
+void tx_sched_psm_update(const struct lte_lc_psm_cfg *psm_cfg)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	psm_tau = psm_cfg->tau;
+
+	if (psm_tau <= 0) {
+		next_start = -1;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+void tx_sched_tau_update(uint64_t time_ms)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	next_start = k_uptime_get() + (int64_t)time_ms;
+
+	k_spin_unlock(&lock, key);
+}
+
+void tx_sched_tau_pre_warning(void)
+{
+	LOG_DBG("TAU pre-warning, sending deferred transmissions");
+
+	k_work_submit(&flush_work);
+}
+
+int lte_lc_tx_defer(struct lte_lc_tx *tx, uint32_t max_delay_ms)
+{
+	k_spinlock_key_t key;
+	struct lte_lc_tx *item;
+	bool connected;
+
+	if ((tx == NULL) || (tx->handler == NULL)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&pending, item, node) {
+		if (item == tx) {
+			k_spin_unlock(&lock, key);
+			return -EALREADY;
+		}
+	}
+
+	tx->deadline = k_uptime_get() + max_delay_ms;
+	sys_slist_append(&pending, &tx->node);
+	connected = rrc_connected;
+
+	if (!connected) {
+		deadline_schedule();
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (connected) {
+		k_work_submit(&flush_work);
+	}
+
+	return 0;
+}
+
+int lte_lc_tx_cancel(struct lte_lc_tx *tx)
+{
+	k_spinlock_key_t key;
+	bool removed;
+
+	if (tx == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	removed = sys_slist_find_and_remove(&pending, &tx->node);
+	if (removed) {
+		if (sys_slist_is_empty(&pending)) {
+			(void)k_work_cancel_delayable(&deadline_work);
+		} else {
+			deadline_schedule();
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return removed ? 0 : -EINVAL;
+}
+
+int lte_lc_active_window_get(struct lte_lc_active_window *window)
+{
+	k_spinlock_key_t key;
+
+	if (window == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	window->rrc_connected = rrc_connected;
+	window->next_start = next_start;
+
+	/* The prediction is stale if the TAU did not happen, for example
+	 * because the network released the PSM configuration.
+	 */
+	if ((window->next_start >= 0) && (window->next_start < k_uptime_get())) {
+		window->next_start = -1;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef LTE_LC_TX_SCHED_H__
+#define LTE_LC_TX_SCHED_H__
+
+#include <zephyr/types.h>
+#include <modem/lte_lc.h>
+
+/* Link updates from the notification handler. */
+void tx_sched_rrc_update(enum lte_lc_rrc_mode mode);
+void tx_sched_psm_update(const struct lte_lc_psm_cfg *psm_cfg);
+void tx_sched_tau_update(uint64_t time_ms);
+void tx_sched_tau_pre_warning(void);
+
+#endif /* LTE_LC_TX_SCHED_H__ */
@@ -8,7 +8,6 @@
 #include <string.h>
 #include <stdlib.h>
 #include <cJSON.h>
-#include <cJSON_os.h>
 #include <modem/modem_info.h>
 #include <modem/at_params.h>
 #include <logging/log.h>
@@ -229,66 +228,3 @@ delete_object:
 
 	return obj_count;
 }
-
-int modem_info_json_string_encode(struct modem_param_info *modem,
-				  char *buf)
-{
-	int total_len = 0;
-	int ret;
-
-	cJSON *root_obj		= cJSON_CreateObject();
-	cJSON *network_obj	= cJSON_CreateObject();
-	cJSON *sim_obj		= cJSON_CreateObject();
-	cJSON *device_obj	= cJSON_CreateObject();
-
-	if (root_obj == NULL || network_obj == NULL || buf == NULL ||
-	    sim_obj == NULL || device_obj == NULL) {
-		return -ENOMEM;
-	}
-
-	if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_NETWORK)) {
-		ret = network_data_add(&modem->network, network_obj);
-		if (ret < 0) {
-			total_len = ret;
-			goto delete_object;
-		}
-
-		total_len += ret;
-		json_add_obj(root_obj, MODEM_INFO_JSON_KEY_NET_INF, network_obj);
-	}
-
-	if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_SIM)) {
-		ret = sim_data_add(&modem->sim, sim_obj);
-		if (ret < 0) {
-			total_len = ret;
-			goto delete_object;
-		}
-
-		total_len += ret;
-		json_add_obj(root_obj, MODEM_INFO_JSON_KEY_SIM_INF, sim_obj);
-	}
-
-	if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_DEVICE)) {
-		ret = device_data_add(&modem->device, device_obj);
-		if (ret < 0) {
-			total_len = ret;
-			goto delete_object;
-		}
-
-		total_len += ret;
-		json_add_obj(root_obj, MODEM_INFO_JSON_KEY_DEV_INF, device_obj);
-	}
-
-	if (total_len > 0) {
-		char *root_obj_string = cJSON_PrintUnformatted(root_obj);
-
-		memcpy(buf, root_obj_string,
-		       MODEM_INFO_JSON_STRING_SIZE);
-		cJSON_FreeString(root_obj_string);
-	}
-
-delete_object:
-	cJSON_Delete(root_obj);
-
-	return total_len;
-}
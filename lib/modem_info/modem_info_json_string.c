@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr.h>
+#include <stdio.h>
+#include <string.h>
+#include <modem/modem_info.h>
+#include <modem/at_params.h>
+#include <logging/log.h>
+
+LOG_MODULE_REGISTER(modem_info_json_string);
+
+/* Writes JSON directly to the output buffer. Errors are sticky, so the
+ * result only needs to be checked once the whole document is written.
+ */
+struct json_out {
+	char *buf;
+	size_t size;
+	size_t len;
+	bool first;
+	int err;
+};
+
+static void put(struct json_out *out, const char *str, size_t len)
+{
+	if (out->err) {
+		return;
+	}
+
+	/* Leave room for the terminator. */
+	if (out->len + len >= out->size) {
+		out->err = -EMSGSIZE;
+		return;
+	}
+
+	memcpy(&out->buf[out->len], str, len);
+	out->len += len;
+}
+
+static void put_char(struct json_out *out, char c)
+{
+	put(out, &c, 1);
+}
+
+static void put_string(struct json_out *out, const char *str)
+{
+	put_char(out, '"');
+
+	for (; *str; str++) {
+		unsigned char c = *str;
+
+		if (c == '"' || c == '\\') {
+			put_char(out, '\\');
+			put_char(out, c);
+		} else if (c < 0x20) {
+			char esc[7];
+
+			snprintf(esc, sizeof(esc), "\\u%04x", c);
+			put(out, esc, 6);
+		} else {
+			put_char(out, c);
+		}
+	}
+
+	put_char(out, '"');
+}
+
+static void put_key(struct json_out *out, const char *key)
+{
+	if (!out->first) {
+		put_char(out, ',');
+	}
+
+	out->first = false;
+
+	put_string(out, key);
+	put_char(out, ':');
+}
+
+static void obj_start(struct json_out *out, const char *key)
+{
+	if (key) {
+		put_key(out, key);
+	}
+
+	put_char(out, '{');
+	out->first = true;
+}
+
+static void obj_end(struct json_out *out)
+{
+	put_char(out, '}');
+	out->first = false;
+}
+
+static void put_num(struct json_out *out, const char *key, uint32_t val)
+{
+	char tmp[11];
+	int len = snprintf(tmp, sizeof(tmp), "%u", val);
+
+	put_key(out, key);
+	put(out, tmp, len);
+}
+
+static void put_str(struct json_out *out, const char *key, const char *val)
+{
+	put_key(out, key);
+	put_string(out, val);
+}
+
+/* Same representation as the cJSON encoder: strings as strings, except for
+ * the area code, which is reported as a number.
+ */
+static void put_data(struct json_out *out, const struct lte_param *param)
+{
+	char data_name[MODEM_INFO_MAX_RESPONSE_SIZE];
+	int len;
+
+	len = modem_info_name_get(param->type, data_name);
+	if (len < 0) {
+		out->err = out->err ? out->err : -EINVAL;
+		return;
+	}
+
+	data_name[len] = '\0';
+
+	if (modem_info_type_get(param->type) == AT_PARAM_TYPE_STRING &&
+	    param->type != MODEM_INFO_AREA_CODE) {
+		put_str(out, data_name, param->value_string);
+	} else {
+		put_num(out, data_name, param->value);
+	}
+}
+
+static void network_data_put(struct json_out *out, struct network_param *network)
+{
+	char data_name[MODEM_INFO_MAX_RESPONSE_SIZE];
+	int len;
+
+	obj_start(out, MODEM_INFO_JSON_KEY_NET_INF);
+
+	put_data(out, &network->current_band);
+	put_data(out, &network->sup_band);
+	put_data(out, &network->area_code);
+	put_data(out, &network->current_operator);
+	put_data(out, &network->ip_address);
+	put_data(out, &network->ue_mode);
+
+	len = modem_info_name_get(network->cellid_hex.type, data_name);
+	data_name[len] = '\0';
+	put_num(out, data_name, (uint32_t)network->cellid_dec);
+
+	network->network_mode[0] = '\0';
+
+	if (network->lte_mode.value == 1) {
+		strcat(network->network_mode, "LTE-M");
+	} else if (network->nbiot_mode.value == 1) {
+		strcat(network->network_mode, "NB-IoT");
+	}
+
+	if (network->gps_mode.value == 1) {
+		strcat(network->network_mode, " GPS");
+	}
+
+	put_str(out, "networkMode", network->network_mode);
+
+	obj_end(out);
+}
+
+static void sim_data_put(struct json_out *out, const struct sim_param *sim)
+{
+	obj_start(out, MODEM_INFO_JSON_KEY_SIM_INF);
+
+	put_data(out, &sim->uicc);
+	put_data(out, &sim->iccid);
+	put_data(out, &sim->imsi);
+
+	obj_end(out);
+}
+
+static void device_data_put(struct json_out *out, const struct device_param *device)
+{
+	obj_start(out, MODEM_INFO_JSON_KEY_DEV_INF);
+
+	put_data(out, &device->modem_fw);
+	put_data(out, &device->battery);
+	put_data(out, &device->imei);
+	put_str(out, "board", device->board);
+	put_str(out, "appVersion", device->app_version);
+	put_str(out, "appName", device->app_name);
+
+	obj_end(out);
+}
+
+int modem_info_json_string_encode(struct modem_param_info *modem,
+				  char *buf)
+{
+	struct json_out out = {
+		.buf = buf,
+		.size = MODEM_INFO_JSON_STRING_SIZE,
+	};
+
+	if (modem == NULL || buf == NULL) {
+		return -EINVAL;
+	}
+
+	obj_start(&out, NULL);
+
+	if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_NETWORK)) {
+		network_data_put(&out, &modem->network);
+	}
+
+	if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_SIM)) {
+		sim_data_put(&out, &modem->sim);
+	}
+
+	if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_DEVICE)) {
+		device_data_put(&out, &modem->device);
+	}
+
+	obj_end(&out);
+
+	if (out.err) {
+		LOG_ERR("Failed to encode modem information: %d", out.err);
+		buf[0] = '\0';
+		return out.err;
+	}
+
+	buf[out.len] = '\0';
+
+	return out.len;
+}
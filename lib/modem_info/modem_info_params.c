@@ -8,17 +8,62 @@
 #include <string.h>
 #include <stdlib.h>
 #include <modem/modem_info.h>
+#include <modem/at_cmd.h>
+#include <modem/at_cmd_parser.h>
 #include <modem/at_params.h>
 #include <logging/log.h>
 
 LOG_MODULE_REGISTER(modem_info_params);
 
+#define AT_CMD_XMONITOR		"AT%XMONITOR"
+#define AT_CMD_SYSTEMMODE	"AT%XSYSTEMMODE?"
+
+/* %XMONITOR: <reg_status>,<full_name>,<short_name>,<plmn>,<tac>,<AcT>,
+ *	      <band>,<cell_id>,...
+ * Only the parameters up to the cell ID are parsed.
+ */
+#define XMONITOR_RESP_MAX_SIZE	256
+#define XMONITOR_PARAM_COUNT	9
+#define XMONITOR_PLMN_INDEX	4
+#define XMONITOR_TAC_INDEX	5
+#define XMONITOR_BAND_INDEX	7
+#define XMONITOR_CELL_ID_INDEX	8
+
+/* %XSYSTEMMODE: <LTE_M_support>,<NB_IoT_support>,<GNSS_support>,
+ *		 <LTE_preference>
+ */
+#define SYSTEMMODE_PARAM_COUNT	5
+#define SYSTEMMODE_LTE_INDEX	1
+#define SYSTEMMODE_NBIOT_INDEX	2
+#define SYSTEMMODE_GPS_INDEX	3
+
+static struct at_param_list snapshot_params;
+
+/* Parameters that do not change while the device is running are read only
+ * once.
+ */
+static struct {
+	bool valid;
+	char modem_fw[MODEM_INFO_MAX_RESPONSE_SIZE];
+	char imei[MODEM_INFO_MAX_RESPONSE_SIZE];
+	char sup_band[MODEM_INFO_MAX_RESPONSE_SIZE];
+} static_params;
+
 int modem_info_params_init(struct modem_param_info *modem)
 {
 	if (modem == NULL) {
 		return -EINVAL;
 	}
 
+	if (snapshot_params.params == NULL) {
+		int err = at_params_list_init(&snapshot_params,
+					      XMONITOR_PARAM_COUNT);
+
+		if (err) {
+			return err;
+		}
+	}
+
 	modem->network.current_band.type	= MODEM_INFO_CUR_BAND;
 	modem->network.sup_band.type		= MODEM_INFO_SUP_BAND;
 	modem->network.area_code.type		= MODEM_INFO_AREA_CODE;
@@ -128,6 +173,118 @@ static int modem_data_get(struct lte_param *param)
 	return 0;
 }
 
+static int string_param_get(size_t index, struct lte_param *param)
+{
+	size_t len = sizeof(param->value_string) - 1;
+	int err;
+
+	err = at_params_string_get(&snapshot_params, index,
+				   param->value_string, &len);
+	if (err) {
+		return err;
+	}
+
+	param->value_string[len] = '\0';
+
+	return 0;
+}
+
+/* Read the operator, tracking area code, band and cell ID with a single
+ * %XMONITOR command, instead of one command each.
+ */
+static int network_monitor_get(struct network_param *network)
+{
+	static char buf[XMONITOR_RESP_MAX_SIZE];
+	int err;
+
+	err = at_cmd_write(AT_CMD_XMONITOR, buf, sizeof(buf), NULL);
+	if (err) {
+		LOG_ERR("%%XMONITOR failed: %d", err);
+		return -EIO;
+	}
+
+	err = at_parser_max_params_from_str(buf, NULL, &snapshot_params,
+					    XMONITOR_PARAM_COUNT);
+	if (err && err != -EAGAIN) {
+		return err;
+	}
+
+	/* Only the registration status is reported when not registered. */
+	if (at_params_valid_count_get(&snapshot_params) < XMONITOR_PARAM_COUNT) {
+		LOG_DBG("Not registered to a network");
+		return -EAGAIN;
+	}
+
+	err = string_param_get(XMONITOR_PLMN_INDEX, &network->current_operator);
+	err += string_param_get(XMONITOR_TAC_INDEX, &network->area_code);
+	err += string_param_get(XMONITOR_CELL_ID_INDEX, &network->cellid_hex);
+	err += at_params_unsigned_short_get(&snapshot_params, XMONITOR_BAND_INDEX,
+					    &network->current_band.value);
+
+	return err;
+}
+
+/* Read the LTE-M, NB-IoT and GPS support modes with a single command. */
+static int system_mode_get(struct network_param *network)
+{
+	char buf[CONFIG_MODEM_INFO_BUFFER_SIZE];
+	int err;
+
+	err = at_cmd_write(AT_CMD_SYSTEMMODE, buf, sizeof(buf), NULL);
+	if (err) {
+		LOG_ERR("%%XSYSTEMMODE failed: %d", err);
+		return -EIO;
+	}
+
+	err = at_parser_max_params_from_str(buf, NULL, &snapshot_params,
+					    SYSTEMMODE_PARAM_COUNT);
+	if (err && err != -EAGAIN) {
+		return err;
+	}
+
+	err = at_params_unsigned_short_get(&snapshot_params, SYSTEMMODE_LTE_INDEX,
+					   &network->lte_mode.value);
+	err += at_params_unsigned_short_get(&snapshot_params, SYSTEMMODE_NBIOT_INDEX,
+					    &network->nbiot_mode.value);
+	err += at_params_unsigned_short_get(&snapshot_params, SYSTEMMODE_GPS_INDEX,
+					    &network->gps_mode.value);
+
+	return err;
+}
+
+static int static_params_get(struct modem_param_info *modem)
+{
+	int ret;
+
+	if (!static_params.valid) {
+		ret = modem_info_string_get(MODEM_INFO_FW_VERSION, static_params.modem_fw,
+					    sizeof(static_params.modem_fw));
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = modem_info_string_get(MODEM_INFO_IMEI, static_params.imei,
+					    sizeof(static_params.imei));
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = modem_info_string_get(MODEM_INFO_SUP_BAND, static_params.sup_band,
+					    sizeof(static_params.sup_band));
+		if (ret < 0) {
+			return ret;
+		}
+
+		static_params.valid = true;
+	}
+
+	strcpy(modem->device.modem_fw.value_string, static_params.modem_fw);
+	strcpy(modem->device.imei.value_string, static_params.imei);
+	strcpy(modem->network.sup_band.value_string, static_params.sup_band);
+
+	return 0;
+}
+
 int modem_info_params_get(struct modem_param_info *modem)
 {
 	int ret;
@@ -136,17 +293,20 @@ int modem_info_params_get(struct modem_param_info *modem)
 		return -EINVAL;
 	}
 
+	if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_NETWORK) ||
+	    IS_ENABLED(CONFIG_MODEM_INFO_ADD_DEVICE)) {
+		ret = static_params_get(modem);
+		if (ret) {
+			LOG_ERR("Static data not obtained: %d", ret);
+			return -EAGAIN;
+		}
+	}
+
 	if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_NETWORK)) {
-		ret = modem_data_get(&modem->network.current_band);
-		ret += modem_data_get(&modem->network.sup_band);
+		ret = network_monitor_get(&modem->network);
+		ret += system_mode_get(&modem->network);
 		ret += modem_data_get(&modem->network.ip_address);
 		ret += modem_data_get(&modem->network.ue_mode);
-		ret += modem_data_get(&modem->network.current_operator);
-		ret += modem_data_get(&modem->network.cellid_hex);
-		ret += modem_data_get(&modem->network.area_code);
-		ret += modem_data_get(&modem->network.lte_mode);
-		ret += modem_data_get(&modem->network.nbiot_mode);
-		ret += modem_data_get(&modem->network.gps_mode);
 		ret += modem_data_get(&modem->network.apn);
 
 		if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_DATE_TIME)) {
@@ -180,9 +340,7 @@ int modem_info_params_get(struct modem_param_info *modem)
 	}
 
 	if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_DEVICE)) {
-		ret = modem_data_get(&modem->device.modem_fw);
-		ret += modem_data_get(&modem->device.battery);
-		ret += modem_data_get(&modem->device.imei);
+		ret = modem_data_get(&modem->device.battery);
 		if (ret) {
 			LOG_ERR("Device data not obtained: %d", ret);
 			return -EAGAIN;
@@ -13,6 +13,10 @@
 #include <nrf_modem_limits.h>
 #include <modem/modem_key_mgmt.h>
 #include <logging/log.h>
+#if defined(CONFIG_MODEM_KEY_MGMT_DIGEST)
+#include <settings/settings.h>
+#include <mbedtls/sha256.h>
+#endif
 
 #define MODEM_KEY_MGMT_OP_LS "AT%CMNG=1"
 #define MODEM_KEY_MGMT_OP_RD "AT%CMNG=2"
@@ -26,6 +30,40 @@ LOG_MODULE_REGISTER(modem_key_mgmt, CONFIG_MODEM_KEY_MGMT_LOG_LEVEL);
 
 static char scratch_buf[4096];
 
+#define SHA256_LEN 32
+
+#if defined(CONFIG_MODEM_KEY_MGMT_CACHE)
+/* Credential listed by AT%CMNG=1. */
+struct cred_entry {
+	nrf_sec_tag_t sec_tag;
+	uint8_t cred_type;
+	/* Hash reported by the modem, if any. */
+	bool has_hash;
+	uint8_t hash[SHA256_LEN];
+};
+
+static struct {
+	struct cred_entry entries[CONFIG_MODEM_KEY_MGMT_CACHE_SIZE];
+	size_t count;
+	/* Cache has been populated. */
+	bool valid;
+	/* All credentials in the modem fit in the cache. */
+	bool complete;
+} cache;
+#endif
+
+#if defined(CONFIG_MODEM_KEY_MGMT_DIGEST)
+#define DIGEST_SETTINGS_KEY "mkm"
+
+/* Stored in settings for each credential written by this library. */
+struct cred_digest {
+	/* Hash reported by the modem after the credential was written. */
+	uint8_t modem_hash[SHA256_LEN];
+	/* SHA-256 of the written credential. */
+	uint8_t digest[SHA256_LEN];
+};
+#endif
+
 static int cmee_is_active(void)
 {
 	int err;
@@ -128,6 +166,307 @@ static int key_fetch(nrf_sec_tag_t tag,
 	return 0;
 }
 
+static int hex2bin_hash(const char *hex, uint8_t *hash)
+{
+	for (size_t i = 0; i < SHA256_LEN; i++) {
+		unsigned int byte;
+
+		if (sscanf(&hex[2 * i], "%2x", &byte) != 1) {
+			return -EINVAL;
+		}
+		hash[i] = byte;
+	}
+
+	return 0;
+}
+
+/* Parse a single line of AT%CMNG=1 response. Returns pointer to the next
+ * line or NULL if there are no more credentials listed.
+ */
+static const char *cmng_list_parse(const char *line, nrf_sec_tag_t *sec_tag,
+				   uint8_t *cred_type, bool *has_hash,
+				   uint8_t *hash)
+{
+	char hex[2 * SHA256_LEN + 1];
+	unsigned int tag;
+	unsigned int type;
+	int fields;
+
+	line = strstr(line, "%CMNG: ");
+	if (line == NULL) {
+		return NULL;
+	}
+
+	fields = sscanf(line, "%%CMNG: %u,%u,\"%64[0-9A-Fa-f]\"",
+			&tag, &type, hex);
+	if (fields < 2) {
+		return NULL;
+	}
+
+	*sec_tag = tag;
+	*cred_type = type;
+	*has_hash = (fields == 3) && (strlen(hex) == 2 * SHA256_LEN) &&
+		    (hex2bin_hash(hex, hash) == 0);
+
+	return line + 1;
+}
+
+#if defined(CONFIG_MODEM_KEY_MGMT_CACHE)
+static struct cred_entry *cache_find(nrf_sec_tag_t sec_tag, uint8_t cred_type)
+{
+	for (size_t i = 0; i < cache.count; i++) {
+		if ((cache.entries[i].sec_tag == sec_tag) &&
+		    (cache.entries[i].cred_type == cred_type)) {
+			return &cache.entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void cache_remove(nrf_sec_tag_t sec_tag, uint8_t cred_type)
+{
+	struct cred_entry *entry = cache_find(sec_tag, cred_type);
+
+	if (entry != NULL) {
+		*entry = cache.entries[--cache.count];
+	}
+}
+
+/* Add or update an entry in the cache. */
+static void cache_put(const struct cred_entry *new_entry)
+{
+	struct cred_entry *entry = cache_find(new_entry->sec_tag,
+					      new_entry->cred_type);
+
+	if (entry == NULL) {
+		if (cache.count == ARRAY_SIZE(cache.entries)) {
+			cache.complete = false;
+			return;
+		}
+		entry = &cache.entries[cache.count++];
+	}
+
+	*entry = *new_entry;
+}
+
+/* List all credentials with a single AT%CMNG=1 command. */
+static int cache_populate(void)
+{
+	struct cred_entry entry;
+	const char *line = scratch_buf;
+	enum at_cmd_state state;
+	int err;
+
+	if (cache.valid) {
+		return 0;
+	}
+
+	LOG_DBG("Sending: %s", MODEM_KEY_MGMT_OP_LS);
+	err = write_at_cmd_with_cme_enabled(MODEM_KEY_MGMT_OP_LS, scratch_buf,
+					    sizeof(scratch_buf), &state);
+	if (err) {
+		return translate_error(err, state);
+	}
+
+	cache.count = 0;
+	cache.complete = true;
+
+	while ((line = cmng_list_parse(line, &entry.sec_tag, &entry.cred_type,
+				       &entry.has_hash, entry.hash)) != NULL) {
+		cache_put(&entry);
+	}
+
+	cache.valid = true;
+	LOG_DBG("Cached %d credentials%s", cache.count,
+		cache.complete ? "" : " (incomplete)");
+
+	return 0;
+}
+
+void modem_key_mgmt_cache_invalidate(void)
+{
+	cache.valid = false;
+}
+#endif /* CONFIG_MODEM_KEY_MGMT_CACHE */
+
+/* List a single credential. */
+static int key_list(nrf_sec_tag_t sec_tag,
+		    enum modem_key_mgmt_cred_type cred_type,
+		    bool *exists, bool *has_hash, uint8_t *hash)
+{
+	int err;
+	int written;
+	char cmd[32];
+	enum at_cmd_state state;
+	nrf_sec_tag_t tag;
+	uint8_t type;
+
+	written = snprintf(cmd, sizeof(cmd), "%s,%d,%d",
+			   MODEM_KEY_MGMT_OP_LS, sec_tag, cred_type);
+
+	if (written < 0 || written >= sizeof(cmd)) {
+		return -ENOBUFS;
+	}
+
+	err = write_at_cmd_with_cme_enabled(cmd, scratch_buf,
+					    sizeof(scratch_buf), &state);
+	if (err) {
+		return translate_error(err, state);
+	}
+
+	*exists = (strlen(scratch_buf) > 0);
+	*has_hash = false;
+
+	if (*exists) {
+		(void)cmng_list_parse(scratch_buf, &tag, &type, has_hash, hash);
+	}
+
+	return 0;
+}
+
+#if defined(CONFIG_MODEM_KEY_MGMT_DIGEST)
+static int digest_settings_init(void)
+{
+	static bool initialized;
+	int err;
+
+	if (initialized) {
+		return 0;
+	}
+
+	err = settings_subsys_init();
+	if (err) {
+		LOG_ERR("Failed to initialize settings, err %d", err);
+		return err;
+	}
+
+	initialized = true;
+
+	return 0;
+}
+
+static void digest_key_get(char *key, size_t key_len, nrf_sec_tag_t sec_tag,
+			   enum modem_key_mgmt_cred_type cred_type)
+{
+	snprintf(key, key_len, "%s/%u_%u", DIGEST_SETTINGS_KEY,
+		 (unsigned int)sec_tag, (unsigned int)cred_type);
+}
+
+static int digest_load_cb(const char *key, size_t len,
+			  settings_read_cb read_cb, void *cb_arg, void *param)
+{
+	struct cred_digest *record = param;
+
+	if (len != sizeof(*record)) {
+		return -EINVAL;
+	}
+
+	if (read_cb(cb_arg, record, sizeof(*record)) != sizeof(*record)) {
+		return -EIO;
+	}
+
+	/* Mark that the record has been found. */
+	return 1;
+}
+
+static bool digest_load(nrf_sec_tag_t sec_tag,
+			enum modem_key_mgmt_cred_type cred_type,
+			struct cred_digest *record)
+{
+	char key[sizeof(DIGEST_SETTINGS_KEY "/4294967295_255")];
+
+	if (digest_settings_init()) {
+		return false;
+	}
+
+	digest_key_get(key, sizeof(key), sec_tag, cred_type);
+
+	return settings_load_subtree_direct(key, digest_load_cb, record) == 1;
+}
+
+static void digest_store(nrf_sec_tag_t sec_tag,
+			 enum modem_key_mgmt_cred_type cred_type,
+			 const struct cred_digest *record)
+{
+	char key[sizeof(DIGEST_SETTINGS_KEY "/4294967295_255")];
+	int err;
+
+	if (digest_settings_init()) {
+		return;
+	}
+
+	digest_key_get(key, sizeof(key), sec_tag, cred_type);
+
+	if (record != NULL) {
+		err = settings_save_one(key, record, sizeof(*record));
+	} else {
+		err = settings_delete(key);
+	}
+
+	if (err) {
+		LOG_WRN("Failed to update credential digest, err %d", err);
+	}
+}
+
+static int digest_compute(const void *buf, size_t len, uint8_t *digest)
+{
+	return mbedtls_sha256_ret(buf, len, digest, false);
+}
+#endif /* CONFIG_MODEM_KEY_MGMT_DIGEST */
+
+/* Update cache and stored digest after a credential has been written. */
+static void key_written(nrf_sec_tag_t sec_tag,
+			enum modem_key_mgmt_cred_type cred_type,
+			const void *buf, size_t len)
+{
+	if (!IS_ENABLED(CONFIG_MODEM_KEY_MGMT_CACHE) &&
+	    !IS_ENABLED(CONFIG_MODEM_KEY_MGMT_DIGEST)) {
+		return;
+	}
+
+	bool exists;
+	bool has_hash;
+	uint8_t hash[SHA256_LEN];
+	int err;
+
+	/* Modem hash of the new credential is needed for both the cache
+	 * and the stored digest.
+	 */
+	err = key_list(sec_tag, cred_type, &exists, &has_hash, hash);
+	if (err || !exists) {
+#if defined(CONFIG_MODEM_KEY_MGMT_CACHE)
+		cache.valid = false;
+#endif
+		return;
+	}
+
+#if defined(CONFIG_MODEM_KEY_MGMT_CACHE)
+	if (cache.valid) {
+		struct cred_entry entry = {
+			.sec_tag = sec_tag,
+			.cred_type = cred_type,
+			.has_hash = has_hash,
+		};
+
+		memcpy(entry.hash, hash, sizeof(entry.hash));
+		cache_put(&entry);
+	}
+#endif
+
+#if defined(CONFIG_MODEM_KEY_MGMT_DIGEST)
+	struct cred_digest record;
+
+	if (!has_hash || digest_compute(buf, len, record.digest)) {
+		digest_store(sec_tag, cred_type, NULL);
+		return;
+	}
+
+	memcpy(record.modem_hash, hash, sizeof(record.modem_hash));
+	digest_store(sec_tag, cred_type, &record);
+#endif
+}
+
 int modem_key_mgmt_write(nrf_sec_tag_t sec_tag,
 			 enum modem_key_mgmt_cred_type cred_type,
 			 const void *buf, size_t len)
@@ -149,8 +488,12 @@ int modem_key_mgmt_write(nrf_sec_tag_t sec_tag,
 	}
 
 	err = write_at_cmd_with_cme_enabled(scratch_buf, NULL, 0, &state);
+	err = translate_error(err, state);
+	if (err == 0) {
+		key_written(sec_tag, cred_type, buf, len);
+	}
 
-	return translate_error(err, state);
+	return err;
 }
 
 int modem_key_mgmt_read(nrf_sec_tag_t sec_tag,
@@ -191,6 +534,52 @@ int modem_key_mgmt_cmp(nrf_sec_tag_t sec_tag,
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_MODEM_KEY_MGMT_DIGEST)
+	struct cred_digest record;
+	bool exists;
+	bool has_hash;
+	uint8_t hash[SHA256_LEN];
+	uint8_t digest[SHA256_LEN];
+
+	/* If the modem still reports the hash recorded when the credential
+	 * was written, compare digests instead of reading the credential.
+	 */
+	if (digest_load(sec_tag, cred_type, &record)) {
+#if defined(CONFIG_MODEM_KEY_MGMT_CACHE)
+		const struct cred_entry *entry;
+
+		err = cache_populate();
+		entry = (err == 0) ? cache_find(sec_tag, cred_type) : NULL;
+		if (entry != NULL) {
+			exists = true;
+			has_hash = entry->has_hash;
+			memcpy(hash, entry->hash, sizeof(hash));
+		} else if ((err == 0) && cache.complete) {
+			return -ENOENT;
+		} else {
+			err = key_list(sec_tag, cred_type, &exists, &has_hash,
+				       hash);
+		}
+#else
+		err = key_list(sec_tag, cred_type, &exists, &has_hash, hash);
+#endif
+		if (err == 0 && !exists) {
+			return -ENOENT;
+		}
+
+		if ((err == 0) && has_hash &&
+		    !memcmp(hash, record.modem_hash, sizeof(hash)) &&
+		    !digest_compute(buf, len, digest)) {
+			if (memcmp(digest, record.digest, sizeof(digest))) {
+				LOG_DBG("Credential digest mismatch");
+				return 1;
+			}
+
+			return 0;
+		}
+	}
+#endif /* CONFIG_MODEM_KEY_MGMT_DIGEST */
+
 	err = key_fetch(sec_tag, cred_type);
 	if (err) {
 		return err;
@@ -235,8 +624,20 @@ int modem_key_mgmt_delete(nrf_sec_tag_t sec_tag,
 	}
 
 	err = write_at_cmd_with_cme_enabled(scratch_buf, NULL, 0, &state);
+	err = translate_error(err, state);
 
-	return translate_error(err, state);
+#if defined(CONFIG_MODEM_KEY_MGMT_CACHE)
+	if (err == 0 || err == -ENOENT) {
+		cache_remove(sec_tag, cred_type);
+	}
+#endif
+#if defined(CONFIG_MODEM_KEY_MGMT_DIGEST)
+	if (err == 0 || err == -ENOENT) {
+		digest_store(sec_tag, cred_type, NULL);
+	}
+#endif
+
+	return err;
 }
 
 int modem_key_mgmt_permission_set(nrf_sec_tag_t sec_tag,
@@ -251,32 +652,36 @@ int modem_key_mgmt_exists(nrf_sec_tag_t sec_tag,
 			  bool *exists, uint8_t *perm_flags)
 {
 	int err;
-	int written;
-	char cmd[32];
-	enum at_cmd_state state;
+	bool has_hash;
+	uint8_t hash[SHA256_LEN];
 
 	if (exists == NULL || perm_flags == NULL) {
 		return -EINVAL;
 	}
 
-	written = snprintf(cmd, sizeof(cmd), "%s,%d,%d",
-			   MODEM_KEY_MGMT_OP_LS, sec_tag, cred_type);
+#if defined(CONFIG_MODEM_KEY_MGMT_CACHE)
+	err = cache_populate();
+	if (err == 0) {
+		if (cache_find(sec_tag, cred_type) != NULL) {
+			*exists = true;
+			*perm_flags = 0;
+			return 0;
+		}
 
-	if (written < 0 || written >= sizeof(cmd)) {
-		return -ENOBUFS;
+		if (cache.complete) {
+			*exists = false;
+			return 0;
+		}
 	}
+#endif
 
-	err = write_at_cmd_with_cme_enabled(cmd, scratch_buf,
-					    sizeof(scratch_buf), &state);
+	err = key_list(sec_tag, cred_type, exists, &has_hash, hash);
 	if (err) {
-		return translate_error(err, state);
+		return err;
 	}
 
-	if (strlen(scratch_buf) > 0) {
-		*exists = true;
+	if (*exists) {
 		*perm_flags = 0;
-	} else {
-		*exists = false;
 	}
 
 	return 0;
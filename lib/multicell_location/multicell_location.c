@@ -28,6 +28,133 @@ BUILD_ASSERT(!IS_ENABLED(CONFIG_MULTICELL_LOCATION_SERVICE_NONE),
 static char http_request[CONFIG_MULTICELL_LOCATION_SEND_BUF_SIZE];
 static char recv_buf[CONFIG_MULTICELL_LOCATION_RECV_BUF_SIZE];
 
+/* Serializes requests, which share the buffers above. A caller that waits
+ * for a request for the same cells to complete gets the result from the
+ * cache instead of sending the request again.
+ */
+static K_MUTEX_DEFINE(request_lock);
+
+#if defined(CONFIG_MULTICELL_LOCATION_CACHE)
+struct cache_key {
+	int mcc;
+	int mnc;
+	uint32_t id;
+	uint32_t tac;
+	uint8_t ncells_count;
+	/* Sum of the hashes of the neighbor cells, which does not depend on
+	 * the order in which they are listed.
+	 */
+	uint32_t ncells_hash;
+};
+
+static struct cache_entry {
+	struct cache_key key;
+	struct multicell_location location;
+	int64_t resolved_at;
+	int64_t used_at;
+	bool valid;
+} cache[CONFIG_MULTICELL_LOCATION_CACHE_SIZE];
+
+static uint32_t ncell_hash(const struct lte_lc_ncell *ncell)
+{
+	/* Murmur3 finalizer, to spread the bits before summing. */
+	uint32_t h = (ncell->earfcn << 9) ^ ncell->phys_cell_id;
+
+	h ^= h >> 16;
+	h *= 0x85ebca6b;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35;
+	h ^= h >> 16;
+
+	return h;
+}
+
+static void cache_key_get(const struct lte_lc_cells_info *cell_data,
+			  struct cache_key *key)
+{
+	/* Only the neighbors that are included in the request are used. */
+	size_t count = MIN(cell_data->ncells_count,
+			   CONFIG_MULTICELL_LOCATION_MAX_NEIGHBORS);
+
+	memset(key, 0, sizeof(*key));
+	key->mcc = cell_data->current_cell.mcc;
+	key->mnc = cell_data->current_cell.mnc;
+	key->id = cell_data->current_cell.id;
+	key->tac = cell_data->current_cell.tac;
+	key->ncells_count = count;
+
+	for (size_t i = 0; i < count; i++) {
+		key->ncells_hash += ncell_hash(&cell_data->neighbor_cells[i]);
+	}
+}
+
+static bool cache_key_equal(const struct cache_key *a, const struct cache_key *b)
+{
+	return (a->mcc == b->mcc) && (a->mnc == b->mnc) && (a->id == b->id) &&
+	       (a->tac == b->tac) && (a->ncells_count == b->ncells_count) &&
+	       (a->ncells_hash == b->ncells_hash);
+}
+
+static bool cache_entry_expired(const struct cache_entry *entry, int64_t now)
+{
+	return (now - entry->resolved_at) >=
+	       (int64_t)CONFIG_MULTICELL_LOCATION_CACHE_TTL * MSEC_PER_SEC;
+}
+
+static bool cache_lookup(const struct cache_key *key,
+			 struct multicell_location *location)
+{
+	int64_t now = k_uptime_get();
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache); i++) {
+		struct cache_entry *entry = &cache[i];
+
+		if (!entry->valid || !cache_key_equal(&entry->key, key)) {
+			continue;
+		}
+
+		if (cache_entry_expired(entry, now)) {
+			entry->valid = false;
+			return false;
+		}
+
+		entry->used_at = now;
+		*location = entry->location;
+
+		return true;
+	}
+
+	return false;
+}
+
+static void cache_store(const struct cache_key *key,
+			const struct multicell_location *location)
+{
+	int64_t now = k_uptime_get();
+	struct cache_entry *victim = &cache[0];
+
+	/* Use a free or expired entry, or else the least recently used one. */
+	for (size_t i = 0; i < ARRAY_SIZE(cache); i++) {
+		struct cache_entry *entry = &cache[i];
+
+		if (!entry->valid || cache_entry_expired(entry, now)) {
+			victim = entry;
+			break;
+		}
+
+		if (entry->used_at < victim->used_at) {
+			victim = entry;
+		}
+	}
+
+	victim->key = *key;
+	victim->location = *location;
+	victim->resolved_at = now;
+	victim->used_at = now;
+	victim->valid = true;
+}
+#endif /* defined(CONFIG_MULTICELL_LOCATION_CACHE) */
+
 static int tls_setup(int fd)
 {
 	int err;
@@ -206,11 +333,51 @@ clean_up:
 	return err;
 }
 
+static int location_request(const struct lte_lc_cells_info *cell_data,
+			    const char * const device_id,
+			    struct multicell_location *location)
+{
+	int err;
+
+	if (IS_ENABLED(CONFIG_MULTICELL_LOCATION_SERVICE_NRF_CLOUD)) {
+		return location_service_get_cell_location(cell_data, device_id, recv_buf,
+							  sizeof(recv_buf), location);
+	}
+
+	err = location_service_generate_request(cell_data, device_id,
+						http_request, sizeof(http_request));
+	if (err) {
+		LOG_ERR("Failed to generate HTTP request, error: %d", err);
+		return err;
+	}
+
+	LOG_DBG("Generated request:\n%s", log_strdup(http_request));
+
+	err = execute_http_request(http_request, strlen(http_request));
+	if (err == -ETIMEDOUT) {
+		LOG_WRN("Data reception timed out, parsing potentially incomplete data");
+	} else if (err) {
+		LOG_ERR("HTTP request failed, error: %d", err);
+		return err;
+	}
+
+	err = location_service_parse_response(recv_buf, location);
+	if (err) {
+		LOG_ERR("Failed to parse HTTP response");
+		return -ENOMSG;
+	}
+
+	return 0;
+}
+
 int multicell_location_get(const struct lte_lc_cells_info *cell_data,
 			   const char * const device_id,
 			   struct multicell_location *location)
 {
 	int err;
+#if defined(CONFIG_MULTICELL_LOCATION_CACHE)
+	struct cache_key key;
+#endif
 
 	if ((cell_data == NULL) || (location == NULL)) {
 		return -EINVAL;
@@ -227,35 +394,29 @@ int multicell_location_get(const struct lte_lc_cells_info *cell_data,
 		LOG_WRN("Increase CONFIG_MULTICELL_LOCATION_MAX_NEIGHBORS to use more cells");
 	}
 
-	if (IS_ENABLED(CONFIG_MULTICELL_LOCATION_SERVICE_NRF_CLOUD)) {
-		return location_service_get_cell_location(cell_data, device_id, recv_buf,
-							  sizeof(recv_buf), location);
-	} else {
-		err = location_service_generate_request(cell_data, device_id,
-							http_request, sizeof(http_request));
-		if (err) {
-			LOG_ERR("Failed to generate HTTP request, error: %d", err);
-			return err;
-		}
+	k_mutex_lock(&request_lock, K_FOREVER);
 
-		LOG_DBG("Generated request:\n%s", log_strdup(http_request));
+#if defined(CONFIG_MULTICELL_LOCATION_CACHE)
+	cache_key_get(cell_data, &key);
 
-		err = execute_http_request(http_request, strlen(http_request));
-		if (err == -ETIMEDOUT) {
-			LOG_WRN("Data reception timed out, parsing potentially incomplete data");
-		} else if (err) {
-			LOG_ERR("HTTP request failed, error: %d", err);
-			return err;
-		}
+	if (cache_lookup(&key, location)) {
+		LOG_DBG("Location found in cache");
+		k_mutex_unlock(&request_lock);
+		return 0;
+	}
+#endif
 
-		err = location_service_parse_response(recv_buf, location);
-		if (err) {
-			LOG_ERR("Failed to parse HTTP response");
-			return -ENOMSG;
-		}
+	err = location_request(cell_data, device_id, location);
+
+#if defined(CONFIG_MULTICELL_LOCATION_CACHE)
+	if (!err) {
+		cache_store(&key, location);
 	}
+#endif
 
-	return 0;
+	k_mutex_unlock(&request_lock);
+
+	return err;
 }
 
 int multicell_location_provision_certificate(bool overwrite)
@@ -8,12 +8,69 @@
 
 static K_MUTEX_DEFINE(mpsl_lock);
 
+#if IS_ENABLED(CONFIG_MULTITHREADING_LOCK_STATS)
+static struct multithreading_lock_stats stats;
+static atomic_t timeouts;
+
+/* Must be called with the lock held. */
+static void wait_record(uint32_t wait_us, k_tid_t holder)
+{
+	uint32_t bucket = 0;
+
+	while ((wait_us >> bucket) > 1 &&
+	       bucket < (MULTITHREADING_LOCK_STATS_BUCKETS - 1)) {
+		bucket++;
+	}
+
+	stats.contended++;
+	stats.wait_hist[bucket]++;
+
+	if (wait_us > stats.max_wait_us) {
+		stats.max_wait_us = wait_us;
+		stats.max_wait_holder = holder;
+	}
+}
+#endif
+
 int multithreading_lock_acquire(k_timeout_t timeout)
 {
+#if IS_ENABLED(CONFIG_MULTITHREADING_LOCK_STATS)
+	int err = k_mutex_lock(&mpsl_lock, K_NO_WAIT);
+
+	if (err == -EBUSY && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_tid_t holder = mpsl_lock.owner;
+		uint32_t start = k_cycle_get_32();
+
+		err = k_mutex_lock(&mpsl_lock, timeout);
+		if (err == 0) {
+			wait_record(k_cyc_to_us_floor32(k_cycle_get_32() - start),
+				    holder);
+		}
+	}
+
+	if (err == 0) {
+		stats.acquired++;
+	} else {
+		atomic_inc(&timeouts);
+	}
+
+	return err;
+#else
 	return k_mutex_lock(&mpsl_lock, timeout);
+#endif
 }
 
 void multithreading_lock_release(void)
 {
 	k_mutex_unlock(&mpsl_lock);
 }
+
+#if IS_ENABLED(CONFIG_MULTITHREADING_LOCK_STATS)
+void multithreading_lock_stats_get(struct multithreading_lock_stats *out)
+{
+	(void)k_mutex_lock(&mpsl_lock, K_FOREVER);
+	*out = stats;
+	out->timeouts = atomic_get(&timeouts);
+	k_mutex_unlock(&mpsl_lock);
+}
+#endif
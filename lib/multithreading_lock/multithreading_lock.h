@@ -54,6 +54,36 @@ int multithreading_lock_acquire(k_timeout_t timeout);
  */
 void multithreading_lock_release(void);
 
+/** Number of buckets in the wait time histogram. */
+#define MULTITHREADING_LOCK_STATS_BUCKETS 16
+
+/** @brief Lock contention statistics. */
+struct multithreading_lock_stats {
+	/** Number of times the lock was acquired. */
+	uint32_t acquired;
+	/** Number of times the lock was acquired after waiting for it. */
+	uint32_t contended;
+	/** Number of times the lock was not acquired. */
+	uint32_t timeouts;
+	/** Longest wait for the lock, in microseconds. */
+	uint32_t max_wait_us;
+	/** Thread that held the lock during the longest wait. */
+	k_tid_t max_wait_holder;
+	/** Wait times. Bucket 0 counts waits below 2 us, bucket n > 0 counts
+	 *  waits from 2^n us to below 2^(n + 1) us. The last bucket also
+	 *  counts all longer waits.
+	 */
+	uint32_t wait_hist[MULTITHREADING_LOCK_STATS_BUCKETS];
+};
+
+/** @brief Get the lock contention statistics.
+ *
+ * Available if CONFIG_MULTITHREADING_LOCK_STATS is enabled.
+ *
+ * @param[out] stats Statistics since boot.
+ */
+void multithreading_lock_stats_get(struct multithreading_lock_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
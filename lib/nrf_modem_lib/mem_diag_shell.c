@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <shell/shell.h>
+#include <modem/nrf_modem_lib.h>
+
+static void stats_print(const struct shell *shell,
+			const struct nrf_modem_lib_heap_stats *stats)
+{
+	uint32_t attempts = stats->allocs + stats->failed_allocs;
+
+	shell_print(shell, "In use:      %u/%u bytes", stats->allocated,
+		    stats->size);
+	shell_print(shell, "Max in use:  %u bytes", stats->max_allocated);
+	shell_print(shell, "Allocations: %u", stats->allocs);
+	shell_print(shell, "Failed:      %u (%u fragmented)",
+		    stats->failed_allocs, stats->failed_allocs_fragmented);
+	shell_print(shell, "Alloc time:  avg %u us, max %u us",
+		    attempts ? (uint32_t)(stats->alloc_time_total_us / attempts) : 0,
+		    stats->alloc_time_max_us);
+	shell_print(shell, "Allocation sizes:");
+
+	for (size_t i = 0; i < NRF_MODEM_LIB_HEAP_STATS_BUCKETS; i++) {
+		size_t upper = NRF_MODEM_LIB_HEAP_STATS_BUCKET_MIN << i;
+
+		if (i < NRF_MODEM_LIB_HEAP_STATS_BUCKETS - 1) {
+			shell_print(shell, "  <= %5u: %u", upper,
+				    stats->size_hist[i]);
+		} else {
+			shell_print(shell, "  >  %5u: %u", upper >> 1,
+				    stats->size_hist[i]);
+		}
+	}
+}
+
+static int cmd_heap(const struct shell *shell, size_t argc, char **argv)
+{
+	struct nrf_modem_lib_heap_stats stats;
+
+	nrf_modem_lib_heap_stats_get(&stats);
+	stats_print(shell, &stats);
+
+	return 0;
+}
+
+static int cmd_shm_tx(const struct shell *shell, size_t argc, char **argv)
+{
+	struct nrf_modem_lib_heap_stats stats;
+
+	nrf_modem_lib_shm_tx_stats_get(&stats);
+	stats_print(shell, &stats);
+
+	return 0;
+}
+
+static int cmd_reset(const struct shell *shell, size_t argc, char **argv)
+{
+	nrf_modem_lib_heap_stats_reset();
+	nrf_modem_lib_shm_tx_stats_reset();
+
+	shell_print(shell, "Statistics reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_modem_mem,
+	SHELL_CMD(heap, NULL, "Show the library heap statistics", cmd_heap),
+	SHELL_CMD(shm_tx, NULL, "Show the TX region statistics", cmd_shm_tx),
+	SHELL_CMD(reset, NULL, "Reset the statistics", cmd_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(modem_mem, &sub_modem_mem,
+		   "Modem library heap usage statistics", NULL);
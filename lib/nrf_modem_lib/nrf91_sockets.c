@@ -44,39 +44,47 @@
 static struct nrf_sock_ctx {
 	int nrf_fd; /* nRF socket descriptior. */
 	struct k_mutex *lock; /* Mutex associated with the socket. */
+	bool is_stream; /* Data is not sent as separate messages. */
+#if defined(CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_PER_SOCKET)
+	/* sendmsg() intermediate buffer, protected by the socket lock. */
+	uint8_t sendmsg_buf[CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE];
+#endif
 } offload_ctx[NRF_MODEM_MAX_SOCKET_COUNT];
 
-static K_MUTEX_DEFINE(ctx_lock);
+/* Stack of the unused contexts, so that allocating and releasing a context
+ * does not depend on the number of sockets.
+ */
+static struct nrf_sock_ctx *free_ctx[NRF_MODEM_MAX_SOCKET_COUNT];
+static size_t free_ctx_count;
+static struct k_spinlock ctx_lock;
 
 static const struct socket_op_vtable nrf91_socket_fd_op_vtable;
 
-static struct nrf_sock_ctx *allocate_ctx(int nrf_fd)
+static struct nrf_sock_ctx *allocate_ctx(int nrf_fd, bool is_stream)
 {
 	struct nrf_sock_ctx *ctx = NULL;
+	k_spinlock_key_t key = k_spin_lock(&ctx_lock);
 
-	k_mutex_lock(&ctx_lock, K_FOREVER);
-
-	for (int i = 0; i < ARRAY_SIZE(offload_ctx); i++) {
-		if (offload_ctx[i].nrf_fd == -1) {
-			ctx = &offload_ctx[i];
-			ctx->nrf_fd = nrf_fd;
-			break;
-		}
+	if (free_ctx_count > 0) {
+		ctx = free_ctx[--free_ctx_count];
+		ctx->nrf_fd = nrf_fd;
+		ctx->is_stream = is_stream;
 	}
 
-	k_mutex_unlock(&ctx_lock);
+	k_spin_unlock(&ctx_lock, key);
 
 	return ctx;
 }
 
 static void release_ctx(struct nrf_sock_ctx *ctx)
 {
-	k_mutex_lock(&ctx_lock, K_FOREVER);
+	k_spinlock_key_t key = k_spin_lock(&ctx_lock);
 
 	ctx->nrf_fd = -1;
 	ctx->lock = NULL;
+	free_ctx[free_ctx_count++] = ctx;
 
-	k_mutex_unlock(&ctx_lock);
+	k_spin_unlock(&ctx_lock, key);
 }
 
 static void z_to_nrf_ipv4(const struct sockaddr *z_in,
@@ -652,7 +660,7 @@ static int nrf91_socket_offload_accept(void *obj, struct sockaddr *addr,
 		return -1;
 	}
 
-	ctx = allocate_ctx(new_sd);
+	ctx = allocate_ctx(new_sd, true);
 	if (ctx == NULL) {
 		errno = ENOMEM;
 		goto error;
@@ -933,15 +941,144 @@ error:
 	return retval;
 }
 
+/* Send the whole buffer. Returns the number of bytes sent, which is only less
+ * than len if an error occurred after part of the data was sent, or -1.
+ */
+static ssize_t send_all(void *obj, const uint8_t *buf, size_t len, int flags,
+			const struct msghdr *msg)
+{
+	size_t offset = 0;
+	ssize_t ret;
+
+	do {
+		ret = nrf91_socket_offload_sendto(obj, buf + offset, len - offset,
+						  flags, msg->msg_name,
+						  msg->msg_namelen);
+		if (ret < 0) {
+			return (offset > 0) ? offset : -1;
+		}
+
+		offset += ret;
+	} while (offset < len);
+
+	return offset;
+}
+
+/* Datagram sockets: the message must be sent with a single call. */
+static ssize_t sendmsg_datagram(void *obj, const struct msghdr *msg, int flags,
+				uint8_t *buf, size_t buf_size)
+{
+	const struct iovec *single = NULL;
+	size_t parts = 0;
+	size_t len = 0;
+
+	for (size_t i = 0; i < msg->msg_iovlen; i++) {
+		if (msg->msg_iov[i].iov_len > 0) {
+			single = &msg->msg_iov[i];
+			len += single->iov_len;
+			parts++;
+		}
+	}
+
+	/* A message with a single part is sent without copying. */
+	if (parts <= 1) {
+		return nrf91_socket_offload_sendto(obj,
+			single ? single->iov_base : NULL, len, flags,
+			msg->msg_name, msg->msg_namelen);
+	}
+
+	if (len > buf_size) {
+		errno = EMSGSIZE;
+		return -1;
+	}
+
+	len = 0;
+
+	for (size_t i = 0; i < msg->msg_iovlen; i++) {
+		memcpy(buf + len, msg->msg_iov[i].iov_base, msg->msg_iov[i].iov_len);
+		len += msg->msg_iov[i].iov_len;
+	}
+
+	return nrf91_socket_offload_sendto(obj, buf, len, flags, msg->msg_name,
+					   msg->msg_namelen);
+}
+
+/* Stream sockets: consecutive small parts are merged in the buffer, and parts
+ * that are at least as large as the buffer are sent directly.
+ */
+static ssize_t sendmsg_stream(void *obj, const struct msghdr *msg, int flags,
+			      uint8_t *buf, size_t buf_size)
+{
+	size_t fill = 0;
+	ssize_t sent = 0;
+	ssize_t ret;
+
+	for (size_t i = 0; i < msg->msg_iovlen; i++) {
+		const uint8_t *base = msg->msg_iov[i].iov_base;
+		size_t len = msg->msg_iov[i].iov_len;
+
+		if (len == 0) {
+			continue;
+		}
+
+		if ((len < buf_size) && (fill + len <= buf_size)) {
+			memcpy(buf + fill, base, len);
+			fill += len;
+			continue;
+		}
+
+		if (fill > 0) {
+			ret = send_all(obj, buf, fill, flags, msg);
+			if (ret < (ssize_t)fill) {
+				goto out;
+			}
+
+			sent += ret;
+			fill = 0;
+		}
+
+		if (len < buf_size) {
+			memcpy(buf, base, len);
+			fill = len;
+			continue;
+		}
+
+		ret = send_all(obj, base, len, flags, msg);
+		if (ret < (ssize_t)len) {
+			goto out;
+		}
+
+		sent += ret;
+	}
+
+	if (fill == 0) {
+		return sent;
+	}
+
+	ret = send_all(obj, buf, fill, flags, msg);
+	if (ret == (ssize_t)fill) {
+		return sent + ret;
+	}
+
+out:
+	/* Report the data that was sent before the error, if any. */
+	if (ret > 0) {
+		sent += ret;
+	}
+
+	return (sent > 0) ? sent : -1;
+}
+
 static ssize_t nrf91_socket_offload_sendmsg(void *obj, const struct msghdr *msg,
 					    int flags)
 {
-	ssize_t len = 0;
+	struct nrf_sock_ctx *ctx = OBJ_TO_CTX(obj);
 	ssize_t ret;
-	ssize_t offset;
-	int i;
+	uint8_t *buf;
+#if !defined(CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_PER_SOCKET)
 	static K_MUTEX_DEFINE(sendmsg_lock);
-	static uint8_t buf[CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE];
+	static uint8_t sendmsg_buf[CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE];
+#endif
 
 	if (msg == NULL) {
 		errno = EINVAL;
@@ -955,82 +1092,111 @@ static ssize_t nrf91_socket_offload_sendmsg(void *obj, const struct msghdr *msg,
 	 * <http://pubs.opengroup.org/onlinepubs/9699919799/functions/sendmsg.html>
 	 */
 
-	/* Try to reduce number of `sendto` calls - copy data if they fit into
-	 * a single buffer
-	 */
+#if defined(CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_PER_SOCKET)
+	/* The socket lock is held by the caller. */
+	buf = ctx->sendmsg_buf;
+#else
+	k_mutex_lock(&sendmsg_lock, K_FOREVER);
+	buf = sendmsg_buf;
+#endif
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		len += msg->msg_iov[i].iov_len;
+	if (ctx->is_stream) {
+		ret = sendmsg_stream(obj, msg, flags, buf,
+				     CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE);
+	} else {
+		ret = sendmsg_datagram(obj, msg, flags, buf,
+				       CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE);
 	}
 
-	if (len <= sizeof(buf)) {
-		/* Protect `buf` access with a mutex. */
-		k_mutex_lock(&sendmsg_lock, K_FOREVER);
-		len = 0;
+#if !defined(CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_PER_SOCKET)
+	k_mutex_unlock(&sendmsg_lock);
+#endif
 
-		for (i = 0; i < msg->msg_iovlen; i++) {
-			memcpy(buf + len, msg->msg_iov[i].iov_base,
-			       msg->msg_iov[i].iov_len);
-			len += msg->msg_iov[i].iov_len;
-		}
+	return ret;
+}
 
-		offset = 0;
-		ret = 0;
-		while ((offset < len) && (ret >= 0)) {
-			ret = nrf91_socket_offload_sendto(obj,
-				(buf + offset), (len - offset), flags,
-				msg->msg_name, msg->msg_namelen);
-			if (ret > 0) {
-				offset += ret;
-			}
-		}
+/* When the native and nRF poll flags have the same values, the events are
+ * passed through as they are instead of being translated one by one.
+ */
+#if defined(NRF_POLLIN) && defined(NRF_POLLOUT) && defined(NRF_POLLERR) && \
+	defined(NRF_POLLHUP) && defined(NRF_POLLNVAL) && \
+	(POLLIN == NRF_POLLIN) && (POLLOUT == NRF_POLLOUT) && \
+	(POLLERR == NRF_POLLERR) && (POLLHUP == NRF_POLLHUP) && \
+	(POLLNVAL == NRF_POLLNVAL)
+#define POLL_EVENTS_IDENTICAL 1
+#else
+#define POLL_EVENTS_IDENTICAL 0
+#endif
+
+static inline short z_to_nrf_poll_events(short events)
+{
+	short nrf_events = 0;
 
-		k_mutex_unlock(&sendmsg_lock);
-		return ret;
+	if (POLL_EVENTS_IDENTICAL) {
+		return events & (POLLIN | POLLOUT);
 	}
 
-	/* If the data won't fit into intermediate buffer, send the buffers
-	 * separately
-	 */
+	if (events & POLLIN) {
+		nrf_events |= NRF_POLLIN;
+	}
+	if (events & POLLOUT) {
+		nrf_events |= NRF_POLLOUT;
+	}
 
-	len = 0;
+	return nrf_events;
+}
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		if (msg->msg_iov[i].iov_len == 0) {
-			continue;
-		}
+static inline short nrf_to_z_poll_revents(short nrf_revents)
+{
+	short revents = 0;
 
-		offset = 0;
-		while (offset < msg->msg_iov[i].iov_len) {
-			ret = nrf91_socket_offload_sendto(obj,
-				(((uint8_t *) msg->msg_iov[i].iov_base) + offset),
-				(msg->msg_iov[i].iov_len - offset), flags,
-				msg->msg_name, msg->msg_namelen);
-			if (ret < 0) {
-				return ret;
-			}
-			offset += ret;
-			len += ret;
-		}
+	if (POLL_EVENTS_IDENTICAL) {
+		return nrf_revents & (POLLIN | POLLOUT | POLLERR | POLLHUP |
+				      POLLNVAL);
+	}
+
+	if (nrf_revents & NRF_POLLIN) {
+		revents |= POLLIN;
+	}
+	if (nrf_revents & NRF_POLLOUT) {
+		revents |= POLLOUT;
+	}
+	if (nrf_revents & NRF_POLLERR) {
+		revents |= POLLERR;
+	}
+	if (nrf_revents & NRF_POLLNVAL) {
+		revents |= POLLNVAL;
+	}
+	if (nrf_revents & NRF_POLLHUP) {
+		revents |= POLLHUP;
 	}
 
-	return len;
+	return revents;
 }
 
 static inline int nrf91_socket_offload_poll(struct pollfd *fds, int nfds,
 					    int timeout)
 {
 	int retval = 0;
-	struct nrf_pollfd tmp[NRF_MODEM_MAX_SOCKET_COUNT] = { 0 };
+	struct nrf_pollfd tmp[NRF_MODEM_MAX_SOCKET_COUNT];
 	void *obj;
 
+	/* All the descriptors are offloaded sockets, so there cannot be more
+	 * than the modem supports.
+	 */
+	if ((nfds < 0) || (nfds > ARRAY_SIZE(tmp))) {
+		errno = EINVAL;
+		return -1;
+	}
+
 	for (int i = 0; i < nfds; i++) {
-		tmp[i].events = 0;
+		tmp[i].revents = 0;
 		fds[i].revents = 0;
 
 		if (fds[i].fd < 0) {
 			/* Per POSIX, negative fd's are just ignored */
 			tmp[i].fd = fds[i].fd;
+			tmp[i].events = 0;
 			continue;
 		} else {
 			obj = z_get_fd_obj(fds[i].fd,
@@ -1048,12 +1214,7 @@ static inline int nrf91_socket_offload_poll(struct pollfd *fds, int nfds,
 		}
 
 		/* Translate the API from native to nRF */
-		if (fds[i].events & POLLIN) {
-			tmp[i].events |= NRF_POLLIN;
-		}
-		if (fds[i].events & POLLOUT) {
-			tmp[i].events |= NRF_POLLOUT;
-		}
+		tmp[i].events = z_to_nrf_poll_events(fds[i].events);
 	}
 
 	if (retval > 0) {
@@ -1069,21 +1230,7 @@ static inline int nrf91_socket_offload_poll(struct pollfd *fds, int nfds,
 			continue;
 		}
 
-		if (tmp[i].revents & NRF_POLLIN) {
-			fds[i].revents |= POLLIN;
-		}
-		if (tmp[i].revents & NRF_POLLOUT) {
-			fds[i].revents |= POLLOUT;
-		}
-		if (tmp[i].revents & NRF_POLLERR) {
-			fds[i].revents |= POLLERR;
-		}
-		if (tmp[i].revents & NRF_POLLNVAL) {
-			fds[i].revents |= POLLNVAL;
-		}
-		if (tmp[i].revents & NRF_POLLHUP) {
-			fds[i].revents |= POLLHUP;
-		}
+		fds[i].revents = nrf_to_z_poll_revents(tmp[i].revents);
 	}
 
 	return retval;
@@ -1349,7 +1496,7 @@ static int nrf91_socket_create(int family, int type, int proto)
 		return -1;
 	}
 
-	ctx = allocate_ctx(sd);
+	ctx = allocate_ctx(sd, type == SOCK_STREAM);
 	if (ctx == NULL) {
 		errno = ENOMEM;
 		nrf_close(sd);
@@ -1374,8 +1521,11 @@ static int nrf91_nrf_modem_lib_socket_offload_init(const struct device *arg)
 
 	for (int i = 0; i < ARRAY_SIZE(offload_ctx); i++) {
 		offload_ctx[i].nrf_fd = -1;
+		free_ctx[i] = &offload_ctx[ARRAY_SIZE(offload_ctx) - 1 - i];
 	}
 
+	free_ctx_count = ARRAY_SIZE(offload_ctx);
+
 	return 0;
 }
 
@@ -9,6 +9,7 @@
 #include <init.h>
 #include <zephyr.h>
 #include <nrf_modem_os.h>
+#include <modem/nrf_modem_lib.h>
 #include <nrf_modem_platform.h>
 #include <nrf.h>
 #include <nrfx_ipc.h>
@@ -58,8 +59,21 @@ LOG_MODULE_REGISTER(nrf_modem_lib, CONFIG_NRF_MODEM_LIB_LOG_LEVEL);
 
 struct mem_diagnostic_info {
 	uint32_t failed_allocs;
+#if defined(CONFIG_NRF_MODEM_LIB_MEM_DIAG)
+	struct k_spinlock lock;
+	struct nrf_modem_lib_heap_stats stats;
+#endif
 };
 
+#if defined(CONFIG_NRF_MODEM_LIB_MEM_DIAG)
+/* Stored in front of each allocation, to know its size when it is freed.
+ * Its size keeps the alignment of the memory returned by the heap.
+ */
+struct mem_diag_hdr {
+	size_t bytes;
+} __aligned(8);
+#endif
+
 struct sleeping_thread {
 	sys_snode_t node;
 	struct k_sem sem;
@@ -527,14 +541,148 @@ static void trace_rtt_init(void)
 #endif
 }
 
+#if defined(CONFIG_NRF_MODEM_LIB_MEM_DIAG)
+static size_t size_bucket(size_t bytes)
+{
+	size_t bucket = 0;
+
+	while ((bucket < NRF_MODEM_LIB_HEAP_STATS_BUCKETS - 1) &&
+	       (bytes > (NRF_MODEM_LIB_HEAP_STATS_BUCKET_MIN << bucket))) {
+		bucket++;
+	}
+
+	return bucket;
+}
+
+static void *heap_alloc(struct k_heap *heap, struct mem_diagnostic_info *diag,
+			size_t bytes)
+{
+	struct nrf_modem_lib_heap_stats *stats = &diag->stats;
+	struct mem_diag_hdr *hdr;
+	k_spinlock_key_t key;
+	uint32_t start;
+	uint32_t time_us;
+
+	start = k_cycle_get_32();
+	hdr = k_heap_alloc(heap, sizeof(*hdr) + bytes, K_NO_WAIT);
+	time_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	key = k_spin_lock(&diag->lock);
+
+	stats->size_hist[size_bucket(bytes)]++;
+	stats->alloc_time_total_us += time_us;
+	stats->alloc_time_max_us = MAX(stats->alloc_time_max_us, time_us);
+
+	if (hdr) {
+		hdr->bytes = bytes;
+		stats->allocs++;
+		stats->allocated += sizeof(*hdr) + bytes;
+		stats->max_allocated = MAX(stats->max_allocated,
+					   stats->allocated);
+	} else {
+		diag->failed_allocs++;
+		/* There was enough free memory, but not in one block. */
+		if (sizeof(*hdr) + bytes <= stats->size - stats->allocated) {
+			stats->failed_allocs_fragmented++;
+		}
+	}
+
+	k_spin_unlock(&diag->lock, key);
+
+	return hdr ? hdr + 1 : NULL;
+}
+
+static void heap_free(struct k_heap *heap, struct mem_diagnostic_info *diag,
+		      void *mem)
+{
+	struct mem_diag_hdr *hdr;
+	k_spinlock_key_t key;
+
+	if (mem == NULL) {
+		return;
+	}
+
+	hdr = (struct mem_diag_hdr *)mem - 1;
+
+	key = k_spin_lock(&diag->lock);
+	diag->stats.allocated -= sizeof(*hdr) + hdr->bytes;
+	k_spin_unlock(&diag->lock, key);
+
+	k_heap_free(heap, hdr);
+}
+
+static void heap_stats_get(struct mem_diagnostic_info *diag,
+			   struct nrf_modem_lib_heap_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&diag->lock);
+
+	*stats = diag->stats;
+	stats->failed_allocs = diag->failed_allocs;
+
+	k_spin_unlock(&diag->lock, key);
+}
+
+/* Clears the counters, but keeps track of the memory in use. */
+static void heap_stats_reset(struct mem_diagnostic_info *diag)
+{
+	k_spinlock_key_t key = k_spin_lock(&diag->lock);
+	size_t size = diag->stats.size;
+	size_t allocated = diag->stats.allocated;
+
+	diag->failed_allocs = 0;
+	memset(&diag->stats, 0x00, sizeof(diag->stats));
+	diag->stats.size = size;
+	diag->stats.allocated = allocated;
+	diag->stats.max_allocated = allocated;
+
+	k_spin_unlock(&diag->lock, key);
+}
+
+static void heap_stats_print(struct mem_diagnostic_info *diag)
+{
+	struct nrf_modem_lib_heap_stats stats;
+	uint32_t attempts;
+
+	heap_stats_get(diag, &stats);
+	attempts = stats.allocs + stats.failed_allocs;
+
+	printk("In use: %u/%u bytes, max %u bytes\n", stats.allocated,
+	       stats.size, stats.max_allocated);
+	printk("Allocations: %u, failed %u (%u fragmented)\n", stats.allocs,
+	       stats.failed_allocs, stats.failed_allocs_fragmented);
+	printk("Allocation time: avg %u us, max %u us\n",
+	       attempts ? (uint32_t)(stats.alloc_time_total_us / attempts) : 0,
+	       stats.alloc_time_max_us);
+}
+#else
+static void *heap_alloc(struct k_heap *heap, struct mem_diagnostic_info *diag,
+			size_t bytes)
+{
+	void *addr = k_heap_alloc(heap, bytes, K_NO_WAIT);
+
+	if (!addr) {
+		diag->failed_allocs++;
+	}
+
+	return addr;
+}
+
+static void heap_free(struct k_heap *heap, struct mem_diagnostic_info *diag,
+		      void *mem)
+{
+	ARG_UNUSED(diag);
+
+	k_heap_free(heap, mem);
+}
+#endif /* CONFIG_NRF_MODEM_LIB_MEM_DIAG */
+
 void *nrf_modem_os_alloc(size_t bytes)
 {
-	void *addr = k_heap_alloc(&library_heap, bytes, K_NO_WAIT);
+	void *addr = heap_alloc(&library_heap, &heap_diag, bytes);
 #ifdef CONFIG_NRF_MODEM_LIB_DEBUG_ALLOC
 	if (addr) {
 		LOG_INF("alloc(%d) -> %p", bytes, addr);
 	} else {
-		heap_diag.failed_allocs++;
 		LOG_WRN("alloc(%d) -> %p", bytes, addr);
 	}
 #endif
@@ -543,7 +691,7 @@ void *nrf_modem_os_alloc(size_t bytes)
 
 void nrf_modem_os_free(void *mem)
 {
-	k_heap_free(&library_heap, mem);
+	heap_free(&library_heap, &heap_diag, mem);
 #ifdef CONFIG_NRF_MODEM_LIB_DEBUG_ALLOC
 	LOG_INF("free(%p)", mem);
 #endif
@@ -551,12 +699,11 @@ void nrf_modem_os_free(void *mem)
 
 void *nrf_modem_os_shm_tx_alloc(size_t bytes)
 {
-	void *addr = k_heap_alloc(&shmem_heap, bytes, K_NO_WAIT);
+	void *addr = heap_alloc(&shmem_heap, &shmem_diag, bytes);
 #ifdef CONFIG_NRF_MODEM_LIB_DEBUG_SHM_TX_ALLOC
 	if (addr) {
 		LOG_INF("shm_tx_alloc(%d) -> %p", bytes, addr);
 	} else {
-		shmem_diag.failed_allocs++;
 		LOG_WRN("shm_tx_alloc(%d) -> %p", bytes, addr);
 	}
 #endif
@@ -565,7 +712,7 @@ void *nrf_modem_os_shm_tx_alloc(size_t bytes)
 
 void nrf_modem_os_shm_tx_free(void *mem)
 {
-	k_heap_free(&shmem_heap, mem);
+	heap_free(&shmem_heap, &shmem_diag, mem);
 #ifdef CONFIG_NRF_MODEM_LIB_DEBUG_SHM_TX_ALLOC
 	LOG_INF("shm_tx_free(%p)", mem);
 #endif
@@ -576,6 +723,9 @@ void nrf_modem_lib_heap_diagnose(void)
 	printk("nrf_modem heap dump:\n");
 	sys_heap_print_info(&library_heap.heap, false);
 	printk("Failed allocations: %u\n", heap_diag.failed_allocs);
+#if defined(CONFIG_NRF_MODEM_LIB_MEM_DIAG)
+	heap_stats_print(&heap_diag);
+#endif
 }
 
 void nrf_modem_lib_shm_tx_diagnose(void)
@@ -583,8 +733,45 @@ void nrf_modem_lib_shm_tx_diagnose(void)
 	printk("nrf_modem tx dump:\n");
 	sys_heap_print_info(&shmem_heap.heap, false);
 	printk("Failed allocations: %u\n", shmem_diag.failed_allocs);
+#if defined(CONFIG_NRF_MODEM_LIB_MEM_DIAG)
+	heap_stats_print(&shmem_diag);
+#endif
 }
 
+#if defined(CONFIG_NRF_MODEM_LIB_MEM_DIAG)
+int nrf_modem_lib_heap_stats_get(struct nrf_modem_lib_heap_stats *stats)
+{
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+	heap_stats_get(&heap_diag, stats);
+
+	return 0;
+}
+
+int nrf_modem_lib_shm_tx_stats_get(struct nrf_modem_lib_heap_stats *stats)
+{
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+	heap_stats_get(&shmem_diag, stats);
+
+	return 0;
+}
+
+void nrf_modem_lib_heap_stats_reset(void)
+{
+	heap_stats_reset(&heap_diag);
+}
+
+void nrf_modem_lib_shm_tx_stats_reset(void)
+{
+	heap_stats_reset(&shmem_diag);
+}
+#endif /* CONFIG_NRF_MODEM_LIB_MEM_DIAG */
+
 #if defined(CONFIG_NRF_MODEM_LIB_SHM_TX_DUMP_PERIODIC) || \
 	defined(CONFIG_NRF_MODEM_LIB_HEAP_DUMP_PERIODIC)
 
@@ -646,6 +833,11 @@ void nrf_modem_os_init(void)
 	memset(&heap_diag, 0x00, sizeof(heap_diag));
 	memset(&shmem_diag, 0x00, sizeof(shmem_diag));
 
+#if defined(CONFIG_NRF_MODEM_LIB_MEM_DIAG)
+	heap_diag.stats.size = CONFIG_NRF_MODEM_LIB_HEAP_SIZE;
+	shmem_diag.stats.size = CONFIG_NRF_MODEM_LIB_SHMEM_TX_SIZE;
+#endif
+
 	/* Initialize TX heap */
 	k_heap_init(&shmem_heap,
 		    (void *)PM_NRF_MODEM_LIB_TX_ADDRESS,
@@ -19,6 +19,8 @@
 LOG_MODULE_REGISTER(pdn, CONFIG_PDN_LOG_LEVEL);
 
 #define CID_UNASSIGNED (-1)
+/* Highest PDP context ID supported by the modem */
+#define CID_MAX 11
 
 struct pdn {
 	pdn_event_handler_t callback;
@@ -30,6 +32,13 @@ static struct k_sem notif_sem;
 static struct pdn pdn_contexts[CONFIG_PDN_CONTEXTS_MAX];
 static pdn_event_handler_t default_callback;
 
+/* Contexts indexed by CID, so that notifications are dispatched without
+ * searching the context list. Entries are only changed with the lock held,
+ * and are read from the notification handlers without it.
+ */
+static struct pdn *pdn_by_cid[CID_MAX + 1];
+static K_MUTEX_DEFINE(pdn_lock);
+
 /* Use one monitor for all CGEV events and distinguish
  * between the different type of events later (ME, IPV6, etc).
  */
@@ -37,11 +46,21 @@ AT_MONITOR(pdn_cgev, "+CGEV", on_cgev);
 AT_MONITOR(pdn_cnec_esm, "+CNEC ESM", on_cnec_esm);
 
 static struct pdn *pdn_find(int cid)
+{
+	if (cid < 0 || cid > CID_MAX) {
+		return NULL;
+	}
+
+	return pdn_by_cid[cid];
+}
+
+/* Must be called with the lock held. */
+static struct pdn *pdn_avail_get(void)
 {
 	for (size_t i = 0; i < ARRAY_SIZE(pdn_contexts); i++) {
 		struct pdn *pdn = &pdn_contexts[i];
 
-		if (pdn->context_id == cid) {
+		if (pdn->context_id == CID_UNASSIGNED) {
 			return pdn;
 		}
 	}
@@ -49,9 +68,20 @@ static struct pdn *pdn_find(int cid)
 	return NULL;
 }
 
-static struct pdn *pdn_avail_get(void)
+static void pdn_notify(int cid, enum pdn_event event, int reason)
 {
-	return pdn_find(CID_UNASSIGNED);
+	struct pdn *pdn = pdn_find(cid);
+	pdn_event_handler_t cb;
+
+	if (!pdn) {
+		return;
+	}
+
+	/* The context may be destroyed meanwhile. */
+	cb = pdn->callback;
+	if (cb) {
+		cb((intptr_t)cid, event, reason);
+	}
 }
 
 static void on_cnec_esm(const char *notif)
@@ -59,7 +89,6 @@ static void on_cnec_esm(const char *notif)
 	int match;
 	uint32_t cid;
 	uint32_t esm_err;
-	struct pdn *pdn;
 
 	/* +CNEC_ESM: <cause>,<cid> */
 	match = sscanf(notif, "+CNEC_ESM: %u,%u", &esm_err, &cid);
@@ -67,14 +96,11 @@ static void on_cnec_esm(const char *notif)
 		return;
 	}
 
-	pdn = pdn_find(cid);
-	if (!pdn) {
+	if (!pdn_find(cid)) {
 		return;
 	}
 
-	if (pdn->callback) {
-		pdn->callback((intptr_t)cid, PDN_EVENT_CNEC_ESM, esm_err);
-	}
+	pdn_notify(cid, PDN_EVENT_CNEC_ESM, esm_err);
 
 	esm_from_notif = esm_err;
 	k_sem_give(&notif_sem);
@@ -82,9 +108,9 @@ static void on_cnec_esm(const char *notif)
 
 static void on_cgev(const char *notif)
 {
-	char *p;
+	const char *p;
+	size_t len;
 	uint8_t cid;
-	struct pdn *pdn;
 
 	const struct {
 		const char *notif;
@@ -97,28 +123,32 @@ static void on_cgev(const char *notif)
 		{"IPV6",		PDN_EVENT_IPV6_UP},	/* +CGEV: IPV6 <cid> */
 	};
 
+	/* +CGEV: <event> <cid> */
+	p = strchr(notif, ':');
+	if (!p) {
+		return;
+	}
+
+	p++;
+	while (*p == ' ') {
+		p++;
+	}
+
 	for (size_t i = 0; i < ARRAY_SIZE(map); i++) {
-		p = strstr(notif, map[i].notif);
-		if (!p) {
+		len = strlen(map[i].notif);
+		if (strncmp(p, map[i].notif, len)) {
 			continue;
 		}
 
-		cid = strtoul(p + strlen(map[i].notif), NULL, 10);
+		cid = strtoul(p + len, NULL, 10);
 
 		if (default_callback && cid == 0) {
 			default_callback(0, map[i].event, 0);
 			return;
 		}
 
-		pdn = pdn_find(cid);
-		if (!pdn) {
-			return;
-		}
-
-		if (pdn->callback) {
-			pdn->callback((intptr_t)cid, map[i].event, 0);
-			return;
-		}
+		pdn_notify(cid, map[i].event, 0);
+		return;
 	}
 }
 
@@ -186,29 +216,43 @@ int pdn_default_callback_set(pdn_event_handler_t cb)
 int pdn_ctx_create(uint8_t *cid, pdn_event_handler_t cb)
 {
 	int err;
+	int new_cid;
 	struct pdn *pdn;
 
 	if (!cid) {
 		return -EFAULT;
 	}
 
+	k_mutex_lock(&pdn_lock, K_FOREVER);
+
 	pdn = pdn_avail_get();
 	if (!pdn) {
-		return -ENOMEM;
+		err = -ENOMEM;
+		goto unlock;
 	}
 
-	err = nrf_modem_at_scanf("AT%XNEWCID?", "%%XNEWCID: %d", &pdn->context_id);
+	err = nrf_modem_at_scanf("AT%XNEWCID?", "%%XNEWCID: %d", &new_cid);
 	if (err < 0) {
-		return err;
+		goto unlock;
 	}
 
-	*cid = pdn->context_id;
-
-	if (cb) {
-		pdn->callback = cb;
+	if (new_cid < 0 || new_cid > CID_MAX) {
+		LOG_ERR("Invalid CID %d", new_cid);
+		err = -EBADMSG;
+		goto unlock;
 	}
 
-	return 0;
+	pdn->context_id = new_cid;
+	pdn->callback = cb;
+	pdn_by_cid[new_cid] = pdn;
+
+	*cid = new_cid;
+	err = 0;
+
+unlock:
+	k_mutex_unlock(&pdn_lock);
+
+	return err;
 }
 
 int pdn_ctx_configure(uint8_t cid, const char *apn, enum pdn_fam fam,
@@ -281,20 +325,27 @@ int pdn_ctx_destroy(uint8_t cid)
 	int err;
 	struct pdn *pdn;
 
+	k_mutex_lock(&pdn_lock, K_FOREVER);
+
 	pdn = pdn_find(cid);
 	if (!pdn) {
-		return -EINVAL;
+		err = -EINVAL;
+		goto unlock;
 	}
 
 	err = nrf_modem_at_printf("AT+CGDCONT=%u", cid);
 	if (err) {
-		return err;
+		goto unlock;
 	}
 
+	pdn_by_cid[cid] = NULL;
 	pdn->context_id = CID_UNASSIGNED;
 	pdn->callback = NULL;
 
-	return 0;
+unlock:
+	k_mutex_unlock(&pdn_lock);
+
+	return err;
 }
 
 static int cgact(uint8_t cid, bool activate)
@@ -73,9 +73,210 @@ static uint32_t ram_sect_bank_bottom_addr(uint8_t bank_id, uint8_t section_id)
 }
 #endif /* ifndef UNUSED_RAM_POWER_OFF_UNSUPPORTED */
 
+#if CONFIG_RAM_POWER_DOWN_DYNAMIC && !defined(UNUSED_RAM_POWER_OFF_UNSUPPORTED)
+/* Number of RAM sections available at the SoC. */
+#define RAM_SECTIONS_NBR (RAM_BANKS_NBR * RAM_BANK_0_7_SECTIONS_NBR + \
+			  RAM_BANK_8_SECTIONS_NBR)
+/* End of RAM available at the SoC. */
+#define RAM_TOP_ADDR     (RAM_START_ADDR + KB(CONFIG_SRAM_SIZE))
+
+/* Sections above the image, from the lowest address. For each section,
+ * the number of sections of the allocation starting there, or 0.
+ */
+static uint8_t sect_alloc[RAM_SECTIONS_NBR];
+/* Sections that are allocated. */
+static uint32_t sect_used;
+/* Sections that are powered. */
+static uint32_t sect_powered;
+/* Index of the first section above the image. */
+static uint8_t sect_first;
+/* Number of sections available at the SoC. */
+static uint8_t sect_count;
+static struct k_spinlock lock;
+
+static void sect_bank_get(uint8_t sect, uint8_t *bank_id, uint8_t *section_id)
+{
+	if (sect < RAM_BANKS_NBR * RAM_BANK_0_7_SECTIONS_NBR) {
+		*bank_id = sect / RAM_BANK_0_7_SECTIONS_NBR;
+		*section_id = sect % RAM_BANK_0_7_SECTIONS_NBR;
+	} else {
+		*bank_id = 8;
+		*section_id = sect - RAM_BANKS_NBR * RAM_BANK_0_7_SECTIONS_NBR;
+	}
+}
+
+static uint32_t sect_addr(uint8_t sect)
+{
+	uint8_t bank_id;
+	uint8_t section_id;
+
+	sect_bank_get(sect, &bank_id, &section_id);
+
+	return ram_sect_bank_bottom_addr(bank_id, section_id);
+}
+
+static uint32_t sect_size(uint8_t sect)
+{
+	return (sect < RAM_BANKS_NBR * RAM_BANK_0_7_SECTIONS_NBR) ?
+	       RAM_BANK_0_7_SECTION_SIZE : RAM_BANK_8_SECTION_SIZE;
+}
+
+static void sect_power_set(uint8_t sect, bool on)
+{
+	uint8_t bank_id;
+	uint8_t section_id;
+	uint32_t mask;
+
+	sect_bank_get(sect, &bank_id, &section_id);
+	mask = (1 << section_id) << NRF_POWER_RAMPOWER_S0POWER;
+
+	if (on) {
+		nrf_power_rampower_mask_on(NRF_POWER, bank_id, mask);
+		sect_powered |= BIT(sect);
+	} else {
+		nrf_power_rampower_mask_off(NRF_POWER, bank_id, mask);
+		sect_powered &= ~BIT(sect);
+	}
+}
+
+/**@brief Power down free sections, except for the lowest ones which fit in
+ *        the given size. These are taken first by the next allocations.
+ */
+static void sect_trim(size_t spare)
+{
+	for (uint8_t sect = sect_first; sect < sect_count; sect++) {
+		if (sect_used & BIT(sect)) {
+			continue;
+		}
+
+		if (sect_size(sect) <= spare) {
+			spare -= sect_size(sect);
+			continue;
+		}
+
+		/* Sections above are not kept, even if smaller. */
+		spare = 0;
+		if (sect_powered & BIT(sect)) {
+			LOG_DBG("Powering off section %d.", sect);
+			sect_power_set(sect, false);
+		}
+	}
+}
+
+void *ram_pwrdn_alloc(size_t size)
+{
+	k_spinlock_key_t key;
+	void *ptr = NULL;
+
+	if (size == 0) {
+		return NULL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	/* First fit from the lowest address, to keep the top of RAM free. */
+	for (uint8_t start = sect_first; start < sect_count; start++) {
+		size_t found = 0;
+		uint8_t end = start;
+
+		while (end < sect_count && !(sect_used & BIT(end)) &&
+		       found < size) {
+			found += sect_size(end);
+			end++;
+		}
+
+		if (found < size) {
+			start = end;
+			continue;
+		}
+
+		for (uint8_t sect = start; sect < end; sect++) {
+			if (!(sect_powered & BIT(sect))) {
+				LOG_DBG("Powering on section %d.", sect);
+				sect_power_set(sect, true);
+			}
+			sect_used |= BIT(sect);
+		}
+		sect_alloc[start] = end - start;
+		ptr = (void *)sect_addr(start);
+		break;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ptr;
+}
+
+void ram_pwrdn_free(void *ptr)
+{
+	k_spinlock_key_t key;
+	uint8_t start;
+
+	if (!ptr) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+
+	for (start = sect_first; start < sect_count; start++) {
+		if (sect_addr(start) == (uint32_t)ptr) {
+			break;
+		}
+	}
+
+	if (start == sect_count || sect_alloc[start] == 0) {
+		k_spin_unlock(&lock, key);
+		LOG_ERR("Invalid pointer: %p", ptr);
+		return;
+	}
+
+	for (uint8_t sect = start; sect < start + sect_alloc[start]; sect++) {
+		sect_used &= ~BIT(sect);
+	}
+	sect_alloc[start] = 0;
+
+	sect_trim(CONFIG_RAM_POWER_DOWN_DYNAMIC_HYSTERESIS);
+
+	k_spin_unlock(&lock, key);
+}
+
+static int ram_pwrdn_dynamic_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	sect_first = RAM_SECTIONS_NBR;
+	for (uint8_t sect = 0; sect < RAM_SECTIONS_NBR; sect++) {
+		if (sect_addr(sect) + sect_size(sect) > RAM_TOP_ADDR) {
+			break;
+		}
+		if (sect_first == RAM_SECTIONS_NBR &&
+		    sect_addr(sect) >= RAM_END_ADDR) {
+			sect_first = sect;
+		}
+		sect_count = sect + 1;
+		sect_powered |= BIT(sect);
+	}
+
+	/* Unused RAM starts powered down. */
+	sect_trim(0);
+
+	return 0;
+}
+
+SYS_INIT(ram_pwrdn_dynamic_init, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif /* CONFIG_RAM_POWER_DOWN_DYNAMIC */
+
 void power_down_unused_ram(void)
 {
-#ifndef UNUSED_RAM_POWER_OFF_UNSUPPORTED
+#if CONFIG_RAM_POWER_DOWN_DYNAMIC && !defined(UNUSED_RAM_POWER_OFF_UNSUPPORTED)
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* Sections allocated at runtime must stay powered. */
+	sect_trim(0);
+
+	k_spin_unlock(&lock, key);
+#elif !defined(UNUSED_RAM_POWER_OFF_UNSUPPORTED)
 	/* ID of top RAM bank. Depends of amount of RAM available at SoC. */
 	uint8_t     bank_id                 = RAM_BANKS_NBR;
 	uint8_t     section_id              = 5;
@@ -609,10 +609,8 @@ static int decode_pdu_ud_7bit(struct parser *parser, uint8_t *buf)
 {
 	struct pdu_deliver_data * const pdata = parser->data;
 	uint16_t actual_data_length;
-	uint8_t length;
-	uint8_t skip_bits;
-	uint8_t skip_septets;
-	int length_udh_skipped;
+	uint16_t skip_bits;
+	uint16_t skip_septets;
 
 	if (pdata->udl > SMS_MAX_PAYLOAD_LEN_CHARS) {
 		LOG_ERR("User Data Length exceeds maximum number of characters (%d) in SMS spec",
@@ -628,13 +626,8 @@ static int decode_pdu_ud_7bit(struct parser *parser, uint8_t *buf)
 
 	actual_data_length = MIN(actual_data_length, pdata->udl);
 
-	/* Convert GSM 7bit data to ASCII characters */
-	length = string_conversion_gsm7bit_to_ascii(
-		buf, sms_payload_tmp, actual_data_length, true);
-
 	/* Check whether User Data Header is present.
-	 * If yes, we need to skip those septets in the sms_payload_tmp, which has all of the data
-	 * decoded including User Data Header. This is done because the actual data/text is
+	 * If yes, we need to skip those septets, because the actual data/text is
 	 * aligned into septet (7bit) boundary after User Data Header.
 	 */
 	skip_bits = pdata->udhl * 8;
@@ -644,20 +637,10 @@ static int decode_pdu_ud_7bit(struct parser *parser, uint8_t *buf)
 		skip_septets++;
 	}
 
-	/* Number of characters/bytes in the actual data which excludes
-	 * User Data Header but minimum is 0. In some corner cases this would
-	 * result in negative value causing crashes.
-	 */
-	length_udh_skipped = (length >= skip_septets) ? (int)(length - skip_septets) : 0;
-
-	/* Verify that payload buffer is not too short */
-	__ASSERT(length_udh_skipped <= parser->payload_buf_size,
-		"GSM 7bit User-Data-Length shorter than output buffer");
-
-	/* Copy decoded data/text into the output buffer */
-	memcpy(parser->payload, sms_payload_tmp + skip_septets, length_udh_skipped);
-
-	return length_udh_skipped;
+	/* Unpack and convert GSM 7bit data directly into the output buffer */
+	return string_conversion_gsm7bit_packed_to_ascii(
+		buf, skip_septets, actual_data_length,
+		parser->payload, parser->payload_buf_size);
 }
 
 /**
@@ -841,7 +824,7 @@ int sms_deliver_pdu_parse(const char *pdu, struct sms_data *data)
 	err = parser_process_str(&sms_deliver, pdu);
 	if (err) {
 		LOG_ERR("Parsing error (%d) in decoding SMS-DELIVER message", err);
-		return err;
+		goto exit;
 	}
 
 	parser_get_header(&sms_deliver, header);
@@ -852,7 +835,8 @@ int sms_deliver_pdu_parse(const char *pdu, struct sms_data *data)
 
 	if (data->payload_len < 0) {
 		LOG_ERR("Decoding SMS-DELIVER payload failed: %d", data->payload_len);
-		return data->payload_len;
+		err = data->payload_len;
+		goto exit;
 	}
 
 	LOG_DBG("Time:   %02x-%02x-%02x %02x:%02x:%02x",
@@ -866,6 +850,7 @@ int sms_deliver_pdu_parse(const char *pdu, struct sms_data *data)
 
 	LOG_DBG("Length: %d", data->payload_len);
 
+exit:
 	parser_delete(&sms_deliver);
-	return 0;
+	return err;
 }
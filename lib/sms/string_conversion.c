@@ -257,6 +257,46 @@ uint8_t string_conversion_gsm7bit_to_ascii(
 	return index_ascii;
 }
 
+uint8_t string_conversion_gsm7bit_packed_to_ascii(
+	const uint8_t *packed,
+	uint16_t first_char,
+	uint16_t num_char,
+	uint8_t *out_data,
+	uint8_t  out_size)
+{
+	uint8_t index_ascii = 0;
+	bool escape = false;
+
+	if ((packed == NULL) || (out_data == NULL)) {
+		return 0;
+	}
+
+	for (uint16_t index_7bit = first_char;
+	     (index_7bit < num_char) && (index_ascii < out_size);
+	     index_7bit++) {
+		uint16_t bit = index_7bit * 7;
+		uint8_t shift = bit % 8;
+		uint8_t char_7bit = packed[bit / 8] >> shift;
+
+		/* Septets starting from bit 2 or higher continue in the next octet */
+		if (shift > 1) {
+			char_7bit |= packed[bit / 8 + 1] << (8 - shift);
+		}
+		char_7bit &= STR_7BIT_CODE_MASK;
+
+		if (escape) {
+			out_data[index_ascii++] = gsm7bit_to_ascii_table[128 + char_7bit];
+			escape = false;
+		} else if (char_7bit == STR_7BIT_ESCAPE_CODE) {
+			escape = true;
+		} else {
+			out_data[index_ascii++] = gsm7bit_to_ascii_table[char_7bit];
+		}
+	}
+
+	return index_ascii;
+}
+
 /**
  * @brief Performs SMS packing for a string using GSM 7 bit character set. The result
  *        is stored in the same memory buffer that contains the input string to be
@@ -74,6 +74,28 @@ uint8_t string_conversion_gsm7bit_to_ascii(const uint8_t *data,
 						 uint8_t  num_char,
 						 bool     packed);
 
+/**
+ * @brief Convert packed GSM 7 bit Default Alphabet characters to ASCII characters.
+ *
+ * @details Same as string_conversion_gsm7bit_to_ascii() for packed data, but the septets
+ * are unpacked one at a time while they are converted, so no intermediate buffer is needed.
+ * Conversion can start from any septet, for example to skip a User Data Header.
+ *
+ * @param[in] packed Pointer to the packed 7 bit characters. No null termination.
+ * @param[in] first_char Index of the first 7-bit character to be converted.
+ * @param[in] num_char Number of 7-bit characters in "packed", including the skipped ones and
+ *            possible escape codes.
+ * @param[out] out_data Pointer to buffer for the converted string. Null termination is not added.
+ * @param[in] out_size Maximum number of characters to be stored to output buffer.
+ *
+ * @return Number of valid bytes/characters in "out_data".
+ */
+uint8_t string_conversion_gsm7bit_packed_to_ascii(const uint8_t *packed,
+							uint16_t first_char,
+							uint16_t num_char,
+							uint8_t *out_data,
+							uint8_t  out_size);
+
 /**
  * @brief Performs SMS packing for a string using GSM 7 bit character set. The result
  *        is stored in the same memory buffer that contains the input string to be
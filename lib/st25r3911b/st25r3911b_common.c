@@ -305,13 +305,10 @@ int st25r3911b_rx_tx_disable(void)
 	return st25r3911b_reg_modify(ST25R3911B_REG_OP_CTRL, mask, 0);
 }
 
-int st25r3911b_non_response_timer_set(uint16_t fc, bool long_range, bool emv)
+static uint8_t tim_control_get(uint8_t tim_control, bool long_range, bool emv)
 {
-	int err;
-	uint8_t tim_control = 0;
-	uint8_t clr_mask = ST25R3911B_REG_TIM_CTRl_NRT_STEP |
-			ST25R3911B_REG_TIM_CTRl_NRT_EMV;
-	uint8_t reg_data[2] = {0};
+	tim_control &= ~(ST25R3911B_REG_TIM_CTRl_NRT_STEP |
+			 ST25R3911B_REG_TIM_CTRl_NRT_EMV);
 
 	if (emv) {
 		tim_control |= ST25R3911B_REG_TIM_CTRl_NRT_EMV;
@@ -321,21 +318,58 @@ int st25r3911b_non_response_timer_set(uint16_t fc, bool long_range, bool emv)
 		tim_control |= ST25R3911B_REG_TIM_CTRl_NRT_STEP;
 	}
 
+	return tim_control;
+}
+
+int st25r3911b_non_response_timer_set(uint16_t fc, bool long_range, bool emv)
+{
+	int err;
+	uint8_t tim_control;
+	uint8_t reg_data[2] = {0};
+
 	sys_put_be16(fc, reg_data);
 
-	err = st25r3911b_reg_modify(ST25R3911B_REG_TIM_CTRl,
-				    clr_mask, tim_control);
+	err = st25r3911b_reg_read(ST25R3911B_REG_TIM_CTRl, &tim_control);
 	if (err) {
 		return err;
 	}
 
-	err = st25r3911b_reg_write(ST25R3911B_REG_NO_RSP_TIM_REG1, reg_data[0]);
+	err = st25r3911b_reg_write(ST25R3911B_REG_TIM_CTRl,
+				   tim_control_get(tim_control, long_range, emv));
 	if (err) {
 		return err;
 	}
 
-	return st25r3911b_reg_write(ST25R3911B_REG_NO_RSP_TIM_REG2,
-				    reg_data[1]);
+	/* No-Response Timer registers are adjacent. */
+	return st25r3911b_multiple_reg_write(ST25R3911B_REG_NO_RSP_TIM_REG1,
+					     reg_data, sizeof(reg_data));
+}
+
+int st25r3911b_rx_timers_set(uint32_t mask_fc, uint16_t no_rsp_fc,
+			     bool long_range, bool emv)
+{
+	int err;
+	uint8_t tim_control;
+	uint8_t reg_data[4];
+
+	BUILD_ASSERT(ST25R3911B_REG_NO_RSP_TIM_REG1 == ST25R3911B_REG_MASK_RX_TIM + 1,
+		     "Timer registers must be adjacent");
+	BUILD_ASSERT(ST25R3911B_REG_TIM_CTRl == ST25R3911B_REG_NO_RSP_TIM_REG2 + 1,
+		     "Timer registers must be adjacent");
+
+	err = st25r3911b_reg_read(ST25R3911B_REG_TIM_CTRl, &tim_control);
+	if (err) {
+		return err;
+	}
+
+	reg_data[0] = ST25R3911B_FC_TO_64FC(mask_fc);
+	sys_put_be16(no_rsp_fc, &reg_data[1]);
+	reg_data[3] = tim_control_get(tim_control, long_range, emv);
+
+	LOG_DBG("Set mask receive timer to %u fc", mask_fc);
+
+	return st25r3911b_multiple_reg_write(ST25R3911B_REG_MASK_RX_TIM,
+					     reg_data, sizeof(reg_data));
 }
 
 int st25r3911b_mask_receive_timer_set(uint32_t fc)
@@ -442,24 +476,26 @@ int st25r3911b_init(void)
 int st25r3911b_tx_len_set(uint16_t len)
 {
 	int err;
-	uint8_t msb_val;
+	uint8_t reg_data[2];
 
 	if (len > ST25R3911B_MAX_TX_LEN) {
 		return -EFAULT;
 	}
 
-	msb_val = (len >> ST25R3911B_REG_NUM_TX_BYTES_NTX_SHIFT_LSB) & 0xFF;
-
-	err = st25r3911b_reg_modify(ST25R3911B_REG_NUM_TX_BYTES_REG2,
-				    ST25R3911B_REG_NUM_TX_BYTES_REG2_NTX_MASK,
-				    (len << ST25R3911B_REG_NUM_TX_BYTES_NTX_SHIFT) &
-				    ST25R3911B_REG_NUM_TX_BYTES_REG2_NTX_MASK);
+	err = st25r3911b_reg_read(ST25R3911B_REG_NUM_TX_BYTES_REG2, &reg_data[1]);
 	if (err) {
 		return err;
 	}
 
-	err = st25r3911b_reg_write(ST25R3911B_REG_NUM_TX_BYTES_REG1,
-				   msb_val);
+	reg_data[0] = (len >> ST25R3911B_REG_NUM_TX_BYTES_NTX_SHIFT_LSB) & 0xFF;
+
+	reg_data[1] &= ~ST25R3911B_REG_NUM_TX_BYTES_REG2_NTX_MASK;
+	reg_data[1] |= (len << ST25R3911B_REG_NUM_TX_BYTES_NTX_SHIFT) &
+		       ST25R3911B_REG_NUM_TX_BYTES_REG2_NTX_MASK;
+
+	/* Both registers are written in one SPI transfer. */
+	err = st25r3911b_multiple_reg_write(ST25R3911B_REG_NUM_TX_BYTES_REG1,
+					    reg_data, sizeof(reg_data));
 	if (!err) {
 		LOG_DBG("Fifo Tx length set to %u", len);
 	}
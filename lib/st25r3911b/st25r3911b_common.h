@@ -141,6 +141,26 @@ int st25r3911b_non_response_timer_set(uint16_t fc, bool long_range, bool emv);
  */
 int st25r3911b_mask_receive_timer_set(uint32_t fc);
 
+/** @brief Set NFC Reader Mask Receive and No-Response timers.
+ *
+ *  @details The timer registers are adjacent, so this function sets
+ *           both timers in one SPI transfer. It is equivalent to
+ *           calling @ref st25r3911b_mask_receive_timer_set and
+ *           @ref st25r3911b_non_response_timer_set.
+ *
+ *  @param[in] mask_fc    Mask Receive timer value, as for
+ *                        @ref st25r3911b_mask_receive_timer_set.
+ *  @param[in] no_rsp_fc  No-Response timer value, as for
+ *                        @ref st25r3911b_non_response_timer_set.
+ *  @param[in] long_range No-Response timer long range mode.
+ *  @param[in] emv        No-Response timer EMV mode.
+ *
+ *  @retval 0 If the operation was successful.
+ *            Otherwise, a (negative) error code is returned.
+ */
+int st25r3911b_rx_timers_set(uint32_t mask_fc, uint16_t no_rsp_fc,
+			     bool long_range, bool emv);
+
 /** @brief Perform automatic collision resolution and switch on the NFC Reader
  *         field.
  *
@@ -128,6 +128,8 @@ struct st25r3911b_nfca {
 	struct fifo_water_lvl water_lvl;
 	uint32_t cmd;
 	const struct st25r3911b_nfca_cb *cb;
+	bool antcl_mode;
+	bool antcl_mode_valid;
 };
 
 static K_SEM_DEFINE(irq_sem, 0, 1);
@@ -231,6 +233,40 @@ static int transmission_prepare(void)
 	return st25r3911b_cmd_execute(ST25R3911B_CMD_RESET_RX_GAIN);
 }
 
+/* Anticollision frames are bit oriented and their response does not contain
+ * CRC. The mode is only written when it changes, to save SPI transfers
+ * during the anticollision and data exchange.
+ */
+static int antcl_mode_set(bool antcl)
+{
+	int err;
+
+	if (nfca.antcl_mode_valid && (nfca.antcl_mode == antcl)) {
+		return 0;
+	}
+
+	nfca.antcl_mode_valid = false;
+
+	err = st25r3911b_reg_modify(ST25R3911B_REG_ISO14443A,
+				    antcl ? 0 : ST25R3911B_REG_ISO14443A_ANTCL,
+				    antcl ? ST25R3911B_REG_ISO14443A_ANTCL : 0);
+	if (err) {
+		return err;
+	}
+
+	err = st25r3911b_reg_modify(ST25R3911B_REG_AUXILIARY,
+				    antcl ? 0 : ST25R3911B_REG_AUXILIARY_NO_CRC_RX,
+				    antcl ? ST25R3911B_REG_AUXILIARY_NO_CRC_RX : 0);
+	if (err) {
+		return err;
+	}
+
+	nfca.antcl_mode = antcl;
+	nfca.antcl_mode_valid = true;
+
+	return 0;
+}
+
 static int anticollision_transmit(uint8_t *tx_buf, size_t tx_bytes,
 				  size_t tx_bits, bool antcl)
 {
@@ -239,52 +275,26 @@ static int anticollision_transmit(uint8_t *tx_buf, size_t tx_bytes,
 	uint32_t mask_timer;
 	uint16_t no_rsp_timer;
 
-	if (antcl) {
-		/* Set sending anticollision frame */
-		err = st25r3911b_reg_modify(ST25R3911B_REG_ISO14443A, 0,
-					    ST25R3911B_REG_ISO14443A_ANTCL);
-		if (err) {
-			return err;
-		}
-
-		err = st25r3911b_reg_modify(ST25R3911B_REG_AUXILIARY, 0,
-					    ST25R3911B_REG_AUXILIARY_NO_CRC_RX);
-		if (err) {
-			return err;
-		}
+	err = antcl_mode_set(antcl);
+	if (err) {
+		return err;
+	}
 
+	if (antcl) {
 		LOG_DBG("Bit oriented anticollision frame will be sent");
-
-	} else {
-		/* Unset sending anticollision frame */
-		err = st25r3911b_reg_modify(ST25R3911B_REG_ISO14443A,
-					    ST25R3911B_REG_ISO14443A_ANTCL, 0);
-		if (err) {
-			return err;
-		}
-
-		err = st25r3911b_reg_modify(ST25R3911B_REG_AUXILIARY,
-					    ST25R3911B_REG_AUXILIARY_NO_CRC_RX, 0);
-		if (err) {
-			return err;
-		}
 	}
 
 	mask_timer = NFCA_MIN_LISTEN_FDT -
 		     (ST25R3911B_FDT_ADJUST + NFCA_POLL_FTD_ADJUSMENT);
 
-	/* Set time when RX is not active after transmission */
-	err = st25r3911b_mask_receive_timer_set(mask_timer);
-	if (err) {
-		return err;
-	}
-
 	no_rsp_timer = ST25R3911B_FC_TO_64FC(NFCA_MIN_LISTEN_FDT +
 				  ST25R3911B_FDT_ADJUST +
 				  NFCA_FWT_A_ADJUSMENT);
 
-	/* Set time before it RX should be detected */
-	err = st25r3911b_non_response_timer_set(no_rsp_timer, false, false);
+	/* Set time when RX is not active after transmission and time
+	 * before it RX should be detected.
+	 */
+	err = st25r3911b_rx_timers_set(mask_timer, no_rsp_timer, false, false);
 	if (err) {
 		return err;
 	}
@@ -343,21 +353,19 @@ static int transfer_fdt_set(uint32_t fdt)
 	mask_timer = NFCA_MIN_LISTEN_FDT -
 		     (ST25R3911B_FDT_ADJUST + NFCA_POLL_FTD_ADJUSMENT);
 
-	/* Set mask receive timer, RX is disabled for this time. */
-	err = st25r3911b_mask_receive_timer_set(ST25R3911B_FC_TO_64FC(mask_timer));
-	if (err) {
-		return err;
-	}
-
 	fdt += ST25R3911B_FDT_ADJUST + NFCA_FWT_A_ADJUSMENT;
 
-	/* Set No-Response Timer, during this time RX should detect transmission. */
+	/* Set mask receive timer, RX is disabled for this time and
+	 * No-Response Timer, during this time RX should detect transmission.
+	 */
 	if (fdt > ST25R3911B_NRT_64FC_MAX) {
-		err = st25r3911b_non_response_timer_set(ST25R3911B_FC_TO_4096FC(MIN(fdt, ST25R3911B_NRT_FC_MAX)),
-							true, false);
+		err = st25r3911b_rx_timers_set(ST25R3911B_FC_TO_64FC(mask_timer),
+					       ST25R3911B_FC_TO_4096FC(MIN(fdt, ST25R3911B_NRT_FC_MAX)),
+					       true, false);
 	} else {
-		err = st25r3911b_non_response_timer_set(ST25R3911B_FC_TO_64FC(fdt),
-							false, false);
+		err = st25r3911b_rx_timers_set(ST25R3911B_FC_TO_64FC(mask_timer),
+					       ST25R3911B_FC_TO_64FC(fdt),
+					       false, false);
 	}
 
 	return err;
@@ -758,16 +766,8 @@ static int tag_detect(enum st25r3911b_nfca_detect_cmd cmd)
 	uint32_t mask_timer;
 	uint32_t no_rsp_timer;
 
-	/* Set sending anticollision frame */
-	err = st25r3911b_reg_modify(ST25R3911B_REG_ISO14443A, 0,
-				    ST25R3911B_REG_ISO14443A_ANTCL);
-	if (err) {
-		return err;
-	}
-
-	/* Rx data do not contain the CRC. */
-	err = st25r3911b_reg_modify(ST25R3911B_REG_AUXILIARY, 0,
-				    ST25R3911B_REG_AUXILIARY_NO_CRC_RX);
+	/* Set sending anticollision frame, Rx data do not contain the CRC. */
+	err = antcl_mode_set(true);
 	if (err) {
 		return err;
 	}
@@ -775,17 +775,14 @@ static int tag_detect(enum st25r3911b_nfca_detect_cmd cmd)
 	mask_timer = NFCA_MIN_LISTEN_FDT -
 		     (ST25R3911B_FDT_ADJUST + NFCA_POLL_FTD_ADJUSMENT);
 
-	/* Set time when RX is not active after transmission */
-	err = st25r3911b_mask_receive_timer_set(mask_timer);
-	if (err) {
-		return err;
-	}
-
 	no_rsp_timer = NFCA_MIN_LISTEN_FDT + ST25R3911B_FDT_ADJUST + NFCA_FWT_A_ADJUSMENT;
 
-	/* Set time before it RX should be detected */
-	err = st25r3911b_non_response_timer_set(ST25R3911B_FC_TO_64FC(no_rsp_timer),
-						false, false);
+	/* Set time when RX is not active after transmission and time
+	 * before it RX should be detected.
+	 */
+	err = st25r3911b_rx_timers_set(mask_timer,
+				       ST25R3911B_FC_TO_64FC(no_rsp_timer),
+				       false, false);
 	if (err) {
 		return err;
 	}
@@ -857,22 +854,10 @@ static int transfer(const struct st25r3911b_nfca_buf *tx,
 	uint8_t cmd;
 	uint32_t irq;
 
-	/* Do not set sending anticollision frame */
-	err = st25r3911b_reg_modify(ST25R3911B_REG_ISO14443A,
-				    ST25R3911B_REG_ISO14443A_ANTCL, 0);
-	if (err) {
-		return err;
-	}
-
-	err = st25r3911b_reg_modify(ST25R3911B_REG_AUXILIARY,
-				    ST25R3911B_REG_AUXILIARY_NO_CRC_RX, 0);
-	if (err) {
-		return err;
-	}
-
-	/* Read FIFO water level */
-	err = st25r3911b_fifo_reload_lvl_get(&nfca.water_lvl.tx,
-					     &nfca.water_lvl.rx);
+	/* Do not set sending anticollision frame. The FIFO water levels
+	 * were read during initialization and do not change.
+	 */
+	err = antcl_mode_set(false);
 	if (err) {
 		return err;
 	}
@@ -1115,6 +1100,9 @@ int st25r3911b_nfca_init(struct k_poll_event *events, uint8_t cnt,
 		return err;
 	}
 
+	/* Registers are at their default values. */
+	nfca.antcl_mode_valid = false;
+
 	/* Set callbacks */
 	nfca.cb = cb;
 
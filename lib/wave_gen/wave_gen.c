@@ -17,6 +17,35 @@ LOG_MODULE_REGISTER(wave_gen, CONFIG_WAVE_GEN_LIB_LOG_LEVEL);
 
 #include <wave_gen.h>
 
+#define PHASE_QUARTER		BIT(30)
+#define PHASE_HALF		BIT(31)
+/* Scale of 32-bit phase to the fraction of a period. */
+#define PHASE_TO_FLOAT		(1.0f / 4294967296.0f)
+
+#define SINE_TABLE_BITS		6
+#define SINE_TABLE_FRAC_BITS	(30 - SINE_TABLE_BITS)
+
+/* Sine values for the first quarter of the period. */
+static const float sine_table[BIT(SINE_TABLE_BITS) + 1] = {
+	0.00000000f, 0.02454123f, 0.04906767f, 0.07356456f,
+	0.09801714f, 0.12241068f, 0.14673047f, 0.17096189f,
+	0.19509032f, 0.21910124f, 0.24298018f, 0.26671276f,
+	0.29028468f, 0.31368174f, 0.33688985f, 0.35989504f,
+	0.38268343f, 0.40524131f, 0.42755509f, 0.44961133f,
+	0.47139674f, 0.49289819f, 0.51410274f, 0.53499762f,
+	0.55557023f, 0.57580819f, 0.59569930f, 0.61523159f,
+	0.63439328f, 0.65317284f, 0.67155895f, 0.68954054f,
+	0.70710678f, 0.72424708f, 0.74095113f, 0.75720885f,
+	0.77301045f, 0.78834643f, 0.80320753f, 0.81758481f,
+	0.83146961f, 0.84485357f, 0.85772861f, 0.87008699f,
+	0.88192126f, 0.89322430f, 0.90398929f, 0.91420976f,
+	0.92387953f, 0.93299280f, 0.94154407f, 0.94952818f,
+	0.95694034f, 0.96377607f, 0.97003125f, 0.97570213f,
+	0.98078528f, 0.98527764f, 0.98917651f, 0.99247953f,
+	0.99518473f, 0.99729046f, 0.99879546f, 0.99969882f,
+	1.00000000f,
+};
+
 /**
  * @brief Generates a pseudo-random number between -1 and 1.
  *
@@ -84,10 +113,155 @@ static double square_val(uint32_t time, uint32_t period)
 	return ((time < (period / 2)) ? (-amplitude) : (amplitude));
 }
 
+/**
+ * @brief Generates a pseudo-random number between -1 and 1 in single precision.
+ *
+ * @return Pseudo-random number.
+ */
+static float generate_pseudo_random_f(void)
+{
+	return rand() * (2.0f / RAND_MAX) - 1.0f;
+}
+
+/**
+ * @brief Calculate phase of the wave signal.
+ *
+ * @param[in]	time	Time for generated value (lower than the wave period).
+ * @param[in]	period	Wave period.
+ *
+ * @return Phase, where 2^32 represents a full period.
+ */
+static uint32_t phase_get(uint32_t time, uint32_t period)
+{
+	return ((uint64_t)time << 32) / period;
+}
+
+/**
+ * @brief Interpolate sine value from the quarter period table.
+ *
+ * @param[in]	pos	Phase within the first quarter of the period (up to and including 2^30).
+ *
+ * @return Sine value for given phase.
+ */
+static float quarter_sine_val(uint32_t pos)
+{
+	uint32_t idx = pos >> SINE_TABLE_FRAC_BITS;
+
+	if (idx >= BIT(SINE_TABLE_BITS)) {
+		return sine_table[BIT(SINE_TABLE_BITS)];
+	}
+
+	float frac = (pos & BIT_MASK(SINE_TABLE_FRAC_BITS)) *
+		     (1.0f / BIT(SINE_TABLE_FRAC_BITS));
+
+	return sine_table[idx] + (sine_table[idx + 1] - sine_table[idx]) * frac;
+}
+
+/**
+ * @brief Calculate wave value using single precision math and a sine lookup table.
+ *
+ * @param[in]	type	Wave type.
+ * @param[in]	phase	Phase of the wave, where 2^32 represents a full period.
+ *
+ * @return Wave value for given phase.
+ */
+static float wave_val_f(enum wave_gen_type type, uint32_t phase)
+{
+	uint32_t pos = phase & (PHASE_QUARTER - 1);
+
+	switch (type) {
+	case WAVE_GEN_TYPE_SINE:
+		switch (phase >> 30) {
+		case 0:
+			return quarter_sine_val(pos);
+		case 1:
+			return quarter_sine_val(PHASE_QUARTER - pos);
+		case 2:
+			return -quarter_sine_val(pos);
+		default:
+			return -quarter_sine_val(PHASE_QUARTER - pos);
+		}
+
+	case WAVE_GEN_TYPE_TRIANGLE:
+		if (phase < PHASE_HALF) {
+			return -1.0f + 4.0f * (phase * PHASE_TO_FLOAT);
+		} else {
+			return 3.0f - 4.0f * (phase * PHASE_TO_FLOAT);
+		}
+
+	case WAVE_GEN_TYPE_SQUARE:
+		return (phase < PHASE_HALF) ? -1.0f : 1.0f;
+
+	case WAVE_GEN_TYPE_NONE:
+	default:
+		return 0.0f;
+	}
+}
+
+static int params_check(const struct wave_gen_param *params)
+{
+	if (params->type >= WAVE_GEN_TYPE_COUNT) {
+		return -EINVAL;
+	}
+
+	if ((params->period_ms == 0) && (params->type != WAVE_GEN_TYPE_NONE)) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int wave_gen_generate_values(uint32_t time, uint32_t time_step_us,
+			     const struct wave_gen_param *params,
+			     float *out_vals, size_t val_cnt)
+{
+	uint32_t phase = 0;
+	uint32_t phase_step = 0;
+	float amplitude = params->amplitude;
+	float offset = params->offset;
+	float noise = params->noise;
+	int err = params_check(params);
+
+	if (err) {
+		return err;
+	}
+
+	if (params->period_ms != 0) {
+		uint64_t period_us = (uint64_t)params->period_ms * USEC_PER_MSEC;
+
+		phase = phase_get(time % params->period_ms, params->period_ms);
+		phase_step = (((uint64_t)(time_step_us % period_us)) << 32) / period_us;
+	}
+
+	for (size_t i = 0; i < val_cnt; i++) {
+		float res = wave_val_f(params->type, phase) * amplitude + offset;
+
+		if (noise != 0.0f) {
+			res += noise * generate_pseudo_random_f();
+		}
+
+		out_vals[i] = res;
+		phase += phase_step;
+	}
+
+	return 0;
+}
+
 int wave_gen_generate_value(uint32_t time, const struct wave_gen_param *params, double *out_val)
 {
 	double res;
 
+	if (IS_ENABLED(CONFIG_WAVE_GEN_LIB_TABLE)) {
+		float val;
+		int err = wave_gen_generate_values(time, 0, params, &val, 1);
+
+		if (!err) {
+			*out_val = val;
+		}
+
+		return err;
+	}
+
 	if (params->period_ms == 0) {
 		if (params->type != WAVE_GEN_TYPE_NONE) {
 			return -EINVAL;
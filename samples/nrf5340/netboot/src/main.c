@@ -44,25 +44,19 @@ void main(void)
 			goto failure;
 		}
 
+		/* The copy is compared to the validated data while it is
+		 * written, so there is no need to validate it again. Note that
+		 * only the SHA is validated, no signature check is performed.
+		 * This because the signature validation is performed by the
+		 * application core.
+		 */
 		err = pcd_fw_copy(fdev);
 		if (err != 0) {
 			printk("Failed to transfer image: %d\n\r", err);
 			goto failure;
 		}
 
-		/* Note that only the SHA is validated, no signature
-		 * check is performed. This because the signature validation
-		 * is performed by the application core. This check is only
-		 * done to verify that the flash copy operation was successful.
-		 */
-		valid = bl_validate_firmware(s0_addr, s0_addr);
-		if (valid) {
-			pcd_fw_copy_done();
-		} else {
-			printk("Unable to find valid firmware inside %p\n\r",
-				(void *)s0_addr);
-			goto failure;
-		}
+		pcd_fw_copy_done();
 
 		/* Success, waiting to be rebooted */
 		while (1)
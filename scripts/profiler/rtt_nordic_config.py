@@ -17,6 +17,7 @@ RttNordicConfig = {
     'reset_on_start': True,
     'connection_timeout': -1,
     'timestamp_raw_max': 2**32, #timestamp on uC is stored as 32-bit value
+    'timestamp_sync_id': 255, #ID of timestamp synchronization record in compressed stream
     'rtt_read_period': 0.1, #in seconds
     'rtt_read_chunk_size': 64000,
     'rtt_additional_read_thresh': 4096
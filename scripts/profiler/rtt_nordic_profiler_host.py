@@ -31,6 +31,8 @@ class RttNordicProfilerHost:
         self.received_events = EventsData([], {})
         self.timestamp_overflows = 0
         self.after_half = False
+        self.timestamp_delta = False
+        self.last_timestamp_raw = 0
 
         self.desc_buf = ""
         self.bufs = list()
@@ -238,6 +240,14 @@ class RttNordicProfilerHost:
             return None, None
         self.desc_buf = self.desc_buf[self.desc_buf.find('\n')+1:]
 
+        # Stream format options are prefixed with '!'
+        if desc.startswith('!'):
+            if desc[1:] == 'timestamp_delta':
+                self.timestamp_delta = True
+            else:
+                self.logger.warning("Unknown stream format option: " + desc[1:])
+            return self._read_single_event_description()
+
         desc_fields = desc.split(',')
 
         name = desc_fields[0]
@@ -265,13 +275,34 @@ class RttNordicProfilerHost:
         self.logger.info("Received events descriptions")
         self.logger.info("Ready to start logging events")
 
-    def _read_single_event_rtt(self):
-        id = int.from_bytes(
-            self._read_bytes(1),
-            byteorder=self.config['byteorder'],
-            signed=False)
-        et = self.received_events.registered_events_types[id]
+    def _read_varint(self):
+        value = 0
+        shift = 0
+        while True:
+            byte = self._read_bytes(1)[0]
+            value |= (byte & 0x7f) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
 
+    def _read_timestamp_sync(self):
+        buf = self._read_bytes(4)
+        timestamp_abs = int.from_bytes(buf, byteorder=self.config['byteorder'],
+                                       signed=False)
+        raw_max = self.config['timestamp_raw_max']
+        # Unwrap the absolute timestamp relative to the last received one
+        timestamp_raw = timestamp_abs + (self.last_timestamp_raw // raw_max) * raw_max
+        if timestamp_raw < self.last_timestamp_raw - raw_max // 2:
+            timestamp_raw += raw_max
+        self.last_timestamp_raw = timestamp_raw
+
+    def _read_timestamp_delta(self):
+        zigzag = self._read_varint()
+        delta = (zigzag >> 1) ^ -(zigzag & 1)
+        self.last_timestamp_raw += delta
+        return self.config['ms_per_timestamp_tick'] * self.last_timestamp_raw / 1000
+
+    def _read_timestamp_raw(self):
         buf = self._read_bytes(4)
         timestamp_raw = (
             int.from_bytes(
@@ -287,7 +318,24 @@ class RttNordicProfilerHost:
         if timestamp_raw > 0.6 * self.config['timestamp_raw_max']:
             if timestamp_raw < 0.9 * self.config['timestamp_raw_max']:
                 self.after_half = True
-        timestamp = self._calculate_timestamp_from_clock_ticks(timestamp_raw)
+        return self._calculate_timestamp_from_clock_ticks(timestamp_raw)
+
+    def _read_single_event_rtt(self):
+        while True:
+            id = int.from_bytes(
+                self._read_bytes(1),
+                byteorder=self.config['byteorder'],
+                signed=False)
+            if not self.timestamp_delta or id != self.config['timestamp_sync_id']:
+                break
+            self._read_timestamp_sync()
+
+        et = self.received_events.registered_events_types[id]
+
+        if self.timestamp_delta:
+            timestamp = self._read_timestamp_delta()
+        else:
+            timestamp = self._read_timestamp_raw()
 
         def process_int32(self, data):
             buf = self._read_bytes(4)
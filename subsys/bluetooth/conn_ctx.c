@@ -20,31 +20,25 @@ void *bt_conn_ctx_alloc(struct bt_conn_ctx_lib *ctx_lib, struct bt_conn *conn)
 	__ASSERT_NO_MSG(conn != NULL);
 	__ASSERT_NO_MSG(ctx_lib != NULL);
 
-	int err = -ENOMEM;
-	struct bt_conn_ctx *ctx;
+	int err;
+	uint8_t i = bt_conn_index(conn);
+	struct bt_conn_ctx *ctx = &ctx_lib->ctx[i];
 
 	k_mutex_lock(ctx_lib->mutex, K_FOREVER);
 
-	for (size_t i = 0; i < CONFIG_BT_MAX_CONN; i++) {
-		ctx = &ctx_lib->ctx[i];
-
-		if (!ctx->conn && !ctx->data) {
-			err = k_mem_slab_alloc(ctx_lib->mem_slab,
-					       &ctx->data,
-					       K_NO_WAIT);
-			if (!err) {
-				ctx->conn = conn;
-
-				LOG_DBG("The memory for the connection context "
-					"has been allocated, conn %p, index: %u",
-					(void *)conn, i);
-
-				return ctx->data;
+	/* Each connection owns the context slot at its connection index. */
+	if (!ctx->conn && !ctx->data) {
+		err = k_mem_slab_alloc(ctx_lib->mem_slab,
+				       &ctx->data,
+				       K_NO_WAIT);
+		if (!err) {
+			ctx->conn = conn;
 
-			} else {
-				break;
-			}
+			LOG_DBG("The memory for the connection context "
+				"has been allocated, conn %p, index: %u",
+				(void *)conn, i);
 
+			return ctx->data;
 		}
 	}
 
@@ -59,24 +53,23 @@ int bt_conn_ctx_free(struct bt_conn_ctx_lib *ctx_lib, struct bt_conn *conn)
 	__ASSERT_NO_MSG(conn != NULL);
 	__ASSERT_NO_MSG(ctx_lib != NULL);
 
-	k_mutex_lock(ctx_lib->mutex, K_FOREVER);
+	uint8_t i = bt_conn_index(conn);
+	struct bt_conn_ctx *ctx = &ctx_lib->ctx[i];
 
-	for (size_t i = 0; i < CONFIG_BT_MAX_CONN; i++) {
-		struct bt_conn_ctx *ctx = &ctx_lib->ctx[i];
+	k_mutex_lock(ctx_lib->mutex, K_FOREVER);
 
-		if (ctx->conn == conn) {
-			bt_conn_ctx_mem_free(ctx_lib->mem_slab, &ctx->data);
-			ctx->conn = NULL;
-			ctx->data = NULL;
+	if (ctx->conn == conn) {
+		bt_conn_ctx_mem_free(ctx_lib->mem_slab, &ctx->data);
+		ctx->conn = NULL;
+		ctx->data = NULL;
 
-			LOG_DBG("The context memory for the connection "
-				"has been released, conn %p index %u",
-				(void *)conn, i);
+		LOG_DBG("The context memory for the connection "
+			"has been released, conn %p index %u",
+			(void *)conn, i);
 
-			k_mutex_unlock(ctx_lib->mutex);
+		k_mutex_unlock(ctx_lib->mutex);
 
-			return 0;
-		}
+		return 0;
 	}
 
 	LOG_WRN("There is no allocated memory for this connection");
@@ -111,16 +104,14 @@ void *bt_conn_ctx_get(struct bt_conn_ctx_lib *ctx_lib, struct bt_conn *conn)
 	__ASSERT_NO_MSG(conn != NULL);
 	__ASSERT_NO_MSG(ctx_lib != NULL);
 
-	k_mutex_lock(ctx_lib->mutex, K_FOREVER);
+	struct bt_conn_ctx *ctx = &ctx_lib->ctx[bt_conn_index(conn)];
 
-	for (size_t i = 0; i < CONFIG_BT_MAX_CONN; i++) {
-		struct bt_conn_ctx *ctx = &ctx_lib->ctx[i];
+	k_mutex_lock(ctx_lib->mutex, K_FOREVER);
 
-		if (ctx->conn == conn) {
-			LOG_DBG("Memory block found for the connection");
+	if (ctx->conn == conn) {
+		LOG_DBG("Memory block found for the connection");
 
-			return ctx->data;
-		}
+		return ctx->data;
 	}
 
 	LOG_WRN("No memory block for connection");
@@ -153,15 +144,18 @@ void bt_conn_ctx_release(struct bt_conn_ctx_lib *ctx_lib, void *ctx_data)
 	__ASSERT_NO_MSG(ctx_lib != NULL);
 	__ASSERT_NO_MSG(ctx_data != NULL);
 
-	for (size_t i = 0; i < CONFIG_BT_MAX_CONN; i++) {
-		struct bt_conn_ctx *ctx = &ctx_lib->ctx[i];
-
-		if (ctx->data == ctx_data) {
-			k_mutex_unlock(ctx_lib->mutex);
+#if defined(CONFIG_ASSERT)
+	bool found = false;
 
-			return;
+	for (size_t i = 0; i < CONFIG_BT_MAX_CONN; i++) {
+		if (ctx_lib->ctx[i].data == ctx_data) {
+			found = true;
+			break;
 		}
 	}
 
-	__ASSERT_NO_MSG(false);
+	__ASSERT_NO_MSG(found);
+#endif
+
+	k_mutex_unlock(ctx_lib->mutex);
 }
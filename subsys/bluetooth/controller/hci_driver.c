@@ -224,18 +224,12 @@ static int hci_driver_send(struct net_buf *buf)
 	return err;
 }
 
-static void data_packet_process(uint8_t *hci_buf)
+static void data_packet_process(struct net_buf *data_buf)
 {
-	struct net_buf *data_buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_FOREVER);
-	struct bt_hci_acl_hdr *hdr = (void *)hci_buf;
+	struct bt_hci_acl_hdr *hdr = (void *)data_buf->data;
 	uint16_t hf, handle, len;
 	uint8_t flags, pb, bc;
 
-	if (!data_buf) {
-		BT_ERR("No data buffer available");
-		return;
-	}
-
 	len = sys_le16_to_cpu(hdr->len);
 	hf = sys_le16_to_cpu(hdr->handle);
 	handle = bt_acl_handle(hf);
@@ -246,7 +240,6 @@ static void data_packet_process(uint8_t *hci_buf)
 	BT_DBG("Data: handle (0x%02x), PB(%01d), BC(%01d), len(%u)", handle,
 	       pb, bc, len);
 
-	net_buf_add_mem(data_buf, &hci_buf[0], len + sizeof(*hdr));
 	bt_recv(data_buf);
 }
 
@@ -282,6 +275,100 @@ static bool event_packet_is_discardable(const uint8_t *hci_buf)
 	}
 }
 
+#if defined(CONFIG_SDC_ADV_REPORT_RATE_LIMIT)
+struct adv_report_entry {
+	uint32_t hash;
+	uint32_t time;
+};
+
+static struct adv_report_entry
+	adv_reports[CONFIG_SDC_ADV_REPORT_RATE_LIMIT_ENTRIES];
+static uint32_t rx_pressure_time;
+static bool rx_pressure;
+
+/* Hash of the report type and advertiser address of a report event, or 0 if
+ * the event is not a single advertising report.
+ */
+static uint32_t adv_report_hash(const uint8_t *hci_buf)
+{
+	const struct bt_hci_evt_hdr *hdr = (void *)hci_buf;
+	const uint8_t *id;
+	size_t id_len;
+	uint32_t hash = 2166136261U;
+
+	if (hdr->evt != BT_HCI_EVT_LE_META_EVENT || hci_buf[3] != 1) {
+		return 0;
+	}
+
+	/* Event type, address type and address follow the number of reports. */
+	switch (hci_buf[2]) {
+	case BT_HCI_EVT_LE_ADVERTISING_REPORT:
+		id_len = 1 + 1 + sizeof(bt_addr_t);
+		break;
+	case BT_HCI_EVT_LE_EXT_ADVERTISING_REPORT:
+		id_len = 2 + 1 + sizeof(bt_addr_t);
+		break;
+	default:
+		return 0;
+	}
+
+	if (hdr->len < 2 + id_len) {
+		return 0;
+	}
+
+	id = &hci_buf[4];
+
+	/* FNV-1a */
+	for (size_t i = 0; i < id_len; i++) {
+		hash = (hash ^ id[i]) * 16777619U;
+	}
+
+	return hash ? hash : 1;
+}
+
+static void adv_report_rx_pressure_set(void)
+{
+	rx_pressure = true;
+	rx_pressure_time = k_uptime_get_32();
+}
+
+/* Check whether a report from the same advertiser was passed to the host
+ * less than the rate limit interval ago, while buffers are short.
+ */
+static bool adv_report_is_rate_limited(const uint8_t *hci_buf)
+{
+	const uint32_t now = k_uptime_get_32();
+	struct adv_report_entry *entry;
+	uint32_t hash;
+
+	if (!rx_pressure) {
+		return false;
+	}
+
+	if ((now - rx_pressure_time) >= CONFIG_SDC_ADV_REPORT_RATE_LIMIT_INTERVAL) {
+		rx_pressure = false;
+		return false;
+	}
+
+	hash = adv_report_hash(hci_buf);
+	if (!hash) {
+		return false;
+	}
+
+	entry = &adv_reports[hash % ARRAY_SIZE(adv_reports)];
+
+	if (entry->hash == hash &&
+	    (now - entry->time) < CONFIG_SDC_ADV_REPORT_RATE_LIMIT_INTERVAL) {
+		return true;
+	}
+
+	entry->hash = hash;
+	entry->time = now;
+
+	return false;
+}
+#endif /* CONFIG_SDC_ADV_REPORT_RATE_LIMIT */
+
 static void event_packet_process(uint8_t *hci_buf)
 {
 	bool discardable = event_packet_is_discardable(hci_buf);
@@ -311,12 +398,22 @@ static void event_packet_process(uint8_t *hci_buf)
 		BT_DBG("Event (0x%02x) len %u", hdr->evt, hdr->len);
 	}
 
+#if defined(CONFIG_SDC_ADV_REPORT_RATE_LIMIT)
+	if (discardable && adv_report_is_rate_limited(hci_buf)) {
+		BT_DBG("Rate limiting advertising report");
+		return;
+	}
+#endif
+
 	evt_buf = bt_buf_get_evt(hdr->evt, discardable,
 				 discardable ? K_NO_WAIT : K_FOREVER);
 
 	if (!evt_buf) {
 		if (discardable) {
 			BT_DBG("Discarding event");
+#if defined(CONFIG_SDC_ADV_REPORT_RATE_LIMIT)
+			adv_report_rx_pressure_set();
+#endif
 			return;
 		}
 
@@ -348,11 +445,29 @@ static bool fetch_and_process_hci_evt(uint8_t *p_hci_buffer)
 
 static bool fetch_and_process_acl_data(uint8_t *p_hci_buffer)
 {
+	/* Buffer for the next data packet, kept while there is no data. */
+	static struct net_buf *data_buf;
+	struct bt_hci_acl_hdr *hdr;
+	uint8_t *dst;
 	int errcode;
 
+	if (!data_buf) {
+		data_buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_NO_WAIT);
+	}
+
+	/* Let the controller write straight into the buffer passed to the
+	 * host if the largest packet fits, so that it is not copied.
+	 */
+	if (data_buf &&
+	    net_buf_tailroom(data_buf) >= (sizeof(*hdr) + MAX_RX_PACKET_SIZE)) {
+		dst = net_buf_tail(data_buf);
+	} else {
+		dst = p_hci_buffer;
+	}
+
 	errcode = MULTITHREADING_LOCK_ACQUIRE();
 	if (!errcode) {
-		errcode = sdc_hci_data_get(p_hci_buffer);
+		errcode = sdc_hci_data_get(dst);
 		MULTITHREADING_LOCK_RELEASE();
 	}
 
@@ -360,7 +475,27 @@ static bool fetch_and_process_acl_data(uint8_t *p_hci_buffer)
 		return false;
 	}
 
-	data_packet_process(p_hci_buffer);
+	hdr = (void *)dst;
+
+	if (dst == p_hci_buffer) {
+		if (!data_buf) {
+			data_buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_FOREVER);
+		}
+
+		if (!data_buf) {
+			BT_ERR("No data buffer available");
+			return true;
+		}
+
+		net_buf_add_mem(data_buf, dst,
+				sys_le16_to_cpu(hdr->len) + sizeof(*hdr));
+	} else {
+		net_buf_add(data_buf, sys_le16_to_cpu(hdr->len) + sizeof(*hdr));
+	}
+
+	data_packet_process(data_buf);
+	data_buf = NULL;
+
 	return true;
 }
 
@@ -884,6 +884,10 @@ static void cmd_put(uint8_t *cmd_in, uint8_t * const raw_event_out)
 	uint8_t return_param_length = sizeof(struct bt_hci_evt_cmd_complete)
 				      + sizeof(struct bt_hci_evt_cc_status);
 
+	/* The opcodes of each group are dense, so the switch statements below
+	 * compile to jump tables. Return parameters are written directly to
+	 * the command complete event.
+	 */
 	switch (BT_OGF(opcode)) {
 #if defined(CONFIG_BT_CONN)
 	case BT_OGF_LINK_CTRL:
@@ -45,17 +45,78 @@ enum entry_tag {
 	ENTRY_TAG_SEQ = 's',
 };
 
+#if CONFIG_BT_ENOCEAN_DEFERRED_AUTH
+/* Advertising data received from a potential EnOcean device */
+struct telegram {
+	bt_addr_le_t addr;
+	int8_t rssi;
+	uint8_t len;
+	uint8_t data[BT_GAP_ADV_MAX_ADV_DATA_LEN];
+};
+#endif
+
 static struct bt_enocean_device devices[CONFIG_BT_ENOCEAN_DEVICES_MAX];
 static const struct bt_enocean_callbacks *cb;
 static struct k_work_delayable work;
 static bool commissioning;
 
+/* Address hash index of the active devices. Entries are device indexes + 1,
+ * with 0 terminating the chain.
+ */
+static uint16_t hash_head[CONFIG_BT_ENOCEAN_DEVICES_MAX];
+static uint16_t hash_next[CONFIG_BT_ENOCEAN_DEVICES_MAX];
+
+#if CONFIG_BT_ENOCEAN_DEFERRED_AUTH
+K_MSGQ_DEFINE(telegrams, sizeof(struct telegram),
+	      CONFIG_BT_ENOCEAN_DEFERRED_AUTH_QUEUE_SIZE, 4);
+static struct k_work auth_work;
+static struct telegram last_telegram;
+#endif
+
+static uint16_t *hash_bucket(const bt_addr_le_t *addr)
+{
+	uint32_t hash = addr->type;
+
+	for (int i = 0; i < ARRAY_SIZE(addr->a.val); ++i) {
+		hash = hash * 31 + addr->a.val[i];
+	}
+
+	return &hash_head[hash % ARRAY_SIZE(hash_head)];
+}
+
+static void hash_add(struct bt_enocean_device *dev)
+{
+	uint16_t *bucket = hash_bucket(&dev->addr);
+	int index = dev - &devices[0];
+
+	hash_next[index] = *bucket;
+	*bucket = index + 1;
+}
+
+static void hash_remove(struct bt_enocean_device *dev)
+{
+	uint16_t *entry = hash_bucket(&dev->addr);
+	int index = dev - &devices[0];
+
+	while (*entry) {
+		if (*entry == index + 1) {
+			*entry = hash_next[index];
+			return;
+		}
+
+		entry = &hash_next[*entry - 1];
+	}
+}
+
 static struct bt_enocean_device *device_find(const bt_addr_le_t *addr)
 {
-	for (int i = 0; i < ARRAY_SIZE(devices); ++i) {
-		if ((devices[i].flags & FLAG_ACTIVE) &&
-		    !bt_addr_le_cmp(addr, &devices[i].addr)) {
-			return &devices[i];
+	for (uint16_t entry = *hash_bucket(addr); entry;
+	     entry = hash_next[entry - 1]) {
+		struct bt_enocean_device *dev = &devices[entry - 1];
+
+		if ((dev->flags & FLAG_ACTIVE) &&
+		    !bt_addr_le_cmp(addr, &dev->addr)) {
+			return dev;
 		}
 	}
 
@@ -364,14 +425,9 @@ static void handle_sensor_data(const struct bt_le_scan_recv_info *info,
 	cb->sensor(dev, &data, opt_data, opt_data_len);
 }
 
-static void adv_recv(const struct bt_le_scan_recv_info *info,
-		     struct net_buf_simple *buf)
+static void adv_process(const struct bt_le_scan_recv_info *info,
+			struct net_buf_simple *buf)
 {
-	if (info->adv_type != BT_GAP_ADV_TYPE_ADV_NONCONN_IND || !info->addr ||
-	    info->addr->type != BT_ADDR_LE_RANDOM) {
-		return;
-	}
-
 	uint8_t *payload = buf->data;
 	uint8_t len = net_buf_simple_pull_u8(buf);
 	uint8_t type = net_buf_simple_pull_u8(buf);
@@ -434,6 +490,77 @@ static void adv_recv(const struct bt_le_scan_recv_info *info,
 	handle_sensor_data(info, buf, payload, len + 1 - SIGNATURE_LEN);
 }
 
+#if CONFIG_BT_ENOCEAN_DEFERRED_AUTH
+static void auth_process(struct k_work *work)
+{
+	struct telegram telegram;
+	struct net_buf_simple buf;
+	struct bt_le_scan_recv_info info = {
+		.addr = &telegram.addr,
+		.adv_type = BT_GAP_ADV_TYPE_ADV_NONCONN_IND,
+	};
+
+	/* Process all queued telegrams in one go. Telegrams for the same
+	 * device are queued in order, so the sequence number check drops
+	 * the ones that have already been authenticated before any
+	 * decryption is attempted.
+	 */
+	while (!k_msgq_get(&telegrams, &telegram, K_NO_WAIT)) {
+		info.rssi = telegram.rssi;
+		net_buf_simple_init_with_data(&buf, telegram.data,
+					      telegram.len);
+		adv_process(&info, &buf);
+	}
+}
+
+static void telegram_queue(const struct bt_le_scan_recv_info *info,
+			   const struct net_buf_simple *buf)
+{
+	struct telegram *telegram = &last_telegram;
+
+	if (buf->len > sizeof(telegram->data)) {
+		return;
+	}
+
+	/* EnOcean devices send every telegram several times. Skip the
+	 * repetitions of the telegram that was queued last.
+	 */
+	if (telegram->len == buf->len &&
+	    !bt_addr_le_cmp(&telegram->addr, info->addr) &&
+	    !memcmp(telegram->data, buf->data, buf->len)) {
+		return;
+	}
+
+	bt_addr_le_copy(&telegram->addr, info->addr);
+	telegram->rssi = info->rssi;
+	telegram->len = buf->len;
+	memcpy(telegram->data, buf->data, buf->len);
+
+	if (k_msgq_put(&telegrams, telegram, K_NO_WAIT)) {
+		BT_WARN("Telegram queue full");
+		telegram->len = 0;
+		return;
+	}
+
+	k_work_submit(&auth_work);
+}
+#endif
+
+static void adv_recv(const struct bt_le_scan_recv_info *info,
+		     struct net_buf_simple *buf)
+{
+	if (info->adv_type != BT_GAP_ADV_TYPE_ADV_NONCONN_IND || !info->addr ||
+	    info->addr->type != BT_ADDR_LE_RANDOM) {
+		return;
+	}
+
+#if CONFIG_BT_ENOCEAN_DEFERRED_AUTH
+	telegram_queue(info, buf);
+#else
+	adv_process(info, buf);
+#endif
+}
+
 static void store_dirty(struct k_work *work)
 {
 	int err;
@@ -487,9 +614,14 @@ static int settings_set(const char *key, size_t len, settings_read_cb read_cb,
 			return -EINVAL;
 		}
 
+		if (dev->flags & FLAG_ACTIVE) {
+			hash_remove(dev);
+		}
+
 		bt_addr_le_copy(&dev->addr, &entry.addr);
 		memcpy(dev->key, entry.key, sizeof(dev->key));
 		dev->flags |= FLAG_ACTIVE;
+		hash_add(dev);
 
 		BT_DBG("Loaded %s", bt_addr_le_str(&dev->addr));
 		return 0;
@@ -533,6 +665,10 @@ void bt_enocean_init(const struct bt_enocean_callbacks *callbacks)
 		k_work_init_delayable(&work, store_dirty);
 	}
 
+#if CONFIG_BT_ENOCEAN_DEFERRED_AUTH
+	k_work_init(&auth_work, auth_process);
+#endif
+
 	cb = callbacks;
 
 	process_loaded_devs();
@@ -570,6 +706,7 @@ int bt_enocean_commission(const bt_addr_le_t *addr, const uint8_t key[16],
 	}
 
 	dev->flags |= FLAG_ACTIVE;
+	hash_add(dev);
 
 	if (cb->commissioned) {
 		cb->commissioned(dev);
@@ -603,6 +740,10 @@ void bt_enocean_decommission(struct bt_enocean_device *dev)
 		settings_delete(name);
 	}
 
+	if (dev->flags & FLAG_ACTIVE) {
+		hash_remove(dev);
+	}
+
 	dev->flags = 0;
 }
 
@@ -10,6 +10,10 @@
 
 #include <bluetooth/gatt_dm.h>
 
+#if CONFIG_BT_GATT_DM_CACHE
+#include <settings/settings.h>
+#endif
+
 LOG_MODULE_REGISTER(bt_gatt_dm, CONFIG_BT_GATT_DM_LOG_LEVEL);
 
 /* Available sizes: 128, 512, 2048... */
@@ -22,6 +26,29 @@ LOG_MODULE_REGISTER(bt_gatt_dm, CONFIG_BT_GATT_DM_LOG_LEVEL);
 BUILD_ASSERT(sizeof(struct bt_gatt_service_val) % DATA_ALIGN == 0);
 BUILD_ASSERT(sizeof(struct bt_gatt_chrc) % DATA_ALIGN == 0);
 
+#if CONFIG_BT_GATT_DM_CACHE
+#define CACHE_SETTINGS_ROOT "bt_dm"
+#define CACHE_VERSION 1
+#define DB_HASH_LEN 16
+#define UUID_VAL_MAX_LEN 16
+
+/* "bt_dm/" + address and its type in hex + "/" + UUID value in hex */
+#define CACHE_KEY_LEN (sizeof(CACHE_SETTINGS_ROOT) + \
+		       2 * (sizeof(bt_addr_t) + 1) + 1 + 2 * UUID_VAL_MAX_LEN + 1)
+
+/* Encoded UUID: type followed by up to 16 bytes of value */
+#define CACHE_UUID_MAX_LEN (1 + UUID_VAL_MAX_LEN)
+/* Encoded attribute: handle, permissions and UUID followed by
+ * the end or value handle, properties and UUID of a service
+ * or a characteristic.
+ */
+#define CACHE_ATTR_MAX_LEN (2 * (sizeof(uint16_t) + CACHE_UUID_MAX_LEN) + 2)
+/* Header: version, Database Hash and attribute count */
+#define CACHE_HDR_LEN (1 + DB_HASH_LEN + sizeof(uint16_t))
+#define CACHE_DATA_MAX_LEN (CACHE_HDR_LEN + \
+			    CONFIG_BT_GATT_DM_MAX_ATTRS * CACHE_ATTR_MAX_LEN)
+#endif /* CONFIG_BT_GATT_DM_CACHE */
+
 /* Flags for parsed attribute array state */
 enum {
 	STATE_ATTRS_LOCKED,
@@ -50,6 +77,12 @@ struct bt_gatt_dm {
 	struct bt_gatt_dm_attr attrs[CONFIG_BT_GATT_DM_MAX_ATTRS];
 	/* Currently accessed attribute */
 	size_t cur_attr_id;
+	/* Attribute of the service currently being discovered */
+	size_t svc_attr_id;
+	/* UUIDs of the services looked for by a multi-service discovery */
+	struct bt_uuid *svc_uuids[CONFIG_BT_GATT_DM_MAX_SVC_UUIDS];
+	/* Number of UUIDs in svc_uuids, zero for a single service discovery */
+	size_t svc_uuid_cnt;
 	/* Flags with the status of the attributes */
 	ATOMIC_DEFINE(state_flags, STATE_NUM);
 
@@ -60,6 +93,17 @@ struct bt_gatt_dm {
 
 	/* The pointer to callback structure */
 	const struct bt_gatt_dm_cb *callback;
+
+#if CONFIG_BT_GATT_DM_CACHE
+	/* UUID of the service looked up in the cache */
+	const struct bt_uuid *cache_uuid;
+	/* Parameters of the Database Hash read */
+	struct bt_gatt_read_params db_hash_params;
+	/* Database Hash of the peer */
+	uint8_t db_hash[DB_HASH_LEN];
+	/* The Database Hash was read and the result can be cached */
+	bool db_hash_valid;
+#endif
 };
 
 /* Currently only one instance is supported */
@@ -236,9 +280,364 @@ static struct bt_gatt_dm_attr *attr_find_by_handle(
 	return NULL;
 }
 
+#if CONFIG_BT_GATT_DM_CACHE
+static bool cache_peer_get(struct bt_conn *conn, bt_addr_le_t *addr)
+{
+	struct bt_conn_info info;
+
+	if (bt_conn_get_info(conn, &info) || (info.type != BT_CONN_TYPE_LE)) {
+		return false;
+	}
+
+	if (!bt_addr_le_is_bonded(info.id, info.le.dst)) {
+		return false;
+	}
+
+	bt_addr_le_copy(addr, info.le.dst);
+
+	return true;
+}
+
+static int cache_key_get(struct bt_gatt_dm *dm, char *key, size_t key_len)
+{
+	bt_addr_le_t addr;
+	const struct bt_uuid *uuid = dm->cache_uuid;
+	const void *uuid_val;
+	size_t uuid_len;
+	size_t pos;
+
+	if (!uuid || !cache_peer_get(dm->conn, &addr)) {
+		return -ENOENT;
+	}
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		uuid_val = &BT_UUID_16(uuid)->val;
+		uuid_len = sizeof(BT_UUID_16(uuid)->val);
+		break;
+	case BT_UUID_TYPE_128:
+		uuid_val = BT_UUID_128(uuid)->val;
+		uuid_len = sizeof(BT_UUID_128(uuid)->val);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	pos = snprintk(key, key_len, CACHE_SETTINGS_ROOT "/");
+	pos += bin2hex(addr.a.val, sizeof(addr.a.val), &key[pos], key_len - pos);
+	pos += bin2hex(&addr.type, sizeof(addr.type), &key[pos], key_len - pos);
+	key[pos++] = '/';
+	pos += bin2hex(uuid_val, uuid_len, &key[pos], key_len - pos);
+
+	return (pos < key_len) ? 0 : -ENOMEM;
+}
+
+static void cache_uuid_encode(struct net_buf_simple *buf,
+			      const struct bt_uuid *uuid)
+{
+	net_buf_simple_add_u8(buf, uuid->type);
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		net_buf_simple_add_le16(buf, BT_UUID_16(uuid)->val);
+		break;
+	case BT_UUID_TYPE_32:
+		net_buf_simple_add_le32(buf, BT_UUID_32(uuid)->val);
+		break;
+	case BT_UUID_TYPE_128:
+		net_buf_simple_add_mem(buf, BT_UUID_128(uuid)->val,
+				       sizeof(BT_UUID_128(uuid)->val));
+		break;
+	default:
+		break;
+	}
+}
+
+static int cache_uuid_decode(struct net_buf_simple *buf,
+			     struct bt_uuid_128 *uuid)
+{
+	size_t len;
+
+	if (buf->len < 1) {
+		return -EINVAL;
+	}
+
+	switch (net_buf_simple_pull_u8(buf)) {
+	case BT_UUID_TYPE_16:
+		len = sizeof(uint16_t);
+		break;
+	case BT_UUID_TYPE_32:
+		len = sizeof(uint32_t);
+		break;
+	case BT_UUID_TYPE_128:
+		len = UUID_VAL_MAX_LEN;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if ((buf->len < len) ||
+	    !bt_uuid_create(&uuid->uuid, net_buf_simple_pull_mem(buf, len),
+			    len)) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int cache_attr_encode(struct net_buf_simple *buf,
+			     const struct bt_gatt_dm_attr *attr)
+{
+	const struct bt_gatt_service_val *service_val =
+		bt_gatt_dm_attr_service_val(attr);
+	const struct bt_gatt_chrc *chrc = bt_gatt_dm_attr_chrc_val(attr);
+
+	net_buf_simple_add_le16(buf, attr->handle);
+	net_buf_simple_add_u8(buf, attr->perm);
+	cache_uuid_encode(buf, attr->uuid);
+
+	if (service_val) {
+		net_buf_simple_add_le16(buf, service_val->end_handle);
+		cache_uuid_encode(buf, service_val->uuid);
+	} else if (chrc) {
+		if (!chrc->uuid) {
+			/* Characteristic declaration was not read. */
+			return -EINVAL;
+		}
+
+		net_buf_simple_add_le16(buf, chrc->value_handle);
+		net_buf_simple_add_u8(buf, chrc->properties);
+		cache_uuid_encode(buf, chrc->uuid);
+	}
+
+	return 0;
+}
+
+static int cache_attr_decode(struct bt_gatt_dm *dm, struct net_buf_simple *buf)
+{
+	struct bt_uuid_128 uuid;
+	struct bt_uuid_128 val_uuid;
+	struct bt_gatt_attr attr = {
+		.uuid = &uuid.uuid,
+	};
+	struct bt_gatt_dm_attr *cur_attr;
+
+	if (buf->len < (sizeof(uint16_t) + sizeof(uint8_t))) {
+		return -EINVAL;
+	}
+
+	attr.handle = net_buf_simple_pull_le16(buf);
+	attr.perm = net_buf_simple_pull_u8(buf);
+
+	if (cache_uuid_decode(buf, &uuid)) {
+		return -EINVAL;
+	}
+
+	if ((bt_uuid_cmp(attr.uuid, BT_UUID_GATT_PRIMARY) == 0) ||
+	    (bt_uuid_cmp(attr.uuid, BT_UUID_GATT_SECONDARY) == 0)) {
+		struct bt_gatt_service_val *service_val;
+
+		if (buf->len < sizeof(uint16_t)) {
+			return -EINVAL;
+		}
+
+		cur_attr = attr_store(dm, &attr, sizeof(*service_val));
+		if (!cur_attr) {
+			return -ENOMEM;
+		}
+
+		service_val = bt_gatt_dm_attr_service_val(cur_attr);
+		service_val->end_handle = net_buf_simple_pull_le16(buf);
+		if (cache_uuid_decode(buf, &val_uuid)) {
+			return -EINVAL;
+		}
+
+		service_val->uuid = uuid_store(dm, &val_uuid.uuid);
+		if (!service_val->uuid) {
+			return -ENOMEM;
+		}
+	} else if (bt_uuid_cmp(attr.uuid, BT_UUID_GATT_CHRC) == 0) {
+		struct bt_gatt_chrc *chrc;
+
+		if (buf->len < (sizeof(uint16_t) + sizeof(uint8_t))) {
+			return -EINVAL;
+		}
+
+		cur_attr = attr_store(dm, &attr, sizeof(*chrc));
+		if (!cur_attr) {
+			return -ENOMEM;
+		}
+
+		chrc = bt_gatt_dm_attr_chrc_val(cur_attr);
+		chrc->value_handle = net_buf_simple_pull_le16(buf);
+		chrc->properties = net_buf_simple_pull_u8(buf);
+		if (cache_uuid_decode(buf, &val_uuid)) {
+			return -EINVAL;
+		}
+
+		chrc->uuid = uuid_store(dm, &val_uuid.uuid);
+		if (!chrc->uuid) {
+			return -ENOMEM;
+		}
+	} else {
+		cur_attr = attr_store(dm, &attr, 0);
+		if (!cur_attr) {
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+static void cache_store(struct bt_gatt_dm *dm)
+{
+	char key[CACHE_KEY_LEN];
+	struct net_buf_simple buf;
+	uint8_t *data;
+	int err;
+
+	if (!dm->db_hash_valid) {
+		return;
+	}
+
+	/* Only the result of the discovery started for the cached UUID
+	 * is stored, not the services found with bt_gatt_dm_continue().
+	 */
+	dm->db_hash_valid = false;
+
+	if (cache_key_get(dm, key, sizeof(key))) {
+		return;
+	}
+
+	data = k_malloc(CACHE_DATA_MAX_LEN);
+	if (!data) {
+		LOG_WRN("No memory to cache the discovery result");
+		return;
+	}
+
+	net_buf_simple_init_with_data(&buf, data, CACHE_DATA_MAX_LEN);
+	net_buf_simple_reset(&buf);
+
+	net_buf_simple_add_u8(&buf, CACHE_VERSION);
+	net_buf_simple_add_mem(&buf, dm->db_hash, sizeof(dm->db_hash));
+	net_buf_simple_add_le16(&buf, dm->cur_attr_id);
+
+	for (size_t i = 0; i < dm->cur_attr_id; i++) {
+		err = cache_attr_encode(&buf, &dm->attrs[i]);
+		if (err) {
+			goto out;
+		}
+	}
+
+	err = settings_save_one(key, buf.data, buf.len);
+	if (err) {
+		LOG_WRN("Failed to cache the discovery result (err %d)", err);
+	} else {
+		LOG_DBG("Discovery result cached as %s", log_strdup(key));
+	}
+
+out:
+	k_free(data);
+}
+
+static int cache_load_cb(const char *key, size_t len, settings_read_cb read_cb,
+			 void *cb_arg, void *param)
+{
+	struct bt_gatt_dm *dm = param;
+	const struct bt_gatt_service_val *service_val;
+	struct net_buf_simple buf;
+	uint8_t *data;
+	uint16_t attr_cnt;
+	ssize_t read_len;
+	int err = -EINVAL;
+
+	if ((settings_name_next(key, NULL) != 0) || (len < CACHE_HDR_LEN)) {
+		return 0;
+	}
+
+	data = k_malloc(len);
+	if (!data) {
+		return 0;
+	}
+
+	read_len = read_cb(cb_arg, data, len);
+	if (read_len != len) {
+		goto out;
+	}
+
+	net_buf_simple_init_with_data(&buf, data, len);
+
+	if ((net_buf_simple_pull_u8(&buf) != CACHE_VERSION) ||
+	    memcmp(net_buf_simple_pull_mem(&buf, DB_HASH_LEN), dm->db_hash,
+		   DB_HASH_LEN)) {
+		LOG_DBG("Cached discovery result is outdated");
+		goto out;
+	}
+
+	attr_cnt = net_buf_simple_pull_le16(&buf);
+	for (size_t i = 0; i < attr_cnt; i++) {
+		err = cache_attr_decode(dm, &buf);
+		if (err) {
+			goto out;
+		}
+	}
+
+	/* The cached attributes must describe the requested service. */
+	service_val = dm->cur_attr_id ?
+		bt_gatt_dm_attr_service_val(&dm->attrs[0]) : NULL;
+
+	if (!service_val ||
+	    bt_uuid_cmp(service_val->uuid, dm->cache_uuid)) {
+		err = -EINVAL;
+	}
+
+out:
+	if (err) {
+		/* Memory allocated for the attributes is released
+		 * together with the discovery data.
+		 */
+		dm->cur_attr_id = 0;
+	}
+
+	k_free(data);
+
+	/* Stop loading, the key was found. */
+	return 1;
+}
+
+static bool cache_load(struct bt_gatt_dm *dm)
+{
+	char key[CACHE_KEY_LEN];
+	int err;
+
+	if (cache_key_get(dm, key, sizeof(key))) {
+		return false;
+	}
+
+	dm->cur_attr_id = 0;
+	err = settings_load_subtree_direct(key, cache_load_cb, dm);
+	if (err || !dm->cur_attr_id) {
+		return false;
+	}
+
+	LOG_DBG("Discovery result restored from %s", log_strdup(key));
+
+	/* Leave the discovery parameters as a completed discovery would. */
+	dm->discover_params.uuid = NULL;
+	dm->discover_params.start_handle = dm->attrs[0].handle + 1;
+	dm->discover_params.end_handle =
+		bt_gatt_dm_attr_service_val(&dm->attrs[0])->end_handle;
+
+	return true;
+}
+#endif /* CONFIG_BT_GATT_DM_CACHE */
+
 static void discovery_complete(struct bt_gatt_dm *dm)
 {
 	LOG_DBG("Discovery complete.");
+#if CONFIG_BT_GATT_DM_CACHE
+	cache_store(dm);
+#endif
 	atomic_set_bit(dm->state_flags, STATE_ATTRS_RELEASE_PENDING);
 	if (dm->callback->completed) {
 		dm->callback->completed(dm, dm->context);
@@ -266,6 +665,92 @@ static void discovery_complete_error(struct bt_gatt_dm *dm, int err)
 	}
 }
 
+#if CONFIG_BT_GATT_DM_CACHE
+static uint8_t db_hash_read_cb(struct bt_conn *conn, uint8_t err,
+			       struct bt_gatt_read_params *params,
+			       const void *data, uint16_t length)
+{
+	struct bt_gatt_dm *dm = &bt_gatt_dm_inst;
+	int ret;
+
+	if (!err && data && (length == DB_HASH_LEN)) {
+		memcpy(dm->db_hash, data, DB_HASH_LEN);
+		dm->db_hash_valid = true;
+
+		if (cache_load(dm)) {
+			/* Nothing changed since the result was cached. */
+			dm->db_hash_valid = false;
+			discovery_complete(dm);
+			return BT_GATT_ITER_STOP;
+		}
+	} else {
+		LOG_DBG("Database Hash not available (err %u)", err);
+	}
+
+	ret = bt_gatt_discover(dm->conn, &dm->discover_params);
+	if (ret) {
+		LOG_ERR("Discover failed, error: %d.", ret);
+		discovery_complete_error(dm, ret);
+	}
+
+	return BT_GATT_ITER_STOP;
+}
+
+static int db_hash_read(struct bt_gatt_dm *dm)
+{
+	bt_addr_le_t addr;
+
+	if (!dm->cache_uuid || !cache_peer_get(dm->conn, &addr)) {
+		return -ENOENT;
+	}
+
+	dm->db_hash_params.func = db_hash_read_cb;
+	dm->db_hash_params.handle_count = 0;
+	dm->db_hash_params.by_uuid.start_handle = 0x0001;
+	dm->db_hash_params.by_uuid.end_handle = 0xffff;
+	dm->db_hash_params.by_uuid.uuid = BT_UUID_GATT_DB_HASH;
+
+	return bt_gatt_read(dm->conn, &dm->db_hash_params);
+}
+#endif /* CONFIG_BT_GATT_DM_CACHE */
+
+static bool multi_svc_uuid_match(const struct bt_gatt_dm *dm,
+				 const struct bt_uuid *uuid)
+{
+	for (size_t i = 0; i < dm->svc_uuid_cnt; i++) {
+		if (!bt_uuid_cmp(dm->svc_uuids[i], uuid)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Continues a multi-service discovery after the current service. */
+static void discovery_next_service(struct bt_gatt_dm *dm)
+{
+	const struct bt_gatt_service_val *service_val =
+		bt_gatt_dm_attr_service_val(&dm->attrs[dm->svc_attr_id]);
+	int err;
+
+	if (service_val->end_handle == 0xffff) {
+		discovery_complete(dm);
+		return;
+	}
+
+	dm->discover_params.uuid         = NULL;
+	dm->discover_params.type         = BT_GATT_DISCOVER_PRIMARY;
+	dm->discover_params.start_handle = service_val->end_handle + 1;
+	dm->discover_params.end_handle   = 0xffff;
+	LOG_DBG("Continuing primary service discovery");
+	err = bt_gatt_discover(dm->conn, &(dm->discover_params));
+
+	if (err) {
+		LOG_ERR("Discover failed, error: %d.", err);
+		discovery_complete_error(dm, err);
+	}
+}
+
 static uint8_t discovery_process_service(struct bt_gatt_dm *dm,
 				      const struct bt_gatt_attr *attr,
 				      struct bt_gatt_discover_params *params)
@@ -273,11 +758,24 @@ static uint8_t discovery_process_service(struct bt_gatt_dm *dm,
 	int err;
 
 	if (!attr) {
-		discovery_complete_not_found(dm);
+		if (dm->svc_uuid_cnt && dm->cur_attr_id) {
+			discovery_complete(dm);
+		} else {
+			discovery_complete_not_found(dm);
+		}
 		return BT_GATT_ITER_STOP;
 	}
 
 	struct bt_gatt_service_val *service_val = attr->user_data;
+
+	if (dm->svc_uuid_cnt &&
+	    !multi_svc_uuid_match(dm, service_val->uuid)) {
+		/* Not one of the requested services, skip it. */
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	dm->svc_attr_id = dm->cur_attr_id;
+
 	struct bt_gatt_dm_attr *cur_attr =
 		attr_store(dm, attr, sizeof(*service_val));
 
@@ -337,10 +835,10 @@ static uint8_t discovery_process_attribute(struct bt_gatt_dm *dm,
 	struct bt_gatt_dm_attr *cur_attr;
 
 	if (!attr) {
-		if (dm->cur_attr_id > 1) {
+		if (dm->cur_attr_id > (dm->svc_attr_id + 1)) {
 			LOG_DBG("Starting characteristic discovery");
 			dm->discover_params.start_handle =
-				dm->attrs[0].handle + 1;
+				dm->attrs[dm->svc_attr_id].handle + 1;
 			dm->discover_params.type =
 				BT_GATT_DISCOVER_CHARACTERISTIC;
 			int err = bt_gatt_discover(dm->conn,
@@ -352,6 +850,8 @@ static uint8_t discovery_process_attribute(struct bt_gatt_dm *dm,
 					err);
 				discovery_complete_error(dm, err);
 			}
+		} else if (dm->svc_uuid_cnt) {
+			discovery_next_service(dm);
 		} else {
 			discovery_complete(dm);
 		}
@@ -388,7 +888,11 @@ static uint8_t discovery_process_characteristic(
 	struct bt_gatt_chrc *cur_gatt_chrc;
 
 	if (!attr) {
-		discovery_complete(dm);
+		if (dm->svc_uuid_cnt) {
+			discovery_next_service(dm);
+		} else {
+			discovery_complete(dm);
+		}
 		return BT_GATT_ITER_STOP;
 	}
 
@@ -488,6 +992,45 @@ const struct bt_gatt_dm_attr *bt_gatt_dm_service_get(
 	return &(dm->attrs[0]);
 }
 
+const struct bt_gatt_dm_attr *bt_gatt_dm_service_next(
+	const struct bt_gatt_dm *dm,
+	const struct bt_gatt_dm_attr *prev)
+{
+	const struct bt_gatt_dm_attr *curr = prev;
+
+	if (!prev) {
+		/* The first attribute is always a service. */
+		return dm->cur_attr_id ? dm->attrs : NULL;
+	}
+
+	while ((curr = bt_gatt_dm_attr_next(dm, curr)) != NULL) {
+		if (bt_gatt_dm_attr_service_val(curr)) {
+			return curr;
+		}
+	}
+
+	return NULL;
+}
+
+const struct bt_gatt_dm_attr *bt_gatt_dm_service_by_uuid(
+	const struct bt_gatt_dm *dm,
+	const struct bt_uuid *uuid)
+{
+	const struct bt_gatt_dm_attr *curr = NULL;
+
+	while ((curr = bt_gatt_dm_service_next(dm, curr)) != NULL) {
+		struct bt_gatt_service_val *service_val =
+			bt_gatt_dm_attr_service_val(curr);
+
+		__ASSERT_NO_MSG(service_val != NULL);
+		if (!bt_uuid_cmp(uuid, service_val->uuid)) {
+			return curr;
+		}
+	}
+
+	return NULL;
+}
+
 const struct bt_gatt_dm_attr *bt_gatt_dm_char_next(
 	const struct bt_gatt_dm *dm,
 	const struct bt_gatt_dm_attr *prev)
@@ -582,12 +1125,53 @@ const struct bt_gatt_dm_attr *bt_gatt_dm_desc_next(
 	return curr;
 }
 
+static void dm_init(struct bt_gatt_dm *dm, struct bt_conn *conn,
+		    const struct bt_gatt_dm_cb *cb, void *context)
+{
+	dm->conn = conn;
+	dm->context = context;
+	dm->callback = cb;
+	dm->cur_attr_id = 0;
+	dm->svc_attr_id = 0;
+	dm->svc_uuid_cnt = 0;
+	sys_slist_init(&dm->chunk_list);
+	dm->cur_chunk_len = 0;
+
+	dm->discover_params.func = discovery_callback;
+	dm->discover_params.start_handle = 0x0001;
+	dm->discover_params.end_handle = 0xffff;
+	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
+}
+
+static int discovery_start(struct bt_gatt_dm *dm)
+{
+	int err;
+
+#if CONFIG_BT_GATT_DM_CACHE
+	/* For bonded peers, the Database Hash is read first to check
+	 * if a cached discovery result can be used.
+	 */
+	dm->cache_uuid = dm->discover_params.uuid;
+	dm->db_hash_valid = false;
+	if (!db_hash_read(dm)) {
+		return 0;
+	}
+#endif
+
+	err = bt_gatt_discover(dm->conn, &dm->discover_params);
+	if (err) {
+		LOG_ERR("Discover failed, error: %d.", err);
+		atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
+	}
+
+	return err;
+}
+
 int bt_gatt_dm_start(struct bt_conn *conn,
 		     const struct bt_uuid *svc_uuid,
 		     const struct bt_gatt_dm_cb *cb,
 		     void *context)
 {
-	int err;
 	struct bt_gatt_dm *dm;
 
 	if (svc_uuid &&
@@ -606,26 +1190,62 @@ int bt_gatt_dm_start(struct bt_conn *conn,
 		return -EALREADY;
 	}
 
-	dm->conn = conn;
-	dm->context = context;
-	dm->callback = cb;
-	dm->cur_attr_id = 0;
-	sys_slist_init(&dm->chunk_list);
-	dm->cur_chunk_len = 0;
+	dm_init(dm, conn, cb, context);
 
 	dm->discover_params.uuid = svc_uuid ? uuid_store(dm, svc_uuid) : NULL;
-	dm->discover_params.func = discovery_callback;
-	dm->discover_params.start_handle = 0x0001;
-	dm->discover_params.end_handle = 0xffff;
-	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
 
-	err = bt_gatt_discover(conn, &dm->discover_params);
-	if (err) {
-		LOG_ERR("Discover failed, error: %d.", err);
-		atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
+	return discovery_start(dm);
+}
+
+int bt_gatt_dm_start_multi(struct bt_conn *conn,
+			   const struct bt_uuid *const *svc_uuids,
+			   size_t svc_uuid_cnt,
+			   const struct bt_gatt_dm_cb *cb,
+			   void *context)
+{
+	struct bt_gatt_dm *dm;
+
+	if (!svc_uuids || !svc_uuid_cnt ||
+	    (svc_uuid_cnt > CONFIG_BT_GATT_DM_MAX_SVC_UUIDS)) {
+		return -EINVAL;
 	}
 
-	return err;
+	for (size_t i = 0; i < svc_uuid_cnt; i++) {
+		if (!svc_uuids[i] ||
+		    ((svc_uuids[i]->type != BT_UUID_TYPE_16) &&
+		     (svc_uuids[i]->type != BT_UUID_TYPE_128))) {
+			return -EINVAL;
+		}
+	}
+
+	if (!cb) {
+		return -EINVAL;
+	}
+
+	dm = &bt_gatt_dm_inst;
+
+	if (atomic_test_and_set_bit(dm->state_flags, STATE_ATTRS_LOCKED)) {
+		return -EALREADY;
+	}
+
+	dm_init(dm, conn, cb, context);
+
+	for (size_t i = 0; i < svc_uuid_cnt; i++) {
+		dm->svc_uuids[i] = uuid_store(dm, svc_uuids[i]);
+		if (!dm->svc_uuids[i]) {
+			svc_attr_memory_release(dm);
+			atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
+			return -ENOMEM;
+		}
+	}
+
+	/* All primary services are walked once and the requested ones
+	 * are picked by the discovery callback.
+	 */
+	dm->svc_uuid_cnt = svc_uuid_cnt;
+	dm->discover_params.uuid = NULL;
+
+	return discovery_start(dm);
 }
 
 int bt_gatt_dm_continue(struct bt_gatt_dm *dm, void *context)
@@ -656,6 +1276,7 @@ int bt_gatt_dm_continue(struct bt_gatt_dm *dm, void *context)
 	}
 
 	dm->context = context;
+	dm->svc_uuid_cnt = 0;
 	dm->discover_params.start_handle = dm->discover_params.end_handle + 1;
 	dm->discover_params.end_handle = 0xffff;
 	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
@@ -5,6 +5,7 @@
  */
 
 #include <errno.h>
+#include <sys/math_extras.h>
 #include <bluetooth/gatt_pool.h>
 #include <logging/log.h>
 
@@ -14,36 +15,65 @@ LOG_MODULE_REGISTER(bt_gatt_pool, CONFIG_BT_GATT_POOL_LOG_LEVEL);
 struct svc_el_pool {
 	void *elements;
 	atomic_t *locks;
+	/* Reference counters of shared elements, NULL if not shared. */
+	uint8_t *refs;
+	/* Hashes of shared elements, used to find duplicates quickly. */
+	uint8_t *hashes;
+	size_t el_size;
+	size_t el_cnt;
+	const char *name;
+#if CONFIG_BT_GATT_POOL_STATS != 0
+	atomic_t used;
+	atomic_t peak;
+#endif
 };
 
 #if CONFIG_BT_GATT_UUID16_POOL_SIZE != 0
 static struct bt_uuid_16 uuid_16_tab[CONFIG_BT_GATT_UUID16_POOL_SIZE];
 static ATOMIC_DEFINE(uuid_16_locks, ARRAY_SIZE(uuid_16_tab));
+static uint8_t uuid_16_refs[ARRAY_SIZE(uuid_16_tab)];
+static uint8_t uuid_16_hashes[ARRAY_SIZE(uuid_16_tab)];
 #define BT_UUID_16_TAB uuid_16_tab
 #define BT_UUID_16_LOCKS uuid_16_locks
+#define BT_UUID_16_REFS uuid_16_refs
+#define BT_UUID_16_HASHES uuid_16_hashes
 #else
 #define BT_UUID_16_TAB NULL
 #define BT_UUID_16_LOCKS NULL
+#define BT_UUID_16_REFS NULL
+#define BT_UUID_16_HASHES NULL
 #endif
 
 #if CONFIG_BT_GATT_UUID32_POOL_SIZE != 0
 static struct bt_uuid_32 uuid_32_tab[CONFIG_BT_GATT_UUID32_POOL_SIZE];
 static ATOMIC_DEFINE(uuid_32_locks, ARRAY_SIZE(uuid_32_tab));
+static uint8_t uuid_32_refs[ARRAY_SIZE(uuid_32_tab)];
+static uint8_t uuid_32_hashes[ARRAY_SIZE(uuid_32_tab)];
 #define BT_UUID_32_TAB uuid_32_tab
 #define BT_UUID_32_LOCKS uuid_32_locks
+#define BT_UUID_32_REFS uuid_32_refs
+#define BT_UUID_32_HASHES uuid_32_hashes
 #else
 #define BT_UUID_32_TAB NULL
 #define BT_UUID_32_LOCKS NULL
+#define BT_UUID_32_REFS NULL
+#define BT_UUID_32_HASHES NULL
 #endif
 
 #if CONFIG_BT_GATT_UUID128_POOL_SIZE != 0
 static struct bt_uuid_128 uuid_128_tab[CONFIG_BT_GATT_UUID128_POOL_SIZE];
 static ATOMIC_DEFINE(uuid_128_locks, ARRAY_SIZE(uuid_128_tab));
+static uint8_t uuid_128_refs[ARRAY_SIZE(uuid_128_tab)];
+static uint8_t uuid_128_hashes[ARRAY_SIZE(uuid_128_tab)];
 #define BT_UUID_128_TAB uuid_128_tab
 #define BT_UUID_128_LOCKS uuid_128_locks
+#define BT_UUID_128_REFS uuid_128_refs
+#define BT_UUID_128_HASHES uuid_128_hashes
 #else
 #define BT_UUID_128_TAB NULL
 #define BT_UUID_128_LOCKS NULL
+#define BT_UUID_128_REFS NULL
+#define BT_UUID_128_HASHES NULL
 #endif
 
 #if CONFIG_BT_GATT_CHRC_POOL_SIZE != 0
@@ -59,20 +89,41 @@ static ATOMIC_DEFINE(chrc_locks, ARRAY_SIZE(chrc_tab));
 static struct svc_el_pool uuid_16_pool = {
 	.elements = BT_UUID_16_TAB,
 	.locks = BT_UUID_16_LOCKS,
+	.refs = BT_UUID_16_REFS,
+	.hashes = BT_UUID_16_HASHES,
+	.el_size = sizeof(struct bt_uuid_16),
+	.el_cnt = CONFIG_BT_GATT_UUID16_POOL_SIZE,
+	.name = "UUID16",
 };
 static struct svc_el_pool uuid_32_pool = {
 	.elements = BT_UUID_32_TAB,
 	.locks = BT_UUID_32_LOCKS,
+	.refs = BT_UUID_32_REFS,
+	.hashes = BT_UUID_32_HASHES,
+	.el_size = sizeof(struct bt_uuid_32),
+	.el_cnt = CONFIG_BT_GATT_UUID32_POOL_SIZE,
+	.name = "UUID32",
 };
 static struct svc_el_pool uuid_128_pool = {
 	.elements = BT_UUID_128_TAB,
 	.locks = BT_UUID_128_LOCKS,
+	.refs = BT_UUID_128_REFS,
+	.hashes = BT_UUID_128_HASHES,
+	.el_size = sizeof(struct bt_uuid_128),
+	.el_cnt = CONFIG_BT_GATT_UUID128_POOL_SIZE,
+	.name = "UUID128",
 };
 static struct svc_el_pool chrc_pool = {
 	.elements = BT_GATT_CHRC_TAB,
 	.locks = BT_GATT_CHRC_LOCKS,
+	.el_size = sizeof(struct bt_gatt_chrc),
+	.el_cnt = CONFIG_BT_GATT_CHRC_POOL_SIZE,
+	.name = "chrc descriptor",
 };
 
+/* Protects the reference counters of the shared UUIDs. */
+static struct k_spinlock uuid_lock;
+
 static struct bt_uuid const * const uuid_primary = BT_UUID_GATT_PRIMARY;
 static struct bt_uuid const * const uuid_chrc = BT_UUID_GATT_CHRC;
 static struct bt_uuid const * const uuid_ccc = BT_UUID_GATT_CCC;
@@ -88,152 +139,237 @@ static struct bt_uuid const * const uuid_ccc = BT_UUID_GATT_CCC;
 #define ADDR_2_INDEX(pool, el)                                                 \
 	((((uint32_t)el) - ((uint32_t)pool)) / (sizeof(pool[0])))
 
-static size_t free_element_find(struct svc_el_pool *el_pool, size_t el_cnt)
+static void *pool_element(struct svc_el_pool *el_pool, size_t ind)
 {
-	__ASSERT((el_pool->elements != NULL) && (el_pool->locks != NULL),
-		 "Pool uninitialized");
+	return (uint8_t *)el_pool->elements + (ind * el_pool->el_size);
+}
 
-	for (size_t i = 0; i < el_cnt; i++) {
-		if (!atomic_test_and_set_bit(el_pool->locks, i)) {
-			return i;
-		}
-	}
-	return el_cnt;
+static size_t pool_index(struct svc_el_pool *el_pool, void const *el)
+{
+	return ((uint8_t const *)el - (uint8_t *)el_pool->elements) /
+	       el_pool->el_size;
 }
 
-static int uuid_16_get(struct bt_uuid **uuid, struct svc_el_pool *uuid_pool)
+static size_t free_element_find(struct svc_el_pool *el_pool)
 {
-	size_t ind = free_element_find(uuid_pool,
-				       CONFIG_BT_GATT_UUID16_POOL_SIZE);
+	__ASSERT((el_pool->elements != NULL) && (el_pool->locks != NULL),
+		 "Pool uninitialized");
 
-	if (ind >= CONFIG_BT_GATT_UUID16_POOL_SIZE) {
-		LOG_ERR("No more UUID16s in the pool!");
-		return -ENOMEM;
-	}
+	/* Scan the lock bitmap one word at a time and take the lowest
+	 * free bit of the first word that has one.
+	 */
+	for (size_t w = 0; w < ATOMIC_BITMAP_SIZE(el_pool->el_cnt); w++) {
+		atomic_val_t locked = atomic_get(&el_pool->locks[w]);
 
-	*uuid = (struct bt_uuid *)
-		&((struct bt_uuid_16 *) uuid_pool->elements)[ind];
-	return 0;
-}
+		while (~locked) {
+			uint32_t bit = u32_count_trailing_zeros(~locked);
+			size_t ind = (w * ATOMIC_BITS) + bit;
 
-static int uuid_32_get(struct bt_uuid **uuid, struct svc_el_pool *uuid_pool)
-{
-	size_t ind = free_element_find(uuid_pool,
-				       CONFIG_BT_GATT_UUID32_POOL_SIZE);
+			if (ind >= el_pool->el_cnt) {
+				break;
+			}
 
-	if (ind >= CONFIG_BT_GATT_UUID32_POOL_SIZE) {
-		LOG_ERR("No more UUID32s in the pool!");
-		return -ENOMEM;
+			if (atomic_cas(&el_pool->locks[w], locked,
+				       locked | BIT(bit))) {
+#if CONFIG_BT_GATT_POOL_STATS != 0
+				atomic_val_t used = atomic_inc(&el_pool->used) + 1;
+				atomic_val_t peak = atomic_get(&el_pool->peak);
+
+				while ((used > peak) &&
+				       !atomic_cas(&el_pool->peak, peak, used)) {
+					peak = atomic_get(&el_pool->peak);
+				}
+#endif
+				return ind;
+			}
+
+			/* Lost the race for this bit, read the word again. */
+			locked = atomic_get(&el_pool->locks[w]);
+		}
 	}
 
-	*uuid = (struct bt_uuid *)
-		&((struct bt_uuid_32 *) uuid_pool->elements)[ind];
-	return 0;
+	return el_pool->el_cnt;
 }
 
-static int uuid_128_get(struct bt_uuid **uuid, struct svc_el_pool *uuid_pool)
+static void element_release(struct svc_el_pool *el_pool, size_t ind)
 {
-	size_t ind = free_element_find(uuid_pool,
-				       CONFIG_BT_GATT_UUID128_POOL_SIZE);
-
-	if (ind >= CONFIG_BT_GATT_UUID128_POOL_SIZE) {
-		LOG_ERR("No more UUID128s in the pool!");
-		return -ENOMEM;
-	}
-
-	*uuid = (struct bt_uuid *)
-		&((struct bt_uuid_128 *) uuid_pool->elements)[ind];
-	return 0;
+	atomic_clear_bit(el_pool->locks, ind);
+#if CONFIG_BT_GATT_POOL_STATS != 0
+	atomic_dec(&el_pool->used);
+#endif
 }
 
 static int chrc_get(struct bt_gatt_chrc **chrc)
 {
-	size_t ind = free_element_find(&chrc_pool,
-				       CONFIG_BT_GATT_CHRC_POOL_SIZE);
+	size_t ind = free_element_find(&chrc_pool);
 
 	if (ind >= CONFIG_BT_GATT_CHRC_POOL_SIZE) {
 		LOG_ERR("No more chrc descriptors in the pool!");
 		return -ENOMEM;
 	}
 
-	*chrc = &((struct bt_gatt_chrc *) chrc_pool.elements)[ind];
+	*chrc = pool_element(&chrc_pool, ind);
 	return 0;
 }
 
 static void chrc_release(struct bt_gatt_chrc const *chrc)
 {
 	EL_IN_POOL_VERIFY(BT_GATT_CHRC_TAB, chrc);
-	atomic_clear_bit(chrc_pool.locks,
-			 ADDR_2_INDEX(BT_GATT_CHRC_TAB, chrc));
+	element_release(&chrc_pool, pool_index(&chrc_pool, chrc));
 }
 
-static int uuid_register(struct bt_uuid **dest_uuid,
-			 struct bt_uuid const *src_uuid)
+static struct svc_el_pool *uuid_pool_get(struct bt_uuid const *uuid)
 {
-	int ret = -EINVAL;
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		return &uuid_16_pool;
+	case BT_UUID_TYPE_32:
+		return &uuid_32_pool;
+	case BT_UUID_TYPE_128:
+		return &uuid_128_pool;
+	default:
+		return NULL;
+	}
+}
 
-	__ASSERT(*dest_uuid == NULL, "Overriding attribute UUID!");
+static uint8_t uuid_hash(struct bt_uuid const *uuid)
+{
+	uint8_t const *val;
+	size_t len;
+	uint8_t hash = 0;
 
-	switch (src_uuid->type) {
+	switch (uuid->type) {
 	case BT_UUID_TYPE_16:
-		ret = uuid_16_get(dest_uuid, &uuid_16_pool);
-		if (!ret) {
-			memcpy(*dest_uuid, src_uuid, sizeof(struct bt_uuid_16));
-		}
+		val = (uint8_t const *)&BT_UUID_16(uuid)->val;
+		len = sizeof(BT_UUID_16(uuid)->val);
 		break;
-
 	case BT_UUID_TYPE_32:
-		ret = uuid_32_get(dest_uuid, &uuid_32_pool);
-		if (!ret) {
-			memcpy(*dest_uuid, src_uuid, sizeof(struct bt_uuid_32));
-		}
+		val = (uint8_t const *)&BT_UUID_32(uuid)->val;
+		len = sizeof(BT_UUID_32(uuid)->val);
 		break;
+	default:
+		val = BT_UUID_128(uuid)->val;
+		len = sizeof(BT_UUID_128(uuid)->val);
+		break;
+	}
 
-	case BT_UUID_TYPE_128:
-		ret = uuid_128_get(dest_uuid, &uuid_128_pool);
-		if (!ret) {
-			memcpy(*dest_uuid, src_uuid,
-			       sizeof(struct bt_uuid_128));
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash * 31) + val[i];
+	}
+
+	return hash;
+}
+
+/* Looks for an already registered copy of the UUID that can be shared. */
+static struct bt_uuid *uuid_shared_find(struct svc_el_pool *uuid_pool,
+					struct bt_uuid const *uuid,
+					uint8_t hash)
+{
+	for (size_t w = 0; w < ATOMIC_BITMAP_SIZE(uuid_pool->el_cnt); w++) {
+		uint32_t locked = atomic_get(&uuid_pool->locks[w]);
+
+		while (locked) {
+			uint32_t bit = u32_count_trailing_zeros(locked);
+			size_t ind = (w * ATOMIC_BITS) + bit;
+			struct bt_uuid *el = pool_element(uuid_pool, ind);
+
+			locked &= ~BIT(bit);
+
+			if ((uuid_pool->hashes[ind] == hash) &&
+			    (uuid_pool->refs[ind] != 0) &&
+			    (uuid_pool->refs[ind] < UINT8_MAX) &&
+			    !bt_uuid_cmp(el, uuid)) {
+				uuid_pool->refs[ind]++;
+				return el;
+			}
 		}
-		break;
+	}
 
-	default:
+	return NULL;
+}
+
+static int uuid_register(struct bt_uuid **dest_uuid,
+			 struct bt_uuid const *src_uuid)
+{
+	struct svc_el_pool *uuid_pool = uuid_pool_get(src_uuid);
+	k_spinlock_key_t key;
+	uint8_t hash;
+	size_t ind;
+
+	__ASSERT(*dest_uuid == NULL, "Overriding attribute UUID!");
+
+	if (!uuid_pool) {
 		LOG_ERR("Unknown UUID type");
-		break;
+		return -EINVAL;
 	}
-	return ret;
+
+	if (!uuid_pool->el_cnt) {
+		LOG_ERR("No more %ss in the pool!", uuid_pool->name);
+		return -ENOMEM;
+	}
+
+	hash = uuid_hash(src_uuid);
+	key = k_spin_lock(&uuid_lock);
+
+	/* UUIDs are never modified once registered, so attributes with
+	 * the same UUID share a single pool element.
+	 */
+	*dest_uuid = uuid_shared_find(uuid_pool, src_uuid, hash);
+	if (*dest_uuid) {
+		k_spin_unlock(&uuid_lock, key);
+		return 0;
+	}
+
+	ind = free_element_find(uuid_pool);
+	if (ind >= uuid_pool->el_cnt) {
+		k_spin_unlock(&uuid_lock, key);
+		LOG_ERR("No more %ss in the pool!", uuid_pool->name);
+		return -ENOMEM;
+	}
+
+	*dest_uuid = pool_element(uuid_pool, ind);
+	memcpy(*dest_uuid, src_uuid, uuid_pool->el_size);
+	uuid_pool->hashes[ind] = hash;
+	uuid_pool->refs[ind] = 1;
+
+	k_spin_unlock(&uuid_lock, key);
+
+	return 0;
 }
 
 static void uuid_unregister(struct bt_uuid const *uuid)
 {
+	struct svc_el_pool *uuid_pool = uuid_pool_get(uuid);
+	k_spinlock_key_t key;
+	size_t ind;
+
 	switch (uuid->type) {
 	case BT_UUID_TYPE_16:
 		EL_IN_POOL_VERIFY(BT_UUID_16_TAB, uuid);
-#if CONFIG_BT_GATT_UUID16_POOL_SIZE != 0
-		atomic_clear_bit(uuid_16_pool.locks,
-				 ADDR_2_INDEX(BT_UUID_16_TAB, uuid));
-#endif
 		break;
 
 	case BT_UUID_TYPE_32:
 		EL_IN_POOL_VERIFY(BT_UUID_32_TAB, uuid);
-#if CONFIG_BT_GATT_UUID32_POOL_SIZE != 0
-		atomic_clear_bit(uuid_32_pool.locks,
-				 ADDR_2_INDEX(BT_UUID_32_TAB, uuid));
-#endif
 		break;
 
 	case BT_UUID_TYPE_128:
 		EL_IN_POOL_VERIFY(BT_UUID_128_TAB, uuid);
-#if CONFIG_BT_GATT_UUID128_POOL_SIZE != 0
-		atomic_clear_bit(uuid_128_pool.locks,
-				 ADDR_2_INDEX(BT_UUID_128_TAB, uuid));
-#endif
 		break;
 
 	default:
 		__ASSERT(false, "Unknown UUID type");
+		return;
 	}
+
+	ind = pool_index(uuid_pool, uuid);
+	key = k_spin_lock(&uuid_lock);
+
+	__ASSERT(uuid_pool->refs[ind] != 0, "Releasing unused UUID");
+	if (--uuid_pool->refs[ind] == 0) {
+		element_release(uuid_pool, ind);
+	}
+
+	k_spin_unlock(&uuid_lock, key);
 }
 
 /** @brief Free a single attribute.
@@ -420,61 +556,57 @@ void bt_gatt_pool_free(struct bt_gatt_pool *gp)
 
 
 #if CONFIG_BT_GATT_POOL_STATS != 0
-static size_t mask_print(atomic_t *mask, size_t mask_size)
+static void pool_stats_print(struct svc_el_pool *el_pool)
 {
+	size_t mask_size = ATOMIC_BITMAP_SIZE(el_pool->el_cnt);
 	size_t used_el_cnt = 0;
+	size_t refs_cnt = 0;
+	size_t top = 0;
+
+	printk("%s Pool. Locked elements mask:\n", el_pool->name);
 
 	for (size_t i = 0; i < mask_size; i++) {
-		uint32_t state_part = mask[mask_size - i - 1];
+		uint32_t state_part = el_pool->locks[mask_size - i - 1];
 
 		printk("%08X", state_part);
 		used_el_cnt += popcount(state_part);
 	}
-	return used_el_cnt;
+
+	for (size_t i = 0; i < el_pool->el_cnt; i++) {
+		if (atomic_test_bit(el_pool->locks, i)) {
+			top = i + 1;
+			refs_cnt += el_pool->refs ? el_pool->refs[i] : 1;
+		}
+	}
+
+	printk("\nPool element usage: %d out of %d\n", used_el_cnt,
+	       el_pool->el_cnt);
+	printk("Peak usage: %d\n", (int)atomic_get(&el_pool->peak));
+	/* Free elements below the highest used one. */
+	printk("Fragmentation: %d free elements in use range\n",
+	       top - used_el_cnt);
+	if (el_pool->refs) {
+		printk("References: %d\n", refs_cnt);
+	}
+	printk("\n");
 }
 
 void bt_gatt_pool_stats_print(void)
 {
-	size_t used_el_cnt;
-
 #if CONFIG_BT_GATT_UUID16_POOL_SIZE != 0
-	printk("UUID 16 Pool. Locked elements mask:\n");
-
-	used_el_cnt = mask_print(BT_UUID_16_LOCKS,
-				 ARRAY_SIZE(BT_UUID_16_LOCKS));
-
-	printk("\nPool element usage: %d out of %d\n\n", used_el_cnt,
-	       CONFIG_BT_GATT_UUID16_POOL_SIZE);
+	pool_stats_print(&uuid_16_pool);
 #endif
 
 #if CONFIG_BT_GATT_UUID32_POOL_SIZE != 0
-	printk("UUID 32 Pool. Locked elements mask:\n");
-
-	used_el_cnt = mask_print(BT_UUID_32_LOCKS,
-				 ARRAY_SIZE(BT_UUID_32_LOCKS));
-
-	printk("\nPool element usage: %d out of %d\n\n", used_el_cnt,
-	       CONFIG_BT_GATT_UUID32_POOL_SIZE);
+	pool_stats_print(&uuid_32_pool);
 #endif
 
 #if CONFIG_BT_GATT_UUID128_POOL_SIZE != 0
-	printk("UUID 128 Pool. Locked elements mask:\n");
-
-	used_el_cnt = mask_print(BT_UUID_128_LOCKS,
-				 ARRAY_SIZE(BT_UUID_128_LOCKS));
-
-	printk("\nPool element usage: %d out of %d\n\n", used_el_cnt,
-	       CONFIG_BT_GATT_UUID128_POOL_SIZE);
+	pool_stats_print(&uuid_128_pool);
 #endif
 
 #if CONFIG_BT_GATT_CHRC_POOL_SIZE != 0
-	printk("Characteristic Pool. Locked elements mask:\n");
-
-	used_el_cnt = mask_print(BT_GATT_CHRC_LOCKS,
-				 ARRAY_SIZE(BT_GATT_CHRC_LOCKS));
-
-	printk("\nPool element usage: %d out of %d\n\n", used_el_cnt,
-	       CONFIG_BT_GATT_CHRC_POOL_SIZE);
+	pool_stats_print(&chrc_pool);
 #endif
 }
 #endif /* CONFIG_BT_GATT_POOL_STATS */
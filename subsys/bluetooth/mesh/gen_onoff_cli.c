@@ -46,6 +46,7 @@ static int handle_status(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ct
 	struct bt_mesh_onoff_cli *cli = model->user_data;
 	struct bt_mesh_onoff_status status;
 	struct bt_mesh_onoff_status *rsp;
+	struct bt_mesh_onoff_cli_group_rsp *group_rsp;
 	int err;
 
 	err = decode_status(buf, &status);
@@ -59,6 +60,13 @@ static int handle_status(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ct
 		bt_mesh_msg_ack_ctx_rx(&cli->ack_ctx);
 	}
 
+	group_rsp = model_group_rsp_next(&cli->group_ack_ctx,
+					 BT_MESH_ONOFF_OP_STATUS, ctx->addr);
+	if (group_rsp) {
+		group_rsp->addr = ctx->addr;
+		group_rsp->status = status;
+	}
+
 	if (cli->status_handler) {
 		cli->status_handler(cli, ctx, &status);
 	}
@@ -84,6 +92,7 @@ static int bt_mesh_onoff_cli_init(struct bt_mesh_model *model)
 	net_buf_simple_init_with_data(&cli->pub_buf, cli->pub_data,
 				      sizeof(cli->pub_data));
 	bt_mesh_msg_ack_ctx_init(&cli->ack_ctx);
+	bt_mesh_msg_ack_ctx_init(&cli->group_ack_ctx);
 
 	return 0;
 }
@@ -94,6 +103,7 @@ static void bt_mesh_onoff_cli_reset(struct bt_mesh_model *model)
 
 	net_buf_simple_reset(cli->pub.msg);
 	bt_mesh_msg_ack_ctx_reset(&cli->ack_ctx);
+	bt_mesh_msg_ack_ctx_reset(&cli->group_ack_ctx);
 }
 
 const struct bt_mesh_model_cb _bt_mesh_onoff_cli_cb = {
@@ -114,6 +124,29 @@ int bt_mesh_onoff_cli_get(struct bt_mesh_onoff_cli *cli,
 			       BT_MESH_ONOFF_OP_STATUS, rsp);
 }
 
+int bt_mesh_onoff_cli_group_get(struct bt_mesh_onoff_cli *cli,
+				struct bt_mesh_msg_ctx *ctx,
+				struct bt_mesh_onoff_cli_group_rsp *rsps,
+				size_t count, k_timeout_t timeout)
+{
+	BT_MESH_MODEL_BUF_DEFINE(msg, BT_MESH_ONOFF_OP_GET,
+				 BT_MESH_ONOFF_MSG_LEN_GET);
+	struct model_group_rsp rsp = {
+		.rsps = rsps,
+		.rsp_size = sizeof(*rsps),
+		.max = count,
+	};
+
+	if (!rsps || !count) {
+		return -EINVAL;
+	}
+
+	bt_mesh_model_msg_init(&msg, BT_MESH_ONOFF_OP_GET);
+
+	return model_group_send(cli->model, ctx, &msg, &cli->group_ack_ctx,
+				BT_MESH_ONOFF_OP_STATUS, &rsp, timeout);
+}
+
 int bt_mesh_onoff_cli_set(struct bt_mesh_onoff_cli *cli,
 			  struct bt_mesh_msg_ctx *ctx,
 			  const struct bt_mesh_onoff_set *set,
@@ -24,11 +24,10 @@ struct bt_mesh_plvl_srv_settings_data {
 } __packed;
 
 #if CONFIG_BT_SETTINGS
-static void store_timeout(struct k_work *work)
+static void store_timeout(struct bt_mesh_model_store *store)
 {
-	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
 	struct bt_mesh_plvl_srv *srv = CONTAINER_OF(
-		dwork, struct bt_mesh_plvl_srv, store_timer);
+		store, struct bt_mesh_plvl_srv, store_timer);
 
 	struct bt_mesh_plvl_srv_settings_data data = {
 		.default_power = srv->default_power,
@@ -45,9 +44,7 @@ static void store_timeout(struct k_work *work)
 static void store_state(struct bt_mesh_plvl_srv *srv)
 {
 #if CONFIG_BT_SETTINGS
-	k_work_schedule(
-		&srv->store_timer,
-		K_SECONDS(CONFIG_BT_MESH_MODEL_SRV_STORE_TIMEOUT));
+	model_store_schedule(&srv->store_timer);
 #endif
 }
 
@@ -688,7 +685,7 @@ static int bt_mesh_plvl_srv_init(struct bt_mesh_model *model)
 				      sizeof(srv->pub_data));
 
 #if CONFIG_BT_SETTINGS
-	k_work_init_delayable(&srv->store_timer, store_timeout);
+	model_store_init(&srv->store_timer, store_timeout);
 #endif
 
 	err = bt_mesh_model_extend(model, srv->ponoff.ponoff_model);
@@ -51,11 +51,10 @@ static struct bt_mesh_prop *prop_get(const struct bt_mesh_prop_srv *srv,
 }
 
 #if CONFIG_BT_SETTINGS
-static void store_timeout(struct k_work *work)
+static void store_timeout(struct bt_mesh_model_store *store)
 {
-	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
 	struct bt_mesh_prop_srv *srv = CONTAINER_OF(
-		dwork, struct bt_mesh_prop_srv, store_timer);
+		store, struct bt_mesh_prop_srv, store_timer);
 
 	uint8_t user_access[CONFIG_BT_MESH_PROP_MAXCOUNT];
 
@@ -72,9 +71,7 @@ static void store_timeout(struct k_work *work)
 static void store_props(struct bt_mesh_prop_srv *srv)
 {
 #if CONFIG_BT_SETTINGS
-	k_work_schedule(
-		&srv->store_timer,
-		K_SECONDS(CONFIG_BT_MESH_MODEL_SRV_STORE_TIMEOUT));
+	model_store_schedule(&srv->store_timer);
 #endif
 }
 
@@ -604,7 +601,7 @@ static int bt_mesh_prop_srv_init(struct bt_mesh_model *model)
 				      sizeof(srv->pub_data));
 
 #if CONFIG_BT_SETTINGS
-	k_work_init_delayable(&srv->store_timer, store_timeout);
+	model_store_init(&srv->store_timer, store_timeout);
 #endif
 
 	if ((model->id == BT_MESH_MODEL_ID_GEN_MANUFACTURER_PROP_SRV ||
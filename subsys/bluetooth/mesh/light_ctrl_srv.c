@@ -19,6 +19,9 @@
 #include "common/log.h"
 
 #define REG_INT CONFIG_BT_MESH_LIGHT_CTRL_SRV_REG_INTERVAL
+#define REG_INT_MAX CONFIG_BT_MESH_LIGHT_CTRL_SRV_REG_INTERVAL_MAX
+/* Fractional bits of the fixed-point regulator sums */
+#define REG_Q 20
 
 #define FLAGS_CONFIGURATION (BIT(FLAG_STARTED) | BIT(FLAG_OCC_MODE))
 
@@ -59,6 +62,7 @@ static void restart_timer(struct bt_mesh_light_ctrl_srv *srv, uint32_t delay)
 static void reg_start(struct bt_mesh_light_ctrl_srv *srv)
 {
 #if CONFIG_BT_MESH_LIGHT_CTRL_SRV_REG
+	srv->reg.interval = REG_INT;
 	k_work_schedule(&srv->reg.timer, K_MSEC(REG_INT));
 #endif
 }
@@ -312,10 +316,12 @@ static uint16_t light_get(struct bt_mesh_light_ctrl_srv *srv)
 
 #if CONFIG_BT_MESH_LIGHT_CTRL_SRV_REG
 
+#if !CONFIG_BT_MESH_LIGHT_CTRL_SRV_REG_FIXED_POINT
 static float sensor_to_float(struct sensor_value *val)
 {
 	return val->val1 + val->val2 / 1000000.0f;
 }
+#endif
 
 static void lux_get(struct bt_mesh_light_ctrl_srv *srv,
 		    struct sensor_value *lux)
@@ -339,6 +345,7 @@ static void lux_get(struct bt_mesh_light_ctrl_srv *srv,
 	from_centi_lux(centi_lux, lux);
 }
 
+#if !CONFIG_BT_MESH_LIGHT_CTRL_SRV_REG_FIXED_POINT
 static float lux_getf(struct bt_mesh_light_ctrl_srv *srv)
 {
 	if (!is_enabled(srv)) {
@@ -356,6 +363,7 @@ static float lux_getf(struct bt_mesh_light_ctrl_srv *srv)
 
 	return to_centi_lux(&srv->reg.cfg.lux[srv->state]) / 100.0f;
 }
+#endif
 
 #else
 
@@ -513,19 +521,60 @@ static void ctrl_disable(struct bt_mesh_light_ctrl_srv *srv)
 }
 
 #if CONFIG_BT_MESH_LIGHT_CTRL_SRV_REG
-static void reg_step(struct k_work *work)
+#if CONFIG_BT_MESH_LIGHT_CTRL_SRV_REG_FIXED_POINT
+/* Converts a coefficient to a fixed-point factor for centi-lux errors. */
+static int32_t reg_coeff(float k, float scale)
 {
-	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
-	struct bt_mesh_light_ctrl_srv *srv = CONTAINER_OF(
-		dwork, struct bt_mesh_light_ctrl_srv, reg.timer);
+	return CLAMP(k * scale, -2e9f, 2e9f);
+}
 
-	if (!is_enabled(srv)) {
-		/* The server might be disabled asynchronously. */
-		return;
+static uint16_t reg_output(struct bt_mesh_light_ctrl_srv *srv, bool *stable)
+{
+	struct sensor_value lux;
+
+	lux_get(srv, &lux);
+
+	int32_t target = to_centi_lux(&lux);
+	int32_t ambient = to_centi_lux(&srv->ambient_lux);
+	int32_t error = target - ambient;
+
+	/* Accuracy should be in percent and both up and down: */
+	int32_t accuracy = (srv->reg.cfg.accuracy * target) / (2 * 100);
+
+	int32_t input;
+	if (error > accuracy) {
+		input = error - accuracy;
+	} else if (error < -accuracy) {
+		input = error + accuracy;
+	} else {
+		input = 0;
+	}
+
+	float kp, ki;
+	if (input >= 0) {
+		kp = srv->reg.cfg.kpu;
+		ki = srv->reg.cfg.kiu;
+	} else {
+		kp = srv->reg.cfg.kpd;
+		ki = srv->reg.cfg.kid;
 	}
 
-	k_work_reschedule(&srv->reg.timer, K_MSEC(REG_INT));
+	*stable = (input == 0);
+
+	int64_t max = (int64_t)UINT16_MAX << REG_Q;
+
+	srv->reg.i += (int64_t)input *
+		      reg_coeff(ki, (float)BIT(REG_Q) * REG_INT /
+					    (100.0f * MSEC_PER_SEC));
+	srv->reg.i = CLAMP(srv->reg.i, 0, max);
 
+	int64_t p = (int64_t)input * reg_coeff(kp, BIT(REG_Q) / 100.0f);
+
+	return CLAMP(srv->reg.i + p, 0, max) >> REG_Q;
+}
+#else
+static uint16_t reg_output(struct bt_mesh_light_ctrl_srv *srv, bool *stable)
+{
 	float target = lux_getf(srv);
 	float ambient = sensor_to_float(&srv->ambient_lux);
 	float error = target - ambient;
@@ -551,11 +600,48 @@ static void reg_step(struct k_work *work)
 		ki = srv->reg.cfg.kid;
 	}
 
+	*stable = (input == 0.0f);
+
 	srv->reg.i += (input * ki) * ((float)REG_INT / (float)MSEC_PER_SEC);
 	srv->reg.i = CLAMP(srv->reg.i, 0, UINT16_MAX);
 
 	float p = input * kp;
-	uint16_t output = CLAMP(srv->reg.i + p, 0, UINT16_MAX);
+
+	return CLAMP(srv->reg.i + p, 0, UINT16_MAX);
+}
+#endif
+
+/* While the error stays within the accuracy, nothing changes between steps,
+ * and the regulator slows down to save CPU time. The integral is always
+ * computed over the base interval, as it only runs again at that interval
+ * once the error leaves the dead zone.
+ */
+static void reg_reschedule(struct bt_mesh_light_ctrl_srv *srv, bool stable)
+{
+	if (stable && REG_INT_MAX > REG_INT) {
+		srv->reg.interval = MIN(srv->reg.interval * 2, REG_INT_MAX);
+	} else {
+		srv->reg.interval = REG_INT;
+	}
+
+	k_work_reschedule(&srv->reg.timer, K_MSEC(srv->reg.interval));
+}
+
+static void reg_step(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct bt_mesh_light_ctrl_srv *srv = CONTAINER_OF(
+		dwork, struct bt_mesh_light_ctrl_srv, reg.timer);
+	bool stable;
+
+	if (!is_enabled(srv)) {
+		/* The server might be disabled asynchronously. */
+		return;
+	}
+
+	uint16_t output = reg_output(srv, &stable);
+
+	reg_reschedule(srv, stable);
 
 	/* The regulator output is always in linear format. We'll convert to
 	 * the configured representation again before calling the Lightness
@@ -986,6 +1072,16 @@ static int handle_sensor_status(struct bt_mesh_model *model, struct bt_mesh_msg_
 
 		if (id == BT_MESH_PROP_ID_PRESENT_AMB_LIGHT_LEVEL) {
 			srv->ambient_lux = value;
+#if CONFIG_BT_MESH_LIGHT_CTRL_SRV_REG
+			/* Catch up on new readings if the regulator slowed
+			 * down.
+			 */
+			if (srv->reg.interval > REG_INT && is_enabled(srv)) {
+				srv->reg.interval = REG_INT;
+				k_work_reschedule(&srv->reg.timer,
+						  K_MSEC(REG_INT));
+			}
+#endif
 			continue;
 		}
 
@@ -1523,6 +1619,7 @@ static int light_ctrl_srv_init(struct bt_mesh_model *model)
 #endif
 
 #if CONFIG_BT_MESH_LIGHT_CTRL_SRV_REG
+	srv->reg.interval = REG_INT;
 	k_work_init_delayable(&srv->reg.timer, reg_step);
 #endif
 
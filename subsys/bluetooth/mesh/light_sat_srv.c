@@ -26,11 +26,10 @@ struct settings_data {
 } __packed;
 
 #if CONFIG_BT_SETTINGS
-static void store_timeout(struct k_work *work)
+static void store_timeout(struct bt_mesh_model_store *store)
 {
-	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
 	struct bt_mesh_light_sat_srv *srv = CONTAINER_OF(
-		dwork, struct bt_mesh_light_sat_srv, store_timer);
+		store, struct bt_mesh_light_sat_srv, store_timer);
 
 	struct settings_data data = {
 		.range = srv->range,
@@ -46,9 +45,7 @@ static void store_timeout(struct k_work *work)
 static void store(struct bt_mesh_light_sat_srv *srv)
 {
 #if CONFIG_BT_SETTINGS
-	k_work_schedule(
-		&srv->store_timer,
-		K_SECONDS(CONFIG_BT_MESH_MODEL_SRV_STORE_TIMEOUT));
+	model_store_schedule(&srv->store_timer);
 #endif
 }
 
@@ -388,7 +385,7 @@ static int sat_srv_init(struct bt_mesh_model *model)
 				      ARRAY_SIZE(srv->pub_data));
 
 #if CONFIG_BT_SETTINGS
-	k_work_init_delayable(&srv->store_timer, store_timeout);
+	model_store_init(&srv->store_timer, store_timeout);
 #endif
 
 	return bt_mesh_model_extend(model, srv->lvl.model);
@@ -18,6 +18,7 @@ static int light_status(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx
 	struct bt_mesh_lightness_cli *cli = model->user_data;
 	struct bt_mesh_lightness_status status;
 	struct bt_mesh_lightness_status *rsp;
+	struct bt_mesh_lightness_cli_group_rsp *group_rsp;
 
 	status.current = repr_to_light(net_buf_simple_pull_le16(buf), repr);
 	if (buf->len == 3) {
@@ -36,6 +37,14 @@ static int light_status(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx
 		bt_mesh_msg_ack_ctx_rx(&cli->ack_ctx);
 	}
 
+	group_rsp = model_group_rsp_next(&cli->group_ack_ctx,
+					 op_get(LIGHTNESS_OP_TYPE_STATUS, repr),
+					 ctx->addr);
+	if (group_rsp) {
+		group_rsp->addr = ctx->addr;
+		group_rsp->status = status;
+	}
+
 	if (cli->handlers && cli->handlers->light_status) {
 		cli->handlers->light_status(cli, ctx, &status);
 	}
@@ -158,6 +167,7 @@ static int bt_mesh_lvl_cli_init(struct bt_mesh_model *model)
 	net_buf_simple_init_with_data(&cli->pub_buf, cli->pub_data,
 				      sizeof(cli->pub_data));
 	bt_mesh_msg_ack_ctx_init(&cli->ack_ctx);
+	bt_mesh_msg_ack_ctx_init(&cli->group_ack_ctx);
 
 	return 0;
 }
@@ -168,6 +178,7 @@ static void bt_mesh_lvl_cli_reset(struct bt_mesh_model *model)
 
 	net_buf_simple_reset(model->pub->msg);
 	bt_mesh_msg_ack_ctx_reset(&cli->ack_ctx);
+	bt_mesh_msg_ack_ctx_reset(&cli->group_ack_ctx);
 }
 
 const struct bt_mesh_model_cb _bt_mesh_lightness_cli_cb = {
@@ -233,6 +244,32 @@ int bt_mesh_lightness_cli_light_get(struct bt_mesh_lightness_cli *cli,
 	return lightness_cli_light_get(cli, ctx, LIGHT_USER_REPR, rsp);
 }
 
+int bt_mesh_lightness_cli_light_group_get(
+	struct bt_mesh_lightness_cli *cli, struct bt_mesh_msg_ctx *ctx,
+	struct bt_mesh_lightness_cli_group_rsp *rsps, size_t count,
+	k_timeout_t timeout)
+{
+	BT_MESH_MODEL_BUF_DEFINE(buf, BT_MESH_LIGHTNESS_OP_GET,
+				 BT_MESH_LIGHTNESS_MSG_LEN_GET);
+	struct model_group_rsp rsp = {
+		.rsps = rsps,
+		.rsp_size = sizeof(*rsps),
+		.max = count,
+	};
+
+	if (!rsps || !count) {
+		return -EINVAL;
+	}
+
+	bt_mesh_model_msg_init(&buf, op_get(LIGHTNESS_OP_TYPE_GET,
+					    LIGHT_USER_REPR));
+
+	return model_group_send(cli->model, ctx, &buf, &cli->group_ack_ctx,
+				op_get(LIGHTNESS_OP_TYPE_STATUS,
+				       LIGHT_USER_REPR),
+				&rsp, timeout);
+}
+
 int bt_mesh_lightness_cli_light_set(struct bt_mesh_lightness_cli *cli,
 				    struct bt_mesh_msg_ctx *ctx,
 				    const struct bt_mesh_lightness_set *set,
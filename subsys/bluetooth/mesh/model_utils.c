@@ -145,6 +145,131 @@ int model_ackd_send(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
 	return retval;
 }
 
+int model_group_send(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		     struct net_buf_simple *buf,
+		     struct bt_mesh_msg_ack_ctx *ack, uint32_t rsp_op,
+		     struct model_group_rsp *rsp, k_timeout_t timeout)
+{
+	int err;
+
+	rsp->count = 0;
+
+	if (bt_mesh_msg_ack_ctx_prepare(ack, rsp_op, ctx ? ctx->addr : model->pub->addr,
+					rsp) != 0) {
+		return -EALREADY;
+	}
+
+	err = model_send(model, ctx, buf);
+	if (err) {
+		bt_mesh_msg_ack_ctx_clear(ack);
+		return err;
+	}
+
+	/* The collection ends on timeout, unless all buffers are filled. */
+	(void)bt_mesh_msg_ack_ctx_wait(ack, timeout);
+
+	return rsp->count;
+}
+
+void *model_group_rsp_next(struct bt_mesh_msg_ack_ctx *ack, uint32_t op,
+			   uint16_t addr)
+{
+	struct model_group_rsp *rsp;
+
+	if (!bt_mesh_msg_ack_ctx_match(ack, op, addr, (void **)&rsp) ||
+	    rsp->count == rsp->max) {
+		return NULL;
+	}
+
+	if (rsp->count + 1 == rsp->max) {
+		bt_mesh_msg_ack_ctx_rx(ack);
+	}
+
+	return (uint8_t *)rsp->rsps + rsp->rsp_size * rsp->count++;
+}
+
+#if CONFIG_BT_SETTINGS
+static sys_slist_t store_list = SYS_SLIST_STATIC_INIT(&store_list);
+static struct k_spinlock store_lock;
+
+static void store_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(store_work, store_work_handler);
+
+/* Every store is due the same time after it's scheduled, so the list is
+ * always sorted by deadline, and the timer only has to follow its head.
+ * Must be called with the lock held.
+ */
+static void store_timer_update(void)
+{
+	struct bt_mesh_model_store *head = SYS_SLIST_PEEK_HEAD_CONTAINER(
+		&store_list, head, node);
+
+	if (head) {
+		k_work_reschedule(&store_work,
+				  K_MSEC(MAX(head->deadline - k_uptime_get(),
+					     0)));
+	}
+}
+
+static void store_work_handler(struct k_work *work)
+{
+	int64_t now = k_uptime_get();
+	struct bt_mesh_model_store *store;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(work);
+
+	/* Store all models that are due in one go. The handlers are called
+	 * without the lock, so they may schedule new stores.
+	 */
+	for (;;) {
+		key = k_spin_lock(&store_lock);
+
+		store = SYS_SLIST_PEEK_HEAD_CONTAINER(&store_list, store, node);
+		if (!store || store->deadline > now) {
+			store_timer_update();
+			k_spin_unlock(&store_lock, key);
+			return;
+		}
+
+		(void)sys_slist_get(&store_list);
+		store->pending = false;
+
+		k_spin_unlock(&store_lock, key);
+
+		store->cb(store);
+	}
+}
+
+void model_store_init(struct bt_mesh_model_store *store,
+		      bt_mesh_model_store_cb_t cb)
+{
+	store->cb = cb;
+	store->pending = false;
+}
+
+void model_store_schedule(struct bt_mesh_model_store *store)
+{
+	k_spinlock_key_t key = k_spin_lock(&store_lock);
+
+	if (!store->pending) {
+		bool first = sys_slist_is_empty(&store_list);
+
+		store->pending = true;
+		store->deadline =
+			k_uptime_get() +
+			CONFIG_BT_MESH_MODEL_SRV_STORE_TIMEOUT * MSEC_PER_SEC;
+		sys_slist_append(&store_list, &store->node);
+
+		if (first) {
+			store_timer_update();
+		}
+	}
+
+	k_spin_unlock(&store_lock, key);
+}
+#endif
+
 bool bt_mesh_model_pub_is_unicast(const struct bt_mesh_model *model)
 {
 	return model->pub && BT_MESH_ADDR_IS_UNICAST(model->pub->addr);
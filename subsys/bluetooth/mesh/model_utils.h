@@ -88,6 +88,72 @@ int model_ackd_send(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
 int tid_check_and_update(struct bt_mesh_tid_ctx *prev_transaction, uint8_t tid,
 			 const struct bt_mesh_msg_ctx *ctx);
 
+/** Responses from several servers to a single client request. */
+struct model_group_rsp {
+	/** Response buffer array. */
+	void *rsps;
+	/** Size of each response buffer. */
+	size_t rsp_size;
+	/** Number of response buffers. */
+	size_t max;
+	/** Number of collected responses. */
+	size_t count;
+};
+
+/** @brief Send a request and collect the responses of several servers.
+ *
+ * Blocks until @p timeout expires, or all the response buffers in @p rsp are
+ * filled.
+ *
+ * @param model Client model to send on.
+ * @param ctx Message context, or NULL to use the configured publish
+ * parameters.
+ * @param buf Request message.
+ * @param ack Acknowledged message context used for the collection.
+ * @param rsp_op Opcode of the responses.
+ * @param rsp Response collection.
+ * @param timeout Time to wait for responses.
+ *
+ * @return The number of collected responses, or a negative error code if
+ * the request could not be sent.
+ */
+int model_group_send(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		     struct net_buf_simple *buf,
+		     struct bt_mesh_msg_ack_ctx *ack, uint32_t rsp_op,
+		     struct model_group_rsp *rsp, k_timeout_t timeout);
+
+/** @brief Get the next response buffer of a response collection.
+ *
+ * Called by the client when a response is received.
+ *
+ * @param ack Acknowledged message context used for the collection.
+ * @param op Opcode of the received response.
+ * @param addr Source address of the received response.
+ *
+ * @return The response buffer to fill, or NULL if a collection of @p op
+ * responses is not in progress, or has no room for more.
+ */
+void *model_group_rsp_next(struct bt_mesh_msg_ack_ctx *ack, uint32_t op,
+			   uint16_t addr);
+
+/** @brief Initialize a deferred model state store.
+ *
+ * @param store Deferred store.
+ * @param cb Handler that stores the model state.
+ */
+void model_store_init(struct bt_mesh_model_store *store,
+		      bt_mesh_model_store_cb_t cb);
+
+/** @brief Schedule storing the model state.
+ *
+ * The handler is called @c CONFIG_BT_MESH_MODEL_SRV_STORE_TIMEOUT seconds
+ * after the first call. Calls made while the store is pending have no
+ * effect, so the state is stored at most once per timeout.
+ *
+ * @param store Deferred store.
+ */
+void model_store_schedule(struct bt_mesh_model_store *store);
+
 uint8_t model_delay_encode(uint32_t delay);
 int32_t model_delay_decode(uint8_t encoded_delay);
 int32_t model_transition_decode(uint8_t encoded_transition);
@@ -6,6 +6,8 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
+#include <settings/settings.h>
 #include <bluetooth/mesh/access.h>
 #include <bluetooth/mesh/models.h>
 #include <sys/byteorder.h>
@@ -381,6 +383,55 @@ static ssize_t entry_store(struct bt_mesh_model *mod,
 	return sizeof(struct scene_data) + data->len;
 }
 
+struct page_cmp {
+	const uint8_t *data;
+	size_t len;
+	bool equal;
+};
+
+static int page_cmp_cb(const char *key, size_t len, settings_read_cb read_cb,
+		       void *cb_arg, void *param)
+{
+	/* Pages are only compared from the mesh thread, one at a time. */
+	static uint8_t stored[SCENE_PAGE_SIZE];
+	struct page_cmp *cmp = param;
+
+	if (settings_name_next(key, NULL) != 0) {
+		return 0;
+	}
+
+	if (len == cmp->len && read_cb(cb_arg, stored, len) == len) {
+		cmp->equal = !memcmp(stored, cmp->data, len);
+	}
+
+	/* Stop loading, the page was found. */
+	return 1;
+}
+
+/** Check whether the stored page already has the given contents.
+ *
+ *  Most scene stores only change the state of a few models, so comparing
+ *  the pages first saves flash writes for the rest.
+ */
+static bool page_unchanged(struct bt_mesh_scene_srv *srv, const char *path,
+			   const uint8_t buf[], size_t len)
+{
+	struct page_cmp cmp = {
+		.data = buf,
+		.len = len,
+	};
+	char key[32];
+
+	snprintf(key, sizeof(key), "bt/mesh/s/%x/data/%s",
+		 (srv->model->elem_idx << 8) | srv->model->mod_idx, path);
+
+	if (settings_load_subtree_direct(key, page_cmp_cb, &cmp)) {
+		return false;
+	}
+
+	return cmp.equal;
+}
+
 /** Store a single page of the Scene.
  *
  *  To accommodate large scene data, each scene is stored in pages of up to 256
@@ -395,6 +446,11 @@ static void page_store(struct bt_mesh_scene_srv *srv, uint16_t scene,
 	scene_path(path, scene, vnd, page);
 	update_page_count(srv, vnd, page);
 
+	if (page_unchanged(srv, path, buf, len)) {
+		BT_DBG("%s unchanged", log_strdup(path));
+		return;
+	}
+
 	err = bt_mesh_model_data_store(srv->model, false, path, buf, len);
 	if (err) {
 		BT_ERR("Failed storing %s: %d", log_strdup(path), err);
@@ -63,6 +63,16 @@ static bool is_entry_defined(struct bt_mesh_scheduler_srv *srv, uint8_t idx)
 	return srv->sch_reg[idx].action != BT_MESH_SCHEDULER_NO_ACTIONS;
 }
 
+static bool is_entry_schedulable(struct bt_mesh_scheduler_srv *srv,
+				 uint8_t idx)
+{
+	const struct bt_mesh_schedule_entry *entry = &srv->sch_reg[idx];
+
+	return entry->action < BT_MESH_SCHEDULER_SCENE_RECALL ||
+	       (entry->action == BT_MESH_SCHEDULER_SCENE_RECALL &&
+		entry->scene_number != 0);
+}
+
 static bool revise_year(struct tm *sched_time,
 			struct tm *current_local,
 			struct bt_mesh_schedule_entry *entry,
@@ -354,6 +364,8 @@ static void run_scheduler(struct bt_mesh_scheduler_srv *srv)
 	uint8_t planned_idx = get_least_time_index(srv);
 
 	if (planned_idx == BT_MESH_SCHEDULER_ACTION_ENTRY_COUNT) {
+		srv->idx = BT_MESH_SCHEDULER_ACTION_ENTRY_COUNT;
+		k_work_cancel_delayable(&srv->delayed_work);
 		return;
 	}
 
@@ -366,12 +378,33 @@ static void run_scheduler(struct bt_mesh_scheduler_srv *srv)
 	BT_DBG("Scheduler started. Target uptime: %lld", scheduled_uptime);
 }
 
+/* Only a change to the planned entry, or an entry that is now due before it,
+ * changes which action runs next.
+ */
+static bool is_planned_changed(struct bt_mesh_scheduler_srv *srv, uint8_t idx)
+{
+	if (srv->idx == BT_MESH_SCHEDULER_ACTION_ENTRY_COUNT ||
+	    srv->idx == idx) {
+		return true;
+	}
+
+	return (srv->active_bitmap & BIT(idx)) &&
+	       srv->sched_tai[idx].sec < srv->sched_tai[srv->idx].sec;
+}
+
 static void schedule_action(struct bt_mesh_scheduler_srv *srv,
 			    uint8_t idx)
 {
 	struct tm sched_time;
 	struct bt_mesh_schedule_entry *entry = &srv->sch_reg[idx];
 
+	/* Stays inactive unless a new time is found for the entry. */
+	WRITE_BIT(srv->active_bitmap, idx, 0);
+
+	if (!is_entry_schedulable(srv, idx)) {
+		return;
+	}
+
 	int64_t current_uptime = k_uptime_get();
 	struct tm *current_local = bt_mesh_time_srv_localtime(srv->time_srv,
 			current_uptime);
@@ -610,10 +643,9 @@ static int action_set(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
 	srv->sch_reg[idx] = tmp;
 	BT_DBG("Rx: scheduler server action index %d set, ack %d", idx, ack);
 
-	if (srv->sch_reg[idx].action < BT_MESH_SCHEDULER_SCENE_RECALL ||
-	   (srv->sch_reg[idx].action == BT_MESH_SCHEDULER_SCENE_RECALL &&
-	    srv->sch_reg[idx].scene_number != 0)) {
-		schedule_action(srv, idx);
+	schedule_action(srv, idx);
+
+	if (is_planned_changed(srv, idx)) {
 		run_scheduler(srv);
 	}
 
@@ -77,6 +77,48 @@ static void cadence_store(struct bt_mesh_sensor_srv *srv)
 }
 
 
+#if CONFIG_BT_MESH_SENSOR_SRV_STATUS_CACHE
+BUILD_ASSERT(sizeof(((struct bt_mesh_sensor *)0)->state.cache) ==
+	     BT_MESH_SENSOR_STATUS_MAXLEN);
+#endif
+
+static void status_cache_update(struct bt_mesh_sensor *sensor,
+				const struct net_buf_simple *buf,
+				uint16_t offset)
+{
+#if CONFIG_BT_MESH_SENSOR_SRV_STATUS_CACHE
+	uint16_t len = buf->len - offset;
+
+	if (len > sizeof(sensor->state.cache)) {
+		sensor->state.cache_len = 0;
+		return;
+	}
+
+	memcpy(sensor->state.cache, &buf->data[offset], len);
+	sensor->state.cache_len = len;
+	sensor->state.cache_time = k_uptime_get_32();
+#endif
+}
+
+static bool status_cache_get(struct bt_mesh_sensor *sensor,
+			     struct net_buf_simple *buf)
+{
+#if CONFIG_BT_MESH_SENSOR_SRV_STATUS_CACHE
+	if (!sensor->state.cache_len ||
+	    (k_uptime_get_32() - sensor->state.cache_time >=
+	     CONFIG_BT_MESH_SENSOR_SRV_STATUS_CACHE_TIMEOUT) ||
+	    net_buf_simple_tailroom(buf) < sensor->state.cache_len) {
+		return false;
+	}
+
+	net_buf_simple_add_mem(buf, sensor->state.cache,
+			       sensor->state.cache_len);
+	return true;
+#else
+	return false;
+#endif
+}
+
 static int value_get(struct bt_mesh_sensor *sensor, struct bt_mesh_msg_ctx *ctx,
 		     struct sensor_value *value)
 {
@@ -102,8 +144,13 @@ static int buf_status_add(struct bt_mesh_sensor *sensor,
 			  struct net_buf_simple *buf)
 {
 	struct sensor_value value[CONFIG_BT_MESH_SENSOR_CHANNELS_MAX] = {};
+	uint16_t offset = buf->len;
 	int err;
 
+	if (status_cache_get(sensor, buf)) {
+		return 0;
+	}
+
 	err = value_get(sensor, ctx, value);
 	if (err) {
 		sensor_status_id_encode(buf, 0, sensor->type->id);
@@ -115,9 +162,12 @@ static int buf_status_add(struct bt_mesh_sensor *sensor,
 		BT_WARN("Sensor value encode for 0x%04x: %d", sensor->type->id,
 			err);
 		sensor_status_id_encode(buf, 0, sensor->type->id);
+		return err;
 	}
 
-	return err;
+	status_cache_update(sensor, buf, offset);
+
+	return 0;
 }
 
 static int handle_descriptor_get(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
@@ -801,11 +851,15 @@ static void pub_msg_add(struct bt_mesh_sensor_srv *srv,
 		return;
 	}
 
+	uint16_t offset = srv->pub.msg->len;
+
 	err = sensor_status_encode(srv->pub.msg, s, value);
 	if (err) {
 		return;
 	}
 
+	status_cache_update(s, srv->pub.msg, offset);
+
 	s->state.prev = value[0];
 	s->state.seq = srv->seq;
 }
@@ -915,6 +969,9 @@ static void sensor_srv_reset(struct bt_mesh_model *model)
 		s->state.pub_div = 0;
 		s->state.min_int = 0;
 		memset(&s->state.threshold, 0, sizeof(s->state.threshold));
+#if CONFIG_BT_MESH_SENSOR_SRV_STATUS_CACHE
+		s->state.cache_len = 0;
+#endif
 	}
 
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
@@ -998,6 +1055,8 @@ int bt_mesh_sensor_srv_pub(struct bt_mesh_sensor_srv *srv,
 		return err;
 	}
 
+	status_cache_update(sensor, &msg,
+			    BT_MESH_MODEL_OP_LEN(BT_MESH_SENSOR_OP_STATUS));
 	sensor_cadence_update(sensor, value);
 
 	err = model_send(srv->model, ctx, &msg);
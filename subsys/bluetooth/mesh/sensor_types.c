@@ -180,6 +180,11 @@ struct scalar_repr {
 	int64_t value;
 };
 
+/* Highest divisor for which the fractional part of a value can be scaled in
+ * 32 bits. Most formats stay below it, and avoid 64-bit division.
+ */
+#define MICRO_DIV_MAX (INT32_MAX / 1000000)
+
 static int64_t mul_scalar(int64_t val, const struct scalar_repr *repr)
 {
 	return (repr->flags & DIVIDE) ? (val / repr->value) :
@@ -243,8 +248,18 @@ static int scalar_encode(const struct bt_mesh_sensor_format *format,
 		return -ENOMEM;
 	}
 
-	int64_t raw = div_scalar(val->val1, repr) +
-		    div_scalar(val->val2, repr) / 1000000LL;
+	int64_t raw;
+
+	if (!(repr->flags & DIVIDE)) {
+		/* The fraction is always truncated away when dividing. */
+		raw = (int32_t)val->val1 / (int32_t)repr->value;
+	} else if (repr->value <= MICRO_DIV_MAX) {
+		raw = (int64_t)val->val1 * repr->value +
+		      (int32_t)val->val2 * (int32_t)repr->value / 1000000;
+	} else {
+		raw = div_scalar(val->val1, repr) +
+		      div_scalar(val->val2, repr) / 1000000LL;
+	}
 
 	int64_t max_value = scalar_max(format);
 	int32_t min_value = scalar_min(format);
@@ -355,10 +370,26 @@ static int scalar_decode(const struct bt_mesh_sensor_format *format,
 		return 0;
 	}
 
-	int64_t million = mul_scalar(raw * 1000000LL, repr);
+	if (!(repr->flags & DIVIDE)) {
+		val->val1 = raw * repr->value;
+		val->val2 = 0;
+	} else if (repr->value <= MICRO_DIV_MAX && raw >= INT32_MIN &&
+		   raw <= INT32_MAX) {
+		/* Split into integer and fraction first, so that both fit in
+		 * 32 bits. Gives the same result as dividing the value in
+		 * millionths.
+		 */
+		int32_t div = repr->value;
+		int32_t rem = (int32_t)raw % div;
+
+		val->val1 = (int32_t)raw / div;
+		val->val2 = rem * 1000000 / div;
+	} else {
+		int64_t million = mul_scalar(raw * 1000000LL, repr);
 
-	val->val1 = million / 1000000LL;
-	val->val2 = million % 1000000LL;
+		val->val1 = million / 1000000LL;
+		val->val2 = million % 1000000LL;
+	}
 
 	return 0;
 }
@@ -1202,10 +1233,30 @@ SENSOR_TYPE(rel_dev_runtime_in_a_generic_level_range) = {
 
 /******************************************************************************/
 
+#if CONFIG_BT_MESH_SENSOR_TYPE_CACHE_SIZE
+/* Recently looked up sensor types, indexed by their ID. The entries are only
+ * hints, and are verified before they're used.
+ */
+static const struct bt_mesh_sensor_type
+	*type_cache[CONFIG_BT_MESH_SENSOR_TYPE_CACHE_SIZE];
+#endif
+
 const struct bt_mesh_sensor_type *bt_mesh_sensor_type_get(uint16_t id)
 {
+#if CONFIG_BT_MESH_SENSOR_TYPE_CACHE_SIZE
+	const struct bt_mesh_sensor_type **entry =
+		&type_cache[id % CONFIG_BT_MESH_SENSOR_TYPE_CACHE_SIZE];
+
+	if (*entry && (*entry)->id == id) {
+		return *entry;
+	}
+#endif
+
 	Z_STRUCT_SECTION_FOREACH(bt_mesh_sensor_type, type) {
 		if (type->id == id) {
+#if CONFIG_BT_MESH_SENSOR_TYPE_CACHE_SIZE
+			*entry = type;
+#endif
 			return type;
 		}
 	}
@@ -346,11 +346,10 @@ int bt_id_delete(uint8_t id)
 
 size_t bt_data_buf_size(const struct bt_data *data)
 {
-	size_t buffer_size_max = 9;
-
-	buffer_size_max += sizeof(uint8_t) * data->data_len;
+	size_t data_size = sizeof(uint8_t) * data->data_len;
 
-	return buffer_size_max;
+	return SER_UINT_SIZE(data->type) + SER_UINT_SIZE(data->data_len) +
+	       SER_BUFFER_SIZE(data->data, data_size);
 }
 
 size_t bt_data_sp_size(const struct bt_data *data)
@@ -1592,6 +1591,46 @@ decoding_error:
 NRF_RPC_CBOR_CMD_DECODER(bt_rpc_grp, bt_le_scan_cb_recv, BT_LE_SCAN_CB_RECV_RPC_CMD,
 			 bt_le_scan_cb_recv_rpc_handler, NULL);
 
+static void bt_le_scan_cb_recv_batch_rpc_handler(CborValue *value, void *handler_data)
+{
+	size_t count;
+	struct bt_le_scan_recv_info *info;
+	struct net_buf_simple *buf;
+	struct ser_scratchpad scratchpad;
+
+	SER_SCRATCHPAD_DECLARE(&scratchpad, value);
+
+	count = ser_decode_uint(value);
+
+	/* All reports are decoded into the scratchpad before any callback is called,
+	 * so that the input packet is released first.
+	 */
+	info = ser_scratchpad_add(&scratchpad, count * sizeof(struct bt_le_scan_recv_info));
+	buf = ser_scratchpad_add(&scratchpad, count * sizeof(struct net_buf_simple));
+
+	for (size_t i = 0; i < count; i++) {
+		bt_le_scan_recv_info_dec(&scratchpad, &info[i]);
+		net_buf_simple_dec(&scratchpad, &buf[i]);
+	}
+
+	if (!ser_decoding_done_and_check(value)) {
+		goto decoding_error;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		bt_le_scan_cb_recv(&info[i], &buf[i]);
+	}
+
+	ser_rsp_send_void();
+
+	return;
+decoding_error:
+	report_decoding_error(BT_LE_SCAN_CB_RECV_BATCH_RPC_CMD, handler_data);
+}
+
+NRF_RPC_CBOR_CMD_DECODER(bt_rpc_grp, bt_le_scan_cb_recv_batch, BT_LE_SCAN_CB_RECV_BATCH_RPC_CMD,
+			 bt_le_scan_cb_recv_batch_rpc_handler, NULL);
+
 static void bt_le_scan_cb_timeout(void)
 {
 	struct bt_le_scan_cb *listener;
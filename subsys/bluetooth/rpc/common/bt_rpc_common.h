@@ -115,6 +115,7 @@ enum bt_rpc_cmd_from_host_to_cli {
 	BT_LE_EXT_ADV_CB_CONNECTED_CALLBACK_RPC_CMD,
 	BT_LE_SCAN_CB_RECV_RPC_CMD,
 	BT_LE_SCAN_CB_TIMEOUT_RPC_CMD,
+	BT_LE_SCAN_CB_RECV_BATCH_RPC_CMD,
 	BT_FOREACH_BOND_CB_CALLBACK_RPC_CMD,
 	PER_ADV_SYNC_CB_SYNCED_RPC_CMD,
 	PER_ADV_SYNC_CB_TERM_RPC_CMD,
@@ -8,11 +8,10 @@
 #include <stdint.h>
 
 #include <zephyr.h>
+#include <sys/atomic.h>
 
 #include "cbkproxy.h"
 
-static K_MUTEX_DEFINE(mutex);
-
 #if CONFIG_CBKPROXY_OUT_SLOTS > 0
 
 #if CONFIG_CBKPROXY_OUT_SLOTS > 16383
@@ -43,7 +42,7 @@ static K_MUTEX_DEFINE(mutex);
 #define TABLE_ENTRY4096 TABLE_ENTRY2048 TABLE_ENTRY2048
 #define TABLE_ENTRY8192 TABLE_ENTRY4096 TABLE_ENTRY4096
 
-static void *out_callbacks[CONFIG_CBKPROXY_OUT_SLOTS];
+static atomic_ptr_t out_callbacks[CONFIG_CBKPROXY_OUT_SLOTS];
 
 __attribute__((naked))
 static void callback_jump_table_start(void)
@@ -117,9 +116,11 @@ void *cbkproxy_out_get(int index, void *handler)
 
 	if (index >= CONFIG_CBKPROXY_OUT_SLOTS || index < 0) {
 		return NULL;
-	} else if (!out_callbacks[index]) {
-		out_callbacks[index] = handler;
-	} else if (out_callbacks[index] != handler) {
+	}
+
+	/* Assign the slot if it is free, otherwise it must match. */
+	if (!atomic_ptr_cas(&out_callbacks[index], NULL, handler) &&
+	    atomic_ptr_get(&out_callbacks[index]) != handler) {
 		return NULL;
 	}
 
@@ -137,64 +138,47 @@ void *cbkproxy_out_get(int index, void *handler)
 #endif /* CONFIG_CBKPROXY_OUT_SLOTS > 0 */
 
 #if CONFIG_CBKPROXY_IN_SLOTS > 0
-static struct
-{
-	intptr_t callback;
-	uint16_t gt;
-	uint16_t lt;
-} in_slots[CONFIG_CBKPROXY_IN_SLOTS];
+/* Open addressing hash table of callbacks, the slot number is the index. */
+static atomic_ptr_t in_slots[CONFIG_CBKPROXY_IN_SLOTS];
 
-static uint32_t next_free_in_slot;
+static inline uint32_t in_slot_hash(void *callback)
+{
+	/* Fibonacci hashing spreads the aligned function addresses. */
+	return ((uint32_t)(uintptr_t)callback * 2654435761u) %
+	       CONFIG_CBKPROXY_IN_SLOTS;
+}
 
 int cbkproxy_in_set(void *callback)
 {
-	int index = 0;
-	uint16_t *attach_to = NULL;
-	uintptr_t callback_int = (uintptr_t)callback;
-
-	k_mutex_lock(&mutex, K_FOREVER);
-
-	if (next_free_in_slot == 0) {
-		attach_to = &in_slots[0].lt;
-	} else {
-		do {
-			if (callback_int == in_slots[index].callback) {
-				attach_to = NULL;
-				break;
-			} else if (callback_int < in_slots[index].callback) {
-				attach_to = &in_slots[index].lt;
-			} else {
-				attach_to = &in_slots[index].gt;
-			}
-			index = *attach_to;
-		} while (index > 0);
-	}
+	uint32_t index = in_slot_hash(callback);
+	void *slot;
 
-	if (attach_to) {
-		if (next_free_in_slot >= CONFIG_CBKPROXY_IN_SLOTS) {
-			index = -1;
-		} else {
-			index = next_free_in_slot;
-			next_free_in_slot++;
-			*attach_to = index;
-			in_slots[index].callback = callback_int;
-			in_slots[index].gt = 0;
-			in_slots[index].lt = 0;
+	for (size_t i = 0; i < CONFIG_CBKPROXY_IN_SLOTS; i++) {
+		slot = atomic_ptr_get(&in_slots[index]);
+
+		if (slot == NULL &&
+		    atomic_ptr_cas(&in_slots[index], NULL, callback)) {
+			return index;
+		}
+
+		/* The slot may have been taken by this callback concurrently. */
+		if (atomic_ptr_get(&in_slots[index]) == callback) {
+			return index;
 		}
-	}
 
-	k_mutex_unlock(&mutex);
+		index = (index + 1) % CONFIG_CBKPROXY_IN_SLOTS;
+	}
 
-	return index;
+	return -1;
 }
 
 void *cbkproxy_in_get(int index)
 {
-	if ((index >= next_free_in_slot) || (index < 0)) {
+	if ((index >= CONFIG_CBKPROXY_IN_SLOTS) || (index < 0)) {
 		return NULL;
 	}
 
-	return (void *) in_slots[index].callback;
+	return atomic_ptr_get(&in_slots[index]);
 }
 
 #else
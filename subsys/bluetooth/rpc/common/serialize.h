@@ -27,6 +27,26 @@
  */
 #define SCRATCHPAD_ALIGN(size) WB_UP(size)
 
+/** @brief Get the exact size of an encoded unsigned integer.
+ *
+ * Evaluates to a constant expression for a constant @p _value.
+ *
+ * @param[in] _value Unsigned integer value.
+ *
+ * @retval Number of bytes written by @ref ser_encode_uint.
+ */
+#define SER_UINT_SIZE(_value)							\
+	((_value) < 24 ? 1 : (_value) <= UINT8_MAX ? 2 : (_value) <= UINT16_MAX ? 3 : 5)
+
+/** @brief Get the exact size of an encoded buffer.
+ *
+ * @param[in] _data Buffer data, NULL buffer is encoded as a null value.
+ * @param[in] _size Buffer size.
+ *
+ * @retval Number of bytes written by @ref ser_encode_buffer.
+ */
+#define SER_BUFFER_SIZE(_data, _size) (!(_data) ? 1 : SER_UINT_SIZE(_size) + (_size))
+
 /** @brief Alloc the scratchpad. Scratchpad is used to store a data when decoding serialized data.
  *
  *  @param[in] _scratchpad Scratchpad name.
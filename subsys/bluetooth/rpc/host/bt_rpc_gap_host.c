@@ -1061,8 +1061,8 @@ void bt_le_scan_recv_info_enc(CborEncoder *encoder, const struct bt_le_scan_recv
 	ser_encode_uint(encoder, data->secondary_phy);
 }
 
-void bt_le_scan_cb_recv(const struct bt_le_scan_recv_info *info,
-			struct net_buf_simple *buf)
+static void bt_le_scan_cb_recv_send(const struct bt_le_scan_recv_info *info,
+				    struct net_buf_simple *buf)
 {
 	struct nrf_rpc_cbor_ctx ctx;
 	size_t scratchpad_size = 0;
@@ -1084,11 +1084,137 @@ void bt_le_scan_cb_recv(const struct bt_le_scan_recv_info *info,
 				&ctx, ser_rsp_decode_void, NULL);
 }
 
+#if CONFIG_BT_RPC_SCAN_REPORT_BATCH_SIZE > 0
+/* Scan report stored in the batch buffer, followed by the advertising data. */
+struct scan_report {
+	struct bt_le_scan_recv_info info;
+	bt_addr_le_t addr;
+	uint16_t len;
+	uint8_t data[];
+};
+
+static uint8_t scan_batch_buf[CONFIG_BT_RPC_SCAN_REPORT_BATCH_SIZE] __aligned(4);
+static size_t scan_batch_len;
+static size_t scan_batch_count;
+static K_MUTEX_DEFINE(scan_batch_mutex);
+
+static size_t scan_report_size(size_t data_len)
+{
+	return WB_UP(sizeof(struct scan_report) + data_len);
+}
+
+/* Must be called with scan_batch_mutex locked. */
+static void scan_batch_flush(void)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	struct scan_report *report;
+	struct net_buf_simple buf;
+	size_t scratchpad_size = 0;
+	size_t buffer_size_max = 10;
+	size_t offset;
+
+	if (scan_batch_count == 0) {
+		return;
+	}
+
+	for (offset = 0; offset < scan_batch_len; offset += scan_report_size(report->len)) {
+		report = (struct scan_report *)&scan_batch_buf[offset];
+		net_buf_simple_init_with_data(&buf, report->data, report->len);
+
+		buffer_size_max += bt_le_scan_recv_info_buf_size(&report->info);
+		buffer_size_max += net_buf_simple_buf_size(&buf);
+
+		scratchpad_size += bt_le_scan_recv_info_sp_size(&report->info);
+		scratchpad_size += net_buf_simple_sp_size(&buf);
+	}
+
+	/* Client decodes all the reports before calling the callbacks. */
+	scratchpad_size += SCRATCHPAD_ALIGN(scan_batch_count *
+					    sizeof(struct bt_le_scan_recv_info));
+	scratchpad_size += SCRATCHPAD_ALIGN(scan_batch_count * sizeof(struct net_buf_simple));
+
+	NRF_RPC_CBOR_ALLOC(ctx, buffer_size_max);
+	ser_encode_uint(&ctx.encoder, scratchpad_size);
+	ser_encode_uint(&ctx.encoder, scan_batch_count);
+
+	for (offset = 0; offset < scan_batch_len; offset += scan_report_size(report->len)) {
+		report = (struct scan_report *)&scan_batch_buf[offset];
+		net_buf_simple_init_with_data(&buf, report->data, report->len);
+
+		bt_le_scan_recv_info_enc(&ctx.encoder, &report->info);
+		net_buf_simple_enc(&ctx.encoder, &buf);
+	}
+
+	scan_batch_len = 0;
+	scan_batch_count = 0;
+
+	nrf_rpc_cbor_cmd_no_err(&bt_rpc_grp, BT_LE_SCAN_CB_RECV_BATCH_RPC_CMD,
+				&ctx, ser_rsp_decode_void, NULL);
+}
+
+static void scan_batch_work_handler(struct k_work *work)
+{
+	k_mutex_lock(&scan_batch_mutex, K_FOREVER);
+	scan_batch_flush();
+	k_mutex_unlock(&scan_batch_mutex);
+}
+
+static K_WORK_DELAYABLE_DEFINE(scan_batch_work, scan_batch_work_handler);
+
+void bt_le_scan_cb_recv(const struct bt_le_scan_recv_info *info,
+			struct net_buf_simple *buf)
+{
+	struct scan_report *report;
+	size_t size = scan_report_size(buf->len);
+
+	k_mutex_lock(&scan_batch_mutex, K_FOREVER);
+
+	if (scan_batch_len + size > sizeof(scan_batch_buf)) {
+		scan_batch_flush();
+	}
+
+	if (size > sizeof(scan_batch_buf)) {
+		/* Report does not fit in the batch at all. */
+		bt_le_scan_cb_recv_send(info, buf);
+		k_mutex_unlock(&scan_batch_mutex);
+		return;
+	}
+
+	report = (struct scan_report *)&scan_batch_buf[scan_batch_len];
+	report->info = *info;
+	bt_addr_le_copy(&report->addr, info->addr);
+	report->info.addr = &report->addr;
+	report->len = buf->len;
+	memcpy(report->data, buf->data, buf->len);
+
+	scan_batch_len += size;
+	scan_batch_count++;
+
+	k_mutex_unlock(&scan_batch_mutex);
+
+	/* Does not reschedule if the batch is already waiting. */
+	k_work_schedule(&scan_batch_work, K_MSEC(CONFIG_BT_RPC_SCAN_REPORT_BATCH_TIMEOUT));
+}
+#else
+void bt_le_scan_cb_recv(const struct bt_le_scan_recv_info *info,
+			struct net_buf_simple *buf)
+{
+	bt_le_scan_cb_recv_send(info, buf);
+}
+#endif /* CONFIG_BT_RPC_SCAN_REPORT_BATCH_SIZE > 0 */
+
 void bt_le_scan_cb_timeout(void)
 {
 	struct nrf_rpc_cbor_ctx ctx;
 	size_t buffer_size_max = 0;
 
+#if CONFIG_BT_RPC_SCAN_REPORT_BATCH_SIZE > 0
+	/* Pending reports are delivered before the timeout. */
+	k_mutex_lock(&scan_batch_mutex, K_FOREVER);
+	scan_batch_flush();
+	k_mutex_unlock(&scan_batch_mutex);
+#endif
+
 	NRF_RPC_CBOR_ALLOC(ctx, buffer_size_max);
 
 	nrf_rpc_cbor_cmd_no_err(&bt_rpc_grp, BT_LE_SCAN_CB_TIMEOUT_RPC_CMD,
@@ -6,6 +6,7 @@
 
 #include <zephyr.h>
 #include <sys/byteorder.h>
+#include <sys/crc.h>
 #include <string.h>
 #include <bluetooth/scan.h>
 
@@ -55,6 +56,11 @@ struct bt_scan_name_filter {
 	 */
 	char target_name[CONFIG_BT_SCAN_NAME_CNT][CONFIG_BT_SCAN_NAME_MAX_LEN];
 
+	/* Length of each target name, cached so that advertised names
+	 * longer than the target are rejected without a string compare.
+	 */
+	uint8_t target_name_len[CONFIG_BT_SCAN_NAME_CNT];
+
 	/* Name filter counter. */
 	uint8_t cnt;
 
@@ -72,6 +78,9 @@ struct bt_scan_short_name_filter {
 		 */
 		char target_name[CONFIG_BT_SCAN_SHORT_NAME_MAX_LEN];
 
+		/* Length of the short name. */
+		uint8_t len;
+
 		/* Minimum length of the short name. */
 		uint8_t min_len;
 	} name[CONFIG_BT_SCAN_SHORT_NAME_CNT];
@@ -230,6 +239,29 @@ struct conn_blocklist {
 };
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
 
+#if CONFIG_BT_SCAN_DUPLICATE_FILTER
+/* Duplicate filter entry. */
+struct duplicate_filter_entry {
+	/* Advertiser address. */
+	bt_addr_le_t addr;
+
+	/* Hash of the advertising data. */
+	uint32_t data_hash;
+
+	/* Uptime of the last report passed to the application, in ms. */
+	uint32_t timestamp;
+
+	/* Entry is in use. */
+	bool used;
+};
+
+/* Duplicate filter. */
+struct duplicate_filter {
+	/* Array of the recently reported advertisers. */
+	struct duplicate_filter_entry entry[CONFIG_BT_SCAN_DUPLICATE_FILTER_LEN];
+};
+#endif /* CONFIG_BT_SCAN_DUPLICATE_FILTER */
+
 /* Scanning module instance. Options for the different scanning modes.
  * This structure stores all module settings. It is used to enable
  * or disable scanning modes and to configure filters.
@@ -264,6 +296,16 @@ static struct bt_scan {
 	struct conn_blocklist blocklist;
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
 
+#if CONFIG_BT_SCAN_DUPLICATE_FILTER
+	/* Scan duplicate filter. */
+	struct duplicate_filter duplicate_filter;
+#endif /* CONFIG_BT_SCAN_DUPLICATE_FILTER */
+
+#if CONFIG_BT_SCAN_FILTER_STATS
+	/* Filter match and reject counters. */
+	struct bt_scan_filter_stats stats;
+#endif /* CONFIG_BT_SCAN_FILTER_STATS */
+
 } bt_scan;
 
 static sys_slist_t callback_list;
@@ -451,6 +493,61 @@ static bool conn_attempts_exceeded(const bt_addr_le_t *addr)
 
 #endif /* CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER */
 
+#if CONFIG_BT_SCAN_DUPLICATE_FILTER
+static bool duplicate_report_check(const bt_addr_le_t *addr,
+				   const struct net_buf_simple *ad)
+{
+	struct duplicate_filter *filter = &bt_scan.duplicate_filter;
+	struct duplicate_filter_entry *victim = NULL;
+	uint32_t victim_age = 0;
+	uint32_t now = k_uptime_get_32();
+	uint32_t hash = crc32_ieee(ad->data, ad->len);
+	bool duplicate = false;
+
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(filter->entry); i++) {
+		struct duplicate_filter_entry *entry = &filter->entry[i];
+		uint32_t age = now - entry->timestamp;
+
+		if (!entry->used) {
+			age = UINT32_MAX;
+		} else if ((entry->data_hash == hash) &&
+			   (bt_addr_le_cmp(addr, &entry->addr) == 0)) {
+			if (age < CONFIG_BT_SCAN_DUPLICATE_FILTER_TIMEOUT) {
+				duplicate = true;
+			} else {
+				/* The time window expired, report the device
+				 * again and start a new window.
+				 */
+				entry->timestamp = now;
+			}
+
+			goto out;
+		}
+
+		/* Keep track of the least recently reported entry. */
+		if (!victim || (age > victim_age)) {
+			victim = entry;
+			victim_age = age;
+		}
+	}
+
+	/* New advertiser or changed advertising data,
+	 * overwrite the least recently reported entry.
+	 */
+	bt_addr_le_copy(&victim->addr, addr);
+	victim->data_hash = hash;
+	victim->timestamp = now;
+	victim->used = true;
+
+out:
+	k_mutex_unlock(&scan_mutex);
+
+	return duplicate;
+}
+#endif /* CONFIG_BT_SCAN_DUPLICATE_FILTER */
+
 static bool scan_device_filter_check(const bt_addr_le_t *addr)
 {
 #if CONFIG_BT_SCAN_BLOCKLIST
@@ -575,9 +672,14 @@ static int scan_addr_filter_add(const bt_addr_le_t *target_addr)
 
 static bool adv_name_cmp(const uint8_t *data,
 			 uint8_t data_len,
-			 const char *target_name)
+			 const char *target_name,
+			 uint8_t target_name_len)
 {
-	return strncmp(target_name, data, data_len) == 0;
+	if (data_len > target_name_len) {
+		return false;
+	}
+
+	return memcmp(target_name, data, data_len) == 0;
 }
 
 static bool adv_name_compare(const struct bt_data *data,
@@ -592,7 +694,8 @@ static bool adv_name_compare(const struct bt_data *data,
 	for (size_t i = 0; i < counter; i++) {
 		if (adv_name_cmp(data->data,
 				 data_len,
-				 name_filter->target_name[i])) {
+				 name_filter->target_name[i],
+				 name_filter->target_name_len[i])) {
 
 			control->filter_status.name.name =
 				name_filter->target_name[i];
@@ -643,7 +746,9 @@ static int scan_name_filter_add(const char *name)
 
 	/* Check for duplicated filter. */
 	for (size_t i = 0; i < counter; i++) {
-		if (!strcmp(bt_scan.scan_filters.name.target_name[i], name)) {
+		if ((bt_scan.scan_filters.name.target_name_len[i] == name_len) &&
+		    !memcmp(bt_scan.scan_filters.name.target_name[i], name,
+			    name_len)) {
 			return 0;
 		}
 	}
@@ -651,6 +756,7 @@ static int scan_name_filter_add(const char *name)
 	/* Add name to filter. */
 	memcpy(bt_scan.scan_filters.name.target_name[counter],
 	       name, name_len);
+	bt_scan.scan_filters.name.target_name_len[counter] = name_len;
 
 	bt_scan.scan_filters.name.cnt++;
 
@@ -662,10 +768,12 @@ static int scan_name_filter_add(const char *name)
 static bool adv_short_name_cmp(const uint8_t *data,
 			       uint8_t data_len,
 			       const char *target_name,
+			       uint8_t target_name_len,
 			       uint8_t short_name_min_len)
 {
 	if ((data_len >= short_name_min_len) &&
-	    (strncmp(target_name, data, data_len) == 0)) {
+	    (data_len <= target_name_len) &&
+	    (memcmp(target_name, data, data_len) == 0)) {
 		return true;
 	}
 
@@ -685,6 +793,7 @@ static bool adv_short_name_compare(const struct bt_data *data,
 		if (adv_short_name_cmp(data->data,
 				       data_len,
 				       name_filter->name[i].target_name,
+				       name_filter->name[i].len,
 				       name_filter->name[i].min_len)) {
 
 			control->filter_status.short_name.name =
@@ -740,13 +849,15 @@ static int scan_short_name_filter_add(const struct bt_scan_short_name *short_nam
 
 	/* Check for duplicated filter. */
 	for (size_t i = 0; i < counter; i++) {
-		if (!strcmp(short_name_filter->name[i].target_name,
-			    short_name->name)) {
+		if ((short_name_filter->name[i].len == name_len) &&
+		    !memcmp(short_name_filter->name[i].target_name,
+			    short_name->name, name_len)) {
 			return 0;
 		}
 	}
 
 	/* Add name to the filter. */
+	short_name_filter->name[counter].len = name_len;
 	short_name_filter->name[counter].min_len = short_name->min_len;
 	memcpy(short_name_filter->name[counter].target_name,
 	       short_name->name,
@@ -759,6 +870,25 @@ static int scan_short_name_filter_add(const struct bt_scan_short_name *short_nam
 	return 0;
 }
 
+static bool uuid_raw_match(const uint8_t *data,
+			   const struct bt_scan_uuid *target_uuid)
+{
+	switch (target_uuid->uuid->type) {
+	case BT_UUID_TYPE_16:
+		return sys_get_le16(data) == target_uuid->uuid_data.uuid_16.val;
+
+	case BT_UUID_TYPE_32:
+		return sys_get_le32(data) == target_uuid->uuid_data.uuid_32.val;
+
+	case BT_UUID_TYPE_128:
+		return memcmp(data, target_uuid->uuid_data.uuid_128.val,
+			      BT_SCAN_UUID_128_SIZE) == 0;
+
+	default:
+		return false;
+	}
+}
+
 static bool find_uuid(const uint8_t *data,
 		      uint8_t data_len,
 		      uint8_t uuid_type,
@@ -783,6 +913,19 @@ static bool find_uuid(const uint8_t *data,
 		return false;
 	}
 
+	/* UUIDs of the same type are compared on their raw encoding,
+	 * without decoding every advertised UUID for each filter entry.
+	 */
+	if (target_uuid->uuid->type == uuid_type) {
+		for (size_t i = 0; (i + uuid_len) <= data_len; i += uuid_len) {
+			if (uuid_raw_match(&data[i], target_uuid)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
 	for (size_t i = 0; i < data_len; i += uuid_len) {
 		struct bt_uuid_128 uuid;
 
@@ -1398,6 +1541,77 @@ static void check_enabled_filters(struct bt_scan_control *control)
 	}
 }
 
+static bool is_adv_data_filter_enabled(void)
+{
+	return is_name_filter_enabled() ||
+	       is_short_name_filter_enabled() ||
+	       is_uuid_filter_enabled() ||
+	       is_appearance_filter_enabled() ||
+	       is_manufacturer_data_filter_enabled();
+}
+
+#if CONFIG_BT_SCAN_FILTER_STATS
+static void filter_type_stats_update(struct bt_scan_filter_type_stats *stats,
+				     bool enabled, bool match)
+{
+	if (!enabled) {
+		return;
+	}
+
+	if (match) {
+		stats->match++;
+	} else {
+		stats->reject++;
+	}
+}
+
+static void filter_stats_update(const struct bt_scan_control *control)
+{
+	struct bt_scan_filter_stats *stats = &bt_scan.stats;
+	const struct bt_scan_filter_match *status = &control->filter_status;
+
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+
+	filter_type_stats_update(&stats->name, is_name_filter_enabled(),
+				 status->name.match);
+	filter_type_stats_update(&stats->short_name,
+				 is_short_name_filter_enabled(),
+				 status->short_name.match);
+	filter_type_stats_update(&stats->addr, is_addr_filter_enabled(),
+				 status->addr.match);
+	filter_type_stats_update(&stats->uuid, is_uuid_filter_enabled(),
+				 status->uuid.match);
+	filter_type_stats_update(&stats->appearance,
+				 is_appearance_filter_enabled(),
+				 status->appearance.match);
+	filter_type_stats_update(&stats->manufacturer_data,
+				 is_manufacturer_data_filter_enabled(),
+				 status->manufacturer_data.match);
+
+	k_mutex_unlock(&scan_mutex);
+}
+
+int bt_scan_filter_stats_get(struct bt_scan_filter_stats *stats)
+{
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+	*stats = bt_scan.stats;
+	k_mutex_unlock(&scan_mutex);
+
+	return 0;
+}
+
+void bt_scan_filter_stats_reset(void)
+{
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+	memset(&bt_scan.stats, 0, sizeof(bt_scan.stats));
+	k_mutex_unlock(&scan_mutex);
+}
+#endif /* CONFIG_BT_SCAN_FILTER_STATS */
+
 static bool adv_data_found(struct bt_data *data, void *user_data)
 {
 	struct bt_scan_control *scan_control =
@@ -1483,6 +1697,13 @@ static void scan_recv(const struct bt_le_scan_recv_info *info,
 	struct bt_scan_control scan_control;
 	struct net_buf_simple_state state;
 
+#if CONFIG_BT_SCAN_DUPLICATE_FILTER
+	/* Drop reports that do not bring anything new. */
+	if (duplicate_report_check(info->addr, ad)) {
+		return;
+	}
+#endif /* CONFIG_BT_SCAN_DUPLICATE_FILTER */
+
 	memset(&scan_control, 0, sizeof(scan_control));
 
 	scan_control.all_mode = bt_scan.scan_filters.all_mode;
@@ -1496,12 +1717,20 @@ static void scan_recv(const struct bt_le_scan_recv_info *info,
 	/* Check the address filter. */
 	check_addr(&scan_control, info->addr);
 
-	/* Save advertising buffer state to transfer it
+	/* All advertising data filters are checked in a single pass over
+	 * the AD structures. The pass is skipped if none of them is enabled.
+	 * Save advertising buffer state to transfer it
 	 * data to application if futher processing is needed.
 	 */
-	net_buf_simple_save(ad, &state);
-	bt_data_parse(ad, adv_data_found, (void *)&scan_control);
-	net_buf_simple_restore(ad, &state);
+	if (is_adv_data_filter_enabled()) {
+		net_buf_simple_save(ad, &state);
+		bt_data_parse(ad, adv_data_found, (void *)&scan_control);
+		net_buf_simple_restore(ad, &state);
+	}
+
+#if CONFIG_BT_SCAN_FILTER_STATS
+	filter_stats_update(&scan_control);
+#endif /* CONFIG_BT_SCAN_FILTER_STATS */
 
 	scan_control.device_info.recv_info = info;
 	scan_control.device_info.conn_param = &bt_scan.conn_param;
@@ -1609,6 +1838,15 @@ void bt_scan_blocklist_clear(void)
 }
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
 
+#if CONFIG_BT_SCAN_DUPLICATE_FILTER
+void bt_scan_duplicate_filter_clear(void)
+{
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+	memset(&bt_scan.duplicate_filter, 0, sizeof(bt_scan.duplicate_filter));
+	k_mutex_unlock(&scan_mutex);
+}
+#endif /* CONFIG_BT_SCAN_DUPLICATE_FILTER */
+
 #if CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER
 void bt_scan_conn_attempts_filter_clear(void)
 {
@@ -471,7 +471,8 @@ static void device_token_get(char *device_token)
 	LOG_DBG("Device token: %s", log_strdup(device_token));
 }
 
-static int gadgets_command_respond(struct bt_conn *conn)
+static int gadgets_command_respond(struct bt_conn *conn,
+				   const uint8_t *data, size_t len)
 {
 	ControlEnvelope control_response;
 	Response *response;
@@ -479,8 +480,7 @@ static int gadgets_command_respond(struct bt_conn *conn)
 	DeviceFeatures *dev_features;
 	bool success;
 
-	pb_istream_t stream_in =
-		pb_istream_from_buffer(protobuf_encoded, protobuf_offset);
+	pb_istream_t stream_in = pb_istream_from_buffer(data, len);
 
 	success = pb_decode(
 		&stream_in,
@@ -636,6 +636,43 @@ static void encoded_data_reset(void)
 	encoded_buffer_release();
 }
 
+/* Collect the payload of an incoming transaction.
+ * A transaction received in a single piece is decoded directly from
+ * the received data, without copying it to protobuf_encoded.
+ * The buffer is still acquired, as handlers re-use it for replies.
+ * Returns -EINPROGRESS if more data is needed to complete the transaction.
+ */
+static int stream_data_collect(const uint8_t *const data, uint16_t len,
+			       bool more_data, int user,
+			       const uint8_t **payload, size_t *payload_len)
+{
+	int err;
+
+	if (!more_data && (atomic_get(&protobuf_encoded_user) != user)) {
+		err = encoded_buffer_acquire(user);
+		if (err) {
+			return err;
+		}
+
+		*payload = data;
+		*payload_len = len;
+		return 0;
+	}
+
+	err = encoded_data_append(data, len, user);
+	if (err) {
+		return err;
+	}
+
+	if (more_data) {
+		return -EINPROGRESS;
+	}
+
+	*payload = protobuf_encoded;
+	*payload_len = protobuf_offset;
+	return 0;
+}
+
 static void gadgets_sent_cb(struct bt_conn *conn, const void *buf, bool success)
 {
 	enum buf_user user;
@@ -677,6 +714,8 @@ static bool gadgets_control_stream_cb(struct bt_conn *conn,
 				      const uint8_t *const data,
 				      uint16_t len, bool more_data)
 {
+	const uint8_t *payload;
+	size_t payload_len;
 	bool ret;
 	int err;
 
@@ -684,7 +723,9 @@ static bool gadgets_control_stream_cb(struct bt_conn *conn,
 		return false;
 	}
 
-	err = encoded_data_append(data, len, BUF_USER_CONTROL_STREAM);
+	err = stream_data_collect(data, len, more_data,
+				  BUF_USER_CONTROL_STREAM,
+				  &payload, &payload_len);
 	if (err == -EBUSY) {
 		LOG_WRN("Buffer busy");
 		return false;
@@ -692,14 +733,12 @@ static bool gadgets_control_stream_cb(struct bt_conn *conn,
 		LOG_WRN("Buffer overflow");
 		ret = false;
 		goto cleanup;
-	}
-
-	if (more_data) {
+	} else if (err == -EINPROGRESS) {
 		/* Wait for last piece of data */
 		return true;
 	}
 
-	err = gadgets_command_respond(conn);
+	err = gadgets_command_respond(conn, payload, payload_len);
 	if (err) {
 		LOG_WRN("Failed to reply to command message");
 		ret = false;
@@ -718,6 +757,8 @@ static bool gadgets_alexa_stream_cb(struct bt_conn *conn,
 				    const uint8_t *const data,
 				    uint16_t len, bool more_data)
 {
+	const uint8_t *payload;
+	size_t payload_len;
 	bool ret;
 	int err;
 
@@ -725,7 +766,9 @@ static bool gadgets_alexa_stream_cb(struct bt_conn *conn,
 		return false;
 	}
 
-	err = encoded_data_append(data, len, BUF_USER_ALEXA_STREAM);
+	err = stream_data_collect(data, len, more_data,
+				  BUF_USER_ALEXA_STREAM,
+				  &payload, &payload_len);
 	if (err == -EBUSY) {
 		LOG_WRN("Buffer busy");
 		return false;
@@ -733,17 +776,14 @@ static bool gadgets_alexa_stream_cb(struct bt_conn *conn,
 		LOG_WRN("Buffer overflow");
 		ret = false;
 		goto cleanup;
-	}
-
-	__ASSERT(err == 0, "Unhandled error");
-
-	if (more_data) {
+	} else if (err == -EINPROGRESS) {
 		/* Wait for last piece of data */
 		return true;
 	}
 
-	pb_istream_t stream_in =
-		pb_istream_from_buffer(protobuf_encoded, protobuf_offset);
+	__ASSERT(err == 0, "Unhandled error");
+
+	pb_istream_t stream_in = pb_istream_from_buffer(payload, payload_len);
 	bool success = pb_decode(
 		&stream_in,
 		&directive_DirectiveParserProto_msg,
@@ -770,7 +810,7 @@ static bool gadgets_alexa_stream_cb(struct bt_conn *conn,
 			 * for outoing messages.
 			 */
 			err = namespace_handlers[i].handler(
-				conn, name, protobuf_encoded, protobuf_offset);
+				conn, name, payload, payload_len);
 			if (err) {
 				LOG_ERR("Unsupported %s / %s", log_strdup(name),
 					log_strdup(namespace));
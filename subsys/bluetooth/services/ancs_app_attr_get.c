@@ -14,6 +14,7 @@
 #include <logging/log.h>
 #include <net/buf.h>
 #include "ancs_client_internal.h"
+#include "ancs_attr_parser.h"
 #include "ancs_app_attr_get.h"
 
 LOG_MODULE_DECLARE(ancs_c, CONFIG_BT_ANCS_CLIENT_LOG_LEVEL);
@@ -166,11 +167,10 @@ static int app_attr_get(struct bt_ancs_client *ancs_c, const uint8_t *app_id,
 	}
 
 	if (state == APP_ATTR_DONE) {
+		bt_ancs_parse_request_start(ancs_c);
 		err = bt_ancs_cp_write(ancs_c, buf.len, func);
-
-		ancs_c->parse_info.expected_number_of_attrs =
-			ancs_c->number_of_requested_attr;
 	} else {
+		atomic_clear_bit(&ancs_c->state, ANCS_CP_WRITE_PENDING);
 		err = -ENOMEM;
 	}
 
@@ -190,7 +190,5 @@ int bt_ancs_app_attr_request(struct bt_ancs_client *ancs_c,
 		return -EINVAL;
 	}
 
-	ancs_c->parse_info.parse_state = BT_ANCS_PARSE_STATE_COMMAND_ID;
-
 	return app_attr_get(ancs_c, app_id, len, func);
 }
@@ -29,6 +29,55 @@ static bool attr_is_requested(struct bt_ancs_client *ancs_c,
 	return ancs_c->parse_info.attr_list[attr.attr_id].get;
 }
 
+static uint32_t requested_attrs_count(const struct bt_ancs_attr_list *attr_list,
+				      uint32_t attr_count)
+{
+	uint32_t count = 0;
+
+	for (uint32_t i = 0; i < attr_count; i++) {
+		if (attr_list[i].get) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/**@brief Function for finishing the parsing of an attribute.
+ *
+ * @param[in] ancs_c   Pointer to an ANCS instance to which the event belongs.
+ *
+ * @return The next parse state.
+ */
+static enum bt_ancs_parse_state attr_done(struct bt_ancs_client *ancs_c)
+{
+	if (attr_is_requested(ancs_c, ancs_c->attr_response.attr)) {
+		bt_ancs_do_ds_notif_cb(ancs_c, &ancs_c->attr_response);
+	}
+	if (all_req_attrs_parsed(ancs_c)) {
+		/* The next response may follow in the same notification. */
+		return BT_ANCS_PARSE_STATE_COMMAND_ID;
+	} else {
+		return BT_ANCS_PARSE_STATE_ATTR_ID;
+	}
+}
+
+/**@brief Function for passing a chunk of attribute data to the application.
+ *
+ * @param[in] ancs_c   Pointer to an ANCS instance to which the event belongs.
+ * @param[in] data     Chunk of the attribute data.
+ * @param[in] len      Length of the chunk.
+ */
+static void attr_chunk(struct bt_ancs_client *ancs_c, const uint8_t *data,
+		       uint16_t len)
+{
+	if (ancs_c->ds_chunk_cb && len &&
+	    attr_is_requested(ancs_c, ancs_c->attr_response.attr)) {
+		ancs_c->ds_chunk_cb(ancs_c, &ancs_c->attr_response, data, len,
+				    ancs_c->parse_info.current_attr_index);
+	}
+}
+
 /**@brief Function for parsing command id and notification id.
  *        Used in the @ref parse_get_notif_attrs_response state machine.
  *
@@ -56,6 +105,9 @@ static enum bt_ancs_parse_state command_id_parse(struct bt_ancs_client *ancs_c,
 		ancs_c->attr_response.command_id = BT_ANCS_COMMAND_ID_GET_NOTIF_ATTRIBUTES;
 		ancs_c->parse_info.attr_list = ancs_c->ancs_notif_attr_list;
 		ancs_c->parse_info.attr_count = BT_ANCS_NOTIF_ATTR_COUNT;
+		ancs_c->parse_info.expected_number_of_attrs =
+			requested_attrs_count(ancs_c->ancs_notif_attr_list,
+					      BT_ANCS_NOTIF_ATTR_COUNT);
 		parse_state = BT_ANCS_PARSE_STATE_NOTIF_UID;
 		break;
 
@@ -63,6 +115,10 @@ static enum bt_ancs_parse_state command_id_parse(struct bt_ancs_client *ancs_c,
 		ancs_c->attr_response.command_id = BT_ANCS_COMMAND_ID_GET_APP_ATTRIBUTES;
 		ancs_c->parse_info.attr_list = ancs_c->ancs_app_attr_list;
 		ancs_c->parse_info.attr_count = BT_ANCS_APP_ATTR_COUNT;
+		ancs_c->parse_info.expected_number_of_attrs =
+			requested_attrs_count(ancs_c->ancs_app_attr_list,
+					      BT_ANCS_APP_ATTR_COUNT);
+		ancs_c->parse_info.current_app_id_index = 0;
 		parse_state = BT_ANCS_PARSE_STATE_APP_ID;
 		break;
 
@@ -193,24 +249,20 @@ static enum bt_ancs_parse_state attr_len2_parse(struct bt_ancs_client *ancs_c,
 		}
 	} else {
 		LOG_DBG("Attribute LEN %i ", ancs_c->attr_response.attr.attr_len);
-		if (attr_is_requested(ancs_c, ancs_c->attr_response.attr)) {
-			bt_ancs_do_ds_notif_cb(ancs_c, &ancs_c->attr_response);
-		}
-		if (all_req_attrs_parsed(ancs_c)) {
-			return BT_ANCS_PARSE_STATE_DONE;
-		} else {
-			return BT_ANCS_PARSE_STATE_ATTR_ID;
-		}
+		return attr_done(ancs_c);
 	}
 }
 
 /**@brief Function for parsing the data of an iOS attribute.
  *        Used in the @ref parse_get_notif_attrs_response state machine.
  *
- * @details Read the data of the attribute into our local buffer.
+ * @details Copy all the attribute data available in the received data into our local buffer
+ *          at once. Data that does not fit into the buffer is only passed to the chunk
+ *          callback.
  *
  * @param[in] ancs_c   Pointer to an ANCS instance to which the event belongs.
  * @param[in] data_src Pointer to data that was received from the Notification Provider.
+ * @param[in] data_len Length of the data that was received from the Notification Provider.
  * @param[in] index    Pointer to an index that helps us keep track of the current data
  *                     to be parsed.
  *
@@ -218,85 +270,78 @@ static enum bt_ancs_parse_state attr_len2_parse(struct bt_ancs_client *ancs_c,
  */
 static enum bt_ancs_parse_state attr_data_parse(struct bt_ancs_client *ancs_c,
 						const uint8_t *data_src,
+						uint16_t data_len,
 						uint32_t *index)
 {
-	/* We have not reached the end of the attribute, nor our max allocated internal size.
+	struct bt_ancs_attr *attr = &ancs_c->attr_response.attr;
+	/* Leave room for the NUL-terminator. */
+	uint16_t buf_len = ancs_c->parse_info.attr_list[attr->attr_id].attr_len - 1;
+	uint16_t attr_index = ancs_c->parse_info.current_attr_index;
+	uint16_t len = MIN(data_len - *index, attr->attr_len - attr_index);
+
+	attr_chunk(ancs_c, &data_src[*index], len);
+
+	/* We have not reached our max allocated internal size.
 	 * Proceed with copying data over to our buffer.
 	 */
-	if ((ancs_c->parse_info.current_attr_index <
-	     ancs_c->parse_info.attr_list[ancs_c->attr_response.attr.attr_id].attr_len) &&
-	    (ancs_c->parse_info.current_attr_index <
-	     ancs_c->attr_response.attr.attr_len)) {
-		/* Un-comment this line to see every byte of an attribute as it is parsed.
-		 * Commented out by default since it can overflow the uart buffer.
-		 */
-		/* LOG_DBG("Byte copied to buffer: %c", data_src[(*index)]); */
-		ancs_c->attr_response.attr
-			.attr_data[ancs_c->parse_info.current_attr_index++] =
-			data_src[(*index)++];
+	if (attr_index < buf_len) {
+		memcpy(&attr->attr_data[attr_index], &data_src[*index],
+		       MIN(len, buf_len - attr_index));
 	}
 
-	/* We have reached the end of the attribute, or our max allocated internal size.
-	 * Stop copying data over to our buffer. NUL-terminate at the current index.
-	 */
-	if ((ancs_c->parse_info.current_attr_index ==
-	     ancs_c->attr_response.attr.attr_len) ||
-	    (ancs_c->parse_info.current_attr_index ==
-	     ancs_c->parse_info.attr_list[ancs_c->attr_response.attr.attr_id].attr_len -
-		     1)) {
-		if (attr_is_requested(ancs_c, ancs_c->attr_response.attr)) {
-			ancs_c->attr_response.attr.attr_data
-				[ancs_c->parse_info.current_attr_index] = '\0';
-		}
+	*index += len;
+	ancs_c->parse_info.current_attr_index += len;
 
-		/* If our max buffer size is smaller than the remaining attribute data, we must
-		 * increase index to skip the data until the start of the next attribute.
-		 */
-		if (ancs_c->parse_info.current_attr_index <
-		    ancs_c->attr_response.attr.attr_len) {
-			return BT_ANCS_PARSE_STATE_ATTR_SKIP;
-		}
-		LOG_DBG("Attribute finished!");
-		if (attr_is_requested(ancs_c, ancs_c->attr_response.attr)) {
-			bt_ancs_do_ds_notif_cb(ancs_c, &ancs_c->attr_response);
-		}
-		if (all_req_attrs_parsed(ancs_c)) {
-			return BT_ANCS_PARSE_STATE_DONE;
-		} else {
-			return BT_ANCS_PARSE_STATE_ATTR_ID;
-		}
+	if (ancs_c->parse_info.current_attr_index < attr->attr_len) {
+		return BT_ANCS_PARSE_STATE_ATTR_DATA;
+	}
+
+	/* We have reached the end of the attribute.
+	 * NUL-terminate at the end of the copied data.
+	 */
+	if (attr_is_requested(ancs_c, *attr)) {
+		attr->attr_data[MIN(attr->attr_len, buf_len)] = '\0';
 	}
-	return BT_ANCS_PARSE_STATE_ATTR_DATA;
+
+	LOG_DBG("Attribute finished!");
+	return attr_done(ancs_c);
 }
 
 static enum bt_ancs_parse_state attr_skip(struct bt_ancs_client *ancs_c,
 					  const uint8_t *data_src,
+					  uint16_t data_len,
 					  uint32_t *index)
 {
-	/* We have not reached the end of the attribute, nor our max allocated internal size.
-	 * Proceed with copying data over to our buffer.
-	 */
-	if (ancs_c->parse_info.current_attr_index < ancs_c->attr_response.attr.attr_len) {
-		ancs_c->parse_info.current_attr_index++;
-		(*index)++;
-	}
+	struct bt_ancs_attr *attr = &ancs_c->attr_response.attr;
+	uint16_t len = MIN(data_len - *index,
+			   attr->attr_len - ancs_c->parse_info.current_attr_index);
+
+	/* Skip all the attribute data available in the received data. */
+	attr_chunk(ancs_c, &data_src[*index], len);
+	*index += len;
+	ancs_c->parse_info.current_attr_index += len;
+
 	/* At the end of the attribute, determine if it should be passed to event handler and
 	 * continue parsing the next attribute ID if we are not done with all the attributes.
 	 */
-	if (ancs_c->parse_info.current_attr_index ==
-	    ancs_c->attr_response.attr.attr_len) {
-		if (attr_is_requested(ancs_c, ancs_c->attr_response.attr)) {
-			bt_ancs_do_ds_notif_cb(ancs_c, &ancs_c->attr_response);
-		}
-		if (all_req_attrs_parsed(ancs_c)) {
-			return BT_ANCS_PARSE_STATE_DONE;
-		} else {
-			return BT_ANCS_PARSE_STATE_ATTR_ID;
-		}
+	if (ancs_c->parse_info.current_attr_index == attr->attr_len) {
+		return attr_done(ancs_c);
 	}
 	return BT_ANCS_PARSE_STATE_ATTR_SKIP;
 }
 
+void bt_ancs_parse_request_start(struct bt_ancs_client *ancs_c)
+{
+	/* With queued requests, responses to the earlier requests may still be
+	 * parsed. The parser returns to the command ID state after each
+	 * complete response, so it is only restarted if parsing was aborted.
+	 */
+	if ((CONFIG_BT_ANCS_CLIENT_REQ_QUEUE_SIZE == 0) ||
+	    (ancs_c->parse_info.parse_state == BT_ANCS_PARSE_STATE_DONE)) {
+		ancs_c->parse_info.parse_state = BT_ANCS_PARSE_STATE_COMMAND_ID;
+	}
+}
+
 void bt_ancs_parse_get_attrs_response(struct bt_ancs_client *ancs_c,
 				      const uint8_t *data_src,
 				      const uint16_t data_len)
@@ -337,12 +382,13 @@ void bt_ancs_parse_get_attrs_response(struct bt_ancs_client *ancs_c,
 
 		case BT_ANCS_PARSE_STATE_ATTR_DATA:
 			ancs_c->parse_info.parse_state =
-				attr_data_parse(ancs_c, data_src, &index);
+				attr_data_parse(ancs_c, data_src, data_len,
+						&index);
 			break;
 
 		case BT_ANCS_PARSE_STATE_ATTR_SKIP:
 			ancs_c->parse_info.parse_state =
-				attr_skip(ancs_c, data_src, &index);
+				attr_skip(ancs_c, data_src, data_len, &index);
 			break;
 
 		case BT_ANCS_PARSE_STATE_DONE:
@@ -42,6 +42,12 @@ void bt_ancs_parse_get_attrs_response(struct bt_ancs_client *ancs_c,
 				      const uint8_t *data_src,
 				      const uint16_t data_len);
 
+/**@brief Function for preparing the parser for the response to a new request.
+ *
+ * @param[in] ancs_c     ANCS client instance.
+ */
+void bt_ancs_parse_request_start(struct bt_ancs_client *ancs_c);
+
 #ifdef __cplusplus
 }
 #endif
@@ -354,6 +354,98 @@ static uint16_t encode_notif_action(uint8_t *encoded_data, uint32_t uid,
 	return index;
 }
 
+static int notif_attrs_write(struct bt_ancs_client *ancs_c, const uint32_t uid,
+			     bt_ancs_write_cb func);
+
+#if CONFIG_BT_ANCS_CLIENT_REQ_QUEUE_SIZE > 0
+/**@brief Function for queuing a request while a Control Point write is pending.
+ *
+ * @retval 0 If the request was queued.
+ * @retval -EALREADY If no write is pending and the request must be written directly.
+ * @retval -EBUSY If the queue is full.
+ */
+static int attr_req_enqueue(struct bt_ancs_client *ancs_c, uint32_t uid,
+			    bt_ancs_write_cb func)
+{
+	int err = 0;
+	k_spinlock_key_t key = k_spin_lock(&ancs_c->req_queue.lock);
+
+	if (!atomic_test_and_set_bit(&ancs_c->state, ANCS_CP_WRITE_PENDING)) {
+		err = -EALREADY;
+	} else if (ancs_c->req_queue.count ==
+		   ARRAY_SIZE(ancs_c->req_queue.reqs)) {
+		err = -EBUSY;
+	} else {
+		uint8_t idx = (ancs_c->req_queue.head + ancs_c->req_queue.count) %
+			      ARRAY_SIZE(ancs_c->req_queue.reqs);
+
+		ancs_c->req_queue.reqs[idx].notif_uid = uid;
+		ancs_c->req_queue.reqs[idx].func = func;
+		ancs_c->req_queue.count++;
+	}
+
+	k_spin_unlock(&ancs_c->req_queue.lock, key);
+
+	return err;
+}
+
+/**@brief Function for taking the next queued request.
+ *
+ * If the queue is empty, the Control Point write pending flag is cleared.
+ *
+ * @retval true If a request was taken. The pending flag is kept set.
+ * @retval false If the queue is empty.
+ */
+static bool attr_req_dequeue(struct bt_ancs_client *ancs_c,
+			     struct bt_ancs_attr_req *req)
+{
+	bool taken = false;
+	k_spinlock_key_t key = k_spin_lock(&ancs_c->req_queue.lock);
+
+	if (ancs_c->req_queue.count) {
+		*req = ancs_c->req_queue.reqs[ancs_c->req_queue.head];
+		ancs_c->req_queue.head = (ancs_c->req_queue.head + 1) %
+					 ARRAY_SIZE(ancs_c->req_queue.reqs);
+		ancs_c->req_queue.count--;
+		taken = true;
+	} else {
+		atomic_clear_bit(&ancs_c->state, ANCS_CP_WRITE_PENDING);
+	}
+
+	k_spin_unlock(&ancs_c->req_queue.lock, key);
+
+	return taken;
+}
+
+/**@brief Function for writing the queued requests back to back.
+ *
+ * Called with the Control Point write pending flag set.
+ */
+static void attr_req_queue_process(struct bt_ancs_client *ancs_c)
+{
+	struct bt_ancs_attr_req req;
+
+	while (attr_req_dequeue(ancs_c, &req)) {
+		if (!notif_attrs_write(ancs_c, req.notif_uid, req.func)) {
+			return;
+		}
+
+		if (req.func) {
+			req.func(ancs_c, BT_ATT_ERR_UNLIKELY);
+		}
+
+		/* The pending flag was cleared by the failed write. If a new
+		 * request was written meanwhile, its write callback takes
+		 * over the queue.
+		 */
+		if (atomic_test_and_set_bit(&ancs_c->state,
+					    ANCS_CP_WRITE_PENDING)) {
+			return;
+		}
+	}
+}
+#endif /* CONFIG_BT_ANCS_CLIENT_REQ_QUEUE_SIZE > 0 */
+
 static void bt_ancs_cp_write_callback(struct bt_conn *conn, uint8_t err,
 				      struct bt_gatt_write_params *params)
 {
@@ -364,10 +456,20 @@ static void bt_ancs_cp_write_callback(struct bt_conn *conn, uint8_t err,
 	ancs_c = CONTAINER_OF(params, struct bt_ancs_client, cp_write_params);
 
 	write_cb = ancs_c->cp_write_cb;
+#if CONFIG_BT_ANCS_CLIENT_REQ_QUEUE_SIZE > 0
+	/* Keep the pending flag set so that new requests are queued
+	 * behind the ones already waiting.
+	 */
+	if (write_cb) {
+		write_cb(ancs_c, err);
+	}
+	attr_req_queue_process(ancs_c);
+#else
 	atomic_clear_bit(&ancs_c->state, ANCS_CP_WRITE_PENDING);
 	if (write_cb) {
 		write_cb(ancs_c, err);
 	}
+#endif
 }
 
 int bt_ancs_cp_write(struct bt_ancs_client *ancs_c, uint16_t len,
@@ -406,13 +508,13 @@ int bt_ancs_notification_action(struct bt_ancs_client *ancs_c, uint32_t uuid,
 	return bt_ancs_cp_write(ancs_c, len, func);
 }
 
-static int bt_ancs_get_notif_attrs(struct bt_ancs_client *ancs_c,
-				   const uint32_t uid, bt_ancs_write_cb func)
+/**@brief Function for writing the "get notification attributes" request.
+ *
+ * The caller is expected to set the ANCS_CP_WRITE_PENDING.
+ */
+static int notif_attrs_write(struct bt_ancs_client *ancs_c, const uint32_t uid,
+			     bt_ancs_write_cb func)
 {
-	if (atomic_test_and_set_bit(&ancs_c->state, ANCS_CP_WRITE_PENDING)) {
-		return -EBUSY;
-	}
-
 	uint32_t index = 0;
 	uint8_t *data = ancs_c->cp_data;
 
@@ -446,12 +548,29 @@ static int bt_ancs_get_notif_attrs(struct bt_ancs_client *ancs_c,
 		}
 	}
 
-	ancs_c->parse_info.expected_number_of_attrs =
-		ancs_c->number_of_requested_attr;
+	bt_ancs_parse_request_start(ancs_c);
 
 	return bt_ancs_cp_write(ancs_c, index, func);
 }
 
+static int bt_ancs_get_notif_attrs(struct bt_ancs_client *ancs_c,
+				   const uint32_t uid, bt_ancs_write_cb func)
+{
+#if CONFIG_BT_ANCS_CLIENT_REQ_QUEUE_SIZE > 0
+	int err = attr_req_enqueue(ancs_c, uid, func);
+
+	if (err != -EALREADY) {
+		return err;
+	}
+#else
+	if (atomic_test_and_set_bit(&ancs_c->state, ANCS_CP_WRITE_PENDING)) {
+		return -EBUSY;
+	}
+#endif
+
+	return notif_attrs_write(ancs_c, uid, func);
+}
+
 int bt_ancs_request_attrs(struct bt_ancs_client *ancs_c,
 			  const struct bt_ancs_evt_notif *notif,
 			  bt_ancs_write_cb func)
@@ -463,8 +582,6 @@ int bt_ancs_request_attrs(struct bt_ancs_client *ancs_c,
 		return err;
 	}
 
-	ancs_c->parse_info.parse_state = BT_ANCS_PARSE_STATE_COMMAND_ID;
-
 	return bt_ancs_get_notif_attrs(ancs_c, notif->notif_uid, func);
 }
 
@@ -514,6 +631,18 @@ int bt_ancs_register_app_attr(struct bt_ancs_client *ancs_c,
 	return 0;
 }
 
+int bt_ancs_register_attr_chunk_cb(struct bt_ancs_client *ancs_c,
+				   bt_ancs_ds_chunk_cb func)
+{
+	if (!ancs_c) {
+		return -EINVAL;
+	}
+
+	ancs_c->ds_chunk_cb = func;
+
+	return 0;
+}
+
 int bt_ancs_request_app_attr(struct bt_ancs_client *ancs_c,
 			     const uint8_t *app_id, uint32_t len,
 			     bt_ancs_write_cb func)
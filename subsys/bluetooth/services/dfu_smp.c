@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 #include <kernel.h>
+#include <sys/byteorder.h>
 #include <bluetooth/conn.h>
 #include <bluetooth/uuid.h>
 #include <bluetooth/gatt.h>
@@ -13,6 +14,12 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(dfu_smp, CONFIG_BT_DFU_SMP_LOG_LEVEL);
 
+#if CONFIG_BT_DFU_SMP_UPLOAD
+static void upload_rsp_process(struct bt_dfu_smp *dfu_smp,
+			       const uint8_t *data, uint16_t length);
+static void upload_finish(struct bt_dfu_smp *dfu_smp, int err);
+static void upload_work_handler(struct k_work *work);
+#endif
 
 /** @brief Notification callback function
  *
@@ -40,9 +47,19 @@ static uint8_t notify_process(struct bt_conn *conn,
 		/* Notification disabled */
 		dfu_smp->cbs.rsp_part = NULL;
 		params->notify = NULL;
+#if CONFIG_BT_DFU_SMP_UPLOAD
+		upload_finish(dfu_smp, -ENOTCONN);
+#endif
 		return BT_GATT_ITER_STOP;
 	}
 
+#if CONFIG_BT_DFU_SMP_UPLOAD
+	if (dfu_smp->upload.active) {
+		upload_rsp_process(dfu_smp, data, length);
+		return BT_GATT_ITER_CONTINUE;
+	}
+#endif
+
 	if (dfu_smp->cbs.rsp_part) {
 		dfu_smp->rsp_state.chunk_size = length;
 		dfu_smp->rsp_state.data       = data;
@@ -82,6 +99,9 @@ int bt_dfu_smp_init(struct bt_dfu_smp *dfu_smp,
 	}
 	memset(dfu_smp, 0, sizeof(*dfu_smp));
 	dfu_smp->cbs.error_cb = params->error_cb;
+#if CONFIG_BT_DFU_SMP_UPLOAD
+	k_work_init_delayable(&dfu_smp->upload.work, upload_work_handler);
+#endif
 	return 0;
 }
 
@@ -129,6 +149,24 @@ int bt_dfu_smp_handles_assign(struct bt_gatt_dm *dm,
 }
 
 
+/* Sign into notification if not currently enabled */
+static int notification_subscribe(struct bt_dfu_smp *dfu_smp)
+{
+	if (dfu_smp->notification_params.notify) {
+		return 0;
+	}
+
+	dfu_smp->notification_params.value_handle = dfu_smp->handles.smp;
+	dfu_smp->notification_params.ccc_handle = dfu_smp->handles.smp_ccc;
+	dfu_smp->notification_params.notify = notify_process;
+	dfu_smp->notification_params.value  = BT_GATT_CCC_NOTIFY;
+	atomic_set_bit(dfu_smp->notification_params.flags,
+		       BT_GATT_SUBSCRIBE_FLAG_VOLATILE);
+
+	return bt_gatt_subscribe(dfu_smp->conn, &dfu_smp->notification_params);
+}
+
+
 int bt_dfu_smp_command(struct bt_dfu_smp *dfu_smp,
 			      bt_dfu_smp_rsp_part_cb rsp_cb,
 			      size_t cmd_size,
@@ -152,23 +190,14 @@ int bt_dfu_smp_command(struct bt_dfu_smp *dfu_smp,
 	if (dfu_smp->cbs.rsp_part) {
 		return -EBUSY;
 	}
-	/* Sign into notification if not currently enabled */
-	if (!dfu_smp->notification_params.notify) {
-		dfu_smp->notification_params.value_handle =
-			dfu_smp->handles.smp;
-		dfu_smp->notification_params.ccc_handle =
-			dfu_smp->handles.smp_ccc;
-		dfu_smp->notification_params.notify =
-			notify_process;
-		dfu_smp->notification_params.value  = BT_GATT_CCC_NOTIFY;
-		atomic_set_bit(dfu_smp->notification_params.flags,
-			       BT_GATT_SUBSCRIBE_FLAG_VOLATILE);
-
-		ret = bt_gatt_subscribe(dfu_smp->conn,
-					&dfu_smp->notification_params);
-		if (ret) {
-			return ret;
-		}
+#if CONFIG_BT_DFU_SMP_UPLOAD
+	if (dfu_smp->upload.active) {
+		return -EBUSY;
+	}
+#endif
+	ret = notification_subscribe(dfu_smp);
+	if (ret) {
+		return ret;
 	}
 	memset(&dfu_smp->rsp_state, 0, sizeof(dfu_smp->rsp_state));
 	dfu_smp->cbs.rsp_part = rsp_cb;
@@ -206,3 +235,452 @@ bool bt_dfu_smp_rsp_total_check(
 		>=
 		dfu_smp->rsp_state.total_size);
 }
+
+
+#if CONFIG_BT_DFU_SMP_UPLOAD
+/* SMP image upload command. */
+#define SMP_OP_WRITE		2
+#define SMP_GROUP_IMAGE		1
+#define SMP_ID_IMAGE_UPLOAD	1
+
+#define CBOR_MAJOR_UINT		0
+#define CBOR_MAJOR_NINT		1
+#define CBOR_MAJOR_BSTR		2
+#define CBOR_MAJOR_TSTR		3
+#define CBOR_MAJOR_MAP		5
+#define CBOR_MAJOR_SIMPLE	7
+
+/* Maximum size of the head of a byte string shorter than 64 kB. */
+#define CBOR_BSTR_HEAD_MAX	3
+
+/* Delay before a request is sent again, when no buffer is available. */
+#define UPLOAD_RETRY_DELAY	K_MSEC(10)
+
+static uint8_t *cbor_head_put(uint8_t *p, uint8_t major, uint32_t val)
+{
+	major <<= 5;
+
+	if (val < 24) {
+		*p++ = major | val;
+	} else if (val <= UINT8_MAX) {
+		*p++ = major | 24;
+		*p++ = val;
+	} else if (val <= UINT16_MAX) {
+		*p++ = major | 25;
+		sys_put_be16(val, p);
+		p += sizeof(uint16_t);
+	} else {
+		*p++ = major | 26;
+		sys_put_be32(val, p);
+		p += sizeof(uint32_t);
+	}
+
+	return p;
+}
+
+static uint8_t *cbor_tstr_put(uint8_t *p, const char *str)
+{
+	size_t len = strlen(str);
+
+	p = cbor_head_put(p, CBOR_MAJOR_TSTR, len);
+	memcpy(p, str, len);
+
+	return p + len;
+}
+
+/* Returns the number of bytes of the head, or 0 on error. */
+static size_t cbor_head_get(const uint8_t *p, const uint8_t *end,
+			    uint8_t *major, uint32_t *val)
+{
+	uint8_t info;
+
+	if (p >= end) {
+		return 0;
+	}
+
+	*major = *p >> 5;
+	info = *p & 0x1F;
+
+	if (info < 24) {
+		*val = info;
+		return 1;
+	}
+	if (info == 24 && end - p >= 2) {
+		*val = p[1];
+		return 2;
+	}
+	if (info == 25 && end - p >= 3) {
+		*val = sys_get_be16(&p[1]);
+		return 3;
+	}
+	if (info == 26 && end - p >= 5) {
+		*val = sys_get_be32(&p[1]);
+		return 5;
+	}
+
+	return 0;
+}
+
+/* Decode the "rc" and "off" fields of an upload response. */
+static int upload_rsp_decode(const uint8_t *p, const uint8_t *end,
+			     int32_t *rc, uint32_t *off)
+{
+	uint8_t major;
+	uint32_t val;
+	uint32_t count;
+	size_t len;
+	bool off_found = false;
+
+	*rc = 0;
+
+	len = cbor_head_get(p, end, &major, &count);
+	if (!len || major != CBOR_MAJOR_MAP) {
+		return -EINVAL;
+	}
+	p += len;
+
+	for (uint32_t i = 0; i < count; i++) {
+		const uint8_t *key;
+		size_t key_len;
+
+		len = cbor_head_get(p, end, &major, &val);
+		if (!len || major != CBOR_MAJOR_TSTR || val > end - p - len) {
+			return -EINVAL;
+		}
+		key = p + len;
+		key_len = val;
+		p += len + val;
+
+		len = cbor_head_get(p, end, &major, &val);
+		if (!len) {
+			return -EINVAL;
+		}
+		p += len;
+
+		switch (major) {
+		case CBOR_MAJOR_UINT:
+		case CBOR_MAJOR_NINT:
+			if (key_len == 2 && !memcmp(key, "rc", 2)) {
+				*rc = (major == CBOR_MAJOR_UINT) ?
+				      (int32_t)val : -1 - (int32_t)val;
+			} else if (key_len == 3 && !memcmp(key, "off", 3)) {
+				*off = val;
+				off_found = true;
+			}
+			break;
+		case CBOR_MAJOR_BSTR:
+		case CBOR_MAJOR_TSTR:
+			if (val > end - p) {
+				return -EINVAL;
+			}
+			p += val;
+			break;
+		case CBOR_MAJOR_SIMPLE:
+			break;
+		default:
+			return -EINVAL;
+		}
+	}
+
+	/* Offset is not reported when the request failed. */
+	return (off_found || *rc != 0) ? 0 : -EINVAL;
+}
+
+static void upload_finish(struct bt_dfu_smp *dfu_smp, int err)
+{
+	struct bt_dfu_smp_upload *upload = &dfu_smp->upload;
+	k_spinlock_key_t key = k_spin_lock(&upload->lock);
+	bool active = upload->active;
+
+	upload->active = false;
+	k_spin_unlock(&upload->lock, key);
+
+	if (active) {
+		upload->params.done(dfu_smp, err);
+	}
+}
+
+static struct bt_dfu_smp_upload_req *upload_req_find(
+		struct bt_dfu_smp_upload *upload, bool used, uint8_t seq)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(upload->reqs); i++) {
+		if (upload->reqs[i].used == used &&
+		    (!used || upload->reqs[i].seq == seq)) {
+			return &upload->reqs[i];
+		}
+	}
+
+	return NULL;
+}
+
+static bool upload_reqs_pending(const struct bt_dfu_smp_upload *upload)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(upload->reqs); i++) {
+		if (upload->reqs[i].used) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void upload_rsp_handle(struct bt_dfu_smp *dfu_smp)
+{
+	struct bt_dfu_smp_upload *upload = &dfu_smp->upload;
+	const struct bt_dfu_smp_header *header = (const void *)upload->rsp;
+	struct bt_dfu_smp_upload_req *req;
+	k_spinlock_key_t key;
+	uint32_t off = 0;
+	int32_t rc;
+	int err;
+	bool done;
+
+	err = upload_rsp_decode(&upload->rsp[sizeof(*header)],
+				&upload->rsp[upload->rsp_len], &rc, &off);
+	if (err) {
+		LOG_ERR("Invalid upload response");
+		upload_finish(dfu_smp, -EIO);
+		return;
+	}
+	if (rc != 0) {
+		LOG_ERR("Upload failed, rc: %d", rc);
+		upload_finish(dfu_smp, rc);
+		return;
+	}
+
+	key = k_spin_lock(&upload->lock);
+
+	req = upload_req_find(upload, true, header->seq);
+	if (!req) {
+		k_spin_unlock(&upload->lock, key);
+		LOG_WRN("Unexpected response, seq: %u", header->seq);
+		return;
+	}
+	req->used = false;
+
+	if (!req->stale) {
+		upload->acked_off = off;
+		if (off != req->end) {
+			/* Server expects another offset, for example after
+			 * a lost request. Responses to the requests sent
+			 * after this one are ignored.
+			 */
+			LOG_DBG("Upload rewound to %u", off);
+			upload->next_off = off;
+			for (size_t i = 0; i < ARRAY_SIZE(upload->reqs); i++) {
+				upload->reqs[i].stale = true;
+			}
+		}
+	}
+
+	done = (upload->acked_off == upload->params.size) &&
+	       !upload_reqs_pending(upload);
+
+	k_spin_unlock(&upload->lock, key);
+
+	if (done) {
+		upload_finish(dfu_smp, 0);
+	} else {
+		k_work_reschedule(&upload->work, K_NO_WAIT);
+	}
+}
+
+static void upload_rsp_process(struct bt_dfu_smp *dfu_smp,
+			       const uint8_t *data, uint16_t length)
+{
+	struct bt_dfu_smp_upload *upload = &dfu_smp->upload;
+	const struct bt_dfu_smp_header *header = (const void *)upload->rsp;
+	size_t total;
+
+	/* Responses may be split into several notifications. */
+	if (length > sizeof(upload->rsp) - upload->rsp_len) {
+		LOG_ERR("Upload response too long");
+		upload->rsp_len = 0;
+		upload_finish(dfu_smp, -ENOMEM);
+		return;
+	}
+	memcpy(&upload->rsp[upload->rsp_len], data, length);
+	upload->rsp_len += length;
+
+	if (upload->rsp_len < sizeof(*header)) {
+		return;
+	}
+
+	total = sizeof(*header) + ((header->len_h8 << 8) | header->len_l8);
+	if (upload->rsp_len < total) {
+		return;
+	}
+
+	upload->rsp_len = total;
+	upload_rsp_handle(dfu_smp);
+	upload->rsp_len = 0;
+}
+
+/* Encode an upload request, up to the "data" key. */
+static uint8_t *upload_req_encode(const struct bt_dfu_smp_upload *upload,
+				  uint8_t *p, size_t off)
+{
+	const struct bt_dfu_smp_upload_params *params = &upload->params;
+
+	if (off == 0) {
+		p = cbor_head_put(p, CBOR_MAJOR_MAP, params->sha ? 5 : 4);
+		p = cbor_tstr_put(p, "image");
+		p = cbor_head_put(p, CBOR_MAJOR_UINT, params->image);
+		p = cbor_tstr_put(p, "len");
+		p = cbor_head_put(p, CBOR_MAJOR_UINT, params->size);
+		if (params->sha) {
+			p = cbor_tstr_put(p, "sha");
+			p = cbor_head_put(p, CBOR_MAJOR_BSTR, 32);
+			memcpy(p, params->sha, 32);
+			p += 32;
+		}
+	} else {
+		p = cbor_head_put(p, CBOR_MAJOR_MAP, 2);
+	}
+
+	p = cbor_tstr_put(p, "off");
+	p = cbor_head_put(p, CBOR_MAJOR_UINT, off);
+
+	return cbor_tstr_put(p, "data");
+}
+
+/* Send one request. Returns -EAGAIN when the window is full or the whole
+ * image has been sent.
+ */
+static int upload_req_send(struct bt_dfu_smp *dfu_smp)
+{
+	/* Requests are sent from the system work queue only. */
+	static uint8_t buf[CONFIG_BT_L2CAP_TX_MTU];
+
+	struct bt_dfu_smp_upload *upload = &dfu_smp->upload;
+	struct bt_dfu_smp_header *header = (void *)buf;
+	struct bt_dfu_smp_upload_req *req;
+	k_spinlock_key_t key;
+	uint8_t *p = &buf[sizeof(*header)];
+	size_t max_len;
+	size_t off;
+	size_t len;
+	uint8_t seq;
+	int err;
+
+	/* ATT header of Write Command takes 3 bytes. */
+	max_len = MIN(sizeof(buf), bt_gatt_get_mtu(dfu_smp->conn) - 3);
+
+	key = k_spin_lock(&upload->lock);
+
+	req = upload_req_find(upload, false, 0);
+	if (!upload->active || !req ||
+	    upload->next_off >= upload->params.size) {
+		k_spin_unlock(&upload->lock, key);
+		return -EAGAIN;
+	}
+
+	off = upload->next_off;
+	p = upload_req_encode(upload, p, off);
+	if (p - buf + CBOR_BSTR_HEAD_MAX >= max_len) {
+		k_spin_unlock(&upload->lock, key);
+		return -EMSGSIZE;
+	}
+	len = MIN(max_len - (p - buf) - CBOR_BSTR_HEAD_MAX,
+		  upload->params.size - off);
+
+	seq = upload->seq++;
+	req->used = true;
+	req->stale = false;
+	req->seq = seq;
+	req->end = off + len;
+	upload->next_off = off + len;
+
+	k_spin_unlock(&upload->lock, key);
+
+	p = cbor_head_put(p, CBOR_MAJOR_BSTR, len);
+	err = upload->params.read(dfu_smp, off, p, len);
+	if (err) {
+		goto rollback;
+	}
+	p += len;
+
+	header->op = SMP_OP_WRITE;
+	header->flags = 0;
+	header->len_h8 = (p - buf - sizeof(*header)) >> 8;
+	header->len_l8 = (p - buf - sizeof(*header)) & 0xFF;
+	header->group_h8 = 0;
+	header->group_l8 = SMP_GROUP_IMAGE;
+	header->seq = seq;
+	header->id = SMP_ID_IMAGE_UPLOAD;
+
+	err = bt_gatt_write_without_response(dfu_smp->conn,
+					     dfu_smp->handles.smp,
+					     buf, p - buf, false);
+	if (!err) {
+		return 0;
+	}
+
+rollback:
+	key = k_spin_lock(&upload->lock);
+	req->used = false;
+	if (!req->stale) {
+		upload->next_off = off;
+	}
+	k_spin_unlock(&upload->lock, key);
+
+	return err;
+}
+
+static void upload_work_handler(struct k_work *work)
+{
+	struct bt_dfu_smp_upload *upload =
+		CONTAINER_OF(work, struct bt_dfu_smp_upload, work);
+	struct bt_dfu_smp *dfu_smp =
+		CONTAINER_OF(upload, struct bt_dfu_smp, upload);
+	int err;
+
+	do {
+		err = upload_req_send(dfu_smp);
+	} while (!err);
+
+	if (err == -ENOMEM || err == -ENOBUFS) {
+		/* No buffer for the request, try again later. */
+		k_work_reschedule(&upload->work, UPLOAD_RETRY_DELAY);
+	} else if (err != -EAGAIN) {
+		LOG_ERR("Upload request not sent, err: %d", err);
+		upload_finish(dfu_smp, err);
+	}
+}
+
+int bt_dfu_smp_upload(struct bt_dfu_smp *dfu_smp,
+		      const struct bt_dfu_smp_upload_params *params)
+{
+	struct bt_dfu_smp_upload *upload;
+	int ret;
+
+	if (!dfu_smp || !params || !params->read || !params->done ||
+	    params->size == 0) {
+		return -EINVAL;
+	}
+	if (!dfu_smp->conn) {
+		return -ENXIO;
+	}
+
+	upload = &dfu_smp->upload;
+	if (dfu_smp->cbs.rsp_part || upload->active) {
+		return -EBUSY;
+	}
+
+	ret = notification_subscribe(dfu_smp);
+	if (ret) {
+		return ret;
+	}
+
+	upload->params = *params;
+	upload->next_off = 0;
+	upload->acked_off = 0;
+	upload->rsp_len = 0;
+	memset(upload->reqs, 0, sizeof(upload->reqs));
+	upload->active = true;
+
+	k_work_reschedule(&upload->work, K_NO_WAIT);
+
+	return 0;
+}
+#endif /* CONFIG_BT_DFU_SMP_UPLOAD */
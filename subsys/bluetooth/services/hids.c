@@ -52,6 +52,33 @@
 
 LOG_MODULE_REGISTER(bt_hids, CONFIG_BT_HIDS_LOG_LEVEL);
 
+/* Replace the buffer holding the last sent Input Report. */
+static void inp_rep_buf_set(struct bt_hids_conn_data *conn_data, uint8_t idx,
+			    struct net_buf *buf)
+{
+#if defined(CONFIG_BT_HIDS_INP_REP_NET_BUF)
+	if (conn_data->inp_rep_buf[idx]) {
+		net_buf_unref(conn_data->inp_rep_buf[idx]);
+	}
+	conn_data->inp_rep_buf[idx] = buf ? net_buf_ref(buf) : NULL;
+#endif
+}
+
+static void inp_rep_bufs_release(struct bt_hids *hids_obj,
+				 struct bt_hids_conn_data *conn_data)
+{
+	if (!IS_ENABLED(CONFIG_BT_HIDS_INP_REP_NET_BUF)) {
+		return;
+	}
+
+	size_t cnt = MIN(hids_obj->inp_rep_group.cnt,
+			 ARRAY_SIZE(hids_obj->inp_rep_group.reports));
+
+	for (size_t i = 0; i < cnt; i++) {
+		inp_rep_buf_set(conn_data, i, NULL);
+	}
+}
+
 int bt_hids_connected(struct bt_hids *hids_obj, struct bt_conn *conn)
 {
 	__ASSERT_NO_MSG(conn != NULL);
@@ -103,6 +130,14 @@ int bt_hids_disconnected(struct bt_hids *hids_obj, struct bt_conn *conn)
 	__ASSERT_NO_MSG(conn != NULL);
 	__ASSERT_NO_MSG(hids_obj != NULL);
 
+	struct bt_hids_conn_data *conn_data =
+		bt_conn_ctx_get(hids_obj->conn_ctx, conn);
+
+	if (conn_data) {
+		inp_rep_bufs_release(hids_obj, conn_data);
+		bt_conn_ctx_release(hids_obj->conn_ctx, (void *)conn_data);
+	}
+
 	int err = bt_conn_ctx_free(hids_obj->conn_ctx, conn);
 
 	if (err) {
@@ -227,6 +262,11 @@ static ssize_t hids_inp_rep_read(struct bt_conn *conn,
 	}
 
 	rep_data = conn_data->inp_rep_ctx + rep->offset;
+#if defined(CONFIG_BT_HIDS_INP_REP_NET_BUF)
+	if (conn_data->inp_rep_buf[idx]) {
+		rep_data = conn_data->inp_rep_buf[idx]->data;
+	}
+#endif
 
 	ret_len = bt_gatt_attr_read(conn, attr, buf, len, offset, rep_data,
 				    rep->size);
@@ -765,6 +805,9 @@ hids_input_reports_register(struct bt_hids *hids_obj,
 		hids_inp_rep->att_ind = hids_obj->gp.svc.attr_count - 1;
 		hids_inp_rep->offset = offset;
 		hids_inp_rep->idx = i;
+		hids_inp_rep->notify_params.attr =
+			&hids_obj->gp.svc.attrs[hids_inp_rep->att_ind];
+		hids_inp_rep->notify_params.len = hids_inp_rep->size;
 
 		BT_GATT_POOL_CCC(&hids_obj->gp, hids_inp_rep->ccc,
 				 hids_input_report_ccc_changed,  wperm | rperm);
@@ -1002,6 +1045,20 @@ int bt_hids_uninit(struct bt_hids *hids_obj)
 	/* Free the whole GATT pool */
 	bt_gatt_pool_free(&hids_obj->gp);
 
+	/* Release all referenced buffers. */
+	const size_t contexts = bt_conn_ctx_count(hids_obj->conn_ctx);
+
+	for (size_t i = 0; i < contexts; i++) {
+		const struct bt_conn_ctx *ctx =
+			bt_conn_ctx_get_by_id(hids_obj->conn_ctx, i);
+
+		if (ctx) {
+			inp_rep_bufs_release(hids_obj, ctx->data);
+			bt_conn_ctx_release(hids_obj->conn_ctx,
+					    (void *)ctx->data);
+		}
+	}
+
 	/* Free all allocated memory. */
 	bt_conn_ctx_free_all(hids_obj->conn_ctx);
 
@@ -1014,10 +1071,13 @@ int bt_hids_uninit(struct bt_hids *hids_obj)
 }
 
 static void store_input_report(struct bt_hids_inp_rep *hids_inp_rep,
-			       uint8_t *rep_data, uint8_t const *rep,
-			       uint8_t len)
+			       struct bt_hids_conn_data *conn_data,
+			       uint8_t const *rep, uint8_t len)
 {
+	uint8_t *rep_data = conn_data->inp_rep_ctx + hids_inp_rep->offset;
+
 	if (!hids_inp_rep->rep_mask) {
+		inp_rep_buf_set(conn_data, hids_inp_rep->idx, NULL);
 		memcpy(rep_data, rep, len);
 		return;
 	}
@@ -1031,15 +1091,29 @@ static void store_input_report(struct bt_hids_inp_rep *hids_inp_rep,
 	}
 }
 
+/* Store the report in the context of the connection. If the buffer is given,
+ * it is referenced instead of copying the report.
+ */
+static void inp_rep_store(struct bt_hids_inp_rep *hids_inp_rep,
+			  struct bt_hids_conn_data *conn_data,
+			  uint8_t const *rep, uint8_t len,
+			  struct net_buf *buf)
+{
+	if (buf && !hids_inp_rep->rep_mask) {
+		inp_rep_buf_set(conn_data, hids_inp_rep->idx, buf);
+	} else {
+		store_input_report(hids_inp_rep, conn_data, rep, len);
+	}
+}
+
 static int inp_rep_notify_all(struct bt_hids *hids_obj,
 			      struct bt_hids_inp_rep *hids_inp_rep,
 			      uint8_t const *rep, uint8_t len,
+			      struct net_buf *buf,
 			      bt_gatt_complete_func_t cb)
 {
-	struct bt_hids_conn_data *conn_data;
-	uint8_t *rep_data = NULL;
-	struct bt_gatt_attr *rep_attr =
-		&hids_obj->gp.svc.attrs[hids_inp_rep->att_ind];
+	bool notified = false;
+	const struct bt_gatt_attr *rep_attr = hids_inp_rep->notify_params.attr;
 
 	const size_t contexts =
 	    bt_conn_ctx_count(hids_obj->conn_ctx);
@@ -1053,12 +1127,9 @@ static int inp_rep_notify_all(struct bt_hids *hids_obj,
 				ctx->conn, rep_attr, BT_GATT_CCC_NOTIFY);
 
 			if (notification_enabled) {
-				conn_data = ctx->data;
-				rep_data = conn_data->inp_rep_ctx +
-					   hids_inp_rep->offset;
-
-				store_input_report(hids_inp_rep, rep_data, rep,
-						   len);
+				inp_rep_store(hids_inp_rep, ctx->data, rep,
+					      len, buf);
+				notified = true;
 			}
 
 			bt_conn_ctx_release(hids_obj->conn_ctx,
@@ -1066,12 +1137,11 @@ static int inp_rep_notify_all(struct bt_hids *hids_obj,
 		}
 	}
 
-	if (rep_data != NULL) {
-		struct bt_gatt_notify_params params = {0};
+	if (notified) {
+		struct bt_gatt_notify_params params =
+			hids_inp_rep->notify_params;
 
-		params.attr = rep_attr;
 		params.data = rep;
-		params.len = hids_inp_rep->size;
 		params.func = cb;
 
 		return bt_gatt_notify_cb(NULL, &params);
@@ -1080,23 +1150,24 @@ static int inp_rep_notify_all(struct bt_hids *hids_obj,
 	}
 }
 
-int bt_hids_inp_rep_send(struct bt_hids *hids_obj,
-			 struct bt_conn *conn, uint8_t rep_index,
-			 uint8_t const *rep, uint8_t len,
-			 bt_gatt_complete_func_t cb)
+static int inp_rep_send(struct bt_hids *hids_obj,
+			struct bt_conn *conn, uint8_t rep_index,
+			uint8_t const *rep, uint8_t len,
+			struct net_buf *buf,
+			bt_gatt_complete_func_t cb)
 {
 	struct bt_hids_inp_rep *hids_inp_rep =
 	    &hids_obj->inp_rep_group.reports[rep_index];
-	struct bt_gatt_attr *rep_attr =
-	    &hids_obj->gp.svc.attrs[hids_inp_rep->att_ind];
-	uint8_t *rep_data;
+	const struct bt_gatt_attr *rep_attr =
+	    hids_inp_rep->notify_params.attr;
 
 	if (hids_inp_rep->size != len) {
 		return -EINVAL;
 	}
 
 	if (!conn) {
-		return inp_rep_notify_all(hids_obj, hids_inp_rep, rep, len, cb);
+		return inp_rep_notify_all(hids_obj, hids_inp_rep, rep, len,
+					  buf, cb);
 	}
 
 	if (!bt_gatt_is_subscribed(conn, rep_attr, BT_GATT_CCC_NOTIFY)) {
@@ -1111,15 +1182,11 @@ int bt_hids_inp_rep_send(struct bt_hids *hids_obj,
 		return -EINVAL;
 	}
 
-	rep_data = conn_data->inp_rep_ctx + hids_inp_rep->offset;
+	inp_rep_store(hids_inp_rep, conn_data, rep, len, buf);
 
-	store_input_report(hids_inp_rep, rep_data, rep, len);
-
-	struct bt_gatt_notify_params params = {0};
+	struct bt_gatt_notify_params params = hids_inp_rep->notify_params;
 
-	params.attr = &hids_obj->gp.svc.attrs[hids_inp_rep->att_ind];
 	params.data = rep;
-	params.len = hids_inp_rep->size;
 	params.func = cb;
 
 	int err = bt_gatt_notify_cb(conn, &params);
@@ -1129,6 +1196,35 @@ int bt_hids_inp_rep_send(struct bt_hids *hids_obj,
 	return err;
 }
 
+int bt_hids_inp_rep_send(struct bt_hids *hids_obj,
+			 struct bt_conn *conn, uint8_t rep_index,
+			 uint8_t const *rep, uint8_t len,
+			 bt_gatt_complete_func_t cb)
+{
+	return inp_rep_send(hids_obj, conn, rep_index, rep, len, NULL, cb);
+}
+
+#if defined(CONFIG_BT_HIDS_INP_REP_NET_BUF)
+int bt_hids_inp_rep_send_buf(struct bt_hids *hids_obj, struct bt_conn *conn,
+			     uint8_t rep_index, struct net_buf *buf,
+			     bt_gatt_complete_func_t cb)
+{
+	int err;
+
+	if (buf->len > UINT8_MAX) {
+		err = -EINVAL;
+	} else {
+		err = inp_rep_send(hids_obj, conn, rep_index, buf->data,
+				   buf->len, buf, cb);
+	}
+
+	/* The connection contexts hold their own references. */
+	net_buf_unref(buf);
+
+	return err;
+}
+#endif /* CONFIG_BT_HIDS_INP_REP_NET_BUF */
+
 static int boot_mouse_inp_report_notify_all(
 	struct bt_hids *hids_obj, const uint8_t *buttons,
 	struct bt_hids_boot_mouse_inp_rep *boot_mouse_inp_rep,
@@ -25,6 +25,7 @@ struct bt_hogp_rep_info {
 	bt_hogp_read_cb  read_cb;   /**< Read function callback        */
 	bt_hogp_write_cb write_cb;  /**< Write function callback       */
 	bt_hogp_read_cb  notify_cb; /**< Notification function (Input) */
+	bool buffered;              /**< Notifications are buffered    */
 	struct bt_gatt_read_params      read_params;   /**< Read params   */
 	struct bt_gatt_write_params     write_params;  /**< Write params  */
 	struct bt_gatt_subscribe_params notify_params; /**< Notify params */
@@ -45,6 +46,15 @@ struct bt_hogp_rep_info {
 	uint8_t size; /**< The size of the value */
 };
 
+/* Size of the Report Reference descriptor value */
+#define REPREF_SIZE 2
+
+/* Buffered report: pointer to the report followed by the report data */
+#define REP_BUF_PTR_WORDS DIV_ROUND_UP(sizeof(struct bt_hogp_rep_info *), \
+				       sizeof(uint32_t))
+#define REP_BUF_ITEM_WORDS_MAX (REP_BUF_PTR_WORDS + \
+				DIV_ROUND_UP(UINT8_MAX, sizeof(uint32_t)))
+
 /* Memory slab used for reports */
 K_MEM_SLAB_DEFINE(bt_hogp_reports_mem,
 		  sizeof(struct bt_hogp_rep_info),
@@ -371,6 +381,61 @@ static uint8_t repref_read_process(struct bt_conn *conn, uint8_t err,
 				struct bt_gatt_read_params *params,
 				const void *data, uint16_t length);
 
+#if defined(CONFIG_BT_HOGP_REPREF_READ_MULTIPLE)
+/**
+ * @brief Process report references read with Read Multiple request
+ *
+ * @param conn   Connection handler.
+ * @param err    Read ATT error code.
+ * @param params Notification parameters structure - the pointer
+ *               to the structure provided to read function.
+ * @param data   Pointer to the data buffer, NULL when the read is complete.
+ * @param length The size of the received data.
+ *
+ * @retval BT_GATT_ITER_STOP     Stop notification
+ */
+static uint8_t repref_read_multiple_process(struct bt_conn *conn, uint8_t err,
+					    struct bt_gatt_read_params *params,
+					    const void *data, uint16_t length);
+
+/**
+ * @brief Start Report Reference read with Read Multiple request
+ *
+ * Reads as many consecutive report references as fit into a single
+ * response.
+ *
+ * @param hogp    See @ref bt_hogp_handles_assign.
+ * @param rep_idx Index of the first report in the report array.
+ * @param count   Number of report references to read, at least 2.
+ *
+ * @return 0 or negative error value.
+ */
+static int repref_read_multiple_start(struct bt_hogp *hogp, size_t rep_idx,
+				      size_t count)
+{
+	int err;
+
+	LOG_DBG("Report (idx: %u-%u) reference read multiple start",
+		rep_idx, rep_idx + count - 1);
+	for (size_t i = 0; i < count; i++) {
+		hogp->init_repref.handles[i] =
+			hogp->rep_info[rep_idx + i]->handlers.ref;
+	}
+	hogp->init_repref.rep_idx = rep_idx;
+	hogp->init_repref.count = count;
+	hogp->read_params.func = repref_read_multiple_process;
+	hogp->read_params.handle_count = count;
+	hogp->read_params.multiple.handles = hogp->init_repref.handles;
+	hogp->read_params.multiple.variable = false;
+	err = bt_gatt_read(hogp->conn, &(hogp->read_params));
+	if (err) {
+		LOG_ERR("Report reference read multiple error (err: %d)", err);
+		return err;
+	}
+	return 0;
+}
+#endif /* CONFIG_BT_HOGP_REPREF_READ_MULTIPLE */
+
 /**
  * @brief Start Report Reference read
  *
@@ -395,6 +460,19 @@ static int repref_read_start(struct bt_hogp *hogp, size_t rep_idx)
 		}
 		return err;
 	}
+#if defined(CONFIG_BT_HOGP_REPREF_READ_MULTIPLE)
+	if (!hogp->init_repref.single) {
+		size_t count = hogp->rep_count - rep_idx;
+
+		count = MIN(count, ARRAY_SIZE(hogp->init_repref.handles));
+		count = MIN(count,
+			    (bt_gatt_get_mtu(hogp->conn) - 1) / REPREF_SIZE);
+		if (count > 1) {
+			return repref_read_multiple_start(hogp, rep_idx,
+							  count);
+		}
+	}
+#endif
 	LOG_DBG("Report (id: %u) reference read start", rep_idx);
 	rep = hogp->rep_info[rep_idx];
 	hogp->init_repref.rep_idx = rep_idx;
@@ -410,15 +488,104 @@ static int repref_read_start(struct bt_hogp *hogp, size_t rep_idx)
 	return 0;
 }
 
+/**
+ * @brief Store report reference value
+ *
+ * @param hogp    See @ref bt_hogp_handles_assign.
+ * @param rep_idx Index in the report array.
+ * @param bdata   Report Reference descriptor value.
+ *
+ * @return 0 or negative error value.
+ */
+static int repref_set(struct bt_hogp *hogp, size_t rep_idx,
+		      const uint8_t *bdata)
+{
+	struct bt_hogp_rep_info *rep = hogp->rep_info[rep_idx];
+
+	if ((uint8_t)rep->ref.type != bdata[1]) {
+		LOG_ERR("Unexpected report type (%u while expecting %u)",
+			bdata[1], rep->ref.type);
+		return -EINVAL;
+	}
+	rep->ref.id = bdata[0];
+	LOG_DBG("Report reference read (idx: %u, id: %u)",
+		rep_idx, rep->ref.id);
+
+	return 0;
+}
+
+#if defined(CONFIG_BT_HOGP_REPREF_READ_MULTIPLE)
+static uint8_t repref_read_multiple_process(struct bt_conn *conn, uint8_t err,
+					    struct bt_gatt_read_params *params,
+					    const void *data, uint16_t length)
+{
+	int ret;
+	struct bt_hogp *hogp;
+	size_t rep_idx;
+	size_t count;
+	const uint8_t *bdata = data;
+
+	hogp = CONTAINER_OF(params, struct bt_hogp, read_params);
+
+	rep_idx = hogp->init_repref.rep_idx;
+	count = hogp->init_repref.count;
+
+	if (err == BT_ATT_ERR_NOT_SUPPORTED) {
+		LOG_DBG("Read Multiple not supported, reading one by one");
+		hogp->init_repref.single = true;
+		ret = repref_read_start(hogp, rep_idx);
+		if (ret) {
+			hids_prep_error(hogp, ret);
+		}
+		return BT_GATT_ITER_STOP;
+	}
+	if (err) {
+		LOG_ERR("Report (idx: %u) reference read multiple error "
+			"(err: %d)", rep_idx, err);
+		hids_prep_error(hogp, err);
+		return BT_GATT_ITER_STOP;
+	}
+	if (count == 0) {
+		/* Error already reported for this response */
+		return BT_GATT_ITER_STOP;
+	}
+
+	if (data) {
+		if (length != count * REPREF_SIZE) {
+			LOG_ERR("Report (idx: %u) reference unexpected "
+				"size (%u)", rep_idx, length);
+			ret = -ENOTSUP;
+		} else {
+			ret = 0;
+			for (size_t i = 0; (i < count) && !ret; i++) {
+				ret = repref_set(hogp, rep_idx + i,
+						 &bdata[i * REPREF_SIZE]);
+			}
+		}
+		if (ret) {
+			hogp->init_repref.count = 0;
+			hids_prep_error(hogp, ret);
+		}
+		return BT_GATT_ITER_STOP;
+	}
+
+	/* Read complete, next */
+	ret = repref_read_start(hogp, rep_idx + count);
+	if (ret) {
+		hids_prep_error(hogp, ret);
+	}
+
+	return BT_GATT_ITER_STOP;
+}
+#endif /* CONFIG_BT_HOGP_REPREF_READ_MULTIPLE */
+
 static uint8_t repref_read_process(struct bt_conn *conn, uint8_t err,
 				struct bt_gatt_read_params *params,
 				const void *data, uint16_t length)
 {
 	int ret;
 	struct bt_hogp *hogp;
-	struct bt_hogp_rep_info *rep;
 	size_t rep_idx;
-	const uint8_t *bdata = data;
 
 	hogp = CONTAINER_OF(params, struct bt_hogp, read_params);
 
@@ -431,24 +598,18 @@ static uint8_t repref_read_process(struct bt_conn *conn, uint8_t err,
 		hids_prep_error(hogp, err);
 		return BT_GATT_ITER_STOP;
 	}
-	if (length != 2 || !data) {
+	if (length != REPREF_SIZE || !data) {
 		LOG_ERR("Report (idx: %u) reference unexpected size (%u)",
 			rep_idx, length);
 		hids_prep_error(hogp, -ENOTSUP);
 		return BT_GATT_ITER_STOP;
 	}
 
-	rep = hogp->rep_info[rep_idx];
-	if ((uint8_t)rep->ref.type != bdata[1]) {
-		LOG_ERR("Unexpected report type (%u while expecting %u)",
-			bdata[1], rep->ref.type);
-		hids_prep_error(hogp, -EINVAL);
+	ret = repref_set(hogp, rep_idx, data);
+	if (ret) {
+		hids_prep_error(hogp, ret);
 		return BT_GATT_ITER_STOP;
 	}
-	rep->ref.id = bdata[0];
-	LOG_DBG("Report reference read (idx: %u, id: %u)",
-		rep_idx, rep->ref.id);
-
 
 	/* Next */
 	ret = repref_read_start(hogp, rep_idx + 1);
@@ -559,6 +720,9 @@ static int post_discovery_start(struct bt_hogp *hogp)
 		return err;
 	}
 
+#if defined(CONFIG_BT_HOGP_REPREF_READ_MULTIPLE)
+	hogp->init_repref.single = false;
+#endif
 	err = hid_info_read_start(hogp);
 	if (err) {
 		k_sem_give(&hogp->read_params_sem);
@@ -762,6 +926,11 @@ void bt_hogp_init(struct bt_hogp *hogp,
 	hogp->prep_error_cb = params->prep_error_cb;
 	hogp->pm_update_cb  = params->pm_update_cb;
 	k_sem_init(&hogp->read_params_sem, 1, 1);
+#if defined(CONFIG_BT_HOGP_REPORT_BUFFER)
+	ring_buf_init(&hogp->rep_buf.rb, ARRAY_SIZE(hogp->rep_buf.data),
+		      hogp->rep_buf.data);
+	k_sem_init(&hogp->rep_buf.sem, 0, K_SEM_MAX_LIMIT);
+#endif
 }
 
 int bt_hogp_handles_assign(struct bt_gatt_dm *dm,
@@ -805,6 +974,11 @@ void bt_hogp_release(struct bt_hogp *hogp)
 	hogp->map_cb  = NULL;
 	hogp->ready   = false;
 	hogp->conn    = NULL;
+#if defined(CONFIG_BT_HOGP_REPORT_BUFFER)
+	/* Buffered reports refer to the released report objects */
+	ring_buf_reset(&hogp->rep_buf.rb);
+	k_sem_reset(&hogp->rep_buf.sem);
+#endif
 	k_sem_give(&hogp->read_params_sem);
 }
 
@@ -995,6 +1169,38 @@ int bt_hogp_rep_write_wo_rsp(struct bt_hogp *hogp,
 	return err;
 }
 
+#if defined(CONFIG_BT_HOGP_REPORT_BUFFER)
+/**
+ * @brief Copy notified report to the report buffer
+ *
+ * Called from the Bluetooth receive context, which is the only producer.
+ *
+ * @param rep    Report object.
+ * @param data   Report data.
+ * @param length Report data size.
+ */
+static void rep_buffer_put(struct bt_hogp_rep_info *rep,
+			   const void *data, uint8_t length)
+{
+	struct bt_hogp *hogp = rep->hogp;
+	uint32_t item[REP_BUF_ITEM_WORDS_MAX];
+	uint8_t item_words = REP_BUF_PTR_WORDS +
+			     DIV_ROUND_UP(length, sizeof(uint32_t));
+
+	memcpy(item, &rep, sizeof(rep));
+	memcpy(&item[REP_BUF_PTR_WORDS], data, length);
+
+	if (ring_buf_item_put(&hogp->rep_buf.rb, 0, length,
+			      item, item_words)) {
+		atomic_inc(&hogp->rep_buf.dropped);
+		LOG_WRN("Report buffer full, report dropped");
+		return;
+	}
+
+	k_sem_give(&hogp->rep_buf.sem);
+}
+#endif /* CONFIG_BT_HOGP_REPORT_BUFFER */
+
 /**
  * @brief Process report notification
  *
@@ -1026,6 +1232,12 @@ static uint8_t rep_notify_process(struct bt_conn *conn,
 		LOG_WRN("Data size too big, truncating");
 		length = UINT8_MAX;
 	}
+#if defined(CONFIG_BT_HOGP_REPORT_BUFFER)
+	if (rep->buffered && (data != NULL)) {
+		rep_buffer_put(rep, data, (uint8_t)length);
+		return BT_GATT_ITER_CONTINUE;
+	}
+#endif
 	/* Zephyr uses the callback with data set to NULL to inform about the
 	 * subscription removal. Do not update the report size in that case.
 	 */
@@ -1036,9 +1248,10 @@ static uint8_t rep_notify_process(struct bt_conn *conn,
 	return rep->notify_cb(rep->hogp, rep, 0, data);
 }
 
-int bt_hogp_rep_subscribe(struct bt_hogp *hogp,
-			  struct bt_hogp_rep_info *rep,
-			  bt_hogp_read_cb func)
+static int rep_subscribe(struct bt_hogp *hogp,
+			 struct bt_hogp_rep_info *rep,
+			 bt_hogp_read_cb func,
+			 bool buffered)
 {
 	int err;
 
@@ -1053,6 +1266,7 @@ int bt_hogp_rep_subscribe(struct bt_hogp *hogp,
 	}
 
 	rep->notify_cb = func;
+	rep->buffered = buffered;
 
 	rep->notify_params.notify = rep_notify_process;
 	rep->notify_params.value = BT_GATT_CCC_NOTIFY;
@@ -1074,6 +1288,62 @@ int bt_hogp_rep_subscribe(struct bt_hogp *hogp,
 	return err;
 }
 
+int bt_hogp_rep_subscribe(struct bt_hogp *hogp,
+			  struct bt_hogp_rep_info *rep,
+			  bt_hogp_read_cb func)
+{
+	return rep_subscribe(hogp, rep, func, false);
+}
+
+#if defined(CONFIG_BT_HOGP_REPORT_BUFFER)
+int bt_hogp_rep_subscribe_buffered(struct bt_hogp *hogp,
+				   struct bt_hogp_rep_info *rep,
+				   bt_hogp_read_cb func)
+{
+	return rep_subscribe(hogp, rep, func, true);
+}
+
+int bt_hogp_rep_buffer_process(struct bt_hogp *hogp, k_timeout_t timeout)
+{
+	uint32_t item[REP_BUF_ITEM_WORDS_MAX];
+	uint8_t item_words = ARRAY_SIZE(item);
+	struct bt_hogp_rep_info *rep;
+	uint16_t type;
+	uint8_t size;
+	int err;
+
+	if (k_sem_take(&hogp->rep_buf.sem, timeout)) {
+		return -EAGAIN;
+	}
+
+	err = ring_buf_item_get(&hogp->rep_buf.rb, &type, &size,
+				item, &item_words);
+	if (err) {
+		/* Buffer reset in the meantime */
+		return -EAGAIN;
+	}
+
+	memcpy(&rep, item, sizeof(rep));
+	if (!rep->notify_cb) {
+		return 0;
+	}
+
+	rep->size = size;
+	if (rep->notify_cb(hogp, rep, 0,
+			   (const uint8_t *)&item[REP_BUF_PTR_WORDS]) ==
+	    BT_GATT_ITER_STOP) {
+		(void)bt_hogp_rep_unsubscribe(hogp, rep);
+	}
+
+	return 0;
+}
+
+uint32_t bt_hogp_rep_buffer_dropped_get(const struct bt_hogp *hogp)
+{
+	return atomic_get(&hogp->rep_buf.dropped);
+}
+#endif /* CONFIG_BT_HOGP_REPORT_BUFFER */
+
 int bt_hogp_rep_unsubscribe(struct bt_hogp *hogp,
 			    struct bt_hogp_rep_info *rep)
 {
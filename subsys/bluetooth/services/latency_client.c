@@ -17,8 +17,14 @@
 #include <bluetooth/services/latency.h>
 #include <bluetooth/services/latency_client.h>
 
+#if defined(CONFIG_BT_LATENCY_CLIENT_HIST_SHELL)
+#include <shell/shell.h>
+#endif
+
 LOG_MODULE_REGISTER(bt_latency_client, CONFIG_BT_LATENCY_CLIENT_LOG_LEVEL);
 
+#define HIST_SUB_CNT BIT(BT_LATENCY_HIST_SUB_BITS)
+
 enum {
 	LATENCY_INITIALIZED,
 	LATENCY_ASYNC_WRITE_PENDING
@@ -26,6 +32,111 @@ enum {
 
 static const struct bt_latency_client_cb *callbacks;
 
+#if defined(CONFIG_BT_LATENCY_CLIENT_HIST)
+static sys_slist_t clients = SYS_SLIST_STATIC_INIT(&clients);
+
+static size_t hist_index(uint32_t value)
+{
+	uint8_t exp;
+
+	if (value < HIST_SUB_CNT) {
+		return value;
+	}
+
+	exp = 31 - __builtin_clz(value);
+
+	return ((exp - BT_LATENCY_HIST_SUB_BITS + 1) * HIST_SUB_CNT) +
+	       ((value >> (exp - BT_LATENCY_HIST_SUB_BITS)) &
+		(HIST_SUB_CNT - 1));
+}
+
+static uint32_t hist_upper_bound(size_t idx)
+{
+	uint8_t shift;
+	uint32_t lower;
+
+	if (idx < HIST_SUB_CNT) {
+		return idx;
+	}
+
+	shift = (idx / HIST_SUB_CNT) - 1;
+	lower = (HIST_SUB_CNT + (idx % HIST_SUB_CNT)) << shift;
+
+	return lower + (BIT(shift) - 1);
+}
+
+void bt_latency_hist_reset(struct bt_latency_hist *hist)
+{
+	memset(hist, 0, sizeof(*hist));
+	hist->min = UINT32_MAX;
+}
+
+void bt_latency_hist_add(struct bt_latency_hist *hist, uint32_t value)
+{
+	hist->buckets[hist_index(value)]++;
+	hist->count++;
+	hist->min = MIN(hist->min, value);
+	hist->max = MAX(hist->max, value);
+}
+
+uint32_t bt_latency_hist_percentile(const struct bt_latency_hist *hist,
+				    uint8_t pct)
+{
+	uint32_t target;
+	uint32_t sum = 0;
+
+	if (!hist->count) {
+		return 0;
+	}
+
+	target = MAX(1, ((uint64_t)hist->count * MIN(pct, 100) + 99) / 100);
+
+	for (size_t i = 0; i < ARRAY_SIZE(hist->buckets); i++) {
+		sum += hist->buckets[i];
+		if (sum >= target) {
+			return MIN(hist_upper_bound(i), hist->max);
+		}
+	}
+
+	return hist->max;
+}
+
+static void continuous_work_handler(struct k_work *work)
+{
+	int err;
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct bt_latency_client *latency =
+		CONTAINER_OF(dwork, struct bt_latency_client, work);
+
+	err = bt_latency_request(latency, &latency->req_cycles,
+				 sizeof(latency->req_cycles));
+	if (err == -ENOTCONN) {
+		LOG_INF("Link lost, continuous mode stopped");
+		return;
+	}
+
+	k_work_reschedule(&latency->work, K_MSEC(latency->period));
+}
+
+int bt_latency_client_continuous_start(struct bt_latency_client *latency,
+				       uint32_t period)
+{
+	if (!period || !latency->conn) {
+		return -EINVAL;
+	}
+
+	latency->period = period;
+	k_work_reschedule(&latency->work, K_NO_WAIT);
+
+	return 0;
+}
+
+void bt_latency_client_continuous_stop(struct bt_latency_client *latency)
+{
+	(void)k_work_cancel_delayable(&latency->work);
+}
+#endif /* defined(CONFIG_BT_LATENCY_CLIENT_HIST) */
+
 static void received_latency_response(struct bt_conn *conn, uint8_t err,
 				      struct bt_gatt_write_params *params)
 {
@@ -41,6 +152,11 @@ static void received_latency_response(struct bt_conn *conn, uint8_t err,
 	buf = params->data;
 	len = params->length;
 
+#if defined(CONFIG_BT_LATENCY_CLIENT_HIST)
+	uint32_t rtt = k_cyc_to_us_floor32(k_cycle_get_32() -
+					   latency->req_cycles);
+#endif
+
 	atomic_clear_bit(&latency->state, LATENCY_ASYNC_WRITE_PENDING);
 
 	if (err) {
@@ -48,6 +164,10 @@ static void received_latency_response(struct bt_conn *conn, uint8_t err,
 		return;
 	}
 
+#if defined(CONFIG_BT_LATENCY_CLIENT_HIST)
+	bt_latency_hist_add(&latency->hist, rtt);
+#endif
+
 	LOG_DBG("Received Latency response, data %p length %u", buf, len);
 
 	if (callbacks && callbacks->latency_response) {
@@ -67,6 +187,13 @@ int bt_latency_client_init(struct bt_latency_client *latency,
 	}
 
 	callbacks = cb;
+
+#if defined(CONFIG_BT_LATENCY_CLIENT_HIST)
+	bt_latency_hist_reset(&latency->hist);
+	k_work_init_delayable(&latency->work, continuous_work_handler);
+	sys_slist_append(&clients, &latency->node);
+#endif
+
 	return 0;
 }
 
@@ -129,6 +256,10 @@ int bt_latency_request(struct bt_latency_client *latency,
 	latency->latency_params.data = data;
 	latency->latency_params.length = len;
 
+#if defined(CONFIG_BT_LATENCY_CLIENT_HIST)
+	latency->req_cycles = k_cycle_get_32();
+#endif
+
 	err = bt_gatt_write(latency->conn, &latency->latency_params);
 	if (err) {
 		LOG_ERR("Send Latency request failed (err %d)", err);
@@ -137,3 +268,56 @@ int bt_latency_request(struct bt_latency_client *latency,
 
 	return err;
 }
+
+#if defined(CONFIG_BT_LATENCY_CLIENT_HIST_SHELL)
+static int cmd_latency_stats(const struct shell *shell, size_t argc,
+			     char **argv)
+{
+	struct bt_latency_client *latency;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&clients, latency, node) {
+		const struct bt_latency_hist *hist = &latency->hist;
+		char addr[BT_ADDR_LE_STR_LEN];
+
+		if (!latency->conn) {
+			continue;
+		}
+
+		bt_addr_le_to_str(bt_conn_get_dst(latency->conn), addr,
+				  sizeof(addr));
+
+		shell_print(shell,
+			    "%s: count %u p50 %u p95 %u p99 %u max %u [us]",
+			    addr, hist->count,
+			    bt_latency_hist_percentile(hist, 50),
+			    bt_latency_hist_percentile(hist, 95),
+			    bt_latency_hist_percentile(hist, 99),
+			    hist->max);
+	}
+
+	return 0;
+}
+
+static int cmd_latency_reset(const struct shell *shell, size_t argc,
+			     char **argv)
+{
+	struct bt_latency_client *latency;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&clients, latency, node) {
+		bt_latency_hist_reset(&latency->hist);
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_cmd_latency,
+	SHELL_CMD_ARG(stats, NULL, "Print round-trip latency percentiles",
+		      cmd_latency_stats, 1, 0),
+	SHELL_CMD_ARG(reset, NULL, "Reset the histograms",
+		      cmd_latency_reset, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_ARG_REGISTER(bt_latency, &sub_cmd_latency, "Latency client",
+		       cmd_latency_stats, 1, 1);
+#endif /* defined(CONFIG_BT_LATENCY_CLIENT_HIST_SHELL) */
@@ -15,6 +15,15 @@ LOG_MODULE_REGISTER(bt_nus, CONFIG_BT_NUS_LOG_LEVEL);
 
 static struct bt_nus_cb nus_cb;
 
+#if defined(CONFIG_BT_NUS_STREAM)
+struct nus_stream {
+	/* Notifications that can still be queued for the connection. */
+	struct k_sem credits;
+};
+
+static struct nus_stream streams[CONFIG_BT_MAX_CONN];
+#endif /* defined(CONFIG_BT_NUS_STREAM) */
+
 static void nus_ccc_cfg_changed(const struct bt_gatt_attr *attr,
 				  uint16_t value)
 {
@@ -53,6 +62,51 @@ static void on_sent(struct bt_conn *conn, void *user_data)
 	}
 }
 
+#if defined(CONFIG_BT_NUS_STREAM)
+static void on_stream_sent(struct bt_conn *conn, void *user_data)
+{
+	struct nus_stream *stream = user_data;
+
+	k_sem_give(&stream->credits);
+	on_sent(conn, NULL);
+}
+
+static void stream_disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	struct nus_stream *stream = &streams[bt_conn_index(conn)];
+
+	/* Notifications still queued for the link are dropped without
+	 * a TX complete callback, so return all credits here. The
+	 * semaphore limit keeps late callbacks from adding more.
+	 */
+	for (size_t i = 0; i < CONFIG_BT_NUS_STREAM_CREDITS; i++) {
+		k_sem_give(&stream->credits);
+	}
+}
+
+static struct bt_conn_cb stream_conn_callbacks = {
+	.disconnected = stream_disconnected,
+};
+
+static void stream_init(void)
+{
+	static bool initialized;
+
+	if (initialized) {
+		return;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(streams); i++) {
+		k_sem_init(&streams[i].credits,
+			   CONFIG_BT_NUS_STREAM_CREDITS,
+			   CONFIG_BT_NUS_STREAM_CREDITS);
+	}
+
+	bt_conn_cb_register(&stream_conn_callbacks);
+	initialized = true;
+}
+#endif /* defined(CONFIG_BT_NUS_STREAM) */
+
 /* UART Service Declaration */
 BT_GATT_SERVICE_DEFINE(nus_svc,
 BT_GATT_PRIMARY_SERVICE(BT_UUID_NUS_SERVICE),
@@ -76,6 +130,10 @@ int bt_nus_init(struct bt_nus_cb *callbacks)
 		nus_cb.send_enabled = callbacks->send_enabled;
 	}
 
+#if defined(CONFIG_BT_NUS_STREAM)
+	stream_init();
+#endif
+
 	return 0;
 }
 
@@ -98,3 +156,108 @@ int bt_nus_send(struct bt_conn *conn, const uint8_t *data, uint16_t len)
 		return -EINVAL;
 	}
 }
+
+#if defined(CONFIG_BT_NUS_STREAM)
+static struct nus_stream *stream_get(struct bt_conn *conn)
+{
+	if (!conn ||
+	    !bt_gatt_is_subscribed(conn, &nus_svc.attrs[2], BT_GATT_CCC_NOTIFY)) {
+		return NULL;
+	}
+
+	return &streams[bt_conn_index(conn)];
+}
+
+static int stream_chunk_send(struct bt_conn *conn, struct nus_stream *stream,
+			     const uint8_t *data, uint16_t len,
+			     k_timeout_t timeout)
+{
+	int err;
+	struct bt_gatt_notify_params params = {0};
+
+	if (k_sem_take(&stream->credits, timeout)) {
+		return -EAGAIN;
+	}
+
+	params.attr = &nus_svc.attrs[2];
+	params.data = data;
+	params.len = len;
+	params.func = on_stream_sent;
+	params.user_data = stream;
+
+	err = bt_gatt_notify_cb(conn, &params);
+	if (err) {
+		k_sem_give(&stream->credits);
+	}
+
+	return err;
+}
+
+int bt_nus_stream_send(struct bt_conn *conn, const uint8_t *data, size_t len,
+		       k_timeout_t timeout)
+{
+	int err;
+	size_t sent = 0;
+	uint16_t chunk_max;
+	struct nus_stream *stream = stream_get(conn);
+
+	if (!stream) {
+		return -EINVAL;
+	}
+
+	chunk_max = bt_nus_get_mtu(conn);
+
+	while (sent < len) {
+		uint16_t chunk = MIN(len - sent, chunk_max);
+
+		err = stream_chunk_send(conn, stream, &data[sent], chunk,
+					timeout);
+		if (err) {
+			LOG_DBG("Stream stopped after %zu bytes (err %d)",
+				sent, err);
+			return sent ? sent : err;
+		}
+
+		sent += chunk;
+	}
+
+	return sent;
+}
+
+int bt_nus_stream_send_ring(struct bt_conn *conn, struct ring_buf *rb,
+			    k_timeout_t timeout)
+{
+	int err;
+	size_t sent = 0;
+	uint16_t chunk_max;
+	struct nus_stream *stream = stream_get(conn);
+
+	if (!stream) {
+		return -EINVAL;
+	}
+
+	chunk_max = bt_nus_get_mtu(conn);
+
+	while (true) {
+		uint8_t *data;
+		uint32_t chunk = ring_buf_get_claim(rb, &data, chunk_max);
+
+		if (!chunk) {
+			break;
+		}
+
+		err = stream_chunk_send(conn, stream, data, chunk, timeout);
+		ring_buf_get_finish(rb, err ? 0 : chunk);
+
+		if (err) {
+			LOG_DBG("Stream stopped after %zu bytes (err %d)",
+				sent, err);
+			return sent ? sent : err;
+		}
+
+		sent += chunk;
+	}
+
+	return sent;
+}
+#endif /* defined(CONFIG_BT_NUS_STREAM) */
@@ -17,6 +17,10 @@
 
 #include <bluetooth/services/throughput.h>
 
+#if defined(CONFIG_CPU_LOAD)
+#include <debug/cpu_load.h>
+#endif
+
 #include <logging/log.h>
 
 LOG_MODULE_REGISTER(bt_throughput, CONFIG_BT_THROUGHPUT_LOG_LEVEL);
@@ -100,14 +104,452 @@ static ssize_t read_callback(struct bt_conn *conn,
 }
 
 
+#if defined(CONFIG_BT_THROUGHPUT_BENCH)
+#define THROUGHPUT_CHRC_PROPS \
+	(BT_GATT_CHRC_READ | BT_GATT_CHRC_WRITE_WITHOUT_RESP | \
+	 BT_GATT_CHRC_NOTIFY)
+#define THROUGHPUT_CCC \
+	BT_GATT_CCC(NULL, BT_GATT_PERM_READ | BT_GATT_PERM_WRITE),
+#else
+#define THROUGHPUT_CHRC_PROPS \
+	(BT_GATT_CHRC_READ | BT_GATT_CHRC_WRITE_WITHOUT_RESP)
+#define THROUGHPUT_CCC
+#endif /* defined(CONFIG_BT_THROUGHPUT_BENCH) */
+
 BT_GATT_SERVICE_DEFINE(throughput_svc,
 BT_GATT_PRIMARY_SERVICE(BT_UUID_THROUGHPUT),
 	BT_GATT_CHARACTERISTIC(BT_UUID_THROUGHPUT_CHAR,
-		BT_GATT_CHRC_READ | BT_GATT_CHRC_WRITE_WITHOUT_RESP,
+		THROUGHPUT_CHRC_PROPS,
 		BT_GATT_PERM_READ | BT_GATT_PERM_WRITE,
 		read_callback, write_callback, &met),
+	THROUGHPUT_CCC
 );
 
+#if defined(CONFIG_BT_THROUGHPUT_BENCH)
+#define BENCH_CREDITS CONFIG_BT_THROUGHPUT_BENCH_CREDITS
+#define BENCH_SAMPLES CONFIG_BT_THROUGHPUT_BENCH_LATENCY_SAMPLES
+#define BENCH_TIMEOUT K_MSEC(CONFIG_BT_THROUGHPUT_BENCH_UPDATE_TIMEOUT)
+
+static struct {
+	struct bt_conn *conn;
+	atomic_t busy;
+	bool disconnected;
+
+	/* Signalled when a link update of the connection completes. */
+	struct k_sem update_sem;
+	/* Packets that can still be queued. */
+	struct k_sem credits;
+
+	/* Queue times of the packets in flight. The host completes the
+	 * packets of a connection in order, so a FIFO is enough.
+	 */
+	uint32_t tx_cycles[BENCH_CREDITS];
+	uint8_t tx_head;
+	uint8_t tx_tail;
+
+	uint32_t latency[BENCH_SAMPLES];
+	uint32_t latency_cnt;
+	uint32_t latency_max;
+} bench;
+
+static uint8_t bench_data[CONFIG_BT_L2CAP_TX_MTU];
+
+static void bench_sent(struct bt_conn *conn, void *user_data)
+{
+	uint32_t cycles = k_cycle_get_32() - bench.tx_cycles[bench.tx_tail];
+	uint32_t latency = k_cyc_to_us_floor32(cycles);
+
+	bench.tx_tail = (bench.tx_tail + 1) % BENCH_CREDITS;
+
+	bench.latency[bench.latency_cnt % BENCH_SAMPLES] = latency;
+	bench.latency_cnt++;
+	bench.latency_max = MAX(bench.latency_max, latency);
+
+	k_sem_give(&bench.credits);
+}
+
+static void bench_link_updated(struct bt_conn *conn)
+{
+	if (conn == bench.conn) {
+		k_sem_give(&bench.update_sem);
+	}
+}
+
+static void bench_param_updated(struct bt_conn *conn, uint16_t interval,
+				uint16_t latency, uint16_t timeout)
+{
+	bench_link_updated(conn);
+}
+
+static void bench_phy_updated(struct bt_conn *conn,
+			      struct bt_conn_le_phy_info *param)
+{
+	bench_link_updated(conn);
+}
+
+static void bench_data_len_updated(struct bt_conn *conn,
+				   struct bt_conn_le_data_len_info *info)
+{
+	bench_link_updated(conn);
+}
+
+static void bench_disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	if (conn != bench.conn) {
+		return;
+	}
+
+	bench.disconnected = true;
+
+	/* Unblock the sender, packets of the link are dropped. */
+	for (size_t i = 0; i < BENCH_CREDITS; i++) {
+		k_sem_give(&bench.credits);
+	}
+	k_sem_give(&bench.update_sem);
+}
+
+static struct bt_conn_cb bench_conn_callbacks = {
+	.disconnected = bench_disconnected,
+	.le_param_updated = bench_param_updated,
+	.le_phy_updated = bench_phy_updated,
+	.le_data_len_updated = bench_data_len_updated,
+};
+
+static void bench_init(void)
+{
+	static bool initialized;
+
+	if (initialized) {
+		return;
+	}
+
+	k_sem_init(&bench.update_sem, 0, 1);
+	k_sem_init(&bench.credits, BENCH_CREDITS, BENCH_CREDITS);
+	memset(bench_data, 0xAA, sizeof(bench_data));
+
+	bt_conn_cb_register(&bench_conn_callbacks);
+	initialized = true;
+}
+
+static int bench_update_wait(void)
+{
+	if (k_sem_take(&bench.update_sem, BENCH_TIMEOUT)) {
+		return -ETIMEDOUT;
+	}
+
+	return bench.disconnected ? -ENOTCONN : 0;
+}
+
+static int bench_link_update(struct bt_conn *conn,
+			     const struct bt_throughput_bench_cfg *cfg)
+{
+	int err;
+	struct bt_conn_info info;
+
+	err = bt_conn_get_info(conn, &info);
+	if (err) {
+		return err;
+	}
+
+	if (cfg->phy && (cfg->phy != info.le.phy->tx_phy)) {
+		const struct bt_conn_le_phy_param param = {
+			.options = BT_CONN_LE_PHY_OPT_NONE,
+			.pref_tx_phy = cfg->phy,
+			.pref_rx_phy = cfg->phy,
+		};
+
+		k_sem_reset(&bench.update_sem);
+
+		err = bt_conn_le_phy_update(conn, &param);
+		if (!err) {
+			err = bench_update_wait();
+		}
+		if (err) {
+			LOG_ERR("PHY update failed (err %d)", err);
+			return err;
+		}
+	}
+
+	if (cfg->data_len && (cfg->data_len != info.le.data_len->tx_max_len)) {
+		const struct bt_conn_le_data_len_param param = {
+			.tx_max_len = cfg->data_len,
+			.tx_max_time = BT_GAP_DATA_TIME_MAX,
+		};
+
+		k_sem_reset(&bench.update_sem);
+
+		err = bt_conn_le_data_len_update(conn, &param);
+		if (!err) {
+			err = bench_update_wait();
+		}
+		if (err) {
+			LOG_ERR("Data length update failed (err %d)", err);
+			return err;
+		}
+	}
+
+	if (cfg->interval && (cfg->interval != info.le.interval)) {
+		/* The supervision timeout must cover more than two
+		 * connection intervals.
+		 */
+		const struct bt_le_conn_param param = {
+			.interval_min = cfg->interval,
+			.interval_max = cfg->interval,
+			.latency = 0,
+			.timeout = MAX(400, cfg->interval / 2),
+		};
+
+		k_sem_reset(&bench.update_sem);
+
+		err = bt_conn_le_param_update(conn, &param);
+		if (!err) {
+			err = bench_update_wait();
+		}
+		if (err) {
+			LOG_ERR("Connection parameters update failed (err %d)",
+				err);
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+static int bench_packet_send(struct bt_throughput *throughput,
+			     const struct bt_throughput_bench_cfg *cfg,
+			     uint16_t len)
+{
+	if (cfg->mode == BT_THROUGHPUT_BENCH_NOTIFY) {
+		struct bt_gatt_notify_params params = {
+			.attr = &throughput_svc.attrs[2],
+			.data = bench_data,
+			.len = len,
+			.func = bench_sent,
+		};
+
+		return bt_gatt_notify_cb(throughput->conn, &params);
+	}
+
+	return bt_gatt_write_without_response_cb(throughput->conn,
+						 throughput->char_handle,
+						 bench_data, len, false,
+						 bench_sent, NULL);
+}
+
+static void bench_latency_sort(uint32_t *samples, size_t cnt)
+{
+	for (size_t i = 1; i < cnt; i++) {
+		uint32_t val = samples[i];
+		size_t j = i;
+
+		while ((j > 0) && (samples[j - 1] > val)) {
+			samples[j] = samples[j - 1];
+			j--;
+		}
+
+		samples[j] = val;
+	}
+}
+
+static uint32_t bench_percentile(const uint32_t *sorted, size_t cnt,
+				 uint8_t pct)
+{
+	return cnt ? sorted[((cnt - 1) * pct) / 100] : 0;
+}
+
+static void bench_latency_report(struct bt_throughput_bench_result *res)
+{
+	size_t cnt = MIN(bench.latency_cnt, BENCH_SAMPLES);
+
+	bench_latency_sort(bench.latency, cnt);
+
+	res->latency_p50 = bench_percentile(bench.latency, cnt, 50);
+	res->latency_p90 = bench_percentile(bench.latency, cnt, 90);
+	res->latency_p99 = bench_percentile(bench.latency, cnt, 99);
+	res->latency_max = bench.latency_max;
+}
+
+static int bench_traffic_run(struct bt_throughput *throughput,
+			     const struct bt_throughput_bench_cfg *cfg,
+			     struct bt_throughput_bench_result *res)
+{
+	int err = 0;
+	uint32_t start;
+	uint16_t len = res->payload_len;
+
+	bench.tx_head = 0;
+	bench.tx_tail = 0;
+	bench.latency_cnt = 0;
+	bench.latency_max = 0;
+
+#if defined(CONFIG_CPU_LOAD)
+	err = cpu_load_init();
+	if (err) {
+		LOG_WRN("CPU load measurement not available (err %d)", err);
+		err = 0;
+	}
+	cpu_load_reset();
+#endif
+
+	start = k_uptime_get_32();
+
+	while ((k_uptime_get_32() - start) < cfg->duration) {
+		if (k_sem_take(&bench.credits, BENCH_TIMEOUT)) {
+			err = -ETIMEDOUT;
+			break;
+		}
+
+		if (bench.disconnected) {
+			err = -ENOTCONN;
+			break;
+		}
+
+		bench.tx_cycles[bench.tx_head] = k_cycle_get_32();
+		bench.tx_head = (bench.tx_head + 1) % BENCH_CREDITS;
+
+		err = bench_packet_send(throughput, cfg, len);
+		if (err) {
+			bench.tx_head = (bench.tx_head + BENCH_CREDITS - 1) %
+					BENCH_CREDITS;
+			k_sem_give(&bench.credits);
+			break;
+		}
+
+		res->packets++;
+		res->bytes += len;
+	}
+
+	/* Wait for the packets in flight, so that the duration and the
+	 * latencies cover all queued data.
+	 */
+	for (size_t i = 0; i < BENCH_CREDITS; i++) {
+		if (k_sem_take(&bench.credits, BENCH_TIMEOUT) && !err) {
+			err = -ETIMEDOUT;
+		}
+	}
+	for (size_t i = 0; i < BENCH_CREDITS; i++) {
+		k_sem_give(&bench.credits);
+	}
+
+	res->duration = k_uptime_get_32() - start;
+	if (res->duration) {
+		res->rate = ((uint64_t)res->bytes << 3) * 1000 / res->duration;
+	}
+
+#if defined(CONFIG_CPU_LOAD)
+	res->cpu_load = cpu_load_get();
+#endif
+
+	bench_latency_report(res);
+
+	return err;
+}
+
+static void bench_config_run(struct bt_throughput *throughput,
+			     const struct bt_throughput_bench_cfg *cfg,
+			     struct bt_throughput_bench_result *res)
+{
+	int err;
+	struct bt_conn_info info;
+	uint16_t payload_max;
+
+	memset(res, 0, sizeof(*res));
+	res->cfg = cfg;
+
+	err = bench_link_update(throughput->conn, cfg);
+	if (!err) {
+		err = bt_conn_get_info(throughput->conn, &info);
+	}
+	if (err) {
+		res->err = err;
+		return;
+	}
+
+	res->phy = info.le.phy->tx_phy;
+	res->data_len = info.le.data_len->tx_max_len;
+	res->interval = info.le.interval;
+	res->mtu = bt_gatt_get_mtu(throughput->conn);
+
+	payload_max = MIN(res->mtu - 3, sizeof(bench_data));
+	res->payload_len = cfg->payload_len ?
+			   MIN(cfg->payload_len, payload_max) : payload_max;
+
+	if (cfg->mode == BT_THROUGHPUT_BENCH_NOTIFY) {
+		if (!bt_gatt_is_subscribed(throughput->conn,
+					   &throughput_svc.attrs[2],
+					   BT_GATT_CCC_NOTIFY)) {
+			res->err = -EINVAL;
+			return;
+		}
+	} else {
+		/* A single byte write resets the peer metrics, so data
+		 * packets must be longer.
+		 */
+		res->payload_len = MAX(res->payload_len, 2);
+
+		err = bt_throughput_write(throughput, bench_data, 1);
+		if (err) {
+			res->err = err;
+			return;
+		}
+	}
+
+	res->err = bench_traffic_run(throughput, cfg, res);
+}
+
+int bt_throughput_bench_run(struct bt_throughput *throughput,
+			    const struct bt_throughput_bench_cfg *cfg,
+			    size_t cfg_cnt, bt_throughput_bench_cb cb)
+{
+	struct bt_throughput_bench_result res;
+
+	if (!throughput || !throughput->conn || !cfg || !cb || !callbacks) {
+		return -EINVAL;
+	}
+
+	if (!atomic_cas(&bench.busy, 0, 1)) {
+		return -EBUSY;
+	}
+
+	bench.conn = throughput->conn;
+	bench.disconnected = false;
+
+	for (size_t i = 0; i < cfg_cnt; i++) {
+		bench_config_run(throughput, &cfg[i], &res);
+
+		LOG_DBG("Configuration %zu done, %u bps (err %d)",
+			i, res.rate, res.err);
+
+		cb(&res);
+
+		if (bench.disconnected) {
+			break;
+		}
+	}
+
+	bench.conn = NULL;
+	atomic_set(&bench.busy, 0);
+
+	return 0;
+}
+
+int bt_throughput_bench_result_csv(
+	const struct bt_throughput_bench_result *result,
+	char *buf, size_t size)
+{
+	return snprintk(buf, size,
+			"%s,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%d",
+			(result->cfg->mode == BT_THROUGHPUT_BENCH_NOTIFY) ?
+			"notify" : "write",
+			result->phy, result->data_len, result->interval,
+			result->mtu, result->payload_len, result->packets,
+			result->bytes, result->duration, result->rate,
+			result->latency_p50, result->latency_p90,
+			result->latency_p99, result->latency_max,
+			result->cpu_load, result->err);
+}
+#endif /* defined(CONFIG_BT_THROUGHPUT_BENCH) */
+
 int bt_throughput_init(struct bt_throughput *throughput,
 		       const struct bt_throughput_cb *cb)
 {
@@ -117,6 +559,10 @@ int bt_throughput_init(struct bt_throughput *throughput,
 
 	callbacks = cb;
 
+#if defined(CONFIG_BT_THROUGHPUT_BENCH)
+	bench_init();
+#endif
+
 	return 0;
 }
 
@@ -14,7 +14,7 @@
 #include <bl_crypto.h>
 #include "bl_crypto_cc310_common.h"
 
-#define MAX_CHUNK_LEN 0x8000 /* Must be 4 byte aligned. */
+#define MAX_CHUNK_LEN CONFIG_SB_CRYPTO_CC310_SHA256_CHUNK_LEN
 #define CHUNK_LEN_STACK 0x200
 #define RAM_BUFFER_LEN_WORDS ((MAX_CHUNK_LEN) / 4)
 #define STACK_BUFFER_LEN_WORDS ((CHUNK_LEN_STACK) / 4)
@@ -33,6 +33,9 @@
 #define CRYS_HASH_LAST_BLOCK_ALREADY_PROCESSED_ERROR \
 	(CRYS_HASH_MODULE_ERROR_BASE + 0xCUL)
 
+BUILD_ASSERT((MAX_CHUNK_LEN % 4) == 0,
+		"CONFIG_SB_CRYPTO_CC310_SHA256_CHUNK_LEN must be 4 byte aligned.");
+
 BUILD_ASSERT(SHA256_CTX_SIZE >= sizeof(nrf_cc310_bl_hash_context_sha256_t), \
 		"nrf_cc310_bl_hash_context_sha256_t can no longer fit inside " \
 		"bl_sha256_ctx_t.");
@@ -64,6 +64,8 @@ bool bl_validate_firmware(uint32_t fw_dst_address, uint32_t fw_src_address)
 #include <errno.h>
 #include <sys/printk.h>
 #include <toolchain.h>
+#include <stddef.h>
+#include <linker/sections.h>
 #include <bl_crypto.h>
 #include "bl_validation_internal.h"
 
@@ -143,6 +145,72 @@ validation_info_find(uint32_t start_address, uint32_t search_distance)
 	return NULL;
 }
 
+#ifdef CONFIG_SB_VALIDATION_CACHE
+#define VALIDATION_CACHE_MAGIC 0x56434348
+
+/* Digest of the last firmware whose signature was verified. Kept in RAM that
+ * is not cleared by a warm reset, and lost on power-on reset.
+ */
+struct validation_cache {
+	uint32_t magic;
+	uint32_t address;
+	uint32_t size;
+	uint8_t hash[CONFIG_SB_HASH_LEN];
+	uint32_t check;
+};
+
+static struct validation_cache __noinit validation_cache;
+
+static uint32_t validation_cache_check(const struct validation_cache *cache)
+{
+	const uint32_t *words = (const uint32_t *)cache;
+	uint32_t check = 0;
+
+	for (size_t i = 0; i < offsetof(struct validation_cache, check) / 4;
+			i++) {
+		check ^= words[i];
+	}
+	return ~check;
+}
+
+static bool validation_cache_hit(uint32_t fw_address, uint32_t fw_size)
+{
+	if ((validation_cache.magic != VALIDATION_CACHE_MAGIC)
+		|| (validation_cache.check !=
+			validation_cache_check(&validation_cache))
+		|| (validation_cache.address != fw_address)
+		|| (validation_cache.size != fw_size)) {
+		return false;
+	}
+
+	/* The image may have been changed since it was verified. */
+	return bl_sha256_verify((const uint8_t *)fw_address, fw_size,
+				validation_cache.hash) == 0;
+}
+
+static void validation_cache_store(uint32_t fw_address, uint32_t fw_size)
+{
+	bl_sha256_ctx_t ctx;
+
+	validation_cache.magic = 0;
+
+	if ((bl_sha256_init(&ctx) != 0)
+		|| (bl_sha256_update(&ctx, (const uint8_t *)fw_address,
+					fw_size) != 0)
+		|| (bl_sha256_finalize(&ctx, validation_cache.hash) != 0)) {
+		return;
+	}
+
+	validation_cache.address = fw_address;
+	validation_cache.size = fw_size;
+	validation_cache.magic = VALIDATION_CACHE_MAGIC;
+	validation_cache.check = validation_cache_check(&validation_cache);
+}
+
+BUILD_ASSERT((offsetof(struct validation_cache, check) % 4) == 0,
+		"validation_cache must be word aligned.");
+#endif /* CONFIG_SB_VALIDATION_CACHE */
+
 #ifdef CONFIG_SB_VALIDATE_FW_SIGNATURE
 static bool validate_signature(const uint32_t fw_src_address, const uint32_t fw_size,
 			       const struct fw_validation_info *fw_val_info,
@@ -155,6 +223,13 @@ static bool validate_signature(const uint32_t fw_src_address, const uint32_t fw_
 		return false;
 	}
 
+#ifdef CONFIG_SB_VALIDATION_CACHE
+	if (!external && validation_cache_hit(fw_src_address, fw_size)) {
+		PRINT("Firmware unchanged since its signature was verified.\n\r");
+		return true;
+	}
+#endif
+
 	init_retval = verify_public_keys();
 	if (init_retval) {
 		PRINT("verify_public_keys() returned %d.\n\r", init_retval);
@@ -203,6 +278,11 @@ static bool validate_signature(const uint32_t fw_src_address, const uint32_t fw_
 				PRINT("Invalidating key %d.\n\r", i);
 				invalidate_public_key(i);
 			}
+#ifdef CONFIG_SB_VALIDATION_CACHE
+			if (!external) {
+				validation_cache_store(fw_src_address, fw_size);
+			}
+#endif
 			PRINT("Firmware signature verified.\n\r");
 			return true;
 		} else if (retval == -EHASHINV) {
@@ -333,15 +413,25 @@ static bool validate_firmware(uint32_t fw_dst_address, uint32_t fw_src_address,
 		return false;
 	}
 
+	uint32_t start = k_uptime_get_32();
+	bool valid;
+
 #ifdef CONFIG_SB_VALIDATE_FW_SIGNATURE
-	return validate_signature(fw_src_address, fwinfo->size, fw_val_info,
+	valid = validate_signature(fw_src_address, fwinfo->size, fw_val_info,
 				external);
 #elif defined(CONFIG_SB_VALIDATE_FW_HASH)
-	return validate_hash(fw_src_address, fwinfo->size, fw_val_info,
+	valid = validate_hash(fw_src_address, fwinfo->size, fw_val_info,
 				external);
 #else
 	#error "Validation not specified."
 #endif
+
+	if (IS_ENABLED(CONFIG_SB_VALIDATION_TIMING)) {
+		PRINT("Validated %u bytes in %u ms.\n\r", fwinfo->size,
+			k_uptime_get_32() - start);
+	}
+
+	return valid;
 }
 
 
@@ -21,9 +21,15 @@ static void profile_button_event(struct log_event_buf *buf,
 				 const struct event_header *eh)
 {
 	const struct button_event *event = cast_button_event(eh);
-
-	profiler_log_encode_uint16(buf, event->key_id);
-	profiler_log_encode_uint8(buf, (event->pressed)?(1):(0));
+	const struct {
+		uint16_t key_id;
+		uint8_t pressed;
+	} __packed data = {
+		.key_id = event->key_id,
+		.pressed = (event->pressed)?(1):(0),
+	};
+
+	PROFILER_LOG_ENCODE_PACKED(buf, data);
 }
 
 EVENT_INFO_DEFINE(button_event,
@@ -71,6 +71,31 @@ enum peer_rpa {
 
 static enum peer_rpa peer_is_rpa[CONFIG_BT_ID_MAX];
 
+#if CONFIG_CAF_BLE_ADV_PREPARED_SETS
+enum adv_set_type {
+	ADV_SET_FAST,
+	ADV_SET_SLOW,
+	ADV_SET_DIRECT,
+
+	ADV_SET_COUNT
+};
+
+struct adv_set {
+	struct bt_le_ext_adv *adv;
+	/* Local identity and peer address the set is prepared for. */
+	uint8_t id;
+	bt_addr_le_t peer;
+	bool fast;
+	bool ready;
+};
+
+BUILD_ASSERT(CONFIG_BT_EXT_ADV_MAX_ADV_SET >= ADV_SET_COUNT,
+	     "Not enough advertising sets");
+
+static struct adv_set adv_sets[ADV_SET_COUNT];
+static struct bt_le_ext_adv *adv_cur;
+#endif /* CONFIG_CAF_BLE_ADV_PREPARED_SETS */
+
 
 static int settings_set(const char *key, size_t len_rd, settings_read_cb read_cb, void *cb_arg)
 {
@@ -111,18 +136,119 @@ static void broadcast_adv_state(bool active)
 	LOG_INF("Advertising %s", (active)?("started"):("stopped"));
 }
 
+#if CONFIG_CAF_BLE_ADV_PREPARED_SETS
+static int adv_sets_stop(struct bt_le_ext_adv *except)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(adv_sets); i++) {
+		struct bt_le_ext_adv *adv = adv_sets[i].adv;
+
+		if (adv && (adv != except)) {
+			/* Stopping a set that does not advertise is a no-op. */
+			int err = bt_le_ext_adv_stop(adv);
+
+			if (err) {
+				return err;
+			}
+		}
+	}
+
+	adv_cur = except;
+
+	return 0;
+}
+
+static bool adv_set_is_ready(const struct adv_set *set, const bt_addr_le_t *peer,
+			     bool fast)
+{
+	return set->ready && (set->id == cur_identity) && (set->fast == fast) &&
+	       !bt_addr_le_cmp(&set->peer, peer);
+}
+
+static int adv_set_prepare(struct adv_set *set, const struct bt_le_adv_param *adv_param,
+			   const bt_addr_le_t *peer, bool fast,
+			   const struct bt_data *ad, size_t ad_len)
+{
+	int err;
+
+	set->ready = false;
+
+	if (!set->adv) {
+		err = bt_le_ext_adv_create(adv_param, NULL, &set->adv);
+	} else {
+		err = bt_le_ext_adv_update_param(set->adv, adv_param);
+	}
+
+	/* Directed advertising carries no data. */
+	if (!err && ad) {
+		err = bt_le_ext_adv_set_data(set->adv, ad, ad_len,
+					     sd, ARRAY_SIZE(sd));
+	}
+
+	if (err) {
+		LOG_ERR("Cannot prepare advertising set (err %d)", err);
+		return err;
+	}
+
+	set->id = adv_param->id;
+	set->fast = fast;
+	bt_addr_le_copy(&set->peer, peer);
+	set->ready = true;
+
+	return 0;
+}
+
+static int adv_set_start(struct adv_set *set)
+{
+	int err;
+
+	if (set->adv == adv_cur) {
+		/* The set could have been stopped by the controller, for
+		 * example on directed advertising timeout. Restart it.
+		 */
+		err = bt_le_ext_adv_stop(set->adv);
+		if (err) {
+			return err;
+		}
+	}
+
+	err = bt_le_ext_adv_start(set->adv, BT_LE_EXT_ADV_START_DEFAULT);
+	if (err) {
+		return err;
+	}
+
+	/* The previous set is stopped after the new one is started, so that
+	 * the device keeps advertising while switching.
+	 */
+	return adv_sets_stop(set->adv);
+}
+#endif /* CONFIG_CAF_BLE_ADV_PREPARED_SETS */
+
+static int adv_disable(void)
+{
+#if CONFIG_CAF_BLE_ADV_PREPARED_SETS
+	return adv_sets_stop(NULL);
+#else
+	return bt_le_adv_stop();
+#endif
+}
+
+static void adv_timeouts_cancel(void)
+{
+	k_work_cancel_delayable(&adv_update);
+
+	if (IS_ENABLED(CONFIG_CAF_BLE_ADV_SWIFT_PAIR) &&
+	    IS_ENABLED(CONFIG_CAF_BLE_ADV_PM_EVENTS)) {
+		k_work_cancel_delayable(&sp_grace_period_to);
+	}
+}
+
 static int ble_adv_stop(void)
 {
-	int err = bt_le_adv_stop();
+	int err = adv_disable();
 	if (err) {
 		LOG_ERR("Cannot stop advertising (err %d)", err);
 	} else {
-		k_work_cancel_delayable(&adv_update);
-
-		if (IS_ENABLED(CONFIG_CAF_BLE_ADV_SWIFT_PAIR) &&
-		    IS_ENABLED(CONFIG_CAF_BLE_ADV_PM_EVENTS)) {
-			k_work_cancel_delayable(&sp_grace_period_to);
-		}
+		adv_timeouts_cancel();
 
 		state = STATE_IDLE;
 
@@ -175,7 +301,27 @@ static int ble_adv_start_directed(const bt_addr_le_t *addr, bool fast_adv)
 
 	adv_param.id = cur_identity;
 
+#if CONFIG_CAF_BLE_ADV_PREPARED_SETS
+	struct adv_set *set = &adv_sets[ADV_SET_DIRECT];
+	int err = 0;
+
+	if (!adv_set_is_ready(set, addr, fast_adv)) {
+		/* Parameters cannot change while the set advertises. */
+		if (set->adv == adv_cur) {
+			err = adv_sets_stop(NULL);
+		}
+		if (!err) {
+			err = adv_set_prepare(set, &adv_param, addr, fast_adv,
+					      NULL, 0);
+		}
+	}
+
+	if (!err) {
+		err = adv_set_start(set);
+	}
+#else
 	int err = bt_le_adv_start(&adv_param, NULL, 0, NULL, 0);
+#endif
 
 	if (err) {
 		return err;
@@ -189,44 +335,88 @@ static int ble_adv_start_directed(const bt_addr_le_t *addr, bool fast_adv)
 	return 0;
 }
 
-static int ble_adv_start_undirected(const bt_addr_le_t *bond_addr,
-				    bool fast_adv)
+static void adv_param_undirected_get(struct bt_le_adv_param *adv_param,
+				     const bt_addr_le_t *bond_addr, bool fast_adv)
 {
-	struct bt_le_adv_param adv_param = {
+	*adv_param = (struct bt_le_adv_param) {
+		.id = cur_identity,
 		.options = BT_LE_ADV_OPT_CONNECTABLE | BT_LE_ADV_OPT_ONE_TIME |
 			   BT_LE_ADV_OPT_USE_NAME,
 	};
 
-	LOG_INF("Use %s advertising", (fast_adv)?("fast"):("slow"));
 	if (fast_adv) {
-		adv_param.interval_min = BT_GAP_ADV_FAST_INT_MIN_1;
-		adv_param.interval_max = BT_GAP_ADV_FAST_INT_MAX_1;
+		adv_param->interval_min = BT_GAP_ADV_FAST_INT_MIN_1;
+		adv_param->interval_max = BT_GAP_ADV_FAST_INT_MAX_1;
 	} else {
-		adv_param.interval_min = BT_GAP_ADV_FAST_INT_MIN_2;
-		adv_param.interval_max = BT_GAP_ADV_FAST_INT_MAX_2;
+		adv_param->interval_min = BT_GAP_ADV_FAST_INT_MIN_2;
+		adv_param->interval_max = BT_GAP_ADV_FAST_INT_MAX_2;
 	}
 
-	if (IS_ENABLED(CONFIG_BT_WHITELIST)) {
-		int err = bt_le_whitelist_clear();
+	if (IS_ENABLED(CONFIG_BT_WHITELIST) &&
+	    bt_addr_le_cmp(bond_addr, BT_ADDR_LE_ANY)) {
+		adv_param->options |= BT_LE_ADV_OPT_FILTER_SCAN_REQ;
+		adv_param->options |= BT_LE_ADV_OPT_FILTER_CONN;
+	}
+}
 
-		if (err) {
-			LOG_ERR("Cannot clear whitelist (err: %d)", err);
-			return err;
-		}
+static int whitelist_update(const bt_addr_le_t *bond_addr)
+{
+	if (!IS_ENABLED(CONFIG_BT_WHITELIST)) {
+		return 0;
+	}
 
-		if (bt_addr_le_cmp(bond_addr, BT_ADDR_LE_ANY)) {
-			adv_param.options |= BT_LE_ADV_OPT_FILTER_SCAN_REQ;
-			adv_param.options |= BT_LE_ADV_OPT_FILTER_CONN;
-			err = bt_le_whitelist_add(bond_addr);
-		}
+	int err = bt_le_whitelist_clear();
 
-		if (err) {
-			LOG_ERR("Cannot add peer to whitelist (err: %d)", err);
-			return err;
+	if (err) {
+		LOG_ERR("Cannot clear whitelist (err: %d)", err);
+		return err;
+	}
+
+	if (bt_addr_le_cmp(bond_addr, BT_ADDR_LE_ANY)) {
+		err = bt_le_whitelist_add(bond_addr);
+	}
+
+	if (err) {
+		LOG_ERR("Cannot add peer to whitelist (err: %d)", err);
+	}
+
+	return err;
+}
+
+#if CONFIG_CAF_BLE_ADV_PREPARED_SETS
+/* Sets for fast and slow advertising are prepared together, as the whitelist
+ * cannot change while any of them advertises.
+ */
+static int adv_sets_undirected_prepare(const bt_addr_le_t *bond_addr,
+				       const struct bt_data *ad, size_t ad_size)
+{
+	struct bt_le_adv_param adv_param;
+	int err = adv_sets_stop(NULL);
+
+	if (!err) {
+		err = whitelist_update(bond_addr);
+	}
+
+	for (size_t i = ADV_SET_FAST; !err && (i <= ADV_SET_SLOW); i++) {
+		bool fast = (i == ADV_SET_FAST);
+
+		if (fast && !IS_ENABLED(CONFIG_CAF_BLE_ADV_FAST_ADV)) {
+			continue;
 		}
+
+		adv_param_undirected_get(&adv_param, bond_addr, fast);
+		err = adv_set_prepare(&adv_sets[i], &adv_param, bond_addr, fast,
+				      ad, ad_size);
 	}
 
-	adv_param.id = cur_identity;
+	return err;
+}
+#endif /* CONFIG_CAF_BLE_ADV_PREPARED_SETS */
+
+static int ble_adv_start_undirected(const bt_addr_le_t *bond_addr,
+				    bool fast_adv)
+{
+	LOG_INF("Use %s advertising", (fast_adv)?("fast"):("slow"));
 
 	const struct bt_data *ad;
 	size_t ad_size;
@@ -240,7 +430,30 @@ static int ble_adv_start_undirected(const bt_addr_le_t *bond_addr,
 		adv_swift_pair = IS_ENABLED(CONFIG_CAF_BLE_ADV_SWIFT_PAIR);
 	}
 
+#if CONFIG_CAF_BLE_ADV_PREPARED_SETS
+	struct adv_set *set = &adv_sets[fast_adv ? ADV_SET_FAST : ADV_SET_SLOW];
+
+	if (!adv_set_is_ready(set, bond_addr, fast_adv)) {
+		int err = adv_sets_undirected_prepare(bond_addr, ad, ad_size);
+
+		if (err) {
+			return err;
+		}
+	}
+
+	return adv_set_start(set);
+#else
+	struct bt_le_adv_param adv_param;
+	int err = whitelist_update(bond_addr);
+
+	if (err) {
+		return err;
+	}
+
+	adv_param_undirected_get(&adv_param, bond_addr, fast_adv);
+
 	return bt_le_adv_start(&adv_param, ad, ad_size, sd, ARRAY_SIZE(sd));
+#endif
 }
 
 static int ble_adv_start(bool can_fast_adv)
@@ -254,7 +467,15 @@ static int ble_adv_start(bool can_fast_adv)
 	bt_addr_le_copy(&bond_find_data.peer_address, BT_ADDR_LE_ANY);
 	bt_foreach_bond(cur_identity, bond_find, &bond_find_data);
 
-	int err = ble_adv_stop();
+	int err = 0;
+
+	if (IS_ENABLED(CONFIG_CAF_BLE_ADV_PREPARED_SETS)) {
+		/* Advertising is switched to another set without stopping. */
+		adv_timeouts_cancel();
+	} else {
+		err = ble_adv_stop();
+	}
+
 	if (err) {
 		LOG_ERR("Cannot stop advertising (err %d)", err);
 		goto error;
@@ -265,7 +486,8 @@ static int ble_adv_start(bool can_fast_adv)
 	bt_conn_foreach(BT_CONN_TYPE_LE, conn_find, &conn);
 	if (conn) {
 		LOG_INF("Already connected, do not advertise");
-		return 0;
+		return IS_ENABLED(CONFIG_CAF_BLE_ADV_PREPARED_SETS) ?
+		       ble_adv_stop() : 0;
 	}
 
 	bool direct = false;
@@ -321,12 +543,31 @@ static void sp_grace_period_fn(struct k_work *work)
 	}
 }
 
+static int adv_data_update(const struct bt_data *ad, size_t ad_len)
+{
+#if CONFIG_CAF_BLE_ADV_PREPARED_SETS
+	if (!adv_cur) {
+		return -EAGAIN;
+	}
+
+	/* The set is prepared again when used next time. */
+	for (size_t i = 0; i < ARRAY_SIZE(adv_sets); i++) {
+		if (adv_sets[i].adv == adv_cur) {
+			adv_sets[i].ready = false;
+		}
+	}
+
+	return bt_le_ext_adv_set_data(adv_cur, ad, ad_len, sd, ARRAY_SIZE(sd));
+#else
+	return bt_le_adv_update_data(ad, ad_len, sd, ARRAY_SIZE(sd));
+#endif
+}
+
 static int remove_swift_pair_section(void)
 {
-	int err = bt_le_adv_update_data(ad_unbonded,
-					(ARRAY_SIZE(ad_unbonded) -
-					 SWIFT_PAIR_SECTION_SIZE),
-					sd, ARRAY_SIZE(sd));
+	int err = adv_data_update(ad_unbonded,
+				  (ARRAY_SIZE(ad_unbonded) -
+				   SWIFT_PAIR_SECTION_SIZE));
 
 	if (!err) {
 		LOG_INF("Swift Pair section removed");
@@ -32,6 +32,10 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_CAF_BUTTONS_LOG_LEVEL);
 /* For directly connected GPIO, scan rows once. */
 #define COLUMNS MAX(ARRAY_SIZE(col), 1)
 
+BUILD_ASSERT(!IS_ENABLED(CONFIG_CAF_BUTTONS_WAIT_FOR_CHANGE) ||
+	     (ARRAY_SIZE(col) == 0),
+	     "Waiting for change is supported only for directly connected GPIO");
+
 enum state {
 	STATE_IDLE,
 	STATE_ACTIVE,
@@ -119,7 +123,7 @@ static int set_trig_mode(void)
 	return err;
 }
 
-static int callback_ctrl(bool enable)
+static int callback_ctrl(bool enable, uint32_t pressed_mask)
 {
 	int err = 0;
 
@@ -139,8 +143,11 @@ static int callback_ctrl(bool enable)
 			/* Level interrupt is needed to leave deep sleep mode.
 			 * Edge interrupt gives only 7 channels. It is not
 			 * suitable for larger matrix/number of GPIO buttons.
+			 * Pins of pressed buttons wait for the release level.
 			 */
-			gpio_flags_t flag_irq = (IS_ENABLED(CONFIG_CAF_BUTTONS_POLARITY_INVERSED) ?
+			bool level_low = IS_ENABLED(CONFIG_CAF_BUTTONS_POLARITY_INVERSED) !=
+					 ((pressed_mask & BIT(i)) != 0);
+			gpio_flags_t flag_irq = (level_low ?
 						(GPIO_INT_LEVEL_LOW) : (GPIO_INT_LEVEL_HIGH));
 
 			err = gpio_pin_interrupt_configure(gpio_devs[row[i].port],
@@ -177,7 +184,7 @@ static int suspend(void)
 
 	case STATE_ACTIVE:
 		state = STATE_IDLE;
-		err = callback_ctrl(true);
+		err = callback_ctrl(true, 0);
 		break;
 
 	case STATE_IDLE:
@@ -199,7 +206,7 @@ static void resume(void)
 		return;
 	}
 
-	int err = callback_ctrl(false);
+	int err = callback_ctrl(false, 0);
 	if (err) {
 		LOG_ERR("Cannot disable callbacks");
 	} else {
@@ -246,10 +253,14 @@ static void scan_fn(struct k_work *work)
 
 	static uint32_t settled_state[COLUMNS];
 
+	/* State is stable if nothing bounces and all changes were reported */
+	bool stable = true;
+
 	/* Prevent bouncing */
 	static uint32_t prev_state[COLUMNS];
 	for (size_t i = 0; i < COLUMNS; i++) {
 		uint32_t bounce_mask = prev_state[i] ^ raw_state[i];
+		stable = stable && (bounce_mask == 0);
 		prev_state[i] = raw_state[i];
 		raw_state[i] &= ~bounce_mask;
 		raw_state[i] |= settled_state[i] & bounce_mask;
@@ -302,9 +313,19 @@ static void scan_fn(struct k_work *work)
 			      (prev_state[i] != 0) ||
 			      (settled_state[i] != 0) ||
 			      (cur_state[i] != 0);
+		stable = stable && (settled_state[i] == cur_state[i]);
 	}
 
-	if (any_pressed) {
+	if (any_pressed && IS_ENABLED(CONFIG_CAF_BUTTONS_WAIT_FOR_CHANGE) &&
+	    stable) {
+		/* Directly connected buttons do not need scanning to detect
+		 * a change. Wait for a callback in the current state.
+		 */
+		if (callback_ctrl(true, settled_state[0])) {
+			LOG_ERR("Cannot enable callbacks");
+			goto error;
+		}
+	} else if (any_pressed) {
 		/* Schedule next scan */
 		k_work_reschedule(&matrix_scan, K_MSEC(SCAN_INTERVAL));
 	} else {
@@ -316,7 +337,7 @@ static void scan_fn(struct k_work *work)
 		switch (state) {
 		case STATE_SCANNING:
 			state = STATE_ACTIVE;
-			err = callback_ctrl(true);
+			err = callback_ctrl(true, 0);
 			break;
 
 		case STATE_SUSPENDING:
@@ -394,7 +415,7 @@ static void button_pressed_isr(const struct device *gpio_dev,
 
 static void button_pressed_fn(struct k_work *work)
 {
-	int err = callback_ctrl(false);
+	int err = callback_ctrl(false, 0);
 
 	if (err) {
 		LOG_ERR("Cannot disable callbacks");
@@ -416,6 +437,11 @@ static void button_pressed_fn(struct k_work *work)
 
 	case STATE_SCANNING:
 	case STATE_SUSPENDING:
+		/* Waiting for change of the pressed buttons */
+		__ASSERT_NO_MSG(IS_ENABLED(CONFIG_CAF_BUTTONS_WAIT_FOR_CHANGE));
+		k_work_reschedule(&matrix_scan, K_MSEC(DEBOUNCE_INTERVAL));
+		break;
+
 	default:
 		/* Invalid state */
 		__ASSERT_NO_MSG(false);
@@ -106,6 +106,44 @@ static void set_off(struct led *led)
 	set_color(led, &nocolor);
 }
 
+static bool is_step_noop(const struct led *led, const struct led_effect_step *step)
+{
+	return !memcmp(&step->color, &led->color, sizeof(led->color));
+}
+
+/* Steps that start at the current color do not change it, so there is no
+ * need to wake up for them. Their time is added to the delay instead.
+ * Returns a negative value if none of the effect steps changes the color.
+ */
+static int32_t next_delay_get(struct led *led)
+{
+	const struct led_effect *effect = led->effect;
+	int32_t delay = 0;
+	size_t skipped = 0;
+
+	while ((led->effect_substep == 0) &&
+	       is_step_noop(led, &effect->steps[led->effect_step])) {
+		bool last = (led->effect_step == effect->step_count - 1);
+
+		/* Keep the last step of an effect that reports being done. */
+		if (last && !effect->loop_forever) {
+			break;
+		}
+
+		if (skipped == effect->step_count) {
+			return -1;
+		}
+
+		const struct led_effect_step *step = &effect->steps[led->effect_step];
+
+		delay += step->substep_count * step->substep_time;
+		led->effect_step = last ? 0 : (led->effect_step + 1);
+		skipped++;
+	}
+
+	return delay + effect->steps[led->effect_step].substep_time;
+}
+
 static void work_handler(struct k_work *work)
 {
 	struct led *led = CONTAINER_OF(work, struct led, work);
@@ -143,10 +181,11 @@ static void work_handler(struct k_work *work)
 	}
 
 	if (led->effect_step < led->effect->step_count) {
-		int32_t next_delay =
-			led->effect->steps[led->effect_step].substep_time;
+		int32_t next_delay = next_delay_get(led);
 
-		k_work_reschedule(&led->work, K_MSEC(next_delay));
+		if (next_delay >= 0) {
+			k_work_reschedule(&led->work, K_MSEC(next_delay));
+		}
 	}
 }
 
@@ -165,10 +204,11 @@ static void led_update(struct led *led)
 	__ASSERT_NO_MSG(led->effect->steps);
 
 	if (led->effect->step_count > 0) {
-		int32_t next_delay =
-			led->effect->steps[led->effect_step].substep_time;
+		int32_t next_delay = next_delay_get(led);
 
-		k_work_reschedule(&led->work, K_MSEC(next_delay));
+		if (next_delay >= 0) {
+			k_work_reschedule(&led->work, K_MSEC(next_delay));
+		}
 	} else {
 		LOG_WRN("LED effect with no effect");
 	}
@@ -217,6 +257,7 @@ static void leds_stop(void)
 		k_work_cancel_delayable(&leds[i].work);
 
 		set_off(&leds[i]);
+		memset(&leds[i].color, 0, sizeof(leds[i].color));
 
 #ifdef CONFIG_PM_DEVICE
 		int err = pm_device_state_set(leds[i].dev,
@@ -29,7 +29,16 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_CAF_POWER_MANAGER_LOG_LEVEL);
 
 
 #define POWER_DOWN_ERROR_TIMEOUT K_SECONDS(CONFIG_CAF_POWER_MANAGER_ERROR_TIMEOUT)
-#define POWER_DOWN_TIMEOUT       K_SECONDS(CONFIG_CAF_POWER_MANAGER_TIMEOUT)
+
+#ifndef CONFIG_CAF_POWER_MANAGER_ADAPTIVE_TIMEOUT_MIN
+  #define CONFIG_CAF_POWER_MANAGER_ADAPTIVE_TIMEOUT_MIN 0
+#endif
+#ifndef CONFIG_CAF_POWER_MANAGER_ADAPTIVE_TIMEOUT_MISS
+  #define CONFIG_CAF_POWER_MANAGER_ADAPTIVE_TIMEOUT_MISS 0
+#endif
+
+#define IDLE_HIST_SIZE		8
+#define IDLE_HIST_SAMPLES_MIN	4
 
 
 enum power_state {
@@ -51,6 +60,14 @@ static struct k_work_delayable  error_trigger;
  */
 static struct module_flags power_mode_restrict_flags[POWER_MANAGER_LEVEL_MAX];
 
+/* Idle periods that ended with activity. Bucket n counts the periods that
+ * lasted from 2^n to 2^(n+1) seconds, the last bucket also counts the longer
+ * ones.
+ */
+static uint8_t idle_hist[IDLE_HIST_SIZE];
+static int64_t last_activity;
+static uint32_t power_down_timeout_s = CONFIG_CAF_POWER_MANAGER_TIMEOUT;
+
 
 static bool check_if_power_state_allowed(enum power_manager_level lvl);
 
@@ -59,11 +76,71 @@ static void power_down_counter_reset(void)
 {
 	if ((power_state == POWER_STATE_IDLE) &&
 	    check_if_power_state_allowed(POWER_MANAGER_LEVEL_SUSPENDED)) {
-		k_work_reschedule(&power_down_trigger, POWER_DOWN_TIMEOUT);
+		k_work_reschedule(&power_down_trigger, K_SECONDS(power_down_timeout_s));
 		LOG_DBG("Power down timer restarted");
 	}
 }
 
+/* Choose the shortest timeout after which the idle period rarely ends soon.
+ * Suspending then saves power for long, at the cost of the wake-up latency
+ * observed by the user only for a few periods.
+ */
+static void power_down_timeout_update(void)
+{
+	uint32_t longer = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(idle_hist); i++) {
+		longer += idle_hist[i];
+	}
+
+	power_down_timeout_s = CONFIG_CAF_POWER_MANAGER_TIMEOUT;
+
+	for (size_t i = 0; i < ARRAY_SIZE(idle_hist) - 1; i++) {
+		uint32_t bound = BIT(i);
+
+		if (bound >= CONFIG_CAF_POWER_MANAGER_TIMEOUT) {
+			break;
+		}
+
+		if ((bound >= CONFIG_CAF_POWER_MANAGER_ADAPTIVE_TIMEOUT_MIN) &&
+		    (longer >= IDLE_HIST_SAMPLES_MIN) &&
+		    (idle_hist[i] * 100 <=
+		     longer * CONFIG_CAF_POWER_MANAGER_ADAPTIVE_TIMEOUT_MISS)) {
+			power_down_timeout_s = bound;
+			break;
+		}
+
+		longer -= idle_hist[i];
+	}
+
+	LOG_DBG("Power down timeout: %us", power_down_timeout_s);
+}
+
+static void activity_record(void)
+{
+	int64_t now = k_uptime_get();
+	uint32_t idle_s = (now - last_activity) / MSEC_PER_SEC;
+
+	last_activity = now;
+
+	/* Shorter periods never end with a power down. */
+	if (idle_s < MAX(CONFIG_CAF_POWER_MANAGER_ADAPTIVE_TIMEOUT_MIN, 1)) {
+		return;
+	}
+
+	size_t idx = MIN(find_msb_set(idle_s) - 1, ARRAY_SIZE(idle_hist) - 1);
+
+	if (idle_hist[idx] == UINT8_MAX) {
+		/* Reduce the weight of older periods. */
+		for (size_t i = 0; i < ARRAY_SIZE(idle_hist); i++) {
+			idle_hist[i] /= 2;
+		}
+	}
+
+	idle_hist[idx]++;
+	power_down_timeout_update();
+}
+
 static void power_down_counter_abort(void)
 {
 	k_work_cancel_delayable(&power_down_trigger);
@@ -180,6 +257,10 @@ static void error(struct k_work *work)
 static bool event_handler(const struct event_header *eh)
 {
 	if (IS_ENABLED(CONFIG_CAF_KEEP_ALIVE_EVENTS) && is_keep_alive_event(eh)) {
+		if (IS_ENABLED(CONFIG_CAF_POWER_MANAGER_ADAPTIVE_TIMEOUT)) {
+			activity_record();
+		}
+
 		power_down_counter_reset();
 
 		return false;
@@ -286,6 +367,10 @@ static bool event_handler(const struct event_header *eh)
 
 		LOG_INF("Wake up the board");
 
+		if (IS_ENABLED(CONFIG_CAF_POWER_MANAGER_ADAPTIVE_TIMEOUT)) {
+			activity_record();
+		}
+
 		set_power_state(POWER_STATE_IDLE);
 		power_down_counter_reset();
 		return false;
@@ -325,6 +410,7 @@ static bool event_handler(const struct event_header *eh)
 
 			k_work_init_delayable(&error_trigger, error);
 			k_work_init_delayable(&power_down_trigger, power_down);
+			last_activity = k_uptime_get();
 			power_down_counter_reset();
 		} else if (event->state == MODULE_STATE_ERROR) {
 			set_power_state(POWER_STATE_ERROR);
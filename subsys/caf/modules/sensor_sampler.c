@@ -31,6 +31,8 @@ struct sensor_data {
 	atomic_t state;
 	unsigned int sleep_cnt;
 	atomic_t event_cnt;
+	struct sensor_event *event;
+	unsigned int sample_cnt;
 };
 
 static struct sensor_data sensor_data[ARRAY_SIZE(sensor_configs)];
@@ -52,21 +54,6 @@ static void update_sensor_state(const struct sensor_config *sc, struct sensor_da
 	EVENT_SUBMIT(event);
 }
 
-static void send_sensor_event(const char *descr, const float *data, const size_t data_cnt,
-			      atomic_t *event_cnt)
-{
-	struct sensor_event *event = new_sensor_event(sizeof(float) * data_cnt);
-	float *data_ptr = sensor_event_get_data_ptr(event);
-
-	event->descr = descr;
-
-	__ASSERT_NO_MSG(sensor_event_get_data_cnt(event) == data_cnt);
-	memcpy(data_ptr, data, sizeof(float) * data_cnt);
-
-	atomic_inc(event_cnt);
-	EVENT_SUBMIT(event);
-}
-
 static struct sensor_data *get_sensor_data(const struct device *dev)
 {
 	for (size_t i = 0; i < ARRAY_SIZE(sensor_data); i++) {
@@ -110,6 +97,42 @@ static size_t get_sensor_data_cnt(const struct sensor_config *sc)
 	return data_cnt;
 }
 
+static unsigned int get_samples_in_event(const struct sensor_config *sc)
+{
+	return MAX(sc->samples_in_event, 1);
+}
+
+static float *get_sample_ptr(const struct sensor_config *sc, struct sensor_data *sd)
+{
+	size_t data_cnt = get_sensor_data_cnt(sc);
+
+	if (!sd->event) {
+		if (atomic_get(&sd->event_cnt) >= sc->active_events_limit) {
+			return NULL;
+		}
+
+		sd->event = new_sensor_event(sizeof(float) * data_cnt * get_samples_in_event(sc));
+		sd->event->descr = sc->event_descr;
+		sd->sample_cnt = 0;
+	}
+
+	return sensor_event_get_data_ptr(sd->event) + sd->sample_cnt * data_cnt;
+}
+
+static void send_sensor_event(const struct sensor_config *sc, struct sensor_data *sd)
+{
+	if (!sd->event) {
+		return;
+	}
+
+	/* Event may be sent before all of the samples are collected. */
+	sd->event->dyndata.size = sizeof(float) * get_sensor_data_cnt(sc) * sd->sample_cnt;
+
+	atomic_inc(&sd->event_cnt);
+	EVENT_SUBMIT(sd->event);
+	sd->event = NULL;
+}
+
 static bool is_active(const struct sensor_config *sc, struct sensor_data *sd,
 		      const float curr, const float prev)
 {
@@ -189,6 +212,9 @@ static void try_enter_sleep(const struct sensor_config *sc,
 			   const float *curr)
 {
 	if (can_sensor_sleep(sc, sd, curr)) {
+		/* Do not keep the collected samples until the sensor wakes up. */
+		send_sensor_event(sc, sd);
+
 		k_sched_lock();
 		int err = sensor_trigger_set(sd->dev, &sc->trigger->cfg, trigger_handler);
 
@@ -226,9 +252,15 @@ static void sample_sensor(struct sensor_data *sd, const struct sensor_config *sc
 		LOG_ERR("Sensor sampling error (err %d)", err);
 		update_sensor_state(sc, sd, SENSOR_STATE_ERROR);
 	} else {
-		if (atomic_get(&sd->event_cnt) < sc->active_events_limit) {
-			send_sensor_event(sc->event_descr, curr, ARRAY_SIZE(curr),
-					  &sd->event_cnt);
+		float *data_ptr = get_sample_ptr(sc, sd);
+
+		if (data_ptr) {
+			memcpy(data_ptr, curr, sizeof(curr));
+			sd->sample_cnt++;
+
+			if (sd->sample_cnt == get_samples_in_event(sc)) {
+				send_sensor_event(sc, sd);
+			}
 		} else {
 			LOG_WRN("Did not send event due to too many active events on sensor: %s",
 				sc->dev_name);
@@ -237,6 +269,10 @@ static void sample_sensor(struct sensor_data *sd, const struct sensor_config *sc
 			try_enter_sleep(sc, sd, curr);
 		}
 	}
+
+	if (atomic_get(&sd->state) == SENSOR_STATE_ERROR) {
+		send_sensor_event(sc, sd);
+	}
 }
 
 static size_t sample_sensors(int64_t *next_timeout)
@@ -38,6 +38,15 @@ static struct k_work_delayable cpu_load_log;
 static uint32_t cycle_ref;
 static uint32_t shared_ch_mask;
 
+#ifdef CONFIG_CPU_LOAD_THREADS
+/* Execution time of the threads at the last reset. */
+static struct {
+	const struct k_thread *thread;
+	uint64_t cycles;
+} thread_ref[CONFIG_CPU_LOAD_THREADS_MAX];
+static size_t thread_ref_count;
+#endif
+
 #define IS_CH_SHARED(ch) \
 	(IS_ENABLED(CONFIG_CPU_LOAD_USE_SHARED_DPPI_CHANNELS) && \
 	(BIT(ch) & shared_ch_mask))
@@ -207,10 +216,76 @@ int cpu_load_init(void)
 	return ret;
 }
 
+#ifdef CONFIG_CPU_LOAD_THREADS
+static uint64_t thread_cycles_get(const struct k_thread *thread)
+{
+	k_thread_runtime_stats_t stats;
+
+	if (k_thread_runtime_stats_get((k_tid_t)thread, &stats) != 0) {
+		return 0;
+	}
+
+	return stats.execution_cycles;
+}
+
+static void thread_ref_add(const struct k_thread *thread, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (thread_ref_count < ARRAY_SIZE(thread_ref)) {
+		thread_ref[thread_ref_count].thread = thread;
+		thread_ref[thread_ref_count].cycles = thread_cycles_get(thread);
+		thread_ref_count++;
+	}
+}
+
+struct thread_load_ctx {
+	cpu_load_thread_cb_t cb;
+	void *user_data;
+	uint32_t total_cyc;
+};
+
+static void thread_load_report(const struct k_thread *thread, void *user_data)
+{
+	struct thread_load_ctx *ctx = user_data;
+	uint64_t cycles = thread_cycles_get(thread);
+	uint32_t load = 0;
+
+	for (size_t i = 0; i < thread_ref_count; i++) {
+		if (thread_ref[i].thread == thread) {
+			cycles -= MIN(cycles, thread_ref[i].cycles);
+			break;
+		}
+	}
+
+	if (ctx->total_cyc != 0) {
+		load = (uint32_t)MIN((100000 * cycles) / ctx->total_cyc, 100000);
+	}
+
+	ctx->cb(thread, load, ctx->user_data);
+}
+
+void cpu_load_thread_foreach(cpu_load_thread_cb_t cb, void *user_data)
+{
+	struct thread_load_ctx ctx = {
+		.cb = cb,
+		.user_data = user_data,
+		.total_cyc = k_cycle_get_32() - cycle_ref,
+	};
+
+	k_thread_foreach(thread_load_report, &ctx);
+}
+#endif /* CONFIG_CPU_LOAD_THREADS */
+
 void cpu_load_reset(void)
 {
 	nrfx_timer_clear(&timer);
 	cycle_ref = k_cycle_get_32();
+
+#ifdef CONFIG_CPU_LOAD_THREADS
+	thread_ref_count = 0;
+	k_thread_foreach(thread_ref_add, NULL);
+#endif
 }
 
 static uint32_t sleep_ticks_to_us(uint32_t ticks)
@@ -266,6 +341,33 @@ static int cmd_cpu_load_get(const struct shell *shell, size_t argc, char **argv)
 	return 0;
 }
 
+#ifdef CONFIG_CPU_LOAD_THREADS
+static void thread_load_print(const struct k_thread *thread, uint32_t load,
+			      void *user_data)
+{
+	const struct shell *shell = user_data;
+	const char *name = k_thread_name_get((k_tid_t)thread);
+
+	shell_print(shell, "%-20s %3d,%03d%%", (name && name[0]) ? name : "unknown",
+		    load / 1000, load % 1000);
+}
+#endif
+
+static int cmd_cpu_load_threads(const struct shell *shell, size_t argc,
+				char **argv)
+{
+	if (!ready) {
+		shell_error(shell, "Not initialized.");
+		return 0;
+	}
+
+#ifdef CONFIG_CPU_LOAD_THREADS
+	cpu_load_thread_foreach(thread_load_print, (void *)shell);
+#endif
+
+	return 0;
+}
+
 static int cmd_cpu_load_reset(const struct shell *shell,
 				size_t argc, char **argv)
 {
@@ -284,6 +386,8 @@ static int cmd_cpu_load_reset(const struct shell *shell,
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_cmd_cpu_load,
 	SHELL_CMD_ARG(get, NULL, "Get load", cmd_cpu_load_get, 1, 0),
+	SHELL_COND_CMD_ARG(CONFIG_CPU_LOAD_THREADS, threads, NULL,
+			"Get load of each thread", cmd_cpu_load_threads, 1, 0),
 	SHELL_CMD_ARG(reset, NULL, "Reset measurement",
 			cmd_cpu_load_reset, 1, 0),
 	SHELL_CMD_ARG(init, NULL, "Init",
@@ -14,6 +14,12 @@
 #include <debug/ppi_trace.h>
 #include <logging/log.h>
 
+#ifdef CONFIG_PPI_TRACE_CAPTURE
+#include <irq.h>
+#include <hal/nrf_timer.h>
+#include <hal/nrf_egu.h>
+#endif
+
 LOG_MODULE_REGISTER(ppi_trace, CONFIG_PPI_TRACE_LOG_LEVEL);
 
 /* Convert task address to associated subscribe register */
@@ -203,6 +209,139 @@ static uint32_t ppi_channel_mask_get(void *handle)
 			BIT(GET_CH(handle));
 }
 
+#ifdef CONFIG_PPI_TRACE_CAPTURE
+#define CAPTURE_TIMER NRFX_CONCAT_2(NRF_TIMER, CONFIG_PPI_TRACE_CAPTURE_TIMER)
+#define CAPTURE_EGU NRFX_CONCAT_2(NRF_EGU, CONFIG_PPI_TRACE_CAPTURE_EGU)
+#ifdef DPPI_PRESENT
+#define CAPTURE_EGU_IRQN \
+	NRFX_CONCAT_3(EGU, CONFIG_PPI_TRACE_CAPTURE_EGU, _IRQn)
+#else
+#define CAPTURE_EGU_IRQN \
+	NRFX_CONCAT_3(NRFX_CONCAT_2(SWI, CONFIG_PPI_TRACE_CAPTURE_EGU), \
+		      NRFX_CONCAT_2(_EGU, CONFIG_PPI_TRACE_CAPTURE_EGU), _IRQn)
+#endif
+
+/* All TIMER instances have at least 4 capture/compare channels. Event N is
+ * captured in CC[N] and signalled on EGU channel N.
+ */
+#define CAPTURE_SLOTS 4
+
+static struct ppi_trace_capture_entry
+	capture_buf[CONFIG_PPI_TRACE_CAPTURE_BUF_SIZE];
+static size_t capture_head;
+static size_t capture_count;
+static uint32_t capture_dropped;
+static uint8_t capture_ids[CAPTURE_SLOTS];
+static uint8_t capture_slots_used;
+
+static void capture_isr(const void *arg)
+{
+	ARG_UNUSED(arg);
+
+	for (uint8_t i = 0; i < capture_slots_used; i++) {
+		nrf_egu_event_t evt = nrf_egu_triggered_event_get(i);
+
+		if (!nrf_egu_event_check(CAPTURE_EGU, evt)) {
+			continue;
+		}
+
+		nrf_egu_event_clear(CAPTURE_EGU, evt);
+
+		if (capture_count == ARRAY_SIZE(capture_buf)) {
+			capture_dropped++;
+			continue;
+		}
+
+		struct ppi_trace_capture_entry *entry = &capture_buf[
+			(capture_head + capture_count) % ARRAY_SIZE(capture_buf)];
+
+		entry->timestamp = nrf_timer_cc_get(CAPTURE_TIMER, i);
+		entry->id = capture_ids[i];
+		capture_count++;
+	}
+}
+
+static void capture_init(void)
+{
+	nrf_timer_mode_set(CAPTURE_TIMER, NRF_TIMER_MODE_TIMER);
+	nrf_timer_bit_width_set(CAPTURE_TIMER, NRF_TIMER_BIT_WIDTH_32);
+	nrf_timer_frequency_set(CAPTURE_TIMER, NRF_TIMER_FREQ_1MHz);
+	nrf_timer_task_trigger(CAPTURE_TIMER, NRF_TIMER_TASK_CLEAR);
+	nrf_timer_task_trigger(CAPTURE_TIMER, NRF_TIMER_TASK_START);
+
+	IRQ_CONNECT(CAPTURE_EGU_IRQN, CONFIG_PPI_TRACE_CAPTURE_IRQ_PRIORITY,
+		    capture_isr, NULL, 0);
+	irq_enable(CAPTURE_EGU_IRQN);
+}
+
+void *ppi_trace_capture_config(uint8_t id, uint32_t evt)
+{
+	uint8_t slot = capture_slots_used;
+	uint32_t capture_task;
+	uint32_t egu_task;
+	uint8_t ppi_ch;
+	int err;
+
+	if (slot == CAPTURE_SLOTS) {
+		LOG_ERR("No capture channel left.");
+		return NULL;
+	}
+
+	err = ppi_alloc(&ppi_ch, evt);
+	if (err != NRFX_SUCCESS) {
+		LOG_ERR("Failed to allocate PPI channel.");
+		return NULL;
+	}
+
+	if (slot == 0) {
+		capture_init();
+	}
+
+	capture_ids[slot] = id;
+	capture_task = nrf_timer_task_address_get(CAPTURE_TIMER,
+					nrf_timer_capture_task_get(slot));
+	egu_task = nrf_egu_task_address_get(CAPTURE_EGU,
+					nrf_egu_trigger_task_get(slot));
+
+	ppi_assign(ppi_ch, evt, capture_task);
+#ifdef DPPI_PRESENT
+	*SUBSCRIBE_ADDR(egu_task) = DPPIC_SUBSCRIBE_CHG_EN_EN_Msk | (uint32_t)ppi_ch;
+#else
+	(void)nrfx_ppi_channel_fork_assign(ppi_ch, egu_task);
+#endif
+
+	nrf_egu_int_enable(CAPTURE_EGU, nrf_egu_channel_int_get(slot));
+	capture_slots_used++;
+
+	return HANDLE_ENCODE(ppi_ch);
+}
+
+size_t ppi_trace_capture_read(struct ppi_trace_capture_entry *entries,
+			      size_t max_entries)
+{
+	size_t count = 0;
+
+	irq_disable(CAPTURE_EGU_IRQN);
+
+	while (count < max_entries && capture_count > 0) {
+		entries[count++] = capture_buf[capture_head];
+		capture_head = (capture_head + 1) % ARRAY_SIZE(capture_buf);
+		capture_count--;
+	}
+
+	if (capture_slots_used) {
+		irq_enable(CAPTURE_EGU_IRQN);
+	}
+
+	return count;
+}
+
+uint32_t ppi_trace_capture_dropped_get(void)
+{
+	return capture_dropped;
+}
+#endif /* CONFIG_PPI_TRACE_CAPTURE */
+
 void ppi_trace_enable(void *handle)
 {
 	ppi_enable(ppi_channel_mask_get(handle));
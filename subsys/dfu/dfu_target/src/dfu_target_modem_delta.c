@@ -6,6 +6,7 @@
 
 #include <zephyr.h>
 #include <stdio.h>
+#include <string.h>
 #include <drivers/flash.h>
 #if defined(CONFIG_POSIX_API)
 #include <posix/unistd.h>
@@ -32,6 +33,15 @@ static int  fd;
 static int  offset;
 static dfu_target_callback_t callback;
 
+#ifdef CONFIG_DFU_TARGET_MODEM_DELTA_ASYNC_ERASE
+static struct k_work_delayable erase_work;
+static K_SEM_DEFINE(erase_sem, 0, 1);
+static atomic_t erase_pending;
+static int erase_timeout;
+static uint8_t erase_buf[CONFIG_DFU_TARGET_MODEM_DELTA_ASYNC_ERASE_BUF_SIZE];
+static size_t erase_buf_len;
+#endif
+
 static int get_modem_error(void)
 {
 	int rc;
@@ -65,11 +75,10 @@ static int apply_modem_delta_upgrade(void)
 	return 0;
 }
 #define SLEEP_TIME 1
-static int delete_banked_modem_delta_fw(void)
+
+static int erase_start(void)
 {
 	int err;
-	socklen_t len = sizeof(offset);
-	int timeout = CONFIG_DFU_TARGET_MODEM_TIMEOUT;
 
 	LOG_INF("Deleting firmware image, this can take several minutes");
 	err = setsockopt(fd, SOL_DFU, SO_DFU_BACKUP_DELETE, NULL, 0);
@@ -77,31 +86,96 @@ static int delete_banked_modem_delta_fw(void)
 		LOG_ERR("Failed to delete backup, errno %d", errno);
 		return -EFAULT;
 	}
-	while (true) {
-		err = getsockopt(fd, SOL_DFU, SO_DFU_OFFSET, &offset, &len);
-		if (err < 0) {
-			if (timeout < 0) {
-				callback(DFU_TARGET_EVT_TIMEOUT);
-				timeout = CONFIG_DFU_TARGET_MODEM_TIMEOUT;
-			}
-			if (errno == ENOEXEC) {
-				err = get_modem_error();
-				if (err != DFU_ERASE_PENDING) {
-					LOG_ERR("DFU error: %d", err);
-				}
-				k_sleep(K_SECONDS(SLEEP_TIME));
+
+	return 0;
+}
+
+/* Returns zero once the delete has completed, -EINPROGRESS otherwise. */
+static int erase_poll(int *timeout)
+{
+	int err;
+	socklen_t len = sizeof(offset);
+
+	err = getsockopt(fd, SOL_DFU, SO_DFU_OFFSET, &offset, &len);
+	if (err < 0) {
+		if (*timeout < 0) {
+			callback(DFU_TARGET_EVT_TIMEOUT);
+			*timeout = CONFIG_DFU_TARGET_MODEM_TIMEOUT;
+		}
+		if (errno == ENOEXEC) {
+			err = get_modem_error();
+			if (err != DFU_ERASE_PENDING) {
+				LOG_ERR("DFU error: %d", err);
 			}
-			timeout -= SLEEP_TIME;
-		} else {
-			callback(DFU_TARGET_EVT_ERASE_DONE);
-			LOG_INF("Modem FW delete complete");
-			break;
 		}
+		*timeout -= SLEEP_TIME;
+		return -EINPROGRESS;
+	}
+
+	callback(DFU_TARGET_EVT_ERASE_DONE);
+	LOG_INF("Modem FW delete complete");
+
+	return 0;
+}
+
+static int delete_banked_modem_delta_fw(void)
+{
+	int err;
+	int timeout = CONFIG_DFU_TARGET_MODEM_TIMEOUT;
+
+	err = erase_start();
+	if (err) {
+		return err;
+	}
+
+	while (erase_poll(&timeout) == -EINPROGRESS) {
+		k_sleep(K_SECONDS(SLEEP_TIME));
 	}
 
 	return 0;
 }
 
+#ifdef CONFIG_DFU_TARGET_MODEM_DELTA_ASYNC_ERASE
+static void erase_work_handler(struct k_work *work)
+{
+	if (erase_poll(&erase_timeout) == -EINPROGRESS) {
+		k_work_reschedule(&erase_work, K_SECONDS(SLEEP_TIME));
+		return;
+	}
+
+	atomic_clear(&erase_pending);
+	k_sem_give(&erase_sem);
+}
+
+static int delete_banked_modem_delta_fw_async(void)
+{
+	int err;
+
+	err = erase_start();
+	if (err) {
+		return err;
+	}
+
+	erase_timeout = CONFIG_DFU_TARGET_MODEM_TIMEOUT;
+	erase_buf_len = 0;
+	k_sem_reset(&erase_sem);
+	atomic_set(&erase_pending, 1);
+	k_work_reschedule(&erase_work, K_SECONDS(SLEEP_TIME));
+
+	return 0;
+}
+
+static void erase_cancel(void)
+{
+	if (atomic_get(&erase_pending)) {
+		k_work_cancel_delayable(&erase_work);
+		atomic_clear(&erase_pending);
+	}
+
+	erase_buf_len = 0;
+}
+#endif /* CONFIG_DFU_TARGET_MODEM_DELTA_ASYNC_ERASE */
+
 /**@brief Initialize DFU socket. */
 static int modem_delta_dfu_socket_init(void)
 {
@@ -149,6 +223,11 @@ int dfu_target_modem_delta_init(size_t file_size, dfu_target_callback_t cb)
 
 	callback = cb;
 
+#ifdef CONFIG_DFU_TARGET_MODEM_DELTA_ASYNC_ERASE
+	erase_cancel();
+	k_work_init_delayable(&erase_work, erase_work_handler);
+#endif
+
 	err = modem_delta_dfu_socket_init();
 	if (err < 0) {
 		return err;
@@ -180,7 +259,13 @@ int dfu_target_modem_delta_init(size_t file_size, dfu_target_callback_t cb)
 	}
 
 	if (offset == DIRTY_IMAGE) {
+		/* The offset is read again once the delete has completed */
+		offset = 0;
+#ifdef CONFIG_DFU_TARGET_MODEM_DELTA_ASYNC_ERASE
+		delete_banked_modem_delta_fw_async();
+#else
 		delete_banked_modem_delta_fw();
+#endif
 	} else if (offset != 0) {
 		LOG_INF("Setting offset to 0x%x", offset);
 		len = sizeof(offset);
@@ -199,7 +284,7 @@ int dfu_target_modem_delta_offset_get(size_t *out)
 	return 0;
 }
 
-int dfu_target_modem_delta_write(const void *const buf, size_t len)
+static int modem_delta_send(const void *const buf, size_t len)
 {
 	int err = 0;
 	int sent = 0;
@@ -229,7 +314,7 @@ int dfu_target_modem_delta_write(const void *const buf, size_t len)
 		return -EINVAL;
 	case DFU_INVALID_FILE_OFFSET:
 		delete_banked_modem_delta_fw();
-		err = dfu_target_modem_delta_write(buf, len);
+		err = modem_delta_send(buf, len);
 		if (err < 0) {
 			return -EINVAL;
 		} else {
@@ -237,7 +322,7 @@ int dfu_target_modem_delta_write(const void *const buf, size_t len)
 		}
 	case DFU_AREA_NOT_BLANK:
 		delete_banked_modem_delta_fw();
-		err = dfu_target_modem_delta_write(buf, len);
+		err = modem_delta_send(buf, len);
 		if (err < 0) {
 			return -EINVAL;
 		} else {
@@ -248,10 +333,65 @@ int dfu_target_modem_delta_write(const void *const buf, size_t len)
 	}
 }
 
+#ifdef CONFIG_DFU_TARGET_MODEM_DELTA_ASYNC_ERASE
+/* Wait for the scratch area to be erased and send the buffered data. */
+static int erase_wait_and_flush(void)
+{
+	size_t len;
+
+	if (atomic_get(&erase_pending)) {
+		LOG_INF("Waiting for modem FW delete to complete");
+		k_sem_take(&erase_sem, K_FOREVER);
+	}
+
+	if (erase_buf_len == 0) {
+		return 0;
+	}
+
+	len = erase_buf_len;
+	erase_buf_len = 0;
+
+	return modem_delta_send(erase_buf, len);
+}
+#endif /* CONFIG_DFU_TARGET_MODEM_DELTA_ASYNC_ERASE */
+
+int dfu_target_modem_delta_write(const void *const buf, size_t len)
+{
+#ifdef CONFIG_DFU_TARGET_MODEM_DELTA_ASYNC_ERASE
+	int err;
+
+	if (atomic_get(&erase_pending) &&
+	    erase_buf_len + len <= sizeof(erase_buf)) {
+		memcpy(erase_buf + erase_buf_len, buf, len);
+		erase_buf_len += len;
+		return 0;
+	}
+
+	err = erase_wait_and_flush();
+	if (err) {
+		return err;
+	}
+#endif
+
+	return modem_delta_send(buf, len);
+}
+
 int dfu_target_modem_delta_done(bool successful)
 {
 	int err = 0;
 
+#ifdef CONFIG_DFU_TARGET_MODEM_DELTA_ASYNC_ERASE
+	if (successful) {
+		err = erase_wait_and_flush();
+		if (err) {
+			LOG_ERR("Failed to write buffered data, err %d", err);
+			successful = false;
+		}
+	}
+
+	erase_cancel();
+#endif
+
 	if (successful) {
 		err = apply_modem_delta_upgrade();
 		if (err < 0) {
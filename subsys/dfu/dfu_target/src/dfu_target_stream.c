@@ -8,6 +8,7 @@
 #include <logging/log.h>
 #include <storage/stream_flash.h>
 #include <stdio.h>
+#include <string.h>
 #include <dfu/dfu_target_stream.h>
 
 #ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
@@ -22,8 +23,28 @@ static struct stream_flash_ctx stream;
 static const char *current_id;
 
 #ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
-
 static char current_name_key[32];
+static size_t stored_bytes;
+static off_t stored_page_start;
+static int64_t stored_time;
+#endif /* CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS */
+
+#ifdef CONFIG_DFU_TARGET_STREAM_ASYNC
+#define ASYNC_BUF_COUNT 2
+
+struct async_fragment {
+	uint8_t idx;
+	size_t len;
+};
+
+static uint8_t async_buf[ASYNC_BUF_COUNT][CONFIG_DFU_TARGET_STREAM_ASYNC_BUF_SIZE];
+static uint8_t async_fill_idx;
+static int async_err;
+static K_SEM_DEFINE(async_free_sem, ASYNC_BUF_COUNT, ASYNC_BUF_COUNT);
+static K_MSGQ_DEFINE(async_msgq, sizeof(struct async_fragment), ASYNC_BUF_COUNT, 4);
+#endif /* CONFIG_DFU_TARGET_STREAM_ASYNC */
+
+#ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
 
 /**
  * @brief Store the information stored in the stream_flash instance so that it
@@ -32,6 +53,7 @@ static char current_name_key[32];
 static int store_progress(void)
 {
 	int err;
+	struct flash_pages_info page;
 	size_t bytes_written = stream_flash_bytes_written(&stream);
 
 	err = settings_save_one(current_name_key, &bytes_written,
@@ -42,9 +64,120 @@ static int store_progress(void)
 		return err;
 	}
 
+	stored_bytes = bytes_written;
+	stored_time = k_uptime_get();
+
+	err = flash_get_page_info_by_offs(stream.fdev,
+					  stream.offset + bytes_written, &page);
+	stored_page_start = (err == 0) ? page.start_offset : -1;
+
 	return 0;
 }
 
+/**
+ * @brief Check whether the write progress should be stored, according to
+ *        the policy selected in Kconfig.
+ */
+static bool store_progress_due(void)
+{
+	size_t bytes_written = stream_flash_bytes_written(&stream);
+
+	if (bytes_written == stored_bytes) {
+		/* Nothing has reached flash since the last store. */
+		return false;
+	}
+
+	if (CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_INTERVAL_BYTES == 0 &&
+	    CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_INTERVAL_MS == 0 &&
+	    !IS_ENABLED(CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_PAGE)) {
+		return true;
+	}
+
+	if (CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_INTERVAL_BYTES > 0 &&
+	    bytes_written - stored_bytes >=
+	    CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_INTERVAL_BYTES) {
+		return true;
+	}
+
+	if (CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_INTERVAL_MS > 0 &&
+	    k_uptime_get() - stored_time >=
+	    CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_INTERVAL_MS) {
+		return true;
+	}
+
+	if (IS_ENABLED(CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_PAGE)) {
+		struct flash_pages_info page;
+		int err = flash_get_page_info_by_offs(stream.fdev,
+					stream.offset + bytes_written, &page);
+
+		if (err != 0 || page.start_offset != stored_page_start) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Validate the flash page of the restored offset.
+ *
+ * Since the progress is not stored after every write, more data than
+ * indicated by the restored offset may have been written to its flash
+ * page. That data cannot be written again without erasing the page, so
+ * in that case the stream is rewound to the start of the page, and the
+ * page is erased before it is written again.
+ */
+static int progress_recover(void)
+{
+	int err;
+	struct flash_pages_info page;
+	const struct flash_parameters *params;
+	uint8_t chunk[16];
+	off_t abs_offset = stream.offset + stream.bytes_written;
+
+	if (stream.bytes_written == 0) {
+		return 0;
+	}
+
+	err = flash_get_page_info_by_offs(stream.fdev, abs_offset, &page);
+	if (err != 0) {
+		LOG_ERR("Error %d while getting page info", err);
+		return err;
+	}
+
+	params = flash_get_parameters(stream.fdev);
+
+	for (off_t off = abs_offset; off < page.start_offset + page.size;
+	     off += sizeof(chunk)) {
+		size_t len = MIN(sizeof(chunk),
+				 page.start_offset + page.size - off);
+
+		err = flash_read(stream.fdev, off, chunk, len);
+		if (err != 0) {
+			LOG_ERR("Error %d while reading flash", err);
+			return err;
+		}
+
+		for (size_t i = 0; i < len; i++) {
+			if (chunk[i] != params->erase_value) {
+				goto rewind;
+			}
+		}
+	}
+
+	return 0;
+
+rewind:
+	stream.bytes_written = (page.start_offset > stream.offset) ?
+			       page.start_offset - stream.offset : 0;
+	/* Let stream_flash erase the page again before writing to it. */
+	stream.last_erased_page_start_offset = -1;
+
+	LOG_INF("Resuming from offset %zu", stream.bytes_written);
+
+	return store_progress();
+}
+
 /**
  * @brief Function used by settings_load() to restore the stream_flash ctx.
  *	  See the Zephyr documentation of the settings subsystem for more
@@ -85,6 +218,162 @@ static int settings_set(const char *key, size_t len_rd,
 }
 #endif /* CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS */
 
+#ifdef CONFIG_DFU_TARGET_STREAM_DIRECT_WRITE
+/**
+ * @brief Write whole chunks of the stream buffer size straight from @p buf,
+ *        bypassing the stream buffer, while the stream buffer is empty.
+ *
+ * @return The number of bytes written, or a negative error code.
+ */
+static int stream_write_direct(const uint8_t *buf, size_t len)
+{
+	int err;
+	size_t written = 0;
+
+	if (stream.buf_bytes != 0) {
+		/* Keep the order of the data already in the stream buffer */
+		return 0;
+	}
+
+	while (len - written >= stream.buf_len &&
+	       stream.bytes_written + stream.buf_len <= stream.available) {
+		off_t addr = stream.offset + stream.bytes_written;
+
+		/* The chunk is smaller than a page, so at most two pages
+		 * need to be erased. Pages already erased are skipped.
+		 */
+		err = stream_flash_erase_page(&stream, addr);
+		if (err == 0) {
+			err = stream_flash_erase_page(&stream,
+						      addr + stream.buf_len - 1);
+		}
+		if (err != 0) {
+			return err;
+		}
+
+		err = flash_write(stream.fdev, addr, buf + written,
+				  stream.buf_len);
+		if (err != 0) {
+			LOG_ERR("flash_write error %d", err);
+			return err;
+		}
+
+		stream.bytes_written += stream.buf_len;
+		written += stream.buf_len;
+	}
+
+	return written;
+}
+#endif /* CONFIG_DFU_TARGET_STREAM_DIRECT_WRITE */
+
+static int stream_write(const uint8_t *buf, size_t len)
+{
+	int err;
+
+#ifdef CONFIG_DFU_TARGET_STREAM_DIRECT_WRITE
+	err = stream_write_direct(buf, len);
+	if (err < 0) {
+		LOG_ERR("Direct write error %d", err);
+		return err;
+	}
+
+	buf += err;
+	len -= err;
+#endif
+
+	err = stream_flash_buffered_write(&stream, buf, len, false);
+
+	if (err != 0) {
+		LOG_ERR("stream_flash_buffered_write error %d", err);
+		return err;
+	}
+
+#ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
+	if (store_progress_due()) {
+		err = store_progress();
+		if (err != 0) {
+			/* Failing to store progress is not a critical error
+			 * you'll just be left to download a bit more if you
+			 * fail and resume.
+			 */
+			LOG_WRN("Unable to store write progress: %d", err);
+		}
+	}
+#endif
+
+	return err;
+}
+
+#ifdef CONFIG_DFU_TARGET_STREAM_ASYNC
+static void async_writer_thread(void)
+{
+	struct async_fragment frag;
+
+	while (true) {
+		k_msgq_get(&async_msgq, &frag, K_FOREVER);
+
+		/* Once a write fails, drop the rest of the stream. */
+		if (async_err == 0) {
+			async_err = stream_write(async_buf[frag.idx], frag.len);
+		}
+
+		k_sem_give(&async_free_sem);
+	}
+}
+
+K_THREAD_DEFINE(dfu_target_stream_writer, CONFIG_DFU_TARGET_STREAM_ASYNC_STACK_SIZE,
+		async_writer_thread, NULL, NULL, NULL,
+		CONFIG_DFU_TARGET_STREAM_ASYNC_PRIORITY, 0, 0);
+
+/**
+ * @brief Wait until the writer thread has programmed all queued fragments.
+ *
+ * @return The first error returned by the writer thread since the
+ *         stream was initialized.
+ */
+static int async_flush(void)
+{
+	for (size_t i = 0; i < ASYNC_BUF_COUNT; i++) {
+		k_sem_take(&async_free_sem, K_FOREVER);
+	}
+
+	for (size_t i = 0; i < ASYNC_BUF_COUNT; i++) {
+		k_sem_give(&async_free_sem);
+	}
+
+	return async_err;
+}
+
+static int async_write(const uint8_t *buf, size_t len)
+{
+	while (len > 0) {
+		struct async_fragment frag = {
+			.idx = async_fill_idx,
+			.len = MIN(len, sizeof(async_buf[0])),
+		};
+
+		/* Block while both buffers are being programmed. */
+		k_sem_take(&async_free_sem, K_FOREVER);
+
+		if (async_err != 0) {
+			k_sem_give(&async_free_sem);
+			return async_err;
+		}
+
+		memcpy(async_buf[frag.idx], buf, frag.len);
+		async_fill_idx = (async_fill_idx + 1) % ASYNC_BUF_COUNT;
+
+		/* The queue holds one entry per buffer, so it cannot be full. */
+		(void)k_msgq_put(&async_msgq, &frag, K_NO_WAIT);
+
+		buf += frag.len;
+		len -= frag.len;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_DFU_TARGET_STREAM_ASYNC */
+
 struct stream_flash_ctx *dfu_target_stream_get_stream(void)
 {
 	return &stream;
@@ -105,6 +394,10 @@ int dfu_target_stream_init(const struct dfu_target_stream_init *init)
 
 	current_id = init->id;
 
+#ifdef CONFIG_DFU_TARGET_STREAM_ASYNC
+	async_err = 0;
+#endif
+
 	err = stream_flash_init(&stream, init->fdev, init->buf, init->len,
 				init->offset, init->size, NULL);
 	if (err) {
@@ -138,11 +431,23 @@ int dfu_target_stream_init(const struct dfu_target_stream_init *init)
 		return err;
 	}
 
+	stored_bytes = 0;
+	stored_page_start = -1;
+	stored_time = k_uptime_get();
+
 	err = settings_load();
 	if (err) {
 		LOG_ERR("settings_load failed (err %d)", err);
 		return err;
 	}
+
+	stored_bytes = stream.bytes_written;
+
+	err = progress_recover();
+	if (err) {
+		LOG_ERR("Unable to recover write progress (err %d)", err);
+		return err;
+	}
 #endif /* CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS */
 
 	return 0;
@@ -150,6 +455,10 @@ int dfu_target_stream_init(const struct dfu_target_stream_init *init)
 
 int dfu_target_stream_offset_get(size_t *out)
 {
+#ifdef CONFIG_DFU_TARGET_STREAM_ASYNC
+	(void)async_flush();
+#endif
+
 	*out = stream_flash_bytes_written(&stream);
 
 	return 0;
@@ -157,30 +466,25 @@ int dfu_target_stream_offset_get(size_t *out)
 
 int dfu_target_stream_write(const uint8_t *buf, size_t len)
 {
-	int err = stream_flash_buffered_write(&stream, buf, len, false);
-
-	if (err != 0) {
-		LOG_ERR("stream_flash_buffered_write error %d", err);
-		return err;
-	}
-
-#ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
-	err = store_progress();
-	if (err != 0) {
-		/* Failing to store progress is not a critical error you'll just
-		 * be left to download a bit more if you fail and resume.
-		 */
-		LOG_WRN("Unable to store write progress: %d", err);
-	}
+#ifdef CONFIG_DFU_TARGET_STREAM_ASYNC
+	return async_write(buf, len);
+#else
+	return stream_write(buf, len);
 #endif
-
-	return err;
 }
 
 int dfu_target_stream_done(bool successful)
 {
 	int err = 0;
 
+#ifdef CONFIG_DFU_TARGET_STREAM_ASYNC
+	err = async_flush();
+	if (err != 0) {
+		LOG_ERR("Asynchronous write failed (err %d)", err);
+		successful = false;
+	}
+#endif
+
 	if (successful) {
 		err = stream_flash_buffered_write(&stream, NULL, 0, true);
 		if (err != 0) {
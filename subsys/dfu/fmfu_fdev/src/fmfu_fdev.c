@@ -19,13 +19,155 @@ LOG_MODULE_REGISTER(fmfu_fdev, CONFIG_FMFU_FDEV_LOG_LEVEL);
 
 static uint8_t meta_buf[MAX_META_LEN];
 
+/* Reads a region of the flash device in chunks. With read-ahead, the next
+ * chunk is read in a separate thread while the current one is processed.
+ */
+struct chunk_reader {
+	const struct device *fdev;
+	uint32_t addr;
+	size_t len;
+	uint8_t *buf[2];
+	size_t buf_len;
+	uint8_t idx;
+#ifdef CONFIG_FMFU_FDEV_READ_AHEAD
+	struct k_work work;
+	struct k_sem filled[2];
+	struct k_sem free[2];
+	size_t chunk_len[2];
+	int err[2];
+	atomic_t abort;
+#endif
+};
+
+static struct chunk_reader reader;
+
+#ifdef CONFIG_FMFU_FDEV_READ_AHEAD
+static K_THREAD_STACK_DEFINE(read_ahead_stack,
+			     CONFIG_FMFU_FDEV_READ_AHEAD_STACK_SIZE);
+static struct k_work_q read_ahead_q;
+static bool read_ahead_q_started;
+
+static void read_ahead_work_handler(struct k_work *work)
+{
+	struct chunk_reader *r = CONTAINER_OF(work, struct chunk_reader, work);
+	uint32_t addr = r->addr;
+	size_t left = r->len;
+
+	for (uint8_t idx = 0; left > 0; idx ^= 1) {
+		k_sem_take(&r->free[idx], K_FOREVER);
+		if (atomic_get(&r->abort)) {
+			return;
+		}
+
+		r->chunk_len[idx] = MIN(r->buf_len, left);
+		r->err[idx] = flash_read(r->fdev, addr, r->buf[idx],
+					 r->chunk_len[idx]);
+		k_sem_give(&r->filled[idx]);
+
+		if (r->err[idx] != 0) {
+			return;
+		}
+
+		addr += r->chunk_len[idx];
+		left -= r->chunk_len[idx];
+	}
+}
+#endif /* CONFIG_FMFU_FDEV_READ_AHEAD */
+
+static int chunk_reader_start(struct chunk_reader *r, const struct device *fdev,
+			      uint32_t addr, size_t len, uint8_t *buf,
+			      size_t buf_len)
+{
+	r->fdev = fdev;
+	r->addr = addr;
+	r->len = len;
+	r->idx = 0;
+
+#ifdef CONFIG_FMFU_FDEV_READ_AHEAD
+	/* The buffer is split in two, one half is read while the other one is
+	 * processed.
+	 */
+	r->buf_len = ROUND_DOWN(buf_len / 2, sizeof(uint32_t));
+	if (r->buf_len == 0) {
+		return -ENOMEM;
+	}
+	r->buf[0] = buf;
+	r->buf[1] = buf + r->buf_len;
+
+	if (!read_ahead_q_started) {
+		k_work_queue_start(&read_ahead_q, read_ahead_stack,
+				   K_THREAD_STACK_SIZEOF(read_ahead_stack),
+				   CONFIG_FMFU_FDEV_READ_AHEAD_PRIORITY, NULL);
+		read_ahead_q_started = true;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(r->buf); i++) {
+		k_sem_init(&r->filled[i], 0, 1);
+		k_sem_init(&r->free[i], 1, 1);
+	}
+	atomic_set(&r->abort, false);
+	k_work_init(&r->work, read_ahead_work_handler);
+	k_work_submit_to_queue(&read_ahead_q, &r->work);
+#else
+	r->buf[0] = buf;
+	r->buf_len = buf_len;
+#endif
+
+	return 0;
+}
+
+/* Get the next chunk. Must be followed by chunk_reader_release(). */
+static int chunk_reader_get(struct chunk_reader *r, uint8_t **chunk,
+			    size_t *chunk_len)
+{
+#ifdef CONFIG_FMFU_FDEV_READ_AHEAD
+	k_sem_take(&r->filled[r->idx], K_FOREVER);
+
+	*chunk = r->buf[r->idx];
+	*chunk_len = r->chunk_len[r->idx];
+
+	return r->err[r->idx];
+#else
+	*chunk = r->buf[0];
+	*chunk_len = MIN(r->buf_len, r->len);
+
+	return flash_read(r->fdev, r->addr, *chunk, *chunk_len);
+#endif
+}
+
+static void chunk_reader_release(struct chunk_reader *r, size_t chunk_len)
+{
+	r->addr += chunk_len;
+	r->len -= chunk_len;
+
+#ifdef CONFIG_FMFU_FDEV_READ_AHEAD
+	k_sem_give(&r->free[r->idx]);
+	r->idx ^= 1;
+#endif
+}
+
+/* Must be called when the region is not read until its end. */
+static void chunk_reader_stop(struct chunk_reader *r)
+{
+#ifdef CONFIG_FMFU_FDEV_READ_AHEAD
+	struct k_work_sync sync;
+
+	atomic_set(&r->abort, true);
+	for (size_t i = 0; i < ARRAY_SIZE(r->buf); i++) {
+		k_sem_give(&r->free[i]);
+	}
+	k_work_flush(&r->work, &sync);
+#endif
+}
+
 static int get_hash_from_flash(const struct device *fdev, size_t offset,
 			       size_t data_len, uint8_t *hash, uint8_t *buffer,
 			       size_t buffer_len)
 {
 	int err;
 	mbedtls_sha256_context sha256_ctx;
-	size_t end = offset + data_len;
+	uint8_t *chunk;
+	size_t chunk_len;
 
 	mbedtls_sha256_init(&sha256_ctx);
 
@@ -34,20 +176,30 @@ static int get_hash_from_flash(const struct device *fdev, size_t offset,
 		return err;
 	}
 
-	for (size_t tmp_offs = offset; tmp_offs < end; tmp_offs += buffer_len) {
-		size_t part_len = MIN(buffer_len, (end - tmp_offs));
-		int err = flash_read(fdev, tmp_offs, buffer, part_len);
+	err = chunk_reader_start(&reader, fdev, offset, data_len, buffer,
+				 buffer_len);
+	if (err != 0) {
+		return err;
+	}
 
-		if (err != 0) {
-			return err;
+	while (reader.len > 0) {
+		err = chunk_reader_get(&reader, &chunk, &chunk_len);
+		if (err == 0) {
+			/* Next chunk is read while this one is hashed. */
+			err = mbedtls_sha256_update_ret(&sha256_ctx, chunk,
+							chunk_len);
 		}
 
-		err = mbedtls_sha256_update_ret(&sha256_ctx, buffer, part_len);
 		if (err != 0) {
+			chunk_reader_stop(&reader);
 			return err;
 		}
+
+		chunk_reader_release(&reader, chunk_len);
 	}
 
+	chunk_reader_stop(&reader);
+
 	err = mbedtls_sha256_finish_ret(&sha256_ctx, hash);
 	if (err != 0) {
 		return err;
@@ -84,33 +236,41 @@ static int load_segment(const struct device *fdev, size_t seg_size,
 			uint8_t *buf, size_t buf_len, bool is_bootloader)
 {
 	int err;
-	uint32_t read_addr = seg_offset;
-	size_t bytes_left = seg_size;
+	uint8_t *chunk;
+	size_t chunk_len;
 
-	while (bytes_left) {
-		uint32_t read_len = MIN(buf_len, bytes_left);
+	err = chunk_reader_start(&reader, fdev, seg_offset, seg_size, buf,
+				 buf_len);
+	if (err != 0) {
+		return err;
+	}
 
-		err = flash_read(fdev, read_addr, buf, read_len);
+	while (reader.len > 0) {
+		err = chunk_reader_get(&reader, &chunk, &chunk_len);
 		if (err != 0) {
 			LOG_ERR("flash_read failed: %d", err);
+			chunk_reader_stop(&reader);
 			return err;
 		}
 
-		err = write_chunk(buf, read_len, seg_target_addr,
+		/* Next chunk is read while this one is written. */
+		err = write_chunk(chunk, chunk_len, seg_target_addr,
 				  is_bootloader);
 		if (err != 0) {
 			LOG_ERR("write_chunk failed: %d", err);
+			chunk_reader_stop(&reader);
 			return err;
 		}
 
 		LOG_DBG("Wrote chunk: offset 0x%x target addr 0x%x size 0x%x",
-			read_addr, seg_target_addr, read_len);
+			reader.addr, seg_target_addr, chunk_len);
 
-		seg_target_addr += read_len;
-		bytes_left -= read_len;
-		read_addr += read_len;
+		seg_target_addr += chunk_len;
+		chunk_reader_release(&reader, chunk_len);
 	}
 
+	chunk_reader_stop(&reader);
+
 	if (is_bootloader) {
 		/* We need to explicitly call _apply() once all chunks of the
 		 * bootloader has been written.
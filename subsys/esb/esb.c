@@ -5,6 +5,7 @@
  */
 #include <errno.h>
 #include <irq.h>
+#include <kernel.h>
 #include <sys/byteorder.h>
 #include <nrf.h>
 #include <esb.h>
@@ -80,6 +81,15 @@
 #define ESB_SYS_TIMER_IRQn TIMER4_IRQn
 #endif
 
+/* Adaptive retransmit delay step in microseconds. */
+#define ADAPTIVE_DELAY_STEP 250
+/* Average TX attempts are kept in 1/16 units. */
+#define ATTEMPTS_SCALE 16
+/* Average attempts above which the retransmit delay is increased. */
+#define ATTEMPTS_HIGH (2 * ATTEMPTS_SCALE)
+/* Average attempts below which the retransmit delay is decreased. */
+#define ATTEMPTS_LOW (ATTEMPTS_SCALE + ATTEMPTS_SCALE / 4)
+
 /* Internal Enhanced ShockBurst module state. */
 enum esb_state {
 	ESB_STATE_IDLE,		/* Idle. */
@@ -190,6 +200,183 @@ static volatile uint32_t interrupt_flags;
 static volatile uint32_t retransmits_remaining;
 static volatile uint32_t last_tx_attempts;
 static volatile uint32_t wait_for_ack_timeout_us;
+/* The radio was restarted for TX by the DISABLED-TXEN shortcut. */
+static bool tx_burst_ramping;
+/* The slot at the back of the TX FIFO is reserved by the application. */
+static bool tx_reserved;
+
+#if defined(CONFIG_ESB_ADAPTIVE)
+static struct {
+	struct esb_channel_stats channels[CONFIG_ESB_HOP_CHANNELS_MAX];
+	struct esb_pipe_stats pipes[CONFIG_ESB_PIPE_COUNT];
+	uint8_t count;
+	uint8_t idx;
+	/* A valid packet was received on the current channel (PRX). */
+	bool rx_seen;
+	/* Average number of TX attempts per packet. */
+	uint32_t attempts_avg;
+	uint16_t retransmit_delay;
+	struct k_work_delayable prx_hop_work;
+} adaptive;
+
+static void adaptive_hop_next(void)
+{
+	if (adaptive.count > 1) {
+		adaptive.idx = (adaptive.idx + 1) % adaptive.count;
+		esb_addr.rf_channel = adaptive.channels[adaptive.idx].channel;
+	}
+}
+
+static void adaptive_tx_done(uint32_t attempts, bool success)
+{
+	struct esb_channel_stats *channel = &adaptive.channels[adaptive.idx];
+	struct esb_pipe_stats *pipe = &adaptive.pipes[current_payload->pipe];
+	int32_t diff = (int32_t)(attempts * ATTEMPTS_SCALE) -
+		       (int32_t)adaptive.attempts_avg;
+
+	channel->tx_attempts += attempts;
+	pipe->tx_attempts += attempts;
+
+	if (success) {
+		channel->tx_success++;
+		pipe->tx_success++;
+	} else {
+		channel->tx_failed++;
+		pipe->tx_failed++;
+	}
+
+	/* Space the retransmits further apart while packets need many
+	 * attempts, and return to the configured delay when the link is
+	 * clean again.
+	 */
+	adaptive.attempts_avg += diff / 8;
+
+	if (adaptive.attempts_avg > ATTEMPTS_HIGH) {
+		adaptive.retransmit_delay =
+			MIN(adaptive.retransmit_delay + ADAPTIVE_DELAY_STEP,
+			    CONFIG_ESB_RETRANSMIT_DELAY_MAX);
+	} else if (adaptive.attempts_avg < ATTEMPTS_LOW) {
+		adaptive.retransmit_delay =
+			MAX(adaptive.retransmit_delay - ADAPTIVE_DELAY_STEP,
+			    esb_cfg.retransmit_delay);
+	}
+
+	if (!success) {
+		adaptive_hop_next();
+	}
+}
+
+static void adaptive_rx_done(void)
+{
+	adaptive.channels[adaptive.idx].rx_packets++;
+	adaptive.rx_seen = true;
+}
+
+static void prx_hop_work_handler(struct k_work *work)
+{
+	if (esb_state == ESB_STATE_IDLE) {
+		/* RX is stopped. */
+		return;
+	}
+
+	if (adaptive.rx_seen || (adaptive.count < 2)) {
+		adaptive.rx_seen = false;
+		k_work_reschedule(&adaptive.prx_hop_work,
+				  K_MSEC(CONFIG_ESB_PRX_HOP_DWELL_MS));
+		return;
+	}
+
+	uint32_t key = irq_lock();
+
+	/* Do not interrupt an ACK that is being sent. */
+	if (esb_state == ESB_STATE_PRX) {
+		(void)esb_stop_rx();
+		adaptive_hop_next();
+		(void)esb_start_rx();
+	} else {
+		k_work_reschedule(&adaptive.prx_hop_work,
+				  K_MSEC(CONFIG_ESB_PRX_HOP_DWELL_MS));
+	}
+
+	irq_unlock(key);
+}
+
+static void adaptive_init(void)
+{
+	memset(adaptive.channels, 0, sizeof(adaptive.channels));
+	memset(adaptive.pipes, 0, sizeof(adaptive.pipes));
+
+	adaptive.count = 1;
+	adaptive.idx = 0;
+	adaptive.channels[0].channel = esb_addr.rf_channel;
+	adaptive.rx_seen = false;
+	adaptive.attempts_avg = ATTEMPTS_SCALE;
+	adaptive.retransmit_delay = esb_cfg.retransmit_delay;
+
+	k_work_init_delayable(&adaptive.prx_hop_work, prx_hop_work_handler);
+}
+
+static uint16_t retransmit_delay_get(void)
+{
+	return adaptive.retransmit_delay;
+}
+#else
+static inline void adaptive_tx_done(uint32_t attempts, bool success) {}
+static inline void adaptive_rx_done(void) {}
+
+static uint16_t retransmit_delay_get(void)
+{
+	return esb_cfg.retransmit_delay;
+}
+#endif /* defined(CONFIG_ESB_ADAPTIVE) */
+
+#if defined(CONFIG_ESB_TIMESTAMP)
+static struct esb_latency_stats latency_stats[CONFIG_ESB_PIPE_COUNT];
+static uint32_t tx_start_cycles;
+static volatile uint32_t last_tx_latency;
+
+static void latency_stats_reset(void)
+{
+	memset(latency_stats, 0, sizeof(latency_stats));
+
+	for (size_t i = 0; i < ARRAY_SIZE(latency_stats); i++) {
+		latency_stats[i].latency_min = UINT32_MAX;
+	}
+}
+
+static void latency_tx_start(void)
+{
+	tx_start_cycles = k_cycle_get_32();
+}
+
+static void latency_tx_done(uint32_t attempts, bool success)
+{
+	struct esb_latency_stats *stats =
+		&latency_stats[current_payload->pipe];
+	uint32_t latency;
+	uint8_t bucket;
+
+	if (!success) {
+		stats->failed++;
+		return;
+	}
+
+	latency = k_cyc_to_us_floor32(k_cycle_get_32() - tx_start_cycles);
+	last_tx_latency = latency;
+
+	bucket = latency ? (31 - __builtin_clz(latency)) : 0;
+	stats->latency_hist[MIN(bucket, ESB_LATENCY_HIST_BUCKETS - 1)]++;
+	stats->attempts_hist[MIN(attempts, ESB_ATTEMPTS_HIST_BUCKETS) - 1]++;
+
+	stats->count++;
+	stats->latency_min = MIN(stats->latency_min, latency);
+	stats->latency_max = MAX(stats->latency_max, latency);
+	stats->latency_sum += latency;
+}
+#else
+static inline void latency_tx_start(void) {}
+static inline void latency_tx_done(uint32_t attempts, bool success) {}
+#endif /* defined(CONFIG_ESB_TIMESTAMP) */
 
 static uint32_t radio_shorts_common = RADIO_SHORTS_COMMON;
 
@@ -446,6 +633,8 @@ static bool update_radio_parameters(void)
 
 static void reset_fifos(void)
 {
+	tx_reserved = false;
+	tx_burst_ramping = false;
 	tx_fifo.back = 0;
 	tx_fifo.front = 0;
 	tx_fifo.count = 0;
@@ -534,6 +723,9 @@ static bool rx_fifo_push_rfbuf(uint8_t pipe, uint8_t pid)
 	rx_fifo.payload[rx_fifo.back]->rssi = NRF_RADIO->RSSISAMPLE;
 	rx_fifo.payload[rx_fifo.back]->pid = pid;
 	rx_fifo.payload[rx_fifo.back]->noack = !(rx_payload_buffer[1] & 0x01);
+#if defined(CONFIG_ESB_TIMESTAMP)
+	rx_fifo.payload[rx_fifo.back]->timestamp = k_cycle_get_32();
+#endif
 
 	if (++rx_fifo.back >= CONFIG_ESB_RX_FIFO_SIZE) {
 		rx_fifo.back = 0;
@@ -587,11 +779,31 @@ static void ppi_init(void)
 							(1 << ppi_ch_timer_compare0_radio_disable) | (1 << ppi_ch_timer_compare1_radio_txen);
 }
 
+static bool tx_burst_next(void)
+{
+	uint32_t next;
+
+	if (!IS_ENABLED(CONFIG_ESB_TX_BURST) ||
+	    (esb_cfg.tx_mode != ESB_TXMODE_AUTO) ||
+	    !esb_cfg.selective_auto_ack ||
+	    (tx_fifo.count < 2)) {
+		return false;
+	}
+
+	next = tx_fifo.front + 1;
+	if (next >= CONFIG_ESB_TX_FIFO_SIZE) {
+		next = 0;
+	}
+
+	return tx_fifo.payload[next]->noack;
+}
+
 static void start_tx_transaction(void)
 {
 	bool ack;
 
 	last_tx_attempts = 1;
+	latency_tx_start();
 	/* Prepare the payload */
 	current_payload = tx_fifo.payload[tx_fifo.front];
 
@@ -636,7 +848,12 @@ static void start_tx_transaction(void)
 			on_radio_disabled = on_radio_disabled_tx;
 			esb_state = ESB_STATE_PTX_TX_ACK;
 		} else {
-			NRF_RADIO->SHORTS = radio_shorts_common;
+			/* Restart the radio in hardware when the next packet
+			 * does not need an ACK either.
+			 */
+			NRF_RADIO->SHORTS = radio_shorts_common |
+					    (tx_burst_next() ?
+					     RADIO_SHORTS_DISABLED_TXEN_Msk : 0);
 			NRF_RADIO->INTENSET = RADIO_INTENSET_DISABLED_Msk;
 			on_radio_disabled = on_radio_disabled_tx_noack;
 			esb_state = ESB_STATE_PTX_TX;
@@ -659,6 +876,15 @@ static void start_tx_transaction(void)
 
 	NRF_RADIO->EVENTS_ADDRESS = 0;
 	NRF_RADIO->EVENTS_PAYLOAD = 0;
+
+	/* In a burst, the radio is already ramping up and reads PACKETPTR
+	 * only when the START task is triggered on READY.
+	 */
+	if (tx_burst_ramping) {
+		tx_burst_ramping = false;
+		return;
+	}
+
 	NRF_RADIO->EVENTS_DISABLED = 0;
 
 	NRF_RADIO->TASKS_TXEN = 1;
@@ -666,10 +892,23 @@ static void start_tx_transaction(void)
 
 static void on_radio_disabled_tx_noack(void)
 {
+	tx_burst_ramping = (NRF_RADIO->SHORTS &
+			    RADIO_SHORTS_DISABLED_TXEN_Msk) != 0;
+
 	interrupt_flags |= INT_TX_SUCCESS_MSK;
+	adaptive_tx_done(1, true);
+	latency_tx_done(1, true);
 	tx_fifo_remove_last();
 
 	if (tx_fifo.count == 0) {
+		if (tx_burst_ramping) {
+			/* The TX FIFO was flushed during the burst. */
+			tx_burst_ramping = false;
+			on_radio_disabled = NULL;
+			NRF_RADIO->SHORTS = radio_shorts_common;
+			NRF_RADIO->TASKS_DISABLE = 1;
+		}
+
 		esb_state = ESB_STATE_IDLE;
 		NVIC_SetPendingIRQ(ESB_EVT_IRQ);
 	} else {
@@ -690,7 +929,7 @@ static void on_radio_disabled_tx(void)
 	 * received by the time defined in wait_for_ack_timeout_us
 	 */
 	ESB_SYS_TIMER->CC[0] = wait_for_ack_timeout_us;
-	ESB_SYS_TIMER->CC[1] = esb_cfg.retransmit_delay - 130;
+	ESB_SYS_TIMER->CC[1] = retransmit_delay_get() - 130;
 	ESB_SYS_TIMER->TASKS_CLEAR = 1;
 	ESB_SYS_TIMER->EVENTS_COMPARE[0] = 0;
 	ESB_SYS_TIMER->EVENTS_COMPARE[1] = 0;
@@ -729,6 +968,8 @@ static void on_radio_disabled_tx_wait_for_ack(void)
 		last_tx_attempts = esb_cfg.retransmit_count -
 				   retransmits_remaining + 1;
 
+		adaptive_tx_done(last_tx_attempts, true);
+		latency_tx_done(last_tx_attempts, true);
 		tx_fifo_remove_last();
 
 		if (esb_cfg.protocol != ESB_PROTOCOL_ESB &&
@@ -758,6 +999,10 @@ static void on_radio_disabled_tx_wait_for_ack(void)
 			last_tx_attempts = esb_cfg.retransmit_count + 1;
 			interrupt_flags |= INT_TX_FAILED_MSK;
 
+			/* Hops to the next channel for the next attempt. */
+			adaptive_tx_done(last_tx_attempts, false);
+			latency_tx_done(last_tx_attempts, false);
+
 			esb_state = ESB_STATE_IDLE;
 			NVIC_SetPendingIRQ(ESB_EVT_IRQ);
 		} else {
@@ -861,6 +1106,8 @@ static void on_radio_disabled_rx(void)
 		return;
 	}
 
+	adaptive_rx_done();
+
 	pipe_info = &rx_pipe_info[NRF_RADIO->RXMATCH];
 	if (NRF_RADIO->RXCRC == pipe_info->crc &&
 	    (rx_payload_buffer[1] >> 1) == pipe_info->pid) {
@@ -975,6 +1222,9 @@ static void esb_evt_irq_handler(void)
 	struct esb_evt event;
 
 	event.tx_attempts = last_tx_attempts;
+#if defined(CONFIG_ESB_TIMESTAMP)
+	event.tx_latency = last_tx_latency;
+#endif
 
 	get_and_clear_irqs(&interrupts);
 	if (event_handler != NULL) {
@@ -1050,6 +1300,14 @@ int esb_init(const struct esb_config *config)
 	sys_timer_init();
 	ppi_init();
 
+#if defined(CONFIG_ESB_ADAPTIVE)
+	adaptive_init();
+#endif
+
+#if defined(CONFIG_ESB_TIMESTAMP)
+	latency_stats_reset();
+#endif
+
 	IRQ_DIRECT_CONNECT(RADIO_IRQn, config->radio_irq_priority,
 			   RADIO_IRQHandler, 0);
 	IRQ_DIRECT_CONNECT(ESB_EVT_IRQ, config->event_irq_priority,
@@ -1091,6 +1349,12 @@ int esb_suspend(void)
 
 void esb_disable(void)
 {
+#if defined(CONFIG_ESB_ADAPTIVE)
+	if (esb_initialized) {
+		(void)k_work_cancel_delayable(&adaptive.prx_hop_work);
+	}
+#endif
+
 	/*  Clear PPI */
 	nrfx_gppi_channels_disable(ppi_all_channels_mask);
 
@@ -1124,41 +1388,65 @@ static struct payload_wrap *find_free_payload_cont(void)
 	return 0;
 }
 
+static int payload_check(const struct esb_payload *payload)
+{
+	if (payload->length == 0 ||
+	    payload->length > CONFIG_ESB_MAX_PAYLOAD_LENGTH ||
+	    (esb_cfg.protocol == ESB_PROTOCOL_ESB &&
+	     payload->length > esb_cfg.payload_length)) {
+		return -EMSGSIZE;
+	}
+	if (payload->pipe >= CONFIG_ESB_PIPE_COUNT) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Must be called with interrupts locked. */
+static void tx_fifo_push_back(void)
+{
+	struct esb_payload *payload = tx_fifo.payload[tx_fifo.back];
+
+	pids[payload->pipe] = (pids[payload->pipe] + 1) % (PID_MAX + 1);
+	payload->pid = pids[payload->pipe];
+
+	if (++tx_fifo.back >= CONFIG_ESB_TX_FIFO_SIZE) {
+		tx_fifo.back = 0;
+	}
+
+	tx_fifo.count++;
+}
+
 int esb_write_payload(const struct esb_payload *payload)
 {
+	int err;
+
 	if (!esb_initialized) {
 		return -EACCES;
 	}
 	if (payload == NULL) {
 		return -EINVAL;
 	}
-	if (payload->length == 0 ||
-	    payload->length > CONFIG_ESB_MAX_PAYLOAD_LENGTH ||
-	    (esb_cfg.protocol == ESB_PROTOCOL_ESB &&
-	     payload->length > esb_cfg.payload_length)) {
-		return -EMSGSIZE;
+	err = payload_check(payload);
+	if (err) {
+		return err;
 	}
 	if (tx_fifo.count >= CONFIG_ESB_TX_FIFO_SIZE) {
 		return -ENOMEM;
 	}
-	if (payload->pipe >= CONFIG_ESB_PIPE_COUNT) {
-		return -EINVAL;
+	if (tx_reserved) {
+		return -EBUSY;
 	}
 
 	uint32_t key = irq_lock();
 
 	if (esb_cfg.mode == ESB_MODE_PTX) {
+		/* Copy only the used part of the data. */
 		memcpy(tx_fifo.payload[tx_fifo.back], payload,
-			sizeof(struct esb_payload));
-
-		pids[payload->pipe] = (pids[payload->pipe] + 1) % (PID_MAX + 1);
-		tx_fifo.payload[tx_fifo.back]->pid = pids[payload->pipe];
+		       offsetof(struct esb_payload, data) + payload->length);
 
-		if (++tx_fifo.back >= CONFIG_ESB_TX_FIFO_SIZE) {
-			tx_fifo.back = 0;
-		}
-
-		tx_fifo.count++;
+		tx_fifo_push_back();
 	} else {
 		struct payload_wrap *new_ack_payload = find_free_payload_cont();
 
@@ -1195,6 +1483,70 @@ int esb_write_payload(const struct esb_payload *payload)
 	return 0;
 }
 
+int esb_reserve_tx_payload(struct esb_payload **payload)
+{
+	if (!esb_initialized) {
+		return -EACCES;
+	}
+	if (payload == NULL) {
+		return -EINVAL;
+	}
+	if (esb_cfg.mode != ESB_MODE_PTX) {
+		return -ENOTSUP;
+	}
+	if (tx_reserved) {
+		return -EBUSY;
+	}
+	if (tx_fifo.count >= CONFIG_ESB_TX_FIFO_SIZE) {
+		return -ENOMEM;
+	}
+
+	/* The slot at the back is outside of the queue, so the radio does
+	 * not use it until it is committed.
+	 */
+	tx_reserved = true;
+	*payload = tx_fifo.payload[tx_fifo.back];
+	(*payload)->noack = 0;
+
+	return 0;
+}
+
+int esb_commit_tx_payload(void)
+{
+	int err;
+
+	if (!esb_initialized) {
+		return -EACCES;
+	}
+	if (!tx_reserved) {
+		return -EINVAL;
+	}
+
+	err = payload_check(tx_fifo.payload[tx_fifo.back]);
+	if (err) {
+		return err;
+	}
+
+	uint32_t key = irq_lock();
+
+	tx_reserved = false;
+	tx_fifo_push_back();
+
+	irq_unlock(key);
+
+	if (esb_cfg.tx_mode == ESB_TXMODE_AUTO &&
+	    esb_state == ESB_STATE_IDLE) {
+		start_tx_transaction();
+	}
+
+	return 0;
+}
+
+void esb_cancel_tx_payload(void)
+{
+	tx_reserved = false;
+}
+
 int esb_read_rx_payload(struct esb_payload *payload)
 {
 	if (!esb_initialized) {
@@ -1215,6 +1567,9 @@ int esb_read_rx_payload(struct esb_payload *payload)
 	payload->rssi = rx_fifo.payload[rx_fifo.front]->rssi;
 	payload->pid = rx_fifo.payload[rx_fifo.front]->pid;
 	payload->noack = rx_fifo.payload[rx_fifo.front]->noack;
+#if defined(CONFIG_ESB_TIMESTAMP)
+	payload->timestamp = rx_fifo.payload[rx_fifo.front]->timestamp;
+#endif
 	memcpy(payload->data, rx_fifo.payload[rx_fifo.front]->data,
 	       payload->length);
 
@@ -1272,6 +1627,11 @@ int esb_start_rx(void)
 
 	NRF_RADIO->TASKS_RXEN = 1;
 
+#if defined(CONFIG_ESB_ADAPTIVE)
+	k_work_reschedule(&adaptive.prx_hop_work,
+			  K_MSEC(CONFIG_ESB_PRX_HOP_DWELL_MS));
+#endif
+
 	return 0;
 }
 
@@ -1303,6 +1663,7 @@ int esb_flush_tx(void)
 
 	uint32_t key = irq_lock();
 
+	tx_reserved = false;
 	tx_fifo.count = 0;
 	tx_fifo.back = 0;
 	tx_fifo.front = 0;
@@ -1463,6 +1824,13 @@ int esb_set_rf_channel(uint32_t channel)
 
 	esb_addr.rf_channel = channel;
 
+#if defined(CONFIG_ESB_ADAPTIVE)
+	/* A single channel replaces the hopping list. */
+	adaptive.count = 1;
+	adaptive.idx = 0;
+	adaptive.channels[0].channel = channel;
+#endif
+
 	return 0;
 }
 
@@ -1502,6 +1870,10 @@ int esb_set_retransmit_delay(uint16_t delay)
 
 	esb_cfg.retransmit_delay = delay;
 
+#if defined(CONFIG_ESB_ADAPTIVE)
+	adaptive.retransmit_delay = delay;
+#endif
+
 	return 0;
 }
 
@@ -1540,3 +1912,118 @@ int esb_reuse_pid(uint8_t pipe)
 
 	return 0;
 }
+
+#if defined(CONFIG_ESB_ADAPTIVE)
+int esb_set_hop_channels(const uint8_t *channels, uint8_t count)
+{
+	if (esb_state != ESB_STATE_IDLE) {
+		return -EBUSY;
+	}
+	if (!channels || (count == 0) ||
+	    (count > CONFIG_ESB_HOP_CHANNELS_MAX)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (channels[i] > 100) {
+			return -EINVAL;
+		}
+	}
+
+	memset(adaptive.channels, 0, sizeof(adaptive.channels));
+
+	for (size_t i = 0; i < count; i++) {
+		adaptive.channels[i].channel = channels[i];
+	}
+
+	adaptive.count = count;
+	adaptive.idx = 0;
+	esb_addr.rf_channel = channels[0];
+
+	return 0;
+}
+
+int esb_get_channel_stats(struct esb_channel_stats *stats, uint8_t *count)
+{
+	if (!stats || !count) {
+		return -EINVAL;
+	}
+
+	uint32_t key = irq_lock();
+
+	*count = MIN(*count, adaptive.count);
+	memcpy(stats, adaptive.channels, *count * sizeof(*stats));
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+int esb_get_pipe_stats(uint8_t pipe, struct esb_pipe_stats *stats)
+{
+	if (!stats || (pipe >= CONFIG_ESB_PIPE_COUNT)) {
+		return -EINVAL;
+	}
+
+	uint32_t key = irq_lock();
+
+	*stats = adaptive.pipes[pipe];
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+void esb_reset_stats(void)
+{
+	uint32_t key = irq_lock();
+
+	for (size_t i = 0; i < adaptive.count; i++) {
+		uint8_t channel = adaptive.channels[i].channel;
+
+		memset(&adaptive.channels[i], 0, sizeof(adaptive.channels[i]));
+		adaptive.channels[i].channel = channel;
+	}
+
+	memset(adaptive.pipes, 0, sizeof(adaptive.pipes));
+
+	irq_unlock(key);
+}
+
+int esb_get_retransmit_delay(uint16_t *delay)
+{
+	if (!delay) {
+		return -EINVAL;
+	}
+
+	*delay = adaptive.retransmit_delay;
+
+	return 0;
+}
+#endif /* defined(CONFIG_ESB_ADAPTIVE) */
+
+#if defined(CONFIG_ESB_TIMESTAMP)
+int esb_get_latency_stats(uint8_t pipe, struct esb_latency_stats *stats)
+{
+	if (!stats || (pipe >= CONFIG_ESB_PIPE_COUNT)) {
+		return -EINVAL;
+	}
+
+	uint32_t key = irq_lock();
+
+	*stats = latency_stats[pipe];
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+void esb_reset_latency_stats(void)
+{
+	uint32_t key = irq_lock();
+
+	latency_stats_reset();
+
+	irq_unlock(key);
+}
+#endif /* defined(CONFIG_ESB_TIMESTAMP) */
@@ -5,6 +5,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <zephyr.h>
 #include <spinlock.h>
 #include <sys/slist.h>
@@ -19,6 +20,12 @@ LOG_MODULE_REGISTER(event_manager, CONFIG_EVENT_MANAGER_LOG_LEVEL);
  */
 const struct {} linker_tag __attribute__((__section__("event_manager"))) __used;
 
+/* Zero-length entry that causes the section to be generated by the linker
+ * even if no event type is assigned to an event queue.
+ */
+const struct {} event_queue_assignments_empty
+	__attribute__((__section__("event_queue_assignments"))) __used;
+
 
 static void event_processor_fn(struct k_work *work);
 
@@ -35,9 +42,52 @@ extern uint32_t event_manager_displayed_events;
 static uint32_t event_manager_displayed_events;
 #endif
 
+#ifdef CONFIG_EVENT_MANAGER_QUEUES
+#define EVENT_QUEUE_CNT EVENT_QUEUE_COUNT
+#else
+#define EVENT_QUEUE_CNT 1
+#endif
+
+/* Up to 32 event types can be used in an application. */
+#define EVENT_TYPE_MAX_CNT 32
+
+struct event_queue {
+	sys_slist_t events;
+	struct k_work work;
+	struct k_work_q *work_q;
+#ifdef CONFIG_EVENT_MANAGER_STATS
+	atomic_t depth;
+	atomic_t depth_max;
+#endif
+};
+
+#define EVENT_QUEUE_INIT(_queue, _work_q)				\
+	{								\
+		.events = SYS_SLIST_STATIC_INIT(&event_queues[_queue].events),\
+		.work = Z_WORK_INITIALIZER(event_processor_fn),		\
+		.work_q = _work_q,					\
+	}
+
+#ifdef CONFIG_EVENT_MANAGER_QUEUES
+static K_THREAD_STACK_DEFINE(realtime_work_q_stack,
+			     CONFIG_EVENT_MANAGER_QUEUE_REALTIME_STACK_SIZE);
+static K_THREAD_STACK_DEFINE(bulk_work_q_stack,
+			     CONFIG_EVENT_MANAGER_QUEUE_BULK_STACK_SIZE);
+static struct k_work_q realtime_work_q;
+static struct k_work_q bulk_work_q;
+
+static uint8_t event_type_queue_ids[EVENT_TYPE_MAX_CNT];
+#endif
+
+static struct event_queue event_queues[EVENT_QUEUE_CNT] = {
+	[EVENT_QUEUE_DEFAULT] = EVENT_QUEUE_INIT(EVENT_QUEUE_DEFAULT, &k_sys_work_q),
+#ifdef CONFIG_EVENT_MANAGER_QUEUES
+	[EVENT_QUEUE_REALTIME] = EVENT_QUEUE_INIT(EVENT_QUEUE_REALTIME, &realtime_work_q),
+	[EVENT_QUEUE_BULK] = EVENT_QUEUE_INIT(EVENT_QUEUE_BULK, &bulk_work_q),
+#endif
+};
+
 static uint16_t profiler_event_ids[IDS_COUNT];
-static K_WORK_DEFINE(event_processor, event_processor_fn);
-static sys_slist_t eventq = SYS_SLIST_STATIC_INIT(&eventq);
 static struct k_spinlock lock;
 
 
@@ -228,87 +278,466 @@ static int trace_event_init(void)
 	return 0;
 }
 
+#if defined(CONFIG_EVENT_MANAGER_MEM_SLAB) || defined(CONFIG_EVENT_MANAGER_STATS)
+static void atomic_max_update(atomic_t *max, atomic_val_t val)
+{
+	atomic_val_t prev;
+
+	do {
+		prev = atomic_get(max);
+		if (val <= prev) {
+			return;
+		}
+	} while (!atomic_cas(max, prev, val));
+}
+#endif
+
+#ifdef CONFIG_EVENT_MANAGER_MEM_SLAB
+static bool is_mem_slab_block(const struct k_mem_slab *slab, const void *ptr)
+{
+	const uint8_t *start = (const uint8_t *)slab->buffer;
+	const uint8_t *end = start + slab->num_blocks * slab->block_size;
+
+	return ((const uint8_t *)ptr >= start) && ((const uint8_t *)ptr < end);
+}
+
+void *_event_manager_alloc(const struct event_type *et, size_t size)
+{
+	ASSERT_EVENT_ID(et);
+
+	struct k_mem_slab *slab = et->mem_slab;
+
+	if (!slab || (size > slab->block_size)) {
+		return k_malloc(size);
+	}
+
+	void *event;
+
+	if (k_mem_slab_alloc(slab, &event, K_NO_WAIT)) {
+		return NULL;
+	}
+
+	atomic_max_update(et->mem_slab_max_used, k_mem_slab_num_used_get(slab));
+
+	return event;
+}
+
+static void event_free(struct event_header *eh)
+{
+	struct k_mem_slab *slab = eh->type_id->mem_slab;
+
+	if (slab && is_mem_slab_block(slab, eh)) {
+		void *event = eh;
+
+		k_mem_slab_free(slab, &event);
+	} else {
+		k_free(eh);
+	}
+}
+#else
+static void event_free(struct event_header *eh)
+{
+	k_free(eh);
+}
+#endif /* CONFIG_EVENT_MANAGER_MEM_SLAB */
+
+#ifdef CONFIG_EVENT_MANAGER_EVENT_REF
+static void event_ref_init(struct event_header *eh)
+{
+	atomic_set(&eh->ref_cnt, 1);
+}
+
+void event_manager_event_ref(const struct event_header *eh)
+{
+	__ASSERT_NO_MSG(eh);
+
+	atomic_val_t prev = atomic_inc((atomic_t *)&eh->ref_cnt);
+
+	__ASSERT_NO_MSG(prev > 0);
+	ARG_UNUSED(prev);
+}
+
+void event_manager_event_unref(const struct event_header *eh)
+{
+	__ASSERT_NO_MSG(eh);
+
+	atomic_val_t prev = atomic_dec((atomic_t *)&eh->ref_cnt);
+
+	__ASSERT_NO_MSG(prev > 0);
+
+	if (prev == 1) {
+		event_free((struct event_header *)eh);
+	}
+}
+
+static void event_release(struct event_header *eh)
+{
+	event_manager_event_unref(eh);
+}
+#else
+static void event_ref_init(struct event_header *eh)
+{
+	ARG_UNUSED(eh);
+}
+
+static void event_release(struct event_header *eh)
+{
+	event_free(eh);
+}
+#endif /* CONFIG_EVENT_MANAGER_EVENT_REF */
+
+#ifdef CONFIG_EVENT_MANAGER_STATS
+static uint32_t time_us_since(uint32_t start)
+{
+	return k_cyc_to_us_floor32(k_cycle_get_32() - start);
+}
+
+static void stats_event_submit(struct event_header *eh,
+			       struct event_queue *queue)
+{
+	eh->submit_time = k_cycle_get_32();
+	atomic_inc(&eh->type_id->stats->submitted);
+	atomic_max_update(&queue->depth_max, atomic_inc(&queue->depth) + 1);
+}
+
+/* Events of a given type are always processed by the same event queue,
+ * so the event type statistics are not updated concurrently.
+ */
+static void stats_event_dispatch(const struct event_header *eh)
+{
+	struct event_type_stats *stats = eh->type_id->stats;
+	uint32_t latency = time_us_since(eh->submit_time);
+
+	stats->latency_sum_us += latency;
+	stats->latency_max_us = MAX(stats->latency_max_us, latency);
+}
+
+static void stats_event_processed(const struct event_type *et, bool consumed)
+{
+	et->stats->processed++;
+
+	if (consumed) {
+		et->stats->consumed++;
+	}
+}
+
+static void stats_event_done(struct event_queue *queue)
+{
+	atomic_dec(&queue->depth);
+}
+
+/* Listeners can be notified from multiple event queues. */
+static void stats_listener_update(struct event_listener_stats *stats,
+				  uint32_t time_us)
+{
+	size_t bucket = 0;
+
+	while ((time_us >> bucket) > 1 &&
+	       bucket < (EVENT_MANAGER_STATS_HIST_LEN - 1)) {
+		bucket++;
+	}
+
+	atomic_inc(&stats->calls);
+	atomic_inc(&stats->time_hist[bucket]);
+	atomic_max_update(&stats->time_max_us, time_us);
+}
+
+static bool listener_notify(const struct event_listener *el,
+			    const struct event_header *eh)
+{
+	uint32_t start = k_cycle_get_32();
+	bool consumed = el->notification(eh);
+
+	stats_listener_update(el->stats, time_us_since(start));
+
+	return consumed;
+}
+#else
+static void stats_event_submit(struct event_header *eh,
+			       struct event_queue *queue)
+{
+}
+
+static void stats_event_dispatch(const struct event_header *eh)
+{
+}
+
+static void stats_event_processed(const struct event_type *et, bool consumed)
+{
+}
+
+static void stats_event_done(struct event_queue *queue)
+{
+}
+
+static bool listener_notify(const struct event_listener *el,
+			    const struct event_header *eh)
+{
+	return el->notification(eh);
+}
+#endif /* CONFIG_EVENT_MANAGER_STATS */
+
+static void event_queue_work_submit(struct event_queue *queue)
+{
+	k_work_submit_to_queue(queue->work_q, &queue->work);
+}
+
+static void process_event(struct event_header *eh)
+{
+	ASSERT_EVENT_ID(eh->type_id);
+
+	const struct event_type *et = eh->type_id;
+	bool consumed = false;
+
+	stats_event_dispatch(eh);
+
+	trace_event_execution(eh, true);
+
+	log_event(eh);
+
+	/* Subscribers of all priorities form a single array. */
+	for (const struct event_subscriber *es =
+			et->subs_start[SUBS_PRIO_MIN];
+	     es != et->subs_stop[SUBS_PRIO_MAX];
+	     es++) {
+
+		__ASSERT_NO_MSG(es != NULL);
+
+		const struct event_listener *el = es->listener;
+
+		__ASSERT_NO_MSG(el != NULL);
+		__ASSERT_NO_MSG(el->notification != NULL);
+
+		log_event_progress(et, el);
+
+		if (listener_notify(el, eh)) {
+			log_event_consumed(et);
+			consumed = true;
+			break;
+		}
+	}
+
+	trace_event_execution(eh, false);
+
+	stats_event_processed(et, consumed);
+
+	event_release(eh);
+}
+
 static void event_processor_fn(struct k_work *work)
 {
+	struct event_queue *queue = CONTAINER_OF(work, struct event_queue, work);
 	sys_slist_t events = SYS_SLIST_STATIC_INIT(&events);
 
 	/* Make current event list local. */
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	if (sys_slist_is_empty(&eventq)) {
+	if (sys_slist_is_empty(&queue->events)) {
 		k_spin_unlock(&lock, key);
 		return;
 	}
 
-	sys_slist_merge_slist(&events, &eventq);
+	sys_slist_merge_slist(&events, &queue->events);
 
 	k_spin_unlock(&lock, key);
 
 
 	/* Traverse the list of events. */
 	sys_snode_t *node;
+	size_t processed = 0;
+
 	while (NULL != (node = sys_slist_get(&events))) {
 		struct event_header *eh = CONTAINER_OF(node,
 						       struct event_header,
 						       node);
 
-		ASSERT_EVENT_ID(eh->type_id);
+		process_event(eh);
+		stats_event_done(queue);
+		processed++;
+
+		if ((CONFIG_EVENT_MANAGER_MAX_EVENTS_PER_PASS > 0) &&
+		    (processed >= CONFIG_EVENT_MANAGER_MAX_EVENTS_PER_PASS) &&
+		    !sys_slist_is_empty(&events)) {
+			/* Put the remaining events back in front of the queue
+			 * and let other work items run.
+			 */
+			key = k_spin_lock(&lock);
+			sys_slist_merge_slist(&events, &queue->events);
+			sys_slist_merge_slist(&queue->events, &events);
+			k_spin_unlock(&lock, key);
+
+			event_queue_work_submit(queue);
+			break;
+		}
+	}
+}
+
+static struct event_queue *event_queue_get(const struct event_type *et)
+{
+#ifdef CONFIG_EVENT_MANAGER_QUEUES
+	size_t event_idx = et - __start_event_types;
+
+	return &event_queues[event_type_queue_ids[event_idx]];
+#else
+	return &event_queues[EVENT_QUEUE_DEFAULT];
+#endif
+}
+
+void _event_submit(struct event_header *eh)
+{
+	__ASSERT_NO_MSG(eh);
+	ASSERT_EVENT_ID(eh->type_id);
+
+	struct event_queue *queue = event_queue_get(eh->type_id);
+
+	event_ref_init(eh);
+	trace_event_submission(eh);
+	stats_event_submit(eh, queue);
 
-		const struct event_type *et = eh->type_id;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	sys_slist_append(&queue->events, &eh->node);
+	k_spin_unlock(&lock, key);
 
-		trace_event_execution(eh, true);
+	event_queue_work_submit(queue);
+}
 
-		log_event(eh);
+void event_submit_batch(sys_slist_t *events)
+{
+	__ASSERT_NO_MSG(events);
 
-		bool consumed = false;
+	if (sys_slist_is_empty(events)) {
+		return;
+	}
 
-		for (size_t prio = SUBS_PRIO_MIN;
-		     (prio <= SUBS_PRIO_MAX) && !consumed;
-		     prio++) {
-			for (const struct event_subscriber *es =
-					et->subs_start[prio];
-			     (es != et->subs_stop[prio]) && !consumed;
-			     es++) {
+	struct event_header *eh;
 
-				__ASSERT_NO_MSG(es != NULL);
+	SYS_SLIST_FOR_EACH_CONTAINER(events, eh, node) {
+		ASSERT_EVENT_ID(eh->type_id);
+		event_ref_init(eh);
+		trace_event_submission(eh);
+		stats_event_submit(eh, event_queue_get(eh->type_id));
+	}
 
-				const struct event_listener *el = es->listener;
+	uint32_t queue_mask = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
 
-				__ASSERT_NO_MSG(el != NULL);
-				__ASSERT_NO_MSG(el->notification != NULL);
+	if (EVENT_QUEUE_CNT == 1) {
+		sys_slist_merge_slist(&event_queues[EVENT_QUEUE_DEFAULT].events,
+				      events);
+		queue_mask = BIT(EVENT_QUEUE_DEFAULT);
+	} else {
+		sys_snode_t *node;
 
-				log_event_progress(et, el);
+		while (NULL != (node = sys_slist_get(events))) {
+			eh = CONTAINER_OF(node, struct event_header, node);
 
-				consumed = el->notification(eh);
+			struct event_queue *queue = event_queue_get(eh->type_id);
 
-				if (consumed) {
-					log_event_consumed(et);
-				}
-			}
+			sys_slist_append(&queue->events, node);
+			queue_mask |= BIT(queue - event_queues);
 		}
+	}
 
-		trace_event_execution(eh, false);
+	k_spin_unlock(&lock, key);
 
-		k_free(eh);
+	for (size_t i = 0; i < ARRAY_SIZE(event_queues); i++) {
+		if (queue_mask & BIT(i)) {
+			event_queue_work_submit(&event_queues[i]);
+		}
 	}
 }
 
-void _event_submit(struct event_header *eh)
+#ifdef CONFIG_EVENT_MANAGER_STATS
+int event_manager_queue_stats_get(enum event_queue_id queue,
+				  struct event_queue_stats *stats)
 {
-	__ASSERT_NO_MSG(eh);
-	ASSERT_EVENT_ID(eh->type_id);
+	if ((queue >= ARRAY_SIZE(event_queues)) || !stats) {
+		return -EINVAL;
+	}
 
-	trace_event_submission(eh);
+	stats->depth = atomic_get(&event_queues[queue].depth);
+	stats->depth_max = atomic_get(&event_queues[queue].depth_max);
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
-	sys_slist_append(&eventq, &eh->node);
-	k_spin_unlock(&lock, key);
+	return 0;
+}
 
-	k_work_submit(&event_processor);
+void event_manager_stats_reset(void)
+{
+	for (const struct event_type *et = __start_event_types;
+	     (et != NULL) && (et != __stop_event_types);
+	     et++) {
+		memset(et->stats, 0, sizeof(*et->stats));
+	}
+
+	for (const struct event_listener *el = __start_event_listeners;
+	     el != __stop_event_listeners;
+	     el++) {
+		memset(el->stats, 0, sizeof(*el->stats));
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(event_queues); i++) {
+		atomic_set(&event_queues[i].depth_max,
+			   atomic_get(&event_queues[i].depth));
+	}
+}
+#endif /* CONFIG_EVENT_MANAGER_STATS */
+
+static void verify_subscribers(void)
+{
+	for (const struct event_type *et = __start_event_types;
+	     (et != NULL) && (et != __stop_event_types);
+	     et++) {
+		for (size_t prio = SUBS_PRIO_MIN; prio < SUBS_PRIO_MAX; prio++) {
+			/* Linker must place subscriber arrays back to back. */
+			__ASSERT(et->subs_stop[prio] == et->subs_start[prio + 1],
+				 "Subscribers of %s are not contiguous", et->name);
+		}
+	}
+}
+
+#ifdef CONFIG_EVENT_MANAGER_QUEUES
+static void event_queues_init(void)
+{
+	__ASSERT_NO_MSG((__stop_event_types - __start_event_types) <=
+			ARRAY_SIZE(event_type_queue_ids));
+
+	for (const struct event_queue_assignment *eqa =
+			__start_event_queue_assignments;
+	     eqa != __stop_event_queue_assignments;
+	     eqa++) {
+		ASSERT_EVENT_ID(eqa->type_id);
+		__ASSERT_NO_MSG(eqa->queue < EVENT_QUEUE_COUNT);
+
+		size_t event_idx = eqa->type_id - __start_event_types;
+
+		event_type_queue_ids[event_idx] = eqa->queue;
+	}
+
+	k_work_queue_start(&realtime_work_q, realtime_work_q_stack,
+			   K_THREAD_STACK_SIZEOF(realtime_work_q_stack),
+			   CONFIG_EVENT_MANAGER_QUEUE_REALTIME_PRIORITY, NULL);
+	k_thread_name_set(&realtime_work_q.thread, "em_realtime");
+
+	k_work_queue_start(&bulk_work_q, bulk_work_q_stack,
+			   K_THREAD_STACK_SIZEOF(bulk_work_q_stack),
+			   CONFIG_EVENT_MANAGER_QUEUE_BULK_PRIORITY, NULL);
+	k_thread_name_set(&bulk_work_q.thread, "em_bulk");
+
+	/* Process events submitted before the work queues were started. */
+	for (size_t i = 0; i < ARRAY_SIZE(event_queues); i++) {
+		event_queue_work_submit(&event_queues[i]);
+	}
+}
+#else
+static void event_queues_init(void)
+{
 }
+#endif /* CONFIG_EVENT_MANAGER_QUEUES */
 
 int event_manager_init(void)
 {
+	verify_subscribers();
+	event_queues_init();
 	log_event_init();
 
 	return trace_event_init();
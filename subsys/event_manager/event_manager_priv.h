@@ -26,19 +26,25 @@ extern "C" {
 #define _SUBS_PRIO_FINAL  2
 
 
-/* Convenience macros generating section names. */
+/* Convenience macros generating section names.
+ *
+ * Subscribers of all event types are placed in a single output section with
+ * input sections sorted by name (see em.ld). For every event type and priority
+ * level there are three input sections: the start marker, the subscribers and
+ * the stop marker. The sorting makes subscribers of an event type a single
+ * contiguous array ordered by priority, that can be processed in one pass.
+ */
 
 #define _SUBS_PRIO_ID(level) _CONCAT(_CONCAT(_prio, level), _)
 
 #define _EVENT_SUBSCRIBERS_SECTION_PREFIX(ename, prio)	_CONCAT(_CONCAT(event_subscribers_, ename), prio)
 
-#define _EVENT_SUBSCRIBERS_SECTION_NAME(ename, prio)	STRINGIFY(_EVENT_SUBSCRIBERS_SECTION_PREFIX(ename, prio))
-
+#define _EVENT_SUBSCRIBERS_SECTION_NAME(ename, prio, part) \
+	"event_subscribers." STRINGIFY(ename) "." STRINGIFY(prio) "." part
 
-/* Declare a zero-length subscriber. */
-#define _EVENT_SUBSCRIBERS_EMPTY(ename, prio)								\
-	const struct {} _CONCAT(_EVENT_SUBSCRIBERS_SECTION_PREFIX(ename, prio), empty)			\
-	__attribute__((__section__(STRINGIFY(_EVENT_SUBSCRIBERS_SECTION_NAME(ename, prio))))) = {};
+#define _EVENT_SUBSCRIBERS_SECTION_START	"a"
+#define _EVENT_SUBSCRIBERS_SECTION_SUBS		"b"
+#define _EVENT_SUBSCRIBERS_SECTION_STOP		"c"
 
 
 /* Convenience macros generating section start and stop markers. */
@@ -48,6 +54,12 @@ extern "C" {
 #define _EVENT_SUBSCRIBERS_STOP(ename, prio)	_CONCAT(__stop_,  _EVENT_SUBSCRIBERS_SECTION_PREFIX(ename, prio))
 
 
+/* Declare a zero-length marker of the subscribers array. */
+#define _EVENT_SUBSCRIBERS_MARKER(marker, ename, prio, part)					\
+	const struct event_subscriber marker(ename, prio)[0] __used				\
+	__attribute__((__section__(_EVENT_SUBSCRIBERS_SECTION_NAME(ename, prio, part)))) = {};
+
+
 #define _EVENT_SUBSCRIBERS_DECLARE(ename)										\
 	extern const struct event_subscriber _EVENT_SUBSCRIBERS_START(ename, _SUBS_PRIO_ID(_SUBS_PRIO_FIRST))[];	\
 	extern const struct event_subscriber _EVENT_SUBSCRIBERS_STOP(ename,  _SUBS_PRIO_ID(_SUBS_PRIO_FIRST))[];	\
@@ -57,23 +69,29 @@ extern "C" {
 	extern const struct event_subscriber _EVENT_SUBSCRIBERS_STOP(ename,  _SUBS_PRIO_ID(_SUBS_PRIO_FINAL))[];
 
 
-/* Macro defining empty subscribers on each priority level.
+/* Macro defining start and stop markers of subscribers on each priority level.
  * Each event type keeps an array of subscribers for every priority level.
  * It can happen that for a given priority no subscriber will be registered.
- * This macro declares zero-length subscriber that will cause required section
- * to be generated by the linker. If no subscriber is registered at this
- * level section will remain empty.
+ * In that case start and stop markers point to the same location and the
+ * array remains empty.
  */
-#define _EVENT_SUBSCRIBERS_DEFINE(ename)					\
-	_EVENT_SUBSCRIBERS_EMPTY(ename, _SUBS_PRIO_ID(_SUBS_PRIO_FIRST))	\
-	_EVENT_SUBSCRIBERS_EMPTY(ename, _SUBS_PRIO_ID(_SUBS_PRIO_NORMAL))	\
-	_EVENT_SUBSCRIBERS_EMPTY(ename, _SUBS_PRIO_ID(_SUBS_PRIO_FINAL))
+#define _EVENT_SUBSCRIBERS_DEFINE_PRIO(ename, prio)						\
+	_EVENT_SUBSCRIBERS_MARKER(_EVENT_SUBSCRIBERS_START, ename, prio,			\
+				  _EVENT_SUBSCRIBERS_SECTION_START)				\
+	_EVENT_SUBSCRIBERS_MARKER(_EVENT_SUBSCRIBERS_STOP, ename, prio,				\
+				  _EVENT_SUBSCRIBERS_SECTION_STOP)
+
+#define _EVENT_SUBSCRIBERS_DEFINE(ename)						\
+	_EVENT_SUBSCRIBERS_DEFINE_PRIO(ename, _SUBS_PRIO_ID(_SUBS_PRIO_FIRST))		\
+	_EVENT_SUBSCRIBERS_DEFINE_PRIO(ename, _SUBS_PRIO_ID(_SUBS_PRIO_NORMAL))		\
+	_EVENT_SUBSCRIBERS_DEFINE_PRIO(ename, _SUBS_PRIO_ID(_SUBS_PRIO_FINAL))
 
 
 /* Subscribe a listener to an event. */
 #define _EVENT_SUBSCRIBE(lname, ename, prio)								\
 	const struct event_subscriber _CONCAT(_CONCAT(__event_subscriber_, ename), lname) __used	\
-	__attribute__((__section__(_EVENT_SUBSCRIBERS_SECTION_NAME(ename, prio)))) = {			\
+	__attribute__((__section__(_EVENT_SUBSCRIBERS_SECTION_NAME(ename, prio,			\
+						_EVENT_SUBSCRIBERS_SECTION_SUBS)))) = {		\
 		.listener = &_CONCAT(__event_listener_, lname),						\
 	}
 
@@ -82,6 +100,16 @@ extern "C" {
 #define _EVENT_ID(ename) (&_CONCAT(__event_type_, ename))
 
 
+/* Memory used by an event. Event types defined with a memory slab take
+ * the memory from the slab, the remaining ones use the heap.
+ */
+#ifdef CONFIG_EVENT_MANAGER_MEM_SLAB
+#define _EVENT_ALLOC(ename, size) _event_manager_alloc(_EVENT_ID(ename), (size))
+#else
+#define _EVENT_ALLOC(ename, size) k_malloc(size)
+#endif
+
+
 /* Macro generates a function of name new_ename where ename is provided as
  * an argument. Allocator function is used to create an event of the given
  * ename type.
@@ -89,7 +117,8 @@ extern "C" {
 #define _EVENT_ALLOCATOR_FN(ename)					\
 	static inline struct ename *_CONCAT(new_, ename)(void)		\
 	{								\
-		struct ename *event = (struct ename *)k_malloc(sizeof(*event));\
+		struct ename *event =					\
+			(struct ename *)_EVENT_ALLOC(ename, sizeof(*event));\
 		BUILD_ASSERT(offsetof(struct ename, header) == 0,	\
 				 "");					\
 		if (unlikely(!event)) {					\
@@ -111,7 +140,8 @@ extern "C" {
 #define _EVENT_ALLOCATOR_DYNDATA_FN(ename)				\
 	static inline struct ename *_CONCAT(new_, ename)(size_t size)	\
 	{								\
-		struct ename *event = (struct ename *)k_malloc(sizeof(*event) + size);\
+		struct ename *event =					\
+			(struct ename *)_EVENT_ALLOC(ename, sizeof(*event) + size);\
 		BUILD_ASSERT((offsetof(struct ename, dyndata) +		\
 				  sizeof(event->dyndata.size)) ==	\
 				 sizeof(*event), "");			\
@@ -196,11 +226,36 @@ extern "C" {
 			}
 
 
+/* Statistics related fields of the event type and listener structures. */
+#ifdef CONFIG_EVENT_MANAGER_STATS
+#define _EVENT_STATS_NAME(prefix, name)	_CONCAT(_CONCAT(__event_stats_, prefix), name)
+
+#define _EVENT_STATS_DEFINE(type, prefix, name)	\
+	static struct type _EVENT_STATS_NAME(prefix, name)
+
+#define _EVENT_STATS_INIT(prefix, name)	\
+		.stats = &_EVENT_STATS_NAME(prefix, name),
+#else
+#define _EVENT_STATS_DEFINE(type, prefix, name)
+#define _EVENT_STATS_INIT(prefix, name)
+#endif
+
+
 #define _EVENT_LISTENER(lname, notification_fn)					\
+	_EVENT_STATS_DEFINE(event_listener_stats, listener_, lname);		\
 	const struct event_listener _CONCAT(__event_listener_, lname) __used	\
 	__attribute__((__section__("event_listeners"))) = {			\
 		.name = STRINGIFY(lname),					\
 		.notification = (notification_fn),				\
+		_EVENT_STATS_INIT(listener_, lname)				\
+	}
+
+
+#define _EVENT_QUEUE_ASSIGN(ename, queue_id)						\
+	const struct event_queue_assignment _CONCAT(__event_queue_assignment_, ename) __used	\
+	__attribute__((__section__("event_queue_assignments"))) = {			\
+		.type_id = _EVENT_ID(ename),						\
+		.queue = (queue_id),							\
 	}
 
 
@@ -221,8 +276,45 @@ extern "C" {
 	_EVENT_ALLOCATOR_DYNDATA_FN(ename)
 
 
-#define _EVENT_TYPE_DEFINE(ename, init_log_en, log_fn, ev_info_struct)							\
+/* Memory slab related fields of the event type structure. */
+#ifdef CONFIG_EVENT_MANAGER_MEM_SLAB
+#define _EVENT_MEM_SLAB_NAME(ename)		_CONCAT(__event_mem_slab_, ename)
+
+#define _EVENT_MEM_SLAB_MAX_USED_NAME(ename)	_CONCAT(__event_mem_slab_max_used_, ename)
+
+#define _EVENT_MEM_SLAB_INIT(slab, max_used)	\
+		.mem_slab = (slab),		\
+		.mem_slab_max_used = (max_used),
+
+/* Indirection needed to expand the slab name before it is concatenated. */
+#define _EVENT_MEM_SLAB_DEFINE(name, block_size, block_cnt) \
+	K_MEM_SLAB_DEFINE(name, block_size, block_cnt, sizeof(void *))
+#else
+#define _EVENT_MEM_SLAB_INIT(slab, max_used)
+#endif
+
+
+#define _EVENT_TYPE_DEFINE(ename, init_log_en, log_fn, ev_info_struct)		\
+	_EVENT_TYPE_DEFINE_COMMON(ename, init_log_en, log_fn, ev_info_struct,	\
+				  _EVENT_MEM_SLAB_INIT(NULL, NULL))
+
+
+#ifdef CONFIG_EVENT_MANAGER_MEM_SLAB
+#define _EVENT_TYPE_MEM_SLAB_DEFINE(ename, init_log_en, log_fn, ev_info_struct, slab_cnt)	\
+	_EVENT_MEM_SLAB_DEFINE(_EVENT_MEM_SLAB_NAME(ename), sizeof(struct ename), slab_cnt);	\
+	static atomic_t _EVENT_MEM_SLAB_MAX_USED_NAME(ename);					\
+	_EVENT_TYPE_DEFINE_COMMON(ename, init_log_en, log_fn, ev_info_struct,			\
+				  _EVENT_MEM_SLAB_INIT(&_EVENT_MEM_SLAB_NAME(ename),		\
+						       &_EVENT_MEM_SLAB_MAX_USED_NAME(ename)))
+#else
+#define _EVENT_TYPE_MEM_SLAB_DEFINE(ename, init_log_en, log_fn, ev_info_struct, slab_cnt)	\
+	_EVENT_TYPE_DEFINE(ename, init_log_en, log_fn, ev_info_struct)
+#endif
+
+
+#define _EVENT_TYPE_DEFINE_COMMON(ename, init_log_en, log_fn, ev_info_struct, mem_slab_init)			\
 	_EVENT_SUBSCRIBERS_DEFINE(ename);										\
+	_EVENT_STATS_DEFINE(event_type_stats, type_, ename);								\
 	const struct event_type _CONCAT(__event_type_, ename) __used							\
 	__attribute__((__section__("event_types"))) = {									\
 		.name				= STRINGIFY(ename),							\
@@ -239,6 +331,8 @@ extern "C" {
 		.init_log_enable		= init_log_en,								\
 		.log_event			= log_fn,								\
 		.ev_info			= ev_info_struct,							\
+		mem_slab_init												\
+		_EVENT_STATS_INIT(type_, ename)										\
 	}
 
 
@@ -89,6 +89,119 @@ static int show_subscribers(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+#ifdef CONFIG_EVENT_MANAGER_MEM_SLAB
+static int show_mem_slabs(const struct shell *shell, size_t argc,
+			  char **argv)
+{
+	shell_fprintf(shell, SHELL_NORMAL, "Event memory slabs:\n");
+	for (const struct event_type *et = __start_event_types;
+	     (et != NULL) && (et != __stop_event_types);
+	     et++) {
+
+		if (!et->mem_slab) {
+			continue;
+		}
+
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "|\t[E:%s] used: %u/%u max used: %u\n",
+			      et->name,
+			      k_mem_slab_num_used_get(et->mem_slab),
+			      et->mem_slab->num_blocks,
+			      (uint32_t)atomic_get(et->mem_slab_max_used));
+	}
+
+	return 0;
+}
+#endif /* CONFIG_EVENT_MANAGER_MEM_SLAB */
+
+#ifdef CONFIG_EVENT_MANAGER_STATS
+static void show_listener_hist(const struct shell *shell,
+			       const struct event_listener_stats *stats)
+{
+	for (size_t i = 0; i < EVENT_MANAGER_STATS_HIST_LEN; i++) {
+		uint32_t cnt = atomic_get(&stats->time_hist[i]);
+
+		if (cnt == 0) {
+			continue;
+		}
+
+		if (i < (EVENT_MANAGER_STATS_HIST_LEN - 1)) {
+			shell_fprintf(shell, SHELL_NORMAL,
+				      "|\t\t< %u us: %u\n", BIT(i + 1), cnt);
+		} else {
+			shell_fprintf(shell, SHELL_NORMAL,
+				      "|\t\t>= %u us: %u\n", BIT(i), cnt);
+		}
+	}
+}
+
+static int show_stats(const struct shell *shell, size_t argc, char **argv)
+{
+	static const char * const queue_names[] = {
+		[EVENT_QUEUE_DEFAULT] = "default",
+		[EVENT_QUEUE_REALTIME] = "realtime",
+		[EVENT_QUEUE_BULK] = "bulk",
+	};
+
+	shell_fprintf(shell, SHELL_NORMAL, "Event statistics:\n");
+	for (const struct event_type *et = __start_event_types;
+	     (et != NULL) && (et != __stop_event_types);
+	     et++) {
+
+		const struct event_type_stats *stats = et->stats;
+		uint32_t processed = stats->processed;
+
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "|\t[E:%s] submitted: %u processed: %u "
+			      "consumed: %u latency avg: %u us max: %u us\n",
+			      et->name,
+			      (uint32_t)atomic_get(&stats->submitted),
+			      processed,
+			      stats->consumed,
+			      processed ?
+				(uint32_t)(stats->latency_sum_us / processed) : 0,
+			      stats->latency_max_us);
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL, "Listener statistics:\n");
+	for (const struct event_listener *el = __start_event_listeners;
+	     el != __stop_event_listeners;
+	     el++) {
+
+		__ASSERT_NO_MSG(el != NULL);
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "|\t[L:%s] calls: %u max: %u us\n",
+			      el->name,
+			      (uint32_t)atomic_get(&el->stats->calls),
+			      (uint32_t)atomic_get(&el->stats->time_max_us));
+		show_listener_hist(shell, el->stats);
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL, "Queue statistics:\n");
+	for (size_t i = 0; i < ARRAY_SIZE(queue_names); i++) {
+		struct event_queue_stats stats;
+
+		if (event_manager_queue_stats_get(i, &stats)) {
+			continue;
+		}
+
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "|\t[Q:%s] depth: %u max depth: %u\n",
+			      queue_names[i], stats.depth, stats.depth_max);
+	}
+
+	return 0;
+}
+
+static int reset_stats(const struct shell *shell, size_t argc, char **argv)
+{
+	event_manager_stats_reset();
+	shell_fprintf(shell, SHELL_NORMAL, "Event statistics reset\n");
+
+	return 0;
+}
+#endif /* CONFIG_EVENT_MANAGER_STATS */
+
 static void set_event_displaying(const struct shell *shell, size_t argc,
 				 char **argv, bool enable)
 {
@@ -168,6 +281,15 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_event_manager,
 	SHELL_CMD_ARG(show_subscribers, NULL, "Show subscribers",
 		      show_subscribers, 0, 0),
 	SHELL_CMD_ARG(show_events, NULL, "Show events", show_events, 0, 0),
+#ifdef CONFIG_EVENT_MANAGER_MEM_SLAB
+	SHELL_CMD_ARG(show_mem_slabs, NULL, "Show event memory slabs usage",
+		      show_mem_slabs, 0, 0),
+#endif
+#ifdef CONFIG_EVENT_MANAGER_STATS
+	SHELL_CMD_ARG(stats, NULL, "Show event statistics", show_stats, 0, 0),
+	SHELL_CMD_ARG(stats_reset, NULL, "Reset event statistics",
+		      reset_stats, 0, 0),
+#endif
 	SHELL_CMD_ARG(disable, NULL, "Disable displaying event with given ID",
 		      disable_event_displaying, 0,
 		      sizeof(event_manager_displayed_events) * 8 - 1),
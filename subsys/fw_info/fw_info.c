@@ -81,18 +81,34 @@ static const struct fw_info_ext_api_request *skip_ext_apis(
 
 
 #ifdef CONFIG_EXT_API_PROVIDE_EXT_API_UNUSED
-static const struct fw_info_ext_api *find_ext_api(
-		const struct fw_info_ext_api_request *ext_api_req,
+/* Find the images that can provide EXT_APIs. Returns the number of images
+ * placed in @p images, in the order they are listed in .fw_info_images.
+ */
+static uint32_t find_images(const struct fw_info **images,
 		const struct fw_info * const skip_fw_info)
 {
+	uint32_t num_images = 0;
+
 	for (uint32_t i = 0; i < (uint32_t)_fw_info_images_size; i++) {
 		const struct fw_info *fw_info =
 				fw_info_find(_fw_info_images_start[i]);
 
 		if (!fw_info || (fw_info->valid != CONFIG_FW_INFO_VALID_VAL)
-		    || (fw_info == skip_fw_info)) {
+		    || (fw_info == skip_fw_info) || !fw_info->ext_api_num) {
 			continue;
 		}
+		images[num_images++] = fw_info;
+	}
+	return num_images;
+}
+
+
+static const struct fw_info_ext_api *find_ext_api(
+		const struct fw_info_ext_api_request *ext_api_req,
+		const struct fw_info **images, uint32_t num_images)
+{
+	for (uint32_t i = 0; i < num_images; i++) {
+		const struct fw_info *fw_info = images[i];
 		const struct fw_info_ext_api *ext_api = &fw_info->ext_apis[0];
 
 		for (uint32_t j = 0; j < fw_info->ext_api_num; j++) {
@@ -119,10 +135,13 @@ bool fw_info_ext_api_provide(const struct fw_info *fw_info, bool provide)
 
 	const struct fw_info_ext_api_request *ext_api_req =
 				skip_ext_apis(fw_info);
+	/* The images are searched for their fw_info once, not per request. */
+	const struct fw_info *images[(uint32_t)_fw_info_images_size];
+	const uint32_t num_images = find_images(images, fw_info);
 
 	for (uint32_t i = 0; i < fw_info->ext_api_request_num; i++) {
 		const struct fw_info_ext_api *new_ext_api =
-				 find_ext_api(ext_api_req, fw_info);
+				 find_ext_api(ext_api_req, images, num_images);
 
 		if (provide) {
 			/* Provide ext_api, or NULL. */
@@ -31,12 +31,19 @@ struct firmware_packet {
 	uint8_t data[SMP_PACKET_MTU];
 	uint32_t target_address;
 	uint32_t data_len;
+	uint32_t offset;
 };
 
-static int unpack(struct mgmt_ctxt *ctxt, struct firmware_packet *packet,
-		  bool *whole_file_received)
+/* Kept out of the stack, as the packet can be as large as the SMP frame. */
+static struct firmware_packet packet;
+
+/* State of the file being uploaded. */
+static uint32_t file_length;
+static uint32_t expected_offset;
+static int64_t file_start_time;
+
+static int unpack(struct mgmt_ctxt *ctxt, struct firmware_packet *packet)
 {
-	static uint32_t file_length;
 	/*
 	 * These data types are long long so that we don't have to typecast
 	 * and get compiler warnings when using them as assign data in
@@ -96,16 +103,15 @@ static int unpack(struct mgmt_ctxt *ctxt, struct firmware_packet *packet,
 
 	if (offset == 0) {
 		file_length = (uint32_t)read_file_length;
+		expected_offset = 0;
+		file_start_time = k_uptime_get();
 	}
 
 	packet->target_address  = (uint32_t)fw_target_address;
 	packet->data_len = (uint32_t)data_len;
-	uint32_t new_offset = (uint32_t)offset + packet->data_len;
-	*whole_file_received = (((uint32_t)offset + packet->data_len)
-				== file_length);
-	LOG_INF("Writing %d/%d bytes", new_offset, file_length);
+	packet->offset = (uint32_t)offset;
 
-	return offset + packet->data_len;
+	return 0;
 }
 
 static int get_mgmt_err_from_modem_ret_err(int err)
@@ -146,15 +152,27 @@ static int fmfu_firmware_upload(struct mgmt_ctxt *ctx)
 
 	int rc;
 	bool whole_file_received;
-	struct firmware_packet packet;
-	uint32_t next_expected_offset;
+	int64_t write_start_time;
 
-	rc = unpack(ctx, &packet, &whole_file_received);
+	rc = unpack(ctx, &packet);
 	if (rc < 0) {
 		return rc;
 	}
 
-	next_expected_offset = rc;
+	/* The client can send several chunks without waiting for responses.
+	 * A chunk that does not start at the expected offset, for example
+	 * after a lost or repeated chunk, is dropped. The response tells the
+	 * client where to continue from.
+	 */
+	if (packet.offset != expected_offset) {
+		LOG_DBG("Dropped chunk at offset 0x%x, expected 0x%x",
+			packet.offset, expected_offset);
+		fmfu_mgmt_stat_chunk_dropped();
+		return encode_response(ctx, expected_offset);
+	}
+
+	whole_file_received = (packet.offset + packet.data_len) == file_length;
+	write_start_time = k_uptime_get();
 
 	if (packet.data_len > 0) {
 		if (bootloader) {
@@ -165,8 +183,8 @@ static int fmfu_firmware_upload(struct mgmt_ctxt *ctx)
 				return get_mgmt_err_from_modem_ret_err(rc);
 			}
 		} else {
-			LOG_DBG("next_offset: 0x%x, target_address: 0x%x,"
-				"packet len: %d", next_expected_offset,
+			LOG_DBG("offset: 0x%x, target_address: 0x%x,"
+				"packet len: %d", packet.offset,
 						  packet.target_address,
 						  packet.data_len);
 
@@ -182,6 +200,11 @@ static int fmfu_firmware_upload(struct mgmt_ctxt *ctx)
 		}
 	}
 
+	expected_offset += packet.data_len;
+	fmfu_mgmt_stat_chunk_written(packet.data_len,
+				     k_uptime_get() - write_start_time);
+	LOG_INF("Writing %d/%d bytes", expected_offset, file_length);
+
 	if (whole_file_received) {
 		rc = nrf_modem_full_dfu_apply();
 		if (rc != 0) {
@@ -189,9 +212,11 @@ static int fmfu_firmware_upload(struct mgmt_ctxt *ctx)
 			return get_mgmt_err_from_modem_ret_err(rc);
 		}
 		bootloader = false;
+		fmfu_mgmt_stat_file_written(file_length,
+					    k_uptime_get() - file_start_time);
 	}
 
-	return encode_response(ctx, next_expected_offset);
+	return encode_response(ctx, expected_offset);
 }
 
 static int fmfu_get_memory_hash(struct mgmt_ctxt *ctxt)
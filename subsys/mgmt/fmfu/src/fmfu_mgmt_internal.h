@@ -29,6 +29,22 @@ extern "C" {
  */
 #define SMP_UART_BUFFER_SIZE CONFIG_UART_MCUMGR_RX_BUF_SIZE
 
+/*
+ * Number of requests the SMP UART transport can receive while the previous
+ * one is processed. The client can send that many upload chunks without
+ * waiting for responses.
+ */
+#ifdef CONFIG_UART_MCUMGR_RX_BUF_COUNT
+#define SMP_UPLOAD_WINDOW CONFIG_UART_MCUMGR_RX_BUF_COUNT
+#else
+#define SMP_UPLOAD_WINDOW 1
+#endif
+
+/* Update the upload statistics. */
+void fmfu_mgmt_stat_chunk_written(uint32_t len, uint32_t write_time_ms);
+void fmfu_mgmt_stat_chunk_dropped(void);
+void fmfu_mgmt_stat_file_written(uint32_t len, uint32_t upload_time_ms);
+
 #ifdef __cplusplus
 }
 #endif
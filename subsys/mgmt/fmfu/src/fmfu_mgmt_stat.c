@@ -15,17 +15,57 @@
 STATS_SECT_START(smp_com_param)
 STATS_SECT_ENTRY(frame_max)
 STATS_SECT_ENTRY(pack_max)
+STATS_SECT_ENTRY(win_max)
 STATS_SECT_END;
 
 /* Assign a name to each stat. */
 STATS_NAME_START(smp_com_param)
 STATS_NAME(smp_com_param, frame_max)
 STATS_NAME(smp_com_param, pack_max)
+STATS_NAME(smp_com_param, win_max)
 STATS_NAME_END(smp_com_param);
 
 /* Define an instance of the stats group. */
 STATS_SECT_DECL(smp_com_param) smp_com_param;
 
+STATS_SECT_START(fmfu_upload)
+STATS_SECT_ENTRY(bytes)
+STATS_SECT_ENTRY(chunks)
+STATS_SECT_ENTRY(dropped)
+STATS_SECT_ENTRY(write_ms)
+STATS_SECT_ENTRY(rate)
+STATS_SECT_END;
+
+STATS_NAME_START(fmfu_upload)
+STATS_NAME(fmfu_upload, bytes)
+STATS_NAME(fmfu_upload, chunks)
+STATS_NAME(fmfu_upload, dropped)
+STATS_NAME(fmfu_upload, write_ms)
+STATS_NAME(fmfu_upload, rate)
+STATS_NAME_END(fmfu_upload);
+
+STATS_SECT_DECL(fmfu_upload) fmfu_upload;
+
+void fmfu_mgmt_stat_chunk_written(uint32_t len, uint32_t write_time_ms)
+{
+	STATS_INCN(fmfu_upload, bytes, len);
+	STATS_INC(fmfu_upload, chunks);
+	STATS_INCN(fmfu_upload, write_ms, write_time_ms);
+}
+
+void fmfu_mgmt_stat_chunk_dropped(void)
+{
+	STATS_INC(fmfu_upload, dropped);
+}
+
+void fmfu_mgmt_stat_file_written(uint32_t len, uint32_t upload_time_ms)
+{
+	/* Upload rate of the last file, in bytes per second. */
+	STATS_CLEAR(fmfu_upload, rate);
+	STATS_INCN(fmfu_upload, rate,
+		   (uint64_t)len * MSEC_PER_SEC / MAX(upload_time_ms, 1));
+}
+
 int fmfu_mgmt_stat_init(void)
 {
 	/* Register/start the stat service */
@@ -35,6 +75,11 @@ int fmfu_mgmt_stat_init(void)
 
 	STATS_INCN(smp_com_param, frame_max, SMP_UART_BUFFER_SIZE);
 	STATS_INCN(smp_com_param, pack_max, SMP_PACKET_MTU);
+	STATS_INCN(smp_com_param, win_max, SMP_UPLOAD_WINDOW);
+
+	if (rc == 0) {
+		rc = STATS_INIT_AND_REG(fmfu_upload, STATS_SIZE_32, "fmfu");
+	}
 
 	return rc;
 }
@@ -18,6 +18,7 @@
 #include <stdint.h>
 
 #include <device.h>
+#include <irq.h>
 #include <drivers/gpio.h>
 
 #include "hal/nrf_gpio.h"
@@ -36,6 +37,11 @@ static gpio_port_value_t    pri_pin_mask;
 static gpio_port_value_t    gra_pin_mask;
 static struct gpio_callback grant_cb;
 
+#if IS_ENABLED(CONFIG_MPSL_CX_THREAD_STATS)
+static struct mpsl_cx_thread_stats stats;
+static bool requested;
+#endif
+
 static int32_t grant_pin_is_asserted(bool *is_asserted)
 {
 	int ret;
@@ -99,6 +105,15 @@ static void gpiote_irq_handler(const struct device *gpiob, struct gpio_callback
 		}
 
 		if (granted_ops != last_notified) {
+#if IS_ENABLED(CONFIG_MPSL_CX_THREAD_STATS)
+			if (requested) {
+				if (granted_ops & MPSL_CX_OP_TX) {
+					stats.granted++;
+				} else {
+					stats.denied++;
+				}
+			}
+#endif
 			last_notified = granted_ops;
 			callback(granted_ops);
 		}
@@ -170,7 +185,9 @@ static int32_t request(const mpsl_cx_request_t *req_params)
 		return -NRF_EPERM;
 	}
 
-	if (req_params->ops & (MPSL_CX_OP_RX | MPSL_CX_OP_TX)) {
+	bool request_asserted = req_params->ops & (MPSL_CX_OP_RX | MPSL_CX_OP_TX);
+
+	if (request_asserted) {
 		ret = gpio_port_set_clr_bits_raw(req_dev, req_pin_mask, 0);
 	} else {
 		ret = gpio_port_set_clr_bits_raw(req_dev, 0, req_pin_mask);
@@ -180,6 +197,13 @@ static int32_t request(const mpsl_cx_request_t *req_params)
 		return -NRF_EPERM;
 	}
 
+#if IS_ENABLED(CONFIG_MPSL_CX_THREAD_STATS)
+	if (request_asserted && !requested) {
+		stats.requests++;
+	}
+	requested = request_asserted;
+#endif
+
 	return 0;
 }
 
@@ -197,12 +221,16 @@ static int32_t release(void)
 		return -NRF_EPERM;
 	}
 
+#if IS_ENABLED(CONFIG_MPSL_CX_THREAD_STATS)
+	requested = false;
+#endif
+
 	return 0;
 }
 
 static uint32_t req_grant_delay_get(void)
 {
-	return REQUEST_TO_GRANT_US;
+	return REQUEST_TO_GRANT_US + CONFIG_MPSL_CX_THREAD_REQUEST_GUARD_US;
 }
 
 static int32_t register_callback(mpsl_cx_cb_t cb)
@@ -220,6 +248,16 @@ static const mpsl_cx_interface_t m_mpsl_cx_methods = {
 	.p_register_callback   = register_callback,
 };
 
+#if IS_ENABLED(CONFIG_MPSL_CX_THREAD_STATS)
+void mpsl_cx_thread_stats_get(struct mpsl_cx_thread_stats *out)
+{
+	unsigned int key = irq_lock();
+
+	*out = stats;
+	irq_unlock(key);
+}
+#endif
+
 int32_t mpsl_cx_thread_interface_config_set(
 		struct mpsl_cx_thread_interface_config const * const new_config)
 {
@@ -228,6 +266,11 @@ int32_t mpsl_cx_thread_interface_config_set(
 	config = *new_config;
 	callback = NULL;
 
+#if IS_ENABLED(CONFIG_MPSL_CX_THREAD_STATS)
+	stats = (struct mpsl_cx_thread_stats){ 0 };
+	requested = false;
+#endif
+
 	ret_code = mpsl_cx_interface_set(&m_mpsl_cx_methods);
 	if (ret_code != 0) {
 		return ret_code;
@@ -177,6 +177,10 @@ static int fem_nrf21540_gpio_configure(void)
 	}
 #endif
 
+	/* The timings and gains are devicetree constants, so this
+	 * configuration is fixed at build time and passed to MPSL once. MPSL
+	 * applies it to each radio event itself.
+	 */
 	mpsl_fem_nrf21540_gpio_interface_config_t cfg = {
 		.fem_config = {
 			.pa_time_gap_us  =
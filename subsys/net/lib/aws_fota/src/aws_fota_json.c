@@ -6,22 +6,326 @@
 
 #include <zephyr.h>
 #include <string.h>
-#include <cJSON.h>
+#include <stdlib.h>
 #include <sys/util.h>
 #include <net/aws_jobs.h>
 
 #include "aws_fota_json.h"
 
-/**@brief Copy max maxlen bytes from src to dst. Insert null-terminator.
+/* The job documents are parsed in place, without building a tree.
+ * The parser walks the document once and records where the values of
+ * the fields of interest are. The values are copied to the output
+ * buffers afterwards.
  */
-static void strncpy_nullterm(char *dst, const char *src, size_t maxlen)
+
+/* Maximum nesting of objects and arrays in a parsed document. */
+#define JSON_MAX_DEPTH 8
+
+/* Parent index of the fields in the top-level object. */
+#define FIELD_ROOT -1
+/* Index of the fields that are not of interest. */
+#define FIELD_NONE -2
+
+enum json_type {
+	JSON_TYPE_NONE,
+	JSON_TYPE_STRING,
+	JSON_TYPE_PRIMITIVE,
+	JSON_TYPE_OBJECT,
+	JSON_TYPE_ARRAY,
+};
+
+struct json_field {
+	/* Key of the field. */
+	const char *key;
+	/* Index of the field of the enclosing object. */
+	int8_t parent;
+	/* Type of the value found in the document. */
+	enum json_type type;
+	/* Value in the document. Strings are still escaped. */
+	const char *value;
+	size_t len;
+};
+
+struct json_lexer {
+	const char *pos;
+	const char *end;
+};
+
+static void skip_ws(struct json_lexer *lex)
+{
+	while (lex->pos < lex->end &&
+	       (*lex->pos == ' ' || *lex->pos == '\t' ||
+		*lex->pos == '\r' || *lex->pos == '\n')) {
+		lex->pos++;
+	}
+}
+
+/**@brief Scan a string. Escapes are skipped, not decoded.
+ */
+static int scan_string(struct json_lexer *lex, const char **str, size_t *len)
+{
+	/* Skip the opening quote. */
+	const char *start = ++lex->pos;
+
+	while (lex->pos < lex->end) {
+		if (*lex->pos == '"') {
+			*str = start;
+			*len = lex->pos - start;
+			lex->pos++;
+			return 0;
+		}
+		if (*lex->pos == '\\') {
+			lex->pos++;
+		}
+		lex->pos++;
+	}
+
+	return -ENODATA;
+}
+
+/**@brief Scan a number, true, false or null.
+ */
+static int scan_primitive(struct json_lexer *lex, const char **str, size_t *len)
 {
-	size_t len = strlen(src) + 1;
+	const char *start = lex->pos;
+
+	while (lex->pos < lex->end &&
+	       (*lex->pos == '-' || *lex->pos == '+' || *lex->pos == '.' ||
+		(*lex->pos >= '0' && *lex->pos <= '9') ||
+		(*lex->pos >= 'a' && *lex->pos <= 'z') ||
+		(*lex->pos >= 'A' && *lex->pos <= 'Z'))) {
+		lex->pos++;
+	}
 
-	memcpy(dst, src, MIN(len, maxlen));
-	if (len > maxlen) {
-		dst[maxlen - 1] = '\0';
+	if (lex->pos == start) {
+		return -ENODATA;
 	}
+
+	*str = start;
+	*len = lex->pos - start;
+
+	return 0;
+}
+
+static int8_t field_find(struct json_field *fields, size_t count,
+			 int8_t parent, const char *key, size_t len)
+{
+	if (parent == FIELD_NONE) {
+		return FIELD_NONE;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (fields[i].parent == parent &&
+		    strlen(fields[i].key) == len &&
+		    !memcmp(fields[i].key, key, len)) {
+			return i;
+		}
+	}
+
+	return FIELD_NONE;
+}
+
+/**@brief Walk a JSON document and record the values of the given fields.
+ *
+ * @return 0 if the document is well-formed, otherwise -ENODATA.
+ */
+static int json_walk(const char *doc, size_t doc_len,
+		     struct json_field *fields, size_t count)
+{
+	enum { EXPECT_VALUE, EXPECT_KEY, EXPECT_COLON, EXPECT_NEXT } state;
+	struct json_lexer lex = {
+		.pos = doc,
+		.end = doc + strnlen(doc, doc_len),
+	};
+	/* Field of each open object or array. */
+	int8_t node[JSON_MAX_DEPTH];
+	bool array[JSON_MAX_DEPTH];
+	size_t depth = 0;
+	/* Field the next value belongs to. */
+	int8_t field = FIELD_ROOT;
+	/* An object or array was just opened and may be closed right away. */
+	bool empty = false;
+	const char *str;
+	size_t len;
+
+	state = EXPECT_VALUE;
+
+	for (;;) {
+		skip_ws(&lex);
+		if (lex.pos == lex.end) {
+			return -ENODATA;
+		}
+
+		switch (state) {
+		case EXPECT_VALUE:
+			if (empty && *lex.pos == ']') {
+				break;
+			}
+			empty = false;
+
+			if (*lex.pos == '{' || *lex.pos == '[') {
+				if (depth == JSON_MAX_DEPTH) {
+					return -ENODATA;
+				}
+				array[depth] = (*lex.pos == '[');
+				/* Fields are only looked for in objects. */
+				node[depth] = array[depth] ? FIELD_NONE : field;
+				if (field >= 0) {
+					fields[field].type = array[depth] ?
+						JSON_TYPE_ARRAY : JSON_TYPE_OBJECT;
+				}
+				depth++;
+				lex.pos++;
+				empty = true;
+				if (array[depth - 1]) {
+					field = FIELD_NONE;
+				} else {
+					state = EXPECT_KEY;
+				}
+				continue;
+			}
+
+			if (*lex.pos == '"') {
+				if (scan_string(&lex, &str, &len)) {
+					return -ENODATA;
+				}
+				if (field >= 0) {
+					fields[field].type = JSON_TYPE_STRING;
+				}
+			} else {
+				if (scan_primitive(&lex, &str, &len)) {
+					return -ENODATA;
+				}
+				if (field >= 0) {
+					fields[field].type = JSON_TYPE_PRIMITIVE;
+				}
+			}
+
+			if (field >= 0) {
+				fields[field].value = str;
+				fields[field].len = len;
+			}
+
+			if (depth == 0) {
+				/* Only a single top-level value. */
+				return 0;
+			}
+			state = EXPECT_NEXT;
+			continue;
+
+		case EXPECT_KEY:
+			if (empty && *lex.pos == '}') {
+				break;
+			}
+			empty = false;
+
+			if (*lex.pos != '"' || scan_string(&lex, &str, &len)) {
+				return -ENODATA;
+			}
+			field = field_find(fields, count, node[depth - 1],
+					   str, len);
+			state = EXPECT_COLON;
+			continue;
+
+		case EXPECT_COLON:
+			if (*lex.pos != ':') {
+				return -ENODATA;
+			}
+			lex.pos++;
+			state = EXPECT_VALUE;
+			continue;
+
+		case EXPECT_NEXT:
+			if (*lex.pos == ',') {
+				lex.pos++;
+				if (array[depth - 1]) {
+					field = FIELD_NONE;
+					state = EXPECT_VALUE;
+				} else {
+					state = EXPECT_KEY;
+				}
+				continue;
+			}
+			break;
+
+		default:
+			return -ENODATA;
+		}
+
+		/* Closing an object or an array. */
+		if (*lex.pos != (array[depth - 1] ? ']' : '}')) {
+			return -ENODATA;
+		}
+		lex.pos++;
+		empty = false;
+		depth--;
+		if (depth == 0) {
+			return 0;
+		}
+		state = EXPECT_NEXT;
+	}
+}
+
+/**@brief Copy a JSON string value to dst, decoding escapes.
+ *	  Copy max maxlen bytes, including the null-terminator.
+ */
+static int json_string_copy(char *dst, const struct json_field *field,
+			    size_t maxlen)
+{
+	const char *src = field->value;
+	const char *end = field->value + field->len;
+	size_t len = 0;
+
+	while (src < end && len < maxlen - 1) {
+		char c = *src++;
+
+		if (c == '\\') {
+			switch (*src++) {
+			case 'b':
+				c = '\b';
+				break;
+			case 'f':
+				c = '\f';
+				break;
+			case 'n':
+				c = '\n';
+				break;
+			case 'r':
+				c = '\r';
+				break;
+			case 't':
+				c = '\t';
+				break;
+			case 'u': {
+				char hex[5] = { 0 };
+				unsigned long code;
+
+				if (end - src < 4) {
+					return -ENODATA;
+				}
+				memcpy(hex, src, 4);
+				code = strtoul(hex, NULL, 16);
+				/* Only ASCII characters are expected in the fields. */
+				if (code == 0 || code > 0x7F) {
+					return -ENODATA;
+				}
+				c = (char)code;
+				src += 4;
+				break;
+			}
+			default:
+				/* Quote, backslash and slash. */
+				c = src[-1];
+				break;
+			}
+		}
+
+		dst[len++] = c;
+	}
+
+	dst[len] = '\0';
+
+	return 0;
 }
 
 int aws_fota_parse_UpdateJobExecution_rsp(const char *update_rsp_document,
@@ -31,29 +335,20 @@ int aws_fota_parse_UpdateJobExecution_rsp(const char *update_rsp_document,
 		return -EINVAL;
 	}
 
-	int ret;
+	struct json_field fields[] = {
+		{ .key = "status", .parent = FIELD_ROOT },
+	};
 
-	cJSON *update_response = cJSON_Parse(update_rsp_document);
-
-	if (update_response == NULL) {
-		ret = -ENODATA;
-		goto cleanup;
+	if (json_walk(update_rsp_document, payload_len,
+		      fields, ARRAY_SIZE(fields))) {
+		return -ENODATA;
 	}
 
-	cJSON *status = cJSON_GetObjectItemCaseSensitive(update_response,
-							  "status");
-	if (cJSON_IsString(status) && status->valuestring != NULL) {
-		strncpy_nullterm(status_buf, status->valuestring,
-				 STATUS_MAX_LEN);
-	} else {
-		ret = -ENODATA;
-		goto cleanup;
+	if (fields[0].type != JSON_TYPE_STRING) {
+		return -ENODATA;
 	}
 
-	ret = 0;
-cleanup:
-	cJSON_Delete(update_response);
-	return ret;
+	return json_string_copy(status_buf, &fields[0], STATUS_MAX_LEN);
 }
 
 int aws_fota_parse_DescribeJobExecution_rsp(const char *job_document,
@@ -71,74 +366,71 @@ int aws_fota_parse_DescribeJobExecution_rsp(const char *job_document,
 		return -EINVAL;
 	}
 
-	int ret;
-
-	cJSON *json_data = cJSON_Parse(job_document);
+	enum {
+		EXECUTION,
+		JOB_ID,
+		VERSION_NUMBER,
+		JOB_DOCUMENT,
+		LOCATION,
+		HOST,
+		PATH,
+	};
+	struct json_field fields[] = {
+		[EXECUTION] = { .key = "execution", .parent = FIELD_ROOT },
+		[JOB_ID] = { .key = "jobId", .parent = EXECUTION },
+		[VERSION_NUMBER] = { .key = "versionNumber",
+				     .parent = EXECUTION },
+		[JOB_DOCUMENT] = { .key = "jobDocument", .parent = EXECUTION },
+		[LOCATION] = { .key = "location", .parent = JOB_DOCUMENT },
+		[HOST] = { .key = "host", .parent = LOCATION },
+		[PATH] = { .key = "path", .parent = LOCATION },
+	};
+	int err;
 
-	if (json_data == NULL) {
-		ret = -ENODATA;
-		goto cleanup;
+	if (json_walk(job_document, payload_len, fields, ARRAY_SIZE(fields))) {
+		return -ENODATA;
 	}
 
-	cJSON *execution = cJSON_GetObjectItemCaseSensitive(json_data,
-							    "execution");
-	if (execution == NULL) {
-		ret = 0;
-		goto cleanup;
+	if (fields[EXECUTION].type == JSON_TYPE_NONE) {
+		return 0;
 	}
 
-	cJSON *job_id = cJSON_GetObjectItemCaseSensitive(execution, "jobId");
-
-	if (cJSON_GetStringValue(job_id) != NULL) {
-		strncpy_nullterm(job_id_buf, job_id->valuestring,
-				AWS_JOBS_JOB_ID_MAX_LEN);
-	} else {
-		ret = -ENODATA;
-		goto cleanup;
+	if (fields[JOB_ID].type != JSON_TYPE_STRING ||
+	    fields[LOCATION].type != JSON_TYPE_OBJECT ||
+	    fields[HOST].type != JSON_TYPE_STRING ||
+	    fields[PATH].type != JSON_TYPE_STRING ||
+	    fields[VERSION_NUMBER].type != JSON_TYPE_PRIMITIVE) {
+		return -ENODATA;
 	}
 
-	cJSON *job_data = cJSON_GetObjectItemCaseSensitive(execution,
-							   "jobDocument");
-
-	if (!cJSON_IsObject(job_data)) {
-		ret = -ENODATA;
-		goto cleanup;
+	/* Primitive must be a number, not true, false or null. */
+	if (fields[VERSION_NUMBER].value[0] != '-' &&
+	    (fields[VERSION_NUMBER].value[0] < '0' ||
+	     fields[VERSION_NUMBER].value[0] > '9')) {
+		return -ENODATA;
 	}
 
-	cJSON *location = cJSON_GetObjectItemCaseSensitive(job_data,
-							    "location");
-
-	if (!cJSON_IsObject(location)) {
-		ret = -ENODATA;
-		goto cleanup;
+	err = json_string_copy(job_id_buf, &fields[JOB_ID],
+			       AWS_JOBS_JOB_ID_MAX_LEN);
+	if (err) {
+		return err;
 	}
 
-	cJSON *hostname = cJSON_GetObjectItemCaseSensitive(location, "host");
-	cJSON *path = cJSON_GetObjectItemCaseSensitive(location, "path");
-
-	if ((cJSON_GetStringValue(hostname) != NULL)
-	   && (cJSON_GetStringValue(path) != NULL)) {
-		strncpy_nullterm(hostname_buf, hostname->valuestring,
-				CONFIG_AWS_FOTA_HOSTNAME_MAX_LEN);
-		strncpy_nullterm(file_path_buf, path->valuestring,
-				CONFIG_AWS_FOTA_FILE_PATH_MAX_LEN);
-	} else {
-		ret = -ENODATA;
-		goto cleanup;
+	err = json_string_copy(hostname_buf, &fields[HOST],
+			       CONFIG_AWS_FOTA_HOSTNAME_MAX_LEN);
+	if (err) {
+		return err;
 	}
 
-	cJSON *version_number = cJSON_GetObjectItemCaseSensitive(
-					execution, "versionNumber");
-
-	if (cJSON_IsNumber(version_number)) {
-		*execution_version_number = version_number->valueint;
-	} else {
-		ret = -ENODATA;
-		goto cleanup;
+	err = json_string_copy(file_path_buf, &fields[PATH],
+			       CONFIG_AWS_FOTA_FILE_PATH_MAX_LEN);
+	if (err) {
+		return err;
 	}
 
-	ret = 1;
-cleanup:
-	cJSON_Delete(json_data);
-	return ret;
+	/* The value is followed by a delimiter, so strtol() stops in time. */
+	*execution_version_number = (int)strtol(fields[VERSION_NUMBER].value,
+						NULL, 10);
+
+	return 1;
 }
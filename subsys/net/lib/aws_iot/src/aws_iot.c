@@ -138,6 +138,20 @@ static struct aws_iot_suback_confirmation {
 
 static K_SEM_DEFINE(connection_poll_sem, 0, 1);
 
+#if defined(CONFIG_AWS_IOT_PUBLISH_WINDOW)
+/* QoS 1 message waiting for PUBACK. The topic and the payload are stored
+ * back to back in a single allocation.
+ */
+static struct pub_window_entry {
+	uint16_t message_id;
+	uint16_t topic_len;
+	size_t payload_len;
+	uint8_t *buf;
+} pub_window[CONFIG_AWS_IOT_PUBLISH_WINDOW_SIZE];
+
+static K_MUTEX_DEFINE(pub_window_lock);
+#endif /* defined(CONFIG_AWS_IOT_PUBLISH_WINDOW) */
+
 static int connect_error_translate(const int err)
 {
 	switch (err) {
@@ -290,6 +304,9 @@ static void aws_iot_notify_event(const struct aws_iot_evt *aws_iot_evt)
 		cloud_evt.data.fota_progress =
 				aws_iot_evt->data.fota_progress;
 		break;
+	case AWS_IOT_EVT_PUBACK:
+		cloud_evt.type = CLOUD_EVT_DATA_SENT;
+		break;
 	default:
 		LOG_ERR("Unknown AWS IoT event");
 		break;
@@ -637,6 +654,111 @@ clean_exit:
 	return err;
 }
 
+static uint16_t message_id_get(void)
+{
+	static uint16_t message_id;
+
+	/* Message ID 0 is not allowed by the MQTT specification. */
+	if (++message_id == 0) {
+		message_id = 1;
+	}
+
+	return message_id;
+}
+
+#if defined(CONFIG_AWS_IOT_PUBLISH_WINDOW)
+static int pub_window_add(const struct mqtt_publish_param *param)
+{
+	struct pub_window_entry *free_entry = NULL;
+	const struct mqtt_binstr *payload = &param->message.payload;
+	const struct mqtt_utf8 *topic = &param->message.topic.topic;
+
+	if (topic->size > UINT16_MAX) {
+		return -EMSGSIZE;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(pub_window); i++) {
+		if (pub_window[i].buf == NULL) {
+			free_entry = free_entry ? free_entry : &pub_window[i];
+		} else if (pub_window[i].message_id == param->message_id) {
+			LOG_ERR("Message ID %d is already in flight",
+				param->message_id);
+			return -EALREADY;
+		}
+	}
+
+	if (free_entry == NULL) {
+		return -ENOBUFS;
+	}
+
+	free_entry->buf = k_malloc(topic->size + payload->len);
+	if (free_entry->buf == NULL) {
+		return -ENOMEM;
+	}
+
+	memcpy(free_entry->buf, topic->utf8, topic->size);
+	memcpy(free_entry->buf + topic->size, payload->data, payload->len);
+	free_entry->topic_len = topic->size;
+	free_entry->payload_len = payload->len;
+	free_entry->message_id = param->message_id;
+
+	return 0;
+}
+
+/* Release the entry for a message ID. Returns false if it was not tracked. */
+static bool pub_window_release(uint16_t message_id)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(pub_window); i++) {
+		if (pub_window[i].buf != NULL &&
+		    pub_window[i].message_id == message_id) {
+			k_free(pub_window[i].buf);
+			pub_window[i].buf = NULL;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Publish all unacknowledged messages again on a new connection. */
+static void pub_window_resend(void)
+{
+	int err;
+
+	k_mutex_lock(&pub_window_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(pub_window); i++) {
+		struct pub_window_entry *entry = &pub_window[i];
+
+		if (entry->buf == NULL) {
+			continue;
+		}
+
+		struct mqtt_publish_param param = {
+			.message.topic.qos = MQTT_QOS_1_AT_LEAST_ONCE,
+			.message.topic.topic.utf8 = entry->buf,
+			.message.topic.topic.size = entry->topic_len,
+			.message.payload.data = entry->buf + entry->topic_len,
+			.message.payload.len = entry->payload_len,
+			.message_id = entry->message_id,
+			.dup_flag = 1,
+		};
+
+		LOG_DBG("Resending message ID %d", entry->message_id);
+
+		err = mqtt_publish(&client, &param);
+		if (err) {
+			/* Kept for the next connection. */
+			LOG_WRN("Resending message ID %d failed, error: %d",
+				entry->message_id, err);
+			break;
+		}
+	}
+
+	k_mutex_unlock(&pub_window_lock);
+}
+#endif /* defined(CONFIG_AWS_IOT_PUBLISH_WINDOW) */
+
 static int publish_get_payload(struct mqtt_client *const c, size_t length)
 {
 	if (length > sizeof(payload_buf)) {
@@ -686,6 +808,10 @@ static void mqtt_evt_handler(struct mqtt_client *const c,
 		aws_iot_evt.type = AWS_IOT_EVT_CONNECTED;
 		aws_iot_notify_event(&aws_iot_evt);
 
+#if defined(CONFIG_AWS_IOT_PUBLISH_WINDOW)
+		pub_window_resend();
+#endif
+
 		if (!mqtt_evt->param.connack.session_present_flag ||
 		    IS_ENABLED(CONFIG_MQTT_CLEAN_SESSION)) {
 			err = topic_subscribe();
@@ -757,11 +883,26 @@ static void mqtt_evt_handler(struct mqtt_client *const c,
 
 		aws_iot_notify_event(&aws_iot_evt);
 	} break;
-	case MQTT_EVT_PUBACK:
+	case MQTT_EVT_PUBACK: {
+		const uint16_t message_id = mqtt_evt->param.puback.message_id;
+
 		LOG_DBG("MQTT_EVT_PUBACK: id = %d result = %d",
-			mqtt_evt->param.puback.message_id,
-			mqtt_evt->result);
-		break;
+			message_id, mqtt_evt->result);
+
+#if defined(CONFIG_AWS_IOT_PUBLISH_WINDOW)
+		bool released;
+
+		k_mutex_lock(&pub_window_lock, K_FOREVER);
+		released = pub_window_release(message_id);
+		k_mutex_unlock(&pub_window_lock);
+
+		if (released) {
+			aws_iot_evt.type = AWS_IOT_EVT_PUBACK;
+			aws_iot_evt.data.message_id = message_id;
+			aws_iot_notify_event(&aws_iot_evt);
+		}
+#endif
+	} break;
 	case MQTT_EVT_SUBACK:
 		LOG_DBG("MQTT_EVT_SUBACK: id = %d result = %d",
 			mqtt_evt->param.suback.message_id,
@@ -1114,13 +1255,47 @@ int aws_iot_send(const struct aws_iot_data *const tx_data)
 	param.message.topic.topic.size	= tx_data_pub.topic.len;
 	param.message.payload.data	= tx_data_pub.ptr;
 	param.message.payload.len	= tx_data_pub.len;
-	param.message_id		= k_cycle_get_32();
+	param.message_id		= tx_data->message_id ?
+					  tx_data->message_id :
+					  message_id_get();
 	param.dup_flag			= 0;
 	param.retain_flag		= 0;
 
 	LOG_DBG("Publishing to topic: %s",
 		log_strdup(param.message.topic.topic.utf8));
 
+#if defined(CONFIG_AWS_IOT_PUBLISH_WINDOW)
+	if (param.message.topic.qos == MQTT_QOS_1_AT_LEAST_ONCE) {
+		int err;
+
+		k_mutex_lock(&pub_window_lock, K_FOREVER);
+
+		err = pub_window_add(&param);
+		if (err) {
+			k_mutex_unlock(&pub_window_lock);
+			LOG_WRN("Message not added to publish window, error: %d",
+				err);
+			return err;
+		}
+
+		err = mqtt_publish(&client, &param);
+		if (err && atomic_get(&aws_iot_disconnected) == 0) {
+			/* Still connected, so the failure is not transient
+			 * and the message is not resent later.
+			 */
+			pub_window_release(param.message_id);
+		} else if (err) {
+			LOG_DBG("Not connected, message ID %d is sent on the "
+				"next connection", param.message_id);
+			err = 0;
+		}
+
+		k_mutex_unlock(&pub_window_lock);
+
+		return err;
+	}
+#endif
+
 	return mqtt_publish(&client, &param);
 }
 
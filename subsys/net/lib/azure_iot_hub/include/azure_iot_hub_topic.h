@@ -101,6 +101,32 @@ enum topic_type topic_type_get(const char *buf, const size_t len);
  */
 int azure_iot_hub_topic_parse(struct topic_parser_data *const data);
 
+/* @brief Write all property bags as a querystring into a caller-provided
+ *	  buffer, without allocating memory.
+ *
+ * @param bags Array of property bags.
+ * @param count Number of property bag elements in the bags array.
+ * @param buf Output buffer, or NULL to only get the required length.
+ * @param size Size of the output buffer, including the null-terminator.
+ *
+ * @return Length of the querystring, excluding the null-terminator, on
+ *	   success. -ENOMEM if it does not fit in the buffer.
+ */
+int azure_iot_hub_prop_bag_str_write(const struct azure_iot_hub_prop_bag *bags,
+				     size_t count, char *buf, size_t size);
+
+/* @brief Write an unsigned integer as a decimal string, for instance as the
+ *	  request ID at the end of a topic.
+ *
+ * @param buf Output buffer.
+ * @param size Size of the output buffer, including the null-terminator.
+ * @param val Value to write.
+ *
+ * @return Number of characters written, excluding the null-terminator, on
+ *	   success. -ENOMEM if the value does not fit in the buffer.
+ */
+int azure_iot_hub_topic_u32_write(char *buf, size_t size, uint32_t val);
+
 /* @brief Create a string with all property bags as a querystring.
  *	  The caller is responsible for calling k_free() on the returned
  *	  (non-NULL) pointer after use.
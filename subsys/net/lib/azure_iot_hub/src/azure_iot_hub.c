@@ -36,10 +36,12 @@ LOG_MODULE_REGISTER(azure_iot_hub, CONFIG_AZURE_IOT_HUB_LOG_LEVEL);
 #define DPS_USER_NAME		CONFIG_AZURE_IOT_HUB_DPS_ID_SCOPE \
 				"/registrations/%s/api-version=2019-03-31"
 
-/* Topics for data publishing */
-#define TOPIC_TWIN_REPORT	"$iothub/twin/PATCH/properties/reported/?$rid=%d"
-#define TOPIC_EVENTS		"devices/%s/messages/events/%s"
-#define TOPIC_TWIN_REQUEST	"$iothub/twin/GET/?$rid=%d"
+/* Topics for data publishing. The twin topics end with the request ID, and
+ * the events topic with the property bags.
+ */
+#define TOPIC_TWIN_REPORT	"$iothub/twin/PATCH/properties/reported/?$rid="
+#define TOPIC_EVENTS		"devices/%s/messages/events/"
+#define TOPIC_TWIN_REQUEST	"$iothub/twin/GET/?$rid="
 #define TOPIC_DIRECT_METHOD_RES	"$iothub/methods/res/%d/?$rid=%s"
 
 /* Subscription topics */
@@ -69,6 +71,13 @@ static struct azure_iot_hub_config conn_config = {
 
 static azure_iot_hub_evt_handler_t evt_handler;
 
+/* The events topic prefix depends only on the device ID. It's formatted on
+ * first use and kept in the buffer, so that only the property bags are
+ * written for each message. A length of 0 means it must be formatted again.
+ */
+static char event_topic[CONFIG_AZURE_IOT_HUB_TOPIC_MAX_LEN + 1];
+static size_t event_topic_prefix_len;
+
 /* If DPS is used, the IoT hub hostname is obtained through that service,
  * otherwise it has to be set in compile time using
  * @option{CONFIG_AZURE_IOT_HUB_HOSTNAME}. The maximal size is length of hub
@@ -1120,10 +1129,60 @@ int azure_iot_hub_input(void)
 	return mqtt_input(&client);
 }
 
+/* Write the events topic with property bags. Only the property bags are
+ * written if the prefix is already in place.
+ */
+static ssize_t event_topic_build(const struct azure_iot_hub_topic_data *topic)
+{
+	int len;
+
+	if (event_topic_prefix_len == 0) {
+		len = snprintk(event_topic, sizeof(event_topic), TOPIC_EVENTS,
+			       conn_config.device_id);
+		if ((len < 0) || (len >= sizeof(event_topic))) {
+			return -ENOMEM;
+		}
+
+		event_topic_prefix_len = len;
+	}
+
+	len = azure_iot_hub_prop_bag_str_write(
+				topic->prop_bag, topic->prop_bag_count,
+				&event_topic[event_topic_prefix_len],
+				sizeof(event_topic) - event_topic_prefix_len);
+	if (len < 0) {
+		return len;
+	}
+
+	return event_topic_prefix_len + len;
+}
+
+/* Write a constant topic prefix followed by a request ID. */
+static ssize_t rid_topic_build(char *buf, size_t size,
+			       const char *prefix, size_t prefix_len)
+{
+	int len;
+
+	if (prefix_len >= size) {
+		return -ENOMEM;
+	}
+
+	memcpy(buf, prefix, prefix_len);
+
+	len = azure_iot_hub_topic_u32_write(&buf[prefix_len],
+					    size - prefix_len,
+					    k_uptime_get_32());
+	if (len < 0) {
+		return len;
+	}
+
+	return prefix_len + len;
+}
+
 int azure_iot_hub_send(const struct azure_iot_hub_data *const tx_data)
 {
 	ssize_t len;
-	static char topic[CONFIG_AZURE_IOT_HUB_TOPIC_MAX_LEN + 1];
+	static char topic[sizeof(TOPIC_TWIN_REPORT) + 10];
 	struct mqtt_publish_param param = {
 		.message.payload.data = tx_data->ptr,
 		.message.payload.len = tx_data->len,
@@ -1131,6 +1190,7 @@ int azure_iot_hub_send(const struct azure_iot_hub_data *const tx_data)
 		.message_id = tx_data->message_id,
 		.dup_flag = tx_data->dup_flag,
 		.retain_flag = tx_data->retain_flag,
+		.message.topic.topic.utf8 = topic,
 	};
 
 	if (!connection_state_verify(STATE_CONNECTED)) {
@@ -1139,45 +1199,27 @@ int azure_iot_hub_send(const struct azure_iot_hub_data *const tx_data)
 	}
 
 	switch (tx_data->topic.type) {
-	case AZURE_IOT_HUB_TOPIC_EVENT: {
-		char *prop_bag_str = NULL;
-
-		if (tx_data->topic.prop_bag_count > 0) {
-			prop_bag_str = azure_iot_hub_prop_bag_str_get(
-						tx_data->topic.prop_bag,
-						tx_data->topic.prop_bag_count);
-			if (prop_bag_str == NULL) {
-				LOG_ERR("Failed to add property bags");
-			}
-		}
-
-		len = snprintk(topic, sizeof(topic),
-			       TOPIC_EVENTS, conn_config.device_id,
-			       prop_bag_str ? prop_bag_str : "");
-
-		if (prop_bag_str) {
-			azure_iot_hub_prop_bag_free(prop_bag_str);
-		}
-
-		if ((len < 0) || (len > sizeof(topic))) {
+	case AZURE_IOT_HUB_TOPIC_EVENT:
+		len = event_topic_build(&tx_data->topic);
+		if (len < 0) {
 			LOG_ERR("Failed to create event topic");
 			return -ENOMEM;
 		}
 
+		param.message.topic.topic.utf8 = event_topic;
 		break;
-	}
 	case AZURE_IOT_HUB_TOPIC_TWIN_REPORTED:
-		len = snprintk(topic, sizeof(topic),
-				TOPIC_TWIN_REPORT, k_uptime_get_32());
-		if ((len < 0) || (len > sizeof(topic))) {
+		len = rid_topic_build(topic, sizeof(topic), TOPIC_TWIN_REPORT,
+				      sizeof(TOPIC_TWIN_REPORT) - 1);
+		if (len < 0) {
 			LOG_ERR("Failed to create twin report topic");
 			return -ENOMEM;
 		}
 		break;
 	case AZURE_IOT_HUB_TOPIC_TWIN_REQUEST:
-		len = snprintk(topic, sizeof(topic),
-			       TOPIC_TWIN_REQUEST, k_uptime_get_32());
-		if ((len < 0) || (len > sizeof(topic))) {
+		len = rid_topic_build(topic, sizeof(topic), TOPIC_TWIN_REQUEST,
+				      sizeof(TOPIC_TWIN_REQUEST) - 1);
+		if (len < 0) {
 			LOG_ERR("Failed to create device twin request");
 			return -ENOMEM;
 		}
@@ -1188,7 +1230,6 @@ int azure_iot_hub_send(const struct azure_iot_hub_data *const tx_data)
 	}
 
 	param.message.topic.topic.size = len;
-	param.message.topic.topic.utf8 = topic;
 
 	LOG_DBG("Publishing to topic: %s",
 		log_strdup(param.message.topic.topic.utf8));
@@ -1280,6 +1321,7 @@ int azure_iot_hub_init(const struct azure_iot_hub_config *const config,
 		memcpy(conn_config.device_id, config->device_id,
 		       config->device_id_len);
 		conn_config.device_id_len = config->device_id_len;
+		event_topic_prefix_len = 0;
 	}
 
 #if IS_ENABLED(CONFIG_AZURE_IOT_HUB_DPS)
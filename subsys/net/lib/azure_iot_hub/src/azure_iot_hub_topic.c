@@ -14,16 +14,27 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(azure_iot_hub_topic, CONFIG_AZURE_IOT_HUB_LOG_LEVEL);
 
-#define PROP_BAG_STR		"%s=%s"
-#define PROP_BAG_STR_EMPTY_VAL	"%s="
-#define PROP_BAG_STR_NO_VAL	"%s"
-
-static char *topic_prefixes[] = {
-	[TOPIC_TYPE_DEVICEBOUND] = TOPIC_PREFIX_DEVICEBOUND,
-	[TOPIC_TYPE_TWIN_UPDATE_DESIRED] = TOPIC_PREFIX_TWIN_DESIRED,
-	[TOPIC_TYPE_TWIN_UPDATE_RESULT] = TOPIC_PREFIX_TWIN_RES,
-	[TOPIC_TYPE_DPS_REG_RESULT] = TOPIC_PREFIX_DPS_REG_RESULT,
-	[TOPIC_TYPE_DIRECT_METHOD] = TOPIC_PREFIX_DIRECT_METHOD,
+#if defined(CONFIG_AZURE_IOT_HUB_TOPIC_PROPERTY_BAG_PREFIX)
+#define PROP_BAG_PREFIX "?"
+#else
+#define PROP_BAG_PREFIX ""
+#endif
+
+/* Topic prefixes with their lengths computed at compile time, so that
+ * matching an incoming topic does not need to measure them.
+ */
+#define TOPIC_PREFIX(_str) { .str = _str, .len = sizeof(_str) - 1 }
+
+static const struct {
+	const char *str;
+	size_t len;
+} topic_prefixes[] = {
+	[TOPIC_TYPE_DEVICEBOUND] = TOPIC_PREFIX(TOPIC_PREFIX_DEVICEBOUND),
+	[TOPIC_TYPE_TWIN_UPDATE_DESIRED] =
+		TOPIC_PREFIX(TOPIC_PREFIX_TWIN_DESIRED),
+	[TOPIC_TYPE_TWIN_UPDATE_RESULT] = TOPIC_PREFIX(TOPIC_PREFIX_TWIN_RES),
+	[TOPIC_TYPE_DPS_REG_RESULT] = TOPIC_PREFIX(TOPIC_PREFIX_DPS_REG_RESULT),
+	[TOPIC_TYPE_DIRECT_METHOD] = TOPIC_PREFIX(TOPIC_PREFIX_DIRECT_METHOD),
 };
 
 /* If the topic type is TOPIC_TYPE_DEVICEBOUND, the dynamic value in the
@@ -41,7 +52,7 @@ static char *topic_prefixes[] = {
  */
 static inline char *skip_prefix(char *const buf, enum topic_type type)
 {
-	return buf + strlen(topic_prefixes[type]);
+	return buf + topic_prefixes[type].len;
 }
 
 /* Get the next occurence of a character within a string, where the length
@@ -171,8 +182,8 @@ enum topic_type topic_type_get(const char *buf, const size_t len)
 	}
 
 	for (size_t i = 0; i < ARRAY_SIZE(topic_prefixes); i++) {
-		if (strncmp(topic_prefixes[i], buf,
-			    MIN(strlen(topic_prefixes[i]), len)) == 0) {
+		if (strncmp(topic_prefixes[i].str, buf,
+			    MIN(topic_prefixes[i].len, len)) == 0) {
 			return i;
 		}
 	}
@@ -277,68 +288,95 @@ int azure_iot_hub_topic_parse(struct topic_parser_data *const data)
 	return 0;
 }
 
-char *azure_iot_hub_prop_bag_str_get(struct azure_iot_hub_prop_bag *bags,
-				     size_t count)
+/* Copy a string to the output if it fits, and return the new position. */
+static size_t str_put(char *buf, size_t size, size_t pos,
+		      const char *str, size_t len)
 {
-	/* Reserve space for null-terminator. */
-	size_t total_len = 1;
-	size_t len, written = 0;
-	char *buf;
+	if ((buf != NULL) && (pos + len < size)) {
+		memcpy(&buf[pos], str, len);
+	}
+
+	return pos + len;
+}
+
+int azure_iot_hub_prop_bag_str_write(const struct azure_iot_hub_prop_bag *bags,
+				     size_t count, char *buf, size_t size)
+{
+	size_t written = 0;
 
 	for (size_t i = 0; i < count; i++) {
-		if (bags[i].key) {
-			/* Allocate space also for '?' or '&'. */
-			total_len += strlen(bags[i].key) + 1;
-		}
+		const char *sep = (i == 0) ? PROP_BAG_PREFIX : "&";
+		const char *key = bags[i].key ? bags[i].key : "";
+
+		written = str_put(buf, size, written, sep, strlen(sep));
+		written = str_put(buf, size, written, key, strlen(key));
 
-		if (bags[i].value) {
-			/* Allocate space also for '='. */
-			total_len += strlen(bags[i].value) + 1;
+		/* The value is left out altogether if it's NULL, while an
+		 * empty value is written as "<key>=".
+		 */
+		if (bags[i].value != NULL) {
+			written = str_put(buf, size, written, "=", 1);
+			written = str_put(buf, size, written, bags[i].value,
+					  strlen(bags[i].value));
 		}
 	}
 
-	LOG_DBG("Requested memory block size: %d", total_len);
-
-	buf = k_malloc(total_len);
 	if (buf == NULL) {
-		LOG_ERR("Memory could not be allocated");
-		return NULL;
+		return written;
 	}
 
-	for (size_t i = 0; i < count; i++) {
-		if (i == 0) {
-#if defined(CONFIG_AZURE_IOT_HUB_TOPIC_PROPERTY_BAG_PREFIX)
-			buf[0] = '?';
-			written++;
-#endif
-		} else {
-			buf[written] = '&';
-			written++;
-		}
+	if (written >= size) {
+		LOG_ERR("Property bags do not fit in buffer");
+		return -ENOMEM;
+	}
 
-		if (bags[i].value == NULL) {
-			len = snprintk(&buf[written], total_len - written,
-				       PROP_BAG_STR_NO_VAL, bags[i].key);
-		} else if (strlen(bags[i].value) == 0) {
-			len = snprintk(&buf[written], total_len - written,
-				       PROP_BAG_STR_EMPTY_VAL, bags[i].key);
-		} else {
-			len = snprintk(&buf[written], total_len - written,
-				       PROP_BAG_STR, bags[i].key,
-				       bags[i].value);
-		}
+	buf[written] = '\0';
 
-		if ((len < 0) || (len > total_len)) {
-			LOG_ERR("Failed to add property bag");
-			goto clean_exit;
-		}
+	return written;
+}
+
+int azure_iot_hub_topic_u32_write(char *buf, size_t size, uint32_t val)
+{
+	char tmp[10];
+	size_t len = 0;
 
-		written += len;
+	do {
+		tmp[len++] = '0' + (val % 10);
+		val /= 10;
+	} while (val > 0);
+
+	if (len >= size) {
+		return -ENOMEM;
 	}
 
-	return buf;
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = tmp[len - 1 - i];
+	}
 
-clean_exit:
-	k_free(buf);
-	return NULL;
+	buf[len] = '\0';
+
+	return len;
+}
+
+char *azure_iot_hub_prop_bag_str_get(struct azure_iot_hub_prop_bag *bags,
+				     size_t count)
+{
+	int len = azure_iot_hub_prop_bag_str_write(bags, count, NULL, 0);
+	char *buf;
+
+	LOG_DBG("Requested memory block size: %d", len + 1);
+
+	buf = k_malloc(len + 1);
+	if (buf == NULL) {
+		LOG_ERR("Memory could not be allocated");
+		return NULL;
+	}
+
+	if (azure_iot_hub_prop_bag_str_write(bags, count, buf, len + 1) < 0) {
+		LOG_ERR("Failed to add property bag");
+		k_free(buf);
+		return NULL;
+	}
+
+	return buf;
 }
@@ -14,7 +14,7 @@ LOG_MODULE_REGISTER(coap_utils, CONFIG_COAP_UTILS_LOG_LEVEL);
 #define MAX_COAP_MSG_LEN 256
 #define COAP_VER 1
 #define COAP_TOKEN_LEN 8
-#define COAP_MAX_REPLIES 1
+#define COAP_MAX_REQUESTS CONFIG_COAP_UTILS_MAX_REQUESTS
 #define COAP_POOL_SLEEP 500
 #define COAP_OPEN_SOCKET_SLEEP 200
 #if defined(CONFIG_NRF_MODEM_LIB)
@@ -25,13 +25,28 @@ LOG_MODULE_REGISTER(coap_utils, CONFIG_COAP_UTILS_LOG_LEVEL);
 
 const static int nfds = 1;
 static struct pollfd fds;
-static struct coap_reply replies[COAP_MAX_REPLIES];
 static int proto_family;
 static struct sockaddr *bind_addr;
 
 static K_THREAD_STACK_DEFINE(receive_stack_area, COAP_RECEIVE_STACK_SIZE);
 static struct k_thread receive_thread_data;
 
+/* Outstanding requests. Slot i uses replies[i] to match the response by
+ * token and, for confirmable requests, pendings[i] and pending_bufs[i] to
+ * retransmit it until it is acknowledged. The arrays are kept separate
+ * because the CoAP library matches responses against plain arrays.
+ */
+static struct coap_reply replies[COAP_MAX_REQUESTS];
+static struct coap_pending pendings[COAP_MAX_REQUESTS];
+static uint8_t pending_bufs[COAP_MAX_REQUESTS][MAX_COAP_MSG_LEN];
+static bool pending_active[COAP_MAX_REQUESTS];
+static uint32_t request_time[COAP_MAX_REQUESTS];
+
+/* Protects the request slots, which are used by the callers sending
+ * requests, the receive thread and the retransmission work.
+ */
+static K_MUTEX_DEFINE(request_lock);
+
 static int coap_open_socket(void)
 {
 	int sock;
@@ -60,11 +75,134 @@ static void coap_close_socket(int socket)
 	(void)close(socket);
 }
 
+static int coap_send_message(const struct sockaddr *addr,
+			     const uint8_t *data, size_t len)
+{
+	return sendto(fds.fd, data, len, 0, addr, sizeof(*addr));
+}
+
+static void request_slot_free(size_t i)
+{
+	coap_reply_clear(&replies[i]);
+
+	if (pending_active[i]) {
+		coap_pending_clear(&pendings[i]);
+		pending_active[i] = false;
+	}
+}
+
+/* Get a free request slot. If all are taken, the oldest request that is no
+ * longer retransmitted is given up, as there is no guarantee that it will
+ * ever be answered.
+ */
+static int request_slot_get(void)
+{
+	int oldest = -1;
+
+	for (size_t i = 0; i < COAP_MAX_REQUESTS; i++) {
+		if (!pending_active[i] && replies[i].reply == NULL) {
+			return i;
+		}
+
+		if (!pending_active[i] &&
+		    (oldest < 0 ||
+		     (int32_t)(request_time[i] - request_time[oldest]) < 0)) {
+			oldest = i;
+		}
+	}
+
+	if (oldest >= 0) {
+		LOG_DBG("Dropping oldest request waiting for a response");
+		request_slot_free(oldest);
+	}
+
+	return oldest;
+}
+
+/* Retransmit expired confirmable requests, and give up on those that have
+ * been retransmitted the maximum number of times. The work is rescheduled
+ * for the next retransmission while there are requests in flight.
+ */
+static void retransmit_work_fn(struct k_work *work)
+{
+	struct coap_pending *pending;
+	int32_t remaining;
+	size_t i;
+
+	k_mutex_lock(&request_lock, K_FOREVER);
+
+	while (true) {
+		pending = coap_pending_next_to_expire(pendings,
+						      COAP_MAX_REQUESTS);
+		if (pending == NULL) {
+			break;
+		}
+
+		remaining = (int32_t)(pending->t0 + pending->timeout -
+				      k_uptime_get_32());
+		if (remaining > 0) {
+			k_work_reschedule(k_work_delayable_from_work(work),
+					  K_MSEC(remaining));
+			break;
+		}
+
+		i = pending - pendings;
+
+		if (coap_pending_cycle(pending)) {
+			LOG_DBG("Retransmitting request %d", pending->id);
+			if (coap_send_message(&pending->addr, pending->data,
+					      pending->len) < 0) {
+				LOG_ERR("Retransmission failed: %d", errno);
+			}
+			continue;
+		}
+
+		LOG_WRN("Request %d timed out", pending->id);
+
+		if (replies[i].reply != NULL) {
+			replies[i].reply(NULL, &replies[i], NULL);
+		}
+
+		request_slot_free(i);
+	}
+
+	k_mutex_unlock(&request_lock);
+}
+
+static K_WORK_DELAYABLE_DEFINE(retransmit_work, retransmit_work_fn);
+
+static void response_process(const struct coap_packet *response,
+			     const struct sockaddr *from)
+{
+	struct coap_pending *pending;
+	struct coap_reply *reply;
+
+	k_mutex_lock(&request_lock, K_FOREVER);
+
+	/* An ACK, with or without a piggybacked response, ends the
+	 * retransmission of the confirmable request it acknowledges.
+	 */
+	pending = coap_pending_received(response, pendings, COAP_MAX_REQUESTS);
+	if (pending) {
+		size_t i = pending - pendings;
+
+		coap_pending_clear(pending);
+		pending_active[i] = false;
+	}
+
+	reply = coap_response_received(response, from, replies,
+				       COAP_MAX_REQUESTS);
+	if (reply) {
+		request_slot_free(reply - replies);
+	}
+
+	k_mutex_unlock(&request_lock);
+}
+
 static void coap_receive(void)
 {
 	static uint8_t buf[MAX_COAP_MSG_LEN + 1];
 	struct coap_packet response;
-	struct coap_reply *reply = NULL;
 	static struct sockaddr from_addr;
 	socklen_t from_addr_len;
 	int len;
@@ -128,11 +266,7 @@ static void coap_receive(void)
 			continue;
 		}
 
-		reply = coap_response_received(&response, &from_addr, replies,
-					       COAP_MAX_REPLIES);
-		if (reply) {
-			coap_reply_clear(reply);
-		}
+		response_process(&response, &from_addr);
 	}
 }
 
@@ -181,25 +315,6 @@ end:
 	return ret;
 }
 
-static int coap_send_message(const struct sockaddr *addr,
-			     struct coap_packet *request)
-{
-	return sendto(fds.fd, request->data, request->offset, 0, addr,
-		      sizeof(*addr));
-}
-
-static void coap_set_response_callback(struct coap_packet *request,
-				       coap_reply_t reply_cb)
-{
-	struct coap_reply *reply;
-
-	reply = &replies[0];
-
-	coap_reply_clear(reply);
-	coap_reply_init(reply, request);
-	reply->reply = reply_cb;
-}
-
 void coap_init(int ip_family, struct sockaddr *addr)
 {
 	proto_family = ip_family;
@@ -222,30 +337,91 @@ void coap_init(int ip_family, struct sockaddr *addr)
 	LOG_DBG("CoAP socket receive thread started");
 }
 
-int coap_send_request(enum coap_method method, const struct sockaddr *addr,
-		      const char *const *uri_path_options, uint8_t *payload,
-		      uint16_t payload_size, coap_reply_t reply_cb)
+static int coap_send(enum coap_method method, enum coap_msgtype msg_type,
+		     const struct sockaddr *addr,
+		     const char *const *uri_path_options, uint8_t *payload,
+		     uint16_t payload_size, coap_reply_t reply_cb)
 {
 	int ret;
+	int i = -1;
 	struct coap_packet request;
 	uint8_t buf[MAX_COAP_MSG_LEN];
+	bool con = (msg_type == COAP_TYPE_CON);
 
-	ret = coap_init_request(method, COAP_TYPE_NON_CON, uri_path_options,
-				payload, payload_size, &request, buf);
+	k_mutex_lock(&request_lock, K_FOREVER);
+
+	if (reply_cb != NULL || con) {
+		i = request_slot_get();
+		if (i < 0) {
+			LOG_ERR("No free request slot");
+			ret = -ENOMEM;
+			goto end;
+		}
+	}
+
+	/* Confirmable requests are kept for retransmission. */
+	ret = coap_init_request(method, msg_type, uri_path_options,
+				payload, payload_size, &request,
+				con ? pending_bufs[i] : buf);
 	if (ret < 0) {
 		goto end;
 	}
 
 	if (reply_cb != NULL) {
-		coap_set_response_callback(&request, reply_cb);
+		coap_reply_init(&replies[i], &request);
+		replies[i].reply = reply_cb;
+	}
+
+	if (con) {
+		ret = coap_pending_init(&pendings[i], &request, addr,
+					CONFIG_COAP_UTILS_MAX_RETRANSMIT);
+		if (ret < 0) {
+			LOG_ERR("Failed to init pending request");
+			request_slot_free(i);
+			goto end;
+		}
+
+		coap_pending_cycle(&pendings[i]);
+		pending_active[i] = true;
+	}
+
+	if (i >= 0) {
+		request_time[i] = k_uptime_get_32();
 	}
 
-	ret = coap_send_message(addr, &request);
+	ret = coap_send_message(addr, request.data, request.offset);
 	if (ret < 0) {
 		LOG_ERR("Transmission failed: %d", errno);
+		if (i >= 0) {
+			request_slot_free(i);
+		}
 		goto end;
 	}
 
 end:
+	k_mutex_unlock(&request_lock);
+
+	if (con && ret >= 0) {
+		k_work_reschedule(&retransmit_work, K_NO_WAIT);
+	}
+
 	return ret;
 }
+
+int coap_send_request(enum coap_method method, const struct sockaddr *addr,
+		      const char *const *uri_path_options, uint8_t *payload,
+		      uint16_t payload_size, coap_reply_t reply_cb)
+{
+	return coap_send(method, COAP_TYPE_NON_CON, addr, uri_path_options,
+			 payload, payload_size, reply_cb);
+}
+
+int coap_send_confirmable_request(enum coap_method method,
+				  const struct sockaddr *addr,
+				  const char *const *uri_path_options,
+				  uint8_t *payload, uint16_t payload_size,
+				  coap_reply_t reply_cb)
+{
+	return coap_send(method, COAP_TYPE_CON, addr, uri_path_options,
+			 payload, payload_size, reply_cb);
+}
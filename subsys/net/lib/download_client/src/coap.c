@@ -14,17 +14,146 @@ LOG_MODULE_DECLARE(download_client, CONFIG_DOWNLOAD_CLIENT_LOG_LEVEL);
 #define COAP_VER 1
 #define FILENAME_SIZE CONFIG_DOWNLOAD_CLIENT_MAX_FILENAME_SIZE
 
+/* Smallest block size used when adapting to packet loss */
+#define BLOCK_SIZE_MIN COAP_BLOCK_64
+/* Blocks to receive without retransmissions before growing the block size */
+#define BLOCK_GROW_THRESHOLD 8
+
 int url_parse_file(const char *url, char *file, size_t len);
-int socket_send(const struct download_client *client, size_t len);
+int socket_send(const struct download_client *client, const void *buf,
+		size_t len);
+int socket_rcvtimeo_set(int fd, uint32_t timeout_ms);
 
 int coap_block_init(struct download_client *client, size_t from)
 {
 	coap_block_transfer_init(&client->coap.block_ctx,
 				 CONFIG_DOWNLOAD_CLIENT_COAP_BLOCK_SIZE, 0);
 	client->coap.block_ctx.current = from;
+
+	client->coap.srtt = 0;
+	client->coap.rttvar = 0;
+	client->coap.rto = CONFIG_DOWNLOAD_CLIENT_UDP_SOCK_TIMEO_MS;
+	client->coap.retransmits = 0;
+	client->coap.blocks_ok = 0;
+
 	return 0;
 }
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_COAP_RTT_TIMEOUT)
+/* Update the retransmission timeout with a new round-trip time sample,
+ * see RFC 6298, section 2.
+ */
+static void rtt_update(struct download_client *client, uint32_t rtt)
+{
+	if (client->coap.srtt == 0) {
+		client->coap.srtt = MAX(rtt, 1);
+		client->coap.rttvar = rtt / 2;
+	} else {
+		uint32_t delta = (client->coap.srtt > rtt) ?
+				 client->coap.srtt - rtt :
+				 rtt - client->coap.srtt;
+
+		client->coap.rttvar = (3 * client->coap.rttvar + delta) / 4;
+		client->coap.srtt = MAX((7 * client->coap.srtt + rtt) / 8, 1);
+	}
+
+	client->coap.rto = MAX(client->coap.srtt + 4 * client->coap.rttvar,
+			       CONFIG_DOWNLOAD_CLIENT_COAP_RTO_MIN_MS);
+	client->coap.rto = MIN(client->coap.rto,
+			       CONFIG_DOWNLOAD_CLIENT_COAP_RTO_MAX_MS);
+
+	LOG_DBG("RTT %d ms, SRTT %d ms, RTO %d ms",
+		rtt, client->coap.srtt, client->coap.rto);
+}
+
+static int rto_apply(struct download_client *client)
+{
+	uint32_t rto = client->coap.rto;
+
+	/* Exponential backoff on retransmissions */
+	for (uint8_t i = 0; i < client->coap.retransmits &&
+	     rto < CONFIG_DOWNLOAD_CLIENT_COAP_RTO_MAX_MS; i++) {
+		rto *= 2;
+	}
+
+	rto = MIN(rto, CONFIG_DOWNLOAD_CLIENT_COAP_RTO_MAX_MS);
+
+	return socket_rcvtimeo_set(client->fd, rto);
+}
+#endif /* CONFIG_DOWNLOAD_CLIENT_COAP_RTT_TIMEOUT */
+
+void coap_timeout(struct download_client *client)
+{
+	struct coap_block_context *ctx = &client->coap.block_ctx;
+
+	if (client->coap.retransmits < UINT8_MAX) {
+		client->coap.retransmits++;
+	}
+
+	if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_COAP_ADAPTIVE_BLOCK_SIZE) &&
+	    ctx->block_size > BLOCK_SIZE_MIN) {
+		/* The current offset stays aligned to the smaller size */
+		ctx->block_size--;
+		client->coap.blocks_ok = 0;
+		LOG_DBG("Block size decreased to %d",
+			coap_block_size_to_bytes(ctx->block_size));
+	}
+}
+
+/* Called when a block has been received */
+static void block_received(struct download_client *client)
+{
+	struct coap_block_context *ctx = &client->coap.block_ctx;
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_COAP_RTT_TIMEOUT)
+	/* Only sample blocks that were not retransmitted (Karn's algorithm) */
+	if (client->coap.retransmits == 0) {
+		rtt_update(client, k_uptime_get() - client->coap.send_time);
+	}
+#endif
+
+	if (client->coap.retransmits == 0 &&
+	    client->coap.blocks_ok < UINT8_MAX) {
+		client->coap.blocks_ok++;
+	}
+	client->coap.retransmits = 0;
+
+	if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_COAP_ADAPTIVE_BLOCK_SIZE) &&
+	    ctx->block_size < CONFIG_DOWNLOAD_CLIENT_COAP_BLOCK_SIZE &&
+	    client->coap.blocks_ok >= BLOCK_GROW_THRESHOLD &&
+	    ctx->current % coap_block_size_to_bytes(ctx->block_size + 1) == 0) {
+		/* Only grow when the next offset is aligned to the new size */
+		ctx->block_size++;
+		client->coap.blocks_ok = 0;
+		LOG_DBG("Block size increased to %d",
+			coap_block_size_to_bytes(ctx->block_size));
+	}
+}
+
+/* Check that the Block2 option of a response matches the block that
+ * was requested. Late responses to earlier requests are dropped.
+ */
+static bool block_expected(struct download_client *client,
+			   const struct coap_packet *pkt)
+{
+	int block2 = coap_get_option_int(pkt, COAP_OPTION_BLOCK2);
+	size_t szx;
+	size_t off;
+
+	if (block2 < 0) {
+		/* Let coap_update_from_block() deal with it */
+		return true;
+	}
+
+	szx = block2 & 0x07;
+	off = (block2 >> 4) << (szx + 4);
+
+	return szx <= client->coap.block_ctx.block_size &&
+	       off <= client->coap.block_ctx.current &&
+	       client->coap.block_ctx.current - off <
+	       coap_block_size_to_bytes(szx);
+}
+
 int coap_block_update(struct download_client *client, struct coap_packet *pkt,
 		      size_t *blk_off)
 {
@@ -71,6 +200,11 @@ int coap_parse(struct download_client *client, size_t len)
 		return -1;
 	}
 
+	if (!block_expected(client, &response)) {
+		LOG_DBG("Dropping response to an earlier request");
+		return 1;
+	}
+
 	err = coap_block_update(client, &response, &blk_off);
 	if (err) {
 		return -1;
@@ -102,6 +236,8 @@ int coap_parse(struct download_client *client, size_t len)
 	client->offset += payload_len - blk_off;
 	client->progress += payload_len - blk_off;
 
+	block_received(client);
+
 	return 0;
 }
 
@@ -147,7 +283,16 @@ int coap_request_send(struct download_client *client)
 
 	LOG_DBG("CoAP next block: %d", client->coap.block_ctx.current);
 
-	err = socket_send(client, request.offset);
+#if defined(CONFIG_DOWNLOAD_CLIENT_COAP_RTT_TIMEOUT)
+	err = rto_apply(client);
+	if (err) {
+		return err;
+	}
+#endif
+
+	client->coap.send_time = k_uptime_get();
+
+	err = socket_send(client, client->buf, request.offset);
 	if (err) {
 		LOG_ERR("Failed to send CoAP request, errno %d", errno);
 		return err;
@@ -34,10 +34,12 @@ int url_parse_host(const char *url, char *host, size_t len);
 
 int http_parse(struct download_client *client, size_t len);
 int http_get_request_send(struct download_client *client);
+size_t http_frag_size(const struct download_client *client);
 
 int coap_block_init(struct download_client *client, size_t from);
 int coap_parse(struct download_client *client, size_t len);
 int coap_request_send(struct download_client *client);
+void coap_timeout(struct download_client *client);
 
 static const char *str_family(int family)
 {
@@ -52,9 +54,25 @@ static const char *str_family(int family)
 	}
 }
 
-static int socket_timeout_set(int fd, int type)
+int socket_rcvtimeo_set(int fd, uint32_t timeout_ms)
 {
 	int err;
+	struct timeval timeo = {
+		.tv_sec = (timeout_ms / 1000),
+		.tv_usec = (timeout_ms % 1000) * 1000,
+	};
+
+	err = setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeo, sizeof(timeo));
+	if (err) {
+		LOG_WRN("Failed to set socket timeout, errno %d", errno);
+		return -errno;
+	}
+
+	return 0;
+}
+
+static int socket_timeout_set(int fd, int type)
+{
 	uint32_t timeout_ms;
 
 	if (type == SOCK_STREAM) {
@@ -67,23 +85,9 @@ static int socket_timeout_set(int fd, int type)
 		return 0;
 	}
 
-	struct timeval timeo = {
-		.tv_sec = (timeout_ms / 1000),
-		.tv_usec = (timeout_ms % 1000) * 1000,
-	};
-
-#if defined(CONFIG_POSIX_API)
-	LOG_INF("Configuring socket timeout (%d s)", (int32_t)timeo.tv_sec);
-#else
-	LOG_INF("Configuring socket timeout (%ld s)", timeo.tv_sec);
-#endif
-	err = setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeo, sizeof(timeo));
-	if (err) {
-		LOG_WRN("Failed to set socket timeout, errno %d", errno);
-		return -errno;
-	}
+	LOG_INF("Configuring socket timeout (%d s)", timeout_ms / 1000);
 
-	return 0;
+	return socket_rcvtimeo_set(fd, timeout_ms);
 }
 
 static int socket_sectag_set(int fd, int sec_tag)
@@ -362,13 +366,14 @@ cleanup:
 	return err;
 }
 
-int socket_send(const struct download_client *client, size_t len)
+int socket_send(const struct download_client *client, const void *buf,
+		size_t len)
 {
 	int sent;
 	size_t off = 0;
 
 	while (len) {
-		sent = send(client->fd, client->buf + off, len, 0);
+		sent = send(client->fd, (const uint8_t *)buf + off, len, 0);
 		if (sent <= 0) {
 			return -errno;
 		}
@@ -430,6 +435,11 @@ static int reconnect(struct download_client *dl)
 	int err;
 
 	LOG_INF("Reconnecting..");
+
+	/* Pipelined requests are lost with the connection */
+	dl->http.outstanding = 0;
+	dl->http.carry = 0;
+
 	err = download_client_disconnect(dl);
 	if (err) {
 		return err;
@@ -443,15 +453,98 @@ static int reconnect(struct download_client *dl)
 	return 0;
 }
 
+static int client_start(struct download_client *client, const char *file,
+			size_t from);
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_STRIPE)
+static void stripe_stop(struct download_client *dl)
+{
+	struct download_client_stripe *stripe = dl->stripe;
+
+	if (!stripe || atomic_set(&stripe->stopped, 1)) {
+		return;
+	}
+
+	/* Wake up the clients waiting for their turn */
+	for (size_t i = 0; i < stripe->count; i++) {
+		if (stripe->clients[i] != dl) {
+			k_sem_give(&stripe->clients[i]->stripe_turn);
+		}
+	}
+}
+
+/* Start the other clients, once the first response from the first client
+ * has given the file size.
+ */
+static int stripe_others_start(struct download_client *dl)
+{
+	int err;
+	struct download_client_stripe *stripe = dl->stripe;
+	const size_t frag_size = http_frag_size(dl);
+	const size_t from = dl->progress - dl->offset;
+	const size_t frags = DIV_ROUND_UP(dl->file_size - from, frag_size);
+
+	stripe->active = MAX(1, MIN(stripe->count, frags));
+
+	for (size_t i = 1; i < stripe->active; i++) {
+		err = client_start(stripe->clients[i], dl->file,
+				   from + i * frag_size);
+		if (err) {
+			LOG_ERR("Failed to start client %d, err %d", i, err);
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+/* Returns false if the download has been stopped on another client. */
+static bool stripe_turn_wait(struct download_client *dl)
+{
+	struct download_client_stripe *stripe = dl->stripe;
+
+	if (dl->stripe_idx == 0 && stripe->active == 0) {
+		if (stripe_others_start(dl)) {
+			return false;
+		}
+	}
+
+	k_sem_take(&dl->stripe_turn, K_FOREVER);
+
+	return !atomic_get(&stripe->stopped);
+}
+
+static void stripe_turn_pass(struct download_client *dl)
+{
+	struct download_client_stripe *stripe = dl->stripe;
+	struct download_client *next =
+		stripe->clients[(dl->stripe_idx + 1) % stripe->active];
+
+	k_sem_give(&next->stripe_turn);
+}
+
+/* Skip the fragments downloaded by the other clients.
+ * Returns false if there are no more fragments for this client.
+ */
+static bool stripe_advance(struct download_client *dl)
+{
+	dl->progress += (dl->stripe->active - 1) * http_frag_size(dl);
+
+	return dl->progress < dl->file_size;
+}
+#endif /* CONFIG_DOWNLOAD_CLIENT_STRIPE */
+
 void download_thread(void *client, void *a, void *b)
 {
 	int rc = 0;
 	int error_cause;
 	size_t len;
+	__maybe_unused bool finished;
 	struct download_client *const dl = client;
 
 restart_and_suspend:
 	k_thread_suspend(dl->tid);
+	finished = false;
 
 	while (true) {
 		__ASSERT(dl->offset < sizeof(dl->buf), "Buffer overflow");
@@ -463,11 +556,20 @@ restart_and_suspend:
 			break;
 		}
 
-		LOG_DBG("Receiving up to %d bytes at %p...",
-			(sizeof(dl->buf) - dl->offset), (dl->buf + dl->offset));
+		if (dl->http.carry > 0) {
+			/* The next pipelined response has already been
+			 * received, in part or entirely.
+			 */
+			len = dl->http.carry;
+			dl->http.carry = 0;
+		} else {
+			LOG_DBG("Receiving up to %d bytes at %p...",
+				(sizeof(dl->buf) - dl->offset),
+				(dl->buf + dl->offset));
 
-		len = recv(dl->fd, dl->buf + dl->offset,
-			   sizeof(dl->buf) - dl->offset, 0);
+			len = recv(dl->fd, dl->buf + dl->offset,
+				   sizeof(dl->buf) - dl->offset, 0);
+		}
 
 		if ((len == 0) || (len == -1)) {
 			/* We just had an unexpected socket error or closure */
@@ -493,6 +595,9 @@ restart_and_suspend:
 					if (dl->proto == IPPROTO_UDP ||
 					    dl->proto == IPPROTO_DTLS_1_2) {
 						LOG_DBG("Socket timeout, resending");
+						if (IS_ENABLED(CONFIG_COAP)) {
+							coap_timeout(dl);
+						}
 						goto send_again;
 					}
 					error_cause = ETIMEDOUT;
@@ -527,14 +632,15 @@ restart_and_suspend:
 
 		if (dl->proto == IPPROTO_TCP || dl->proto == IPPROTO_TLS_1_2) {
 			rc = http_parse(client, len);
-			if (rc > 0) {
-				/* Wait for more data (fragment/header) */
-				continue;
-			}
 		} else if (IS_ENABLED(CONFIG_COAP)) {
 			rc = coap_parse(client, len);
 		}
 
+		if (rc > 0) {
+			/* Wait for more data (fragment/header/block) */
+			continue;
+		}
+
 		if (rc < 0) {
 			/* Something was wrong with the packet
 			 * Restart and suspend
@@ -551,6 +657,14 @@ restart_and_suspend:
 			LOG_INF("Downloaded %u bytes", dl->progress);
 		}
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_STRIPE)
+		/* Deliver the fragments of a striped download in order */
+		if (dl->stripe && !stripe_turn_wait(dl)) {
+			/* Restart and suspend */
+			break;
+		}
+#endif
+
 		/* Send fragment to application.
 		 * If the application callback returns non-zero, stop.
 		 */
@@ -561,16 +675,31 @@ restart_and_suspend:
 			break;
 		}
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_STRIPE)
+		if (dl->stripe) {
+			stripe_turn_pass(dl);
+		}
+#endif
+
 		if (dl->progress == dl->file_size) {
 			LOG_INF("Download complete");
 			const struct download_client_evt evt = {
 				.id = DOWNLOAD_CLIENT_EVT_DONE,
 			};
 			dl->callback(&evt);
+			finished = true;
 			/* Restart and suspend */
 			break;
 		}
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_STRIPE)
+		if (dl->stripe && !stripe_advance(dl)) {
+			/* The other clients download the remaining fragments */
+			finished = true;
+			break;
+		}
+#endif
+
 		/* Attempt to reconnect if the connection was closed */
 		if (dl->http.connection_close) {
 			dl->http.connection_close = false;
@@ -578,6 +707,10 @@ restart_and_suspend:
 		}
 
 send_again:
+		if (dl->http.carry > 0) {
+			/* Move data of the next response to the beginning */
+			memmove(dl->buf, dl->buf + dl->offset, dl->http.carry);
+		}
 		dl->offset = 0;
 		/* Request next fragment, if necessary (HTTPS/CoAP) */
 		if (dl->proto != IPPROTO_TCP || len == 0
@@ -603,6 +736,12 @@ send_again:
 		}
 	}
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_STRIPE)
+	if (!finished) {
+		stripe_stop(dl);
+	}
+#endif
+
 	/* Do not let the thread return, since it can't be restarted */
 	goto restart_and_suspend;
 }
@@ -616,6 +755,9 @@ int download_client_init(struct download_client *const client,
 
 	client->fd = -1;
 	client->callback = callback;
+#if defined(CONFIG_DOWNLOAD_CLIENT_STRIPE)
+	client->stripe = NULL;
+#endif
 
 	/* The thread is spawned now, but it will suspend itself;
 	 * it is resumed when the download is started via the API.
@@ -694,15 +836,11 @@ int download_client_disconnect(struct download_client *const client)
 	return 0;
 }
 
-int download_client_start(struct download_client *client, const char *file,
-			  size_t from)
+static int client_start(struct download_client *client, const char *file,
+			size_t from)
 {
 	int err;
 
-	if (client == NULL) {
-		return -EINVAL;
-	}
-
 	if (client->fd < 0) {
 		return -ENOTCONN;
 	}
@@ -713,6 +851,8 @@ int download_client_start(struct download_client *client, const char *file,
 
 	client->offset = 0;
 	client->http.has_header = false;
+	client->http.outstanding = 0;
+	client->http.carry = 0;
 
 	if (client->proto == IPPROTO_UDP || client->proto == IPPROTO_DTLS_1_2) {
 		if (IS_ENABLED(CONFIG_COAP)) {
@@ -734,6 +874,53 @@ int download_client_start(struct download_client *client, const char *file,
 	return 0;
 }
 
+int download_client_start(struct download_client *client, const char *file,
+			  size_t from)
+{
+	if (client == NULL) {
+		return -EINVAL;
+	}
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_STRIPE)
+	client->stripe = NULL;
+#endif
+
+	return client_start(client, file, from);
+}
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_STRIPE)
+int download_client_stripe_start(struct download_client_stripe *stripe,
+				 const char *file, size_t from)
+{
+	if (stripe == NULL || stripe->clients == NULL || stripe->count == 0 ||
+	    stripe->count > UINT8_MAX) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < stripe->count; i++) {
+		struct download_client *client = stripe->clients[i];
+
+		if (client == NULL) {
+			return -EINVAL;
+		}
+
+		if (client->proto != IPPROTO_TCP &&
+		    client->proto != IPPROTO_TLS_1_2) {
+			return -EPROTONOSUPPORT;
+		}
+
+		client->stripe = stripe;
+		client->stripe_idx = i;
+		k_sem_init(&client->stripe_turn, (i == 0) ? 1 : 0, 1);
+	}
+
+	stripe->active = 0;
+	atomic_clear(&stripe->stopped);
+
+	return client_start(stripe->clients[0], file, from);
+}
+#endif /* CONFIG_DOWNLOAD_CLIENT_STRIPE */
+
 void download_client_pause(struct download_client *client)
 {
 	k_thread_suspend(client->tid);
@@ -42,13 +42,78 @@ LOG_MODULE_DECLARE(download_client, CONFIG_DOWNLOAD_CLIENT_LOG_LEVEL);
 
 int url_parse_host(const char *url, char *host, size_t len);
 int url_parse_file(const char *url, char *file, size_t len);
-int socket_send(const struct download_client *client, size_t len);
+int socket_send(const struct download_client *client, const void *buf,
+		size_t len);
 
-int http_get_request_send(struct download_client *client)
+size_t http_frag_size(const struct download_client *client)
+{
+	if (client->config.frag_size_override) {
+		return client->config.frag_size_override;
+	}
+
+	return CONFIG_DOWNLOAD_CLIENT_HTTP_FRAG_SIZE;
+}
+
+static bool http_range_requests(const struct download_client *client)
+{
+#if defined(CONFIG_DOWNLOAD_CLIENT_STRIPE)
+	if (client->stripe) {
+		return true;
+	}
+#endif
+	return client->proto == IPPROTO_TLS_1_2 ||
+	       IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_RANGE_REQUESTS);
+}
+
+static int http_range_request_send(struct download_client *client,
+				   const char *host, const char *file)
 {
 	int err;
 	int len;
 	size_t off;
+#if CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE_DEPTH > 1
+	char *const buf = client->http.req_buf;
+	const size_t size = sizeof(client->http.req_buf);
+#else
+	char *const buf = client->buf;
+	const size_t size = CONFIG_DOWNLOAD_CLIENT_BUF_SIZE;
+#endif
+
+	/* Offset of last byte in range (Content-Range) */
+	off = client->http.next_range + http_frag_size(client) - 1;
+
+	if (client->file_size != 0) {
+		/* Don't request bytes past the end of file */
+		off = MIN(off, client->file_size - 1);
+	}
+
+	len = snprintf(buf, size, HTTP_GET_RANGE, file, host,
+		       client->http.next_range, off);
+	if (len < 0 || len > size) {
+		LOG_ERR("Cannot create GET request, buffer too small");
+		return -ENOMEM;
+	}
+
+	if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_LOG_HEADERS)) {
+		LOG_HEXDUMP_DBG(buf, len, "HTTP request");
+	}
+
+	err = socket_send(client, buf, len);
+	if (err) {
+		LOG_ERR("Failed to send HTTP request, errno %d", errno);
+		return err;
+	}
+
+	client->http.next_range = off + 1;
+	client->http.outstanding++;
+
+	return 0;
+}
+
+int http_get_request_send(struct download_client *client)
+{
+	int err;
+	int len;
 	char host[HOSTNAME_SIZE];
 	char file[FILENAME_SIZE];
 
@@ -65,25 +130,33 @@ int http_get_request_send(struct download_client *client)
 		return err;
 	}
 
-	/* Offset of last byte in range (Content-Range) */
-	if (client->config.frag_size_override) {
-		off = client->progress + client->config.frag_size_override - 1;
-	} else {
-		off = client->progress +
-			CONFIG_DOWNLOAD_CLIENT_HTTP_FRAG_SIZE - 1;
-	}
+	if (http_range_requests(client)) {
+		if (client->http.outstanding == 0) {
+			client->http.next_range = client->progress;
+		}
 
-	if (client->file_size != 0) {
-		/* Don't request bytes past the end of file */
-		off = MIN(off, client->file_size - 1);
+		/* Keep up to CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE_DEPTH
+		 * requests outstanding. Only one request is sent until the
+		 * file size is known from the first response.
+		 */
+		do {
+			if (client->file_size != 0 &&
+			    client->http.next_range >= client->file_size) {
+				break;
+			}
+
+			err = http_range_request_send(client, host, file);
+			if (err) {
+				return err;
+			}
+		} while (client->file_size != 0 &&
+			 client->http.outstanding <
+			 CONFIG_DOWNLOAD_CLIENT_HTTP_PIPELINE_DEPTH);
+
+		return 0;
 	}
 
-	if (client->proto == IPPROTO_TLS_1_2
-	   || IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_RANGE_REQUESTS)) {
-		len = snprintf(client->buf,
-			CONFIG_DOWNLOAD_CLIENT_BUF_SIZE,
-			HTTP_GET_RANGE, file, host, client->progress, off);
-	} else if (client->progress) {
+	if (client->progress) {
 		len = snprintf(client->buf,
 			CONFIG_DOWNLOAD_CLIENT_BUF_SIZE,
 			HTTP_GET_OFFSET, file, host, client->progress);
@@ -102,7 +175,7 @@ int http_get_request_send(struct download_client *client)
 		LOG_HEXDUMP_DBG(client->buf, len, "HTTP request");
 	}
 
-	err = socket_send(client, len);
+	err = socket_send(client, client->buf, len);
 	if (err) {
 		LOG_ERR("Failed to send HTTP request, errno %d", errno);
 		return err;
@@ -122,9 +195,7 @@ static int http_header_parse(struct download_client *client, size_t *hdr_len)
 	char *q;
 	unsigned int http_status;
 	const bool using_range_requests =
-		(client->proto == IPPROTO_TLS_1_2 ||
-		 IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_RANGE_REQUESTS) ||
-		 client->progress);
+		(http_range_requests(client) || client->progress);
 
 	const unsigned int expected_status = using_range_requests ? 206 : 200;
 
@@ -235,6 +306,7 @@ int http_parse(struct download_client *client, size_t len)
 {
 	int rc;
 	size_t hdr_len;
+	size_t excess = 0;
 
 	/* Accumulate buffer offset */
 	client->offset += len;
@@ -267,6 +339,21 @@ int http_parse(struct download_client *client, size_t len)
 			 */
 			client->offset = 0;
 		}
+
+		/* Payload size of this range response */
+		client->http.frag_len = MIN(http_frag_size(client),
+					    client->file_size - client->progress);
+	}
+
+	/* With pipelined range requests, the buffer may also contain
+	 * the beginning of the next response. Set it aside, it is moved
+	 * to the beginning of the buffer once this fragment is handled.
+	 */
+	if (http_range_requests(client) &&
+	    client->offset > client->http.frag_len) {
+		excess = client->offset - client->http.frag_len;
+		client->offset -= excess;
+		client->http.carry = excess;
 	}
 
 	/* Accumulate overall file progress.
@@ -276,15 +363,17 @@ int http_parse(struct download_client *client, size_t len)
 	 * `offset` is less than `len` and it represents
 	 * the actual payload bytes.
 	 */
-	client->progress += MIN(client->offset, len);
+	client->progress += MIN(client->offset + excess, len) - excess;
 
 	/* Have we received a whole fragment or the whole file? */
 	if (client->progress != client->file_size &&
-	    client->offset < (client->config.frag_size_override != 0 ?
-			      client->config.frag_size_override :
-			      CONFIG_DOWNLOAD_CLIENT_HTTP_FRAG_SIZE)) {
+	    client->offset < http_frag_size(client)) {
 		return 1;
 	}
 
+	if (http_range_requests(client) && client->http.outstanding > 0) {
+		client->http.outstanding--;
+	}
+
 	return 0;
 }
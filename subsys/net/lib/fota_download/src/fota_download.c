@@ -5,11 +5,21 @@
  */
 
 #include <zephyr.h>
+#include <string.h>
 #include <logging/log.h>
 #include <net/fota_download.h>
 #include <net/download_client.h>
 #include <pm_config.h>
 
+#ifdef CONFIG_FOTA_DOWNLOAD_SHA256
+#include <mbedtls/sha256.h>
+#endif
+#ifdef CONFIG_FOTA_DOWNLOAD_SHA256_SAVE_PROGRESS
+#include <settings/settings.h>
+#define SHA256_SETTINGS_KEY "fota_dl"
+#define SHA256_SETTINGS_SNAPSHOT "sha256"
+#endif
+
 #if defined(PM_S1_ADDRESS) || defined(CONFIG_DFU_TARGET_MCUBOOT)
 /* MCUBoot support is required */
 #include <fw_info.h>
@@ -41,6 +51,167 @@ static enum dfu_target_image_type img_type_expected = DFU_TARGET_IMAGE_TYPE_ANY;
 static bool first_fragment;
 static bool downloading;
 
+#ifdef CONFIG_FOTA_DOWNLOAD_SHA256
+#define SHA256_LEN 32
+
+/* Hash context matching a DFU target offset, to resume hashing from. */
+struct sha256_snapshot {
+	size_t offset;
+	mbedtls_sha256_context ctx;
+};
+
+static struct {
+	mbedtls_sha256_context ctx;
+	/* Number of bytes hashed in ctx */
+	size_t hashed;
+	/* The hash covers the whole image so far */
+	bool valid;
+	/* The digest of the last finished download is in hash */
+	bool done;
+	uint8_t hash[SHA256_LEN];
+	bool check;
+	uint8_t expected[SHA256_LEN];
+	struct sha256_snapshot snapshot;
+} sha256;
+
+#ifdef CONFIG_FOTA_DOWNLOAD_SHA256_SAVE_PROGRESS
+static int sha256_settings_set(const char *key, size_t len_rd,
+			       settings_read_cb read_cb, void *cb_arg)
+{
+	ssize_t len;
+
+	if (strcmp(key, SHA256_SETTINGS_SNAPSHOT)) {
+		return 0;
+	}
+
+	if (len_rd != sizeof(sha256.snapshot)) {
+		return 0;
+	}
+
+	len = read_cb(cb_arg, &sha256.snapshot, sizeof(sha256.snapshot));
+	if (len != sizeof(sha256.snapshot)) {
+		LOG_ERR("Can't read hash context from storage");
+		sha256.snapshot.offset = 0;
+		return len;
+	}
+
+	return 0;
+}
+
+static int sha256_settings_init(void)
+{
+	int err;
+	static struct settings_handler sh = {
+		.name = SHA256_SETTINGS_KEY,
+		.h_set = sha256_settings_set,
+	};
+
+	err = settings_subsys_init();
+	if (err) {
+		return err;
+	}
+
+	err = settings_register(&sh);
+	if (err && err != -EEXIST) {
+		return err;
+	}
+
+	return settings_load_subtree(SHA256_SETTINGS_KEY);
+}
+#endif /* CONFIG_FOTA_DOWNLOAD_SHA256_SAVE_PROGRESS */
+
+static void sha256_snapshot_clear(void)
+{
+	sha256.snapshot.offset = 0;
+
+#ifdef CONFIG_FOTA_DOWNLOAD_SHA256_SAVE_PROGRESS
+	(void)settings_delete(SHA256_SETTINGS_KEY "/" SHA256_SETTINGS_SNAPSHOT);
+#endif
+}
+
+/* Start hashing an image that is downloaded from the given offset. */
+static void sha256_start(size_t offset)
+{
+	mbedtls_sha256_free(&sha256.ctx);
+	mbedtls_sha256_init(&sha256.ctx);
+	sha256.done = false;
+
+	if (offset == 0) {
+		sha256.hashed = 0;
+		sha256.valid = (mbedtls_sha256_starts_ret(&sha256.ctx, false) == 0);
+		sha256_snapshot_clear();
+	} else if (sha256.snapshot.offset == offset) {
+		mbedtls_sha256_clone(&sha256.ctx, &sha256.snapshot.ctx);
+		sha256.hashed = offset;
+		sha256.valid = true;
+	} else {
+		LOG_WRN("No hash context for offset %d, image is not hashed",
+			offset);
+		sha256.valid = false;
+	}
+}
+
+static void sha256_update(const void *buf, size_t len)
+{
+	int err;
+	size_t offset;
+
+	if (!sha256.valid) {
+		return;
+	}
+
+	if (mbedtls_sha256_update_ret(&sha256.ctx, buf, len) != 0) {
+		sha256.valid = false;
+		return;
+	}
+
+	sha256.hashed += len;
+
+	/* Keep a copy of the context when it matches the DFU target
+	 * offset, since that is where a resumed download starts from.
+	 */
+	err = dfu_target_offset_get(&offset);
+	if (err != 0 || offset != sha256.hashed) {
+		return;
+	}
+
+	sha256.snapshot.offset = offset;
+	mbedtls_sha256_clone(&sha256.snapshot.ctx, &sha256.ctx);
+
+#ifdef CONFIG_FOTA_DOWNLOAD_SHA256_SAVE_PROGRESS
+	err = settings_save_one(SHA256_SETTINGS_KEY "/" SHA256_SETTINGS_SNAPSHOT,
+				&sha256.snapshot, sizeof(sha256.snapshot));
+	if (err) {
+		LOG_WRN("Unable to store hash context: %d", err);
+	}
+#endif
+}
+
+/* Returns zero if the image hash is as expected, or not checked. */
+static int sha256_finish(void)
+{
+	sha256_snapshot_clear();
+
+	if (!sha256.valid ||
+	    mbedtls_sha256_finish_ret(&sha256.ctx, sha256.hash) != 0) {
+		if (sha256.check) {
+			LOG_WRN("Image hash not available, not verified");
+		}
+		return 0;
+	}
+
+	sha256.done = true;
+
+	if (sha256.check &&
+	    memcmp(sha256.hash, sha256.expected, SHA256_LEN) != 0) {
+		LOG_ERR("Image hash does not match");
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_FOTA_DOWNLOAD_SHA256 */
+
 static void send_evt(enum fota_download_evt_id id)
 {
 	__ASSERT(id != FOTA_DOWNLOAD_EVT_PROGRESS, "use send_progress");
@@ -147,6 +318,10 @@ static int download_client_callback(const struct download_client_evt *event)
 				send_error_evt(FOTA_DOWNLOAD_ERROR_CAUSE_DOWNLOAD_FAILED);
 			}
 
+#ifdef CONFIG_FOTA_DOWNLOAD_SHA256
+			sha256_start(offset);
+#endif
+
 			if (offset != 0) {
 				/* Abort current download procedure, and
 				 * schedule new download from offset.
@@ -175,6 +350,10 @@ static int download_client_callback(const struct download_client_evt *event)
 			return err;
 		}
 
+#ifdef CONFIG_FOTA_DOWNLOAD_SHA256
+		sha256_update(event->fragment.buf, event->fragment.len);
+#endif
+
 		if (IS_ENABLED(CONFIG_FOTA_DOWNLOAD_PROGRESS_EVT) &&
 		    !first_fragment) {
 			err = dfu_target_offset_get(&offset);
@@ -198,6 +377,18 @@ static int download_client_callback(const struct download_client_evt *event)
 	}
 
 	case DOWNLOAD_CLIENT_EVT_DONE:
+#ifdef CONFIG_FOTA_DOWNLOAD_SHA256
+		err = sha256_finish();
+		if (err != 0) {
+			(void)dfu_target_done(false);
+			(void)dfu_target_reset();
+			(void)download_client_disconnect(&dlc);
+			first_fragment = true;
+			send_error_evt(FOTA_DOWNLOAD_ERROR_CAUSE_INVALID_UPDATE);
+			return err;
+		}
+#endif
+
 		err = dfu_target_done(true);
 		if (err != 0) {
 			LOG_ERR("dfu_target_done error: %d", err);
@@ -399,6 +590,13 @@ int fota_download_init(fota_download_callback_t client_callback)
 
 	k_work_init_delayable(&dlc_with_offset_work, download_with_offset);
 
+#ifdef CONFIG_FOTA_DOWNLOAD_SHA256_SAVE_PROGRESS
+	err = sha256_settings_init();
+	if (err) {
+		LOG_WRN("Unable to load hash context: %d", err);
+	}
+#endif
+
 	err = download_client_init(&dlc, download_client_callback);
 	if (err != 0) {
 		return err;
@@ -441,3 +639,34 @@ int fota_download_target(void)
 {
 	return img_type;
 }
+
+#ifdef CONFIG_FOTA_DOWNLOAD_SHA256
+int fota_download_sha256_expected_set(const uint8_t *hash)
+{
+	if (downloading) {
+		return -EALREADY;
+	}
+
+	sha256.check = (hash != NULL);
+	if (hash) {
+		memcpy(sha256.expected, hash, SHA256_LEN);
+	}
+
+	return 0;
+}
+
+int fota_download_sha256_get(uint8_t *hash)
+{
+	if (hash == NULL) {
+		return -EINVAL;
+	}
+
+	if (!sha256.done) {
+		return -ENODATA;
+	}
+
+	memcpy(hash, sha256.hash, SHA256_LEN);
+
+	return 0;
+}
+#endif /* CONFIG_FOTA_DOWNLOAD_SHA256 */
@@ -46,6 +46,7 @@ static char ctrl_buf[FTP_MAX_BUFFER_SIZE];
 
 enum data_task_type {
 	TASK_SEND,
+	TASK_SEND_STREAM,
 	TASK_RECEIVE
 };
 
@@ -55,6 +56,8 @@ static struct data_task {
 	char *ctrl_msg;		/* PSAV resposne */
 	uint8_t *data;		/* TX data */
 	uint16_t length;	/* TX length */
+	ftp_client_put_cb_t producer;	/* TX data producer */
+	int result;		/* TX result */
 } data_task_param;
 
 static bool ftp_inactivity;
@@ -219,12 +222,31 @@ static int do_ftp_send_ctrl(const uint8_t *message, int length)
 	return ret;
 }
 
+static int data_send_all(const uint8_t *message, uint32_t length)
+{
+	int ret = 0;
+	uint32_t offset = 0;
+
+	while (offset < length) {
+		ret = send(client.data_sock, message + offset, length - offset, 0);
+		if (ret < 0) {
+			LOG_ERR("send data failed: %d", -errno);
+			ret = -errno;
+			break;
+		}
+		LOG_DBG("DATA sent %d", ret);
+		offset += ret;
+		ret = 0;
+	}
+
+	return ret;
+}
+
 /**@brief Send FTP data via socket
  */
 static int do_ftp_send_data(const char *pasv_msg, uint8_t *message, uint16_t length)
 {
 	int ret;
-	uint32_t offset = 0;
 
 	/* Establish data channel */
 	ret = establish_data_channel(pasv_msg);
@@ -232,17 +254,41 @@ static int do_ftp_send_data(const char *pasv_msg, uint8_t *message, uint16_t len
 		return ret;
 	}
 
-	while (offset < length) {
-		ret = send(client.data_sock, message + offset, length - offset, 0);
+	ret = data_send_all(message, length);
+
+	close(client.data_sock);
+	ftp_inactivity = false;
+	return ret;
+}
+
+/**@brief Send FTP data from a producer callback via socket
+ */
+static int do_ftp_send_stream(const char *pasv_msg, ftp_client_put_cb_t producer)
+{
+	int ret;
+	uint8_t data_buf[FTP_MAX_BUFFER_SIZE];
+
+	/* Establish data channel */
+	ret = establish_data_channel(pasv_msg);
+	if (ret) {
+		return ret;
+	}
+
+	/* Each chunk is sent before the next one is requested, so the RAM used
+	 * does not depend on the size of the file.
+	 */
+	do {
+		ret = producer(data_buf, sizeof(data_buf));
 		if (ret < 0) {
-			LOG_ERR("send data failed: %d", -errno);
-			ret = -errno;
+			LOG_ERR("producer aborted the transfer: %d", ret);
 			break;
 		}
-		LOG_DBG("DATA sent %d", ret);
-		offset += ret;
-		ret = 0;
-	}
+		if (ret == 0) {
+			break;
+		}
+		ret = data_send_all(data_buf, MIN((size_t)ret, sizeof(data_buf)));
+		ftp_inactivity = false;
+	} while (ret == 0);
 
 	close(client.data_sock);
 	ftp_inactivity = false;
@@ -379,6 +425,9 @@ static void data_task(struct k_work *item)
 		do_ftp_recv_data(task_param->ctrl_msg);
 	} else if (task_param->task == TASK_SEND) {
 		do_ftp_send_data(task_param->ctrl_msg, task_param->data, task_param->length);
+	} else if (task_param->task == TASK_SEND_STREAM) {
+		task_param->result = do_ftp_send_stream(task_param->ctrl_msg,
+							task_param->producer);
 	}
 }
 
@@ -768,10 +817,27 @@ int ftp_get(const char *file)
 	return ret;
 }
 
+static int do_ftp_send_put_cmd(const char *file, int type)
+{
+	char put_cmd[128];
+
+	if (type == FTP_PUT_NORMAL) {
+		/* Send STOR command in control channel */
+		sprintf(put_cmd, CMD_STOR, file);
+	} else if (type == FTP_PUT_UNIQUE) {
+		/* Send STOU command in control channel */
+		sprintf(put_cmd, CMD_STOU);
+	} else {
+		/* Send APPE command in control channel */
+		sprintf(put_cmd, CMD_APPE, file);
+	}
+
+	return do_ftp_send_ctrl(put_cmd, strlen(put_cmd));
+}
+
 int ftp_put(const char *file, const uint8_t *data, uint16_t length, int type)
 {
 	int ret;
-	char put_cmd[128];
 
 	if (type != FTP_PUT_NORMAL && type != FTP_PUT_UNIQUE && type != FTP_PUT_APPEND) {
 		return -EINVAL;
@@ -806,19 +872,7 @@ int ftp_put(const char *file, const uint8_t *data, uint16_t length, int type)
 		data_task_param.length = length;
 	}
 
-	if (type == FTP_PUT_NORMAL) {
-		/* Send STOR command in control channel */
-		sprintf(put_cmd, CMD_STOR, file);
-		ret = do_ftp_send_ctrl(put_cmd, strlen(put_cmd));
-	} else if (type == FTP_PUT_UNIQUE) {
-		/* Send STOU command in control channel */
-		sprintf(put_cmd, CMD_STOU);
-		ret = do_ftp_send_ctrl(put_cmd, strlen(put_cmd));
-	} else {
-		/* Send APPE command in control channel */
-		sprintf(put_cmd, CMD_APPE, file);
-		ret = do_ftp_send_ctrl(put_cmd, strlen(put_cmd));
-	}
+	ret = do_ftp_send_put_cmd(file, type);
 	if (ret != 0) {
 		return ret;
 	}
@@ -834,6 +888,52 @@ int ftp_put(const char *file, const uint8_t *data, uint16_t length, int type)
 	return ret;
 }
 
+int ftp_put_stream(const char *file, ftp_client_put_cb_t producer, int type)
+{
+	int ret;
+	struct k_work_sync sync;
+
+	if (type != FTP_PUT_NORMAL && type != FTP_PUT_UNIQUE && type != FTP_PUT_APPEND) {
+		return -EINVAL;
+	}
+	if (producer == NULL ||
+	   ((type == FTP_PUT_NORMAL || type == FTP_PUT_APPEND) && file == NULL)) {
+		return -EINVAL;
+	}
+
+	/* Always set Passive mode to act as TCP client */
+	ret = do_ftp_send_ctrl(CMD_PASV, sizeof(CMD_PASV) - 1);
+	if (ret) {
+		return -EIO;
+	}
+	ret = do_ftp_recv_ctrl(true, FTP_CODE_227);
+	if (ret != FTP_CODE_227) {
+		return ret;
+	}
+	data_task_param.ctrl_msg = ctrl_buf;
+	data_task_param.task = TASK_SEND_STREAM;
+	data_task_param.producer = producer;
+	data_task_param.result = 0;
+
+	ret = do_ftp_send_put_cmd(file, type);
+	if (ret != 0) {
+		return ret;
+	}
+
+	k_work_submit_to_queue(&ftp_work_q, &data_task_param.work);
+	ret = poll_data_task_done();
+
+	/* The server completes the transfer when the data channel is closed,
+	 * also if the producer has aborted it.
+	 */
+	(void)k_work_flush(&data_task_param.work, &sync);
+	if (ret == FTP_CODE_226 && data_task_param.result < 0) {
+		ret = data_task_param.result;
+	}
+
+	return ret;
+}
+
 int ftp_init(ftp_client_callback_t ctrl_callback, ftp_client_callback_t data_callback)
 {
 	if (ctrl_callback == NULL || data_callback == NULL) {
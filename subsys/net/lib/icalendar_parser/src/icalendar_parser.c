@@ -14,388 +14,309 @@
 
 LOG_MODULE_REGISTER(icalendar_parser, CONFIG_ICAL_PARSER_LOG_LEVEL);
 
-static size_t unfold_contentline(const char *buf, char *prop_buf)
+/* Position of the tokenizer within a content line.
+ * Reference: RFC 5545 3.1 Content Lines
+ */
+enum line_state {
+	LINE_STATE_NAME,
+	LINE_STATE_PARAM,
+	LINE_STATE_VALUE,
+};
+
+/* Position of the tokenizer within a line break.
+ * A line break followed by a space or a tab is a fold and is skipped.
+ */
+enum eol_state {
+	EOL_STATE_NONE,
+	EOL_STATE_CR,
+	EOL_STATE_LF,
+};
+
+/* Supported properties of the VEVENT component. */
+static const struct {
+	const char *name;
+	size_t offset;
+	size_t size;
+	enum ical_parser_error_id error;
+	/* Property parameters are accepted, and skipped. */
+	bool param;
+} event_props[] = {
+	{ "SUMMARY", offsetof(struct ical_component, summary),
+	  CONFIG_ICAL_PARSER_SUMMARY_SIZE, ICAL_ERROR_SUMMARY, false },
+	{ "LOCATION", offsetof(struct ical_component, location),
+	  CONFIG_ICAL_PARSER_LOCATION_SIZE, ICAL_ERROR_LOCATION, false },
+	{ "DESCRIPTION", offsetof(struct ical_component, description),
+	  CONFIG_ICAL_PARSER_DESCRIPTION_SIZE, ICAL_ERROR_DESCRIPTION, false },
+	{ "DTSTART", offsetof(struct ical_component, dtstart),
+	  CONFIG_ICAL_PARSER_DTSTART_SIZE, ICAL_ERROR_DTSTART, true },
+	{ "DTEND", offsetof(struct ical_component, dtend),
+	  CONFIG_ICAL_PARSER_DTEND_SIZE, ICAL_ERROR_DTEND, true },
+};
+
+/* Supported components. Others, like VALARM, are skipped. */
+static const struct {
+	const char *name;
+	enum ical_parser_evt_id id;
+	enum ical_parser_error_id error;
+} components[] = {
+	{ "VEVENT", ICAL_EVT_VEVENT, ICAL_ERROR_NONE },
+	{ "VTODO", ICAL_EVT_VTODO, ICAL_ERROR_COM_NOT_SUPPORTED },
+	{ "VJOURNAL", ICAL_EVT_VJOURNAL, ICAL_ERROR_COM_NOT_SUPPORTED },
+	{ "VFREEBUSY", ICAL_EVT_VFREEBUSY, ICAL_ERROR_COM_NOT_SUPPORTED },
+	{ "VTIMEZONE", ICAL_EVT_VTIMEZONE, ICAL_ERROR_COM_NOT_SUPPORTED },
+};
+
+static void prop_error(struct icalendar_parser *ical, const char *reason)
 {
-	const char *sol = buf;
-	char *eol;
-	uint16_t total_line_len = 0, single_line_len = 0;
-
-	while (1) {
-		eol = strstr(sol, "\r\n");
-		if (!eol) {
-			return 0;
-		}
-		single_line_len = eol - sol;
-		if ((total_line_len + single_line_len) <= CONFIG_ICAL_PARSER_MAX_PROPERTY_SIZE) {
-			memcpy(prop_buf + total_line_len, sol, single_line_len);
-			total_line_len += single_line_len;
-		} else {
-			LOG_WRN("Property value overflow."
-				"Increase CONFIG_ICAL_PARSER_MAX_PROPERTY_SIZE.");
-			return 0;
-		}
-		if (!strncmp(eol, "\r\n ", strlen("\r\n "))) {
-			/* Long content line is split into multiple lines.
-			 * Copy the folded part to unfolded buffer.
-			 */
-			sol = eol + strlen("\r\n ");
-		} else {
-			/* Content line is delimited. */
-			break;
-		}
-	}
-	prop_buf[total_line_len] = '\0';
+	LOG_ERR("%s %s.", log_strdup(ical->name), reason);
 
-	return total_line_len;
+	if (ical->evt.error == ICAL_ERROR_NONE) {
+		ical->evt.error = event_props[ical->prop].error;
+	}
 }
 
-static bool parse_desc_props(const char *buf,
-			     const char *name,
-			     size_t name_size,
-			     char *value,
-			     size_t max_value_len)
+/* Called when the property name is complete, to select the destination of its value. */
+static void name_parsed(struct icalendar_parser *ical)
 {
-	bool ret;
-	size_t unfold_size;
-	char ical_prop_buf[CONFIG_ICAL_PARSER_MAX_PROPERTY_SIZE + 1];
-
-	unfold_size = unfold_contentline(buf, ical_prop_buf);
-	if (unfold_size <= 0) {
-		/* Property wrong format - no parameter or value. */
-		LOG_ERR("%s no value/param.", name);
-		return false;
+	ical->name[MIN(ical->name_len, ICAL_PARSER_NAME_SIZE)] = '\0';
+	ical->prop = ICAL_PARSER_PROP_NONE;
+	ical->value = NULL;
+	ical->value_len = 0;
+
+	if (ical->name_len > ICAL_PARSER_NAME_SIZE) {
+		/* Not a supported property. */
+		return;
 	}
 
-	if (ical_prop_buf[name_size] == ':') {
-		size_t value_len = unfold_size - name_size - 1;
+	if (!strcmp(ical->name, "BEGIN") || !strcmp(ical->name, "END")) {
+		ical->value = ical->token;
+		ical->value_max = ICAL_PARSER_NAME_SIZE;
+		return;
+	}
 
-		if (value_len <= max_value_len) {
-			memcpy(value, ical_prop_buf + name_size + 1, value_len);
-			value[value_len] = '\0';
-			ret = true;
-		} else {
-			/* Property value overflow. */
-			LOG_ERR("%s value overflow.", name);
-			ret = false;
-		}
-	} else if (ical_prop_buf[name_size] == ';') {
-		/* Does not support property parameter. */
-		LOG_ERR("%s param not supported.", name);
-		ret = false;
-	} else {
-		/* Property wrong format - no parameter or value. */
-		LOG_ERR("%s wrong format.", name);
-		ret = false;
+	/* Properties are only parsed in a top-level VEVENT without errors. */
+	if (ical->depth != 1 || ical->evt.id != ICAL_EVT_VEVENT ||
+	    ical->evt.error != ICAL_ERROR_NONE) {
+		return;
 	}
 
-	return ret;
+	for (size_t i = 0; i < ARRAY_SIZE(event_props); i++) {
+		if (!strcasecmp(ical->name, event_props[i].name)) {
+			ical->prop = i;
+			ical->value = (char *)&ical->evt.ical_com + event_props[i].offset;
+			ical->value_max = event_props[i].size;
+			return;
+		}
+	}
 }
 
-static bool parse_datetime_props(const char *buf,
-				 const char *name,
-				 size_t name_size,
-				 char *value,
-				 size_t max_value_len)
+static void begin_parsed(struct icalendar_parser *ical)
 {
-	bool ret;
-	size_t unfold_size;
-	char ical_prop_buf[CONFIG_ICAL_PARSER_MAX_PROPERTY_SIZE + 1];
-
-	unfold_size = unfold_contentline(buf, ical_prop_buf);
-	if (unfold_size <= 0) {
-		/* Property wrong format - fail to unfold property. */
-		LOG_ERR("%s wrong format. Fail to unfold property", name);
-		return false;
+	if (!ical->icalobject_begin) {
+		if (!strcmp(ical->token, "VCALENDAR")) {
+			LOG_DBG("Found a calendar stream");
+			ical->icalobject_begin = true;
+		}
+		return;
 	}
 
-	if (ical_prop_buf[name_size] == ':') {
-		size_t value_len = unfold_size - name_size - 1;
+	if (ical->depth++ > 0) {
+		/* Nested component, for example VALARM in VEVENT. */
+		return;
+	}
 
-		if (value_len <= max_value_len) {
-			memcpy(value, ical_prop_buf + name_size + 1, value_len);
-			value[value_len] = '\0';
-			ret = true;
-		} else {
-			/* Property value overflow. */
-			LOG_ERR("%s value overflow.", name);
-			ret = false;
-		}
-	} else if (ical_prop_buf[name_size] == ';') {
-		char *dtvalue;
-
-		dtvalue = strchr(ical_prop_buf, ':');
-		if (dtvalue) {
-			dtvalue = dtvalue + 1;
-			size_t value_len;
-
-			value_len = unfold_size - (dtvalue - ical_prop_buf);
-			if (value_len <= max_value_len) {
-				memcpy(value, dtvalue, value_len);
-				value[value_len] = '\0';
-				ret = true;
-			} else {
-				/* Property value overflow. */
-				LOG_ERR("%s value overflow.", name);
-				ret = false;
-			}
-		} else {
-			/* Property wrong format - no value. */
-			LOG_ERR("%s wrong format - no value.", name);
-			ret = false;
+	memset(&ical->evt, 0, sizeof(ical->evt));
+	ical->evt.error = ICAL_ERROR_COM_NOT_SUPPORTED;
+	ical->component = false;
+
+	for (size_t i = 0; i < ARRAY_SIZE(components); i++) {
+		if (!strcmp(ical->token, components[i].name)) {
+			ical->evt.id = components[i].id;
+			ical->evt.error = components[i].error;
+			ical->component = true;
+			break;
 		}
-	} else {
-		/* Property wrong format - no parameter or value. */
-		LOG_ERR("%s wrong format.", name);
-		ret = false;
 	}
-
-	return ret;
 }
 
-static size_t parse_calprops(const char *buf)
+/* Returns the callback result when a component is complete. */
+static int end_parsed(struct icalendar_parser *ical)
 {
-	const char *parsed = buf;
-	char *end = NULL;
-	char prop_value[CONFIG_ICAL_PARSER_MAX_PROPERTY_SIZE + 1];
-
-	parsed = strstr(parsed, "BEGIN:VCALENDAR\r\n");
-	if (parsed == NULL) {
+	if (ical->depth == 0) {
+		/* END:VCALENDAR */
+		ical->icalobject_begin = false;
 		return 0;
 	}
-	parsed += strlen("BEGIN:VCALENDAR\r\n");
 
-	end = strstr(parsed, "\r\nBEGIN:");
-	if (end == NULL) {
+	if (--ical->depth > 0 || !ical->component) {
 		return 0;
 	}
-	end += strlen("\r\n");
-
-	while (parsed < end) {
-		memset(prop_value, 0, sizeof(prop_value));
-		if (!strncmp(parsed, "PRODID", 6)) {
-			if (!parse_desc_props(parsed, "PRODID", 6,
-					prop_value, sizeof(prop_value))) {
-				LOG_ERR("Wrong PRODID");
-			}
-		} else if (!strncmp(parsed, "VERSION", 7)) {
-			if (!parse_desc_props(parsed, "VERSION", 7,
-					prop_value, sizeof(prop_value))) {
-				LOG_ERR("Wrong VERSION");
-			}
-		}
-		parsed = strstr(parsed, "\r\n");
-		parsed += strlen("\r\n");
-	}
 
-	return (parsed - buf);
+	return ical->callback(&ical->evt);
 }
 
-static size_t parse_eventprop(const char *buf, struct ical_parser_evt *evt)
+/* Called when a content line, including its folded parts, is complete. */
+static int line_parsed(struct icalendar_parser *ical)
 {
-	const char *parsed = buf;
-	char *com_end;
-
-	if (strncmp(buf, "BEGIN:VEVENT\r\n", strlen("BEGIN:VEVENT\r\n"))) {
-		return 0;
+	if (ical->line_state == LINE_STATE_NAME) {
+		name_parsed(ical);
 	}
 
-	com_end = strstr(buf, "END:VEVENT\r\n");
-	if (com_end == NULL) {
+	if (!ical->value) {
 		return 0;
 	}
 
-	evt->id = ICAL_EVT_VEVENT;
-	evt->error = ICAL_ERROR_NONE;
-	com_end += strlen("END:VEVENT\r\n");
-	while (parsed < com_end) {
-		if (!strncasecmp(parsed, "SUMMARY", 7)) {
-			if (!parse_desc_props(
-				parsed, "SUMMARY", 7,
-				evt->ical_com.summary,
-				CONFIG_ICAL_PARSER_SUMMARY_SIZE)) {
-				evt->error = ICAL_ERROR_SUMMARY;
-				parsed = com_end;
-			}
-		} else if (!strncasecmp(parsed, "LOCATION", 8)) {
-			if (!parse_desc_props(
-				parsed, "LOCATION", 8,
-				evt->ical_com.location,
-				CONFIG_ICAL_PARSER_LOCATION_SIZE)) {
-				evt->error = ICAL_ERROR_LOCATION;
-				parsed = com_end;
-			}
-		} else if (!strncasecmp(parsed, "DESCRIPTION", 11)) {
-			if (!parse_desc_props(
-				parsed, "DESCRIPTION", 11,
-				evt->ical_com.description,
-				CONFIG_ICAL_PARSER_DESCRIPTION_SIZE)) {
-				evt->error = ICAL_ERROR_DESCRIPTION;
-				parsed = com_end;
-			}
-		} else if (!strncasecmp(parsed, "DTSTART", 7)) {
-			if (!parse_datetime_props(
-				parsed, "DTSTART", 7,
-				evt->ical_com.dtstart,
-				CONFIG_ICAL_PARSER_DTSTART_SIZE)) {
-				evt->error = ICAL_ERROR_DTSTART;
-				parsed = com_end;
-			}
-		} else if (!strncasecmp(parsed,
-					"DTEND", 5)) {
-			if (!parse_datetime_props(
-				parsed, "DTEND", 5,
-				evt->ical_com.dtend,
-				CONFIG_ICAL_PARSER_DTEND_SIZE)) {
-				evt->error = ICAL_ERROR_DTEND;
-				parsed = com_end;
-			}
+	if (ical->line_state != LINE_STATE_VALUE) {
+		if (ical->prop != ICAL_PARSER_PROP_NONE) {
+			/* Property wrong format - no parameter or value. */
+			prop_error(ical, "wrong format - no value");
 		}
-
-		/* Move parsed pointer to end of line break */
-		parsed = strstr(parsed, "\r\n") + 2;
+		return 0;
 	}
 
-	return parsed - buf;
-}
-
-static size_t parse_todoprop(const char *buf, struct ical_parser_evt *evt)
-{
-	const char *parsed = buf;
-	char *com_end;
+	ical->value[MIN(ical->value_len, ical->value_max)] = '\0';
 
-	com_end = strstr(buf, "END:VTODO\r\n");
-	if (com_end) {
-		parsed = com_end + strlen("END:VTODO\r\n");
+	if (ical->prop != ICAL_PARSER_PROP_NONE) {
+		if (ical->value_len > ical->value_max) {
+			prop_error(ical, "value overflow");
+		}
+		return 0;
 	}
-	evt->id = ICAL_EVT_VTODO;
-	evt->error = ICAL_ERROR_COM_NOT_SUPPORTED;
 
-	return parsed - buf;
-}
-
-static size_t parse_jourprop(const char *buf,
-				struct ical_parser_evt *evt)
-{
-	const char *parsed = buf;
-	char *com_end;
-
-	com_end = strstr(buf, "END:VJOURNAL\r\n");
-	if (com_end) {
-		parsed = com_end + strlen("END:VJOURNAL\r\n");
+	if (ical->value_len > ical->value_max) {
+		/* Not a supported component. */
+		ical->token[0] = '\0';
 	}
-	evt->id = ICAL_EVT_VJOURNAL;
-	evt->error = ICAL_ERROR_COM_NOT_SUPPORTED;
-
-	return parsed - buf;
-}
-
-static size_t parse_fbprop(const char *buf, struct ical_parser_evt *evt)
-{
-	const char *parsed = buf;
-	char *com_end;
 
-	com_end = strstr(buf, "END:VFREEBUSY\r\n");
-	if (com_end) {
-		parsed = com_end + strlen("END:VFREEBUSY\r\n");
+	if (ical->name[0] == 'B') {
+		begin_parsed(ical);
+		return 0;
 	}
-	evt->id = ICAL_EVT_VFREEBUSY;
-	evt->error = ICAL_ERROR_COM_NOT_SUPPORTED;
 
-	return parsed - buf;
+	return end_parsed(ical);
 }
 
-static size_t parse_tzprop(const char *buf, struct ical_parser_evt *evt)
+static void line_char(struct icalendar_parser *ical, char c)
 {
-	const char *parsed = buf;
-	char *com_end;
-
-	com_end = strstr(buf, "END:VTIMEZONE\r\n");
-	if (com_end) {
-		parsed = com_end + strlen("END:VTIMEZONE\r\n");
-	}
-	evt->id = ICAL_EVT_VTIMEZONE;
-	evt->error = ICAL_ERROR_COM_NOT_SUPPORTED;
+	switch (ical->line_state) {
+	case LINE_STATE_NAME:
+		if (c == ':' || c == ';') {
+			name_parsed(ical);
+			if (c == ':') {
+				ical->line_state = LINE_STATE_VALUE;
+			} else if (ical->prop != ICAL_PARSER_PROP_NONE &&
+				   !event_props[ical->prop].param) {
+				/* Does not support property parameter. */
+				prop_error(ical, "param not supported");
+				ical->value = NULL;
+				ical->line_state = LINE_STATE_PARAM;
+			} else {
+				ical->line_state = LINE_STATE_PARAM;
+			}
+		} else {
+			if (ical->name_len < ICAL_PARSER_NAME_SIZE) {
+				ical->name[ical->name_len] = c;
+			}
+			/* Length above ICAL_PARSER_NAME_SIZE marks an unsupported name. */
+			if (ical->name_len <= ICAL_PARSER_NAME_SIZE) {
+				ical->name_len++;
+			}
+		}
+		break;
+
+	case LINE_STATE_PARAM:
+		/* Quoted parameter values may contain a colon. */
+		if (c == '"') {
+			ical->quoted = !ical->quoted;
+		} else if (c == ':' && !ical->quoted) {
+			ical->line_state = LINE_STATE_VALUE;
+		}
+		break;
 
-	return parsed - buf;
-}
+	case LINE_STATE_VALUE:
+		if (!ical->value) {
+			break;
+		}
+		/* Value is written directly to its destination.
+		 * Length above value_max marks an overflow.
+		 */
+		if (ical->value_len < ical->value_max) {
+			ical->value[ical->value_len] = c;
+		}
+		if (ical->value_len <= ical->value_max) {
+			ical->value_len++;
+		}
+		break;
 
-static size_t parse_component(char *buf, struct ical_parser_evt *evt)
-{
-	char *com_begin = buf;
-	size_t ret = 0;
-
-	/* Search begin of component */
-	if (!strncmp(com_begin, "BEGIN:VEVENT\r\n", 14)) {
-		ret += parse_eventprop(com_begin, evt);
-	} else if (!strncmp(com_begin, "BEGIN:VTODO\r\n", 13)) {
-		ret += parse_todoprop(com_begin, evt);
-	} else if (!strncmp(com_begin, "BEGIN:VJOURNAL\r\n", 16)) {
-		ret += parse_jourprop(com_begin, evt);
-	} else if (!strncmp(com_begin, "BEGIN:VFREEBUSY\r\n", 17)) {
-		ret += parse_fbprop(com_begin, evt);
-	} else if (!strncmp(com_begin, "BEGIN:VTIMEZONE\r\n", 17)) {
-		ret += parse_tzprop(com_begin, evt);
+	default:
+		break;
 	}
-
-	return ret;
 }
 
-static size_t parse_icalbody(char *buf,	icalendar_parser_callback_t callback)
+static void line_reset(struct icalendar_parser *ical)
 {
-	size_t parsed_bytes = 0, parsed_offset = 0;
-
-	do {
-		struct ical_parser_evt evt;
-
-		parsed_bytes = parse_component(buf + parsed_offset, &evt);
-		parsed_offset += parsed_bytes;
-		if (parsed_bytes > 0) {
-			callback(&evt);
-		}
-	} while (parsed_bytes > 0);
-
-	return parsed_offset;
+	ical->line_state = LINE_STATE_NAME;
+	ical->name_len = 0;
+	ical->quoted = false;
+	ical->prop = ICAL_PARSER_PROP_NONE;
+	ical->value = NULL;
 }
 
 size_t ical_parser_parse(struct icalendar_parser *ical, const char *data, size_t len)
 {
-	size_t parsed_offset = 0;
-
-	if (CONFIG_ICAL_PARSER_BUFFER_SIZE < (ical->offset + len)) {
-		return -ENOBUFS;
-	}
+	for (size_t i = 0; i < len; i++) {
+		char c = data[i];
+
+		switch (ical->eol_state) {
+		case EOL_STATE_CR:
+			if (c == '\n' && ical->value == ical->token &&
+			    ical->line_state == LINE_STATE_VALUE) {
+				/* BEGIN and END lines are completed right away,
+				 * so that the last component of the stream is
+				 * reported without waiting for more data.
+				 */
+				ical->eol_state = EOL_STATE_NONE;
+				if (line_parsed(ical)) {
+					line_reset(ical);
+					return i + 1;
+				}
+				line_reset(ical);
+				continue;
+			}
+			if (c == '\n') {
+				ical->eol_state = EOL_STATE_LF;
+				continue;
+			}
+			/* Bare CR is part of the line. */
+			ical->eol_state = EOL_STATE_NONE;
+			line_char(ical, '\r');
+			break;
 
-	memcpy(ical->buf + ical->offset, data, len);
-	ical->buf[ical->offset + len] = '\0';
+		case EOL_STATE_LF:
+			ical->eol_state = EOL_STATE_NONE;
+			if (c == ' ' || c == '\t') {
+				/* Long content line is folded. Continue the line. */
+				continue;
+			}
+			if (line_parsed(ical)) {
+				line_reset(ical);
+				return i;
+			}
+			line_reset(ical);
+			break;
 
-	/* Check begin of iCalendar object delimiter
-	 * Reference: RFC 5545 3.4 iCalendar Object
-	 */
-	if (!ical->icalobject_begin) {
-		/* The body of the iCalendar object consists of
-		 * a sequence of calendar properties and
-		 * one or more calendar components.
-		 *
-		 * Reference: RFC 5545 3.6 Calendar Components
-		 */
-		parsed_offset += parse_calprops(ical->buf);
-		if (parsed_offset > 0) {
-			LOG_DBG("Found a calendar stream");
-			ical->icalobject_begin = true;
+		default:
+			break;
 		}
-	}
-
-	/* If we got a calendar property, start parsing calendar body. */
-	if (ical->icalobject_begin) {
-		parsed_offset += parse_icalbody(ical->buf + parsed_offset, ical->callback);
-	}
 
-	if (parsed_offset) {
-		ical->offset = ical->offset + len - parsed_offset;
-		memcpy(ical->buf, ical->buf + parsed_offset, ical->offset);
+		if (c == '\r') {
+			ical->eol_state = EOL_STATE_CR;
+		} else {
+			line_char(ical, c);
+		}
 	}
 
-	return parsed_offset;
+	return len;
 }
 
 int ical_parser_init(struct icalendar_parser *ical, icalendar_parser_callback_t callback)
@@ -404,9 +325,9 @@ int ical_parser_init(struct icalendar_parser *ical, icalendar_parser_callback_t
 		return -EINVAL;
 	}
 
+	memset(ical, 0, sizeof(*ical));
 	ical->callback = callback;
-	ical->icalobject_begin = false;
-	ical->offset = 0;
+	line_reset(ical);
 
 	return 0;
 }
@@ -26,6 +26,51 @@ static int32_t modem_rsrp;
 
 static uint8_t bearers[2] = { LTE_FDD_BEARER, NB_IOT_BEARER };
 
+/* Values last written to the numeric resources. Writing a resource notifies
+ * its observers, so a value is only written again when it has changed.
+ */
+static struct {
+	bool bearer_valid;
+	bool network_valid;
+	bool rsrp_valid;
+	uint8_t bearer;
+	uint32_t cell_id;
+	uint16_t mnc;
+	uint16_t mcc;
+	int32_t rsrp;
+} reported;
+
+static void bearer_set(uint8_t bearer)
+{
+	if (reported.bearer_valid && reported.bearer == bearer) {
+		return;
+	}
+
+	lwm2m_engine_set_u8("4/0/0", bearer);
+	reported.bearer = bearer;
+	reported.bearer_valid = true;
+}
+
+static void network_set(uint32_t cell_id, uint16_t mnc, uint16_t mcc)
+{
+	if (!reported.network_valid || reported.cell_id != cell_id) {
+		lwm2m_engine_set_u32("4/0/8", cell_id);
+	}
+
+	if (!reported.network_valid || reported.mnc != mnc) {
+		lwm2m_engine_set_u16("4/0/9", mnc);
+	}
+
+	if (!reported.network_valid || reported.mcc != mcc) {
+		lwm2m_engine_set_u16("4/0/10", mcc);
+	}
+
+	reported.cell_id = cell_id;
+	reported.mnc = mnc;
+	reported.mcc = mcc;
+	reported.network_valid = true;
+}
+
 static void modem_data_update(struct k_work *work)
 {
 	int ret;
@@ -45,11 +90,11 @@ static void modem_data_update(struct k_work *work)
 
 	switch (mode) {
 	case LTE_LC_LTE_MODE_LTEM:
-		lwm2m_engine_set_u8("4/0/0", LTE_FDD_BEARER);
+		bearer_set(LTE_FDD_BEARER);
 		break;
 
 	case LTE_LC_LTE_MODE_NBIOT:
-		lwm2m_engine_set_u8("4/0/0", NB_IOT_BEARER);
+		bearer_set(NB_IOT_BEARER);
 		break;
 
 	case LTE_LC_LTE_MODE_NONE:
@@ -78,9 +123,9 @@ static void modem_data_update(struct k_work *work)
 		strlen(modem_param.network.apn.value_string),
 		LWM2M_RES_DATA_FLAG_RO);
 
-	lwm2m_engine_set_u32("4/0/8", (uint32_t)modem_param.network.cellid_dec);
-	lwm2m_engine_set_u16("4/0/9", modem_param.network.mnc.value);
-	lwm2m_engine_set_u16("4/0/10", modem_param.network.mcc.value);
+	network_set((uint32_t)modem_param.network.cellid_dec,
+		    modem_param.network.mnc.value,
+		    modem_param.network.mcc.value);
 
 	/* set "Firmware Version" as modem firmware version in device object */
 	lwm2m_engine_set_res_data("3/0/3",
@@ -116,7 +161,15 @@ static void modem_signal_update(struct k_work *work)
 		return;
 	}
 
+	/* Small fluctuations are not worth a notification. */
+	if (reported.rsrp_valid &&
+	    abs(modem_rsrp - reported.rsrp) < CONFIG_LWM2M_CONN_MON_RSRP_STEP) {
+		return;
+	}
+
 	lwm2m_engine_set_s8("4/0/2", modem_rsrp);
+	reported.rsrp = modem_rsrp;
+	reported.rsrp_valid = true;
 	timestamp_prev = k_uptime_get_32();
 }
 
@@ -77,6 +77,10 @@ int nrf_cloud_codec_init(void);
 int nrf_cloud_encode_sensor_data(const struct nrf_cloud_sensor_data *input,
 				 struct nrf_cloud_data *output);
 
+/**@brief Encode the sensor data as CBOR, with the same keys as the JSON encoding. */
+int nrf_cloud_encode_sensor_data_cbor(const struct nrf_cloud_sensor_data *input,
+				      struct nrf_cloud_data *output);
+
 /**@brief Encode the sensor data to be sent to the device shadow. */
 int nrf_cloud_encode_shadow_data(const struct nrf_cloud_sensor_data *sensor,
 				 struct nrf_cloud_data *output);
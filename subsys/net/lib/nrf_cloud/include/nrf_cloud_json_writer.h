@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_CLOUD_JSON_WRITER_H__
+#define NRF_CLOUD_JSON_WRITER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum nesting depth of objects and arrays. */
+#define NRF_CLOUD_JW_DEPTH_MAX 32
+
+/**@brief Streaming JSON writer.
+ *
+ * The writer prints unformatted JSON directly into a caller-provided
+ * buffer, without building an object tree and without allocating memory.
+ * Errors are sticky: once an operation has failed, the following ones have
+ * no effect, and the error is returned by @ref nrf_cloud_jw_finish.
+ *
+ * If the writer is initialized without a buffer, it only counts the
+ * number of characters that would be written. This can be used to size a
+ * buffer exactly before encoding for real.
+ */
+struct nrf_cloud_jw {
+	char *buf;
+	size_t size;
+	size_t len;
+	int err;
+	uint8_t depth;
+	/* Bit N is set while no element has been written at depth N */
+	uint32_t first;
+};
+
+/**@brief Initialize a writer.
+ *
+ * @param[out] w Writer.
+ * @param[in] buf Output buffer, or NULL to only count characters.
+ * @param[in] size Size of the output buffer, including the terminator.
+ */
+void nrf_cloud_jw_init(struct nrf_cloud_jw *w, char *buf, size_t size);
+
+/**@brief Start an object.
+ *
+ * @param[in] w Writer.
+ * @param[in] key Key of the object in the enclosing object, or NULL at top
+ *		  level and in arrays. The same applies to all value functions.
+ */
+void nrf_cloud_jw_obj_start(struct nrf_cloud_jw *w, const char *key);
+
+/**@brief End the current object. */
+void nrf_cloud_jw_obj_end(struct nrf_cloud_jw *w);
+
+/**@brief Start an array. */
+void nrf_cloud_jw_arr_start(struct nrf_cloud_jw *w, const char *key);
+
+/**@brief End the current array. */
+void nrf_cloud_jw_arr_end(struct nrf_cloud_jw *w);
+
+/**@brief Write a string, escaped as needed. */
+void nrf_cloud_jw_str(struct nrf_cloud_jw *w, const char *key, const char *val);
+
+/**@brief Write an integer. */
+void nrf_cloud_jw_int(struct nrf_cloud_jw *w, const char *key, int32_t val);
+
+/**@brief Write a number. Non-finite values are written as null. */
+void nrf_cloud_jw_num(struct nrf_cloud_jw *w, const char *key, double val);
+
+/**@brief Write a boolean. */
+void nrf_cloud_jw_bool(struct nrf_cloud_jw *w, const char *key, bool val);
+
+/**@brief Write null. */
+void nrf_cloud_jw_null(struct nrf_cloud_jw *w, const char *key);
+
+/**@brief Write a value that is already encoded as JSON, verbatim.
+ *
+ * @param[in] w Writer.
+ * @param[in] key Key, or NULL.
+ * @param[in] json Encoded JSON value. It is not validated.
+ * @param[in] len Length of @p json.
+ */
+void nrf_cloud_jw_raw(struct nrf_cloud_jw *w, const char *key,
+		      const char *json, size_t len);
+
+/**@brief Terminate the output.
+ *
+ * @param[in] w Writer.
+ *
+ * @retval The length of the output, excluding the terminator, if successful.
+ * @retval -ENOMEM The output did not fit in the buffer.
+ * @retval -E2BIG The maximum nesting depth was exceeded.
+ * @retval -EINVAL Objects or arrays were not properly closed.
+ */
+int nrf_cloud_jw_finish(struct nrf_cloud_jw *w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_JSON_WRITER_H__ */
@@ -115,6 +115,12 @@ void nct_dc_endpoint_get(struct nrf_cloud_data *tx_endpoint,
 			 struct nrf_cloud_data *rx_endpoint,
 			 struct nrf_cloud_data *m_endpoint);
 
+/**
+ * @brief Get the CBOR data topic. The topic is empty until the data
+ *        endpoint is set, or if CBOR encoding is disabled.
+ */
+void nct_dc_cbor_endpoint_get(struct nrf_cloud_topic *cbor_endpoint);
+
 /**@brief Needed for keep alive. */
 void nct_process(void);
 
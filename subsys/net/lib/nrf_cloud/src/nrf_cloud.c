@@ -288,12 +288,50 @@ int nrf_cloud_shadow_device_status_update(const struct nrf_cloud_device_status *
 	return err;
 }
 
+/* Device messages can be queued by the transport while the data channel is
+ * not connected.
+ */
+static bool dc_send_allowed(void)
+{
+	if (IS_ENABLED(CONFIG_NRF_CLOUD_MQTT_TX_QUEUE)) {
+		return current_state >= STATE_INITIALIZED;
+	}
+
+	return current_state == STATE_DC_CONNECTED;
+}
+
+/* Encode a sensor data message, as CBOR on the CBOR data topic if requested
+ * and possible, and otherwise as JSON on the data topic.
+ */
+static int sensor_data_encode(const struct nrf_cloud_sensor_data *param,
+			      struct nct_dc_data *dc_data)
+{
+	dc_data->topic.ptr = NULL;
+	dc_data->topic.len = 0;
+
+	if (IS_ENABLED(CONFIG_NRF_CLOUD_CBOR) &&
+	    param->format == NRF_CLOUD_DATA_FORMAT_CBOR) {
+		nct_dc_cbor_endpoint_get(&dc_data->topic);
+
+		if (dc_data->topic.ptr != NULL &&
+		    nrf_cloud_encode_sensor_data_cbor(param, &dc_data->data) == 0) {
+			return 0;
+		}
+
+		LOG_DBG("Sending sensor data as JSON");
+		dc_data->topic.ptr = NULL;
+		dc_data->topic.len = 0;
+	}
+
+	return nrf_cloud_encode_sensor_data(param, &dc_data->data);
+}
+
 int nrf_cloud_sensor_data_send(const struct nrf_cloud_sensor_data *param)
 {
 	int err;
 	struct nct_dc_data sensor_data;
 
-	if (current_state != STATE_DC_CONNECTED) {
+	if (!dc_send_allowed()) {
 		return -EACCES;
 	}
 
@@ -301,7 +339,7 @@ int nrf_cloud_sensor_data_send(const struct nrf_cloud_sensor_data *param)
 		return -EINVAL;
 	}
 
-	err = nrf_cloud_encode_sensor_data(param, &sensor_data.data);
+	err = sensor_data_encode(param, &sensor_data);
 	if (err) {
 		return err;
 	}
@@ -323,7 +361,7 @@ int nrf_cloud_sensor_data_stream(const struct nrf_cloud_sensor_data *param)
 	int err;
 	struct nct_dc_data sensor_data;
 
-	if (current_state != STATE_DC_CONNECTED) {
+	if (!dc_send_allowed()) {
 		return -EACCES;
 	}
 
@@ -331,7 +369,7 @@ int nrf_cloud_sensor_data_stream(const struct nrf_cloud_sensor_data *param)
 		return -EINVAL;
 	}
 
-	err = nrf_cloud_encode_sensor_data(param, &sensor_data.data);
+	err = sensor_data_encode(param, &sensor_data);
 	if (err) {
 		return err;
 	}
@@ -346,12 +384,16 @@ int nrf_cloud_send(const struct nrf_cloud_tx_data *msg)
 {
 	int err;
 
-	if (current_state != STATE_DC_CONNECTED) {
+	if (!dc_send_allowed()) {
 		return -EACCES;
 	}
 
 	switch (msg->topic_type) {
 	case NRF_CLOUD_TOPIC_STATE: {
+		if (current_state != STATE_DC_CONNECTED) {
+			return -EACCES;
+		}
+
 		const struct nct_cc_data shadow_data = {
 			.opcode = NCT_CC_OPCODE_UPDATE_REQ,
 			.data.ptr = msg->data.ptr,
@@ -6,6 +6,7 @@
 
 #include "nrf_cloud_codec.h"
 #include "nrf_cloud_mem.h"
+#include "nrf_cloud_json_writer.h"
 #include <stdbool.h>
 #include <string.h>
 #include <stdio.h>
@@ -16,6 +17,10 @@
 #include <modem/modem_info.h>
 #include "cJSON_os.h"
 #include "nrf_cloud_fota.h"
+#if defined(CONFIG_NRF_CLOUD_CBOR)
+#include <tinycbor/cbor.h>
+#include <tinycbor/cbor_buf_writer.h>
+#endif
 
 LOG_MODULE_REGISTER(nrf_cloud_codec, CONFIG_NRF_CLOUD_LOG_LEVEL);
 
@@ -219,15 +224,6 @@ static int json_add_obj_cs(cJSON *parent, const char *str, cJSON *item)
 	return cJSON_AddItemToObjectCS(parent, str, item) ? 0 : -ENOMEM;
 }
 
-static int json_add_str_cs(cJSON *parent, const char *str, const char *item)
-{
-	if (!parent || !str || !item) {
-		return -EINVAL;
-	}
-
-	return cJSON_AddStringToObjectCS(parent, str, item) ? 0 : -ENOMEM;
-}
-
 static int json_add_null_cs(cJSON *parent, const char *const str)
 {
 	if (!parent || !str) {
@@ -282,46 +278,109 @@ static void nrf_cloud_decode_desired_obj(cJSON *const root_obj,
 	}
 }
 
+typedef void (*json_encode_fn)(struct nrf_cloud_jw *w, const void *ctx);
+
+/* Encode with the streaming writer into a buffer of the exact size.
+ * The first pass only counts the characters, so that a single allocation
+ * is needed. The buffer is freed with nrf_cloud_free().
+ */
+static int json_encode_alloc(json_encode_fn encode, const void *ctx,
+			     struct nrf_cloud_data *output)
+{
+	int len;
+	char *buffer;
+	struct nrf_cloud_jw w;
+
+	nrf_cloud_jw_init(&w, NULL, 0);
+	encode(&w, ctx);
+	len = nrf_cloud_jw_finish(&w);
+	if (len < 0) {
+		return len;
+	}
+
+	buffer = nrf_cloud_malloc(len + 1);
+	if (buffer == NULL) {
+		return -ENOMEM;
+	}
+
+	nrf_cloud_jw_init(&w, buffer, len + 1);
+	encode(&w, ctx);
+	len = nrf_cloud_jw_finish(&w);
+	if (len < 0) {
+		nrf_cloud_free(buffer);
+		return len;
+	}
+
+	output->ptr = buffer;
+	output->len = len;
+
+	return 0;
+}
+
+static void shadow_data_encode(struct nrf_cloud_jw *w, const void *ctx)
+{
+	const struct nrf_cloud_sensor_data *sensor = ctx;
+
+	nrf_cloud_jw_obj_start(w, NULL);
+	nrf_cloud_jw_obj_start(w, JSON_KEY_STATE);
+	nrf_cloud_jw_obj_start(w, JSON_KEY_REP);
+	nrf_cloud_jw_raw(w, sensor_type_str[sensor->type],
+			 sensor->data.ptr, sensor->data.len);
+	nrf_cloud_jw_obj_end(w);
+	nrf_cloud_jw_obj_end(w);
+	nrf_cloud_jw_obj_end(w);
+}
+
 int nrf_cloud_encode_shadow_data(const struct nrf_cloud_sensor_data *sensor,
 				 struct nrf_cloud_data *output)
 {
-	int ret;
-	char *buffer = NULL;
-
 	__ASSERT_NO_MSG(sensor != NULL);
 	__ASSERT_NO_MSG(sensor->data.ptr != NULL);
 	__ASSERT_NO_MSG(sensor->data.len != 0);
 	__ASSERT_NO_MSG(output != NULL);
 	__ASSERT_NO_MSG(sensor->type < SENSOR_TYPE_ARRAY_SIZE);
 
-	cJSON *root_obj = cJSON_CreateObject();
-	cJSON *state_obj = cJSON_AddObjectToObjectCS(root_obj, JSON_KEY_STATE);
-	cJSON *reported_obj = cJSON_AddObjectToObjectCS(state_obj, JSON_KEY_REP);
-	cJSON *input_obj = cJSON_ParseWithLength(sensor->data.ptr, sensor->data.len);
-
-	ret = json_add_obj_cs(reported_obj, sensor_type_str[sensor->type], input_obj);
-
-	if (ret == 0) {
-		buffer = cJSON_PrintUnformatted(root_obj);
-	} else {
-		cJSON_Delete(input_obj);
-	}
+	return json_encode_alloc(shadow_data_encode, sensor, output);
+}
 
-	if (buffer) {
-		output->ptr = buffer;
-		output->len = strlen(buffer);
-	} else {
-		ret = -ENOMEM;
-	}
+static void sensor_data_encode(struct nrf_cloud_jw *w, const void *ctx)
+{
+	const struct nrf_cloud_sensor_data *sensor = ctx;
 
-	cJSON_Delete(root_obj);
-	return ret;
+	nrf_cloud_jw_obj_start(w, NULL);
+	nrf_cloud_jw_str(w, JSON_KEY_APPID, sensor_type_str[sensor->type]);
+	nrf_cloud_jw_str(w, JSON_KEY_DATA, sensor->data.ptr);
+	nrf_cloud_jw_str(w, JSON_KEY_MSGTYPE, MSGTYPE_VAL_DATA);
+	nrf_cloud_jw_obj_end(w);
 }
 
 int nrf_cloud_encode_sensor_data(const struct nrf_cloud_sensor_data *sensor,
 				 struct nrf_cloud_data *output)
 {
-	int ret;
+	__ASSERT_NO_MSG(sensor != NULL);
+	__ASSERT_NO_MSG(sensor->data.ptr != NULL);
+	__ASSERT_NO_MSG(sensor->data.len != 0);
+	__ASSERT_NO_MSG(output != NULL);
+	__ASSERT_NO_MSG(sensor->type < SENSOR_TYPE_ARRAY_SIZE);
+
+	return json_encode_alloc(sensor_data_encode, sensor, output);
+}
+
+#if defined(CONFIG_NRF_CLOUD_CBOR)
+/* Worst case size of the CBOR map header and of a string header */
+#define CBOR_MAP_HDR_MAX 1
+#define CBOR_STR_HDR_MAX 9
+
+int nrf_cloud_encode_sensor_data_cbor(const struct nrf_cloud_sensor_data *sensor,
+				      struct nrf_cloud_data *output)
+{
+	const char *app_id;
+	uint8_t *buffer;
+	size_t size;
+	struct cbor_buf_writer writer;
+	CborEncoder encoder;
+	CborEncoder map;
+	CborError err;
 
 	__ASSERT_NO_MSG(sensor != NULL);
 	__ASSERT_NO_MSG(sensor->data.ptr != NULL);
@@ -329,31 +388,42 @@ int nrf_cloud_encode_sensor_data(const struct nrf_cloud_sensor_data *sensor,
 	__ASSERT_NO_MSG(output != NULL);
 	__ASSERT_NO_MSG(sensor->type < SENSOR_TYPE_ARRAY_SIZE);
 
-	cJSON *root_obj = cJSON_CreateObject();
+	app_id = sensor_type_str[sensor->type];
+	size = CBOR_MAP_HDR_MAX + 6 * CBOR_STR_HDR_MAX +
+	       strlen(JSON_KEY_APPID) + strlen(app_id) +
+	       strlen(JSON_KEY_DATA) + sensor->data.len +
+	       strlen(JSON_KEY_MSGTYPE) + strlen(MSGTYPE_VAL_DATA);
 
-	if (root_obj == NULL) {
+	buffer = nrf_cloud_malloc(size);
+	if (buffer == NULL) {
 		return -ENOMEM;
 	}
 
-	ret = json_add_str_cs(root_obj, JSON_KEY_APPID, sensor_type_str[sensor->type]);
-	ret += json_add_str_cs(root_obj, JSON_KEY_DATA, sensor->data.ptr);
-	ret += json_add_str_cs(root_obj, JSON_KEY_MSGTYPE, MSGTYPE_VAL_DATA);
+	cbor_buf_writer_init(&writer, buffer, size);
+	cbor_encoder_init(&encoder, &writer.enc, 0);
 
-	if (ret != 0) {
-		cJSON_Delete(root_obj);
+	err = cbor_encoder_create_map(&encoder, &map, 3);
+	err |= cbor_encode_text_stringz(&map, JSON_KEY_APPID);
+	err |= cbor_encode_text_stringz(&map, app_id);
+	err |= cbor_encode_text_stringz(&map, JSON_KEY_DATA);
+	err |= cbor_encode_text_string(&map, sensor->data.ptr,
+				       sensor->data.len);
+	err |= cbor_encode_text_stringz(&map, JSON_KEY_MSGTYPE);
+	err |= cbor_encode_text_stringz(&map, MSGTYPE_VAL_DATA);
+	err |= cbor_encoder_close_container(&encoder, &map);
+
+	if (err != CborNoError) {
+		LOG_ERR("CBOR encoding failed: %d", err);
+		nrf_cloud_free(buffer);
 		return -ENOMEM;
 	}
 
-	char *buffer;
-
-	buffer = cJSON_PrintUnformatted(root_obj);
-	cJSON_Delete(root_obj);
-
 	output->ptr = buffer;
-	output->len = strlen(buffer);
+	output->len = writer.ptr - buffer;
 
 	return 0;
 }
+#endif /* CONFIG_NRF_CLOUD_CBOR */
 
 #ifdef CONFIG_NRF_CLOUD_GATEWAY
 void nrf_cloud_register_gateway_state_handler(gateway_state_handler_t handler)
@@ -514,80 +584,83 @@ int nrf_cloud_encode_config_response(struct nrf_cloud_data const *const input,
 	return 0;
 }
 
-int nrf_cloud_encode_state(uint32_t reported_state, struct nrf_cloud_data *output)
+static void state_pin_wait_encode(struct nrf_cloud_jw *w, const void *ctx)
 {
-	__ASSERT_NO_MSG(output != NULL);
+	ARG_UNUSED(ctx);
 
-	char *buffer;
-	int ret = 0;
-	cJSON *root_obj = cJSON_CreateObject();
-	cJSON *state_obj = cJSON_AddObjectToObjectCS(root_obj, JSON_KEY_STATE);
-	cJSON *reported_obj = cJSON_AddObjectToObjectCS(state_obj, JSON_KEY_REP);
-	cJSON *pairing_obj = cJSON_AddObjectToObjectCS(reported_obj, JSON_KEY_PAIRING);
-	cJSON *connection_obj = cJSON_AddObjectToObjectCS(reported_obj, JSON_KEY_CONN);
+	nrf_cloud_jw_obj_start(w, NULL);
+	nrf_cloud_jw_obj_start(w, JSON_KEY_STATE);
+	nrf_cloud_jw_obj_start(w, JSON_KEY_REP);
 
-	if (!pairing_obj || !connection_obj) {
-		cJSON_Delete(root_obj);
-		return -ENOMEM;
-	}
-
-	switch (reported_state) {
-	case STATE_UA_PIN_WAIT: {
-		ret += json_add_str_cs(pairing_obj, JSON_KEY_STATE, DUA_PIN_STR);
-		ret += json_add_null_cs(pairing_obj, JSON_KEY_TOPICS);
-		ret += json_add_null_cs(pairing_obj, JSON_KEY_CFG);
-		ret += json_add_null_cs(reported_obj, JSON_KEY_STAGE);
-		ret += json_add_null_cs(reported_obj, JSON_KEY_TOPIC_PRFX);
-		ret += json_add_null_cs(connection_obj, JSON_KEY_KEEPALIVE);
-		break;
-	}
-	case STATE_UA_PIN_COMPLETE: {
-		struct nrf_cloud_data rx_endp;
-		struct nrf_cloud_data tx_endp;
-		struct nrf_cloud_data m_endp;
+	nrf_cloud_jw_obj_start(w, JSON_KEY_PAIRING);
+	nrf_cloud_jw_str(w, JSON_KEY_STATE, DUA_PIN_STR);
+	nrf_cloud_jw_null(w, JSON_KEY_TOPICS);
+	nrf_cloud_jw_null(w, JSON_KEY_CFG);
+	nrf_cloud_jw_obj_end(w);
 
-		/* Get the endpoint information. */
-		nct_dc_endpoint_get(&tx_endp, &rx_endp, &m_endp);
-		ret += json_add_str_cs(reported_obj, JSON_KEY_TOPIC_PRFX, m_endp.ptr);
+	nrf_cloud_jw_obj_start(w, JSON_KEY_CONN);
+	nrf_cloud_jw_null(w, JSON_KEY_KEEPALIVE);
+	nrf_cloud_jw_obj_end(w);
 
-		/* Clear pairing config and pairingStatus fields. */
-		ret += json_add_str_cs(pairing_obj, JSON_KEY_STATE, PAIRED_STR);
-		ret += json_add_null_cs(pairing_obj, JSON_KEY_CFG);
-		ret += json_add_null_cs(reported_obj, JSON_KEY_PAIR_STAT);
+	nrf_cloud_jw_null(w, JSON_KEY_STAGE);
+	nrf_cloud_jw_null(w, JSON_KEY_TOPIC_PRFX);
 
-		/* Report keepalive value. */
-		ret += json_add_num_cs(connection_obj, JSON_KEY_KEEPALIVE,
-				       CONFIG_NRF_CLOUD_MQTT_KEEPALIVE);
+	nrf_cloud_jw_obj_end(w);
+	nrf_cloud_jw_obj_end(w);
+	nrf_cloud_jw_obj_end(w);
+}
 
-		/* Report pairing topics. */
-		cJSON *topics_obj = cJSON_AddObjectToObjectCS(pairing_obj, JSON_KEY_TOPICS);
+static void state_pin_complete_encode(struct nrf_cloud_jw *w, const void *ctx)
+{
+	struct nrf_cloud_data rx_endp;
+	struct nrf_cloud_data tx_endp;
+	struct nrf_cloud_data m_endp;
+
+	ARG_UNUSED(ctx);
+
+	/* Get the endpoint information. */
+	nct_dc_endpoint_get(&tx_endp, &rx_endp, &m_endp);
+
+	nrf_cloud_jw_obj_start(w, NULL);
+	nrf_cloud_jw_obj_start(w, JSON_KEY_STATE);
+	nrf_cloud_jw_obj_start(w, JSON_KEY_REP);
+
+	/* Clear pairing config and report pairing topics. */
+	nrf_cloud_jw_obj_start(w, JSON_KEY_PAIRING);
+	nrf_cloud_jw_str(w, JSON_KEY_STATE, PAIRED_STR);
+	nrf_cloud_jw_null(w, JSON_KEY_CFG);
+	nrf_cloud_jw_obj_start(w, JSON_KEY_TOPICS);
+	nrf_cloud_jw_str(w, JSON_KEY_DEVICE_TO_CLOUD, tx_endp.ptr);
+	nrf_cloud_jw_str(w, JSON_KEY_CLOUD_TO_DEVICE, rx_endp.ptr);
+	nrf_cloud_jw_obj_end(w);
+	nrf_cloud_jw_obj_end(w);
+
+	/* Report keepalive value. */
+	nrf_cloud_jw_obj_start(w, JSON_KEY_CONN);
+	nrf_cloud_jw_int(w, JSON_KEY_KEEPALIVE, CONFIG_NRF_CLOUD_MQTT_KEEPALIVE);
+	nrf_cloud_jw_obj_end(w);
+
+	nrf_cloud_jw_str(w, JSON_KEY_TOPIC_PRFX, m_endp.ptr);
+	/* Clear pairingStatus field. */
+	nrf_cloud_jw_null(w, JSON_KEY_PAIR_STAT);
+
+	nrf_cloud_jw_obj_end(w);
+	nrf_cloud_jw_obj_end(w);
+	nrf_cloud_jw_obj_end(w);
+}
 
-		ret += json_add_str_cs(topics_obj, JSON_KEY_DEVICE_TO_CLOUD, tx_endp.ptr);
-		ret += json_add_str_cs(topics_obj, JSON_KEY_CLOUD_TO_DEVICE, rx_endp.ptr);
+int nrf_cloud_encode_state(uint32_t reported_state, struct nrf_cloud_data *output)
+{
+	__ASSERT_NO_MSG(output != NULL);
 
-		if (ret != 0) {
-			cJSON_Delete(root_obj);
-			return -ENOMEM;
-		}
-		break;
-	}
-	default: {
-		cJSON_Delete(root_obj);
+	switch (reported_state) {
+	case STATE_UA_PIN_WAIT:
+		return json_encode_alloc(state_pin_wait_encode, NULL, output);
+	case STATE_UA_PIN_COMPLETE:
+		return json_encode_alloc(state_pin_complete_encode, NULL, output);
+	default:
 		return -ENOTSUP;
 	}
-	}
-
-	buffer = cJSON_PrintUnformatted(root_obj);
-	cJSON_Delete(root_obj);
-
-	if (buffer == NULL) {
-		return -ENOMEM;
-	}
-
-	output->ptr = buffer;
-	output->len = strlen(buffer);
-
-	return 0;
 }
 
 /**
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <sys/util.h>
+#include "nrf_cloud_json_writer.h"
+
+static void put(struct nrf_cloud_jw *w, const char *str, size_t len)
+{
+	if (w->err) {
+		return;
+	}
+
+	if (w->buf) {
+		if (w->len + len >= w->size) {
+			w->err = -ENOMEM;
+			return;
+		}
+		memcpy(w->buf + w->len, str, len);
+	}
+
+	w->len += len;
+}
+
+static void put_char(struct nrf_cloud_jw *w, char c)
+{
+	put(w, &c, 1);
+}
+
+static void put_string(struct nrf_cloud_jw *w, const char *str)
+{
+	static const char hex[] = "0123456789abcdef";
+	const char *run = str;
+
+	put_char(w, '"');
+
+	for (; *str; str++) {
+		char esc[6] = { '\\' };
+		size_t esc_len = 2;
+		unsigned char c = *str;
+
+		switch (c) {
+		case '"':
+		case '\\':
+			esc[1] = c;
+			break;
+		case '\b':
+			esc[1] = 'b';
+			break;
+		case '\f':
+			esc[1] = 'f';
+			break;
+		case '\n':
+			esc[1] = 'n';
+			break;
+		case '\r':
+			esc[1] = 'r';
+			break;
+		case '\t':
+			esc[1] = 't';
+			break;
+		default:
+			if (c >= 0x20) {
+				continue;
+			}
+			esc[1] = 'u';
+			esc[2] = '0';
+			esc[3] = '0';
+			esc[4] = hex[c >> 4];
+			esc[5] = hex[c & 0x0f];
+			esc_len = 6;
+		}
+
+		/* Flush the unescaped characters before this one */
+		put(w, run, str - run);
+		put(w, esc, esc_len);
+		run = str + 1;
+	}
+
+	put(w, run, str - run);
+	put_char(w, '"');
+}
+
+/* Write the separator and the key of a new element. */
+static void element(struct nrf_cloud_jw *w, const char *key)
+{
+	if (w->first & BIT(w->depth)) {
+		w->first &= ~BIT(w->depth);
+	} else {
+		put_char(w, ',');
+	}
+
+	if (key) {
+		put_string(w, key);
+		put_char(w, ':');
+	}
+}
+
+static void container_start(struct nrf_cloud_jw *w, const char *key, char c)
+{
+	element(w, key);
+	put_char(w, c);
+
+	if (w->depth + 1 >= NRF_CLOUD_JW_DEPTH_MAX) {
+		w->err = w->err ? w->err : -E2BIG;
+		return;
+	}
+
+	w->depth++;
+	w->first |= BIT(w->depth);
+}
+
+static void container_end(struct nrf_cloud_jw *w, char c)
+{
+	if (w->depth == 0) {
+		w->err = w->err ? w->err : -EINVAL;
+		return;
+	}
+
+	w->first &= ~BIT(w->depth);
+	w->depth--;
+	put_char(w, c);
+}
+
+void nrf_cloud_jw_init(struct nrf_cloud_jw *w, char *buf, size_t size)
+{
+	w->buf = buf;
+	w->size = size;
+	w->len = 0;
+	w->err = 0;
+	w->depth = 0;
+	w->first = BIT(0);
+}
+
+void nrf_cloud_jw_obj_start(struct nrf_cloud_jw *w, const char *key)
+{
+	container_start(w, key, '{');
+}
+
+void nrf_cloud_jw_obj_end(struct nrf_cloud_jw *w)
+{
+	container_end(w, '}');
+}
+
+void nrf_cloud_jw_arr_start(struct nrf_cloud_jw *w, const char *key)
+{
+	container_start(w, key, '[');
+}
+
+void nrf_cloud_jw_arr_end(struct nrf_cloud_jw *w)
+{
+	container_end(w, ']');
+}
+
+void nrf_cloud_jw_str(struct nrf_cloud_jw *w, const char *key, const char *val)
+{
+	element(w, key);
+	put_string(w, val);
+}
+
+void nrf_cloud_jw_int(struct nrf_cloud_jw *w, const char *key, int32_t val)
+{
+	char tmp[12];
+	int len = snprintf(tmp, sizeof(tmp), "%d", val);
+
+	element(w, key);
+	put(w, tmp, len);
+}
+
+void nrf_cloud_jw_num(struct nrf_cloud_jw *w, const char *key, double val)
+{
+	char tmp[32];
+	int len;
+
+	if (!isfinite(val)) {
+		nrf_cloud_jw_null(w, key);
+		return;
+	}
+
+	len = snprintf(tmp, sizeof(tmp), "%.15g", val);
+
+	element(w, key);
+	put(w, tmp, MIN((size_t)len, sizeof(tmp) - 1));
+}
+
+void nrf_cloud_jw_bool(struct nrf_cloud_jw *w, const char *key, bool val)
+{
+	element(w, key);
+	put(w, val ? "true" : "false", val ? 4 : 5);
+}
+
+void nrf_cloud_jw_null(struct nrf_cloud_jw *w, const char *key)
+{
+	element(w, key);
+	put(w, "null", 4);
+}
+
+void nrf_cloud_jw_raw(struct nrf_cloud_jw *w, const char *key,
+		      const char *json, size_t len)
+{
+	element(w, key);
+	put(w, json, len);
+}
+
+int nrf_cloud_jw_finish(struct nrf_cloud_jw *w)
+{
+	if (!w->err && w->depth != 0) {
+		w->err = -EINVAL;
+	}
+
+	if (w->buf && w->size > 0) {
+		w->buf[MIN(w->len, w->size - 1)] = '\0';
+	}
+
+	return w->err ? w->err : (int)w->len;
+}
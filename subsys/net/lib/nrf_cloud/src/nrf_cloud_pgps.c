@@ -19,6 +19,10 @@
 #include <settings/settings.h>
 #include <power/reboot.h>
 #include <logging/log_ctrl.h>
+#if defined(CONFIG_NRF_CLOUD_PGPS_INCREMENTAL_REPLACEMENT)
+#include <stdlib.h>
+#include <modem/at_monitor.h>
+#endif
 
 #include <logging/log.h>
 
@@ -34,6 +38,9 @@ LOG_MODULE_REGISTER(nrf_cloud_pgps, CONFIG_NRF_CLOUD_GPS_LOG_LEVEL);
 
 #define PREDICTION_PERIOD		CONFIG_NRF_CLOUD_PGPS_PREDICTION_PERIOD
 #define REPLACEMENT_THRESHOLD		CONFIG_NRF_CLOUD_PGPS_REPLACEMENT_THRESHOLD
+#if defined(CONFIG_NRF_CLOUD_PGPS_INCREMENTAL_REPLACEMENT)
+#define REPLACEMENT_BATCH		CONFIG_NRF_CLOUD_PGPS_REPLACEMENT_BATCH
+#endif
 #define SEC_TAG				CONFIG_NRF_CLOUD_SEC_TAG
 #define FRAGMENT_SIZE			CONFIG_NRF_CLOUD_PGPS_DOWNLOAD_FRAGMENT_SIZE
 #define PREDICTION_MIDPOINT_SHIFT_SEC	(120 * SEC_PER_MIN)
@@ -65,7 +72,6 @@ struct pgps_index {
 	uint8_t cur_pnum;
 	bool partial_request;
 	bool stale_server_data;
-	uint32_t storage_extent;
 	int store_block;
 
 	/* array of pointers to predictions, in sorted time order */
@@ -102,21 +108,32 @@ static int pgps_request_all(void);
 K_WORK_DEFINE(prediction_work, prediction_work_handler);
 K_TIMER_DEFINE(prediction_timer, prediction_timer_handler, NULL);
 
-static int determine_prediction_num(struct nrf_cloud_pgps_header *header,
-				    struct nrf_cloud_pgps_prediction *p)
+/* Predictions are stored as a fixed-stride table in the memory-mapped
+ * storage. The block of a prediction is the number of prediction periods
+ * between it and the prediction stored in block 0, modulo the number of
+ * blocks, so any prediction is found without scanning the storage, and
+ * consecutive predictions are in consecutive blocks.
+ */
+static int prediction_block(int64_t gps_sec)
 {
-	int64_t start_sec = npgps_gps_day_time_to_sec(header->gps_day,
-						      header->gps_time_of_day);
-	uint32_t period_sec = header->prediction_period_min * SEC_PER_MIN;
-	int64_t end_sec = start_sec + header->prediction_count * period_sec;
-	int64_t pred_sec = npgps_gps_day_time_to_sec(p->time.date_day,
-						     p->time.time_full_s);
+	const struct nrf_cloud_pgps_prediction *base = npgps_block_to_pointer(0);
+	int64_t delta;
+	int64_t periods;
 
-	if ((start_sec <= pred_sec) && (pred_sec < end_sec)) {
-		return (int)((pred_sec - start_sec) / period_sec);
-	} else {
-		return -EINVAL;
+	if ((base == NULL) || (index.period_sec == 0) ||
+	    (base->time_type != NRF_CLOUD_AGPS_GPS_SYSTEM_CLOCK)) {
+		return NO_BLOCK;
 	}
+
+	delta = gps_sec - npgps_gps_day_time_to_sec(base->time.date_day,
+						    base->time.time_full_s);
+	if ((delta % index.period_sec) != 0) {
+		return NO_BLOCK;
+	}
+
+	periods = (delta / index.period_sec) % NUM_BLOCKS;
+
+	return (int)((periods + NUM_BLOCKS) % NUM_BLOCKS);
 }
 
 static void log_pgps_header(const char *msg, const struct nrf_cloud_pgps_header *header)
@@ -231,10 +248,10 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 	uint16_t period_min = index.header.prediction_period_min;
 	uint16_t gps_day = index.header.gps_day;
 	uint32_t gps_time_of_day = index.header.gps_time_of_day;
-	uint8_t *p = storage;
 	struct nrf_cloud_pgps_prediction *pred;
 	int64_t start_gps_sec = index.start_sec;
 	int64_t gps_sec;
+	int block;
 	int pnum;
 
 	/* reset catalog of predictions */
@@ -244,32 +261,15 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 
 	npgps_reset_block_pool();
 
-	/* build catalog of predictions by block */
-	for (i = 0; i < count; i++) {
-		pred = (struct nrf_cloud_pgps_prediction *)p;
-
-		pnum = determine_prediction_num(&index.header, pred);
-		if (pnum < 0) {
-			LOG_ERR("prediction idx:%u, ofs:%p, out of expected time range;"
-				" day:%u, time:%u", i, p, pred->time.date_day,
-				pred->time.time_full_s);
-		} else if (index.predictions[pnum] == NULL) {
-			index.predictions[pnum] = pred;
-			LOG_DBG("Prediction num:%u stored at idx:%d", pnum, i);
-		} else {
-			LOG_WRN("Prediction num:%u stored more than once!", pnum);
-		}
-		p += PGPS_PREDICTION_STORAGE_SIZE;
-	}
-
-	/* validate predictions in time order, independent of storage order */
+	/* validate predictions in time order, looking each one up in its block */
 	i = -1;
 	for (pnum = 0; pnum < count; pnum++) {
 		/* calculate expected time signature */
 		gps_sec = start_gps_sec + pnum * period_min * SEC_PER_MIN;
 		npgps_gps_sec_to_day_time(gps_sec, &gps_day, &gps_time_of_day);
 
-		pred = index.predictions[pnum];
+		block = prediction_block(gps_sec);
+		pred = (block == NO_BLOCK) ? NULL : npgps_block_to_pointer(block);
 		if (pred == NULL) {
 			LOG_WRN("Prediction num:%u missing", pnum);
 			/* request partial data; download interrupted? */
@@ -290,9 +290,9 @@ static int validate_stored_predictions(uint16_t *first_bad_day,
 			break;
 		}
 
-		i = npgps_pointer_to_block((uint8_t *)pred);
+		index.predictions[pnum] = pred;
+		i = block;
 		LOG_DBG("Prediction num:%u, loc:%p, blk:%d", pnum, pred, i);
-		__ASSERT(i != -1, "unexpected pointer value %p", pred);
 		npgps_mark_block_used(i, true);
 	}
 
@@ -362,6 +362,11 @@ static void discard_oldest_predictions(int num)
 	}
 	npgps_print_blocks();
 
+	/* the current prediction moved down too */
+	if ((index.cur_pnum != 0xff) && (index.cur_pnum >= last)) {
+		index.cur_pnum -= last;
+	}
+
 	/* update index and header for new first stored prediction */
 	get_prediction_day_time(last, &index.start_sec,
 				&index.header.gps_day,
@@ -736,10 +741,20 @@ static int pgps_request_all(void)
 	return pgps_request(&request);
 }
 
+/* Number of prediction blocks in one flash page. Predictions are only
+ * discarded in whole pages, so that writing the replacements does not
+ * erase a page that still holds a valid prediction.
+ */
+static int blocks_per_page(void)
+{
+	return MAX(1, (int)(flash_page_size / BLOCK_SIZE));
+}
+
 int nrf_cloud_pgps_preemptive_updates(void)
 {
 	/* keep unexpired, read newer subsequent to last */
 	struct gps_pgps_request request;
+	int per_page = blocks_per_page();
 	int current = index.cur_pnum;
 	int n = NUM_PREDICTIONS - REPLACEMENT_THRESHOLD;
 	uint16_t period_min = index.header.prediction_period_min;
@@ -751,10 +766,21 @@ int nrf_cloud_pgps_preemptive_updates(void)
 		return -EINVAL;
 	}
 
+	if (nrf_cloud_pgps_loading()) {
+		return 0;
+	}
+
 	if (current == 0xff) {
 		return pgps_request_all();
 	}
 
+	current = (current / per_page) * per_page;
+#if defined(CONFIG_NRF_CLOUD_PGPS_INCREMENTAL_REPLACEMENT)
+	/* replace a few at a time, starting as soon as that many expired */
+	n = MAX(((REPLACEMENT_BATCH + per_page - 1) / per_page) * per_page, per_page);
+	current = MIN(current, n);
+#endif
+
 	if ((current + npgps_num_free()) < n) {
 		LOG_DBG("Updates not needed yet; current:%d, free:%d, n:%d",
 			current, npgps_num_free(), n);
@@ -783,9 +809,50 @@ int nrf_cloud_pgps_preemptive_updates(void)
 	request.prediction_count = npgps_num_free();
 	request.prediction_period_min = period_min;
 
+	if (request.prediction_count == 0) {
+		return 0;
+	}
+
 	return pgps_request(&request);
 }
 
+#if defined(CONFIG_NRF_CLOUD_PGPS_INCREMENTAL_REPLACEMENT)
+static void replacement_work_handler(struct k_work *work)
+{
+	struct nrf_cloud_pgps_prediction *p;
+	int err;
+
+	if (state != PGPS_READY) {
+		return;
+	}
+
+	/* update the current prediction number */
+	err = nrf_cloud_pgps_find_prediction(&p);
+	if (err < 0) {
+		return;
+	}
+
+	err = nrf_cloud_pgps_preemptive_updates();
+	if (err) {
+		LOG_ERR("Error replacing expired predictions:%d", err);
+	}
+}
+
+K_WORK_DEFINE(replacement_work, replacement_work_handler);
+
+AT_MONITOR(pgps_rrc_mode, "+CSCON", on_rrc_mode);
+
+static void on_rrc_mode(const char *notif)
+{
+	const char *mode = strchr(notif, ':');
+
+	/* +CSCON: 1 means the radio is up; use it to replace predictions */
+	if ((mode != NULL) && (atoi(mode + 1) == 1)) {
+		k_work_submit(&replacement_work);
+	}
+}
+#endif /* CONFIG_NRF_CLOUD_PGPS_INCREMENTAL_REPLACEMENT */
+
 int nrf_cloud_pgps_inject(struct nrf_cloud_pgps_prediction *p,
 			  const struct gps_agps_request *request)
 {
@@ -1265,7 +1332,8 @@ static int consume_pgps_data(uint8_t pnum, const char *buf, size_t buf_len)
 			index.loading_count++;
 			finished = (index.loading_count == index.expected_count);
 			store_prediction(prediction_ptr, buf_len, (uint32_t)gps_sec,
-					 finished || (index.storage_extent == 1));
+					 finished || (index.store_block == (NUM_BLOCKS - 1)));
+			npgps_mark_block_used(index.store_block, true);
 			index.predictions[pnum] = npgps_block_to_pointer(index.store_block);
 
 			if (pgps_need_assistance &&
@@ -1295,16 +1363,10 @@ static int consume_pgps_data(uint8_t pnum, const char *buf, size_t buf_len)
 				return 0;
 			}
 
-			index.store_block = npgps_alloc_block();
-			if (index.store_block == NO_BLOCK) {
-				LOG_ERR("No more free blocks!");
-				return -ENOMEM;
-			}
-			index.storage_extent--;
-			if (index.storage_extent == 0) {
-				index.storage_extent = npgps_get_block_extent(index.store_block);
-				LOG_INF("Moving to new flash region:%d, len:%d",
-					index.store_block, index.storage_extent);
+			/* the next prediction goes in the next block */
+			index.store_block = (index.store_block + 1) % NUM_BLOCKS;
+			if (index.store_block == 0) {
+				LOG_INF("Wrapping around to start of flash region");
 				err = flush_storage();
 				if (err) {
 					LOG_ERR("Error flushing storage:%d", err);
@@ -1380,14 +1442,19 @@ int nrf_cloud_pgps_process(const char *buf, size_t buf_len)
 			}
 		}
 		index.loading_count = 0;
-		index.store_block = npgps_alloc_block();
-		if (index.store_block == NO_BLOCK) {
-			LOG_ERR("No free flash space!");
-			return -ENOMEM;
+		if (index.partial_request) {
+			/* continue the table at the block of the first requested one */
+			index.store_block = prediction_block(index.start_sec +
+					      index.pnum_offset * index.period_sec);
+			if (index.store_block == NO_BLOCK) {
+				LOG_WRN("Stored predictions not in table; starting over");
+				index.store_block = 0;
+			}
+		} else {
+			/* a full set starts the table over at block 0 */
+			index.store_block = 0;
 		}
-		index.storage_extent = npgps_get_block_extent(index.store_block);
-		LOG_INF("opening storage at block:%d, len:%d", index.store_block,
-			index.storage_extent);
+		LOG_INF("opening storage at block:%d", index.store_block);
 		err = open_storage(npgps_block_to_offset(index.store_block),
 				   index.partial_request);
 		if (err) {
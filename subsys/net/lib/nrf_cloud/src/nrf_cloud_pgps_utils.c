@@ -279,25 +279,6 @@ int ngps_block_pool_init(uint32_t base_address, int num)
 	return 0;
 }
 
-int npgps_alloc_block(void)
-{
-	int idx;
-
-	if (pool.first_free < 0) {
-		LOG_DBG("no blocks");
-		return NO_BLOCK;
-	}
-
-	idx = pool.first_free;
-	pool.block_used[pool.first_free] = true;
-	pool.first_free = (pool.first_free + 1) % num_blocks;
-	if (pool.block_used[pool.first_free]) {
-		pool.first_free = NO_BLOCK;
-	}
-	LOG_DBG("alloc:%d", idx);
-	return idx;
-}
-
 void npgps_free_block(int block)
 {
 	LOG_DBG("free:%d", block);
@@ -307,21 +288,6 @@ void npgps_free_block(int block)
 	pool.block_used[block] = false;
 }
 
-int npgps_get_block_extent(int block)
-{
-	int i;
-	int len = 0;
-
-	for (i = 0; i < num_blocks; i++) {
-		if (pool.block_used[block]) {
-			break;
-		}
-		block = (block + 1) % num_blocks;
-		len++;
-	}
-	return len;
-}
-
 void npgps_reset_block_pool(void)
 {
 	int i;
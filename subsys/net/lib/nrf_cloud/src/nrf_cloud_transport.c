@@ -18,6 +18,7 @@
 #include <net/cloud.h>
 #include <logging/log.h>
 #include <sys/util.h>
+#include <sys/slist.h>
 #include <settings/settings.h>
 #include <modem/at_cmd.h>
 #if defined(CONFIG_NRF_MODEM_LIB)
@@ -51,6 +52,7 @@ BUILD_ASSERT(IMEI_CLIENT_ID_LEN <= NRF_CLOUD_CLIENT_ID_MAX_LEN,
 #endif
 
 #define NRF_CLOUD_HOSTNAME CONFIG_NRF_CLOUD_HOST_NAME
+#define NCT_BULK_TOPIC_SUFFIX "/bulk"
 #define NRF_CLOUD_PORT CONFIG_NRF_CLOUD_PORT
 
 #if defined(CONFIG_NRF_CLOUD_IPV6)
@@ -82,7 +84,13 @@ static char tenant[NRF_CLOUD_TENANT_ID_MAX_LEN];
 /* Null-terminated MQTT client ID */
 static char *client_id_buf;
 
-/* Buffers for keeping the topics for nrf_cloud */
+/* The topics for nrf_cloud, formatted once into a single arena. Each
+ * template has a "%s" for the client ID, which accounts for the terminator.
+ */
+#define NCT_TOPIC_ARENA_SIZE (sizeof(NCT_ACCEPTED_TOPIC) + sizeof(NCT_REJECTED_TOPIC) + \
+			      sizeof(NCT_UPDATE_DELTA_TOPIC) + sizeof(NCT_UPDATE_TOPIC) + \
+			      sizeof(NCT_SHADOW_GET) + 5 * NRF_CLOUD_CLIENT_ID_MAX_LEN)
+static char topic_arena[NCT_TOPIC_ARENA_SIZE];
 static char *accepted_topic;
 static char *rejected_topic;
 static char *update_delta_topic;
@@ -92,9 +100,6 @@ static char *shadow_get_topic;
 static bool mqtt_client_initialized;
 static bool persistent_session;
 
-#define NCT_RX_LIST 0
-#define NCT_TX_LIST 1
-
 static int nct_settings_set(const char *key, size_t len_rd,
 			    settings_read_cb read_cb, void *cb_arg);
 
@@ -119,6 +124,12 @@ static struct nct {
 	struct mqtt_utf8 dc_tx_endp;
 	struct mqtt_utf8 dc_rx_endp;
 	struct mqtt_utf8 dc_m_endp;
+#if defined(CONFIG_NRF_CLOUD_CBOR)
+	struct mqtt_utf8 dc_tx_cbor_endp;
+#endif
+#if defined(CONFIG_NRF_CLOUD_MQTT_TX_QUEUE_BULK)
+	struct mqtt_utf8 dc_tx_bulk_endp;
+#endif
 	uint16_t message_id;
 	uint8_t rx_buf[CONFIG_NRF_CLOUD_MQTT_MESSAGE_BUFFER_LEN];
 	uint8_t tx_buf[CONFIG_NRF_CLOUD_MQTT_MESSAGE_BUFFER_LEN];
@@ -127,6 +138,8 @@ static struct nct {
 
 #define CC_RX_LIST_CNT 3
 static struct mqtt_topic nct_cc_rx_list[CC_RX_LIST_CNT];
+/* Hashes of the RX topics, to dispatch incoming messages */
+static uint32_t nct_cc_rx_hash[CC_RX_LIST_CNT];
 #define CC_TX_LIST_CNT 2
 static struct mqtt_topic nct_cc_tx_list[CC_TX_LIST_CNT];
 
@@ -147,6 +160,16 @@ static void dc_endpoint_reset(void)
 
 	nct.dc_m_endp.utf8 = NULL;
 	nct.dc_m_endp.size = 0;
+
+#if defined(CONFIG_NRF_CLOUD_CBOR)
+	nct.dc_tx_cbor_endp.utf8 = NULL;
+	nct.dc_tx_cbor_endp.size = 0;
+#endif
+
+#if defined(CONFIG_NRF_CLOUD_MQTT_TX_QUEUE_BULK)
+	nct.dc_tx_bulk_endp.utf8 = NULL;
+	nct.dc_tx_bulk_endp.size = 0;
+#endif
 }
 
 /* Get the next unused message id. */
@@ -189,18 +212,24 @@ static void dc_endpoint_free(void)
 	if (nct.dc_m_endp.utf8 != NULL) {
 		nrf_cloud_free((void *)nct.dc_m_endp.utf8);
 	}
+#if defined(CONFIG_NRF_CLOUD_CBOR)
+	if (nct.dc_tx_cbor_endp.utf8 != NULL) {
+		nrf_cloud_free((void *)nct.dc_tx_cbor_endp.utf8);
+	}
+#endif
+#if defined(CONFIG_NRF_CLOUD_MQTT_TX_QUEUE_BULK)
+	if (nct.dc_tx_bulk_endp.utf8 != NULL) {
+		nrf_cloud_free((void *)nct.dc_tx_bulk_endp.utf8);
+	}
+#endif
 	dc_endpoint_reset();
 #if defined(CONFIG_NRF_CLOUD_FOTA)
 	nrf_cloud_fota_endpoint_clear();
 #endif
 }
 
-static uint32_t dc_send(const struct nct_dc_data *dc_data, uint8_t qos)
+static int dc_publish(const struct nct_dc_data *dc_data, uint8_t qos)
 {
-	if (dc_data == NULL) {
-		return -EINVAL;
-	}
-
 	struct mqtt_publish_param publish = {
 		.message_id = 0,
 		.message.topic.qos = qos,
@@ -208,6 +237,12 @@ static uint32_t dc_send(const struct nct_dc_data *dc_data, uint8_t qos)
 		.message.topic.topic.utf8 = nct.dc_tx_endp.utf8,
 	};
 
+	/* Use the topic of the message, if any. */
+	if (dc_data->topic.ptr != NULL) {
+		publish.message.topic.topic.size = dc_data->topic.len;
+		publish.message.topic.topic.utf8 = dc_data->topic.ptr;
+	}
+
 	/* Populate payload. */
 	if ((dc_data->data.len != 0) && (dc_data->data.ptr != NULL)) {
 		publish.message.payload.data = (uint8_t *)dc_data->data.ptr;
@@ -221,34 +256,243 @@ static uint32_t dc_send(const struct nct_dc_data *dc_data, uint8_t qos)
 	return mqtt_publish(&nct.client, &publish);
 }
 
-static bool strings_compare(const char *s1, const char *s2, uint32_t s1_len,
-			    uint32_t s2_len)
+#if defined(CONFIG_NRF_CLOUD_MQTT_TX_QUEUE)
+/* Device message waiting for the data channel. */
+struct tx_queue_entry {
+	sys_snode_t node;
+	size_t len;
+	uint16_t message_id;
+	uint8_t qos;
+	/* Published on the CBOR data topic */
+	bool cbor;
+	uint8_t data[];
+};
+
+static sys_slist_t tx_queue = SYS_SLIST_STATIC_INIT(&tx_queue);
+static size_t tx_queue_bytes;
+static K_MUTEX_DEFINE(tx_queue_mutex);
+static atomic_t dc_connected;
+
+static int tx_queue_put(const struct nct_dc_data *dc_data, uint8_t qos)
+{
+	struct tx_queue_entry *entry;
+	size_t len = dc_data->data.len;
+
+	if (tx_queue_bytes + len > CONFIG_NRF_CLOUD_MQTT_TX_QUEUE_SIZE) {
+		LOG_WRN("TX queue full, message of %zu bytes rejected", len);
+		return -ENOMEM;
+	}
+
+	entry = nrf_cloud_malloc(sizeof(*entry) + len);
+	if (entry == NULL) {
+		return -ENOMEM;
+	}
+
+	entry->len = len;
+	entry->message_id = dc_data->message_id;
+	entry->qos = qos;
+	entry->cbor = (dc_data->topic.ptr != NULL);
+	memcpy(entry->data, dc_data->data.ptr, len);
+
+	sys_slist_append(&tx_queue, &entry->node);
+	tx_queue_bytes += len;
+
+	LOG_DBG("Queued message of %zu bytes, %zu bytes queued", len,
+		tx_queue_bytes);
+
+	return 0;
+}
+
+static void tx_queue_drop(int count)
+{
+	struct tx_queue_entry *entry;
+
+	while (count-- > 0) {
+		entry = CONTAINER_OF(sys_slist_get_not_empty(&tx_queue),
+				     struct tx_queue_entry, node);
+		tx_queue_bytes -= entry->len;
+		nrf_cloud_free(entry);
+	}
+}
+
+#if defined(CONFIG_NRF_CLOUD_MQTT_TX_QUEUE_BULK)
+/* Publish the consecutive JSON messages at the head of the queue as one
+ * JSON array on the bulk topic. Returns the number of messages sent, which
+ * is 0 if there are fewer than two of them.
+ */
+static int tx_queue_bulk_send(void)
+{
+	struct tx_queue_entry *entry;
+	struct nct_dc_data bulk = {
+		.topic.ptr = nct.dc_tx_bulk_endp.utf8,
+		.topic.len = nct.dc_tx_bulk_endp.size,
+		.message_id = NCT_MSG_ID_USE_NEXT_INCREMENT,
+	};
+	size_t len = 1;
+	char *buf;
+	int count = 0;
+	int err;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tx_queue, entry, node) {
+		if (entry->cbor) {
+			break;
+		}
+		len += entry->len + 1;
+		count++;
+	}
+
+	if ((count < 2) || (bulk.topic.ptr == NULL)) {
+		return 0;
+	}
+
+	buf = nrf_cloud_malloc(len);
+	if (buf == NULL) {
+		return 0;
+	}
+
+	len = 0;
+	buf[len++] = '[';
+	SYS_SLIST_FOR_EACH_CONTAINER(&tx_queue, entry, node) {
+		if (entry->cbor) {
+			break;
+		}
+		memcpy(&buf[len], entry->data, entry->len);
+		len += entry->len;
+		buf[len++] = ',';
+	}
+	buf[len - 1] = ']';
+
+	bulk.data.ptr = buf;
+	bulk.data.len = len;
+
+	err = dc_publish(&bulk, MQTT_QOS_1_AT_LEAST_ONCE);
+	nrf_cloud_free(buf);
+	if (err) {
+		return err;
+	}
+
+	LOG_DBG("Published %d queued messages in bulk", count);
+
+	return count;
+}
+#endif /* CONFIG_NRF_CLOUD_MQTT_TX_QUEUE_BULK */
+
+/* Publish the queued messages, in order. Messages that cannot be published
+ * stay queued for the next connection.
+ */
+static void tx_queue_flush(void)
+{
+	struct tx_queue_entry *entry;
+	int err;
+
+	k_mutex_lock(&tx_queue_mutex, K_FOREVER);
+
+	while (atomic_get(&dc_connected) && !sys_slist_is_empty(&tx_queue)) {
+#if defined(CONFIG_NRF_CLOUD_MQTT_TX_QUEUE_BULK)
+		err = tx_queue_bulk_send();
+		if (err < 0) {
+			LOG_ERR("Failed to publish queued messages: %d", err);
+			break;
+		} else if (err > 0) {
+			tx_queue_drop(err);
+			continue;
+		}
+#endif
+		entry = SYS_SLIST_PEEK_HEAD_CONTAINER(&tx_queue, entry, node);
+
+		struct nct_dc_data dc_data = {
+			.data.ptr = entry->data,
+			.data.len = entry->len,
+			.message_id = entry->message_id,
+		};
+
+		if (entry->cbor) {
+			nct_dc_cbor_endpoint_get(&dc_data.topic);
+			if (dc_data.topic.ptr == NULL) {
+				LOG_WRN("No CBOR data topic, queued message dropped");
+				tx_queue_drop(1);
+				continue;
+			}
+		}
+
+		err = dc_publish(&dc_data, entry->qos);
+		if (err) {
+			LOG_ERR("Failed to publish queued message: %d", err);
+			break;
+		}
+
+		tx_queue_drop(1);
+	}
+
+	k_mutex_unlock(&tx_queue_mutex);
+}
+
+static void tx_queue_clear(void)
+{
+	k_mutex_lock(&tx_queue_mutex, K_FOREVER);
+	while (!sys_slist_is_empty(&tx_queue)) {
+		tx_queue_drop(1);
+	}
+	k_mutex_unlock(&tx_queue_mutex);
+}
+#endif /* CONFIG_NRF_CLOUD_MQTT_TX_QUEUE */
+
+static int dc_send(const struct nct_dc_data *dc_data, uint8_t qos)
 {
-	return (strncmp(s1, s2, MIN(s1_len, s2_len))) ? false : true;
+	if (dc_data == NULL) {
+		return -EINVAL;
+	}
+
+#if defined(CONFIG_NRF_CLOUD_MQTT_TX_QUEUE)
+	int err;
+
+	k_mutex_lock(&tx_queue_mutex, K_FOREVER);
+
+	/* Queue behind earlier messages, to keep them in order */
+	if (!atomic_get(&dc_connected) || !sys_slist_is_empty(&tx_queue)) {
+		err = tx_queue_put(dc_data, qos);
+		k_mutex_unlock(&tx_queue_mutex);
+		tx_queue_flush();
+		return err;
+	}
+
+	err = dc_publish(dc_data, qos);
+	if ((err == -ENOTCONN) || (err == -ECONNRESET) || (err == -EPIPE)) {
+		err = tx_queue_put(dc_data, qos);
+	}
+
+	k_mutex_unlock(&tx_queue_mutex);
+
+	return err;
+#else
+	return dc_publish(dc_data, qos);
+#endif
+}
+
+/* FNV-1a hash of a topic. */
+static uint32_t topic_hash(const uint8_t *topic, uint32_t len)
+{
+	uint32_t hash = 2166136261U;
+
+	while (len--) {
+		hash ^= *topic++;
+		hash *= 16777619U;
+	}
+
+	return hash;
 }
 
 /* Verify if the topic is a control channel topic or not. */
-static bool control_channel_topic_match(uint32_t list_id,
-					const struct mqtt_topic *topic,
+static bool control_channel_topic_match(const struct mqtt_topic *topic,
 					enum nct_cc_opcode *opcode)
 {
-	struct mqtt_topic *topic_list;
-	uint32_t list_size;
-
-	if (list_id == NCT_RX_LIST) {
-		topic_list = (struct mqtt_topic *)nct_cc_rx_list;
-		list_size = ARRAY_SIZE(nct_cc_rx_list);
-	} else if (list_id == NCT_TX_LIST) {
-		topic_list = (struct mqtt_topic *)nct_cc_tx_list;
-		list_size = ARRAY_SIZE(nct_cc_tx_list);
-	} else {
-		return false;
-	}
+	uint32_t hash = topic_hash(topic->topic.utf8, topic->topic.size);
 
-	for (uint32_t index = 0; index < list_size; index++) {
-		if (strings_compare(
-			    topic->topic.utf8, topic_list[index].topic.utf8,
-			    topic->topic.size, topic_list[index].topic.size)) {
+	for (uint32_t index = 0; index < CC_RX_LIST_CNT; index++) {
+		if ((hash == nct_cc_rx_hash[index]) &&
+		    (topic->topic.size == nct_cc_rx_list[index].topic.size) &&
+		    (memcmp(topic->topic.utf8, nct_cc_rx_list[index].topic.utf8,
+			    topic->topic.size) == 0)) {
 			*opcode = nct_cc_rx_opcode_map[index];
 			return true;
 		}
@@ -409,52 +653,34 @@ void nct_set_topic_prefix(const char *topic_prefix)
 	}
 }
 
-static int allocate_and_format_topic(char **topic_buf, const char * const topic_template)
+static int format_topic(char **topic_buf, const char * const topic_template,
+			size_t *arena_used)
 {
 	int ret;
-	size_t topic_sz;
-	const size_t client_sz = strlen(client_id_buf);
-
-	topic_sz = client_sz + strlen(topic_template) - 1;
+	char *topic = &topic_arena[*arena_used];
+	size_t topic_sz = sizeof(topic_arena) - *arena_used;
 
-	*topic_buf = nrf_cloud_calloc(topic_sz, 1);
-	if (!*topic_buf) {
-		return -ENOMEM;
-	}
-	ret = snprintf(*topic_buf, topic_sz,
-		       topic_template, client_id_buf);
+	ret = snprintf(topic, topic_sz, topic_template, client_id_buf);
 	if (ret <= 0 || ret >= topic_sz) {
-		nrf_cloud_free(*topic_buf);
 		return -EIO;
 	}
 
+	*topic_buf = topic;
+	*arena_used += ret + 1;
+
 	return 0;
 }
 
 static void nct_reset_topics(void)
 {
-	if (accepted_topic) {
-		nrf_cloud_free(accepted_topic);
-		accepted_topic = NULL;
-	}
-	if (rejected_topic) {
-		nrf_cloud_free(rejected_topic);
-		rejected_topic = NULL;
-	}
-	if (update_delta_topic) {
-		nrf_cloud_free(update_delta_topic);
-		update_delta_topic = NULL;
-	}
-	if (update_topic) {
-		nrf_cloud_free(update_topic);
-		update_topic = NULL;
-	}
-	if (shadow_get_topic) {
-		nrf_cloud_free(shadow_get_topic);
-		shadow_get_topic = NULL;
-	}
+	accepted_topic = NULL;
+	rejected_topic = NULL;
+	update_delta_topic = NULL;
+	update_topic = NULL;
+	shadow_get_topic = NULL;
 
 	memset(nct_cc_rx_list, 0, sizeof(nct_cc_rx_list[0]) * CC_RX_LIST_CNT);
+	memset(nct_cc_rx_hash, 0, sizeof(nct_cc_rx_hash));
 	memset(nct_cc_tx_list, 0, sizeof(nct_cc_tx_list[0]) * CC_TX_LIST_CNT);
 }
 
@@ -473,6 +699,11 @@ static void nct_topic_lists_populate(void)
 	nct_cc_rx_list[2].topic.utf8 = update_delta_topic;
 	nct_cc_rx_list[2].topic.size = strlen(update_delta_topic);
 
+	for (int i = 0; i < CC_RX_LIST_CNT; i++) {
+		nct_cc_rx_hash[i] = topic_hash(nct_cc_rx_list[i].topic.utf8,
+					       nct_cc_rx_list[i].topic.size);
+	}
+
 	/* Add TX topics */
 	nct_cc_tx_list[0].qos = MQTT_QOS_1_AT_LEAST_ONCE;
 	nct_cc_tx_list[0].topic.utf8 = shadow_get_topic;
@@ -490,26 +721,27 @@ static int nct_topics_populate(void)
 	}
 
 	int ret;
+	size_t arena_used = 0;
 
 	nct_reset_topics();
 
-	ret = allocate_and_format_topic(&accepted_topic, NCT_ACCEPTED_TOPIC);
+	ret = format_topic(&accepted_topic, NCT_ACCEPTED_TOPIC, &arena_used);
 	if (ret) {
 		goto err_cleanup;
 	}
-	ret = allocate_and_format_topic(&rejected_topic, NCT_REJECTED_TOPIC);
+	ret = format_topic(&rejected_topic, NCT_REJECTED_TOPIC, &arena_used);
 	if (ret) {
 		goto err_cleanup;
 	}
-	ret = allocate_and_format_topic(&update_delta_topic, NCT_UPDATE_DELTA_TOPIC);
+	ret = format_topic(&update_delta_topic, NCT_UPDATE_DELTA_TOPIC, &arena_used);
 	if (ret) {
 		goto err_cleanup;
 	}
-	ret = allocate_and_format_topic(&update_topic, NCT_UPDATE_TOPIC);
+	ret = format_topic(&update_topic, NCT_UPDATE_TOPIC, &arena_used);
 	if (ret) {
 		goto err_cleanup;
 	}
-	ret = allocate_and_format_topic(&shadow_get_topic, NCT_SHADOW_GET);
+	ret = format_topic(&shadow_get_topic, NCT_SHADOW_GET, &arena_used);
 	if (ret) {
 		goto err_cleanup;
 	}
@@ -891,8 +1123,7 @@ static void nct_mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 		/* If the data arrives on one of the subscribed control channel
 		 * topic. Then we notify the same.
 		 */
-		if (control_channel_topic_match(NCT_RX_LIST, &p->message.topic,
-						&cc.opcode)) {
+		if (control_channel_topic_match(&p->message.topic, &cc.opcode)) {
 			cc.message_id = p->message_id;
 			cc.data.ptr = nct.payload_buf;
 			cc.data.len = p->message.payload.len;
@@ -937,6 +1168,12 @@ static void nct_mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 			evt.type = NCT_EVT_DC_CONNECTED;
 			event_notify = true;
 
+#if defined(CONFIG_NRF_CLOUD_MQTT_TX_QUEUE)
+			/* Replay messages queued while disconnected */
+			atomic_set(&dc_connected, 1);
+			tx_queue_flush();
+#endif
+
 			/* Subscribing complete, session is now valid */
 			err = nct_save_session_state(1);
 			if (err) {
@@ -973,6 +1210,10 @@ static void nct_mqtt_evt_handler(struct mqtt_client *const mqtt_client,
 	case MQTT_EVT_DISCONNECT: {
 		LOG_DBG("MQTT_EVT_DISCONNECT: result = %d", _mqtt_evt->result);
 
+#if defined(CONFIG_NRF_CLOUD_MQTT_TX_QUEUE)
+		atomic_set(&dc_connected, 0);
+#endif
+
 		evt.type = NCT_EVT_DISCONNECTED;
 		event_notify = true;
 		break;
@@ -1028,6 +1269,10 @@ int nct_init(const char * const client_id)
 
 void nct_uninit(void)
 {
+#if defined(CONFIG_NRF_CLOUD_MQTT_TX_QUEUE)
+	atomic_set(&dc_connected, 0);
+	tx_queue_clear();
+#endif
 	dc_endpoint_free();
 	nct_reset_topics();
 
@@ -1200,6 +1445,25 @@ int nct_cc_disconnect(void)
 	return mqtt_unsubscribe(&nct.client, &subscription_list);
 }
 
+static __maybe_unused int endpoint_with_suffix(const struct nrf_cloud_data *endp,
+					       const char *suffix,
+					       struct mqtt_utf8 *out)
+{
+	size_t suffix_len = strlen(suffix);
+	char *buf = nrf_cloud_malloc(endp->len + suffix_len + 1);
+
+	if (buf == NULL) {
+		return -ENOMEM;
+	}
+
+	memcpy(buf, endp->ptr, endp->len);
+	memcpy(buf + endp->len, suffix, suffix_len + 1);
+	out->utf8 = (const uint8_t *)buf;
+	out->size = endp->len + suffix_len;
+
+	return 0;
+}
+
 void nct_dc_endpoint_set(const struct nrf_cloud_data *tx_endp,
 			 const struct nrf_cloud_data *rx_endp,
 			 const struct nrf_cloud_data *m_endp)
@@ -1217,6 +1481,19 @@ void nct_dc_endpoint_set(const struct nrf_cloud_data *tx_endp,
 	nct.dc_rx_endp.utf8 = (const uint8_t *)rx_endp->ptr;
 	nct.dc_rx_endp.size = rx_endp->len;
 
+#if defined(CONFIG_NRF_CLOUD_CBOR)
+	if (endpoint_with_suffix(tx_endp, CONFIG_NRF_CLOUD_CBOR_TOPIC_SUFFIX,
+				 &nct.dc_tx_cbor_endp)) {
+		LOG_WRN("No memory for the CBOR data topic, using JSON");
+	}
+#endif
+#if defined(CONFIG_NRF_CLOUD_MQTT_TX_QUEUE_BULK)
+	if (endpoint_with_suffix(tx_endp, NCT_BULK_TOPIC_SUFFIX,
+				 &nct.dc_tx_bulk_endp)) {
+		LOG_WRN("No memory for the bulk data topic");
+	}
+#endif
+
 	if (m_endp != NULL) {
 		nct.dc_m_endp.utf8 = (const uint8_t *)m_endp->ptr;
 		nct.dc_m_endp.size = m_endp->len;
@@ -1233,6 +1510,17 @@ void nct_dc_endpoint_set(const struct nrf_cloud_data *tx_endp,
 	}
 }
 
+void nct_dc_cbor_endpoint_get(struct nrf_cloud_topic *const cbor_endp)
+{
+#if defined(CONFIG_NRF_CLOUD_CBOR)
+	cbor_endp->ptr = nct.dc_tx_cbor_endp.utf8;
+	cbor_endp->len = nct.dc_tx_cbor_endp.size;
+#else
+	cbor_endp->ptr = NULL;
+	cbor_endp->len = 0;
+#endif
+}
+
 void nct_dc_endpoint_get(struct nrf_cloud_data *const tx_endp,
 			 struct nrf_cloud_data *const rx_endp,
 			 struct nrf_cloud_data *const m_endp)
@@ -1288,6 +1576,10 @@ int nct_dc_disconnect(void)
 
 	LOG_DBG("nct_dc_disconnect");
 
+#if defined(CONFIG_NRF_CLOUD_MQTT_TX_QUEUE)
+	atomic_set(&dc_connected, 0);
+#endif
+
 	const struct mqtt_subscription_list subscription_list = {
 		.list = (struct mqtt_topic *)&nct.dc_rx_endp,
 		.list_count = 1,
@@ -233,18 +233,15 @@ int nfc_ndef_ch_ac_rec_auxiliary_data_ref_add(struct nfc_ndef_record_desc *ac_re
 int nfc_ndef_ch_cr_rec_payload_encode(const struct nfc_ndef_ch_cr_rec *nfc_rec_cr,
 				      uint8_t *buf, uint32_t *len)
 {
-	uint32_t payload_size = 0;
-
 	if (buf) {
 		if (sizeof(nfc_rec_cr->random) > *len) {
 			return -ENOMEM;
 		}
 
 		sys_put_be16(nfc_rec_cr->random, buf);
-		payload_size += sizeof(nfc_rec_cr->random);
 	}
 
-	*len = payload_size;
+	*len = sizeof(nfc_rec_cr->random);
 
 	return 0;
 }
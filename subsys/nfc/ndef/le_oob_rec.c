@@ -23,6 +23,13 @@ static int bt_data_encode(struct bt_data *ad, uint8_t **buff, size_t *size)
 		return -ENOMEM;
 	}
 
+	*size -= ad_len;
+
+	/* Only calculate the payload size. */
+	if (!*buff) {
+		return 0;
+	}
+
 	**buff = ad->data_len + AD_TYPE_FIELD_SIZE;
 	*buff += AD_LEN_FIELD_SIZE;
 
@@ -32,8 +39,6 @@ static int bt_data_encode(struct bt_data *ad, uint8_t **buff, size_t *size)
 	memcpy(*buff, ad->data, ad->data_len);
 	*buff += ad->data_len;
 
-	*size -= ad_len;
-
 	return 0;
 }
 
@@ -90,7 +95,8 @@ int nfc_ndef_le_oob_rec_payload_constructor(
 	uint32_t *len)
 {
 	int err;
-	size_t rem_size = *len;
+	const size_t max_size = buff ? *len : SIZE_MAX;
+	size_t rem_size = max_size;
 
 	if (!payload_desc || !payload_desc->addr || !payload_desc->le_role) {
 		return -EINVAL;
@@ -186,7 +192,7 @@ int nfc_ndef_le_oob_rec_payload_constructor(
 		}
 	}
 
-	*len = *len - rem_size;
+	*len = max_size - rem_size;
 
 	return 0;
 }
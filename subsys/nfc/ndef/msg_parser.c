@@ -3,6 +3,7 @@
  *
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
+#include <errno.h>
 #include <logging/log.h>
 #include "msg_parser_local.h"
 
@@ -31,6 +32,56 @@ int nfc_ndef_msg_parse(const uint8_t *result_buf,
 	return err;
 }
 
+void nfc_ndef_msg_iter_init(struct nfc_ndef_msg_iter *iter,
+			    const uint8_t *raw_data,
+			    uint32_t raw_data_len)
+{
+	iter->data = raw_data;
+	iter->data_len = raw_data_len;
+	iter->record_count = 0;
+	iter->end = false;
+}
+
+int nfc_ndef_msg_iter_next(struct nfc_ndef_msg_iter *iter,
+			   struct nfc_ndef_record_view *view)
+{
+	uint32_t rec_len = iter->data_len;
+	int err;
+
+	if (iter->end) {
+		return -ENOENT;
+	}
+
+	if (iter->data_len == 0) {
+		return -EFAULT;
+	}
+
+	err = nfc_ndef_record_view_parse(view, iter->data, &rec_len);
+	if (err) {
+		return err;
+	}
+
+	/* Verify the records location flags. */
+	if (iter->record_count == 0) {
+		if ((view->location != NDEF_FIRST_RECORD) &&
+		    (view->location != NDEF_LONE_RECORD)) {
+			return -EFAULT;
+		}
+	} else {
+		if ((view->location != NDEF_MIDDLE_RECORD) &&
+		    (view->location != NDEF_LAST_RECORD)) {
+			return -EFAULT;
+		}
+	}
+
+	iter->data += rec_len;
+	iter->data_len -= rec_len;
+	iter->record_count++;
+	iter->end = ((view->location == NDEF_LAST_RECORD) ||
+		     (view->location == NDEF_LONE_RECORD));
+
+	return 0;
+}
 
 void nfc_ndef_msg_printout(const struct nfc_ndef_msg_desc *msg_desc)
 {
@@ -19,11 +19,9 @@ LOG_MODULE_DECLARE(nfc_ndef_parser, CONFIG_NFC_NDEF_PARSER_LOG_LEVEL);
 #define NDEF_RECORD_BASE_SHORT_LEN (2 + NDEF_RECORD_PAYLOAD_LEN_SHORT_SIZE)
 
 
-int nfc_ndef_record_parse(struct nfc_ndef_bin_payload_desc *bin_pay_desc,
-			  struct nfc_ndef_record_desc *rec_desc,
-			  enum nfc_ndef_record_location *record_location,
-			  const uint8_t *nfc_data,
-			  uint32_t *nfc_data_len)
+int nfc_ndef_record_view_parse(struct nfc_ndef_record_view *view,
+			       const uint8_t *nfc_data,
+			       uint32_t *nfc_data_len)
 {
 	uint32_t expected_rec_size = NDEF_RECORD_BASE_SHORT_LEN;
 
@@ -31,21 +29,21 @@ int nfc_ndef_record_parse(struct nfc_ndef_bin_payload_desc *bin_pay_desc,
 		return -EINVAL;
 	}
 
-	rec_desc->tnf = (enum nfc_ndef_record_tnf) ((*nfc_data) & NDEF_RECORD_TNF_MASK);
+	view->tnf = (enum nfc_ndef_record_tnf) ((*nfc_data) & NDEF_RECORD_TNF_MASK);
 
 	/* An NDEF parser that receives an NDEF record with an unknown
 	 * or unsupported TNF field value
 	 * SHOULD treat it as Unknown. See NFCForum-TS-NDEF_1.0
 	 */
-	if (rec_desc->tnf == TNF_RESERVED) {
-		rec_desc->tnf = TNF_UNKNOWN_TYPE;
+	if (view->tnf == TNF_RESERVED) {
+		view->tnf = TNF_UNKNOWN_TYPE;
 	}
 
-	*record_location = (enum nfc_ndef_record_location) ((*nfc_data) & NDEF_RECORD_LOCATION_MASK);
+	view->location = (enum nfc_ndef_record_location) ((*nfc_data) & NDEF_RECORD_LOCATION_MASK);
 
 	uint8_t flags = *(nfc_data++);
 
-	rec_desc->type_length = *(nfc_data++);
+	view->type_length = *(nfc_data++);
 
 	uint32_t payload_length;
 
@@ -70,42 +68,72 @@ int nfc_ndef_record_parse(struct nfc_ndef_bin_payload_desc *bin_pay_desc,
 			return -EINVAL;
 		}
 
-		rec_desc->id_length = *(nfc_data++);
+		view->id_length = *(nfc_data++);
 	} else {
-		rec_desc->id_length = 0;
-		rec_desc->id        = NULL;
+		view->id_length = 0;
+		view->id        = NULL;
 	}
 
-	expected_rec_size += rec_desc->type_length + rec_desc->id_length + payload_length;
-
-	if (expected_rec_size > *nfc_data_len) {
+	/* Compare in 64 bits, a long payload length can wrap the sum. */
+	if ((uint64_t)expected_rec_size + view->type_length + view->id_length +
+	    payload_length > *nfc_data_len) {
 		return -EINVAL;
 	}
 
-	if (rec_desc->type_length > 0) {
-		rec_desc->type = nfc_data;
-		nfc_data += rec_desc->type_length;
+	expected_rec_size += view->type_length + view->id_length + payload_length;
+
+	if (view->type_length > 0) {
+		view->type = nfc_data;
+		nfc_data += view->type_length;
 	} else {
-		rec_desc->type = NULL;
+		view->type = NULL;
 	}
 
-	if (rec_desc->id_length > 0) {
-		rec_desc->id = nfc_data;
-		nfc_data += rec_desc->id_length;
+	if (view->id_length > 0) {
+		view->id = nfc_data;
+		nfc_data += view->id_length;
 	}
 
 	if (payload_length == 0) {
-		bin_pay_desc->payload = NULL;
+		view->payload = NULL;
 	} else {
-		bin_pay_desc->payload = nfc_data;
+		view->payload = nfc_data;
 	}
 
-	bin_pay_desc->payload_length = payload_length;
+	view->payload_length = payload_length;
+
+	*nfc_data_len = expected_rec_size;
+
+	return 0;
+}
+
+int nfc_ndef_record_parse(struct nfc_ndef_bin_payload_desc *bin_pay_desc,
+			  struct nfc_ndef_record_desc *rec_desc,
+			  enum nfc_ndef_record_location *record_location,
+			  const uint8_t *nfc_data,
+			  uint32_t *nfc_data_len)
+{
+	struct nfc_ndef_record_view view;
+	int err;
+
+	err = nfc_ndef_record_view_parse(&view, nfc_data, nfc_data_len);
+	if (err) {
+		return err;
+	}
+
+	rec_desc->tnf = view.tnf;
+	rec_desc->type_length = view.type_length;
+	rec_desc->type = view.type;
+	rec_desc->id_length = view.id_length;
+	rec_desc->id = view.id;
+
+	bin_pay_desc->payload = view.payload;
+	bin_pay_desc->payload_length = view.payload_length;
 
 	rec_desc->payload_descriptor = bin_pay_desc;
 	rec_desc->payload_constructor  = (payload_constructor_t) nfc_ndef_bin_payload_memcopy;
 
-	*nfc_data_len = expected_rec_size;
+	*record_location = view.location;
 
 	return 0;
 }
@@ -19,6 +19,7 @@ LOG_MODULE_REGISTER(nfc_t4t_apdu, CONFIG_NFC_T4T_APDU_LOG_LEVEL);
 #define LC_LONG_FORMAT_SIZE 3U
 #define LE_SHORT_FORMAT_SIZE 1U
 #define LE_LONG_FORMAT_SIZE 2U
+#define LE_LONG_FORMAT_NO_LC_SIZE 3U
 
 /** @brief Values used to encode Lc field in C-APDU.
  */
@@ -34,12 +35,22 @@ LOG_MODULE_REGISTER(nfc_t4t_apdu, CONFIG_NFC_T4T_APDU_LOG_LEVEL);
 /* Size of Status field contained in R-APDU. */
 #define STATUS_SIZE 2U
 
+/* Lc and Le fields use the same format. If one of them needs the extended
+ * (long) format, both are encoded in it. ISO/IEC 7816-4 5.1.
+ */
+static bool nfc_t4t_apdu_comm_long_format(const struct nfc_t4t_apdu_comm *cmd_apdu)
+{
+	return ((cmd_apdu->data.buff) && (cmd_apdu->data.len > LC_LONG_FORMAT_THR)) ||
+	       (cmd_apdu->resp_len > LE_LONG_FORMAT_THR);
+}
+
 static uint16_t nfc_t4t_apdu_comm_size_calc(const struct nfc_t4t_apdu_comm *cmd_apdu)
 {
 	uint16_t res = CLASS_TYPE_SIZE + INSTRUCTION_TYPE_SIZE + PARAMETER_SIZE;
+	bool long_format = nfc_t4t_apdu_comm_long_format(cmd_apdu);
 
 	if (cmd_apdu->data.buff) {
-		if (cmd_apdu->data.len > LC_LONG_FORMAT_THR) {
+		if (long_format) {
 			res += LC_LONG_FORMAT_SIZE;
 		} else {
 			res += LC_SHORT_FORMAT_SIZE;
@@ -49,10 +60,12 @@ static uint16_t nfc_t4t_apdu_comm_size_calc(const struct nfc_t4t_apdu_comm *cmd_
 	res += cmd_apdu->data.len;
 
 	if (cmd_apdu->resp_len != LE_FIELD_ABSENT) {
-		if (cmd_apdu->resp_len > LE_LONG_FORMAT_THR) {
+		if (!long_format) {
+			res += LE_SHORT_FORMAT_SIZE;
+		} else if (cmd_apdu->data.buff) {
 			res += LE_LONG_FORMAT_SIZE;
 		} else {
-			res += LE_SHORT_FORMAT_SIZE;
+			res += LE_LONG_FORMAT_NO_LC_SIZE;
 		}
 	}
 
@@ -77,6 +90,7 @@ int nfc_t4t_apdu_comm_encode(const struct nfc_t4t_apdu_comm *cmd_apdu,
 			     uint8_t *raw_data, uint16_t *len)
 {
 	int err;
+	bool long_format;
 
 	/*  Validate passed arguments. */
 	err = nfc_t4t_apdu_comm_args_validate(cmd_apdu, raw_data, len);
@@ -84,6 +98,8 @@ int nfc_t4t_apdu_comm_encode(const struct nfc_t4t_apdu_comm *cmd_apdu,
 		return err;
 	}
 
+	long_format = nfc_t4t_apdu_comm_long_format(cmd_apdu);
+
 	/* Check if there is enough memory in the provided buffer to store
 	 * described C-APDU.
 	 */
@@ -105,7 +121,7 @@ int nfc_t4t_apdu_comm_encode(const struct nfc_t4t_apdu_comm *cmd_apdu,
 	/* Check if optional data field should be included. */
 	if (cmd_apdu->data.buff) {
 		/* Use long data length encoding. */
-		if (cmd_apdu->data.len > LC_LONG_FORMAT_THR) {
+		if (long_format) {
 			*raw_data++ = LC_LONG_FORMAT_TOKEN;
 
 			sys_put_be16(cmd_apdu->data.len, raw_data);
@@ -124,7 +140,14 @@ int nfc_t4t_apdu_comm_encode(const struct nfc_t4t_apdu_comm *cmd_apdu,
 	 */
 	if (cmd_apdu->resp_len != LE_FIELD_ABSENT) {
 		/* Use long response length encoding. */
-		if (cmd_apdu->resp_len > LE_LONG_FORMAT_THR) {
+		if (long_format) {
+			/* Without Lc field, the long Le field starts with
+			 * the same token as the long Lc field.
+			 */
+			if (!cmd_apdu->data.buff) {
+				*raw_data++ = LC_LONG_FORMAT_TOKEN;
+			}
+
 			sys_put_be16(cmd_apdu->resp_len, raw_data);
 			raw_data += sizeof(uint16_t);
 		} else {
@@ -25,6 +25,7 @@ LOG_MODULE_REGISTER(nfc_t4t_hl_procedure,
 #define CC_RAPDU_MAX_SIZE_OFFSET 0x03
 #define NFC_T4T_APDU_SELECT_DATA {0xD2, 0x76, 0x00, 0x00, 0x85, 0x01, 0x01}
 #define APDU_LE_MAP_2_MAX_VALUE 0xFF
+#define APDU_READ_LE_MAX_VALUE CONFIG_NFC_T4T_HL_PROCEDURE_MAX_LE
 #define NFC_T4T_APDU_RSP_ALL 256
 
 enum nfc_t4t_hl_transaction_type {
@@ -166,11 +167,20 @@ static int ndef_file_chunk_read(const struct nfc_t4t_apdu_resp *resp)
 	const uint8_t *data = resp->data.buff;
 	uint16_t len = resp->data.len;
 
-	if (t4t_hl.ndef.buff_size < t4t_hl.file_offset + len) {
-		return -ENOMEM;
+	file_id = sys_get_be16(t4t_hl.ndef.file_id);
+
+	/* Streamed read does not store the file. */
+	if (t4t_hl.ndef.buff) {
+		if (t4t_hl.ndef.buff_size < t4t_hl.file_offset + len) {
+			return -ENOMEM;
+		}
+
+		memcpy(t4t_hl.ndef.buff + t4t_hl.file_offset, data, len);
 	}
 
-	memcpy(t4t_hl.ndef.buff + t4t_hl.file_offset, data, len);
+	if (hl_cb->ndef_chunk_read) {
+		hl_cb->ndef_chunk_read(file_id, t4t_hl.file_offset, data, len);
+	}
 
 	t4t_hl.file_offset += len;
 
@@ -180,18 +190,18 @@ static int ndef_file_chunk_read(const struct nfc_t4t_apdu_resp *resp)
 		apdu_comm.instruction = NFC_T4T_APDU_COMM_INS_READ;
 		apdu_comm.parameter = t4t_hl.file_offset;
 		apdu_comm.resp_len = MIN(t4t_hl.ndef.nlen - (t4t_hl.file_offset - NDEF_FILE_NLEN_SIZE),
-				MIN(APDU_LE_MAP_2_MAX_VALUE, t4t_hl.ndef.cc->max_rapdu_size));
+				MIN(APDU_READ_LE_MAX_VALUE, t4t_hl.ndef.cc->max_rapdu_size));
 
 		t4t_hl.transaction_type = NFC_T4T_HL_NDEF_READ;
 
 		return t4t_hl_data_exchange(&apdu_comm);
 	}
 
-	file_id = sys_get_be16(t4t_hl.ndef.file_id);
-
-	err = t4t_file_assign(file_id);
-	if (err) {
-		return err;
+	if (t4t_hl.ndef.buff) {
+		err = t4t_file_assign(file_id);
+		if (err) {
+			return err;
+		}
 	}
 
 	if (hl_cb->ndef_read) {
@@ -425,6 +435,30 @@ int nfc_t4t_hl_procedure_ndef_read(struct nfc_t4t_cc_file *cc,
 	return t4t_hl_data_exchange(&apdu_comm);
 }
 
+int nfc_t4t_hl_procedure_ndef_read_stream(struct nfc_t4t_cc_file *cc)
+{
+	struct nfc_t4t_apdu_comm apdu_comm;
+
+	t4t_hl.file_offset = 0;
+
+	if (!cc || !hl_cb || !hl_cb->ndef_chunk_read) {
+		return -EINVAL;
+	}
+
+	nfc_t4t_apdu_comm_clear(&apdu_comm);
+
+	apdu_comm.instruction = NFC_T4T_APDU_COMM_INS_READ;
+	apdu_comm.parameter = 0;
+	apdu_comm.resp_len = NDEF_FILE_NLEN_SIZE;
+
+	t4t_hl.ndef.buff = NULL;
+	t4t_hl.ndef.buff_size = 0;
+	t4t_hl.ndef.cc = cc;
+	t4t_hl.transaction_type = NFC_T4T_HL_NDEF_NLEN_READ;
+
+	return t4t_hl_data_exchange(&apdu_comm);
+}
+
 int nfc_t4t_hl_procedure_ndef_update(struct nfc_t4t_cc_file *cc,
 				     uint8_t *ndef_data, uint16_t ndef_len)
 {
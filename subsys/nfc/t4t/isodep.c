@@ -131,8 +131,11 @@ struct nfc_t4t_isodep {
 	bool first_transfer;
 };
 
-/* Map FSD value in terms of FSDI according to NFC Forum Digital Specification 2.0 14.16.1 */
-static const uint16_t fsd_value_map[] = {16, 24, 32, 40, 48, 64, 96, 128, 256};
+/* Map FSD value in terms of FSDI according to NFC Forum Digital Specification 2.0 14.16.1.
+ * Values above 256 bytes are defined by ISO/IEC 14443-4:2016.
+ */
+static const uint16_t fsd_value_map[] = {16, 24, 32, 40, 48, 64, 96, 128, 256,
+					 512, 1024, 2048, 4096};
 
 static struct nfc_t4t_isodep t4t_isodep;
 static const struct nfc_t4t_isodep_cb *t4t_isodep_cb;
@@ -203,6 +206,9 @@ static int ats_parse(const uint8_t *data, size_t len)
 
 	fsci = t0 & T4T_ATS_T0_FSCI_MASK;
 
+	/* RFU FSCI values are interpreted as the highest defined value. */
+	fsci = MIN(fsci, ARRAY_SIZE(fsd_value_map) - 1);
+
 	/* FSC is mapped from FSCI in the same way like FSD.
 	 * NFC Forum Digital Specification 2.0 14.6.2.
 	 */
@@ -288,6 +294,7 @@ static int ats_parse(const uint8_t *data, size_t len)
 static void isodep_chunk_send(void)
 {
 	size_t data_len;
+	size_t frame_size;
 	uint32_t fdt;
 	size_t index = 0;
 	const uint8_t *data = t4t_isodep.transmit_data;
@@ -296,6 +303,9 @@ static void isodep_chunk_send(void)
 	__ASSERT_NO_MSG(data);
 	__ASSERT_NO_MSG(tx_data);
 
+	/* The frame must fit in the tag buffer and in the Tx buffer. */
+	frame_size = MIN(t4t_isodep.tag.fsc, t4t_isodep.tx_data.buf_size);
+
 	/* Prepare first chunk. */
 	tx_data[index] = ISODEP_I_BLOCK | (t4t_isodep.block_num & 1);
 
@@ -303,10 +313,10 @@ static void isodep_chunk_send(void)
 	index = did_include(tx_data, index);
 
 	/* Use chaining when data is to long. */
-	if ((t4t_isodep.tag.fsc - index) <
+	if ((frame_size - index) <
 	    (t4t_isodep.transmit_len - t4t_isodep.transmitted_len)) {
 		tx_data[0] |= I_BLOCK_CHAINING_BIT;
-		data_len = t4t_isodep.tag.fsc - index;
+		data_len = frame_size - index;
 		t4t_isodep.chaining = true;
 	} else {
 		data_len = t4t_isodep.transmit_len - t4t_isodep.transmitted_len;
@@ -709,6 +719,12 @@ int nfc_t4t_isodep_rats_send(enum nfc_t4t_isodep_fsd fsd, uint8_t did)
 {
 	uint8_t param;
 
+	if (fsd >= ARRAY_SIZE(fsd_value_map)) {
+		LOG_ERR("Invalid FSD value.");
+
+		return -EINVAL;
+	}
+
 	if (atomic_cas(&t4t_isodep.state, ISODEP_STATE_INITIALIZED,
 		       ISODEP_STATE_TRANSFER)) {
 	} else if (atomic_cas(&t4t_isodep.state, ISODEP_STATE_SELECTED,
@@ -70,6 +70,7 @@ struct tnep_tag {
 	nfc_payload_set_t data_set;
 	initial_msg_encode_t initial_msg_encode;
 	uint8_t *current_buff;
+	atomic_t tx_queued;
 };
 
 static struct tnep_control tnep_ctrl;
@@ -106,24 +107,22 @@ static void tnep_tx_msg_clear(struct nfc_ndef_msg_desc *msg)
 	nfc_ndef_msg_clear(msg);
 }
 
-static int tnep_tx_msg_encode(struct nfc_ndef_msg_desc *msg)
+static uint8_t *tnep_tx_next_buff_get(void)
+{
+	return (tnep.current_buff == tnep.tx.data) ?
+		tnep.tx.swap_data : tnep.tx.data;
+}
+
+static int tnep_tx_buff_encode(struct nfc_ndef_msg_desc *msg, uint8_t *buff)
 {
 	int err = 0;
-	unsigned int key;
 	size_t len;
 	uint8_t *data;
 
-
-	if (tnep.current_buff == tnep.tx.data) {
-		tnep.current_buff = tnep.tx.swap_data;
-	} else {
-		tnep.current_buff = tnep.tx.data;
-	}
-
-	memset(tnep.current_buff, 0, tnep.tx.len);
+	memset(buff, 0, tnep.tx.len);
 
 	len = tnep.tx.len;
-	data = tnep.current_buff;
+	data = buff;
 
 	if (IS_ENABLED(CONFIG_NFC_T4T_NRFXLIB)) {
 		len = nfc_t4t_ndef_file_msg_size_get(len);
@@ -134,12 +133,24 @@ static int tnep_tx_msg_encode(struct nfc_ndef_msg_desc *msg)
 		err = nfc_ndef_msg_encode(msg,
 					  data,
 					  &len);
+	} else {
+		/* Empty NDEF message. */
+		len = 0;
 	}
 
 	if (IS_ENABLED(CONFIG_NFC_T4T_NRFXLIB)) {
-		nfc_t4t_ndef_file_encode(tnep.current_buff, &len);
+		nfc_t4t_ndef_file_encode(buff, &len);
 	}
 
+	return err;
+}
+
+static void tnep_tx_buff_set(uint8_t *buff)
+{
+	unsigned int key;
+
+	tnep.current_buff = buff;
+
 	key = irq_lock();
 
 	__ASSERT_NO_MSG(tnep.data_set);
@@ -147,10 +158,39 @@ static int tnep_tx_msg_encode(struct nfc_ndef_msg_desc *msg)
 	tnep.data_set(tnep.current_buff, tnep.tx.len);
 
 	irq_unlock(key);
+}
+
+static int tnep_tx_msg_encode(struct nfc_ndef_msg_desc *msg)
+{
+	int err;
+	uint8_t *buff = tnep_tx_next_buff_get();
+
+	err = tnep_tx_buff_encode(msg, buff);
+
+	tnep_tx_buff_set(buff);
 
 	return err;
 }
 
+/* The queued message is stored in the buffer that is not exposed to the
+ * Reader/Writer, so the next call to tnep_tx_msg_encode() overwrites it.
+ */
+static bool tnep_tx_queued_msg_set(void)
+{
+	if (!atomic_cas(&tnep.tx_queued, true, false)) {
+		return false;
+	}
+
+	tnep_tx_buff_set(tnep_tx_next_buff_get());
+
+	return true;
+}
+
+static void tnep_tx_queue_drop(void)
+{
+	atomic_set(&tnep.tx_queued, false);
+}
+
 static int tnep_tx_msg_add_rec(struct nfc_ndef_msg_desc *msg,
 			       const struct nfc_ndef_record_desc *record)
 {
@@ -449,19 +489,33 @@ static void tnep_sm_service_selected(enum tnep_event event)
 
 	switch (event) {
 	case TNEP_EVENT_MSG_RX_NEW:
+		status = tnep_svc_select_from_msg();
+
+		/* Respond to service data with the queued application
+		 * message. The application can queue the next one now.
+		 */
+		if ((status == TNEP_SVC_NOT_FOUND) && tnep_tx_queued_msg_set()) {
+			tnep.svc_active->callbacks->message_received(tnep.rx.data,
+								     tnep.rx.len);
+			break;
+		}
+
+		tnep_tx_queue_drop();
+
 		/* Encode empty RX message. */
 		err = tnep_tx_msg_encode(NULL);
 		if (err) {
 			break;
 		}
 
-		status = tnep_svc_select_from_msg();
 		err = service_selected_rx_status_process(last_service,
 							 status);
 
 		break;
 
 	case TNEP_EVENT_TAG_SELECTED:
+		tnep_tx_queue_drop();
+
 		err = tnep_tx_initial_msg_set();
 
 		atomic_set(&current_state, TNEP_STATE_SERVICE_READY);
@@ -675,6 +729,47 @@ int nfc_tnep_tag_tx_msg_app_data(struct nfc_ndef_msg_desc *msg,
 	return tnep_new_app_msg_prepare(msg, status);
 }
 
+int nfc_tnep_tag_tx_msg_app_data_queue(struct nfc_ndef_msg_desc *msg,
+				       enum nfc_tnep_status_value status)
+{
+	int err;
+
+	if (!msg) {
+		LOG_ERR("No application data NDEF Message");
+		return -EINVAL;
+	};
+
+	/* Check the state of TNEP service. */
+	if (!atomic_cas(&current_state, TNEP_STATE_SERVICE_SELECTED,
+			TNEP_STATE_SERVICE_SELECTED)) {
+		LOG_ERR("Invalid state. App data can be provided only in service selected state");
+		return -EACCES;
+	}
+
+	if (atomic_get(&tnep.app_data_expected) == TNEP_APP_DATA_EXPECTED) {
+		LOG_ERR("Response to the last message not set.");
+		return -EACCES;
+	}
+
+	if (atomic_get(&tnep.tx_queued)) {
+		return -EBUSY;
+	}
+
+	err = tnep_tx_msg_add_rec_status(msg, status);
+	if (err) {
+		return err;
+	}
+
+	err = tnep_tx_buff_encode(msg, tnep_tx_next_buff_get());
+	if (err) {
+		return err;
+	}
+
+	atomic_set(&tnep.tx_queued, true);
+
+	return 0;
+}
+
 int nfc_tnep_tag_tx_msg_no_app_data(void)
 {
 	int err;
@@ -50,6 +50,10 @@ NRF_NSE(int, spm_request_read, void *destination, uint32_t addr, size_t len);
 NRF_NSE(int, spm_firmware_info, uint32_t fw_address, struct fw_info *info);
 #endif /* CONFIG_SPM_SERVICE_FIND_FIRMWARE_INFO */
 
+#ifdef CONFIG_SPM_SERVICE_BATCH
+NRF_NSE(int, spm_request_batch, struct spm_batch_op *ops, size_t count);
+#endif /* CONFIG_SPM_SERVICE_BATCH */
+
 #ifdef CONFIG_SPM_SERVICE_PREVALIDATE
 NRF_NSE(int, spm_prevalidate_b1_upgrade, uint32_t dst_addr, uint32_t src_addr);
 #endif /* CONFIG_SPM_SERVICE_PREVALIDATE */
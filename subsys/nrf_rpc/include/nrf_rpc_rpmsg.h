@@ -24,16 +24,28 @@ extern "C" {
 #endif
 
 #define NRF_RPC_TR_MAX_HEADER_SIZE 0
-#define NRF_RPC_TR_AUTO_FREE_RX_BUF 1
 
 typedef void (*nrf_rpc_tr_receive_handler_t)(const uint8_t *packet, size_t len);
 
 int nrf_rpc_tr_init(nrf_rpc_tr_receive_handler_t callback);
 
+#if defined(CONFIG_NRF_RPC_TR_RPMSG_HOLD_RX_BUF)
+
+/* Received packets stay in the RPMsg buffer until they are decoded. */
+#define NRF_RPC_TR_AUTO_FREE_RX_BUF 0
+
+void nrf_rpc_tr_free_rx_buf(const uint8_t *buf);
+
+#else
+
+#define NRF_RPC_TR_AUTO_FREE_RX_BUF 1
+
 static inline void nrf_rpc_tr_free_rx_buf(const uint8_t *buf)
 {
 }
 
+#endif /* CONFIG_NRF_RPC_TR_RPMSG_HOLD_RX_BUF */
+
 #define nrf_rpc_tr_alloc_tx_buf(buf, len)				       \
 	uint32_t _nrf_rpc_tr_buf_vla[(sizeof(uint32_t) - 1 + (len)) /	       \
 				     sizeof(uint32_t)];			       \
@@ -9,6 +9,11 @@
 
 #include "nrf_rpc_os.h"
 
+#if defined(CONFIG_NRF_RPC_OS_STATS_SHELL)
+#include <string.h>
+#include <shell/shell.h>
+#endif
+
 /* Maximum number of remote thread that this implementation allows. */
 #define MAX_REMOTE_THREADS 255
 
@@ -22,8 +27,24 @@
 struct pool_start_msg {
 	const uint8_t *data;
 	size_t len;
+#if defined(CONFIG_NRF_RPC_OS_STATS)
+	uint32_t queued_cycles;
+#endif
+};
+
+#if defined(CONFIG_NRF_RPC_OS_STATS)
+/* Statistics of a thread from thread pool, times in microseconds. */
+struct pool_thread_stats {
+	uint32_t handled_cnt;
+	uint32_t wait_time_max;
+	uint32_t handler_time_max;
+	uint64_t wait_time_total;
+	uint64_t handler_time_total;
 };
 
+static struct pool_thread_stats pool_stats[CONFIG_NRF_RPC_THREAD_POOL_SIZE];
+#endif
+
 static nrf_rpc_os_work_t thread_pool_callback;
 
 static struct pool_start_msg pool_start_msg_buf[2];
@@ -49,15 +70,43 @@ BUILD_ASSERT(CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE <= 8 * sizeof(atomic_val_t),
 BUILD_ASSERT(sizeof(uint32_t) == sizeof(atomic_val_t),
 	     "Only atomic_val_t is implemented that is the same as uint32_t");
 
+#if defined(CONFIG_NRF_RPC_OS_STATS)
 static void thread_pool_entry(void *p1, void *p2, void *p3)
 {
+	struct pool_thread_stats *stats = p1;
 	struct pool_start_msg msg;
+	uint32_t start;
+	uint32_t wait_time;
+	uint32_t handler_time;
 
 	do {
 		k_msgq_get(&pool_start_msg, &msg, K_FOREVER);
+
+		start = k_cycle_get_32();
 		thread_pool_callback(msg.data, msg.len);
+
+		wait_time = k_cyc_to_us_floor32(start - msg.queued_cycles);
+		handler_time = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+		stats->handled_cnt++;
+		stats->wait_time_total += wait_time;
+		stats->wait_time_max = MAX(stats->wait_time_max, wait_time);
+		stats->handler_time_total += handler_time;
+		stats->handler_time_max = MAX(stats->handler_time_max,
+					      handler_time);
 	} while (1);
 }
+#else
+static void thread_pool_entry(void *p1, void *p2, void *p3)
+{
+	struct pool_start_msg msg;
+
+	do {
+		k_msgq_get(&pool_start_msg, &msg, K_FOREVER);
+		thread_pool_callback(msg.data, msg.len);
+	} while (1);
+}
+#endif /* CONFIG_NRF_RPC_OS_STATS */
 
 int nrf_rpc_os_init(nrf_rpc_os_work_t callback)
 {
@@ -87,10 +136,15 @@ int nrf_rpc_os_init(nrf_rpc_os_work_t callback)
 		    ARRAY_SIZE(pool_start_msg_buf));
 
 	for (i = 0; i < CONFIG_NRF_RPC_THREAD_POOL_SIZE; i++) {
+		void *stats = NULL;
+
+#if defined(CONFIG_NRF_RPC_OS_STATS)
+		stats = &pool_stats[i];
+#endif
 		k_thread_create(&pool_threads[i], pool_stacks[i],
 			K_THREAD_STACK_SIZEOF(pool_stacks[i]),
 			thread_pool_entry,
-			NULL, NULL, NULL,
+			stats, NULL, NULL,
 			CONFIG_NRF_RPC_THREAD_PRIORITY, 0, K_NO_WAIT);
 	}
 
@@ -103,6 +157,9 @@ void nrf_rpc_os_thread_pool_send(const uint8_t *data, size_t len)
 
 	msg.data = data;
 	msg.len = len;
+#if defined(CONFIG_NRF_RPC_OS_STATS)
+	msg.queued_cycles = k_cycle_get_32();
+#endif
 	k_msgq_put(&pool_start_msg, &msg, K_FOREVER);
 }
 
@@ -168,3 +225,55 @@ void nrf_rpc_os_remote_count(int count)
 		remote_thread_total--;
 	}
 }
+
+#if defined(CONFIG_NRF_RPC_OS_STATS_SHELL)
+static int cmd_thread_pool_stats(const struct shell *shell, size_t argc,
+				 char **argv)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(pool_stats); i++) {
+		const struct pool_thread_stats *stats = &pool_stats[i];
+		size_t unused = 0;
+
+		k_thread_stack_space_get(&pool_threads[i], &unused);
+
+		shell_print(shell, "thread %zu: handled %u, stack unused %zu B",
+			    i, stats->handled_cnt, unused);
+
+		if (stats->handled_cnt == 0) {
+			continue;
+		}
+
+		shell_print(shell, "  queue wait: avg %u us, max %u us",
+			    (uint32_t)(stats->wait_time_total /
+				       stats->handled_cnt),
+			    stats->wait_time_max);
+		shell_print(shell, "  handler:    avg %u us, max %u us",
+			    (uint32_t)(stats->handler_time_total /
+				       stats->handled_cnt),
+			    stats->handler_time_max);
+	}
+
+	return 0;
+}
+
+static int cmd_thread_pool_stats_reset(const struct shell *shell,
+				       size_t argc, char **argv)
+{
+	memset(pool_stats, 0, sizeof(pool_stats));
+	shell_print(shell, "Statistics reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_nrf_rpc,
+	SHELL_CMD_ARG(thread_pool_stats, NULL,
+		      "Show thread pool statistics",
+		      cmd_thread_pool_stats, 0, 0),
+	SHELL_CMD_ARG(thread_pool_stats_reset, NULL,
+		      "Reset thread pool statistics",
+		      cmd_thread_pool_stats_reset, 0, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(nrf_rpc, &sub_nrf_rpc, "nRF RPC commands", NULL);
+#endif /* CONFIG_NRF_RPC_OS_STATS_SHELL */
@@ -9,12 +9,14 @@
 
 #include <zephyr.h>
 #include <errno.h>
+#include <string.h>
 #include <metal/sys.h>
 #include <metal/device.h>
 #include <metal/alloc.h>
 #include <openamp/open_amp.h>
 #include <ipc/rpmsg_service.h>
 #include <init.h>
+#include <sys/byteorder.h>
 
 #include "nrf_rpc.h"
 #include "nrf_rpc_rpmsg.h"
@@ -48,6 +50,33 @@ static nrf_rpc_tr_receive_handler_t receive_callback;
 static int endpoint_id;
 static bool is_handshake_done;
 
+#if defined(CONFIG_NRF_RPC_TR_RPMSG_HOLD_RX_BUF)
+/* Endpoint owning the held receive buffers */
+static struct rpmsg_endpoint *rx_endpoint;
+#endif
+
+#if defined(CONFIG_NRF_RPC_TR_RPMSG_BATCH)
+/* Each packet in a batch frame is preceded by its length. */
+#define BATCH_LEN_SIZE sizeof(uint16_t)
+
+BUILD_ASSERT(CONFIG_NRF_RPC_TR_RPMSG_BATCH_SIZE <= UINT16_MAX,
+	     "Batch frame too large for the packet length field");
+
+static int batch_endpoint_id;
+
+static uint8_t batch_buf[CONFIG_NRF_RPC_TR_RPMSG_BATCH_SIZE];
+static size_t batch_len;
+static K_MUTEX_DEFINE(batch_mutex);
+
+static K_THREAD_STACK_DEFINE(batch_stack,
+			     CONFIG_NRF_RPC_TR_RPMSG_BATCH_STACK_SIZE);
+static struct k_work_q batch_work_q;
+
+static void batch_flush_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(batch_flush_work, batch_flush_work_handler);
+#endif /* CONFIG_NRF_RPC_TR_RPMSG_BATCH */
+
 /* Translates RPMsg error code to nRF RPC error code. */
 static int translate_error(int rpmsg_err)
 {
@@ -105,11 +134,113 @@ static int endpoint_cb(struct rpmsg_endpoint *ept, void *data, size_t len,
 		return RPMSG_SUCCESS;
 	}
 
+#if defined(CONFIG_NRF_RPC_TR_RPMSG_HOLD_RX_BUF)
+	/* Keep the buffer in shared memory until the packet is decoded, so the
+	 * callback does not have to wait for the decoding to finish.
+	 */
+	rx_endpoint = ept;
+	rpmsg_hold_rx_buffer(ept, data);
+#endif
+
 	event_handler(NRF_RPC_EVENT_DATA, data, len);
 
 	return RPMSG_SUCCESS;
 }
 
+#if defined(CONFIG_NRF_RPC_TR_RPMSG_HOLD_RX_BUF)
+void nrf_rpc_tr_free_rx_buf(const uint8_t *buf)
+{
+	NRF_RPC_ASSERT(rx_endpoint != NULL);
+
+	rpmsg_release_rx_buffer(rx_endpoint, (void *)buf);
+}
+#endif
+
+#if defined(CONFIG_NRF_RPC_TR_RPMSG_BATCH)
+static int batch_endpoint_cb(struct rpmsg_endpoint *ept, void *data,
+			     size_t len, uint32_t src, void *priv)
+{
+	const uint8_t *frame = data;
+
+	while (len >= BATCH_LEN_SIZE) {
+		size_t packet_len = sys_get_le16(frame);
+
+		frame += BATCH_LEN_SIZE;
+		len -= BATCH_LEN_SIZE;
+
+		if (packet_len == 0 || packet_len > len) {
+			NRF_RPC_ERR("Malformed batch frame");
+			break;
+		}
+
+		event_handler(NRF_RPC_EVENT_DATA, frame, packet_len);
+
+		frame += packet_len;
+		len -= packet_len;
+	}
+
+	return RPMSG_SUCCESS;
+}
+
+/* Must be called with batch_mutex locked. */
+static int batch_flush(void)
+{
+	int err;
+
+	if (batch_len == 0) {
+		return 0;
+	}
+
+	NRF_RPC_DBG("Send batch of %u bytes.", batch_len);
+
+	err = rpmsg_service_send(batch_endpoint_id, batch_buf, batch_len);
+	batch_len = 0;
+
+	if (err > 0) {
+		err = 0;
+	}
+
+	return translate_error(err);
+}
+
+static void batch_flush_work_handler(struct k_work *work)
+{
+	int err;
+
+	k_mutex_lock(&batch_mutex, K_FOREVER);
+	err = batch_flush();
+	k_mutex_unlock(&batch_mutex);
+
+	if (err) {
+		NRF_RPC_ERR("Sending batch failed with %d", err);
+	}
+}
+
+/* Returns true if the packet was added to the batch frame. */
+static bool batch_add(const uint8_t *buf, size_t len)
+{
+	if (len == 0 || len + BATCH_LEN_SIZE > sizeof(batch_buf)) {
+		return false;
+	}
+
+	if (batch_len + BATCH_LEN_SIZE + len > sizeof(batch_buf)) {
+		(void)batch_flush();
+	}
+
+	sys_put_le16(len, &batch_buf[batch_len]);
+	memcpy(&batch_buf[batch_len + BATCH_LEN_SIZE], buf, len);
+
+	if (batch_len == 0) {
+		k_work_schedule_for_queue(&batch_work_q, &batch_flush_work,
+			K_USEC(CONFIG_NRF_RPC_TR_RPMSG_BATCH_DELAY_US));
+	}
+
+	batch_len += BATCH_LEN_SIZE + len;
+
+	return true;
+}
+#endif /* CONFIG_NRF_RPC_TR_RPMSG_BATCH */
+
 static int nrf_rpc_register_endpoint(const struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -123,6 +254,22 @@ static int nrf_rpc_register_endpoint(const struct device *dev)
 		return err;
 	}
 
+#if defined(CONFIG_NRF_RPC_TR_RPMSG_BATCH)
+	err = rpmsg_service_register_endpoint("nrf_rpc_batch",
+					      batch_endpoint_cb);
+
+	batch_endpoint_id = err;
+
+	if (err < 0) {
+		NRF_RPC_ERR("Registering batch endpoint failed with %d", err);
+		return err;
+	}
+
+	k_work_queue_start(&batch_work_q, batch_stack,
+			   K_THREAD_STACK_SIZEOF(batch_stack),
+			   CONFIG_NRF_RPC_TR_RPMSG_BATCH_THREAD_PRIORITY, NULL);
+#endif
+
 	return 0;
 }
 
@@ -137,6 +284,12 @@ int nrf_rpc_tr_init(nrf_rpc_tr_receive_handler_t callback)
 			k_sleep(K_MSEC(1));
 		}
 
+#if defined(CONFIG_NRF_RPC_TR_RPMSG_BATCH)
+		while (!rpmsg_service_endpoint_is_bound(batch_endpoint_id)) {
+			k_sleep(K_MSEC(1));
+		}
+#endif
+
 		rpmsg_service_send(endpoint_id, (uint8_t *)"", 0);
 	} else {
 		NRF_RPC_INF("RPC remote");
@@ -160,7 +313,25 @@ int nrf_rpc_tr_send(uint8_t *buf, size_t len)
 	NRF_RPC_DBG("Send %u bytes.", len);
 	DUMP_LIMITED_DBG(buf, len, "Data:");
 
+#if defined(CONFIG_NRF_RPC_TR_RPMSG_BATCH)
+	k_mutex_lock(&batch_mutex, K_FOREVER);
+
+	if (batch_add(buf, len)) {
+		k_mutex_unlock(&batch_mutex);
+		return 0;
+	}
+
+	/* Too large for a batch, keep the order of the pending packets. */
+	err = batch_flush();
+	if (err == 0) {
+		err = rpmsg_service_send(endpoint_id, buf, len);
+	}
+
+	k_mutex_unlock(&batch_mutex);
+#else
 	err = rpmsg_service_send(endpoint_id, buf, len);
+#endif
+
 	if (err > 0) {
 		err = 0;
 	}
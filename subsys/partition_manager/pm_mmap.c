@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr.h>
+#include <errno.h>
+#include <string.h>
+#include <storage/flash_map.h>
+#include <pm_mmap.h>
+
+#if defined(CONFIG_PM_MMAP_QSPI_XIP)
+#include <drivers/flash/nrf_qspi_nor.h>
+
+#define QSPI_XIP_SIZE (DT_PROP(DT_INST(0, nordic_qspi_nor), size) / 8)
+
+static const struct device *qspi_dev;
+static atomic_t qspi_xip_users;
+#endif
+
+#define INTERNAL_FLASH_DEV_NAME DT_LABEL(DT_CHOSEN(zephyr_flash_controller))
+
+static bool qspi_xip_ptr(const void *ptr)
+{
+#if defined(CONFIG_PM_MMAP_QSPI_XIP)
+	uintptr_t addr = (uintptr_t)ptr;
+
+	return (addr >= CONFIG_PM_MMAP_QSPI_XIP_ADDRESS) &&
+	       (addr < CONFIG_PM_MMAP_QSPI_XIP_ADDRESS + QSPI_XIP_SIZE);
+#else
+	return false;
+#endif
+}
+
+static int area_base_get(const struct flash_area *fa, uintptr_t *base)
+{
+	if (strcmp(fa->fa_dev_name, INTERNAL_FLASH_DEV_NAME) == 0) {
+		*base = CONFIG_FLASH_BASE_ADDRESS;
+		return 0;
+	}
+
+#if defined(CONFIG_PM_MMAP_QSPI_XIP)
+	if (strcmp(fa->fa_dev_name,
+		   DT_LABEL(DT_INST(0, nordic_qspi_nor))) == 0) {
+		*base = CONFIG_PM_MMAP_QSPI_XIP_ADDRESS;
+		return 0;
+	}
+#endif
+
+	return -ENOTSUP;
+}
+
+int pm_mmap(uint8_t id, off_t off, size_t len, size_t align,
+	    const void **ptr)
+{
+	const struct flash_area *fa;
+	uintptr_t addr;
+	int err;
+
+	if ((ptr == NULL) || (off < 0) || (align == 0) ||
+	    ((align & (align - 1)) != 0)) {
+		return -EINVAL;
+	}
+
+	err = flash_area_open(id, &fa);
+	if (err) {
+		return err;
+	}
+
+	if ((len > fa->fa_size) || (off > fa->fa_size - len)) {
+		err = -EINVAL;
+		goto out;
+	}
+
+	err = area_base_get(fa, &addr);
+	if (err) {
+		goto out;
+	}
+
+	addr += fa->fa_off + off;
+	if ((addr & (align - 1)) != 0) {
+		err = -EINVAL;
+		goto out;
+	}
+
+#if defined(CONFIG_PM_MMAP_QSPI_XIP)
+	if (qspi_xip_ptr((const void *)addr)) {
+		if (qspi_dev == NULL) {
+			qspi_dev = device_get_binding(fa->fa_dev_name);
+			if (qspi_dev == NULL) {
+				err = -ENODEV;
+				goto out;
+			}
+		}
+
+		if (atomic_inc(&qspi_xip_users) == 0) {
+			nrf_qspi_nor_xip_enable(qspi_dev, true);
+		}
+	}
+#endif
+
+	*ptr = (const void *)addr;
+
+out:
+	flash_area_close(fa);
+
+	return err;
+}
+
+void pm_munmap(const void *ptr)
+{
+	if (!qspi_xip_ptr(ptr)) {
+		return;
+	}
+
+#if defined(CONFIG_PM_MMAP_QSPI_XIP)
+	if (atomic_dec(&qspi_xip_users) == 1) {
+		nrf_qspi_nor_xip_enable(qspi_dev, false);
+	}
+#endif
+}
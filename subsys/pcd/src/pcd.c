@@ -10,6 +10,7 @@
 #include <logging/log.h>
 
 #ifdef CONFIG_PCD_NET
+#include <string.h>
 #include <storage/stream_flash.h>
 #endif
 
@@ -69,6 +70,21 @@ const void *pcd_cmd_data_ptr_get(void)
 
 #ifdef CONFIG_PCD_NET
 
+/* Called by stream_flash with the data read back after each write, so that
+ * the copy is verified while it is being written.
+ */
+static int copy_verify(uint8_t *buf, size_t len, size_t offset)
+{
+	const uint8_t *src = (const uint8_t *)cmd->data + (offset - cmd->offset);
+
+	if (memcmp(buf, src, len) != 0) {
+		LOG_ERR("Verification failed at offset 0x%x", offset);
+		return -EIO;
+	}
+
+	return 0;
+}
+
 int pcd_fw_copy(const struct device *fdev)
 {
 	struct stream_flash_ctx stream;
@@ -80,7 +96,7 @@ int pcd_fw_copy(const struct device *fdev)
 	}
 
 	rc = stream_flash_init(&stream, fdev, buf, sizeof(buf),
-			       cmd->offset, 0, NULL);
+			       cmd->offset, 0, copy_verify);
 	if (rc != 0) {
 		LOG_ERR("stream_flash_init failed: %d", rc);
 		return rc;
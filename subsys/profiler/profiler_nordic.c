@@ -57,6 +57,35 @@ static K_THREAD_STACK_DEFINE(profiler_nordic_stack,
 			     CONFIG_PROFILER_NORDIC_STACK_SIZE);
 static struct k_thread profiler_nordic_thread;
 
+#ifdef CONFIG_PROFILER_NORDIC_RING_BUF
+/* Events are stored in the ring buffer as records made of a 32-bit header
+ * followed by the event data. Records are aligned to 4 bytes and never wrap
+ * around the end of the buffer - a padding record is used instead.
+ *
+ * Producers reserve space for a record by atomically moving the head.
+ * The header is written after the data, so the consumer stops at the first
+ * record that is reserved, but not yet written. The consumer clears the
+ * consumed memory, so that a stale data is never taken for a valid header.
+ */
+#define RING_BUF_SIZE		CONFIG_PROFILER_NORDIC_RING_BUF_SIZE
+#define RING_BUF_MASK		(RING_BUF_SIZE - 1)
+#define RING_HDR_SIZE		sizeof(uint32_t)
+#define RING_HDR_VALID		BIT(31)
+#define RING_HDR_PADDING	BIT(30)
+#define RING_HDR_LEN_MASK	BIT_MASK(16)
+#define RING_DRAIN_CHUNK_SIZE	128
+
+BUILD_ASSERT((RING_BUF_SIZE & RING_BUF_MASK) == 0,
+	     "Ring buffer size must be a power of two");
+
+static uint8_t ring_buf[RING_BUF_SIZE] __aligned(sizeof(uint32_t));
+static atomic_t ring_head;
+static atomic_t ring_tail;
+static atomic_t dropped_events;
+static uint32_t reported_dropped_events;
+static uint16_t dropped_events_id;
+#endif /* CONFIG_PROFILER_NORDIC_RING_BUF */
+
 static int send_info_data(const char *data, size_t data_len)
 {
 	uint8_t retry_cnt = 0;
@@ -99,6 +128,13 @@ static void send_system_description(void)
 	char end_line = '\n';
 	int err = 0;
 
+	if (IS_ENABLED(CONFIG_PROFILER_NORDIC_TIMESTAMP_DELTA)) {
+		/* Let the host know the stream format. */
+		static const char format_descr[] = "!timestamp_delta\n";
+
+		err = send_info_data(format_descr, strlen(format_descr));
+	}
+
 	for (size_t t = 0; ((t < ne) && !err); t++) {
 		err = send_info_data(descr[t], strlen(descr[t]));
 		if (!err) {
@@ -111,6 +147,219 @@ static void send_system_description(void)
 	}
 }
 
+#ifdef CONFIG_PROFILER_NORDIC_TIMESTAMP_DELTA
+/* In the compressed stream format, the 32-bit timestamp of an event is
+ * replaced with the difference to the timestamp of the previously sent event,
+ * encoded as a zigzag varint. Synchronization record, made of the sync ID and
+ * the 32-bit absolute timestamp, is sent before the first event and after
+ * events might have been lost.
+ */
+#define TIMESTAMP_SYNC_ID	UCHAR_MAX
+#define EVENT_HDR_SIZE		(sizeof(uint8_t) + sizeof(uint32_t))
+
+/* Maximum length of an encoded event, including the synchronization record. */
+#define COMPRESSED_EVENT_MAX_LEN (CONFIG_PROFILER_CUSTOM_EVENT_BUF_LEN + 1 + \
+				  EVENT_HDR_SIZE)
+
+static uint32_t last_timestamp;
+static bool timestamp_sync_needed = true;
+
+static size_t encode_varint(uint8_t *out, uint32_t value)
+{
+	size_t len = 0;
+
+	while (value >= 0x80) {
+		out[len++] = (value & 0x7f) | 0x80;
+		value >>= 7;
+	}
+	out[len++] = value;
+
+	return len;
+}
+
+/* Must be called with the data channel access serialized. */
+static size_t compress_event(uint8_t *out, const uint8_t *event, size_t len)
+{
+	__ASSERT_NO_MSG(len >= EVENT_HDR_SIZE);
+
+	uint32_t timestamp = sys_get_le32(&event[sizeof(uint8_t)]);
+	size_t pos = 0;
+
+	if (timestamp_sync_needed) {
+		out[pos++] = TIMESTAMP_SYNC_ID;
+		sys_put_le32(timestamp, &out[pos]);
+		pos += sizeof(timestamp);
+		last_timestamp = timestamp;
+		timestamp_sync_needed = false;
+	}
+
+	int32_t delta = (int32_t)(timestamp - last_timestamp);
+
+	last_timestamp = timestamp;
+
+	out[pos++] = event[0];
+	pos += encode_varint(&out[pos], ((uint32_t)delta << 1) ^ (delta >> 31));
+	memcpy(&out[pos], &event[EVENT_HDR_SIZE], len - EVENT_HDR_SIZE);
+
+	return pos + len - EVENT_HDR_SIZE;
+}
+
+static void timestamp_resync(void)
+{
+	timestamp_sync_needed = true;
+}
+#else
+#define COMPRESSED_EVENT_MAX_LEN CONFIG_PROFILER_CUSTOM_EVENT_BUF_LEN
+
+static size_t compress_event(uint8_t *out, const uint8_t *event, size_t len)
+{
+	memcpy(out, event, len);
+
+	return len;
+}
+
+static void timestamp_resync(void)
+{
+}
+#endif /* CONFIG_PROFILER_NORDIC_TIMESTAMP_DELTA */
+
+#ifdef CONFIG_PROFILER_NORDIC_RING_BUF
+static inline uint32_t ring_record_len(uint32_t data_len)
+{
+	return ROUND_UP(RING_HDR_SIZE + data_len, sizeof(uint32_t));
+}
+
+static inline volatile uint32_t *ring_hdr(uint32_t pos)
+{
+	return (volatile uint32_t *)&ring_buf[pos & RING_BUF_MASK];
+}
+
+static void ring_write(const uint8_t *data, size_t len)
+{
+	uint32_t rec_len = ring_record_len(len);
+	atomic_val_t head;
+	uint32_t pad;
+
+	do {
+		head = atomic_get(&ring_head);
+
+		uint32_t off = head & RING_BUF_MASK;
+
+		pad = (off + rec_len > RING_BUF_SIZE) ? (RING_BUF_SIZE - off) : 0;
+
+		if ((uint32_t)head + pad + rec_len - (uint32_t)atomic_get(&ring_tail) >
+		    RING_BUF_SIZE) {
+			atomic_inc(&dropped_events);
+			return;
+		}
+	} while (!atomic_cas(&ring_head, head, head + pad + rec_len));
+
+	if (pad > 0) {
+		*ring_hdr(head) = RING_HDR_VALID | RING_HDR_PADDING | pad;
+	}
+
+	uint32_t pos = head + pad;
+
+	memcpy(&ring_buf[(pos + RING_HDR_SIZE) & RING_BUF_MASK], data, len);
+
+	/* Data must be visible before the record is marked as valid. */
+	__DMB();
+	*ring_hdr(pos) = RING_HDR_VALID | len;
+}
+
+static void ring_chunk_flush(uint8_t *chunk, size_t *chunk_len,
+			     size_t *chunk_events)
+{
+	if (*chunk_len == 0) {
+		return;
+	}
+
+	if (SEGGER_RTT_WriteNoLock(CONFIG_PROFILER_NORDIC_RTT_CHANNEL_DATA,
+				   chunk, *chunk_len) == 0) {
+		atomic_add(&dropped_events, *chunk_events);
+		timestamp_resync();
+	}
+
+	*chunk_len = 0;
+	*chunk_events = 0;
+}
+
+static void report_dropped_events(void)
+{
+	uint32_t dropped = atomic_get(&dropped_events);
+
+	if (dropped == reported_dropped_events) {
+		return;
+	}
+
+	reported_dropped_events = dropped;
+
+	struct log_event_buf buf;
+
+	profiler_log_start(&buf);
+	profiler_log_encode_uint32(&buf, dropped);
+	profiler_log_send(&buf, dropped_events_id);
+}
+
+static void ring_drain(void)
+{
+	uint8_t chunk[RING_DRAIN_CHUNK_SIZE];
+	size_t chunk_len = 0;
+	size_t chunk_events = 0;
+	uint32_t tail = atomic_get(&ring_tail);
+
+	while (tail != (uint32_t)atomic_get(&ring_head)) {
+		uint32_t hdr = *ring_hdr(tail);
+
+		if (!(hdr & RING_HDR_VALID)) {
+			/* Record reserved, but not yet written. */
+			break;
+		}
+
+		/* Read data only after the header was found valid. */
+		__DMB();
+
+		uint32_t len = hdr & RING_HDR_LEN_MASK;
+		uint32_t rec_len;
+
+		if (hdr & RING_HDR_PADDING) {
+			rec_len = len;
+		} else {
+			rec_len = ring_record_len(len);
+
+			if (chunk_len + COMPRESSED_EVENT_MAX_LEN > sizeof(chunk)) {
+				ring_chunk_flush(chunk, &chunk_len, &chunk_events);
+			}
+
+			chunk_len += compress_event(&chunk[chunk_len],
+				&ring_buf[(tail + RING_HDR_SIZE) & RING_BUF_MASK],
+				len);
+			chunk_events++;
+		}
+
+		memset(&ring_buf[tail & RING_BUF_MASK], 0, rec_len);
+		tail += rec_len;
+
+		/* Memory must be cleared before it is released to producers. */
+		__DMB();
+		atomic_set(&ring_tail, tail);
+	}
+
+	ring_chunk_flush(chunk, &chunk_len, &chunk_events);
+	report_dropped_events();
+}
+BUILD_ASSERT(RING_DRAIN_CHUNK_SIZE >= COMPRESSED_EVENT_MAX_LEN,
+	     "Drain chunk must fit a single event");
+#else
+static void ring_write(const uint8_t *data, size_t len)
+{
+}
+
+static void ring_drain(void)
+{
+}
+#endif /* CONFIG_PROFILER_NORDIC_RING_BUF */
+
 static void profiler_nordic_thread_fn(void)
 {
 	while (protocol_running) {
@@ -123,6 +372,12 @@ static void profiler_nordic_thread_fn(void)
 			command = (enum nordic_command)read_data;
 			switch (command) {
 			case NORDIC_COMMAND_START:
+				if (IS_ENABLED(CONFIG_PROFILER_NORDIC_TIMESTAMP_DELTA)) {
+					int key = irq_lock();
+
+					timestamp_resync();
+					irq_unlock(key);
+				}
 				sending_events = true;
 				break;
 			case NORDIC_COMMAND_STOP:
@@ -136,7 +391,13 @@ static void profiler_nordic_thread_fn(void)
 				break;
 			}
 		}
-		k_sleep(K_MSEC(500));
+
+		if (IS_ENABLED(CONFIG_PROFILER_NORDIC_RING_BUF)) {
+			ring_drain();
+			k_sleep(K_MSEC(CONFIG_PROFILER_NORDIC_RING_BUF_DRAIN_PERIOD_MS));
+		} else {
+			k_sleep(K_MSEC(500));
+		}
 	}
 	k_sem_give(&profiler_sem);
 }
@@ -173,6 +434,17 @@ int profiler_init(void)
 		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
 	__ASSERT_NO_MSG(ret >= 0);
 
+#ifdef CONFIG_PROFILER_NORDIC_RING_BUF
+	static const char * const dropped_labels[] = {"dropped_cnt"};
+	static const enum profiler_arg dropped_types[] = {PROFILER_ARG_U32};
+
+	/* Reported in the system description like any other event type. */
+	dropped_events_id = profiler_register_event_type("profiler_dropped_events",
+							 dropped_labels,
+							 dropped_types,
+							 ARRAY_SIZE(dropped_types));
+#endif
+
 	protocol_thread_id =  k_thread_create(&profiler_nordic_thread,
 			profiler_nordic_stack,
 			K_THREAD_STACK_SIZEOF(profiler_nordic_stack),
@@ -307,6 +579,17 @@ void profiler_log_encode_string(struct log_event_buf *buf, const char *string)
 	buf->payload += string_len;
 }
 
+void profiler_log_encode_packed(struct log_event_buf *buf, const void *data,
+				size_t size)
+{
+	BUILD_ASSERT(!IS_ENABLED(CONFIG_BIG_ENDIAN),
+		     "Packed encoding requires little-endian byte order");
+	__ASSERT_NO_MSG(buf->payload - buf->payload_start + size
+			 <= CONFIG_PROFILER_CUSTOM_EVENT_BUF_LEN);
+	memcpy(buf->payload, data, size);
+	buf->payload += size;
+}
+
 void profiler_log_add_mem_address(struct log_event_buf *buf,
 				  const void *mem_address)
 {
@@ -320,12 +603,33 @@ void profiler_log_send(struct log_event_buf *buf, uint16_t event_type_id)
 		uint8_t type_id = event_type_id & UCHAR_MAX;
 
 		buf->payload_start[0] = type_id;
+
+		if (IS_ENABLED(CONFIG_PROFILER_NORDIC_RING_BUF)) {
+			ring_write(buf->payload_start,
+				   buf->payload - buf->payload_start);
+			return;
+		}
+
 		int key = irq_lock();
+		uint8_t num_bytes_send;
+
+		if (IS_ENABLED(CONFIG_PROFILER_NORDIC_TIMESTAMP_DELTA)) {
+			uint8_t data[COMPRESSED_EVENT_MAX_LEN];
+			size_t len = compress_event(data, buf->payload_start,
+					buf->payload - buf->payload_start);
 
-		uint8_t num_bytes_send = SEGGER_RTT_WriteNoLock(
+			num_bytes_send = SEGGER_RTT_WriteNoLock(
+				CONFIG_PROFILER_NORDIC_RTT_CHANNEL_DATA,
+				data, len);
+			if (num_bytes_send == 0) {
+				timestamp_resync();
+			}
+		} else {
+			num_bytes_send = SEGGER_RTT_WriteNoLock(
 				CONFIG_PROFILER_NORDIC_RTT_CHANNEL_DATA,
 				buf->payload_start,
 				buf->payload - buf->payload_start);
+		}
 		ARG_UNUSED(num_bytes_send);
 		irq_unlock(key);
 		__ASSERT_NO_MSG(num_bytes_send > 0);
@@ -37,31 +37,49 @@ static void rx_callback(struct bt_conn *conn, const uint8_t *const data, uint16_
 				  bt_nus->ctrl_blk->context);
 }
 
+/* Notification payload is copied here, so that it is not split at the end
+ * of the ring buffer.
+ */
+static uint8_t tx_buf[CONFIG_BT_L2CAP_TX_MTU];
+
 static void tx_try(const struct shell_bt_nus *bt_nus)
 {
-	uint8_t *buf;
-	uint32_t size;
-	uint32_t req_len = bt_nus_get_mtu(bt_nus->ctrl_blk->conn);
-
-	size = ring_buf_get_claim(bt_nus->tx_ringbuf, &buf, req_len);
-
-	if (size) {
-		int err, err2;
+	struct shell_bt_nus_ctrl_blk *ctrl_blk = bt_nus->ctrl_blk;
+
+	k_mutex_lock(&ctrl_blk->tx_lock, K_FOREVER);
+
+	while (atomic_get(&ctrl_blk->tx_pending) <
+	       CONFIG_SHELL_BT_NUS_TX_WINDOW) {
+		uint32_t mtu = MIN(bt_nus_get_mtu(ctrl_blk->conn),
+				   sizeof(tx_buf));
+		uint32_t used = ring_buf_capacity_get(bt_nus->tx_ringbuf) -
+				ring_buf_space_get(bt_nus->tx_ringbuf);
+		uint32_t size;
+		int err;
+
+		/* Output shorter than the MTU is held back while notifications
+		 * are in flight, to be sent together with further output.
+		 */
+		if (used == 0 ||
+		    (used < mtu && atomic_get(&ctrl_blk->tx_pending) > 0)) {
+			break;
+		}
 
-		err = bt_nus_send(bt_nus->ctrl_blk->conn, buf, size);
-		err2 = ring_buf_get_finish(bt_nus->tx_ringbuf, size);
-		__ASSERT_NO_MSG(err2 == 0);
+		size = ring_buf_get(bt_nus->tx_ringbuf, tx_buf, mtu);
 
-		if (err == 0) {
-			LOG_DBG("Sent %d bytes", size);
-		} else {
+		atomic_inc(&ctrl_blk->tx_pending);
+		err = bt_nus_send(ctrl_blk->conn, tx_buf, size);
+		if (err) {
+			atomic_dec(&ctrl_blk->tx_pending);
 			LOG_INF("Failed to send %d bytes (%d error)",
 								size, err);
-			bt_nus->ctrl_blk->tx_busy = 0;
+			break;
 		}
-	} else {
-		bt_nus->ctrl_blk->tx_busy = 0;
+
+		LOG_DBG("Sent %d bytes", size);
 	}
+
+	k_mutex_unlock(&ctrl_blk->tx_lock);
 }
 
 static void tx_callback(struct bt_conn *conn)
@@ -69,8 +87,10 @@ static void tx_callback(struct bt_conn *conn)
 	const struct shell_bt_nus *bt_nus =
 		(const struct shell_bt_nus *)shell_transport_bt_nus.ctx;
 
-
 	LOG_DBG("Sent operation completed");
+	if (atomic_get(&bt_nus->ctrl_blk->tx_pending) > 0) {
+		atomic_dec(&bt_nus->ctrl_blk->tx_pending);
+	}
 	tx_try(bt_nus);
 	bt_nus->ctrl_blk->handler(SHELL_TRANSPORT_EVT_TX_RDY,
 				  bt_nus->ctrl_blk->context);
@@ -93,6 +113,7 @@ static int init(const struct shell_transport *transport,
 			(struct shell_bt_nus *)transport->ctx;
 
 	LOG_DBG("Initialized");
+	k_mutex_init(&bt_nus->ctrl_blk->tx_lock);
 	bt_nus->ctrl_blk->handler = evt_handler;
 	bt_nus->ctrl_blk->context = context;
 
@@ -143,12 +164,13 @@ static int write(const struct shell_transport *transport,
 		return 0;
 	}
 
+	/* Data that does not fit is written again by the shell after
+	 * the next SHELL_TRANSPORT_EVT_TX_RDY event.
+	 */
 	*cnt = ring_buf_put(bt_nus->tx_ringbuf, data, length);
 	LOG_DBG("Write req:%d accept:%d", length, *cnt);
 
-	if (atomic_set(&bt_nus->ctrl_blk->tx_busy, 1) == 0) {
-		tx_try(bt_nus);
-	}
+	tx_try(bt_nus);
 
 	return 0;
 }
@@ -173,6 +195,8 @@ void shell_bt_nus_enable(struct bt_conn *conn)
 		CONFIG_LOG_MAX_LEVEL : CONFIG_SHELL_BT_NUS_INIT_LOG_LEVEL;
 
 	bt_nus->ctrl_blk->conn = conn;
+	atomic_clear(&bt_nus->ctrl_blk->tx_pending);
+	ring_buf_reset(bt_nus->tx_ringbuf);
 
 	k_sem_reset(&shell_bt_nus_ready);
 
@@ -19,6 +19,9 @@
 #ifdef CONFIG_SPM_SERVICE_FIND_FIRMWARE_INFO
 #include <fw_info.h>
 #endif
+#ifdef CONFIG_SPM_SERVICE_BATCH
+#include <secure_services.h>
+#endif
 
 /*
  * Secure Entry functions to allow access to secure services from non-secure
@@ -67,8 +70,7 @@ struct read_range {
 };
 
 
-__TZ_NONSECURE_ENTRY_FUNC
-int spm_request_read_nse(void *destination, uint32_t addr, size_t len)
+static int request_read(void *destination, uint32_t addr, size_t len)
 {
 	static const struct read_range ranges[] = {
 #ifdef PM_MCUBOOT_ADDRESS
@@ -102,6 +104,12 @@ int spm_request_read_nse(void *destination, uint32_t addr, size_t len)
 
 	return -EPERM;
 }
+
+__TZ_NONSECURE_ENTRY_FUNC
+int spm_request_read_nse(void *destination, uint32_t addr, size_t len)
+{
+	return request_read(destination, addr, len);
+}
 #endif /* CONFIG_SPM_SERVICE_READ */
 
 
@@ -115,8 +123,7 @@ void spm_request_system_reboot_nse(void)
 
 
 #ifdef CONFIG_SPM_SERVICE_RNG
-__TZ_NONSECURE_ENTRY_FUNC
-int spm_request_random_number_nse(uint8_t *output, size_t len, size_t *olen)
+static int request_random_number(uint8_t *output, size_t len, size_t *olen)
 {
 	int err = -EINVAL;
 
@@ -132,6 +139,12 @@ int spm_request_random_number_nse(uint8_t *output, size_t len, size_t *olen)
 
 	return err;
 }
+
+__TZ_NONSECURE_ENTRY_FUNC
+int spm_request_random_number_nse(uint8_t *output, size_t len, size_t *olen)
+{
+	return request_random_number(output, len, olen);
+}
 #endif /* CONFIG_SPM_SERVICE_RNG */
 
 #ifdef CONFIG_SPM_SERVICE_S0_ACTIVE
@@ -168,8 +181,7 @@ int spm_s0_active(uint32_t s0_address, uint32_t s1_address, bool *s0_active)
 #endif /* CONFIG_SPM_SERVICE_S0_ACTIVE */
 
 #ifdef CONFIG_SPM_SERVICE_FIND_FIRMWARE_INFO
-__TZ_NONSECURE_ENTRY_FUNC
-int spm_firmware_info_nse(uint32_t fw_address, struct fw_info *info)
+static int firmware_info(uint32_t fw_address, struct fw_info *info)
 {
 	const struct fw_info *tmp_info;
 
@@ -196,9 +208,73 @@ int spm_firmware_info_nse(uint32_t fw_address, struct fw_info *info)
 
 	return -EFAULT;
 }
+
+__TZ_NONSECURE_ENTRY_FUNC
+int spm_firmware_info_nse(uint32_t fw_address, struct fw_info *info)
+{
+	return firmware_info(fw_address, info);
+}
 #endif /* CONFIG_SPM_SERVICE_FIND_FIRMWARE_INFO */
 
 
+#ifdef CONFIG_SPM_SERVICE_BATCH
+static int batch_op_execute(struct spm_batch_op *op)
+{
+	switch (op->type) {
+#ifdef CONFIG_SPM_SERVICE_READ
+	case SPM_BATCH_OP_READ:
+		return request_read(op->read.destination, op->read.addr,
+				    op->read.len);
+#endif
+#ifdef CONFIG_SPM_SERVICE_RNG
+	case SPM_BATCH_OP_RANDOM_NUMBER:
+		return request_random_number(op->random_number.output,
+					     op->random_number.len,
+					     &op->random_number.olen);
+#endif
+#ifdef CONFIG_SPM_SERVICE_FIND_FIRMWARE_INFO
+	case SPM_BATCH_OP_FIRMWARE_INFO:
+		return firmware_info(op->firmware_info.fw_address,
+				     op->firmware_info.info);
+#endif
+	default:
+		return -ENOTSUP;
+	}
+}
+
+__TZ_NONSECURE_ENTRY_FUNC
+int spm_request_batch_nse(struct spm_batch_op *ops, size_t count)
+{
+	struct spm_batch_op op;
+
+	if (ops == NULL || count == 0) {
+		return -EINVAL;
+	}
+
+	if (count > CONFIG_SPM_SERVICE_BATCH_MAX_OPS) {
+		return -E2BIG;
+	}
+
+	/* Ensure that the whole array is in non-secure RAM */
+	if (ptr_in_secure_area((intptr_t)ops) ||
+	    ptr_in_secure_area((intptr_t)&ops[count] - 1)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		/* Work on a copy, so the non-secure side cannot change the
+		 * operation after it has been validated.
+		 */
+		memcpy(&op, &ops[i], sizeof(op));
+		op.result = batch_op_execute(&op);
+		memcpy(&ops[i], &op, sizeof(op));
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SPM_SERVICE_BATCH */
+
+
 #ifdef CONFIG_SPM_SERVICE_PREVALIDATE
 __TZ_NONSECURE_ENTRY_FUNC
 int spm_prevalidate_b1_upgrade_nse(uint32_t dst_addr, uint32_t src_addr)
@@ -7,6 +7,7 @@
 #include <errno.h>
 #include <stdlib.h>
 #include <shell/shell.h>
+#include <sys/atomic.h>
 
 #include <zb_nrf_platform.h>
 #include <zigbee/zigbee_error_handler.h>
@@ -28,6 +29,21 @@ static ping_time_cb_t ping_ind_cb;
 
 static zb_uint32_t get_request_duration(struct ctx_entry *req_data);
 
+/**@brief Inform user that the ping request could not be sent and free
+ *        its entry.
+ *
+ * @param ping_entry  Pointer to the context manager entry with ping
+ *                    request data.
+ */
+static void ping_request_fail(struct ctx_entry *ping_entry)
+{
+	if (ping_entry->ping_req_data.cb) {
+		ping_entry->ping_req_data.cb(PING_EVT_ERROR, 0, ping_entry);
+	}
+
+	ctx_mgr_delete_entry(ping_entry);
+}
+
 /**@brief Invalidate an entry with ping request data after the timeout.
  *        This function is called as the ZBOSS callback.
  *
@@ -52,7 +68,11 @@ static void invalidate_ping_entry_cb(zb_uint8_t index)
 	}
 }
 
-/**@brief Get the first entry with ping request sent to addr_short.
+/**@brief Get the oldest entry with ping request sent to addr_short.
+ *
+ * @details APS acknowledgments do not carry the ping sequence number, so
+ *          with several requests to the same node in flight, the oldest
+ *          one is assumed to be acknowledged first.
  *
  * @param addr_short  Short network address to look for.
  *
@@ -62,6 +82,7 @@ static struct ctx_entry *find_ping_entry_by_short(zb_uint16_t addr_short)
 {
 	int i;
 	zb_addr_u req_remote_addr;
+	struct ctx_entry *oldest = NULL;
 
 	for (i = 0; i < CONFIG_ZIGBEE_SHELL_CTX_MGR_ENTRIES_NBR; i++) {
 		struct ctx_entry *ping_entry = ctx_mgr_get_entry_by_index(i);
@@ -80,19 +101,28 @@ static struct ctx_entry *find_ping_entry_by_short(zb_uint16_t addr_short)
 
 		if (ping_entry->ping_req_data.packet_info.dst_addr_mode ==
 		    ZB_APS_ADDR_MODE_16_ENDP_PRESENT) {
-			if (req_remote_addr.addr_short == addr_short) {
-				return ping_entry;
+			if (req_remote_addr.addr_short != addr_short) {
+				continue;
 			}
 		} else {
 			if (zb_address_short_by_ieee(
-				req_remote_addr.addr_long) == addr_short) {
-
-				return ping_entry;
+				req_remote_addr.addr_long) != addr_short) {
+				continue;
 			}
 		}
+
+		/* Skip requests that are not sent yet. */
+		if (ping_entry->ping_req_data.sent_time == 0) {
+			continue;
+		}
+
+		if (!oldest || (ping_entry->ping_req_data.sent_time <
+				oldest->ping_req_data.sent_time)) {
+			oldest = ping_entry;
+		}
 	}
 
-	return NULL;
+	return oldest;
 }
 
 /**@brief Function to actually send a ping frame.
@@ -136,10 +166,9 @@ static void zb_zcl_send_ping_frame(zb_uint8_t index)
 
 	if (ping_entry->type == CTX_MGR_PING_REQ_ENTRY_TYPE) {
 		if (zb_err_code != RET_OK) {
-			zb_cli_print_error(ping_entry->shell,
-					   "Can not send zcl frame", ZB_FALSE);
+			LOG_ERR("Can not send zcl frame");
 			zb_buf_free(packet_info->buffer);
-			ctx_mgr_delete_entry(ping_entry);
+			ping_request_fail(ping_entry);
 			return;
 		}
 
@@ -149,10 +178,8 @@ static void zb_zcl_send_ping_frame(zb_uint8_t index)
 					ping_entry->ping_req_data.timeout_ms));
 
 		if (zb_err_code != RET_OK) {
-			zb_cli_print_error(ping_entry->shell,
-					   "Can not schedule timeout alarm.",
-					   ZB_FALSE);
-			ctx_mgr_delete_entry(ping_entry);
+			LOG_ERR("Can not schedule timeout alarm");
+			ping_request_fail(ping_entry);
 			return;
 		}
 
@@ -352,10 +379,7 @@ static void ping_request_send(struct ctx_entry *ping_entry)
 		&(ping_entry->ping_req_data.packet_info);
 
 	if (ping_entry->ping_req_data.count > PING_MAX_LENGTH) {
-		if (ping_entry->ping_req_data.cb) {
-			ping_entry->ping_req_data.cb(PING_EVT_ERROR, 0,
-						     ping_entry);
-		}
+		ping_request_fail(ping_entry);
 		return;
 	}
 
@@ -365,10 +389,7 @@ static void ping_request_send(struct ctx_entry *ping_entry)
 	zb_osif_enable_all_inter();
 
 	if (!bufid) {
-		if (ping_entry->ping_req_data.cb) {
-			ping_entry->ping_req_data.cb(PING_EVT_ERROR, 0,
-						     ping_entry);
-		}
+		ping_request_fail(ping_entry);
 		return;
 	}
 
@@ -400,6 +421,8 @@ static void ping_request_send(struct ctx_entry *ping_entry)
 	       ping_entry->ping_req_data.count);
 	cmd_buf_ptr += ping_entry->ping_req_data.count;
 	ping_entry->ping_req_data.ping_seq = ping_seq_num;
+	/* The ping reply is matched to the request by the sequence number. */
+	ping_entry->id = ping_seq_num;
 	ping_seq_num++;
 
 	/* Schedule frame to send. */
@@ -418,15 +441,14 @@ static void ping_request_send(struct ctx_entry *ping_entry)
 					       ctx_mgr_get_index_by_entry(
 							ping_entry));
 	if (zb_err_code != RET_OK) {
-		zb_cli_print_error(ping_entry->shell,
-				   "Can not schedule zcl frame.", ZB_FALSE);
+		LOG_ERR("Can not schedule zcl frame");
 
 		/* Make sure ZBOSS buffer API is called safely. */
 		zb_osif_disable_all_inter();
 		zb_buf_free(packet_info->buffer);
 		zb_osif_enable_all_inter();
 
-		ctx_mgr_delete_entry(ping_entry);
+		ping_request_fail(ping_entry);
 		return;
 	}
 }
@@ -822,3 +844,327 @@ int cmd_zb_ping(const struct shell *shell, size_t argc, char **argv)
 	ping_request_send(ping_entry);
 	return 0;
 }
+
+/* State of the ongoing ping benchmark. Only one benchmark can run at a time,
+ * and it is only accessed from the ZBOSS context once started.
+ */
+static struct {
+	const struct shell *shell;
+	zb_addr_u dst_addr;
+	zb_uint8_t dst_addr_mode;
+	bool request_echo;
+	bool request_ack;
+	bool sweep_ack;
+	zb_uint16_t payload;
+	zb_uint16_t payload_max;
+	zb_uint16_t payload_step;
+	zb_uint16_t count;
+	zb_uint8_t window;
+	/* Progress of the current run. */
+	zb_uint16_t sent;
+	zb_uint16_t received;
+	zb_uint16_t lost;
+	zb_uint8_t outstanding;
+	bool filling;
+	int64_t start_time;
+	zb_uint16_t latency_ms[CONFIG_ZIGBEE_SHELL_PING_BENCH_MAX_COUNT];
+} bench;
+
+static atomic_t bench_active;
+
+static void ping_bench_fill(void);
+
+static int latency_cmp(const void *a, const void *b)
+{
+	return (int)*(const zb_uint16_t *)a - (int)*(const zb_uint16_t *)b;
+}
+
+/**@brief Get the latency percentile of the received pings,
+ *        using the nearest-rank method.
+ */
+static zb_uint16_t latency_percentile(zb_uint8_t percent)
+{
+	zb_uint32_t rank = ceiling_fraction((zb_uint32_t)percent * bench.received,
+					    100);
+
+	return bench.latency_ms[MAX(rank, 1) - 1];
+}
+
+static void ping_bench_print(void)
+{
+	uint32_t elapsed_ms = MAX(k_uptime_get() - bench.start_time, 1);
+	uint32_t avg_ms = 0;
+
+	for (zb_uint16_t i = 0; i < bench.received; i++) {
+		avg_ms += bench.latency_ms[i];
+	}
+
+	shell_print(bench.shell,
+		    "payload %u B, APS ACK %s: sent %u, received %u, lost %u (%u%%)",
+		    bench.payload, bench.request_ack ? "on" : "off",
+		    bench.sent, bench.received, bench.lost,
+		    (bench.lost * 100U) / MAX(bench.sent, 1));
+
+	if (bench.received) {
+		avg_ms /= bench.received;
+		qsort(bench.latency_ms, bench.received,
+		      sizeof(bench.latency_ms[0]), latency_cmp);
+
+		shell_print(bench.shell,
+			    "  latency ms: min %u avg %u p50 %u p90 %u p99 %u max %u",
+			    bench.latency_ms[0], avg_ms, latency_percentile(50),
+			    latency_percentile(90), latency_percentile(99),
+			    bench.latency_ms[bench.received - 1]);
+	}
+
+	shell_print(bench.shell, "  throughput: %u pings/s, %u B/s in %u ms",
+		    (bench.received * MSEC_PER_SEC) / elapsed_ms,
+		    (bench.received * bench.payload * MSEC_PER_SEC) / elapsed_ms,
+		    elapsed_ms);
+}
+
+static void ping_bench_run_start(zb_uint8_t param)
+{
+	ARG_UNUSED(param);
+
+	bench.sent = 0;
+	bench.received = 0;
+	bench.lost = 0;
+	bench.outstanding = 0;
+	bench.start_time = k_uptime_get();
+
+	ping_bench_fill();
+}
+
+/**@brief Select the parameters of the next run of the sweep.
+ *
+ * @return  True if there is another run, false if the benchmark is done.
+ */
+static bool ping_bench_next_run(void)
+{
+	if (bench.sweep_ack && !bench.request_ack) {
+		bench.request_ack = true;
+		return true;
+	}
+
+	if (bench.payload_step &&
+	    (bench.payload + bench.payload_step <= bench.payload_max)) {
+		bench.payload += bench.payload_step;
+		if (bench.sweep_ack) {
+			bench.request_ack = false;
+		}
+		return true;
+	}
+
+	return false;
+}
+
+static void ping_bench_run_end(void)
+{
+	ping_bench_print();
+
+	if (ping_bench_next_run() &&
+	    (ZB_SCHEDULE_APP_CALLBACK(ping_bench_run_start, 0) == RET_OK)) {
+		return;
+	}
+
+	zb_cli_print_done(bench.shell, ZB_FALSE);
+	atomic_clear(&bench_active);
+}
+
+/**@brief Ping event handler of the benchmark. Records the result of every
+ *        request and keeps the configured number of requests in flight.
+ */
+static void ping_bench_evt_handler(enum ping_time_evt evt, zb_uint32_t delay_ms,
+				   struct ctx_entry *req_data)
+{
+	bool echo = req_data->ping_req_data.request_echo;
+	bool ack = req_data->ping_req_data.request_ack;
+
+	switch (evt) {
+	case PING_EVT_ECHO_RECEIVED:
+		break;
+
+	case PING_EVT_ACK_RECEIVED:
+		if (echo) {
+			return;
+		}
+		break;
+
+	case PING_EVT_FRAME_SENT:
+		if (echo || ack) {
+			return;
+		}
+		break;
+
+	case PING_EVT_FRAME_TIMEOUT:
+	case PING_EVT_ERROR:
+		bench.lost++;
+		bench.outstanding--;
+		goto done;
+
+	default:
+		return;
+	}
+
+	bench.latency_ms[bench.received++] = MIN(delay_ms, UINT16_MAX);
+	bench.outstanding--;
+
+done:
+	if (!bench.filling) {
+		ping_bench_fill();
+	}
+}
+
+/**@brief Send requests until the configured number of them is in flight. */
+static void ping_bench_fill(void)
+{
+	bench.filling = true;
+
+	while ((bench.outstanding < bench.window) && (bench.sent < bench.count)) {
+		struct ctx_entry *ping_entry =
+			ctx_mgr_new_entry(CTX_MGR_PING_REQ_ENTRY_TYPE);
+
+		if (!ping_entry) {
+			/* Retry when one of the ongoing requests is done. */
+			break;
+		}
+
+		ping_entry->shell = bench.shell;
+		ping_entry->ping_req_data.cb = ping_bench_evt_handler;
+		ping_entry->ping_req_data.request_ack = bench.request_ack;
+		ping_entry->ping_req_data.request_echo = bench.request_echo;
+		ping_entry->ping_req_data.count = bench.payload;
+		ping_entry->ping_req_data.timeout_ms =
+			PING_ECHO_REQUEST_TIMEOUT_S * MSEC_PER_SEC;
+		ping_entry->ping_req_data.packet_info.dst_addr = bench.dst_addr;
+		ping_entry->ping_req_data.packet_info.dst_addr_mode =
+			bench.dst_addr_mode;
+
+		bench.sent++;
+		bench.outstanding++;
+
+		ping_request_send(ping_entry);
+	}
+
+	bench.filling = false;
+
+	if (bench.outstanding == 0) {
+		if (bench.sent < bench.count) {
+			/* No entry could be taken, count the rest as lost. */
+			LOG_ERR("No free context entry for the ping benchmark");
+			bench.lost += bench.count - bench.sent;
+			bench.sent = bench.count;
+		}
+
+		ping_bench_run_end();
+	}
+}
+
+/** @brief Benchmark the ping over ZCL
+ *
+ * @code
+ * zcl ping_bench [--no-echo] [--aps-ack] [--sweep-ack] [--sweep-size <d:step>]
+ *                <h:dst_addr> <d:payload size> <d:count> <d:window>
+ * @endcode
+ *
+ * Example:
+ * @code
+ * zcl ping_bench 0b010eaafd745dfa 32 100 4
+ * @endcode
+ *
+ * @pre Ping only after starting @ref zigbee.
+ *
+ * Send `count` ping requests of `payload_size` bytes to the device with
+ * the address `dst_addr`, keeping up to `window` of them in flight, and
+ * print the loss, the latency percentiles and the throughput.<br>
+ *
+ * The `--no-echo` and `--aps-ack` options have the same meaning as
+ * for the `zcl ping` command. With `--sweep-ack`, each run is repeated with
+ * and without the APS acknowledgment. With `--sweep-size`, the runs are
+ * repeated for payload sizes from `step` to `payload_size` bytes, in
+ * increments of `step` bytes.
+ */
+int cmd_zb_ping_bench(const struct shell *shell, size_t argc, char **argv)
+{
+	size_t i;
+
+	if (!atomic_cas(&bench_active, 0, 1)) {
+		zb_cli_print_error(shell, "Ping benchmark already running",
+				   ZB_FALSE);
+		return -EBUSY;
+	}
+
+	bench.shell = shell;
+	bench.request_echo = true;
+	bench.request_ack = false;
+	bench.sweep_ack = false;
+	bench.payload_step = 0;
+
+	for (i = 1; i < (argc - 4); i++) {
+		if (strcmp(argv[i], "--aps-ack") == 0) {
+			bench.request_ack = true;
+		} else if (strcmp(argv[i], "--no-echo") == 0) {
+			bench.request_echo = false;
+		} else if (strcmp(argv[i], "--sweep-ack") == 0) {
+			bench.sweep_ack = true;
+		} else if ((strcmp(argv[i], "--sweep-size") == 0) &&
+			   (i + 1 < (argc - 4)) &&
+			   zb_cli_sscan_uint(argv[i + 1],
+					     (uint8_t *)&bench.payload_step,
+					     2, 10)) {
+			i++;
+		} else {
+			zb_cli_print_error(shell, "Unknown option", ZB_FALSE);
+			goto error;
+		}
+	}
+
+	if (bench.sweep_ack) {
+		bench.request_ack = false;
+	}
+
+	bench.dst_addr_mode = parse_address(argv[argc - 4], &bench.dst_addr,
+					    ADDR_ANY);
+	if (bench.dst_addr_mode == ADDR_INVALID) {
+		zb_cli_print_error(shell, "Wrong address format", ZB_FALSE);
+		goto error;
+	}
+
+	if (!zb_cli_sscan_uint(argv[argc - 3], (uint8_t *)&bench.payload_max,
+			       2, 10) ||
+	    (bench.payload_max > PING_MAX_LENGTH)) {
+		zb_cli_print_error(shell, "Incorrect ping payload size",
+				   ZB_FALSE);
+		goto error;
+	}
+
+	if (!zb_cli_sscan_uint(argv[argc - 2], (uint8_t *)&bench.count, 2, 10) ||
+	    (bench.count == 0) ||
+	    (bench.count > CONFIG_ZIGBEE_SHELL_PING_BENCH_MAX_COUNT)) {
+		zb_cli_print_error(shell, "Incorrect ping count", ZB_FALSE);
+		goto error;
+	}
+
+	if (!zb_cli_sscan_uint(argv[argc - 1], &bench.window, 1, 10) ||
+	    (bench.window == 0)) {
+		zb_cli_print_error(shell, "Incorrect ping window", ZB_FALSE);
+		goto error;
+	}
+
+	bench.payload = bench.payload_step ?
+			MIN(bench.payload_step, bench.payload_max) :
+			bench.payload_max;
+
+	if (ZB_SCHEDULE_APP_CALLBACK(ping_bench_run_start, 0) != RET_OK) {
+		zb_cli_print_error(shell, "Can not schedule ping benchmark",
+				   ZB_FALSE);
+		goto error;
+	}
+
+	return 0;
+
+error:
+	atomic_clear(&bench_active);
+	return -EINVAL;
+}
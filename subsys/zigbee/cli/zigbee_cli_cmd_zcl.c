@@ -15,9 +15,16 @@
 	("Send ping command over ZCL.\n" \
 	"Usage: ping [--no-echo] [--aps-ack] <h:addr> <d:payload size>")
 
+#define PING_BENCH_HELP \
+	("Benchmark ping over ZCL.\n" \
+	"Usage: ping_bench [--no-echo] [--aps-ack] [--sweep-ack]\n" \
+	"                  [--sweep-size <d:step>] <h:addr>\n" \
+	"                  <d:payload size> <d:count> <d:window>")
+
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_zcl,
 	SHELL_CMD_ARG(ping, NULL, PING_HELP, cmd_zb_ping, 3, 2),
+	SHELL_CMD_ARG(ping_bench, NULL, PING_BENCH_HELP, cmd_zb_ping_bench, 5, 5),
 	SHELL_SUBCMD_SET_END);
 
 SHELL_CMD_REGISTER(zcl, &sub_zcl, "ZCL subsystem commands.", NULL);
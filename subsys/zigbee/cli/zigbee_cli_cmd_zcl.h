@@ -8,6 +8,7 @@
 #define ZIGBEE_CLI_CMD_ZCL_H__
 
 int cmd_zb_ping(const struct shell *shell, size_t argc, char **argv);
+int cmd_zb_ping_bench(const struct shell *shell, size_t argc, char **argv);
 
 /* Structure used to pass information required to send ZCL frame. */
 struct zcl_packet_info {
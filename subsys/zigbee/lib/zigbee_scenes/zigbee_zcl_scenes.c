@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <logging/log.h>
 #include <settings/settings.h>
 #include <zb_nrf_platform.h>
@@ -14,6 +16,7 @@ LOG_MODULE_REGISTER(zcl_scenes, CONFIG_ZIGBEE_SCENES_LOG_LEVEL);
 static zb_uint8_t scene_table_get_entry(zb_uint16_t group_id, zb_uint8_t scene_id);
 static void scene_table_remove_entries_by_group(zb_uint16_t group_id);
 static void scene_table_init(void);
+static void scene_index_rebuild(void);
 
 struct zb_zcl_scenes_fieldset_data_on_off {
 	zb_bool_t  has_on_off;
@@ -41,6 +44,22 @@ struct scene_table_on_off_entry {
 
 static struct scene_table_on_off_entry scenes_table[CONFIG_ZIGBEE_SCENE_TABLE_SIZE];
 
+#define SCENE_IDX_NONE 0xFF
+#define SCENE_HASH_SIZE CONFIG_ZIGBEE_SCENE_TABLE_SIZE
+
+/* Scene table entries are chained by the hash of their group and scene ID,
+ * so that the lookup does not depend on the table size. Free entries are
+ * chained in the free list through the same links.
+ */
+static zb_uint8_t scene_buckets[SCENE_HASH_SIZE];
+static zb_uint8_t scene_next[CONFIG_ZIGBEE_SCENE_TABLE_SIZE];
+static zb_uint8_t scene_free_head;
+
+/* The table was loaded from the key used before the entries were stored
+ * separately.
+ */
+static bool scenes_table_legacy;
+
 struct response_info {
 	zb_zcl_parsed_hdr_t cmd_info;
 	zb_zcl_scenes_view_scene_req_t view_scene_req;
@@ -52,6 +71,8 @@ static struct response_info resp_info;
 static int scenes_table_set(const char *name, size_t len, settings_read_cb read_cb, void *cb_arg)
 {
 	const char *next;
+	unsigned long idx;
+	char *end;
 	int rc;
 
 	if (settings_name_steq(name, "scenes_table", &next) && !next) {
@@ -60,6 +81,26 @@ static int scenes_table_set(const char *name, size_t len, settings_read_cb read_
 		}
 
 		rc = read_cb(cb_arg, scenes_table, sizeof(scenes_table));
+		if (rc >= 0) {
+			scenes_table_legacy = true;
+			return 0;
+		}
+
+		return rc;
+	}
+
+	if (settings_name_steq(name, "entry", &next) && next) {
+		idx = strtoul(next, &end, 16);
+		if (end == next || *end != '\0' ||
+		    idx >= CONFIG_ZIGBEE_SCENE_TABLE_SIZE) {
+			return -ENOENT;
+		}
+
+		if (len != sizeof(scenes_table[idx])) {
+			return -EINVAL;
+		}
+
+		rc = read_cb(cb_arg, &scenes_table[idx], sizeof(scenes_table[idx]));
 		if (rc >= 0) {
 			return 0;
 		}
@@ -70,14 +111,46 @@ static int scenes_table_set(const char *name, size_t len, settings_read_cb read_
 	return -ENOENT;
 }
 
+static void scene_entry_save(zb_uint8_t idx)
+{
+	char key[sizeof("scenes/entry/ff")];
+
+	snprintf(key, sizeof(key), "scenes/entry/%x", idx);
+
+	if (scenes_table[idx].common.group_id == ZB_ZCL_SCENES_FREE_SCENE_TABLE_RECORD) {
+		settings_delete(key);
+	} else {
+		settings_save_one(key, &scenes_table[idx], sizeof(scenes_table[idx]));
+	}
+}
+
 static void scenes_table_save(void)
 {
-	settings_save_one("scenes/scenes_table", scenes_table, sizeof(scenes_table));
+	for (zb_uint8_t i = 0; i < CONFIG_ZIGBEE_SCENE_TABLE_SIZE; i++) {
+		scene_entry_save(i);
+	}
+}
+
+static int scenes_table_commit(void)
+{
+	if (scenes_table_legacy) {
+		/* Store the entries separately, so that changing one of them
+		 * does not rewrite the whole table.
+		 */
+		scenes_table_legacy = false;
+		scenes_table_save();
+		settings_delete("scenes/scenes_table");
+	}
+
+	scene_index_rebuild();
+
+	return 0;
 }
 
 struct settings_handler scenes_conf = {
 	.name = "scenes",
-	.h_set = scenes_table_set
+	.h_set = scenes_table_set,
+	.h_commit = scenes_table_commit
 };
 
 static zb_bool_t has_cluster(zb_uint16_t cluster_id)
@@ -488,6 +561,72 @@ static void send_get_scene_membership_resp(zb_bufid_t bufid)
 	LOG_DBG("<< %s", __func__);
 }
 
+static zb_uint8_t scene_hash(zb_uint16_t group_id, zb_uint8_t scene_id)
+{
+	return (((zb_uint32_t)group_id << 8) ^ scene_id) % SCENE_HASH_SIZE;
+}
+
+static void scene_index_rebuild(void)
+{
+	zb_uint8_t i = CONFIG_ZIGBEE_SCENE_TABLE_SIZE;
+
+	memset(scene_buckets, SCENE_IDX_NONE, sizeof(scene_buckets));
+	scene_free_head = SCENE_IDX_NONE;
+
+	/* Walk backwards, so that the free list starts at the lowest index. */
+	while (i--) {
+		zb_uint8_t *head;
+
+		if (scenes_table[i].common.group_id == ZB_ZCL_SCENES_FREE_SCENE_TABLE_RECORD) {
+			head = &scene_free_head;
+		} else {
+			head = &scene_buckets[scene_hash(scenes_table[i].common.group_id,
+							 scenes_table[i].common.scene_id)];
+		}
+
+		scene_next[i] = *head;
+		*head = i;
+	}
+}
+
+static void scene_index_unlink(zb_uint8_t *head, zb_uint8_t idx)
+{
+	while (*head != SCENE_IDX_NONE) {
+		if (*head == idx) {
+			*head = scene_next[idx];
+			return;
+		}
+
+		head = &scene_next[*head];
+	}
+}
+
+/* Must be called once the group and scene ID are set in a free entry. */
+static void scene_index_add(zb_uint8_t idx)
+{
+	zb_uint8_t *head = &scene_buckets[scene_hash(scenes_table[idx].common.group_id,
+						     scenes_table[idx].common.scene_id)];
+
+	/* New entries are always taken from the head of the free list. */
+	scene_index_unlink(&scene_free_head, idx);
+
+	scene_next[idx] = *head;
+	*head = idx;
+}
+
+static void scene_table_remove_entry(zb_uint8_t idx)
+{
+	scene_index_unlink(&scene_buckets[scene_hash(scenes_table[idx].common.group_id,
+						     scenes_table[idx].common.scene_id)],
+			   idx);
+
+	memset(&scenes_table[idx], 0, sizeof(scenes_table[idx]));
+	scenes_table[idx].common.group_id = ZB_ZCL_SCENES_FREE_SCENE_TABLE_RECORD;
+
+	scene_next[idx] = scene_free_head;
+	scene_free_head = idx;
+}
+
 static void scene_table_init(void)
 {
 	zb_uint8_t i = 0;
@@ -497,28 +636,25 @@ static void scene_table_init(void)
 		scenes_table[i].common.group_id = ZB_ZCL_SCENES_FREE_SCENE_TABLE_RECORD;
 		++i;
 	}
+
+	scene_index_rebuild();
 }
 
 static zb_uint8_t scene_table_get_entry(zb_uint16_t group_id, zb_uint8_t scene_id)
 {
-	zb_uint8_t i = 0;
-	zb_uint8_t idx = 0xFF, free_idx = 0xFF;
+	zb_uint8_t i = scene_buckets[scene_hash(group_id, scene_id)];
 
-	while (i < CONFIG_ZIGBEE_SCENE_TABLE_SIZE) {
+	while (i != SCENE_IDX_NONE) {
 		if (scenes_table[i].common.group_id == group_id &&
 		    scenes_table[i].common.scene_id == scene_id) {
-			idx = i;
-			break;
-		} else if ((free_idx == 0xFF) &&
-			 (scenes_table[i].common.group_id ==
-			  ZB_ZCL_SCENES_FREE_SCENE_TABLE_RECORD)) {
-			/* Remember free index */
-			free_idx = i;
+			return i;
 		}
-		++i;
+
+		i = scene_next[i];
 	}
 
-	return ((idx != 0xFF) ? idx : free_idx);
+	/* Not found, return the first free index. */
+	return scene_free_head;
 }
 
 static void scene_table_remove_entries_by_group(zb_uint16_t group_id)
@@ -529,8 +665,8 @@ static void scene_table_remove_entries_by_group(zb_uint16_t group_id)
 	while (i < CONFIG_ZIGBEE_SCENE_TABLE_SIZE) {
 		if (scenes_table[i].common.group_id == group_id) {
 			LOG_INF("removing scene: entry idx %hd", i);
-			memset(&scenes_table[i], 0, sizeof(scenes_table[i]));
-			scenes_table[i].common.group_id = ZB_ZCL_SCENES_FREE_SCENE_TABLE_RECORD;
+			scene_table_remove_entry(i);
+			scene_entry_save(i);
 		}
 		++i;
 	}
@@ -728,12 +864,18 @@ zb_bool_t zcl_scenes_cb(zb_bufid_t bufid)
 			}
 			if (empty_entry == ZB_FALSE) {
 				/* Store this scene */
+				bool is_new = (scenes_table[idx].common.group_id ==
+					       ZB_ZCL_SCENES_FREE_SCENE_TABLE_RECORD);
+
 				scenes_table[idx].common.group_id = add_scene_req->group_id;
 				scenes_table[idx].common.scene_id = add_scene_req->scene_id;
 				scenes_table[idx].common.transition_time =
 						add_scene_req->transition_time;
+				if (is_new) {
+					scene_index_add(idx);
+				}
 				*add_scene_status = ZB_ZCL_STATUS_SUCCESS;
-				scenes_table_save();
+				scene_entry_save(idx);
 			}
 		} else {
 			LOG_ERR("Unable to add scene: ZB_ZCL_STATUS_INSUFF_SPACE");
@@ -782,11 +924,10 @@ zb_bool_t zcl_scenes_cb(zb_bufid_t bufid)
 		if (idx != 0xFF &&
 		    scenes_table[idx].common.group_id != ZB_ZCL_SCENES_FREE_SCENE_TABLE_RECORD) {
 			/* Remove this entry */
-			memset(&scenes_table[idx], 0, sizeof(scenes_table[idx]));
-			scenes_table[idx].common.group_id = ZB_ZCL_SCENES_FREE_SCENE_TABLE_RECORD;
+			scene_table_remove_entry(idx);
 			LOG_INF("removing scene: entry idx %hd", idx);
 			*remove_scene_status = ZB_ZCL_STATUS_SUCCESS;
-			scenes_table_save();
+			scene_entry_save(idx);
 		} else if (!zb_aps_is_endpoint_in_group(
 				remove_scene_req->group_id,
 				ZB_ZCL_PARSED_HDR_SHORT_DATA(in_cmd_info).dst_endpoint)) {
@@ -813,7 +954,6 @@ zb_bool_t zcl_scenes_cb(zb_bufid_t bufid)
 		} else {
 			scene_table_remove_entries_by_group(remove_all_scenes_req->group_id);
 			*remove_all_scenes_status = ZB_ZCL_STATUS_SUCCESS;
-			scenes_table_save();
 		}
 	}
 	break;
@@ -853,11 +993,12 @@ zb_bool_t zcl_scenes_cb(zb_bufid_t bufid)
 					scenes_table[idx].common.scene_id =
 						store_scene_req->scene_id;
 					scenes_table[idx].common.transition_time = 0;
+					scene_index_add(idx);
 					LOG_INF("create new scene: entry idx %hd", idx);
 				}
 				save_state_as_scene(&scenes_table[idx]);
 				*store_scene_status = ZB_ZCL_STATUS_SUCCESS;
-				scenes_table_save();
+				scene_entry_save(idx);
 			} else {
 				*store_scene_status = ZB_ZCL_STATUS_INSUFF_SPACE;
 			}
@@ -918,7 +1059,6 @@ zb_bool_t zcl_scenes_cb(zb_bufid_t bufid)
 
 		/* Have only one endpoint */
 		scene_table_remove_entries_by_group(remove_all_scenes_req->group_id);
-		scenes_table_save();
 	}
 	break;
 
@@ -37,6 +37,18 @@ static uint8_t *uart_rx_buf;
 static volatile size_t uart_rx_buf_offset;
 static volatile size_t uart_rx_buf_len;
 
+#if CONFIG_ZIGBEE_UART_ASYNC_API
+/* Reception alternates between the two buffers, so the UART keeps
+ * receiving while the data of the other one is processed.
+ */
+static uint8_t rx_dma_buf[2][CONFIG_ZIGBEE_UART_RX_DMA_BUF_LEN];
+static uint8_t rx_dma_buf_next;
+static struct k_spinlock rx_lock;
+
+/* Time of line inactivity after which the received data is processed. */
+#define UART_RX_DMA_IDLE_TIMEOUT_MS 1
+#endif /* CONFIG_ZIGBEE_UART_ASYNC_API */
+
 static void uart_tx_timeout(struct k_timer *dummy);
 static void uart_rx_timeout(struct k_timer *dummy);
 
@@ -64,7 +76,7 @@ static void uart_rx_notify(zb_bufid_t bufid)
 	}
 }
 
-static void uart_rx_bytes(uint8_t *buf, size_t len)
+static void uart_rx_bytes(const uint8_t *buf, size_t len)
 {
 	if (char_handler) {
 		for (size_t i = 0; i < len; i++) {
@@ -74,23 +86,31 @@ static void uart_rx_bytes(uint8_t *buf, size_t len)
 }
 
 /**
- * Inform user about transmission timeout.
+ * Inform user about the end of transmission and unlock for the next one.
  */
-static void uart_tx_timeout(struct k_timer *dummy)
+static void uart_tx_finish(zb_uint8_t status)
 {
 	uart_tx_buf_offset = 0;
 	uart_tx_buf_len = 0;
 	uart_tx_buf = uart_tx_buf_bak;
+
+	k_timer_stop(&uart_tx_timer);
 	k_sem_give(&tx_done_sem);
 
 	if (tx_trx_data_cb) {
-		zigbee_schedule_callback(
-			tx_trx_data_cb,
-			SERIAL_SEND_TIMEOUT_EXPIRED);
+		zigbee_schedule_callback(tx_trx_data_cb, status);
 		tx_trx_data_cb = NULL;
 	}
 }
 
+/**
+ * Inform user about transmission timeout.
+ */
+static void uart_tx_timeout(struct k_timer *dummy)
+{
+	uart_tx_finish(SERIAL_SEND_TIMEOUT_EXPIRED);
+}
+
 /**
  * Inform user about reception timeout.
  */
@@ -107,6 +127,137 @@ static void uart_rx_timeout(struct k_timer *dummy)
 	}
 }
 
+/**
+ * Pass the user's buffer to ZBOSS once it is full, or wait for more data.
+ */
+static void uart_rx_buf_update(void)
+{
+	if (uart_rx_buf_offset == uart_rx_buf_len) {
+		uart_rx_buf_len = 0;
+		k_timer_stop(&uart_rx_timer);
+
+		if (zigbee_schedule_callback(uart_rx_notify, 0)) {
+			uart_rx_buf_offset = 0;
+			uart_rx_buf = NULL;
+			k_sem_give(&rx_done_sem);
+		}
+	} else {
+		k_timer_start(
+			&uart_rx_timer,
+			K_MSEC(CONFIG_ZIGBEE_UART_PARTIAL_RX_TIMEOUT),
+			K_NO_WAIT);
+	}
+}
+
+/**
+ * Store bytes that do not fit in the user's buffer, dropping the oldest ones.
+ */
+static void uart_rx_store(const uint8_t *buf, size_t len)
+{
+	if (len > ring_buf_space_get(&rx_ringbuf)) {
+		uint8_t dummy_buffer[CONFIG_ZIGBEE_UART_RX_BUF_LEN];
+
+		(void)ring_buf_get(&rx_ringbuf, dummy_buffer,
+			MIN(sizeof(dummy_buffer),
+			    len - ring_buf_space_get(&rx_ringbuf)));
+	}
+
+	(void)ring_buf_put(&rx_ringbuf, buf, len);
+}
+
+#if CONFIG_ZIGBEE_UART_ASYNC_API
+/**
+ * Copy the data received by DMA directly to the user's buffer, if there is
+ * one, and keep the rest for the next reception.
+ */
+static void uart_rx_process(const uint8_t *buf, size_t len)
+{
+	uart_rx_bytes(buf, len);
+
+	if (uart_rx_buf && (uart_rx_buf_offset < uart_rx_buf_len)) {
+		size_t copy_len = MIN(len, uart_rx_buf_len - uart_rx_buf_offset);
+
+		memcpy(&uart_rx_buf[uart_rx_buf_offset], buf, copy_len);
+		uart_rx_buf_offset += copy_len;
+		buf += copy_len;
+		len -= copy_len;
+
+		uart_rx_buf_update();
+	}
+
+	if (len) {
+		uart_rx_store(buf, len);
+	}
+}
+
+static void uart_rx_start(const struct device *dev)
+{
+	rx_dma_buf_next = 1;
+
+	(void)uart_rx_enable(dev, rx_dma_buf[0], sizeof(rx_dma_buf[0]),
+			     UART_RX_DMA_IDLE_TIMEOUT_MS);
+}
+
+static void uart_evt_handler(const struct device *dev, struct uart_event *evt,
+			     void *user_data)
+{
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(user_data);
+
+	switch (evt->type) {
+	case UART_RX_RDY:
+		key = k_spin_lock(&rx_lock);
+		uart_rx_process(&evt->data.rx.buf[evt->data.rx.offset],
+				evt->data.rx.len);
+		k_spin_unlock(&rx_lock, key);
+		break;
+
+	case UART_RX_BUF_REQUEST:
+		(void)uart_rx_buf_rsp(dev, rx_dma_buf[rx_dma_buf_next],
+				      sizeof(rx_dma_buf[0]));
+		rx_dma_buf_next ^= 1;
+		break;
+
+	case UART_RX_DISABLED:
+		/* The reception stops on errors, continue unless sleeping. */
+		if (!is_sleeping) {
+			uart_rx_start(dev);
+		}
+		break;
+
+	case UART_TX_DONE:
+		uart_tx_finish(SERIAL_SEND_SUCCESS);
+		break;
+
+	case UART_TX_ABORTED:
+		uart_tx_finish(SERIAL_SEND_TIMEOUT_EXPIRED);
+		break;
+
+	default:
+		break;
+	}
+}
+
+/**
+ * The whole buffer is sent in a single DMA transfer.
+ */
+static void uart_tx_start(void)
+{
+	int err = uart_tx(uart_dev, uart_tx_buf, uart_tx_buf_len,
+			  SYS_FOREVER_MS);
+
+	if (err) {
+		uart_tx_finish(SERIAL_SEND_ERROR);
+	}
+}
+#else
+static void uart_tx_start(void)
+{
+	/* Enable TX ready event. */
+	uart_irq_tx_enable(uart_dev);
+}
+
 static void handle_rx_ready_evt(const struct device *dev)
 {
 	int recv_len = 0;
@@ -127,34 +278,13 @@ static void handle_rx_ready_evt(const struct device *dev)
 		uart_rx_bytes(&uart_rx_buf[uart_rx_buf_offset], recv_len);
 		uart_rx_buf_offset += recv_len;
 
-		if (uart_rx_buf_offset == uart_rx_buf_len) {
-			uart_rx_buf_len = 0;
-			k_timer_stop(&uart_rx_timer);
-
-			if (zigbee_schedule_callback(uart_rx_notify, 0)) {
-				uart_rx_buf_offset = 0;
-				uart_rx_buf = NULL;
-				k_sem_give(&rx_done_sem);
-			}
-		} else {
-			k_timer_start(
-				&uart_rx_timer,
-				K_MSEC(CONFIG_ZIGBEE_UART_PARTIAL_RX_TIMEOUT),
-				K_NO_WAIT);
-		}
+		uart_rx_buf_update();
 	} else {
 		recv_len = uart_fifo_read(dev, buffer, sizeof(buffer));
 		uart_rx_bytes(buffer, recv_len);
 
 		/* Store remaining bytes inside the ring buffer. */
-		if (recv_len > ring_buf_space_get(&rx_ringbuf)) {
-			uint8_t dummy_buffer[CONFIG_ZIGBEE_UART_RX_BUF_LEN];
-
-			(void)ring_buf_get(&rx_ringbuf, dummy_buffer,
-				recv_len - ring_buf_space_get(&rx_ringbuf));
-		}
-
-		(void)ring_buf_put(&rx_ringbuf, buffer, recv_len);
+		uart_rx_store(buffer, recv_len);
 	}
 }
 
@@ -171,19 +301,7 @@ static void handle_tx_ready_evt(const struct device *dev)
 		uart_tx_buf_len - uart_tx_buf_offset);
 
 	if (uart_tx_buf_len == uart_tx_buf_offset) {
-		uart_tx_buf_offset = 0;
-		uart_tx_buf_len = 0;
-		uart_tx_buf = uart_tx_buf_bak;
-
-		k_timer_stop(&uart_tx_timer);
-		k_sem_give(&tx_done_sem);
-
-		if (tx_trx_data_cb) {
-			zigbee_schedule_callback(
-				tx_trx_data_cb,
-				SERIAL_SEND_SUCCESS);
-			tx_trx_data_cb = NULL;
-		}
+		uart_tx_finish(SERIAL_SEND_SUCCESS);
 	} else {
 		k_timer_start(
 			&uart_tx_timer,
@@ -204,6 +322,7 @@ static void interrupt_handler(const struct device *dev, void *user_data)
 		}
 	}
 }
+#endif /* CONFIG_ZIGBEE_UART_ASYNC_API */
 
 void zb_osif_async_serial_init(void)
 {
@@ -239,10 +358,16 @@ void zb_osif_async_serial_init(void)
 	}
 
 	ring_buf_init(&rx_ringbuf, sizeof(uart_rx_buf_mem), uart_rx_buf_mem);
+
+#if CONFIG_ZIGBEE_UART_ASYNC_API
+	(void)uart_callback_set(uart_dev, uart_evt_handler, NULL);
+	uart_rx_start(uart_dev);
+#else
 	uart_irq_callback_set(uart_dev, interrupt_handler);
 
 	/* Enable rx interrupts. */
 	uart_irq_rx_enable(uart_dev);
+#endif /* CONFIG_ZIGBEE_UART_ASYNC_API */
 }
 
 void zb_osif_async_serial_sleep(void)
@@ -252,8 +377,13 @@ void zb_osif_async_serial_sleep(void)
 	}
 
 	is_sleeping = true;
+#if CONFIG_ZIGBEE_UART_ASYNC_API
+	(void)uart_tx_abort(uart_dev);
+	(void)uart_rx_disable(uart_dev);
+#else
 	uart_irq_tx_disable(uart_dev);
 	uart_irq_rx_disable(uart_dev);
+#endif /* CONFIG_ZIGBEE_UART_ASYNC_API */
 }
 
 void zb_osif_async_serial_wake_up(void)
@@ -264,8 +394,12 @@ void zb_osif_async_serial_wake_up(void)
 
 	is_sleeping = false;
 
+#if CONFIG_ZIGBEE_UART_ASYNC_API
+	uart_rx_start(uart_dev);
+#else
 	/* Enable rx interrupts. */
 	uart_irq_rx_enable(uart_dev);
+#endif /* CONFIG_ZIGBEE_UART_ASYNC_API */
 }
 
 void zb_osif_serial_recv_data(zb_uint8_t *buf, zb_ushort_t len)
@@ -290,6 +424,28 @@ void zb_osif_serial_recv_data(zb_uint8_t *buf, zb_ushort_t len)
 		return;
 	}
 
+#if CONFIG_ZIGBEE_UART_ASYNC_API
+	/*
+	 * Flush already received data.
+	 * The buffer is passed under the lock, so the data received in the
+	 * meantime goes to the user's buffer, not to the ring buffer.
+	 */
+	k_spinlock_key_t key = k_spin_lock(&rx_lock);
+
+	uart_rx_buf_offset = ring_buf_get(&rx_ringbuf, buf, len);
+	if (uart_rx_buf_offset < len) {
+		uart_rx_buf_len = len;
+		uart_rx_buf = buf;
+	}
+
+	k_spin_unlock(&rx_lock, key);
+
+	if (uart_rx_buf_offset == len) {
+		uart_rx_buf_offset = 0;
+		k_sem_give(&rx_done_sem);
+		rx_data_cb(buf, len);
+	}
+#else
 	/*
 	 * Flush already received data.
 	 * Disable interrupt to block buffer reads from the interrupt handler.
@@ -311,6 +467,7 @@ void zb_osif_serial_recv_data(zb_uint8_t *buf, zb_ushort_t len)
 	 */
 	uart_rx_buf_len = len;
 	uart_rx_buf = buf;
+#endif /* CONFIG_ZIGBEE_UART_ASYNC_API */
 }
 
 void zb_osif_serial_set_cb_recv_data(serial_recv_data_cb_t cb)
@@ -343,8 +500,7 @@ void zb_osif_serial_send_data(zb_uint8_t *buf, zb_ushort_t len)
 	/* Pass the TX callback for a single (ongoing) tranmission. */
 	tx_trx_data_cb = tx_data_cb;
 
-	/* Enable TX ready event. */
-	uart_irq_tx_enable(uart_dev);
+	uart_tx_start();
 }
 
 void zb_osif_serial_set_cb_send_data(serial_send_data_cb_t cb)
@@ -397,8 +553,7 @@ void zb_osif_async_serial_put_bytes(const zb_uint8_t *buf, zb_short_t len)
 	uart_tx_buf_len = len;
 	uart_tx_buf_offset = 0;
 
-	/* Enable tx interrupts. */
-	uart_irq_tx_enable(uart_dev);
+	uart_tx_start();
 
 #endif /* !(ZB_HAVE_ASYNC_SERIAL && CONFIG_ZBOSS_TRACE_LOG_LEVEL_OFF) */
 }
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <zephyr.h>
+#include <string.h>
 #include <pm_config.h>
 #include <storage/flash_map.h>
 #include <logging/log.h>
@@ -33,6 +35,129 @@ static const struct flash_area *fa; /* ZBOSS nvram */
 static const struct flash_area *fa_pc; /* production config */
 #endif
 
+#if CONFIG_ZIGBEE_NVRAM_WRITE_CACHE_SIZE
+/* Consecutive writes are combined in RAM and written to flash in one
+ * operation. The cached data never spans two ZBOSS pages, as writes never
+ * reach the last byte of a page.
+ */
+static struct {
+	uint8_t data[CONFIG_ZIGBEE_NVRAM_WRITE_CACHE_SIZE] __aligned(4);
+	uint32_t addr;
+	size_t len;
+} cache;
+
+static K_MUTEX_DEFINE(cache_lock);
+
+static void cache_flush_work_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(cache_flush_work, cache_flush_work_fn);
+
+/* Must be called with the cache lock held. */
+static int cache_flush(void)
+{
+	int err = 0;
+
+	if (cache.len) {
+		err = flash_area_write(fa, cache.addr, cache.data, cache.len);
+		if (err) {
+			LOG_ERR("Write error: %d", err);
+		}
+
+		cache.len = 0;
+	}
+
+	return err;
+}
+
+static void cache_flush_work_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	(void)cache_flush();
+	k_mutex_unlock(&cache_lock);
+}
+
+static int cache_write(uint32_t addr, const void *buf, size_t len)
+{
+	int err = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (cache.len && ((addr != cache.addr + cache.len) ||
+			  (cache.len + len > sizeof(cache.data)))) {
+		err = cache_flush();
+	}
+
+	if (err) {
+		goto unlock;
+	}
+
+	if (len > sizeof(cache.data)) {
+		err = flash_area_write(fa, addr, buf, len);
+		if (err) {
+			LOG_ERR("Write error: %d", err);
+		}
+
+		goto unlock;
+	}
+
+	if (!cache.len) {
+		cache.addr = addr;
+		/* Does not move the deadline if the work is already scheduled,
+		 * so data is never kept longer than the timeout.
+		 */
+		(void)k_work_schedule(
+			&cache_flush_work,
+			K_MSEC(CONFIG_ZIGBEE_NVRAM_WRITE_CACHE_TIMEOUT));
+	}
+
+	memcpy(&cache.data[cache.len], buf, len);
+	cache.len += len;
+
+unlock:
+	k_mutex_unlock(&cache_lock);
+	return err;
+}
+
+static int cache_read(uint32_t addr, uint8_t *buf, size_t len)
+{
+	uint32_t start;
+	uint32_t end;
+	int err;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	err = flash_area_read(fa, addr, buf, len);
+	if (err) {
+		goto unlock;
+	}
+
+	/* Serve the part that has not been written to flash yet from RAM. */
+	start = MAX(addr, cache.addr);
+	end = MIN(addr + len, cache.addr + cache.len);
+	if (start < end) {
+		memcpy(&buf[start - addr], &cache.data[start - cache.addr],
+		       end - start);
+	}
+
+unlock:
+	k_mutex_unlock(&cache_lock);
+	return err;
+}
+
+static void cache_drop(uint32_t addr, size_t len)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (cache.len && (cache.addr >= addr) && (cache.addr < addr + len)) {
+		cache.len = 0;
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+#endif /* CONFIG_ZIGBEE_NVRAM_WRITE_CACHE_SIZE */
+
 void zb_osif_nvram_init(const zb_char_t *name)
 {
 	ARG_UNUSED(name);
@@ -89,7 +214,11 @@ zb_ret_t zb_osif_nvram_read(zb_uint8_t page, zb_uint32_t pos, zb_uint8_t *buf,
 
 	uint32_t flash_addr = get_page_base_offset(page) + pos;
 
+#if CONFIG_ZIGBEE_NVRAM_WRITE_CACHE_SIZE
+	int err = cache_read(flash_addr, buf, len);
+#else
 	int err = flash_area_read(fa, flash_addr, buf, len);
+#endif
 
 	if (err) {
 		LOG_ERR("Read error: %d", err);
@@ -126,10 +255,17 @@ zb_ret_t zb_osif_nvram_write(zb_uint8_t page, zb_uint32_t pos, void *buf,
 	LOG_DBG("Function: %s, page: %d, pos: %d, len: %d",
 		__func__, page, pos, len);
 
+#if CONFIG_ZIGBEE_NVRAM_WRITE_CACHE_SIZE
+	int err = cache_write(flash_addr, buf, len);
+#else
 	int err = flash_area_write(fa, flash_addr, buf, len);
 
 	if (err) {
 		LOG_ERR("Write error: %d", err);
+	}
+#endif
+
+	if (err) {
 		return RET_ERROR;
 	}
 
@@ -141,6 +277,10 @@ zb_ret_t zb_osif_nvram_erase_async(zb_uint8_t page)
 	zb_ret_t ret = RET_OK;
 
 	if (page < zb_get_nvram_page_count()) {
+#if CONFIG_ZIGBEE_NVRAM_WRITE_CACHE_SIZE
+		cache_drop(get_page_base_offset(page),
+			   zb_get_nvram_page_length());
+#endif
 		int err = flash_area_erase(fa, get_page_base_offset(page),
 					   zb_get_nvram_page_length());
 		if (err) {
@@ -159,7 +299,15 @@ void zb_osif_nvram_wait_for_last_op(void)
 
 void zb_osif_nvram_flush(void)
 {
+#if CONFIG_ZIGBEE_NVRAM_WRITE_CACHE_SIZE
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	(void)cache_flush();
+	k_mutex_unlock(&cache_lock);
+
+	(void)k_work_cancel_delayable(&cache_flush_work);
+#else
 	/* empty for synchronous erase and write */
+#endif
 }
 
 
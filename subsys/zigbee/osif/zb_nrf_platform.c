@@ -510,6 +510,11 @@ void zb_reset(zb_uint8_t param)
 	reas = (uint8_t)SYS_REBOOT_NCP;
 #endif /* CONFIG_ZIGBEE_LIBRARY_NCP_DEV */
 
+#if defined(ZB_USE_NVRAM) && CONFIG_ZIGBEE_NVRAM_WRITE_CACHE_SIZE
+	/* Do not lose the data kept in the NVRAM write cache. */
+	zb_osif_nvram_flush();
+#endif
+
 /* For nRF5340DK sys_reboot() does not set reset reason.
  * Do it manually in this case - NCP samples require this.
  */
@@ -459,9 +459,15 @@ zb_uint8_t zb_trans_get_next_packet(zb_bufid_t buf)
 	length = net_pkt_get_len(pkt);
 	data_ptr = zb_buf_initial_alloc(buf, length);
 
-	/* Copy received data */
-	net_pkt_cursor_init(pkt);
-	net_pkt_read(pkt, data_ptr, length);
+	/* Copy received data. A frame normally fits in a single fragment,
+	 * which is copied directly, without going through the packet cursor.
+	 */
+	if (pkt->buffer && !pkt->buffer->frags) {
+		memcpy(data_ptr, pkt->buffer->data, length);
+	} else {
+		net_pkt_cursor_init(pkt);
+		net_pkt_read(pkt, data_ptr, length);
+	}
 
 	/* Put LQI, RSSI */
 	zb_macll_metadata_t *metadata = ZB_MACLL_GET_METADATA(buf);
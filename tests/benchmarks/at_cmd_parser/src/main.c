@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <ztest.h>
+#include <zephyr.h>
+#include <string.h>
+
+#include <modem/at_cmd_parser.h>
+#include <modem/at_params.h>
+
+/* Number of times each message is parsed. */
+#define BENCH_REPS		100
+
+/* Enough for the neighbour cells of %NCELLMEAS. */
+#define BENCH_MAX_PARAMS	96
+
+/* Size of the buffer of the static parameter list. */
+#define BENCH_STATIC_BUF_SIZE	4096
+
+/* Captured modem responses and notifications. */
+static const struct {
+	const char *name;
+	const char *msg;
+} corpus[] = {
+	{
+		"xmonitor",
+		"%XMONITOR: 1,\"Operator\",\"Op\",\"24201\",\"0901\",7,20,\"02024720\","
+		"402,6400,53,24,\"\",\"11100000\",\"11100000\",\"01001001\"\r\n"
+	},
+	{
+		"cereg_psm",
+		"+CEREG: 5,\"0901\",\"02024720\",7,,,\"00000110\",\"00100001\"\r\n"
+	},
+	{
+		"ncellmeas",
+		"%NCELLMEAS: 0,\"021D140C\",\"24201\",\"0AB9\",64,5300,6400,194,61,16,"
+		"6400,195,60,14,5,6400,210,55,12,5,6400,212,52,10,5,"
+		"6400,301,49,9,5,6400,302,48,9,5,6400,410,45,7,5,"
+		"6400,411,44,6,5,1300,194,40,5,5,1300,195,39,4,5,"
+		"1300,210,37,3,5,1300,212,35,2,5,1300,301,33,1,5,"
+		"1300,302,31,0,5,1300,410,30,0,5,1300,411,28,-1,5,"
+		"5290\r\n"
+	},
+	{
+		"cmgl",
+		"+CMGL: 0,1,,24\r\n"
+		"07919730071111F1040B919730718260F70000120121815233400AC8329BFD06DDDF723619\r\n"
+		"+CMGL: 1,1,,24\r\n"
+		"07919730071111F1040B919730718260F70000120121815233400AC8329BFD06DDDF723619\r\n"
+		"+CMGL: 2,1,,24\r\n"
+		"07919730071111F1040B919730718260F70000120121815233400AC8329BFD06DDDF723619\r\n"
+		"+CMGL: 3,1,,24\r\n"
+		"07919730071111F1040B919730718260F70000120121815233400AC8329BFD06DDDF723619\r\n"
+	},
+};
+
+enum bench_mode {
+	BENCH_MODE_HEAP,
+	BENCH_MODE_STRING_VIEW,
+	BENCH_MODE_STATIC,
+};
+
+static const char * const bench_mode_name[] = {
+	[BENCH_MODE_HEAP] = "heap",
+	[BENCH_MODE_STRING_VIEW] = "string_view",
+	[BENCH_MODE_STATIC] = "static",
+};
+
+static struct at_param_list list;
+static uint8_t static_buf[BENCH_STATIC_BUF_SIZE];
+static uint32_t alloc_cnt;
+
+/* The parser calls k_malloc() through this wrapper, see CMakeLists.txt. */
+void *__real_k_malloc(size_t size);
+
+void *__wrap_k_malloc(size_t size)
+{
+	alloc_cnt++;
+
+	return __real_k_malloc(size);
+}
+
+/* Print a result in a machine-readable format:
+ * BENCH;<benchmark>;<parameter>=<value>;<metric>=<value>
+ */
+static void result_print(const char *bench, const char *param, const char *param_val,
+			 const char *metric, uint32_t val)
+{
+	printk("BENCH;%s;%s=%s;%s=%u\n", bench, param, param_val, metric, val);
+}
+
+static void list_init(enum bench_mode mode)
+{
+	int err;
+
+	switch (mode) {
+	case BENCH_MODE_HEAP:
+	case BENCH_MODE_STRING_VIEW:
+		err = at_params_list_init(&list, BENCH_MAX_PARAMS);
+		zassert_ok(err, "Cannot initialize list");
+		err = at_params_list_string_view_set(&list,
+						     mode == BENCH_MODE_STRING_VIEW);
+		zassert_ok(err, "Cannot set string view");
+		break;
+	case BENCH_MODE_STATIC:
+		err = at_params_list_init_static(&list, BENCH_MAX_PARAMS,
+						 static_buf, sizeof(static_buf));
+		zassert_ok(err, "Cannot initialize static list");
+		break;
+	default:
+		zassert_unreachable("Unknown mode");
+		break;
+	}
+}
+
+/* Read all parameters, the way an application would. */
+static void params_read(void)
+{
+	char str[96];
+	int64_t num;
+	size_t len;
+	int err;
+
+	for (size_t i = 0; i < at_params_valid_count_get(&list); i++) {
+		switch (at_params_type_get(&list, i)) {
+		case AT_PARAM_TYPE_NUM_INT:
+			err = at_params_int64_get(&list, i, &num);
+			zassert_ok(err, "Cannot get number");
+			break;
+		case AT_PARAM_TYPE_STRING:
+			len = sizeof(str);
+			err = at_params_string_get(&list, i, str, &len);
+			zassert_ok(err, "Cannot get string");
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/* Parse all notifications of a message and read their parameters. */
+static void msg_parse(const char *msg)
+{
+	const char *str = msg;
+	char *next;
+	int err;
+
+	do {
+		err = at_parser_max_params_from_str(str, &next, &list, BENCH_MAX_PARAMS);
+		zassert_true(err == 0 || err == -EAGAIN, "Parsing failed: %d", err);
+
+		params_read();
+		str = next;
+	} while (err == -EAGAIN);
+}
+
+static void bench_mode_run(enum bench_mode mode)
+{
+	list_init(mode);
+
+	for (size_t i = 0; i < ARRAY_SIZE(corpus); i++) {
+		uint32_t start;
+		uint32_t cycles;
+
+		/* Warm up, so that the first run is not measured. */
+		msg_parse(corpus[i].msg);
+
+		alloc_cnt = 0;
+		start = k_cycle_get_32();
+
+		for (size_t j = 0; j < BENCH_REPS; j++) {
+			msg_parse(corpus[i].msg);
+		}
+
+		cycles = k_cycle_get_32() - start;
+
+		result_print(corpus[i].name, "mode", bench_mode_name[mode], "ns_per_msg",
+			     (uint32_t)(k_cyc_to_ns_floor64(cycles) / BENCH_REPS));
+		result_print(corpus[i].name, "mode", bench_mode_name[mode], "allocs_per_msg",
+			     alloc_cnt / BENCH_REPS);
+	}
+
+	at_params_list_free(&list);
+}
+
+static void test_heap(void)
+{
+	bench_mode_run(BENCH_MODE_HEAP);
+}
+
+static void test_string_view(void)
+{
+	bench_mode_run(BENCH_MODE_STRING_VIEW);
+}
+
+static void test_static(void)
+{
+	bench_mode_run(BENCH_MODE_STATIC);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(at_cmd_parser_benchmark,
+			 ztest_unit_test(test_heap),
+			 ztest_unit_test(test_string_view),
+			 ztest_unit_test(test_static)
+			 );
+
+	ztest_run_test_suite(at_cmd_parser_benchmark);
+}
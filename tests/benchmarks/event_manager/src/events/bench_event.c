@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "bench_event.h"
+
+
+EVENT_TYPE_DEFINE(bench_event,
+		  false,
+		  NULL,
+		  NULL);
+
+EVENT_TYPE_DEFINE(bench_fanout4_event,
+		  false,
+		  NULL,
+		  NULL);
+
+EVENT_TYPE_DEFINE(bench_fanout8_event,
+		  false,
+		  NULL,
+		  NULL);
+
+EVENT_TYPE_MEM_SLAB_DEFINE(bench_slab_event,
+			   false,
+			   NULL,
+			   NULL,
+			   BENCH_SLAB_EVENT_CNT);
+
+EVENT_TYPE_DEFINE(bench_heap_event,
+		  false,
+		  NULL,
+		  NULL);
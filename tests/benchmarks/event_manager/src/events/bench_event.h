@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _BENCH_EVENT_H_
+#define _BENCH_EVENT_H_
+
+/**
+ * @brief Benchmark Events
+ * @defgroup bench_event Benchmark Events
+ * @{
+ */
+
+#include "event_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of slab events that can be allocated at the same time. */
+#define BENCH_SLAB_EVENT_CNT 16
+
+/* Event with a payload of variable size, handled by one listener. */
+struct bench_event {
+	struct event_header header;
+
+	uint32_t timestamp;
+	struct event_dyndata dyndata;
+};
+
+EVENT_TYPE_DYNDATA_DECLARE(bench_event);
+
+/* Events handled by 4 and 8 listeners. */
+struct bench_fanout4_event {
+	struct event_header header;
+
+	uint32_t timestamp;
+};
+
+EVENT_TYPE_DECLARE(bench_fanout4_event);
+
+struct bench_fanout8_event {
+	struct event_header header;
+
+	uint32_t timestamp;
+};
+
+EVENT_TYPE_DECLARE(bench_fanout8_event);
+
+/* Event allocated from a memory slab, handled by one listener. */
+struct bench_slab_event {
+	struct event_header header;
+
+	uint32_t timestamp;
+};
+
+EVENT_TYPE_DECLARE(bench_slab_event);
+
+/* Event allocated from the heap, handled by one listener. */
+struct bench_heap_event {
+	struct event_header header;
+
+	uint32_t timestamp;
+};
+
+EVENT_TYPE_DECLARE(bench_heap_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _BENCH_EVENT_H_ */
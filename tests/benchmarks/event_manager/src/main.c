@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <ztest.h>
+#include <event_manager.h>
+
+#include "bench_event.h"
+
+/* Number of events used to measure the submit-to-dispatch latency. */
+#define BENCH_LATENCY_CNT	128
+
+/* Number of events used to measure the throughput and allocation cost. */
+#define BENCH_EVENT_CNT		1024
+
+/* Maximum number of events in flight. */
+#define BENCH_BURST_CNT		BENCH_SLAB_EVENT_CNT
+
+/* Number of events submitted from the timer interrupt. */
+#define BENCH_ISR_CNT		64
+
+enum bench_type {
+	BENCH_TYPE_DYNDATA,
+	BENCH_TYPE_HEAP,
+	BENCH_TYPE_SLAB,
+	BENCH_TYPE_FANOUT4,
+	BENCH_TYPE_FANOUT8,
+};
+
+static const char * const bench_type_name[] = {
+	[BENCH_TYPE_DYNDATA] = "dyndata",
+	[BENCH_TYPE_HEAP] = "heap",
+	[BENCH_TYPE_SLAB] = "slab",
+	[BENCH_TYPE_FANOUT4] = "fanout4",
+	[BENCH_TYPE_FANOUT8] = "fanout8",
+};
+
+/* Cost of a submission, in cycles. */
+struct bench_cost {
+	uint32_t alloc;
+	uint32_t submit;
+};
+
+static atomic_t processed_cnt;
+static atomic_t expected_cnt;
+static uint64_t latency_sum;
+static uint32_t latency_max;
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+/* Cost of the submissions from the timer interrupt. */
+static struct bench_cost isr_cost;
+static atomic_t isr_cnt;
+
+/* Out of memory in the Event Manager fails the benchmark. */
+void sys_reboot(int type)
+{
+	zassert_unreachable("Event Manager out of memory");
+}
+
+/* Print a result in a machine-readable format:
+ * BENCH;<benchmark>;<parameter>=<value>;<metric>=<value>
+ */
+static void result_print(const char *bench, const char *param, uint32_t param_val,
+			 const char *metric, uint32_t val)
+{
+	printk("BENCH;%s;%s=%u;%s=%u\n", bench, param, param_val, metric, val);
+}
+
+static uint32_t cyc_to_ns(uint64_t cycles)
+{
+	return (uint32_t)k_cyc_to_ns_floor64(cycles);
+}
+
+static void counters_reset(void)
+{
+	atomic_set(&processed_cnt, 0);
+	atomic_set(&expected_cnt, 0);
+	latency_sum = 0;
+	latency_max = 0;
+	k_sem_reset(&done_sem);
+}
+
+static void bench_event_submit(enum bench_type type, size_t payload,
+			       struct bench_cost *cost)
+{
+	struct event_header *eh;
+	uint32_t *timestamp;
+	uint32_t start = k_cycle_get_32();
+	uint32_t alloc_end;
+
+	switch (type) {
+	case BENCH_TYPE_DYNDATA: {
+		struct bench_event *event = new_bench_event(payload);
+
+		eh = &event->header;
+		timestamp = &event->timestamp;
+		break;
+	}
+	case BENCH_TYPE_HEAP: {
+		struct bench_heap_event *event = new_bench_heap_event();
+
+		eh = &event->header;
+		timestamp = &event->timestamp;
+		break;
+	}
+	case BENCH_TYPE_SLAB: {
+		struct bench_slab_event *event = new_bench_slab_event();
+
+		eh = &event->header;
+		timestamp = &event->timestamp;
+		break;
+	}
+	case BENCH_TYPE_FANOUT4: {
+		struct bench_fanout4_event *event = new_bench_fanout4_event();
+
+		eh = &event->header;
+		timestamp = &event->timestamp;
+		break;
+	}
+	case BENCH_TYPE_FANOUT8: {
+		struct bench_fanout8_event *event = new_bench_fanout8_event();
+
+		eh = &event->header;
+		timestamp = &event->timestamp;
+		break;
+	}
+	default:
+		zassert_unreachable("Unknown event type");
+		return;
+	}
+
+	alloc_end = k_cycle_get_32();
+	*timestamp = alloc_end;
+	_event_submit(eh);
+
+	if (cost) {
+		cost->alloc += alloc_end - start;
+		cost->submit += k_cycle_get_32() - alloc_end;
+	}
+}
+
+/* Submit events in bursts and wait until all of them are processed.
+ * Returns the time of the run, in cycles.
+ */
+static uint32_t bench_run(enum bench_type type, size_t payload, size_t cnt,
+			  struct bench_cost *cost)
+{
+	uint32_t start;
+	int err;
+
+	counters_reset();
+	start = k_cycle_get_32();
+
+	for (size_t i = 0; i < cnt; i += BENCH_BURST_CNT) {
+		size_t burst = MIN(BENCH_BURST_CNT, cnt - i);
+
+		atomic_set(&expected_cnt, i + burst);
+
+		for (size_t j = 0; j < burst; j++) {
+			bench_event_submit(type, payload, cost);
+		}
+
+		err = k_sem_take(&done_sem, K_SECONDS(10));
+		zassert_equal(err, 0, "Events not processed");
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static void test_init(void)
+{
+	zassert_false(event_manager_init(), "Error when initializing");
+}
+
+static void test_latency(void)
+{
+	static const enum bench_type types[] = {
+		BENCH_TYPE_HEAP,
+		BENCH_TYPE_SLAB,
+		BENCH_TYPE_FANOUT8,
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(types); i++) {
+		uint64_t sum = 0;
+		uint32_t max = 0;
+
+		/* One event in flight, so that only the dispatch is measured. */
+		for (size_t j = 0; j < BENCH_LATENCY_CNT; j++) {
+			bench_run(types[i], 0, 1, NULL);
+			sum += latency_sum;
+			max = MAX(max, latency_max);
+		}
+
+		result_print("latency", bench_type_name[types[i]], 0, "avg_ns",
+			     cyc_to_ns(sum / BENCH_LATENCY_CNT));
+		result_print("latency", bench_type_name[types[i]], 0, "max_ns",
+			     cyc_to_ns(max));
+	}
+}
+
+static void throughput_print(const char *param, uint32_t param_val, uint32_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	zassert_true(ns > 0, "Run too short to be measured");
+
+	result_print("throughput", param, param_val, "events_per_s",
+		     (uint32_t)((uint64_t)BENCH_EVENT_CNT * NSEC_PER_SEC / ns));
+}
+
+static void test_throughput_payload(void)
+{
+	static const size_t payloads[] = {0, 16, 64, 256};
+
+	for (size_t i = 0; i < ARRAY_SIZE(payloads); i++) {
+		uint32_t cycles = bench_run(BENCH_TYPE_DYNDATA, payloads[i],
+					    BENCH_EVENT_CNT, NULL);
+
+		throughput_print("payload", payloads[i], cycles);
+	}
+}
+
+static void test_throughput_subscribers(void)
+{
+	static const struct {
+		enum bench_type type;
+		uint32_t subs;
+	} runs[] = {
+		{ BENCH_TYPE_HEAP, 1 },
+		{ BENCH_TYPE_FANOUT4, 4 },
+		{ BENCH_TYPE_FANOUT8, 8 },
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(runs); i++) {
+		uint32_t cycles = bench_run(runs[i].type, 0, BENCH_EVENT_CNT, NULL);
+
+		throughput_print("subscribers", runs[i].subs, cycles);
+	}
+}
+
+static void test_alloc(void)
+{
+	static const enum bench_type types[] = {
+		BENCH_TYPE_HEAP,
+		BENCH_TYPE_SLAB,
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(types); i++) {
+		struct bench_cost cost = {0};
+
+		bench_run(types[i], 0, BENCH_EVENT_CNT, &cost);
+
+		result_print("alloc", bench_type_name[types[i]], 0, "avg_ns",
+			     cyc_to_ns(cost.alloc / BENCH_EVENT_CNT));
+		result_print("submit", bench_type_name[types[i]], 0, "avg_ns",
+			     cyc_to_ns(cost.submit / BENCH_EVENT_CNT));
+	}
+}
+
+static void isr_timer_handler(struct k_timer *timer)
+{
+	bench_event_submit(BENCH_TYPE_SLAB, 0, &isr_cost);
+
+	if (atomic_inc(&isr_cnt) + 1 == BENCH_ISR_CNT) {
+		k_timer_stop(timer);
+	}
+}
+
+static K_TIMER_DEFINE(isr_timer, isr_timer_handler, NULL);
+
+static void test_isr_submit(void)
+{
+	struct bench_cost thread_cost = {0};
+	int err;
+
+	bench_run(BENCH_TYPE_SLAB, 0, BENCH_ISR_CNT, &thread_cost);
+
+	counters_reset();
+	memset(&isr_cost, 0, sizeof(isr_cost));
+	atomic_set(&isr_cnt, 0);
+	atomic_set(&expected_cnt, BENCH_ISR_CNT);
+
+	/* Events are processed between the interrupts, so the slab is never
+	 * exhausted.
+	 */
+	k_timer_start(&isr_timer, K_MSEC(1), K_MSEC(1));
+
+	err = k_sem_take(&done_sem, K_SECONDS(10));
+	zassert_equal(err, 0, "Events not processed");
+
+	result_print("submit_thread", bench_type_name[BENCH_TYPE_SLAB], 0, "avg_ns",
+		     cyc_to_ns((thread_cost.alloc + thread_cost.submit) / BENCH_ISR_CNT));
+	result_print("submit_isr", bench_type_name[BENCH_TYPE_SLAB], 0, "avg_ns",
+		     cyc_to_ns((isr_cost.alloc + isr_cost.submit) / BENCH_ISR_CNT));
+}
+
+void test_main(void)
+{
+	ztest_test_suite(event_manager_benchmark,
+			 ztest_unit_test(test_init),
+			 ztest_unit_test(test_latency),
+			 ztest_unit_test(test_throughput_payload),
+			 ztest_unit_test(test_throughput_subscribers),
+			 ztest_unit_test(test_alloc),
+			 ztest_unit_test(test_isr_submit)
+			 );
+
+	ztest_run_test_suite(event_manager_benchmark);
+}
+
+static bool event_handler(const struct event_header *eh)
+{
+	uint32_t now = k_cycle_get_32();
+	uint32_t timestamp;
+	uint32_t latency;
+
+	if (is_bench_event(eh)) {
+		timestamp = cast_bench_event(eh)->timestamp;
+	} else if (is_bench_heap_event(eh)) {
+		timestamp = cast_bench_heap_event(eh)->timestamp;
+	} else if (is_bench_slab_event(eh)) {
+		timestamp = cast_bench_slab_event(eh)->timestamp;
+	} else if (is_bench_fanout4_event(eh)) {
+		timestamp = cast_bench_fanout4_event(eh)->timestamp;
+	} else if (is_bench_fanout8_event(eh)) {
+		timestamp = cast_bench_fanout8_event(eh)->timestamp;
+	} else {
+		zassert_true(false, "Wrong event type received");
+		return false;
+	}
+
+	latency = now - timestamp;
+	latency_sum += latency;
+	latency_max = MAX(latency_max, latency);
+
+	if (atomic_inc(&processed_cnt) + 1 == atomic_get(&expected_cnt)) {
+		k_sem_give(&done_sem);
+	}
+
+	return false;
+}
+
+EVENT_LISTENER(bench_sink, event_handler);
+EVENT_SUBSCRIBE(bench_sink, bench_event);
+EVENT_SUBSCRIBE(bench_sink, bench_heap_event);
+EVENT_SUBSCRIBE(bench_sink, bench_slab_event);
+/* Fan-out events are processed by all other listeners first. */
+EVENT_SUBSCRIBE_FINAL(bench_sink, bench_fanout4_event);
+EVENT_SUBSCRIBE_FINAL(bench_sink, bench_fanout8_event);
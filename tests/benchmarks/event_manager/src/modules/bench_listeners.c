@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr.h>
+
+#include <bench_event.h>
+
+/* Listeners that only add subscribers to the fan-out events.
+ * The benchmark sink in main.c is subscribed as the final one.
+ */
+static atomic_t notify_cnt;
+
+static bool event_handler(const struct event_header *eh)
+{
+	atomic_inc(&notify_cnt);
+
+	return false;
+}
+
+#define BENCH_LISTENER(idx) \
+	EVENT_LISTENER(_CONCAT(bench_listener_, idx), event_handler)
+
+#define BENCH_SUBSCRIBE(idx, ename) \
+	EVENT_SUBSCRIBE(_CONCAT(bench_listener_, idx), ename)
+
+BENCH_LISTENER(1);
+BENCH_SUBSCRIBE(1, bench_fanout4_event);
+BENCH_SUBSCRIBE(1, bench_fanout8_event);
+
+BENCH_LISTENER(2);
+BENCH_SUBSCRIBE(2, bench_fanout4_event);
+BENCH_SUBSCRIBE(2, bench_fanout8_event);
+
+BENCH_LISTENER(3);
+BENCH_SUBSCRIBE(3, bench_fanout4_event);
+BENCH_SUBSCRIBE(3, bench_fanout8_event);
+
+BENCH_LISTENER(4);
+BENCH_SUBSCRIBE(4, bench_fanout8_event);
+
+BENCH_LISTENER(5);
+BENCH_SUBSCRIBE(5, bench_fanout8_event);
+
+BENCH_LISTENER(6);
+BENCH_SUBSCRIBE(6, bench_fanout8_event);
+
+BENCH_LISTENER(7);
+BENCH_SUBSCRIBE(7, bench_fanout8_event);
@@ -242,6 +242,120 @@ static void test_params_put_get_string_teardown(void)
 	at_params_list_free(&test_list);
 }
 
+static void test_params_string_view_setup(void)
+{
+	at_params_list_init(&test_list, TEST_PARAMS);
+}
+
+static void test_params_string_view(void)
+{
+	char test_str[] = "Test, 1, 2, 3";
+	const char *str_ptr;
+	size_t str_len;
+
+	zassert_equal(-EINVAL, at_params_list_string_view_set(NULL, true),
+		      "String view set should return -EINVAL");
+
+	zassert_equal(0, at_params_list_string_view_set(&test_list, true),
+		      "String view set should return 0");
+
+	zassert_equal(0, at_params_string_put(&test_list, 1,
+					      test_str, sizeof(test_str)),
+		      "String put should return 0");
+
+	zassert_equal(-EINVAL, at_params_string_ptr_get(&test_list, 1,
+							NULL, &str_len),
+		      "String pointer get should return -EINVAL");
+
+	zassert_equal(-EINVAL, at_params_string_ptr_get(&test_list, 0,
+							&str_ptr, &str_len),
+		      "String pointer get should return -EINVAL");
+
+	zassert_equal(0, at_params_string_ptr_get(&test_list, 1,
+						  &str_ptr, &str_len),
+		      "String pointer get should return 0");
+
+	zassert_equal_ptr(test_str, str_ptr,
+			  "String should not be copied in view mode");
+	zassert_equal(sizeof(test_str), str_len,
+		      "str_len should be equal to sizeof(test_str)");
+
+	zassert_equal(0, at_params_list_string_view_set(&test_list, false),
+		      "String view set should return 0");
+	zassert_equal(AT_PARAM_TYPE_INVALID,
+		      at_params_type_get(&test_list, 1),
+		      "List should be cleared when view mode changes");
+
+	zassert_equal(0, at_params_string_put(&test_list, 1,
+					      test_str, sizeof(test_str)),
+		      "String put should return 0");
+	zassert_equal(0, at_params_string_ptr_get(&test_list, 1,
+						  &str_ptr, &str_len),
+		      "String pointer get should return 0");
+	zassert_not_equal(test_str, str_ptr,
+			  "String should be copied outside view mode");
+	zassert_equal(0, memcmp(test_str, str_ptr, sizeof(test_str)),
+		      "test_str and str_ptr should be equal");
+}
+
+static void test_params_string_view_teardown(void)
+{
+	at_params_list_free(&test_list);
+}
+
+static void test_params_list_static(void)
+{
+	struct at_param_list static_list;
+	uint8_t arena[AT_PARAMS_ARENA_SIZE(TEST_PARAMS, 12)];
+	const char test_str[] = "0123456789";
+	char test_buf[16];
+	size_t test_buf_len = sizeof(test_buf);
+
+	zassert_equal(-EINVAL, at_params_list_init_static(NULL, TEST_PARAMS,
+						arena, sizeof(arena)),
+		      "Static init should return -EINVAL");
+
+	zassert_equal(-ENOMEM, at_params_list_init_static(&static_list,
+						TEST_PARAMS, arena, 1),
+		      "Static init should return -ENOMEM");
+
+	zassert_equal(0, at_params_list_init_static(&static_list, TEST_PARAMS,
+						    arena, sizeof(arena)),
+		      "Static init should return 0");
+
+	zassert_equal(TEST_PARAMS, static_list.param_count,
+		      "Params count should be the same as TEST_PARAMS");
+
+	zassert_equal(0, at_params_string_put(&static_list, 0,
+					      test_str, sizeof(test_str)),
+		      "String put should return 0");
+
+	zassert_equal(-ENOMEM, at_params_string_put(&static_list, 1,
+						    test_str, sizeof(test_str)),
+		      "String put should return -ENOMEM when arena is full");
+
+	zassert_equal(0, at_params_string_get(&static_list, 0,
+					      test_buf, &test_buf_len),
+		      "String get should return 0");
+
+	zassert_equal(0, memcmp(test_str, test_buf, sizeof(test_str)),
+		      "test_str and test_buf should be equal");
+
+	at_params_list_clear(&static_list);
+
+	zassert_equal(AT_PARAM_TYPE_INVALID,
+		      at_params_type_get(&static_list, 0),
+		      "Parameter should be cleared");
+
+	zassert_equal(0, at_params_string_put(&static_list, 1,
+					      test_str, sizeof(test_str)),
+		      "String put should return 0 after clearing the list");
+
+	at_params_list_free(&static_list);
+
+	zassert_is_null(static_list.params, "List should be freed");
+}
+
 static void test_params_put_get_array_setup(void)
 {
 	at_params_list_init(&test_list, TEST_PARAMS);
@@ -509,6 +623,7 @@ void test_main(void)
 {
 	ztest_test_suite(at_params,
 			 ztest_unit_test(test_init_free_params_list),
+			 ztest_unit_test(test_params_list_static),
 			 ztest_unit_test_setup_teardown(
 					test_params_put_get_int,
 					test_params_put_get_int_setup,
@@ -517,6 +632,10 @@ void test_main(void)
 					test_params_put_get_string,
 					test_params_put_get_string_setup,
 					test_params_put_get_string_teardown),
+			 ztest_unit_test_setup_teardown(
+					test_params_string_view,
+					test_params_string_view_setup,
+					test_params_string_view_teardown),
 			 ztest_unit_test_setup_teardown(
 					test_params_put_get_array,
 					test_params_put_get_array_setup,
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <ztest.h>
+#include <math.h>
+#include <wave_gen.h>
+
+#ifndef M_PI
+  #define M_PI 3.14159265358979323846
+#endif
+
+#define PERIOD_MS	1000
+#define AMPLITUDE	2.0
+#define OFFSET		0.5
+/* Maximum error of the lookup table with linear interpolation. */
+#define MAX_ERROR	(0.0001 * AMPLITUDE)
+
+static const struct wave_gen_param sine_param = {
+	.type = WAVE_GEN_TYPE_SINE,
+	.period_ms = PERIOD_MS,
+	.offset = OFFSET,
+	.amplitude = AMPLITUDE,
+	.noise = 0.0,
+};
+
+static double sine_ref(uint32_t time)
+{
+	return OFFSET + AMPLITUDE * sin(2 * M_PI * (time % PERIOD_MS) / PERIOD_MS);
+}
+
+static void test_wave_gen_sine_value(void)
+{
+	for (uint32_t time = 0; time < 2 * PERIOD_MS; time++) {
+		double val;
+		int err = wave_gen_generate_value(time, &sine_param, &val);
+
+		zassert_equal(err, 0, "Unexpected error: %d", err);
+		zassert_within(val, sine_ref(time), MAX_ERROR,
+			       "Wrong value for time %u", time);
+	}
+}
+
+static void test_wave_gen_triangle_square_value(void)
+{
+	struct wave_gen_param param = sine_param;
+	double val;
+
+	param.type = WAVE_GEN_TYPE_TRIANGLE;
+	zassert_equal(wave_gen_generate_value(0, &param, &val), 0, NULL);
+	zassert_within(val, OFFSET - AMPLITUDE, MAX_ERROR, NULL);
+	zassert_equal(wave_gen_generate_value(PERIOD_MS / 4, &param, &val), 0, NULL);
+	zassert_within(val, OFFSET, MAX_ERROR, NULL);
+	zassert_equal(wave_gen_generate_value(PERIOD_MS / 2, &param, &val), 0, NULL);
+	zassert_within(val, OFFSET + AMPLITUDE, MAX_ERROR, NULL);
+
+	param.type = WAVE_GEN_TYPE_SQUARE;
+	zassert_equal(wave_gen_generate_value(PERIOD_MS / 4, &param, &val), 0, NULL);
+	zassert_within(val, OFFSET - AMPLITUDE, MAX_ERROR, NULL);
+	zassert_equal(wave_gen_generate_value(3 * PERIOD_MS / 4, &param, &val), 0, NULL);
+	zassert_within(val, OFFSET + AMPLITUDE, MAX_ERROR, NULL);
+}
+
+static void test_wave_gen_block(void)
+{
+	/* One value every 2 ms over four periods. */
+	static float vals[2 * PERIOD_MS];
+	const uint32_t step_us = 2 * USEC_PER_MSEC;
+	int err = wave_gen_generate_values(0, step_us, &sine_param, vals, ARRAY_SIZE(vals));
+
+	zassert_equal(err, 0, "Unexpected error: %d", err);
+
+	for (size_t i = 0; i < ARRAY_SIZE(vals); i++) {
+		double time = (double)i * step_us / USEC_PER_MSEC;
+		double ref = OFFSET + AMPLITUDE * sin(2 * M_PI * time / PERIOD_MS);
+
+		zassert_within(vals[i], ref, MAX_ERROR, "Wrong value %zu", i);
+	}
+}
+
+static void test_wave_gen_invalid_param(void)
+{
+	struct wave_gen_param param = sine_param;
+	double val;
+	float block_val;
+
+	param.period_ms = 0;
+	zassert_equal(wave_gen_generate_value(0, &param, &val), -EINVAL, NULL);
+	zassert_equal(wave_gen_generate_values(0, 1, &param, &block_val, 1), -EINVAL, NULL);
+
+	param.type = WAVE_GEN_TYPE_NONE;
+	zassert_equal(wave_gen_generate_value(0, &param, &val), 0, NULL);
+	zassert_within(val, OFFSET, MAX_ERROR, NULL);
+	zassert_equal(wave_gen_generate_values(0, 1, &param, &block_val, 1), 0, NULL);
+	zassert_within(block_val, OFFSET, MAX_ERROR, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(wave_gen_test,
+			 ztest_unit_test(test_wave_gen_sine_value),
+			 ztest_unit_test(test_wave_gen_triangle_square_value),
+			 ztest_unit_test(test_wave_gen_block),
+			 ztest_unit_test(test_wave_gen_invalid_param)
+			 );
+
+	ztest_run_test_suite(wave_gen_test);
+}
@@ -376,6 +376,68 @@ void test_gatt_generic_serv(void)
 	/* No cleanup here - cleanup is done in run_dm_next */
 }
 
+void test_gatt_multi_serv(void)
+{
+	static const struct bt_uuid *const svc_uuids[] = {
+		BT_UUID_BAS,
+		BT_UUID_DIS,
+		BT_UUID_HIDS,
+	};
+	struct bt_gatt_dm *dm;
+	const struct bt_gatt_dm_attr *attr_serv;
+	const struct bt_gatt_dm_attr *attr_chrc;
+	const struct bt_gatt_service_val *serv_val;
+	int err;
+
+	err = bt_gatt_dm_start_multi((struct bt_conn *)&dummy_conn,
+				     svc_uuids, ARRAY_SIZE(svc_uuids),
+				     &test_hids_cb, &dm);
+	zassert_false(err, "bt_gatt_dm_start_multi finished with error: %d", err);
+
+	err = k_sem_take(&discovery_finished, K_MSEC(SERVICE_DISCOVERY_TIMEOUT));
+	zassert_equal(0, err, "It seems that no callback function was called: %d", err);
+	zassert_not_null(dm, "Device Manager pointer not set");
+
+	zassert_equal(16,
+		      bt_gatt_dm_attr_cnt(dm),
+		      "Unexpected number of attributes detected: %d",
+		      bt_gatt_dm_attr_cnt(dm));
+
+	/* Services in handle order */
+	attr_serv = bt_gatt_dm_service_next(dm, NULL);
+	zassert_not_null(attr_serv, "Unexpected NULL instead of HIDS");
+	zassert_equal(1, attr_serv->handle, "Unexpected handle value for HIDS");
+	serv_val = bt_gatt_dm_attr_service_val(attr_serv);
+	zassert_true(!bt_uuid_cmp(BT_UUID_HIDS, serv_val->uuid), "Invalid service detected");
+
+	attr_serv = bt_gatt_dm_service_next(dm, attr_serv);
+	zassert_not_null(attr_serv, "Unexpected NULL instead of DIS");
+	zassert_equal(12, attr_serv->handle, "Unexpected handle value for DIS");
+	serv_val = bt_gatt_dm_attr_service_val(attr_serv);
+	zassert_true(!bt_uuid_cmp(BT_UUID_DIS, serv_val->uuid), "Invalid service detected");
+
+	attr_serv = bt_gatt_dm_service_next(dm, attr_serv);
+	zassert_is_null(attr_serv, "Unexpected service detected");
+
+	/* Service and characteristics lookup */
+	attr_serv = bt_gatt_dm_service_by_uuid(dm, BT_UUID_DIS);
+	zassert_not_null(attr_serv, "Unexpected NULL instead of DIS");
+	zassert_equal(12, attr_serv->handle, "Unexpected handle value for DIS");
+	zassert_is_null(bt_gatt_dm_service_by_uuid(dm, BT_UUID_BAS),
+			"Unexpected BAS detected");
+
+	attr_chrc = bt_gatt_dm_char_by_uuid(dm, BT_UUID_DIS_MANUFACTURER_NAME);
+	zassert_not_null(attr_chrc, "Unexpected NULL");
+	zassert_equal(15, attr_chrc->handle, "Unexpected handle: %d", attr_chrc->handle);
+
+	attr_chrc = bt_gatt_dm_char_by_uuid(dm, BT_UUID_HIDS_REPORT);
+	zassert_not_null(attr_chrc, "Unexpected NULL");
+	zassert_equal(6, attr_chrc->handle, "Unexpected handle: %d", attr_chrc->handle);
+
+	bt_gatt_dm_data_release(dm);
+	zassert_equal(0, bt_gatt_dm_attr_cnt(dm), "Parameter count after clearing: %d", bt_gatt_dm_attr_cnt(dm));
+}
+
 void test_main(void)
 {
 	ztest_test_suite(
@@ -387,7 +449,8 @@ void test_main(void)
 		ztest_unit_test_setup_teardown(test_gatt_HIDS_attr_by_handle, test_setup, unit_test_noop),
 		ztest_unit_test_setup_teardown(test_gatt_HIDS_next_chrc_access, test_setup, unit_test_noop),
 		ztest_unit_test_setup_teardown(test_gatt_HIDS_chrc_by_uuid, test_setup, unit_test_noop),
-		ztest_unit_test_setup_teardown(test_gatt_generic_serv, test_setup, unit_test_noop)
+		ztest_unit_test_setup_teardown(test_gatt_generic_serv, test_setup, unit_test_noop),
+		ztest_unit_test_setup_teardown(test_gatt_multi_serv, test_setup, unit_test_noop)
 	);
 
 	ztest_run_test_suite(test_gatt);
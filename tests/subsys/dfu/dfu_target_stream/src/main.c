@@ -191,6 +191,71 @@ static void test_dfu_target_stream_save_progress(void)
 	zassert_equal(0, first_offset, "Offsets has not been reset");
 }
 
+static void test_dfu_target_stream_recover_progress(void)
+{
+	int err;
+	size_t first_offset;
+	size_t second_offset;
+	struct flash_pages_info page;
+
+	/* Reset state to avoid failure when initializing */
+	err = dfu_target_stream_done(true);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	/* Clear the progress retained for 'TEST_ID_1' by the previous test */
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, 0, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_done(true);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, 0, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_write(write_buf, sizeof(write_buf)/2);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_offset_get(&first_offset);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_done(false);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	/* Simulate data written after the progress was last stored */
+	err = flash_write(fdev, FLASH_BASE + first_offset, write_buf, 16);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = flash_get_page_info_by_offs(fdev, FLASH_BASE + first_offset,
+					  &page);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	/* Re-initialize dfu target and verify that the stream is rewound to
+	 * the start of the partially written page.
+	 */
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, 0, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_offset_get(&second_offset);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_equal(second_offset, page.start_offset - FLASH_BASE,
+		      "Offset not rewound to page start");
+
+	/* Write the rest of the image and verify it */
+	err = dfu_target_stream_write(write_buf + second_offset,
+				      sizeof(write_buf) - second_offset);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_done(true);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = flash_read(fdev, FLASH_BASE, read_buf, BUF_LEN);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_mem_equal(read_buf, write_buf, BUF_LEN, "Incorrect value");
+}
+
 #else
 
 static void test_dfu_target_stream_save_progress(void)
@@ -198,6 +263,11 @@ static void test_dfu_target_stream_save_progress(void)
 	ztest_test_skip();
 }
 
+static void test_dfu_target_stream_recover_progress(void)
+{
+	ztest_test_skip();
+}
+
 #endif
 
 
@@ -207,7 +277,8 @@ void test_main(void)
 	ztest_test_suite(lib_dfu_target_stream,
 	     ztest_unit_test(test_dfu_target_stream_null_checks),
 	     ztest_unit_test(test_dfu_target_stream),
-	     ztest_unit_test(test_dfu_target_stream_save_progress)
+	     ztest_unit_test(test_dfu_target_stream_save_progress),
+	     ztest_unit_test(test_dfu_target_stream_recover_progress)
 	 );
 
 	ztest_run_test_suite(lib_dfu_target_stream);
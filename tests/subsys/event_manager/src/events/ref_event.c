@@ -0,0 +1,14 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "ref_event.h"
+
+
+EVENT_TYPE_MEM_SLAB_DEFINE(ref_event,
+			   false,
+			   NULL,
+			   NULL,
+			   REF_EVENT_CNT);
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _REF_EVENT_H_
+#define _REF_EVENT_H_
+
+/**
+ * @brief Ref Event
+ * @defgroup ref_event Ref Event
+ * @{
+ */
+
+#include "event_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of ref events that can be allocated at the same time. */
+#define REF_EVENT_CNT 2
+
+struct ref_event {
+	struct event_header header;
+
+	int val;
+};
+
+EVENT_TYPE_DECLARE(ref_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _REF_EVENT_H_ */
@@ -0,0 +1,14 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "slab_event.h"
+
+
+EVENT_TYPE_MEM_SLAB_DEFINE(slab_event,
+			   false,
+			   NULL,
+			   NULL,
+			   SLAB_EVENT_CNT);
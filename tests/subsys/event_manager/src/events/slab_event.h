@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _SLAB_EVENT_H_
+#define _SLAB_EVENT_H_
+
+/**
+ * @brief Slab Event
+ * @defgroup slab_event Slab Event
+ * @{
+ */
+
+#include "event_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of slab events that can be allocated at the same time. */
+#define SLAB_EVENT_CNT 10
+
+struct slab_event {
+	struct event_header header;
+
+	int val;
+};
+
+EVENT_TYPE_DECLARE(slab_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _SLAB_EVENT_H_ */
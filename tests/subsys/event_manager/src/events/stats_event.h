@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _STATS_EVENT_H_
+#define _STATS_EVENT_H_
+
+/**
+ * @brief Stats Event
+ * @defgroup stats_event Stats Event
+ * @{
+ */
+
+#include "event_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of events submitted by the statistics test. */
+#define STATS_EVENT_CNT 8
+
+struct stats_event {
+	struct event_header header;
+
+	int val;
+};
+
+EVENT_TYPE_DECLARE(stats_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _STATS_EVENT_H_ */
@@ -24,9 +24,13 @@ enum test_id {
 	TEST_BASIC,
 	TEST_DATA,
 	TEST_EVENT_ORDER,
+	TEST_EVENT_BATCH,
 	TEST_SUBSCRIBER_ORDER,
 	TEST_OOM_RESET,
 	TEST_MULTICONTEXT,
+	TEST_MEM_SLAB,
+	TEST_STATS,
+	TEST_EVENT_REF,
 
 	TEST_CNT
 };
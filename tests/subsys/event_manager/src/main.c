@@ -54,6 +54,11 @@ static void test_event_order(void)
 	test_start(TEST_EVENT_ORDER);
 }
 
+static void test_event_batch(void)
+{
+	test_start(TEST_EVENT_BATCH);
+}
+
 static void test_subs_order(void)
 {
 	test_start(TEST_SUBSCRIBER_ORDER);
@@ -69,6 +74,21 @@ static void test_multicontext(void)
 	test_start(TEST_MULTICONTEXT);
 }
 
+static void test_mem_slab(void)
+{
+	test_start(TEST_MEM_SLAB);
+}
+
+static void test_stats(void)
+{
+	test_start(TEST_STATS);
+}
+
+static void test_event_ref(void)
+{
+	test_start(TEST_EVENT_REF);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(event_manager_tests,
@@ -76,9 +96,13 @@ void test_main(void)
 			 ztest_unit_test(test_basic),
 			 ztest_unit_test(test_data),
 			 ztest_unit_test(test_event_order),
+			 ztest_unit_test(test_event_batch),
 			 ztest_unit_test(test_subs_order),
 			 ztest_unit_test(test_oom_reset),
-			 ztest_unit_test(test_multicontext)
+			 ztest_unit_test(test_multicontext),
+			 ztest_unit_test(test_mem_slab),
+			 ztest_unit_test(test_stats),
+			 ztest_unit_test(test_event_ref)
 			 );
 
 	ztest_run_test_suite(event_manager_tests);
@@ -62,6 +62,26 @@ static bool event_handler(const struct event_header *eh)
 			break;
 		}
 
+		case TEST_EVENT_BATCH:
+		{
+			sys_slist_t batch;
+
+			sys_slist_init(&batch);
+
+			for (size_t i = 0; i < TEST_EVENT_ORDER_CNT; i++) {
+				struct order_event *event = new_order_event();
+
+				zassert_not_null(event, "Failed to allocate event");
+				event->val = i;
+				EVENT_BATCH_APPEND(&batch, event);
+			}
+
+			event_submit_batch(&batch);
+			zassert_true(sys_slist_is_empty(&batch),
+				     "Batch not emptied on submission");
+			break;
+		}
+
 		case TEST_SUBSCRIBER_ORDER:
 		{
 			struct order_event *event = new_order_event();
@@ -67,6 +67,20 @@ static bool event_handler(const struct event_header *eh)
 				te->test_id = TEST_EVENT_ORDER;
 				EVENT_SUBMIT(te);
 			}
+		} else if (cur_test_id == TEST_EVENT_BATCH) {
+			static int i;
+			struct order_event *event = cast_order_event(eh);
+
+			zassert_equal(event->val, i, "Incorrent event order");
+			i++;
+
+			if (i == TEST_EVENT_ORDER_CNT) {
+				struct test_end_event *te = new_test_end_event();
+
+				zassert_not_null(te, "Failed to allocate event");
+				te->test_id = TEST_EVENT_BATCH;
+				EVENT_SUBMIT(te);
+			}
 		}
 
 		return false;
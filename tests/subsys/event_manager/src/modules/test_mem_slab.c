@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#include <test_events.h>
+#include <slab_event.h>
+
+#define MODULE test_mem_slab
+
+static bool event_handler(const struct event_header *eh)
+{
+	struct k_mem_slab *slab = _EVENT_ID(slab_event)->mem_slab;
+
+	if (is_test_start_event(eh)) {
+		struct test_start_event *st = cast_test_start_event(eh);
+
+		if (st->test_id != TEST_MEM_SLAB) {
+			/* Ignore other test cases, check if proper test_id. */
+			zassert_true(st->test_id < TEST_CNT,
+				     "test_id out of range");
+			return false;
+		}
+
+		zassert_not_null(slab, "Event type has no memory slab");
+
+		struct slab_event *event_tab[SLAB_EVENT_CNT];
+
+		for (size_t i = 0; i < ARRAY_SIZE(event_tab); i++) {
+			event_tab[i] = new_slab_event();
+			zassert_not_null(event_tab[i], "Failed to allocate event");
+			event_tab[i]->val = i;
+		}
+
+		zassert_equal(k_mem_slab_num_used_get(slab), SLAB_EVENT_CNT,
+			      "Events not allocated from memory slab");
+		zassert_equal(atomic_get(_EVENT_ID(slab_event)->mem_slab_max_used),
+			      SLAB_EVENT_CNT, "Wrong memory slab max usage");
+
+		for (size_t i = 0; i < ARRAY_SIZE(event_tab); i++) {
+			EVENT_SUBMIT(event_tab[i]);
+		}
+
+		return false;
+	}
+
+	if (is_slab_event(eh)) {
+		static int i;
+		struct slab_event *event = cast_slab_event(eh);
+
+		zassert_equal(event->val, i, "Incorrect event order");
+		i++;
+
+		/* Previously processed events are returned to the slab. */
+		zassert_equal(k_mem_slab_num_used_get(slab),
+			      SLAB_EVENT_CNT - i + 1,
+			      "Events not freed to memory slab");
+
+		if (i == SLAB_EVENT_CNT) {
+			struct test_end_event *te = new_test_end_event();
+
+			zassert_not_null(te, "Failed to allocate event");
+			te->test_id = TEST_MEM_SLAB;
+			EVENT_SUBMIT(te);
+		}
+
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+EVENT_LISTENER(MODULE, event_handler);
+EVENT_SUBSCRIBE(MODULE, test_start_event);
+EVENT_SUBSCRIBE(MODULE, slab_event);
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#include <test_events.h>
+#include <ref_event.h>
+
+#define MODULE test_ref
+
+static const struct event_header *held_event;
+
+static bool event_handler(const struct event_header *eh)
+{
+	struct k_mem_slab *slab = _EVENT_ID(ref_event)->mem_slab;
+
+	if (is_test_start_event(eh)) {
+		struct test_start_event *st = cast_test_start_event(eh);
+
+		if (st->test_id != TEST_EVENT_REF) {
+			/* Ignore other test cases, check if proper test_id. */
+			zassert_true(st->test_id < TEST_CNT,
+				     "test_id out of range");
+			return false;
+		}
+
+		struct ref_event *event = new_ref_event();
+
+		zassert_not_null(event, "Failed to allocate event");
+		event->val = 0;
+		EVENT_SUBMIT(event);
+
+		return false;
+	}
+
+	if (is_ref_event(eh)) {
+		struct ref_event *event = cast_ref_event(eh);
+
+		if (event->val == 0) {
+			/* Keep the first event after its processing ends.
+			 * The second event is processed after that.
+			 */
+			event_manager_event_ref(eh);
+			held_event = eh;
+
+			struct ref_event *next = new_ref_event();
+
+			zassert_not_null(next, "Failed to allocate event");
+			next->val = 1;
+			EVENT_SUBMIT(next);
+
+			return false;
+		}
+
+		zassert_equal(k_mem_slab_num_used_get(slab), REF_EVENT_CNT,
+			      "Referenced event freed");
+		zassert_equal(cast_ref_event(held_event)->val, 0,
+			      "Referenced event modified");
+
+		event_manager_event_unref(held_event);
+		held_event = NULL;
+
+		zassert_equal(k_mem_slab_num_used_get(slab), REF_EVENT_CNT - 1,
+			      "Released event not freed");
+
+		struct test_end_event *te = new_test_end_event();
+
+		zassert_not_null(te, "Failed to allocate event");
+		te->test_id = TEST_EVENT_REF;
+		EVENT_SUBMIT(te);
+
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+EVENT_LISTENER(MODULE, event_handler);
+EVENT_SUBSCRIBE(MODULE, test_start_event);
+EVENT_SUBSCRIBE(MODULE, ref_event);
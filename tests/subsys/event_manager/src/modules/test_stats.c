@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2021 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#include <test_events.h>
+#include <stats_event.h>
+
+#define MODULE test_stats
+
+/* Listener of the module, defined with EVENT_LISTENER below. */
+extern const struct event_listener _CONCAT(__event_listener_, MODULE);
+
+static bool event_handler(const struct event_header *eh)
+{
+	const struct event_type_stats *type_stats = _EVENT_ID(stats_event)->stats;
+
+	if (is_test_start_event(eh)) {
+		struct test_start_event *st = cast_test_start_event(eh);
+
+		if (st->test_id != TEST_STATS) {
+			/* Ignore other test cases, check if proper test_id. */
+			zassert_true(st->test_id < TEST_CNT,
+				     "test_id out of range");
+			return false;
+		}
+
+		event_manager_stats_reset();
+
+		for (size_t i = 0; i < STATS_EVENT_CNT; i++) {
+			struct stats_event *event = new_stats_event();
+
+			zassert_not_null(event, "Failed to allocate event");
+			event->val = i;
+			EVENT_SUBMIT(event);
+		}
+
+		zassert_equal(atomic_get(&type_stats->submitted),
+			      STATS_EVENT_CNT, "Wrong number of submitted events");
+
+		return false;
+	}
+
+	if (is_stats_event(eh)) {
+		struct stats_event *event = cast_stats_event(eh);
+
+		/* Statistics of the current event are updated once all
+		 * listeners are notified.
+		 */
+		zassert_equal(type_stats->processed, event->val,
+			      "Wrong number of processed events");
+		zassert_equal(type_stats->consumed, event->val / 2,
+			      "Wrong number of consumed events");
+
+		/* The notification about the test start is also counted. */
+		zassert_equal(atomic_get(&_CONCAT(__event_listener_, MODULE).stats->calls),
+			      event->val + 1, "Wrong number of notifications");
+
+		if (event->val == STATS_EVENT_CNT - 1) {
+			struct event_queue_stats queue_stats;
+
+			zassert_ok(event_manager_queue_stats_get(EVENT_QUEUE_DEFAULT,
+								 &queue_stats),
+				   "Cannot get event queue statistics");
+			zassert_true(queue_stats.depth_max >= STATS_EVENT_CNT,
+				     "Wrong maximum event queue depth");
+
+			struct test_end_event *te = new_test_end_event();
+
+			zassert_not_null(te, "Failed to allocate event");
+			te->test_id = TEST_STATS;
+			EVENT_SUBMIT(te);
+		}
+
+		/* Consume every other event. */
+		return (event->val % 2) != 0;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+EVENT_LISTENER(MODULE, event_handler);
+EVENT_SUBSCRIBE(MODULE, test_start_event);
+EVENT_SUBSCRIBE(MODULE, stats_event);
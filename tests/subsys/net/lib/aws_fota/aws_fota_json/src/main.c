@@ -34,6 +34,27 @@ static void test_parse_job_execution(void)
 	zassert_true(!strcmp(file_path, expected_file_path), NULL);
 }
 
+static void test_parse_job_execution_escaped(void)
+{
+	int ret;
+	int version_number;
+	char job_id[100];
+	char hostname[100];
+	char file_path[100];
+	char encoded[] = "{\"execution\":{\"jobId\":\"job\\u002d1\",\"versionNumber\":12,\"statusDetails\":{\"list\":[{\"host\":\"x\"},[]]},\"jobDocument\":{\"location\":{\"host\":\"example.com\",\"path\":\"\\/fw\\/update.bin\"}}}}";
+
+	ret = aws_fota_parse_DescribeJobExecution_rsp(encoded,
+						      sizeof(encoded) - 1,
+						      job_id, hostname,
+						      file_path,
+						      &version_number);
+	zassert_equal(ret, 1, NULL);
+	zassert_true(!strcmp(job_id, "job-1"), NULL);
+	zassert_equal(version_number, 12, NULL);
+	zassert_true(!strcmp(hostname, "example.com"), NULL);
+	zassert_true(!strcmp(file_path, "/fw/update.bin"), NULL);
+}
+
 static void test_parse_malformed_job_execution(void)
 {
 	int ret;
@@ -186,6 +207,7 @@ void test_main(void)
 {
 	ztest_test_suite(lib_json_test,
 			 ztest_unit_test(test_parse_job_execution),
+			 ztest_unit_test(test_parse_job_execution_escaped),
 			 ztest_unit_test(test_parse_job_execution_missing_job_id_field),
 			 ztest_unit_test(test_parse_job_execution_missing_location_obj),
 			 ztest_unit_test(test_parse_job_execution_missing_path_field),
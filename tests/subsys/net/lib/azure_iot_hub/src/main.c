@@ -224,6 +224,54 @@ static void test_topic_add_prop_bags_reverse(void)
 	zassert_equal(strcmp_result, 0, "Incorrect property bag string");
 }
 
+static void test_topic_write_prop_bags(void)
+{
+	int len;
+	char buf[32] = "prefix/";
+	char *key1 = "key1";
+	char *val1 = "value1";
+	char *key2 = "key2";
+	const struct azure_iot_hub_prop_bag bags[] = {
+		{
+			.key = key1,
+			.value = val1,
+		},
+		{
+			.key = key2,
+			.value = NULL,
+		},
+	};
+
+	len = azure_iot_hub_prop_bag_str_write(bags, ARRAY_SIZE(bags),
+					       NULL, 0);
+	zassert_equal(len, strlen("?key1=value1&key2"), NULL);
+
+	len = azure_iot_hub_prop_bag_str_write(bags, ARRAY_SIZE(bags),
+					       &buf[7], sizeof(buf) - 7);
+	zassert_equal(len, strlen("?key1=value1&key2"), NULL);
+	zassert_true(strcmp(buf, "prefix/?key1=value1&key2") == 0,
+		     "Incorrect property bag string");
+
+	/* No room for the null-terminator */
+	len = azure_iot_hub_prop_bag_str_write(bags, ARRAY_SIZE(bags),
+					       buf, strlen("?key1=value1&key2"));
+	zassert_equal(len, -ENOMEM, NULL);
+}
+
+static void test_topic_write_u32(void)
+{
+	char buf[11];
+
+	zassert_equal(azure_iot_hub_topic_u32_write(buf, sizeof(buf), 0), 1,
+		      NULL);
+	zassert_true(strcmp(buf, "0") == 0, NULL);
+	zassert_equal(azure_iot_hub_topic_u32_write(buf, sizeof(buf),
+						    UINT32_MAX), 10, NULL);
+	zassert_true(strcmp(buf, "4294967295") == 0, NULL);
+	zassert_equal(azure_iot_hub_topic_u32_write(buf, 3, 738), -ENOMEM,
+		      NULL);
+}
+
 static void test_topic_parse_long(void)
 {
 	int err;
@@ -292,6 +340,8 @@ void test_main(void)
 			 ztest_unit_test(test_topic_parse_unknown_topic),
 			 ztest_unit_test(test_topic_add_prop_bags),
 			 ztest_unit_test(test_topic_add_prop_bags_reverse),
+			 ztest_unit_test(test_topic_write_prop_bags),
+			 ztest_unit_test(test_topic_write_u32),
 			 ztest_unit_test(test_topic_parse_long),
 			 ztest_unit_test(test_topic_prop_bag_too_long)
 			 );
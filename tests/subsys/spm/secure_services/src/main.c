@@ -158,12 +158,62 @@ void test_spm_request_read(void)
 	zassert_equal(err, -EPERM, "Invalid address did not return -EPERM!");
 }
 
+void test_spm_request_batch(void)
+{
+	const uint32_t ficr_start = (NRF_FICR_S_BASE + 0x204);
+	struct spm_batch_op ops[3];
+	struct fw_info info;
+	uint8_t read_output[32];
+	uint8_t random_output[64];
+	int err;
+
+	ops[0].type = SPM_BATCH_OP_READ;
+	ops[0].read.destination = read_output;
+	ops[0].read.addr = ficr_start;
+	ops[0].read.len = sizeof(read_output);
+
+	ops[1].type = SPM_BATCH_OP_RANDOM_NUMBER;
+	ops[1].random_number.output = random_output;
+	ops[1].random_number.len = sizeof(random_output);
+
+	ops[2].type = SPM_BATCH_OP_FIRMWARE_INFO;
+	ops[2].firmware_info.fw_address = PM_SPM_ADDRESS;
+	ops[2].firmware_info.info = &info;
+
+	/* Normal execution */
+	err = spm_request_batch(ops, ARRAY_SIZE(ops));
+	zassert_equal(err, 0, "Got unexpected failure");
+	zassert_equal(ops[0].result, 0, "Read failed");
+	zassert_equal(ops[1].result,
+		      IS_ENABLED(CONFIG_SPM_SERVICE_RNG) ? 0 : -ENOTSUP,
+		      "Unexpected random number result");
+	zassert_equal(ops[2].result, 0, "Firmware info failed");
+
+	/* Verify that a failing operation does not affect the others */
+	ops[0].read.addr = ficr_start - 1;
+	err = spm_request_batch(ops, ARRAY_SIZE(ops));
+	zassert_equal(err, 0, "Got unexpected failure");
+	zassert_equal(ops[0].result, -EPERM, "Invalid read did not fail");
+	zassert_equal(ops[2].result, 0, "Firmware info failed");
+
+	/* Verify that the function fails for invalid arguments */
+	err = spm_request_batch(ops, 0);
+	zassert_equal(err, -EINVAL, "Did not fail for empty batch");
+
+	err = spm_request_batch((struct spm_batch_op *)PM_SPM_SRAM_ADDRESS, 1);
+	zassert_equal(err, -EINVAL, "Did not fail for secure pointer");
+
+	err = spm_request_batch(ops, CONFIG_SPM_SERVICE_BATCH_MAX_OPS + 1);
+	zassert_equal(err, -E2BIG, "Did not fail for too long batch");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_secure_service,
 			 ztest_unit_test(test_spm_firmware_info),
 			 ztest_unit_test(test_spm_request_random_number),
 			 ztest_unit_test(test_spm_s0_active),
-			 ztest_unit_test(test_spm_request_read));
+			 ztest_unit_test(test_spm_request_read),
+			 ztest_unit_test(test_spm_request_batch));
 	ztest_run_test_suite(test_secure_service);
 }